@@ -810,4 +810,97 @@ ret_code_t ble_advertising_advdata_update(ble_advertising_t   * const p_advertis
 }
 
 
+/**@brief Function for copying one set of encoded data into its swap buffer and patching it.
+ *
+ * @param[in]  p_current   Data currently given to the SoftDevice.
+ * @param[out] p_new       Patched data.
+ * @param[in]  p_buf_0     First buffer used for this set of data.
+ * @param[in]  p_buf_1     Second buffer used for this set of data.
+ * @param[in]  p_patches   Patches to apply.
+ * @param[in]  patch_cnt   Number of patches.
+ */
+static ret_code_t adv_set_data_patch(ble_data_t              const * const p_current,
+                                     ble_data_t                    * const p_new,
+                                     uint8_t                       * const p_buf_0,
+                                     uint8_t                       * const p_buf_1,
+                                     ble_advertising_patch_t const * const p_patches,
+                                     uint8_t                             patch_cnt)
+{
+    for (uint8_t i = 0; i < patch_cnt; i++)
+    {
+        VERIFY_PARAM_NOT_NULL(p_patches[i].p_data);
+
+        if ((uint32_t)p_patches[i].offset + p_patches[i].len > p_current->len)
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    if ((p_current->p_data == NULL) || (p_current->len == 0))
+    {
+        return NRF_SUCCESS;
+    }
+
+    p_new->p_data = (p_current->p_data != p_buf_0) ? p_buf_0 : p_buf_1;
+    p_new->len    = p_current->len;
+
+    memcpy(p_new->p_data, p_current->p_data, p_current->len);
+
+    for (uint8_t i = 0; i < patch_cnt; i++)
+    {
+        memcpy(&p_new->p_data[p_patches[i].offset], p_patches[i].p_data, p_patches[i].len);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t ble_advertising_advdata_patch(ble_advertising_t             * const p_advertising,
+                                         ble_advertising_patch_t const * const p_adv_patches,
+                                         uint8_t                               adv_patch_cnt,
+                                         ble_advertising_patch_t const * const p_sr_patches,
+                                         uint8_t                               sr_patch_cnt)
+{
+    ret_code_t ret;
+
+    VERIFY_PARAM_NOT_NULL(p_advertising);
+    if (p_advertising->initialized == false)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (((p_adv_patches == NULL) && (adv_patch_cnt != 0)) ||
+        ((p_sr_patches == NULL) && (sr_patch_cnt != 0)))
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    ble_gap_adv_data_t new_adv_data;
+    memset(&new_adv_data, 0, sizeof(new_adv_data));
+
+    ret = adv_set_data_patch(&p_advertising->adv_data.adv_data,
+                             &new_adv_data.adv_data,
+                             p_advertising->enc_advdata[0],
+                             p_advertising->enc_advdata[1],
+                             p_adv_patches,
+                             adv_patch_cnt);
+    VERIFY_SUCCESS(ret);
+
+    ret = adv_set_data_patch(&p_advertising->adv_data.scan_rsp_data,
+                             &new_adv_data.scan_rsp_data,
+                             p_advertising->enc_scan_rsp_data[0],
+                             p_advertising->enc_scan_rsp_data[1],
+                             p_sr_patches,
+                             sr_patch_cnt);
+    VERIFY_SUCCESS(ret);
+
+    memcpy(&p_advertising->adv_data, &new_adv_data, sizeof(p_advertising->adv_data));
+    p_advertising->p_adv_data = &p_advertising->adv_data;
+
+    return sd_ble_gap_adv_set_configure(&p_advertising->adv_handle,
+                                        p_advertising->p_adv_data,
+                                        NULL);
+}
+
+
 #endif // NRF_MODULE_ENABLED(BLE_ADVERTISING)
@@ -343,6 +343,51 @@ ret_code_t ble_advertising_advdata_update(ble_advertising_t   * const p_advertis
                                           ble_advdata_t const * const p_advdata,
                                           ble_advdata_t const * const p_srdata);
 
+
+/**@brief   In-place patch of encoded advertising data. */
+typedef struct
+{
+    uint16_t        offset; /**< Offset of the value in the encoded data, e.g. taken from @ref ble_advdata_layout_t. */
+    uint8_t const * p_data; /**< New value. */
+    uint16_t        len;    /**< Length of the new value. */
+} ble_advertising_patch_t;
+
+
+/**@brief   Function for patching fields of the advertising data in place.
+ *
+ * @details Instead of encoding the advertising data again, this function copies the data that is
+ *          currently advertised into the swap buffer, overwrites the given byte ranges and hands
+ *          the swap buffer to the SoftDevice. The layout of the data does not change, so the
+ *          offsets obtained once from @ref ble_advdata_encode_layout stay valid across patches.
+ *          Both the advertising data and the scan response data (if any) are moved to their swap
+ *          buffers, as the SoftDevice does not accept the buffers in use while advertising.
+ *
+ *          @ref ble_advertising_init and @ref ble_advertising_advdata_update do not return the
+ *          layout. To get the offsets, encode the same @ref ble_advdata_t that was passed to them
+ *          with @ref ble_advdata_encode_layout into a scratch buffer of the same size as the
+ *          advertising set (@ref BLE_GAP_ADV_SET_DATA_SIZE_MAX, or the extended size if extended
+ *          advertising is enabled). The output is identical to what the module encoded, so the
+ *          offsets apply to the advertised data. The offsets become invalid when the data is
+ *          encoded again with @ref ble_advertising_advdata_update, unless the new data has the
+ *          same layout.
+ *
+ * @param[in]  p_advertising Advertising Module instance.
+ * @param[in]  p_adv_patches Patches for the advertising data. Can be NULL if \p adv_patch_cnt is 0.
+ * @param[in]  adv_patch_cnt Number of patches in \p p_adv_patches.
+ * @param[in]  p_sr_patches  Patches for the scan response data. Can be NULL if \p sr_patch_cnt is 0.
+ * @param[in]  sr_patch_cnt  Number of patches in \p p_sr_patches.
+ *
+ * @retval @ref NRF_ERROR_NULL          If advertising instance or a patch value was null.
+ * @retval @ref NRF_ERROR_INVALID_STATE If advertising instance was not initialized.
+ * @retval @ref NRF_ERROR_INVALID_PARAM If a patch does not fit within the current data.
+ * @retval @ref NRF_SUCCESS or any error from @ref sd_ble_gap_adv_set_configure().
+ */
+ret_code_t ble_advertising_advdata_patch(ble_advertising_t             * const p_advertising,
+                                         ble_advertising_patch_t const * const p_adv_patches,
+                                         uint8_t                               adv_patch_cnt,
+                                         ble_advertising_patch_t const * const p_sr_patches,
+                                         uint8_t                               sr_patch_cnt);
+
 /** @} */
 
 
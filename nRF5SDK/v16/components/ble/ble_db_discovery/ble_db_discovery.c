@@ -44,6 +44,9 @@
 #include "ble_db_discovery.h"
 #include <stdlib.h>
 #include "ble_srv_common.h"
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+#include "peer_manager.h"
+#endif
 #define NRF_LOG_MODULE_NAME ble_db_disc
 #include "nrf_log.h"
 NRF_LOG_MODULE_REGISTER();
@@ -58,9 +61,37 @@ static ble_uuid_t                       m_registered_handlers[DB_DISCOVERY_MAX_U
 static ble_db_discovery_evt_handler_t   m_evt_handler;
 static nrf_ble_gq_t                   * mp_gatt_queue; /**< Pointer to BLE GATT Queue instance. */
 
+static uint8_t                          m_registered_prio[DB_DISCOVERY_MAX_USERS]; /**< Discovery priority of each registered service. */
+
 static uint32_t m_num_of_handlers_reg;      /**< The number of handlers registered with the DB Discovery module. */
 static bool     m_initialized = false;      /**< This variable Indicates if the module is initialized or not. */
 
+STATIC_ASSERT(BLE_DB_DISCOVERY_MAX_SRV <= 8); /* ble_db_discovery_t::srv_found_mask is 8 bits wide. */
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+#define DB_HASH_UUID         0x2B2A                       /**< UUID of the Database Hash characteristic. */
+#define DB_CACHE_TAG         0x43424444                   /**< Tag identifying a database stored by this module. */
+#define DB_CACHE_MAX_PENDING NRF_SDH_BLE_TOTAL_LINK_COUNT /**< Maximum number of instances waiting for bonding to store their database. */
+
+/**@brief Database of a peer, as stored through the Peer Manager. */
+typedef struct
+{
+    uint32_t          tag;                                   /**< Set to @ref DB_CACHE_TAG. */
+    uint8_t           db_hash[BLE_DB_DISCOVERY_DB_HASH_LEN]; /**< Database Hash of the peer at the time of the discovery. */
+    uint8_t           db_hash_valid;                         /**< Whether the peer exposed a Database Hash. */
+    uint8_t           srv_reg_count;                         /**< Number of registered services when the database was stored. */
+    uint8_t           srv_count;                             /**< Value of ble_db_discovery_t::srv_count. */
+    uint8_t           srv_found_mask;                        /**< Bitmask of the registered services that were found at the peer. */
+    ble_gatt_db_srv_t services[BLE_DB_DISCOVERY_MAX_SRV];    /**< Discovered services, in registration order. */
+} db_cache_record_t;
+
+static db_cache_record_t    m_cache_record;                               /**< Buffer used to load and store databases. It must stay valid while a store is in progress. */
+static bool                 m_cache_store_in_progress;                    /**< Whether @ref m_cache_record is being written to flash. */
+static pm_store_token_t     m_cache_store_token = PM_STORE_TOKEN_INVALID; /**< Token of the store in progress. */
+static bool                 m_cache_pm_registered;                        /**< Whether the Peer Manager event handler has been registered. */
+static ble_db_discovery_t * m_cache_pending[DB_CACHE_MAX_PENDING];        /**< Instances waiting for bonding to store their database. */
+#endif // NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+
 /**@brief     Function for fetching the event handler provided by a registered application module.
  *
  * @param[in] srv_uuid UUID of the service.
@@ -83,15 +114,20 @@ static ble_db_discovery_evt_handler_t registered_handler_get(ble_uuid_t const *
 
 
 /**@brief     Function for storing the event handler provided by a registered application module.
+ *
+ * @details   The registrations are kept sorted by descending priority, so that the services are
+ *            discovered in that order. Services with the same priority keep the registration order.
  *
  * @param[in] p_srv_uuid    The UUID of the service.
  * @param[in] p_evt_handler The event handler provided by the application.
+ * @param[in] prio          Discovery priority of the service.
  *
  * @retval    NRF_SUCCESS If the handler was stored or already present in the list.
  * @retval    NRF_ERROR_NO_MEM If there is no space left to store the handler.
  */
 static uint32_t registered_handler_set(ble_uuid_t                     const * p_srv_uuid,
-                                       ble_db_discovery_evt_handler_t         p_evt_handler)
+                                       ble_db_discovery_evt_handler_t         p_evt_handler,
+                                       uint8_t                                prio)
 {
     if (registered_handler_get(p_srv_uuid) != NULL)
     {
@@ -100,7 +136,16 @@ static uint32_t registered_handler_set(ble_uuid_t                     const * p_
 
     if (m_num_of_handlers_reg < DB_DISCOVERY_MAX_USERS)
     {
-        m_registered_handlers[m_num_of_handlers_reg] = *p_srv_uuid;
+        uint32_t i;
+
+        for (i = m_num_of_handlers_reg; (i > 0) && (m_registered_prio[i - 1] < prio); i--)
+        {
+            m_registered_handlers[i] = m_registered_handlers[i - 1];
+            m_registered_prio[i]     = m_registered_prio[i - 1];
+        }
+
+        m_registered_handlers[i] = *p_srv_uuid;
+        m_registered_prio[i]     = prio;
         m_num_of_handlers_reg++;
 
         return NRF_SUCCESS;
@@ -112,6 +157,28 @@ static uint32_t registered_handler_set(ble_uuid_t                     const * p_
 }
 
 
+/**@brief     Function for adding a discovery request to the BLE GATT Queue.
+ *
+ * @details   With BLE_DB_DISCOVERY_SCHED_ENABLED, the request is added to the high priority lane
+ *            so that the discovery is not delayed by other requests queued on the link. The normal
+ *            lane is used if the high priority lane of @ref nrf_ble_gq is compiled out.
+ *
+ * @param[in] p_req       Pointer to the request.
+ * @param[in] conn_handle Connection Handle.
+ *
+ * @return    Error code returned by @ref nrf_ble_gq_item_add or @ref nrf_ble_gq_item_add_prio.
+ */
+static uint32_t discovery_req_add(nrf_ble_gq_req_t * p_req, uint16_t conn_handle)
+{
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED) && (NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE > 0)
+    return nrf_ble_gq_item_add_prio(mp_gatt_queue, p_req, conn_handle, NRF_BLE_GQ_PRIO_HIGH);
+#else
+    return nrf_ble_gq_item_add(mp_gatt_queue, p_req, conn_handle);
+#endif
+}
+
+
+#if !NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
 /**@brief Function for sending all pending discovery events to the corresponding user modules.
  */
 static void pending_user_evts_send(ble_db_discovery_t * p_db_discovery)
@@ -124,6 +191,7 @@ static void pending_user_evts_send(ble_db_discovery_t * p_db_discovery)
 
     p_db_discovery->pending_usr_evt_index = 0;
 }
+#endif
 
 /**@brief     Function for indicating availability of DB discovery instance.
  *
@@ -152,6 +220,28 @@ static void discovery_available_evt_trigger(ble_db_discovery_t * const p_db_disc
 }
 
 
+/**@brief     Function for ending the discovery process on a DB discovery instance.
+ *
+ * @param[in] p_db_discovery Pointer to the DB discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ */
+static void discovery_finish(ble_db_discovery_t * const p_db_discovery,
+                             uint16_t             const conn_handle)
+{
+    p_db_discovery->discovery_in_progress = false;
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+    p_db_discovery->duration_ticks = app_timer_cnt_diff_compute(app_timer_cnt_get(),
+                                                                p_db_discovery->start_ticks);
+
+    NRF_LOG_DEBUG("Discovery on connection handle 0x%x took %d ticks.",
+                  conn_handle, p_db_discovery->duration_ticks);
+#endif
+
+    discovery_available_evt_trigger(p_db_discovery, conn_handle);
+}
+
+
 /**@brief     Function for indicating error to the application.
  *
  * @details   This function will fetch the event handler based on the UUID of the service being
@@ -200,10 +290,9 @@ static void discovery_error_handler(uint32_t   nrf_error,
                                     uint16_t   conn_handle)
 {
     ble_db_discovery_t * p_db_discovery = (ble_db_discovery_t *)p_ctx;
-    p_db_discovery->discovery_in_progress = false;
 
     discovery_error_evt_trigger(p_db_discovery, nrf_error, conn_handle);
-    discovery_available_evt_trigger(p_db_discovery, conn_handle);
+    discovery_finish(p_db_discovery, conn_handle);
 }
 
 
@@ -231,6 +320,28 @@ static void discovery_complete_evt_trigger(ble_db_discovery_t * p_db_discovery,
 
     p_evt_handler = registered_handler_get(&(p_srv_being_discovered->srv_uuid));
 
+    if (is_srv_found)
+    {
+        p_db_discovery->srv_found_mask |= (1 << p_db_discovery->curr_srv_ind);
+    }
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+    if (p_evt_handler != NULL)
+    {
+        ble_db_discovery_evt_t evt;
+
+        memset(&evt, 0, sizeof(evt));
+
+        evt.conn_handle          = conn_handle;
+        evt.evt_type             = is_srv_found ? BLE_DB_DISCOVERY_COMPLETE :
+                                                  BLE_DB_DISCOVERY_SRV_NOT_FOUND;
+        evt.params.discovered_db = *p_srv_being_discovered;
+
+        // Report the service right away, so that the user module can start using it while the
+        // remaining services are discovered. Its requests are queued behind the discovery.
+        p_evt_handler(&evt);
+    }
+#else
     if (p_evt_handler != NULL)
     {
         if (p_db_discovery->pending_usr_evt_index < DB_DISCOVERY_MAX_USERS)
@@ -266,7 +377,348 @@ static void discovery_complete_evt_trigger(ble_db_discovery_t * p_db_discovery,
             }
         }
     }
+#endif // NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+}
+
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+/**@brief     Function for storing the discovered database of a bonded peer.
+ *
+ * @details   Only one database can be written at a time. If a store is already in progress, the
+ *            database is not stored and the peer will be discovered again on the next connection.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] peer_id        Peer ID of the bonded peer.
+ */
+static void cache_store(ble_db_discovery_t const * p_db_discovery, pm_peer_id_t peer_id)
+{
+    ret_code_t err_code;
+
+    if (m_cache_store_in_progress)
+    {
+        NRF_LOG_DEBUG("Store in progress, database of peer %d not stored.", peer_id);
+        return;
+    }
+
+    memset(&m_cache_record, 0x00, sizeof(m_cache_record));
+
+    m_cache_record.tag            = DB_CACHE_TAG;
+    m_cache_record.db_hash_valid  = p_db_discovery->db_hash_valid;
+    m_cache_record.srv_reg_count  = m_num_of_handlers_reg;
+    m_cache_record.srv_count      = p_db_discovery->srv_count;
+    m_cache_record.srv_found_mask = p_db_discovery->srv_found_mask;
+
+    memcpy(m_cache_record.db_hash, p_db_discovery->db_hash, sizeof(m_cache_record.db_hash));
+    memcpy(m_cache_record.services, p_db_discovery->services, sizeof(m_cache_record.services));
+
+    err_code = pm_peer_data_store(peer_id,
+                                  PM_PEER_DATA_ID_GATT_REMOTE,
+                                  &m_cache_record,
+                                  sizeof(m_cache_record),
+                                  &m_cache_store_token);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        m_cache_store_in_progress = true;
+    }
+    else
+    {
+        NRF_LOG_WARNING("Could not store the database of peer %d, error 0x%x.", peer_id, err_code);
+    }
+}
+
+
+/**@brief     Function for storing the database once the discovery is complete.
+ *
+ * @details   If the peer is not bonded yet, the database is stored when the link is secured
+ *            with bonding (see @ref cache_pm_evt_handler).
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ */
+static void cache_on_discovery_complete(ble_db_discovery_t * p_db_discovery,
+                                        uint16_t             conn_handle)
+{
+    pm_peer_id_t peer_id = PM_PEER_ID_INVALID;
+
+    (void)pm_peer_id_get(conn_handle, &peer_id);
+
+    if (peer_id != PM_PEER_ID_INVALID)
+    {
+        cache_store(p_db_discovery, peer_id);
+        return;
+    }
+
+    for (uint32_t i = 0; i < DB_CACHE_MAX_PENDING; i++)
+    {
+        if ((m_cache_pending[i] == NULL) || (m_cache_pending[i] == p_db_discovery))
+        {
+            m_cache_pending[i]                  = p_db_discovery;
+            p_db_discovery->cache_store_pending = true;
+            return;
+        }
+    }
+}
+
+
+/**@brief     Function for removing an instance from the list of instances waiting for bonding.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ */
+static void cache_pending_remove(ble_db_discovery_t * p_db_discovery)
+{
+    p_db_discovery->cache_store_pending = false;
+
+    for (uint32_t i = 0; i < DB_CACHE_MAX_PENDING; i++)
+    {
+        if (m_cache_pending[i] == p_db_discovery)
+        {
+            m_cache_pending[i] = NULL;
+        }
+    }
+}
+
+
+/**@brief     Function for handling Peer Manager events.
+ *
+ * @param[in] p_evt Peer Manager event.
+ */
+static void cache_pm_evt_handler(pm_evt_t const * p_evt)
+{
+    switch (p_evt->evt_id)
+    {
+        case PM_EVT_CONN_SEC_SUCCEEDED:
+            if (p_evt->peer_id == PM_PEER_ID_INVALID)
+            {
+                break;
+            }
+
+            for (uint32_t i = 0; i < DB_CACHE_MAX_PENDING; i++)
+            {
+                ble_db_discovery_t * p_db_discovery = m_cache_pending[i];
+
+                if ((p_db_discovery != NULL) && (p_db_discovery->conn_handle == p_evt->conn_handle))
+                {
+                    if (p_db_discovery->cache_store_pending)
+                    {
+                        cache_store(p_db_discovery, p_evt->peer_id);
+                    }
+
+                    cache_pending_remove(p_db_discovery);
+                }
+            }
+            break;
+
+        case PM_EVT_PEER_DATA_UPDATE_SUCCEEDED:
+            if (m_cache_store_in_progress &&
+                (p_evt->params.peer_data_update_succeeded.token == m_cache_store_token))
+            {
+                m_cache_store_in_progress = false;
+            }
+            break;
+
+        case PM_EVT_PEER_DATA_UPDATE_FAILED:
+            if (m_cache_store_in_progress &&
+                (p_evt->params.peer_data_update_failed.token == m_cache_store_token))
+            {
+                NRF_LOG_WARNING("Could not store the database of peer %d, error 0x%x.",
+                                p_evt->peer_id,
+                                p_evt->params.peer_data_update_failed.error);
+
+                m_cache_store_in_progress = false;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+#endif // NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+
+
+/**@brief     Function for handling the completion of the discovery of all registered services.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery Structure.
+ * @param[in] conn_handle    Connection Handle.
+ */
+static void all_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
+                                    uint16_t             conn_handle)
+{
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+    cache_on_discovery_complete(p_db_discovery, conn_handle);
+#endif
+
+    discovery_finish(p_db_discovery, conn_handle);
+}
+
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+static uint32_t characteristics_discover(ble_db_discovery_t * p_db_discovery,
+                                         uint16_t             conn_handle);
+
+
+/**@brief Function for checking whether the registered services are located with one sweep of the
+ *        primary services of the peer.
+ *
+ * @details A single registered service is found faster with a discovery by UUID.
+ */
+__STATIC_INLINE bool is_srv_sweep(void)
+{
+    return (m_num_of_handlers_reg > 1);
+}
+
+
+/**@brief     Function for requesting the next part of the primary services of the peer.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery Structure.
+ * @param[in] start_handle   Handle from which the primary services are discovered.
+ * @param[in] conn_handle    Connection Handle.
+ *
+ * @return    Error code returned by @ref discovery_req_add.
+ */
+static uint32_t srv_sweep_request(ble_db_discovery_t * p_db_discovery,
+                                  uint16_t             start_handle,
+                                  uint16_t             conn_handle)
+{
+    nrf_ble_gq_req_t db_srv_disc_req;
+
+    // A UUID of type BLE_UUID_TYPE_UNKNOWN discovers all primary services.
+    memset(&db_srv_disc_req, 0, sizeof(nrf_ble_gq_req_t));
+
+    db_srv_disc_req.type                               = NRF_BLE_GQ_REQ_SRV_DISCOVERY;
+    db_srv_disc_req.params.gattc_srv_disc.start_handle = start_handle;
+    db_srv_disc_req.error_handler.p_ctx                = p_db_discovery;
+    db_srv_disc_req.error_handler.cb                   = discovery_error_handler;
+
+    return discovery_req_add(&db_srv_disc_req, conn_handle);
+}
+
+
+/**@brief     Function for discovering the characteristics of the next service found by the sweep.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery Structure.
+ * @param[in] first_ind      Index of the first registered service to consider.
+ * @param[in] conn_handle    Connection Handle.
+ */
+static void srv_sweep_next(ble_db_discovery_t * p_db_discovery,
+                           uint32_t             first_ind,
+                           uint16_t             conn_handle)
+{
+    for (uint32_t i = first_ind; i < m_num_of_handlers_reg; i++)
+    {
+        if (p_db_discovery->srv_found_mask & (1 << i))
+        {
+            uint32_t err_code;
+
+            p_db_discovery->curr_srv_ind           = i;
+            p_db_discovery->curr_char_ind          = 0;
+            p_db_discovery->services[i].char_count = 0;
+
+            NRF_LOG_DEBUG("Starting discovery of service with UUID 0x%x on connection handle 0x%x.",
+                          p_db_discovery->services[i].srv_uuid.uuid, conn_handle);
+
+            err_code = characteristics_discover(p_db_discovery, conn_handle);
+
+            if (err_code != NRF_SUCCESS)
+            {
+                discovery_error_handler(err_code, p_db_discovery, conn_handle);
+            }
+
+            return;
+        }
+    }
+
+    all_srv_disc_completion(p_db_discovery, conn_handle);
+}
+
+
+/**@brief     Function for handling the end of the sweep of the primary services.
+ *
+ * @details   The services that are not present at the peer are reported right away. Then the
+ *            found services are discovered in the order of their priority.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery Structure.
+ * @param[in] conn_handle    Connection Handle.
+ */
+static void srv_sweep_completion(ble_db_discovery_t * p_db_discovery,
+                                 uint16_t             conn_handle)
+{
+    NRF_LOG_DEBUG("Found %d of %d services on connection handle 0x%x.",
+                  p_db_discovery->srv_count, m_num_of_handlers_reg, conn_handle);
+
+    for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        if (!(p_db_discovery->srv_found_mask & (1 << i)))
+        {
+            p_db_discovery->curr_srv_ind = i;
+            discovery_complete_evt_trigger(p_db_discovery, false, conn_handle);
+            p_db_discovery->discoveries_count++;
+        }
+    }
+
+    srv_sweep_next(p_db_discovery, 0, conn_handle);
+}
+
+
+/**@brief     Function for handling a primary service discovery response during the sweep.
+ *
+ * @details   The first instance of each registered service is recorded. The sweep ends when all
+ *            registered services are found or the end of the database is reached.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_srv_sweep_rsp(ble_db_discovery_t       * p_db_discovery,
+                             ble_gattc_evt_t    const * p_ble_gattc_evt)
+{
+    uint32_t all_mask    = (1 << m_num_of_handlers_reg) - 1;
+    uint16_t next_handle = 0;
+
+    if (p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS)
+    {
+        ble_gattc_evt_prim_srvc_disc_rsp_t const * p_rsp = &(p_ble_gattc_evt->params.prim_srvc_disc_rsp);
+
+        for (uint32_t k = 0; k < p_rsp->count; k++)
+        {
+            for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+            {
+                if (   !(p_db_discovery->srv_found_mask & (1 << i))
+                    && BLE_UUID_EQ(&(p_rsp->services[k].uuid), &(m_registered_handlers[i])))
+                {
+                    p_db_discovery->services[i].handle_range = p_rsp->services[k].handle_range;
+                    p_db_discovery->srv_found_mask          |= (1 << i);
+                    p_db_discovery->srv_count++;
+                    break;
+                }
+            }
+        }
+
+        if (p_rsp->count > 0)
+        {
+            uint16_t end_handle = p_rsp->services[p_rsp->count - 1].handle_range.end_handle;
+
+            if ((end_handle != 0xFFFF) && (p_db_discovery->srv_found_mask != all_mask))
+            {
+                next_handle = end_handle + 1;
+            }
+        }
+    }
+
+    if (next_handle != 0)
+    {
+        uint32_t err_code = srv_sweep_request(p_db_discovery, next_handle, p_ble_gattc_evt->conn_handle);
+
+        if (err_code != NRF_SUCCESS)
+        {
+            discovery_error_handler(err_code, p_db_discovery, p_ble_gattc_evt->conn_handle);
+        }
+
+        return;
+    }
+
+    srv_sweep_completion(p_db_discovery, p_ble_gattc_evt->conn_handle);
 }
+#endif // NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
 
 
 /**@brief     Function for handling service discovery completion.
@@ -286,6 +738,14 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
 
     p_db_discovery->discoveries_count++;
 
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+    if (is_srv_sweep())
+    {
+        srv_sweep_next(p_db_discovery, p_db_discovery->curr_srv_ind + 1, conn_handle);
+        return;
+    }
+#endif
+
     // Check if more services need to be discovered.
     if (p_db_discovery->discoveries_count < m_num_of_handlers_reg)
     {
@@ -316,7 +776,7 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
         db_srv_disc_req.error_handler.p_ctx                = p_db_discovery;
         db_srv_disc_req.error_handler.cb                   = discovery_error_handler;
 
-        err_code = nrf_ble_gq_item_add(mp_gatt_queue, &db_srv_disc_req, conn_handle);
+        err_code = discovery_req_add(&db_srv_disc_req, conn_handle);
 
         if (err_code != NRF_SUCCESS)
         {
@@ -328,9 +788,7 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
     else
     {
         // No more service discovery is needed.
-        p_db_discovery->discovery_in_progress  = false;
-
-        discovery_available_evt_trigger(p_db_discovery, conn_handle);
+        all_srv_disc_completion(p_db_discovery, conn_handle);
     }
 }
 
@@ -477,7 +935,7 @@ static uint32_t characteristics_discover(ble_db_discovery_t * p_db_discovery,
     db_char_disc_req.error_handler.p_ctx    = p_db_discovery;
     db_char_disc_req.error_handler.cb       = discovery_error_handler;
 
-    return nrf_ble_gq_item_add(mp_gatt_queue, &db_char_disc_req, conn_handle);
+    return discovery_req_add(&db_char_disc_req, conn_handle);
 }
 
 
@@ -575,7 +1033,7 @@ static uint32_t descriptors_discover(ble_db_discovery_t * p_db_discovery,
     db_desc_disc_req.error_handler.p_ctx    = p_db_discovery;
     db_desc_disc_req.error_handler.cb       = discovery_error_handler;
 
-    return nrf_ble_gq_item_add(mp_gatt_queue, &db_desc_disc_req, conn_handle);
+    return discovery_req_add(&db_desc_disc_req, conn_handle);
 }
 
 
@@ -599,6 +1057,14 @@ static void on_primary_srv_discovery_rsp(ble_db_discovery_t       * p_db_discove
         return;
     }
 
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+    if (is_srv_sweep())
+    {
+        on_srv_sweep_rsp(p_db_discovery, p_ble_gattc_evt);
+        return;
+    }
+#endif
+
     if (p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS)
     {
         uint32_t err_code;
@@ -893,6 +1359,15 @@ uint32_t ble_db_discovery_init(ble_db_discovery_init_t * p_db_init)
     m_evt_handler           = p_db_init->evt_handler;
     mp_gatt_queue           = p_db_init->p_gatt_queue;
 
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+    if (!m_cache_pm_registered)
+    {
+        err_code = pm_register(cache_pm_evt_handler);
+        VERIFY_SUCCESS(err_code);
+
+        m_cache_pm_registered = true;
+    }
+#endif
 
     return err_code;
 }
@@ -900,9 +1375,13 @@ uint32_t ble_db_discovery_init(ble_db_discovery_init_t * p_db_init)
 
 uint32_t ble_db_discovery_close(ble_db_discovery_t * const p_db_discovery)
 {
-    m_num_of_handlers_reg                 = 0;
-    m_initialized                         = false;
+    m_num_of_handlers_reg = 0;
+    m_initialized         = false;
+#if !NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
     p_db_discovery->pending_usr_evt_index = 0;
+#else
+    UNUSED_PARAMETER(p_db_discovery);
+#endif
 
     return NRF_SUCCESS;
 }
@@ -913,29 +1392,47 @@ uint32_t ble_db_discovery_evt_register(ble_uuid_t const * p_uuid)
     VERIFY_PARAM_NOT_NULL(p_uuid);
     VERIFY_MODULE_INITIALIZED();
 
-    return registered_handler_set(p_uuid, m_evt_handler);
+    return registered_handler_set(p_uuid, m_evt_handler, 0);
 }
 
 
-static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery, uint16_t conn_handle)
+uint32_t ble_db_discovery_evt_register_prio(ble_uuid_t const * p_uuid, uint8_t prio)
+{
+    VERIFY_PARAM_NOT_NULL(p_uuid);
+    VERIFY_MODULE_INITIALIZED();
+
+    return registered_handler_set(p_uuid, m_evt_handler, prio);
+}
+
+
+/**@brief     Function for starting the discovery of the first registered service.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ *
+ * @return    Error code returned by @ref discovery_req_add.
+ */
+static uint32_t first_srv_discover(ble_db_discovery_t * const p_db_discovery, uint16_t conn_handle)
 {
-    ret_code_t          err_code;
     ble_gatt_db_srv_t * p_srv_being_discovered;
     nrf_ble_gq_req_t    db_srv_disc_req;
 
-    memset(p_db_discovery, 0x00, sizeof(ble_db_discovery_t));
     memset(&db_srv_disc_req, 0x00, sizeof(nrf_ble_gq_req_t));
 
-    err_code = nrf_ble_gq_conn_handle_register(mp_gatt_queue, conn_handle);
-    VERIFY_SUCCESS(err_code);
-
-    p_db_discovery->conn_handle = conn_handle;
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+    if (is_srv_sweep())
+    {
+        for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+        {
+            p_db_discovery->services[i].srv_uuid = m_registered_handlers[i];
+        }
 
-    p_db_discovery->pending_usr_evt_index = 0;
+        NRF_LOG_DEBUG("Starting discovery of %d services on connection handle 0x%x.",
+                      m_num_of_handlers_reg, conn_handle);
 
-    p_db_discovery->discoveries_count = 0;
-    p_db_discovery->curr_srv_ind      = 0;
-    p_db_discovery->curr_char_ind     = 0;
+        return srv_sweep_request(p_db_discovery, SRV_DISC_START_HANDLE, conn_handle);
+    }
+#endif
 
     p_srv_being_discovered = &(p_db_discovery->services[p_db_discovery->curr_srv_ind]);
     p_srv_being_discovered->srv_uuid = m_registered_handlers[p_db_discovery->curr_srv_ind];
@@ -949,7 +1446,329 @@ static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery, uint1
     db_srv_disc_req.error_handler.p_ctx                = p_db_discovery;
     db_srv_disc_req.error_handler.cb                   = discovery_error_handler;
 
-    err_code = nrf_ble_gq_item_add(mp_gatt_queue, &db_srv_disc_req, conn_handle);
+    return discovery_req_add(&db_srv_disc_req, conn_handle);
+}
+
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+/**@brief     Function for loading the stored database of a peer and checking if it can be used.
+ *
+ * @details   The stored database is used if it was discovered for the same registered services
+ *            and if the Database Hash of the peer did not change. If the peer has no Database Hash,
+ *            the stored database stays valid until @ref ble_db_discovery_cache_invalidate is
+ *            called.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] peer_id        Peer ID of the bonded peer.
+ *
+ * @retval    True If the database was loaded into @ref m_cache_record and can be used.
+ * @retval    False Otherwise.
+ */
+static bool cache_load(ble_db_discovery_t const * p_db_discovery, pm_peer_id_t peer_id)
+{
+    ret_code_t err_code;
+    uint32_t   len = sizeof(m_cache_record);
+
+    if (m_cache_store_in_progress)
+    {
+        // The buffer holds the database being written.
+        return false;
+    }
+
+    err_code = pm_peer_data_load(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, &m_cache_record, &len);
+
+    if (   (err_code != NRF_SUCCESS)
+        || (len != sizeof(m_cache_record))
+        || (m_cache_record.tag != DB_CACHE_TAG)
+        || (m_cache_record.srv_reg_count != m_num_of_handlers_reg))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        if (!BLE_UUID_EQ(&m_cache_record.services[i].srv_uuid, &m_registered_handlers[i]))
+        {
+            return false;
+        }
+    }
+
+    if (m_cache_record.db_hash_valid != p_db_discovery->db_hash_valid)
+    {
+        return false;
+    }
+
+    return (!p_db_discovery->db_hash_valid ||
+            (memcmp(m_cache_record.db_hash, p_db_discovery->db_hash, BLE_DB_DISCOVERY_DB_HASH_LEN) == 0));
+}
+
+
+/**@brief     Function for replaying the database loaded into @ref m_cache_record.
+ *
+ * @details   The same events as in a full discovery are sent to the application.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ */
+static void cache_replay(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    NRF_LOG_DEBUG("Using the stored database on connection handle 0x%x.", conn_handle);
+
+    memcpy(p_db_discovery->services, m_cache_record.services, sizeof(p_db_discovery->services));
+
+    p_db_discovery->srv_count      = m_cache_record.srv_count;
+    p_db_discovery->srv_found_mask = 0;
+
+    for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        p_db_discovery->curr_srv_ind = i;
+        discovery_complete_evt_trigger(p_db_discovery,
+                                       (m_cache_record.srv_found_mask & (1 << i)) != 0,
+                                       conn_handle);
+        p_db_discovery->discoveries_count++;
+    }
+
+    discovery_finish(p_db_discovery, conn_handle);
+}
+
+
+/**@brief     Function for resolving the discovery once the Database Hash read has completed.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ */
+static void db_hash_read_completion(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    uint32_t     err_code;
+    pm_peer_id_t peer_id = PM_PEER_ID_INVALID;
+
+    p_db_discovery->db_hash_read_pending = false;
+
+    (void)pm_peer_id_get(conn_handle, &peer_id);
+
+    if ((peer_id != PM_PEER_ID_INVALID) && cache_load(p_db_discovery, peer_id))
+    {
+        cache_replay(p_db_discovery, conn_handle);
+        return;
+    }
+
+    err_code = first_srv_discover(p_db_discovery, conn_handle);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        discovery_error_handler(err_code, p_db_discovery, conn_handle);
+    }
+}
+
+
+/**@brief Function for handling errors of the Database Hash read.
+ *
+ * @details The database is then discovered without a Database Hash.
+ *
+ * @param[in] nrf_error   Error code.
+ * @param[in] p_ctx       Parameter from the event handler.
+ * @param[in] conn_handle Connection handle.
+ */
+static void db_hash_read_error_handler(uint32_t   nrf_error,
+                                       void     * p_ctx,
+                                       uint16_t   conn_handle)
+{
+    NRF_LOG_DEBUG("Database Hash read failed, error 0x%x.", nrf_error);
+
+    db_hash_read_completion((ble_db_discovery_t *)p_ctx, conn_handle);
+}
+
+
+/**@brief     Function for reading the Database Hash characteristic of the peer.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ *
+ * @return    Error code returned by @ref discovery_req_add.
+ */
+static uint32_t db_hash_read(ble_db_discovery_t * const p_db_discovery, uint16_t conn_handle)
+{
+    uint32_t                                   err_code;
+    nrf_ble_gq_req_t                           db_hash_read_req;
+    nrf_ble_gq_gattc_char_val_by_uuid_read_t * p_params;
+
+    memset(&db_hash_read_req, 0x00, sizeof(nrf_ble_gq_req_t));
+
+    p_params = &db_hash_read_req.params.gattc_char_val_by_uuid_read;
+
+    db_hash_read_req.type                = NRF_BLE_GQ_REQ_CHAR_VAL_BY_UUID_READ;
+    db_hash_read_req.error_handler.p_ctx = p_db_discovery;
+    db_hash_read_req.error_handler.cb    = db_hash_read_error_handler;
+
+    p_params->uuid.type                 = BLE_UUID_TYPE_BLE;
+    p_params->uuid.uuid                 = DB_HASH_UUID;
+    p_params->handle_range.start_handle = SRV_DISC_START_HANDLE;
+    p_params->handle_range.end_handle   = 0xFFFF;
+
+    err_code = discovery_req_add(&db_hash_read_req, conn_handle);
+
+    if (err_code == NRF_SUCCESS)
+    {
+        p_db_discovery->db_hash_read_pending = true;
+    }
+
+    return err_code;
+}
+
+
+/**@brief     Function for handling the response to the Database Hash read.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_db_hash_read_rsp(ble_db_discovery_t       * p_db_discovery,
+                                ble_gattc_evt_t    const * p_ble_gattc_evt)
+{
+    ble_gattc_evt_char_val_by_uuid_read_rsp_t const * p_rsp;
+
+    if (   (p_ble_gattc_evt->conn_handle != p_db_discovery->conn_handle)
+        || !p_db_discovery->db_hash_read_pending)
+    {
+        return;
+    }
+
+    p_rsp = &(p_ble_gattc_evt->params.char_val_by_uuid_read_rsp);
+
+    if (   (p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS)
+        && (p_rsp->count > 0)
+        && (p_rsp->value_len == BLE_DB_DISCOVERY_DB_HASH_LEN))
+    {
+        // The list starts with the attribute handle, followed by the value.
+        memcpy(p_db_discovery->db_hash,
+               &(p_rsp->handle_value[sizeof(uint16_t)]),
+               BLE_DB_DISCOVERY_DB_HASH_LEN);
+
+        p_db_discovery->db_hash_valid = true;
+    }
+
+    db_hash_read_completion(p_db_discovery, p_ble_gattc_evt->conn_handle);
+}
+
+
+uint32_t ble_db_discovery_cache_invalidate(pm_peer_id_t peer_id)
+{
+    uint32_t err_code = pm_peer_data_delete(peer_id, PM_PEER_DATA_ID_GATT_REMOTE);
+
+    return (err_code == NRF_ERROR_NOT_FOUND) ? NRF_SUCCESS : err_code;
+}
+
+
+/**@brief     Function for checking if a handle is the value handle of the Service Changed
+ *            characteristic in the discovered database.
+ *
+ * @details   The Service Changed characteristic is known only if the GATT Service is registered.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] handle         Attribute handle.
+ *
+ * @retval    True If the handle is the Service Changed value handle.
+ * @retval    False Otherwise.
+ */
+static bool is_srv_changed_handle(ble_db_discovery_t const * p_db_discovery, uint16_t handle)
+{
+    for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        ble_gatt_db_srv_t const * p_srv = &(p_db_discovery->services[i]);
+
+        if ((p_srv->srv_uuid.type != BLE_UUID_TYPE_BLE) || (p_srv->srv_uuid.uuid != BLE_UUID_GATT))
+        {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < p_srv->char_count; j++)
+        {
+            ble_gattc_char_t const * p_char = &(p_srv->charateristics[j].characteristic);
+
+            if (   (p_char->uuid.type == BLE_UUID_TYPE_BLE)
+                && (p_char->uuid.uuid == BLE_UUID_GATT_CHARACTERISTIC_SERVICE_CHANGED)
+                && (p_char->handle_value == handle))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+/**@brief     Function for handling a Service Changed indication.
+ *
+ * @details   The stored database of the peer is invalidated, so that the peer is fully discovered
+ *            on the next connection.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_hvx(ble_db_discovery_t       * p_db_discovery,
+                   ble_gattc_evt_t    const * p_ble_gattc_evt)
+{
+    uint32_t     err_code;
+    pm_peer_id_t peer_id = PM_PEER_ID_INVALID;
+
+    if (   (p_ble_gattc_evt->conn_handle != p_db_discovery->conn_handle)
+        || (p_ble_gattc_evt->params.hvx.type != BLE_GATT_HVX_INDICATION)
+        || !is_srv_changed_handle(p_db_discovery, p_ble_gattc_evt->params.hvx.handle))
+    {
+        return;
+    }
+
+    (void)pm_peer_id_get(p_ble_gattc_evt->conn_handle, &peer_id);
+
+    if (peer_id == PM_PEER_ID_INVALID)
+    {
+        // A database discovered before bonding must not be stored any more.
+        cache_pending_remove(p_db_discovery);
+        return;
+    }
+
+    NRF_LOG_DEBUG("Service Changed, invalidating the database of peer %d.", peer_id);
+
+    err_code = ble_db_discovery_cache_invalidate(peer_id);
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_WARNING("Could not invalidate the database of peer %d, error 0x%x.",
+                        peer_id,
+                        err_code);
+    }
+}
+#endif // NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+
+
+static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery, uint16_t conn_handle)
+{
+    ret_code_t err_code;
+
+    memset(p_db_discovery, 0x00, sizeof(ble_db_discovery_t));
+
+    err_code = nrf_ble_gq_conn_handle_register(mp_gatt_queue, conn_handle);
+    VERIFY_SUCCESS(err_code);
+
+    p_db_discovery->conn_handle = conn_handle;
+
+#if !NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+    p_db_discovery->pending_usr_evt_index = 0;
+#endif
+
+    p_db_discovery->discoveries_count = 0;
+    p_db_discovery->curr_srv_ind      = 0;
+    p_db_discovery->curr_char_ind     = 0;
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+    p_db_discovery->start_ticks = app_timer_cnt_get();
+#endif
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+    // The Database Hash decides whether the stored database can be used.
+    err_code = db_hash_read(p_db_discovery, conn_handle);
+#else
+    err_code = first_srv_discover(p_db_discovery, conn_handle);
+#endif
 
     if (err_code == NRF_SUCCESS)
     {
@@ -992,6 +1811,11 @@ static void on_disconnected(ble_db_discovery_t       * p_db_discovery,
     {
         p_db_discovery->discovery_in_progress = false;
         p_db_discovery->conn_handle           = BLE_CONN_HANDLE_INVALID;
+
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+        p_db_discovery->db_hash_read_pending = false;
+        cache_pending_remove(p_db_discovery);
+#endif
     }
 }
 
@@ -1019,6 +1843,16 @@ void ble_db_discovery_on_ble_evt(ble_evt_t const * p_ble_evt,
             on_descriptor_discovery_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
             break;
 
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+        case BLE_GATTC_EVT_CHAR_VAL_BY_UUID_READ_RSP:
+            on_db_hash_read_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+
+        case BLE_GATTC_EVT_HVX:
+            on_hvx(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+#endif
+
         case BLE_GAP_EVT_DISCONNECTED:
             on_disconnected(p_db_discovery, &(p_ble_evt->evt.gap_evt));
             break;
@@ -64,6 +64,25 @@
  * @note The application must propagate BLE stack events to this module by calling
  *       ble_db_discovery_on_ble_evt().
  *
+ * @note When BLE_DB_DISCOVERY_CACHE_ENABLED is set, the discovered database of a bonded peer is
+ *       stored through the Peer Manager (@ref PM_PEER_DATA_ID_GATT_REMOTE). On reconnection, the
+ *       Database Hash characteristic of the peer is read and, if it matches the stored value, the
+ *       stored handles are replayed through the same events instead of running a new discovery.
+ *       For peers without a Database Hash, the stored database stays in use until the peer
+ *       indicates Service Changed. The module invalidates the stored database on a Service Changed
+ *       indication only if the GATT Service (@ref BLE_UUID_GATT) is registered with
+ *       @ref ble_db_discovery_evt_register. Enabling the indication and confirming it remain
+ *       the task of the application. If the GATT Service is not registered, the application
+ *       must call @ref ble_db_discovery_cache_invalidate on a Service Changed indication,
+ *       otherwise stale handles of a changed peer keep being used.
+ *
+ * @note When BLE_DB_DISCOVERY_SCHED_ENABLED is set, all registered services are located with one
+ *       sweep of the primary services of the peer, discovery requests are queued in the high
+ *       priority lane of @ref nrf_ble_gq (if NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE is not 0), and each
+ *       service is reported as soon as it has been discovered. User modules can then start using
+ *       their services earlier, and the discovery does not wait behind application requests
+ *       queued on the link.
+ *
  */
 
 #ifndef BLE_DB_DISCOVERY_H__
@@ -76,6 +95,12 @@
 #include "ble_gattc.h"
 #include "ble_gatt_db.h"
 #include "nrf_ble_gq.h"
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+#include "app_timer.h"
+#endif
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+#include "peer_manager_types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -124,6 +149,7 @@ NRF_SDH_BLE_OBSERVERS(_name ## _obs,
 #endif //!(defined(__LINT__))
 
 #define BLE_DB_DISCOVERY_MAX_SRV        6   /**< Maximum number of services supported by this module. This also indicates the maximum number of users allowed to be registered to this module (one user per service). */
+#define BLE_DB_DISCOVERY_DB_HASH_LEN    16  /**< Length of the Database Hash characteristic value. */
 
 
 /**@brief DB Discovery event type. */
@@ -174,8 +200,21 @@ typedef struct
     uint8_t                     discoveries_count;                          /**< Number of service discoveries made, both successful and unsuccessful. */
     bool                        discovery_in_progress;                      /**< Variable to indicate whether there is a service discovery in progress. */
     uint16_t                    conn_handle;                                /**< Connection handle on which the discovery is started. */
+#if !NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
     uint32_t                    pending_usr_evt_index;                      /**< The index to the pending user event array, pointing to the last added pending user event. */
-    ble_db_discovery_user_evt_t pending_usr_evts[BLE_DB_DISCOVERY_MAX_SRV]; /**< Whenever a discovery related event is to be raised to a user module, it is stored in this array first. When all expected services have been discovered, all pending events are sent to the corresponding user modules. */
+    ble_db_discovery_user_evt_t pending_usr_evts[BLE_DB_DISCOVERY_MAX_SRV]; /**< Whenever a discovery related event is to be raised to a user module, it is stored in this array first. When all expected services have been discovered, all pending events are sent to the corresponding user modules. Not present with BLE_DB_DISCOVERY_SCHED_ENABLED, which reports each service as soon as it is discovered. */
+#endif
+    uint8_t                     srv_found_mask;                             /**< Bitmask of the registered services that were found at the peer. */
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+    uint32_t                    start_ticks;                                /**< Time when the discovery was started, in app_timer ticks. This is intended for internal use. */
+    uint32_t                    duration_ticks;                             /**< Time from @ref ble_db_discovery_start to the end of the discovery, in app_timer ticks. Valid when @ref BLE_DB_DISCOVERY_AVAILABLE is raised. */
+#endif
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+    uint8_t                     db_hash[BLE_DB_DISCOVERY_DB_HASH_LEN];      /**< Database Hash read from the peer. This is intended for internal use by the discovery cache. */
+    bool                        db_hash_valid;                              /**< Variable to indicate whether the peer exposed a Database Hash. */
+    bool                        db_hash_read_pending;                       /**< Variable to indicate whether the Database Hash read is in progress. */
+    bool                        cache_store_pending;                        /**< Variable to indicate that the discovered database is to be stored once the peer is bonded. */
+#endif
 } ble_db_discovery_t;
 
 /**@brief DB discovery module initialization struct. */
@@ -187,12 +226,17 @@ typedef struct
 
 
 /**@brief Function for initializing the DB Discovery module.
+ *
+ * @note When BLE_DB_DISCOVERY_CACHE_ENABLED is set, the Peer Manager must be initialized before
+ *       this function is called.
  *
  * @param[in] p_db_init   Pointer to DB discovery initialization structure.
  *
  * @retval NRF_SUCCESS    On successful initialization.
  * @retval NRF_ERROR_NULL If the initialization structure was NULL or
  *                        the structure content is empty.
+ * @return                If the discovery cache is enabled, this API propagates the error code
+ *                        returned by @ref pm_register.
  */
 uint32_t ble_db_discovery_init(ble_db_discovery_init_t * p_db_init);
 
@@ -232,6 +276,25 @@ uint32_t ble_db_discovery_close(ble_db_discovery_t * const p_db_discovery);
 uint32_t ble_db_discovery_evt_register(const ble_uuid_t * const p_uuid);
 
 
+/**@brief Function for registering with the DB Discovery module with a discovery priority.
+ *
+ * @details Works like @ref ble_db_discovery_evt_register. Services with a higher @p prio are
+ *          discovered and reported first. Services with the same priority are discovered in
+ *          the order of registration. @ref ble_db_discovery_evt_register uses priority 0.
+ *
+ * @param[in] p_uuid Pointer to the UUID of the service to be discovered at the server.
+ * @param[in] prio   Discovery priority of the service.
+ *
+ * @retval NRF_SUCCESS             Operation success.
+ * @retval NRF_ERROR_NULL          When a NULL pointer is passed as input.
+ * @retval NRF_ERROR_INVALID_STATE If this function is called without calling the
+ *                                 @ref ble_db_discovery_init.
+ * @retval NRF_ERROR_NO_MEM        The maximum number of registrations allowed by this module
+ *                                 has been reached.
+ */
+uint32_t ble_db_discovery_evt_register_prio(ble_uuid_t const * p_uuid, uint8_t prio);
+
+
 /**@brief Function for starting the discovery of the GATT database at the server.
  *
  * @param[out] p_db_discovery Pointer to the DB Discovery structure.
@@ -253,6 +316,26 @@ uint32_t ble_db_discovery_start(ble_db_discovery_t * p_db_discovery,
                                 uint16_t             conn_handle);
 
 
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_CACHE)
+/**@brief Function for invalidating the stored database of a peer.
+ *
+ * @details Call this function when the peer indicates that its database has changed, for example
+ *          on a Service Changed indication. The next discovery on this peer will be a full
+ *          discovery. The module calls this function itself on a Service Changed indication if
+ *          the GATT Service is registered.
+ *
+ * @note     For peers without a Database Hash, this is the only way to drop stale handles.
+ *
+ * @param[in] peer_id Peer ID of the bonded peer.
+ *
+ * @retval NRF_SUCCESS If the stored database was scheduled for deletion, or if none was stored.
+ * @return             Otherwise, this API propagates the error code returned by
+ *                     @ref pm_peer_data_delete.
+ */
+uint32_t ble_db_discovery_cache_invalidate(pm_peer_id_t peer_id);
+#endif
+
+
 /**@brief Function for handling the Application's BLE Stack events.
  *
  * @param[in]     p_ble_evt Pointer to the BLE event received.
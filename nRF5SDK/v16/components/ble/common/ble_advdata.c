@@ -457,7 +457,8 @@ static ret_code_t manuf_specific_data_encode(const ble_advdata_manuf_data_t * p_
 static ret_code_t service_data_encode(const ble_advdata_t * p_advdata,
                                       uint8_t             * p_encoded_data,
                                       uint16_t            * p_offset,
-                                      uint16_t              max_size)
+                                      uint16_t              max_size,
+                                      uint16_t            * p_data_offsets)
 {
     uint8_t i;
 
@@ -476,6 +477,12 @@ static ret_code_t service_data_encode(const ble_advdata_t * p_advdata,
         // For now implemented only for 16-bit UUIDs
         data_size      = AD_TYPE_SERV_DATA_16BIT_UUID_SIZE + p_service_data->data.size;
 
+        // Check for buffer overflow.
+        if (((*p_offset) + AD_DATA_OFFSET + data_size) > max_size)
+        {
+            return NRF_ERROR_DATA_SIZE;
+        }
+
         // There is only 1 byte intended to encode length which is (data_size + AD_TYPE_FIELD_SIZE)
         if (data_size > (0x00FF - AD_TYPE_FIELD_SIZE))
         {
@@ -491,6 +498,11 @@ static ret_code_t service_data_encode(const ble_advdata_t * p_advdata,
         // Encode service 16-bit UUID.
         *p_offset += uint16_encode(p_service_data->service_uuid, &p_encoded_data[*p_offset]);
 
+        if ((p_data_offsets != NULL) && (i < BLE_ADVDATA_LAYOUT_SERVICE_DATA_MAX))
+        {
+            p_data_offsets[i] = *p_offset;
+        }
+
         // Encode additional service data.
         if (p_service_data->data.size > 0)
         {
@@ -506,9 +518,10 @@ static ret_code_t service_data_encode(const ble_advdata_t * p_advdata,
     return NRF_SUCCESS;
 }
 
-ret_code_t ble_advdata_encode(ble_advdata_t const * const p_advdata,
-                              uint8_t             * const p_encoded_data,
-                              uint16_t            * const p_len)
+static ret_code_t advdata_encode(ble_advdata_t const  * const p_advdata,
+                                 uint8_t              * const p_encoded_data,
+                                 uint16_t             * const p_len,
+                                 ble_advdata_layout_t * const p_layout)
 {
     ret_code_t err_code = NRF_SUCCESS;
     uint16_t   max_size = *p_len;
@@ -543,6 +556,11 @@ ret_code_t ble_advdata_encode(ble_advdata_t const * const p_advdata,
                                          p_len,
                                          max_size);
         VERIFY_SUCCESS(err_code);
+
+        if (p_layout != NULL)
+        {
+            p_layout->tx_power_level = *p_len - AD_TYPE_TX_POWER_LEVEL_DATA_SIZE;
+        }
     }
 
     // Encode 'more available' uuid list.
@@ -596,26 +614,68 @@ ret_code_t ble_advdata_encode(ble_advdata_t const * const p_advdata,
                                               p_len,
                                               max_size);
         VERIFY_SUCCESS(err_code);
+
+        if (p_layout != NULL)
+        {
+            p_layout->manuf_specific_data = *p_len - p_advdata->p_manuf_specific_data->data.size;
+        }
     }
 
     // Encode Service Data.
     if (p_advdata->service_data_count > 0)
     {
-        err_code = service_data_encode(p_advdata, p_encoded_data, p_len, max_size);
+        err_code = service_data_encode(p_advdata,
+                                       p_encoded_data,
+                                       p_len,
+                                       max_size,
+                                       (p_layout != NULL) ? p_layout->service_data : NULL);
         VERIFY_SUCCESS(err_code);
     }
 
     // Encode name. WARNING: it is encoded last on purpose since too long device name is truncated.
     if (p_advdata->name_type != BLE_ADVDATA_NO_NAME)
     {
+        uint16_t name_offset = *p_len + AD_DATA_OFFSET;
+
         err_code = name_encode(p_advdata, p_encoded_data, p_len, max_size);
         VERIFY_SUCCESS(err_code);
+
+        if (p_layout != NULL)
+        {
+            p_layout->name = name_offset;
+        }
+    }
+
+    if (p_layout != NULL)
+    {
+        p_layout->len = *p_len;
     }
 
     return err_code;
 }
 
 
+ret_code_t ble_advdata_encode(ble_advdata_t const * const p_advdata,
+                              uint8_t             * const p_encoded_data,
+                              uint16_t            * const p_len)
+{
+    return advdata_encode(p_advdata, p_encoded_data, p_len, NULL);
+}
+
+
+ret_code_t ble_advdata_encode_layout(ble_advdata_t const  * const p_advdata,
+                                     uint8_t              * const p_encoded_data,
+                                     uint16_t             * const p_len,
+                                     ble_advdata_layout_t * const p_layout)
+{
+    VERIFY_PARAM_NOT_NULL(p_layout);
+
+    memset(p_layout, 0xFF, sizeof(ble_advdata_layout_t));
+
+    return advdata_encode(p_advdata, p_encoded_data, p_len, p_layout);
+}
+
+
 uint16_t ble_advdata_search(uint8_t const * p_encoded_data,
                             uint16_t        data_len,
                             uint16_t      * p_offset,
@@ -86,6 +86,12 @@ extern "C" {
 
 #define BLE_ADV_DATA_MATCH_FULL_NAME       0xff
 
+#define BLE_ADVDATA_OFFSET_INVALID         0xFFFF                              /**< Offset value of a field that is not present in the encoded data. */
+
+#ifndef BLE_ADVDATA_LAYOUT_SERVICE_DATA_MAX
+#define BLE_ADVDATA_LAYOUT_SERVICE_DATA_MAX 4                                  /**< Number of Service Data payload offsets recorded by @ref ble_advdata_encode_layout. */
+#endif
+
 
 /**@brief Security Manager TK value. */
 typedef struct
@@ -164,6 +170,23 @@ typedef struct
     ble_gap_lesc_oob_data_t *    p_lesc_data;                         /**< LE Secure Connections OOB data. Included when different from NULL. @warning This field can be used only for NFC. For BLE advertising, set it to NULL.*/
 } ble_advdata_t;
 
+/**@brief Layout of encoded Advertising data.
+ *
+ * @details Holds the offsets, within the encoded buffer, of the field values that typically change
+ *          while advertising. Each offset points at the first byte of the value (past the length,
+ *          AD type, and identifier octets), so that the value can be overwritten in place without
+ *          encoding the whole payload again. Fields that are not present are set to
+ *          @ref BLE_ADVDATA_OFFSET_INVALID.
+ */
+typedef struct
+{
+    uint16_t tx_power_level;                                    /**< Offset of the TX Power Level value. */
+    uint16_t manuf_specific_data;                               /**< Offset of the additional manufacturer specific data (after the Company Identifier). */
+    uint16_t service_data[BLE_ADVDATA_LAYOUT_SERVICE_DATA_MAX]; /**< Offsets of the additional service data (after the 16-bit UUID), in the order of @ref ble_advdata_t::p_service_data_array. */
+    uint16_t name;                                              /**< Offset of the device name. */
+    uint16_t len;                                               /**< Total length of the encoded data. */
+} ble_advdata_layout_t;
+
 /**@brief Function for encoding data in the Advertising and Scan Response data format (AD structures).
  *
  * @details This function encodes data into the Advertising and Scan Response data format
@@ -197,6 +220,27 @@ ret_code_t ble_advdata_encode(ble_advdata_t const * const p_advdata,
                               uint16_t            * const p_len);
 
 
+/**@brief Function for encoding Advertising data and recording the layout of the encoded fields.
+ *
+ * @details This function produces the same output as @ref ble_advdata_encode and additionally fills
+ *          \p p_layout with the offsets of the field values that can later be patched in place,
+ *          e.g. with @ref ble_advertising_advdata_patch. Patched values must keep the length they
+ *          had when the layout was recorded.
+ *
+ * @param[in]      p_advdata       Pointer to the structure for specifying the content of encoded data.
+ * @param[out]     p_encoded_data  Pointer to the buffer where encoded data will be returned.
+ * @param[in,out]  p_len           \c in: Size of \p p_encoded_data buffer.
+ *                                 \c out: Length of encoded data.
+ * @param[out]     p_layout        Layout of the encoded data.
+ *
+ * @return Same values as @ref ble_advdata_encode.
+ */
+ret_code_t ble_advdata_encode_layout(ble_advdata_t const  * const p_advdata,
+                                     uint8_t              * const p_encoded_data,
+                                     uint16_t             * const p_len,
+                                     ble_advdata_layout_t * const p_layout);
+
+
 /**@brief Function for searching encoded Advertising or Scan Response data for specific data types.
  *
  * @details This function searches through encoded data e.g. the data produced by
@@ -52,6 +52,7 @@
 #define DEFAULT_FLAG_COLLECTION_COUNT 6                                /**< The number of flags kept for each connection, excluding user flags. */
 #define TOTAL_FLAG_COLLECTION_COUNT (DEFAULT_FLAG_COLLECTION_COUNT \
                                    + BLE_CONN_STATE_USER_FLAG_COUNT)   /**< The number of flags kept for each connection, including user flags. */
+#define CONN_FLAGS_MASK (UINT32_MAX >> (32 - BLE_CONN_STATE_MAX_CONNECTIONS))  /**< The flags that correspond to a connection index. */
 
 /**@brief Structure containing all the flag collections maintained by the Connection State module.
  */
@@ -84,7 +85,20 @@ typedef struct
 ANON_UNIONS_DISABLE;
 
 
-static ble_conn_state_t m_bcs = {0}; /**< Instantiation of the internal state. */
+/**@brief Structure containing the connection handle lists that are kept up to date on connect and
+ *        disconnect, so that they do not have to be built on every query.
+ */
+typedef struct
+{
+    volatile uint32_t                 seq;      /**< Incremented before and after each update, so it is odd while the lists are out of date. */
+    ble_conn_state_conn_handle_list_t valid;    /**< Handles of all valid connections. */
+    ble_conn_state_conn_handle_list_t central;  /**< Handles of connected links in the central role. */
+    ble_conn_state_conn_handle_list_t periph;   /**< Handles of connected links in the peripheral role. */
+} ble_conn_state_handle_lists_t;
+
+
+static ble_conn_state_t              m_bcs   = {0}; /**< Instantiation of the internal state. */
+static ble_conn_state_handle_lists_t m_lists = {0}; /**< Cached connection handle lists. */
 
 
 /**@brief Function for resetting all internal memory to the values it had at initialization.
@@ -92,23 +106,22 @@ static ble_conn_state_t m_bcs = {0}; /**< Instantiation of the internal state. *
 void bcs_internal_state_reset(void)
 {
     memset( &m_bcs, 0, sizeof(ble_conn_state_t) );
+    memset( &m_lists, 0, sizeof(ble_conn_state_handle_lists_t) );
 }
 
 
 ble_conn_state_conn_handle_list_t conn_handle_list_get(nrf_atflags_t flags)
 {
     ble_conn_state_conn_handle_list_t conn_handle_list;
+    uint32_t                          remaining = flags & CONN_FLAGS_MASK;
+
     conn_handle_list.len = 0;
 
-    if (flags != 0)
+    // Visit only the set flags, lowest first. The mask keeps the list within conn_handles[].
+    while (remaining != 0)
     {
-        for (uint32_t i = 0; i < BLE_CONN_STATE_MAX_CONNECTIONS; i++)
-        {
-            if (nrf_atflags_get(&flags, i))
-            {
-                conn_handle_list.conn_handles[conn_handle_list.len++] = i;
-            }
-        }
+        conn_handle_list.conn_handles[conn_handle_list.len++] = __CLZ(__RBIT(remaining));
+        remaining &= remaining - 1;
     }
 
     return conn_handle_list;
@@ -117,16 +130,71 @@ ble_conn_state_conn_handle_list_t conn_handle_list_get(nrf_atflags_t flags)
 
 uint32_t active_flag_count(nrf_atflags_t flags)
 {
-    uint32_t set_flag_count = 0;
+    uint32_t count = flags & CONN_FLAGS_MASK;
+
+    // Population count in parallel over bit pairs, nibbles and bytes.
+    count = count - ((count >> 1) & 0x55555555);
+    count = (count & 0x33333333) + ((count >> 2) & 0x33333333);
+    count = (count + (count >> 4)) & 0x0F0F0F0F;
+
+    return (count * 0x01010101) >> 24;
+}
+
+
+/**@brief Function for marking the cached connection handle lists as out of date.
+ *
+ * @details Must be called before the valid, connected or central flags are changed.
+ */
+static void handle_lists_invalidate(void)
+{
+    m_lists.seq++;
+    __DMB();
+}
+
 
-    for (uint32_t i = 0; i < BLE_CONN_STATE_MAX_CONNECTIONS; i++)
+/**@brief Function for rebuilding the cached connection handle lists from the flags.
+ */
+static void handle_lists_update(void)
+{
+    nrf_atflags_t connected_flags = m_bcs.flags.connected_flags;
+    nrf_atflags_t central_flags   = m_bcs.flags.central_flags;
+
+    m_lists.valid   = conn_handle_list_get(m_bcs.flags.valid_flags);
+    m_lists.central = conn_handle_list_get(connected_flags & central_flags);
+    m_lists.periph  = conn_handle_list_get(connected_flags & ~central_flags);
+
+    __DMB();
+    m_lists.seq++;
+}
+
+
+/**@brief Function for reading a cached connection handle list.
+ *
+ * @details The list is updated from the BLE event handler, which can be preempted by the caller.
+ *          If it was out of date or changed while it was copied, it is built from the flags
+ *          instead of waiting for the update to finish.
+ *
+ * @param[in]  p_list  The cached list.
+ * @param[in]  flags   The flags the list is built from.
+ *
+ * @return  A consistent copy of the list.
+ */
+static ble_conn_state_conn_handle_list_t handle_list_read(ble_conn_state_conn_handle_list_t const * p_list,
+                                                          nrf_atflags_t                             flags)
+{
+    uint32_t                          seq = m_lists.seq;
+    ble_conn_state_conn_handle_list_t conn_handle_list;
+
+    __DMB();
+    conn_handle_list = *p_list;
+    __DMB();
+
+    if (((seq & 1) != 0) || (seq != m_lists.seq))
     {
-        if (nrf_atflags_get(&flags, i))
-        {
-            set_flag_count += 1;
-        }
+        conn_handle_list = conn_handle_list_get(flags);
     }
-    return set_flag_count;
+
+    return conn_handle_list;
 }
 
 
@@ -232,6 +300,7 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
     switch (p_ble_evt->header.evt_id)
     {
         case BLE_GAP_EVT_CONNECTED:
+            handle_lists_invalidate();
             record_purge_disconnected();
 
             if ( !record_activate(conn_handle) )
@@ -245,10 +314,13 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
                 nrf_atflags_set(&m_bcs.flags.central_flags, conn_handle);
             }
 
+            handle_lists_update();
             break;
 
         case BLE_GAP_EVT_DISCONNECTED:
+            handle_lists_invalidate();
             record_set_disconnected(conn_handle);
+            handle_lists_update();
             break;
 
         case BLE_GAP_EVT_CONN_SEC_UPDATE:
@@ -371,7 +443,7 @@ uint32_t ble_conn_state_peripheral_conn_count(void)
 
 ble_conn_state_conn_handle_list_t ble_conn_state_conn_handles(void)
 {
-    return conn_handle_list_get(m_bcs.flags.valid_flags);
+    return handle_list_read(&m_lists.valid, m_bcs.flags.valid_flags);
 }
 
 
@@ -380,7 +452,7 @@ ble_conn_state_conn_handle_list_t ble_conn_state_central_handles(void)
     nrf_atflags_t central_conn_flags = m_bcs.flags.central_flags;
     UNUSED_RETURN_VALUE(nrf_atomic_u32_and(&central_conn_flags, m_bcs.flags.connected_flags));
 
-    return conn_handle_list_get(central_conn_flags);
+    return handle_list_read(&m_lists.central, central_conn_flags);
 }
 
 
@@ -389,7 +461,7 @@ ble_conn_state_conn_handle_list_t ble_conn_state_periph_handles(void)
     nrf_atflags_t peripheral_conn_flags = ~m_bcs.flags.central_flags;
     UNUSED_RETURN_VALUE(nrf_atomic_u32_and(&peripheral_conn_flags, m_bcs.flags.connected_flags));
 
-    return conn_handle_list_get(peripheral_conn_flags);
+    return handle_list_read(&m_lists.periph, peripheral_conn_flags);
 }
 
 
@@ -453,17 +525,14 @@ static uint32_t for_each_set_flag(nrf_atflags_t                  flags,
     }
 
     uint32_t call_count = 0;
+    uint32_t remaining  = flags & CONN_FLAGS_MASK;
 
-    if (flags != 0)
+    // Visit only the set flags, lowest first.
+    while (remaining != 0)
     {
-        for (uint32_t i = 0; i < BLE_CONN_STATE_MAX_CONNECTIONS; i++)
-        {
-            if (nrf_atflags_get(&flags, i))
-            {
-                user_function(i, p_context);
-                call_count += 1;
-            }
-        }
+        user_function(__CLZ(__RBIT(remaining)), p_context);
+        remaining  &= remaining - 1;
+        call_count += 1;
     }
     return call_count;
 }
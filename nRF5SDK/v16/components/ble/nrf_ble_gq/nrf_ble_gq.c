@@ -42,6 +42,9 @@
 #if NRF_MODULE_ENABLED(NRF_BLE_GQ)
 
 #include "nrf_ble_gq.h"
+#if NRF_BLE_GQ_STATS_ENABLED
+#include "app_timer.h"
+#endif
 
 #define NRF_LOG_MODULE_NAME nrf_ble_gq
 #include "nrf_log.h"
@@ -138,7 +141,8 @@ static const req_data_alloc_t m_req_data_alloc[NRF_BLE_GQ_REQ_NUM] =
     [NRF_BLE_GQ_REQ_SRV_DISCOVERY]  = NULL,
     [NRF_BLE_GQ_REQ_CHAR_DISCOVERY] = NULL,
     [NRF_BLE_GQ_REQ_DESC_DISCOVERY] = NULL,
-    [NRF_BLE_GQ_REQ_GATTS_HVX]      = gatts_hvx_alloc
+    [NRF_BLE_GQ_REQ_GATTS_HVX]      = gatts_hvx_alloc,
+    [NRF_BLE_GQ_REQ_CHAR_VAL_BY_UUID_READ] = NULL
 };
 
 
@@ -170,172 +174,130 @@ __STATIC_INLINE void request_err_code_handle(nrf_ble_gq_req_t const * const p_re
 }
 
 
-/**@brief Function processes subsequent requests from the BGQ instance queue.
+/**@brief Function checks if the SoftDevice asked to retry the request later.
  *
- * @param[in] p_queue      Pointer to the queue instance.
- * @param[in] conn_handle  Connection handle.
+ * @details NRF_ERROR_BUSY is returned while another GATT procedure is in progress and
+ *          NRF_ERROR_RESOURCES when the SoftDevice queue for notifications or write commands is
+ *          full. In both cases the request is retried on a later BLE event.
+ *
+ * @param[in] err_code Error code returned by SoftDevice.
  */
-static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handle)
+__STATIC_INLINE bool is_retry_needed(ret_code_t err_code)
 {
-    ret_code_t       err_code;
-    nrf_ble_gq_req_t ble_req;
+    return (err_code == NRF_ERROR_BUSY) || (err_code == NRF_ERROR_RESOURCES);
+}
 
-    NRF_LOG_DEBUG("Processing the request queue...");
 
-    err_code = nrf_queue_peek(p_queue, &ble_req);
-    if (err_code == NRF_SUCCESS) // Queue is not empty
+/**@brief Function returns the queue of a priority lane of a connection.
+ *
+ * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ * @param[in] conn_id      Connection ID.
+ * @param[in] prio         Priority lane.
+ *
+ * @return    Pointer to the queue instance, or NULL if the lane is compiled out.
+ */
+static nrf_queue_t const * lane_queue_get(nrf_ble_gq_t const * const p_gatt_queue,
+                                          uint16_t                   conn_id,
+                                          nrf_ble_gq_prio_t          prio)
+{
+#if NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE > 0
+    if (prio == NRF_BLE_GQ_PRIO_HIGH)
     {
-        switch (ble_req.type)
-        {
-            case NRF_BLE_GQ_REQ_GATTC_READ:
-                NRF_LOG_DEBUG("GATTC Read Request");
-                err_code = sd_ble_gattc_read(conn_handle,
-                                             ble_req.params.gattc_read.handle,
-                                             ble_req.params.gattc_read.offset);
-                break;
-
-            case NRF_BLE_GQ_REQ_GATTC_WRITE:
-            {
-                uint8_t write_data[NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN];
-
-                // Retrieve allocated data.
-                ble_req.params.gattc_write.p_value = write_data;
-                nrf_memobj_read(ble_req.p_mem_obj,
-                                (void *) ble_req.params.gattc_write.p_value,
-                                ble_req.params.gattc_write.len, 0);
-
-                NRF_LOG_DEBUG("GATTC Write Request");
-                err_code = sd_ble_gattc_write(conn_handle,
-                                              &ble_req.params.gattc_write);
-            } break;
-
-            case NRF_BLE_GQ_REQ_SRV_DISCOVERY:
-            {
-                NRF_LOG_DEBUG("GATTC Primary Service Discovery Request");
-                err_code = sd_ble_gattc_primary_services_discover(conn_handle,
-                                                                  ble_req.params.gattc_srv_disc.start_handle,
-                                                                  &ble_req.params.gattc_srv_disc.srvc_uuid);
-            } break;
+        return &p_gatt_queue->p_hi_req_queue[conn_id];
+    }
+#endif
+    return (prio == NRF_BLE_GQ_PRIO_NORMAL) ? &p_gatt_queue->p_req_queue[conn_id] : NULL;
+}
 
-            case NRF_BLE_GQ_REQ_CHAR_DISCOVERY:
-            {
-                NRF_LOG_DEBUG("GATTC Characteristic Discovery Request");
-                err_code = sd_ble_gattc_characteristics_discover(conn_handle,
-                                                                 &ble_req.params.gattc_char_disc);
-            } break;
 
-            case NRF_BLE_GQ_REQ_DESC_DISCOVERY:
-            {
-                NRF_LOG_DEBUG("GATTC Characteristic Descriptor Discovery Request")
-                err_code = sd_ble_gattc_descriptors_discover(conn_handle,
-                                                             &ble_req.params.gattc_desc_disc);
-            } break;
+/**@brief Function updates the link statistics after a request was passed to the SoftDevice.
+ *
+ * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ * @param[in] conn_id      Connection ID.
+ * @param[in] p_req        Pointer to the processed request.
+ * @param[in] queued       True if the request waited in the queue.
+ * @param[in] err_code     Error code returned by SoftDevice.
+ */
+static void stats_processed_update(nrf_ble_gq_t     const * const p_gatt_queue,
+                                   uint16_t                       conn_id,
+                                   nrf_ble_gq_req_t const * const p_req,
+                                   bool                           queued,
+                                   ret_code_t                     err_code)
+{
+#if NRF_BLE_GQ_STATS_ENABLED
+    nrf_ble_gq_stats_t * p_stats = &p_gatt_queue->p_stats[conn_id];
 
-            case NRF_BLE_GQ_REQ_GATTS_HVX:
-            {
-                uint8_t  hvx_data[NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN];
-                uint16_t len;
-                uint16_t hvx_len;
-
-                // Retrieve allocated data.
-                ble_req.params.gatts_hvx.p_data = hvx_data;
-                nrf_memobj_read(ble_req.p_mem_obj,
-                                (void *) &hvx_len,
-                                sizeof(uint16_t),
-                                0);
-                ble_req.params.gatts_hvx.p_len = &hvx_len;
-                nrf_memobj_read(ble_req.p_mem_obj,
-                                (void *) ble_req.params.gatts_hvx.p_data,
-                                *ble_req.params.gatts_hvx.p_len,
-                                sizeof(uint16_t));
-
-                len = hvx_len;
-
-                NRF_LOG_DEBUG("GATTS HVX");
-                err_code = sd_ble_gatts_hvx(conn_handle,
-                                            &ble_req.params.gatts_hvx);
-
-                if ((err_code == NRF_SUCCESS) &&
-                    (len != hvx_len))
-                {
-                    err_code = NRF_ERROR_DATA_SIZE;
-                }
-            } break;
+    p_stats->processed++;
+    if (err_code != NRF_SUCCESS)
+    {
+        p_stats->failed++;
+    }
 
-            default:
-                NRF_LOG_WARNING("Unimplemented GATT Request");
-                break;
-        }
+    if (queued)
+    {
+        uint32_t latency = app_timer_cnt_diff_compute(app_timer_cnt_get(), p_req->timestamp);
 
-        if (err_code == NRF_ERROR_BUSY) // Softdevice is processing another GATT request.
+        p_stats->latency_sum += latency;
+        if (latency > p_stats->latency_max)
         {
-            NRF_LOG_DEBUG("SD is currently busy. The GATT request procedure will be attempted \
-                          again later.");
-        }
-        else
-        {
-            // Remove last request descriptor from the queue and free data associated with it.
-            if (m_req_data_alloc[ble_req.type] != NULL)
-            {
-                nrf_memobj_free(ble_req.p_mem_obj);
-                NRF_LOG_DEBUG("Pointer to freed memory block: %p.", ble_req.p_mem_obj);
-            }
-            UNUSED_RETURN_VALUE(nrf_queue_pop(p_queue, &ble_req));
-
-            request_err_code_handle(&ble_req, conn_handle, err_code);
+            p_stats->latency_max = latency;
         }
     }
+#else
+    UNUSED_PARAMETER(p_gatt_queue);
+    UNUSED_PARAMETER(conn_id);
+    UNUSED_PARAMETER(p_req);
+    UNUSED_PARAMETER(queued);
+    UNUSED_PARAMETER(err_code);
+#endif
 }
 
 
-/**@brief Function purges all requests from BGQ instance queues that are
- *        no longer used by any connection.
+/**@brief Function updates the link statistics after a request was added to a queue.
  *
  * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ * @param[in] conn_id      Connection ID.
+ * @param[in] coalesced    True if the request replaced a queued request.
  */
-static void queues_purge(nrf_ble_gq_t const * const p_gatt_queue)
+static void stats_queued_update(nrf_ble_gq_t const * const p_gatt_queue,
+                                uint16_t                   conn_id,
+                                bool                       coalesced)
 {
-    ret_code_t err_code;
-    uint16_t   conn_id;
+#if NRF_BLE_GQ_STATS_ENABLED
+    nrf_ble_gq_stats_t * p_stats = &p_gatt_queue->p_stats[conn_id];
+    size_t               depth;
 
-    err_code = nrf_queue_pop(p_gatt_queue->p_purge_queue, &conn_id);
-
-    while (err_code == NRF_SUCCESS)
+    if (coalesced)
     {
-        nrf_ble_gq_req_t    ble_req;
-        nrf_queue_t const * p_queue;
-
-        NRF_LOG_DEBUG("Purging request queue with id: %d", conn_id);
-
-        p_queue  = &p_gatt_queue->p_req_queue[conn_id];
-        err_code = nrf_queue_pop(p_queue, &ble_req);
-
-        while (err_code == NRF_SUCCESS)
-        {
-            // Free data associated with this request if there is any.
-            if (m_req_data_alloc[ble_req.type] != NULL)
-            {
-                nrf_memobj_free(ble_req.p_mem_obj);
-                NRF_LOG_DEBUG("Pointer to freed memory block: %p.", ble_req.p_mem_obj);
-            }
-
-            err_code = nrf_queue_pop(p_queue, &ble_req);
-        }
+        p_stats->coalesced++;
+        return;
+    }
 
-        err_code = nrf_queue_pop(p_gatt_queue->p_purge_queue, &conn_id);
+    p_stats->queued++;
+    depth = nrf_queue_utilization_get(&p_gatt_queue->p_req_queue[conn_id]);
+#if NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE > 0
+    depth += nrf_queue_utilization_get(&p_gatt_queue->p_hi_req_queue[conn_id]);
+#endif
+    if (depth > p_stats->max_depth)
+    {
+        p_stats->max_depth = depth;
     }
+#else
+    UNUSED_PARAMETER(p_gatt_queue);
+    UNUSED_PARAMETER(conn_id);
+    UNUSED_PARAMETER(coalesced);
+#endif
 }
 
 
-/**@brief Function processes single GATT request without queue.
+/**@brief Function passes single GATT request to the SoftDevice.
  *
- * @param[in] p_req        Pointer to GATT request.
+ * @param[in] p_req        Pointer to GATT request. Data of the request must be in place.
  * @param[in] conn_handle  Connection handle.
  *
- * @retval  true   If request is accepted by Softdevice.
- * @retval  false  If Softdevice is busy and the request should be queued.
+ * @return    Error code returned by SoftDevice.
  */
-static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_handle)
+static ret_code_t request_submit(nrf_ble_gq_req_t const * const p_req, uint16_t conn_handle)
 {
     ret_code_t err_code = NRF_SUCCESS;
 
@@ -355,11 +317,20 @@ static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_
             break;
 
         case NRF_BLE_GQ_REQ_SRV_DISCOVERY:
+        {
+            ble_uuid_t const * p_srvc_uuid = &p_req->params.gattc_srv_disc.srvc_uuid;
+
+            if (p_srvc_uuid->type == BLE_UUID_TYPE_UNKNOWN)
+            {
+                // Discover all primary services.
+                p_srvc_uuid = NULL;
+            }
+
             NRF_LOG_DEBUG("GATTC Primary Services Discovery Request");
             err_code = sd_ble_gattc_primary_services_discover(conn_handle,
                                                               p_req->params.gattc_srv_disc.start_handle,
-                                                              &p_req->params.gattc_srv_disc.srvc_uuid);
-            break;
+                                                              p_srvc_uuid);
+        } break;
 
         case NRF_BLE_GQ_REQ_CHAR_DISCOVERY:
             NRF_LOG_DEBUG("GATTC Characteristic Discovery Request");
@@ -390,12 +361,176 @@ static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_
 
         } break;
 
+        case NRF_BLE_GQ_REQ_CHAR_VAL_BY_UUID_READ:
+            NRF_LOG_DEBUG("GATTC Read Using Characteristic UUID Request");
+            err_code = sd_ble_gattc_char_value_by_uuid_read(conn_handle,
+                                                            &p_req->params.gattc_char_val_by_uuid_read.uuid,
+                                                            &p_req->params.gattc_char_val_by_uuid_read.handle_range);
+            break;
+
         default:
             NRF_LOG_WARNING("Unimplemented GATT Request");
             break;
     }
 
-    if (err_code == NRF_ERROR_BUSY) // Softdevice is processing another GATT request.
+    return err_code;
+}
+
+
+/**@brief Function processes subsequent requests from one queue of the BGQ instance.
+ *
+ * @details Requests are passed to the SoftDevice until it asks to retry later, so several
+ *          notifications or write commands can be queued in the SoftDevice in a single
+ *          connection event.
+ *
+ * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ * @param[in] p_queue      Pointer to the queue instance.
+ * @param[in] conn_id      Connection ID.
+ * @param[in] conn_handle  Connection handle.
+ */
+static void lane_process(nrf_ble_gq_t const * const p_gatt_queue,
+                         nrf_queue_t  const * const p_queue,
+                         uint16_t                   conn_id,
+                         uint16_t                   conn_handle)
+{
+    ret_code_t       err_code;
+    nrf_ble_gq_req_t ble_req;
+    uint8_t          data[MAX(NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN,
+                              NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN)];
+    uint16_t         hvx_len;
+
+    while (nrf_queue_peek(p_queue, &ble_req) == NRF_SUCCESS)
+    {
+        // Retrieve allocated data. It is passed to the SoftDevice in place when it is stored in
+        // a single chunk, and gathered into the local buffer otherwise.
+        if (ble_req.type == NRF_BLE_GQ_REQ_GATTC_WRITE)
+        {
+            ble_req.params.gattc_write.p_value = nrf_memobj_gather(ble_req.p_mem_obj,
+                                                                   data,
+                                                                   ble_req.params.gattc_write.len,
+                                                                   0);
+        }
+        else if (ble_req.type == NRF_BLE_GQ_REQ_GATTS_HVX)
+        {
+            nrf_memobj_read(ble_req.p_mem_obj, &hvx_len, sizeof(uint16_t), 0);
+            ble_req.params.gatts_hvx.p_len  = &hvx_len;
+            ble_req.params.gatts_hvx.p_data = nrf_memobj_gather(ble_req.p_mem_obj,
+                                                                data,
+                                                                hvx_len,
+                                                                sizeof(uint16_t));
+        }
+
+        err_code = request_submit(&ble_req, conn_handle);
+
+        if (is_retry_needed(err_code))
+        {
+            NRF_LOG_DEBUG("SD is currently busy. The GATT request procedure will be attempted \
+                          again later.");
+            return;
+        }
+
+        // Remove last request descriptor from the queue and free data associated with it.
+        if (m_req_data_alloc[ble_req.type] != NULL)
+        {
+            nrf_memobj_free(ble_req.p_mem_obj);
+            NRF_LOG_DEBUG("Pointer to freed memory block: %p.", ble_req.p_mem_obj);
+        }
+        UNUSED_RETURN_VALUE(nrf_queue_read_consume(p_queue, 1));
+
+        stats_processed_update(p_gatt_queue, conn_id, &ble_req, true, err_code);
+        request_err_code_handle(&ble_req, conn_handle, err_code);
+    }
+}
+
+
+/**@brief Function processes requests from the BGQ instance queues of a connection.
+ *
+ * @details The high priority queue is processed first. The normal priority queue is processed
+ *          afterwards even if a high priority request is waiting, because the SoftDevice may
+ *          still accept requests of another kind.
+ *
+ * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ * @param[in] conn_id      Connection ID.
+ * @param[in] conn_handle  Connection handle.
+ */
+static void queue_process(nrf_ble_gq_t const * const p_gatt_queue,
+                          uint16_t                   conn_id,
+                          uint16_t                   conn_handle)
+{
+    NRF_LOG_DEBUG("Processing the request queue...");
+
+#if NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE > 0
+    lane_process(p_gatt_queue, &p_gatt_queue->p_hi_req_queue[conn_id], conn_id, conn_handle);
+#endif
+    lane_process(p_gatt_queue, &p_gatt_queue->p_req_queue[conn_id], conn_id, conn_handle);
+}
+
+
+/**@brief Function purges all requests from BGQ instance queues that are
+ *        no longer used by any connection.
+ *
+ * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ */
+static void queues_purge(nrf_ble_gq_t const * const p_gatt_queue)
+{
+    ret_code_t err_code;
+    uint16_t   conn_id;
+
+    err_code = nrf_queue_pop(p_gatt_queue->p_purge_queue, &conn_id);
+
+    while (err_code == NRF_SUCCESS)
+    {
+        nrf_ble_gq_req_t    ble_req;
+        nrf_queue_t const * p_queue;
+
+        NRF_LOG_DEBUG("Purging request queue with id: %d", conn_id);
+
+        for (uint8_t prio = 0; prio < NRF_BLE_GQ_PRIO_NUM; prio++)
+        {
+            p_queue = lane_queue_get(p_gatt_queue, conn_id, (nrf_ble_gq_prio_t)prio);
+            if (p_queue == NULL)
+            {
+                continue;
+            }
+
+            err_code = nrf_queue_pop(p_queue, &ble_req);
+
+            while (err_code == NRF_SUCCESS)
+            {
+                // Free data associated with this request if there is any.
+                if (m_req_data_alloc[ble_req.type] != NULL)
+                {
+                    nrf_memobj_free(ble_req.p_mem_obj);
+                    NRF_LOG_DEBUG("Pointer to freed memory block: %p.", ble_req.p_mem_obj);
+                }
+
+                err_code = nrf_queue_pop(p_queue, &ble_req);
+            }
+        }
+
+        err_code = nrf_queue_pop(p_gatt_queue->p_purge_queue, &conn_id);
+    }
+}
+
+
+/**@brief Function processes single GATT request without queue.
+ *
+ * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ * @param[in] p_req        Pointer to GATT request.
+ * @param[in] conn_id      Connection ID.
+ * @param[in] conn_handle  Connection handle.
+ *
+ * @retval  true   If request is accepted by Softdevice.
+ * @retval  false  If Softdevice is busy and the request should be queued.
+ */
+static bool request_process(nrf_ble_gq_t     const * const p_gatt_queue,
+                            nrf_ble_gq_req_t const * const p_req,
+                            uint16_t                       conn_id,
+                            uint16_t                       conn_handle)
+{
+    ret_code_t err_code = request_submit(p_req, conn_handle);
+
+    if (is_retry_needed(err_code))
     {
         NRF_LOG_DEBUG("SD is currently busy. The GATT request procedure will be attempted \
                       again later.");
@@ -403,12 +538,81 @@ static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_
     }
     else
     {
+        stats_processed_update(p_gatt_queue, conn_id, p_req, false, err_code);
         request_err_code_handle(p_req, conn_handle, err_code);
         return true;
     }
 }
 
 
+#if NRF_BLE_GQ_COALESCE_ENABLED
+/**@brief Function checks if a request carries a value that may be replaced by a newer one.
+ *
+ * @details Only notifications and write commands are coalesced, as the peer does not
+ *          acknowledge them and only the latest value is of interest.
+ *
+ * @param[in] p_req Pointer to GATT request.
+ */
+__STATIC_INLINE bool is_coalescable(nrf_ble_gq_req_t const * const p_req)
+{
+    return ((p_req->type == NRF_BLE_GQ_REQ_GATTS_HVX) &&
+            (p_req->params.gatts_hvx.type == BLE_GATT_HVX_NOTIFICATION)) ||
+           ((p_req->type == NRF_BLE_GQ_REQ_GATTC_WRITE) &&
+            (p_req->params.gattc_write.write_op == BLE_GATT_OP_WRITE_CMD));
+}
+
+
+/**@brief Function finds a queued request whose value may be replaced by the provided request.
+ *
+ * @param[in] p_queue Pointer to the queue instance.
+ * @param[in] p_req   Pointer to the new GATT request.
+ *
+ * @return    Pointer to the queued request, or NULL if there is none.
+ */
+static nrf_ble_gq_req_t * coalesce_target_find(nrf_queue_t      const * const p_queue,
+                                               nrf_ble_gq_req_t const * const p_req)
+{
+    nrf_ble_gq_req_t * p_entries = (nrf_ble_gq_req_t *)p_queue->p_buffer;
+    size_t             idx       = p_queue->p_cb->front;
+
+    // The head of the queue may be in the middle of being passed to the SoftDevice from the BLE
+    // event handler, so it is never replaced.
+    if (idx != p_queue->p_cb->back)
+    {
+        idx = (idx < p_queue->size) ? (idx + 1) : 0;
+    }
+
+    while (idx != p_queue->p_cb->back)
+    {
+        nrf_ble_gq_req_t * p_entry = &p_entries[idx];
+
+        if (p_entry->type == p_req->type)
+        {
+            if ((p_req->type == NRF_BLE_GQ_REQ_GATTS_HVX) &&
+                (p_entry->params.gatts_hvx.type == BLE_GATT_HVX_NOTIFICATION) &&
+                (p_entry->params.gatts_hvx.handle == p_req->params.gatts_hvx.handle) &&
+                (p_entry->params.gatts_hvx.offset == p_req->params.gatts_hvx.offset))
+            {
+                return p_entry;
+            }
+
+            if ((p_req->type == NRF_BLE_GQ_REQ_GATTC_WRITE) &&
+                (p_entry->params.gattc_write.write_op == BLE_GATT_OP_WRITE_CMD) &&
+                (p_entry->params.gattc_write.handle == p_req->params.gattc_write.handle) &&
+                (p_entry->params.gattc_write.offset == p_req->params.gattc_write.offset))
+            {
+                return p_entry;
+            }
+        }
+
+        idx = (idx < p_queue->size) ? (idx + 1) : 0;
+    }
+
+    return NULL;
+}
+#endif // NRF_BLE_GQ_COALESCE_ENABLED
+
+
 /**@brief Function finds ID for the provided connection handle within nrf_ble_gq_t instance registry.
  *
  * @param[in] p_gatt_queue  Pointer to the nrf_ble_gq_t instance.
@@ -477,8 +681,19 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
                                nrf_ble_gq_req_t   * const p_req,
                                uint16_t                   conn_handle)
 {
-    ret_code_t err_code = NRF_SUCCESS;
-    uint16_t   conn_id;
+    return nrf_ble_gq_item_add_prio(p_gatt_queue, p_req, conn_handle, NRF_BLE_GQ_PRIO_NORMAL);
+}
+
+
+ret_code_t nrf_ble_gq_item_add_prio(nrf_ble_gq_t const * const p_gatt_queue,
+                                    nrf_ble_gq_req_t   * const p_req,
+                                    uint16_t                   conn_handle,
+                                    nrf_ble_gq_prio_t          prio)
+{
+    ret_code_t          err_code = NRF_SUCCESS;
+    uint16_t            conn_id;
+    nrf_queue_t const * p_queue;
+    bool                can_bypass;
 
     NRF_LOG_DEBUG("Adding item to the request queue");
 
@@ -490,15 +705,32 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
 
     // Check if connection handle is registered and if GATT request is valid.
     conn_id = conn_handle_id_find(p_gatt_queue, conn_handle);
-    if ((p_req->type >= NRF_BLE_GQ_REQ_NUM) || (conn_id == p_gatt_queue->max_conns))
+    if ((p_req->type >= NRF_BLE_GQ_REQ_NUM) ||
+        (prio >= NRF_BLE_GQ_PRIO_NUM) ||
+        (conn_id == p_gatt_queue->max_conns))
     {
         return NRF_ERROR_INVALID_PARAM;
     }
 
+    p_queue = lane_queue_get(p_gatt_queue, conn_id, prio);
+    if (p_queue == NULL)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    // A request may overtake only requests of lower priority.
+    can_bypass = nrf_queue_is_empty(p_queue);
+#if NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE > 0
+    if (prio == NRF_BLE_GQ_PRIO_NORMAL)
+    {
+        can_bypass = can_bypass && nrf_queue_is_empty(&p_gatt_queue->p_hi_req_queue[conn_id]);
+    }
+#endif
+
     // Try processing a request without buffering.
-    if (nrf_queue_is_empty(&p_gatt_queue->p_req_queue[conn_id]))
+    if (can_bypass)
     {
-        bool req_processed = request_process(p_req, conn_handle);
+        bool req_processed = request_process(p_gatt_queue, p_req, conn_id, conn_handle);
         if (req_processed)
         {
             return err_code;
@@ -514,19 +746,83 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
         VERIFY_SUCCESS(err_code);
     }
 
-    err_code = nrf_queue_push(&p_gatt_queue->p_req_queue[conn_id], p_req);
+#if NRF_BLE_GQ_STATS_ENABLED
+    p_req->timestamp = app_timer_cnt_get();
+#endif
+
+#if NRF_BLE_GQ_COALESCE_ENABLED
+    if (is_coalescable(p_req))
+    {
+        nrf_ble_gq_req_t * p_target;
+        nrf_memobj_t     * p_old_mem_obj = NULL;
+
+        CRITICAL_REGION_ENTER();
+        p_target = coalesce_target_find(p_queue, p_req);
+        if (p_target != NULL)
+        {
+            p_old_mem_obj = p_target->p_mem_obj;
+#if NRF_BLE_GQ_STATS_ENABLED
+            // The latency is measured from the moment the first value was queued.
+            p_req->timestamp = p_target->timestamp;
+#endif
+            *p_target     = *p_req;
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (p_old_mem_obj != NULL)
+        {
+            NRF_LOG_DEBUG("Request coalesced with a queued request to the same handle.");
+            nrf_memobj_free(p_old_mem_obj);
+            stats_queued_update(p_gatt_queue, conn_id, true);
+            queue_process(p_gatt_queue, conn_id, conn_handle);
+            return NRF_SUCCESS;
+        }
+    }
+#endif // NRF_BLE_GQ_COALESCE_ENABLED
+
+    err_code = nrf_queue_push(p_queue, p_req);
     if ((err_code != NRF_SUCCESS) && (m_req_data_alloc[p_req->type] != NULL))
     {
         nrf_memobj_free(p_req->p_mem_obj);
         NRF_LOG_DEBUG("Pointer to freed memory block: %p.", p_req->p_mem_obj);
     }
+    else if (err_code == NRF_SUCCESS)
+    {
+        stats_queued_update(p_gatt_queue, conn_id, false);
+    }
 
     // Check if Softdevice is still busy.
-    queue_process(&p_gatt_queue->p_req_queue[conn_id], conn_handle);
+    queue_process(p_gatt_queue, conn_id, conn_handle);
     return err_code;
 }
 
 
+ret_code_t nrf_ble_gq_stats_get(nrf_ble_gq_t const * const p_gatt_queue,
+                                uint16_t                   conn_handle,
+                                nrf_ble_gq_stats_t * const p_stats)
+{
+    VERIFY_PARAM_NOT_NULL(p_gatt_queue);
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+#if NRF_BLE_GQ_STATS_ENABLED
+    uint16_t conn_id = conn_handle_id_find(p_gatt_queue, conn_handle);
+    if (conn_id == p_gatt_queue->max_conns)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = p_gatt_queue->p_stats[conn_id];
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+#else
+    UNUSED_PARAMETER(conn_handle);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+
 ret_code_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * const p_gatt_queue, uint16_t conn_handle)
 {
     ret_code_t err_code = NRF_SUCCESS;
@@ -551,6 +847,11 @@ ret_code_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * const p_gatt_queue, ui
 
         err_code = conn_handle_register(p_gatt_queue, conn_handle);
         VERIFY_SUCCESS(err_code);
+
+#if NRF_BLE_GQ_STATS_ENABLED
+        conn_id = conn_handle_id_find(p_gatt_queue, conn_handle);
+        memset(&p_gatt_queue->p_stats[conn_id], 0, sizeof(nrf_ble_gq_stats_t));
+#endif
     }
     return err_code;
 }
@@ -603,7 +904,7 @@ void nrf_ble_gq_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
     }
     else
     {
-        queue_process(&p_gatt_queue->p_req_queue[conn_id], conn_handle);
+        queue_process(p_gatt_queue, conn_id, conn_handle);
     }
 }
 
@@ -64,6 +64,10 @@
 extern "C" {
 #endif
 
+#ifndef NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE
+#define NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE 0 /**< Number of requests per connection in the high priority queue. 0 compiles the high priority lane out. */
+#endif
+
 /**@brief   Macro for defining a nrf_ble_gq_t instance with default parameters.
  *
  * @param   _name            Name of the instance.
@@ -97,6 +101,8 @@ extern "C" {
     STATIC_ASSERT(ARRAY_SIZE(CONCAT_2(_name, conn_handles_arr)) == (_max_connections));                \
     NRF_QUEUE_ARRAY_DEF(nrf_ble_gq_req_t, CONCAT_2(_name, req_queue), _queue_size,                     \
                         NRF_QUEUE_MODE_NO_OVERFLOW, _max_connections);                                 \
+    NRF_BLE_GQ_HI_REQ_QUEUE_DEC(_name, _max_connections)                                               \
+    NRF_BLE_GQ_STATS_DEC(_name, _max_connections)                                                      \
     NRF_QUEUE_DEF(uint16_t, CONCAT_2(_name, purge_queue), _max_connections,                            \
                   NRF_QUEUE_MODE_NO_OVERFLOW);                                                         \
     NRF_MEMOBJ_POOL_DEF(CONCAT_2(_name, pool), _pool_elem_size, _pool_elem_count);                     \
@@ -105,8 +111,10 @@ extern "C" {
         .max_conns      = (_max_connections),                                                          \
         .p_conn_handles = CONCAT_2(_name, conn_handles_arr),                                           \
         .p_req_queue    = CONCAT_2(_name, req_queue),                                                  \
+        .p_hi_req_queue = NRF_BLE_GQ_HI_REQ_QUEUE_PTR(_name),                                          \
         .p_purge_queue  = &CONCAT_2(_name, purge_queue),                                               \
-        .p_data_pool    = &CONCAT_2(_name, pool)                                                       \
+        .p_data_pool    = &CONCAT_2(_name, pool),                                                      \
+        .p_stats        = NRF_BLE_GQ_STATS_PTR(_name)                                                  \
     };                                                                                                 \
     NRF_SDH_BLE_OBSERVER(_name ## _obs,                                                                \
                          NRF_BLE_GQ_BLE_OBSERVER_PRIO,                                                 \
@@ -116,6 +124,32 @@ extern "C" {
     static nrf_ble_gq_t _name;
 #endif // !(defined(__LINT__))
 
+#if NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE > 0
+/**@brief Helping macros used to define the high priority queues of nrf_ble_gq_t instance.
+ *        Used in @ref NRF_BLE_GQ_CUSTOM_DEF.
+ */
+#define NRF_BLE_GQ_HI_REQ_QUEUE_DEC(_name, _max_connections)                         \
+    NRF_QUEUE_ARRAY_DEF(nrf_ble_gq_req_t, CONCAT_2(_name, hi_req_queue),             \
+                        NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE,                             \
+                        NRF_QUEUE_MODE_NO_OVERFLOW, _max_connections);
+#define NRF_BLE_GQ_HI_REQ_QUEUE_PTR(_name) CONCAT_2(_name, hi_req_queue)
+#else
+#define NRF_BLE_GQ_HI_REQ_QUEUE_DEC(_name, _max_connections)
+#define NRF_BLE_GQ_HI_REQ_QUEUE_PTR(_name) NULL
+#endif
+
+#if NRF_BLE_GQ_STATS_ENABLED
+/**@brief Helping macros used to define the per-link statistics of nrf_ble_gq_t instance.
+ *        Used in @ref NRF_BLE_GQ_CUSTOM_DEF.
+ */
+#define NRF_BLE_GQ_STATS_DEC(_name, _max_connections) \
+    static nrf_ble_gq_stats_t CONCAT_2(_name, stats)[_max_connections];
+#define NRF_BLE_GQ_STATS_PTR(_name) CONCAT_2(_name, stats)
+#else
+#define NRF_BLE_GQ_STATS_DEC(_name, _max_connections)
+#define NRF_BLE_GQ_STATS_PTR(_name) NULL
+#endif
+
 /**@brief Helping macro used to properly initialize connection handle array for nrf_ble_gq_t instance.
  *        Used in @ref NRF_BLE_GQ_CUSTOM_DEF.
  */
@@ -130,9 +164,44 @@ typedef enum
     NRF_BLE_GQ_REQ_CHAR_DISCOVERY, /**< GATTC Characteristic Discovery Request. See @ref nrf_ble_gq_gattc_char_disc_t and @ref sd_ble_gattc_characteristics_discover. */
     NRF_BLE_GQ_REQ_DESC_DISCOVERY, /**< GATTC Characteristic Descriptor Discovery Request. See @ref nrf_ble_gq_gattc_desc_disc_t and @ref sd_ble_gattc_descriptors_discover*/
     NRF_BLE_GQ_REQ_GATTS_HVX,      /**< GATTS Handle Value Notification or Indication. See @ref nrf_ble_gq_gatts_hvx_t and @ref ble_gatts_hvx_params_t */
+    NRF_BLE_GQ_REQ_CHAR_VAL_BY_UUID_READ, /**< GATTC Read Using Characteristic UUID Request. See @ref nrf_ble_gq_gattc_char_val_by_uuid_read_t and @ref sd_ble_gattc_char_value_by_uuid_read. */
     NRF_BLE_GQ_REQ_NUM             /**< Total number of different GATT Request types */
 } nrf_ble_gq_req_type_t;
 
+/**@brief Priority lanes of the BGQ instance.
+ *
+ * @details Every connection has one queue per lane. Whenever the SoftDevice can accept requests,
+ *          the high priority lane is processed before the normal priority lane. A normal priority
+ *          request is not held back while a high priority request waits for the SoftDevice,
+ *          for example a notification can be sent while a write request waits for the response
+ *          to the previous one. The high priority lane is available only if
+ *          NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE is greater than 0.
+ */
+typedef enum
+{
+    NRF_BLE_GQ_PRIO_NORMAL, /**< Normal priority lane, used by @ref nrf_ble_gq_item_add. */
+    NRF_BLE_GQ_PRIO_HIGH,   /**< High priority lane. Its size is set by NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE. */
+    NRF_BLE_GQ_PRIO_NUM     /**< Number of priority lanes. */
+} nrf_ble_gq_prio_t;
+
+/**@brief Per-link statistics of the BGQ instance.
+ *
+ * @details Latency is the time between adding a request and passing it to the SoftDevice,
+ *          in app_timer ticks. Requests that the SoftDevice accepted immediately count with
+ *          zero latency. A coalesced request keeps the time of the request whose value it
+ *          replaced.
+ */
+typedef struct
+{
+    uint32_t processed;   /**< Number of requests passed to the SoftDevice, successfully or not. */
+    uint32_t failed;      /**< Number of requests rejected by the SoftDevice with an error. */
+    uint32_t queued;      /**< Number of requests that had to wait in the queue. */
+    uint32_t coalesced;   /**< Number of queued requests replaced by a newer value for the same handle. */
+    uint32_t latency_sum; /**< Sum of the latencies of all processed requests. */
+    uint32_t latency_max; /**< Maximum latency of a processed request. */
+    uint16_t max_depth;   /**< Maximum number of requests waiting in the queues of the link. */
+} nrf_ble_gq_stats_t;
+
 /**@brief Pointer used to describe error handler for GATTC request. */
 typedef void (* nrf_ble_gq_req_error_cb_t) (uint32_t   nrf_error,
                                             void     * p_context,
@@ -152,7 +221,7 @@ typedef ble_gattc_write_params_t nrf_ble_gq_gattc_write_t;
 typedef struct
 {
     uint16_t   start_handle;    /**< The start handle value used during service discovery. */
-    ble_uuid_t srvc_uuid;       /**< The service UUID to be found. */
+    ble_uuid_t srvc_uuid;       /**< The service UUID to be found. If the type is BLE_UUID_TYPE_UNKNOWN, all primary services are discovered. */
 } nrf_ble_gq_gattc_srv_discovery_t;
 
 /**@brief Structure used to describe @ref NRF_BLE_GQ_REQ_CHAR_DISCOVERY request type. */
@@ -164,6 +233,13 @@ typedef ble_gattc_handle_range_t nrf_ble_gq_gattc_desc_disc_t;
 /**@brief Structure used to describe @ref NRF_BLE_GQ_REQ_GATTS_HVX request type. */
 typedef ble_gatts_hvx_params_t nrf_ble_gq_gatts_hvx_t;
 
+/**@brief Structure used to describe @ref NRF_BLE_GQ_REQ_CHAR_VAL_BY_UUID_READ request type. */
+typedef struct
+{
+    ble_uuid_t               uuid;         /**< Characteristic UUID to be read. */
+    ble_gattc_handle_range_t handle_range; /**< Handle range in which the characteristic is searched. */
+} nrf_ble_gq_gattc_char_val_by_uuid_read_t;
+
 /**@brief Structure used to handle SoftDevice error. */
 typedef struct
 {
@@ -178,6 +254,9 @@ typedef struct
     nrf_ble_gq_req_type_t            type;          /**< Type of request. */
     nrf_memobj_t                   * p_mem_obj;     /**< Memory object for data that cannot be contained in request descriptor. */
     nrf_ble_gq_req_error_handler_t   error_handler; /**< Error handler structure. */
+#if NRF_BLE_GQ_STATS_ENABLED
+    uint32_t                         timestamp;     /**< Time when the request was queued. Used internally for statistics. */
+#endif
     union
     {
         nrf_ble_gq_gattc_read_t          gattc_read;      /**< GATTC read parameters. Filled when nrf_ble_gq_req_t::type is @ref NRF_BLE_GQ_REQ_GATTC_READ. */
@@ -186,6 +265,7 @@ typedef struct
         nrf_ble_gq_gattc_char_disc_t     gattc_char_disc; /**< GATTC characteristic discovery parameters. Filled when nrf_ble_gq_req_t::type is @ref NRF_BLE_GQ_REQ_CHAR_DISCOVERY. */
         nrf_ble_gq_gattc_desc_disc_t     gattc_desc_disc; /**< GATTC characteristic descriptor discovery parameters. Filled when nrf_ble_gq_req_t::type is NRF_BLE_GQ_REQ_DESC_DISCOVERY. */
         nrf_ble_gq_gatts_hvx_t           gatts_hvx;       /**< GATTS Handle Value Notification or Indication Parameters. Filled when nrf_ble_gq_req_t::type is @ref NRF_BLE_GQ_REQ_GATTS_HVX. */
+        nrf_ble_gq_gattc_char_val_by_uuid_read_t gattc_char_val_by_uuid_read; /**< GATTC read using characteristic UUID parameters. Filled when nrf_ble_gq_req_t::type is @ref NRF_BLE_GQ_REQ_CHAR_VAL_BY_UUID_READ. */
     } params;
 } nrf_ble_gq_req_t;
 
@@ -195,8 +275,10 @@ typedef struct
     uint16_t            const max_conns;      /**< Maximal number of connection handles that can be registered. */
     uint16_t                * p_conn_handles; /**< Pointer to array with registered connection handles.*/
     nrf_queue_t const * const p_req_queue;    /**< Pointer to array of queue instances used to hold nrf_ble_gq_req_t instances.*/
+    nrf_queue_t const * const p_hi_req_queue; /**< Pointer to array of queue instances used to hold high priority nrf_ble_gq_req_t instances, NULL if the high priority lane is compiled out.*/
     nrf_queue_t const * const p_purge_queue;  /**< Pointer to the queue instance used to hold indexes of queues to purge.*/
     nrf_memobj_pool_t const * p_data_pool;    /**< Memory pool used to obtain nrf_memobj_t instances.*/
+    nrf_ble_gq_stats_t      * p_stats;        /**< Pointer to array with per-link statistics, NULL if statistics are disabled.*/
 } nrf_ble_gq_t;
 
 
@@ -207,6 +289,13 @@ typedef struct
  *          this request will be processed immediately. Otherwise, the request remains in
  *          in the queue and is processed later.
  *
+ *          Data of write and notification requests is copied to the data pool only if the
+ *          request has to be queued, so the buffers referenced by \p p_req can be reused when
+ *          this function returns. Queued data that fits in a single chunk of the pool (see
+ *          @ref nrf_memobj_contiguous_size_get) is passed to the SoftDevice in place, longer data
+ *          is gathered into a buffer on the stack first. The data is freed as soon as the
+ *          SoftDevice accepts the request.
+ *
  * @param[in] p_gatt_queue  Pointer to the BGQ instance.
  * @param[in] p_req         Pointer to the request.
  * @param[in] conn_handle   Connection handle associated with the request.
@@ -223,6 +312,51 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
                                uint16_t                   conn_handle);
 
 
+/**@brief Function for adding a GATT request to the selected priority lane of the BGQ instance.
+ *
+ * @details Works like @ref nrf_ble_gq_item_add. If NRF_BLE_GQ_COALESCE_ENABLED is set, a
+ *          notification or a write without response that has to be queued replaces the value of
+ *          a queued request of the same kind to the same handle, so that only the latest value
+ *          is sent.
+ *
+ * @param[in] p_gatt_queue  Pointer to the BGQ instance.
+ * @param[in] p_req         Pointer to the request.
+ * @param[in] conn_handle   Connection handle associated with the request.
+ * @param[in] prio          Priority lane.
+ *
+ * @retval    NRF_SUCCESS             If the request was added successfully.
+ * @retval    NRF_ERROR_NULL          Any parameter was NULL.
+ * @retval    NRF_ERROR_NO_MEM        There was no room in the queue or in the data pool.
+ * @retval    NRF_ERROR_INVALID_PARAM If \p conn_handle is not registered, type of request -
+ *                                    \p p_req or \p prio is not valid.
+ * @retval    NRF_ERROR_NOT_SUPPORTED If \p prio is @ref NRF_BLE_GQ_PRIO_HIGH and
+ *                                    NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE is 0.
+ * @retval    err_code                Other request specific error codes may be returned.
+ */
+ret_code_t nrf_ble_gq_item_add_prio(nrf_ble_gq_t const * const p_gatt_queue,
+                                    nrf_ble_gq_req_t   * const p_req,
+                                    uint16_t                   conn_handle,
+                                    nrf_ble_gq_prio_t          prio);
+
+
+/**@brief Function for reading the statistics of a link.
+ *
+ * @details Statistics are reset when the connection handle is registered.
+ *
+ * @param[in]  p_gatt_queue  Pointer to the BGQ instance.
+ * @param[in]  conn_handle   Connection handle.
+ * @param[out] p_stats       Statistics of the link.
+ *
+ * @retval    NRF_SUCCESS             If the statistics were read.
+ * @retval    NRF_ERROR_NULL          Any parameter was NULL.
+ * @retval    NRF_ERROR_INVALID_PARAM If \p conn_handle is not registered.
+ * @retval    NRF_ERROR_NOT_SUPPORTED If NRF_BLE_GQ_STATS_ENABLED is not set.
+ */
+ret_code_t nrf_ble_gq_stats_get(nrf_ble_gq_t const * const p_gatt_queue,
+                                uint16_t                   conn_handle,
+                                nrf_ble_gq_stats_t * const p_stats);
+
+
 /**@brief Function for registering connection handle in the BGQ instance.
  *
  * @details This function is used for registering connection handle in the BGQ instance. From this
@@ -160,6 +160,64 @@ static uint16_t nrf_ble_scan_address_type_decode(uint8_t const * p_addr)
 
 
 #if (NRF_BLE_SCAN_FILTER_ENABLE == 1)
+
+#define SCAN_HASH_EMPTY     0       /**< Value of an unused hash table slot. */
+#define SCAN_FILTER_NONE    0xFF    /**< Index returned when no filter matches the key. */
+
+/**@brief Filters which are matched against the advertising data, as opposed to the address. */
+#define SCAN_DATA_FILTERS_PRESENT ((NRF_BLE_SCAN_NAME_CNT > 0) || (NRF_BLE_SCAN_SHORT_NAME_CNT > 0) || \
+                                   (NRF_BLE_SCAN_UUID_CNT > 0) || (NRF_BLE_SCAN_APPEARANCE_CNT > 0))
+
+STATIC_ASSERT(NRF_BLE_SCAN_NAME_CNT < SCAN_FILTER_NONE);
+STATIC_ASSERT(NRF_BLE_SCAN_ADDRESS_CNT < SCAN_FILTER_NONE);
+STATIC_ASSERT(NRF_BLE_SCAN_UUID_CNT < SCAN_FILTER_NONE);
+STATIC_ASSERT(NRF_BLE_SCAN_APPEARANCE_CNT < SCAN_FILTER_NONE);
+
+
+/**@brief Function for hashing a filter key (FNV-1a).
+ *
+ * @param[in] p_data Key data.
+ * @param[in] len    Key length.
+ *
+ * @return Hash of the key.
+ */
+static uint32_t scan_hash(uint8_t const * p_data, uint16_t len)
+{
+    uint32_t hash = 2166136261UL;
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        hash ^= p_data[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+
+/**@brief Function for adding a filter index to a compiled lookup table.
+ *
+ * @details The table holds at least one free slot more than the number of filters,
+ *          so the linear probing always terminates.
+ *
+ * @param[in,out] p_table Lookup table.
+ * @param[in]     size    Number of slots in the table.
+ * @param[in]     hash    Hash of the filter key.
+ * @param[in]     index   Index of the filter.
+ */
+static void scan_hash_insert(uint8_t * p_table, uint16_t size, uint32_t hash, uint8_t index)
+{
+    uint16_t slot = hash % size;
+
+    while (p_table[slot] != SCAN_HASH_EMPTY)
+    {
+        slot = (slot + 1 == size) ? 0 : slot + 1;
+    }
+
+    p_table[slot] = index + 1;
+}
+
+
 #if (NRF_BLE_SCAN_ADDRESS_CNT > 0)
 
 /**@brief Function for searching for the provided address in the advertisement packets.
@@ -189,26 +247,30 @@ static bool find_peer_addr(ble_gap_evt_adv_report_t const * const p_adv_report,
 }
 
 
-/** @brief Function for comparing the provided address with the addresses of the advertising devices.
+/** @brief Function for comparing the address of the advertising device with the address filters.
  *
  * @param[in] p_adv_report    Advertising data to parse.
  * @param[in] p_scan_ctx      Pointer to the Scanning Module instance.
  *
- * @retval True when the address matches with the addresses of the advertising devices. False otherwise.
+ * @retval True when the address matches one of the address filters. False otherwise.
  */
 static bool adv_addr_compare(ble_gap_evt_adv_report_t const * const p_adv_report,
                              nrf_ble_scan_t const * const           p_scan_ctx)
 {
-    ble_gap_addr_t const * p_addr  = p_scan_ctx->scan_filters.addr_filter.target_addr;
-    uint8_t                counter = p_scan_ctx->scan_filters.addr_filter.addr_cnt;
+    nrf_ble_scan_addr_filter_t const * p_addr_filter = &p_scan_ctx->scan_filters.addr_filter;
+    uint16_t const                     size          = ARRAY_SIZE(p_addr_filter->hash);
+    uint16_t                           slot;
 
-    for (uint8_t index = 0; index < counter; index++)
+    slot = scan_hash(p_adv_report->peer_addr.addr, BLE_GAP_ADDR_LEN) % size;
+
+    while (p_addr_filter->hash[slot] != SCAN_HASH_EMPTY)
     {
-        // Search for address.
-        if (find_peer_addr(p_adv_report, &p_addr[index]))
+        if (find_peer_addr(p_adv_report,
+                           &p_addr_filter->target_addr[p_addr_filter->hash[slot] - 1]))
         {
             return true;
         }
+        slot = (slot + 1 == size) ? 0 : slot + 1;
     }
 
     return false;
@@ -280,6 +342,11 @@ static ret_code_t nrf_ble_scan_addr_filter_add(nrf_ble_scan_t * const p_scan_ctx
 
     NRF_LOG_DEBUG("\n\r");
 
+    scan_hash_insert(p_scan_ctx->scan_filters.addr_filter.hash,
+                     ARRAY_SIZE(p_scan_ctx->scan_filters.addr_filter.hash),
+                     scan_hash(p_addr, BLE_GAP_ADDR_LEN),
+                     *p_counter);
+
     // Increase the address filter counter.
     *p_counter += 1;
 
@@ -291,33 +358,33 @@ static ret_code_t nrf_ble_scan_addr_filter_add(nrf_ble_scan_t * const p_scan_ctx
 
 
 #if (NRF_BLE_SCAN_NAME_CNT > 0)
-/** @brief Function for comparing the provided name with the advertised name.
+/** @brief Function for comparing the advertised complete local name with the name filters.
  *
- * @param[in] p_adv_report    Advertising data to parse.
  * @param[in] p_scan_ctx      Pointer to the Scanning Module instance.
+ * @param[in] p_name          Advertised name, not NULL-terminated.
+ * @param[in] len             Length of the advertised name.
  *
- * @retval True when the names match. False otherwise.
+ * @retval True when the name matches one of the name filters. False otherwise.
  */
-static bool adv_name_compare(ble_gap_evt_adv_report_t const * p_adv_report,
-                             nrf_ble_scan_t     const * const p_scan_ctx)
+static bool adv_name_compare(nrf_ble_scan_t const * const p_scan_ctx,
+                             uint8_t        const *       p_name,
+                             uint16_t                     len)
 {
     nrf_ble_scan_name_filter_t const * p_name_filter = &p_scan_ctx->scan_filters.name_filter;
-    uint8_t                            counter       =
-        p_scan_ctx->scan_filters.name_filter.name_cnt;
-    uint8_t  index;
-    uint16_t data_len;
+    uint16_t const                     size          = ARRAY_SIZE(p_name_filter->hash);
+    uint16_t                           slot;
 
-    data_len = p_adv_report->data.len;
+    slot = scan_hash(p_name, len) % size;
 
-    // Compare the name found with the name filter.
-    for (index = 0; index < counter; index++)
+    while (p_name_filter->hash[slot] != SCAN_HASH_EMPTY)
     {
-        if (ble_advdata_name_find(p_adv_report->data.p_data,
-                                  data_len,
-                                  p_name_filter->target_name[index]))
+        char const * p_target = p_name_filter->target_name[p_name_filter->hash[slot] - 1];
+
+        if ((strlen(p_target) == len) && (memcmp(p_target, p_name, len) == 0))
         {
             return true;
         }
+        slot = (slot + 1 == size) ? 0 : slot + 1;
     }
 
     return false;
@@ -363,10 +430,15 @@ static ret_code_t nrf_ble_scan_name_filter_add(nrf_ble_scan_t * const p_scan_ctx
     }
 
     // Add name to filter.
-    memcpy(p_scan_ctx->scan_filters.name_filter.target_name[(*counter)++],
+    memcpy(p_scan_ctx->scan_filters.name_filter.target_name[*counter],
            p_name,
            strlen(p_name));
 
+    scan_hash_insert(p_scan_ctx->scan_filters.name_filter.hash,
+                     ARRAY_SIZE(p_scan_ctx->scan_filters.name_filter.hash),
+                     scan_hash((uint8_t const *)p_name, name_len),
+                     (*counter)++);
+
     NRF_LOG_DEBUG("Adding filter on %s name", p_name);
 
     return NRF_SUCCESS;
@@ -377,31 +449,33 @@ static ret_code_t nrf_ble_scan_name_filter_add(nrf_ble_scan_t * const p_scan_ctx
 
 
 #if (NRF_BLE_SCAN_SHORT_NAME_CNT > 0)
-/** @brief Function for comparing the provided short name with the advertised short name.
+/** @brief Function for comparing the advertised short local name with the short name filters.
+ *
+ * @details A short name filter matches when the advertised name is a prefix of the filter name
+ *          and it is at least as long as the minimum length of the filter.
  *
- * @param[in] p_adv_report    Advertising data to parse.
  * @param[in] p_scan_ctx      Pointer to the Scanning Module instance.
+ * @param[in] p_name          Advertised short name, not NULL-terminated.
+ * @param[in] len             Length of the advertised short name.
  *
  * @retval True when the names match. False otherwise.
  */
-static bool adv_short_name_compare(ble_gap_evt_adv_report_t const * const p_adv_report,
-                                   nrf_ble_scan_t           const * const p_scan_ctx)
+static bool adv_short_name_compare(nrf_ble_scan_t const * const p_scan_ctx,
+                                   uint8_t        const *       p_name,
+                                   uint16_t                     len)
 {
     nrf_ble_scan_short_name_filter_t const * p_name_filter =
         &p_scan_ctx->scan_filters.short_name_filter;
-    uint8_t  counter = p_scan_ctx->scan_filters.short_name_filter.name_cnt;
-    uint8_t  index;
-    uint16_t data_len;
-
-    data_len = p_adv_report->data.len;
+    uint8_t const counter = p_name_filter->name_cnt;
 
     // Compare the name found with the name filters.
-    for (index = 0; index < counter; index++)
+    for (uint8_t index = 0; index < counter; index++)
     {
-        if (ble_advdata_short_name_find(p_adv_report->data.p_data,
-                                        data_len,
-                                        p_name_filter->short_name[index].short_target_name,
-                                        p_name_filter->short_name[index].short_name_min_len))
+        char const * p_target = p_name_filter->short_name[index].short_target_name;
+
+        if ((len >= p_name_filter->short_name[index].short_name_min_len) &&
+            (len < strlen(p_target)) &&
+            (memcmp(p_target, p_name, len) == 0))
         {
             return true;
         }
@@ -470,59 +544,89 @@ static ret_code_t nrf_ble_scan_short_name_filter_add(nrf_ble_scan_t            *
 
 
 #if (NRF_BLE_SCAN_UUID_CNT > 0)
-/**@brief Function for comparing the provided UUID with the UUID in the advertisement packets.
+/**@brief Function for looking up an advertised UUID in the UUID filters.
  *
- * @param[in]   p_adv_report   Advertising data to parse.
  * @param[in]   p_scan_ctx     Pointer to the Scanning Module instance.
+ * @param[in]   p_uuid         Advertised UUID, little endian.
+ * @param[in]   len            Length of the advertised UUID.
  *
- * @return      True if the UUIDs match. False otherwise.
+ * @return      Index of the matching UUID filter, or SCAN_FILTER_NONE if there is none.
  */
-static bool adv_uuid_compare(ble_gap_evt_adv_report_t const * const p_adv_report,
-                             nrf_ble_scan_t           const * const p_scan_ctx)
+static uint8_t adv_uuid_lookup(nrf_ble_scan_t const * const p_scan_ctx,
+                               uint8_t        const *       p_uuid,
+                               uint8_t                      len)
 {
-    nrf_ble_scan_uuid_filter_t const * p_uuid_filter    = &p_scan_ctx->scan_filters.uuid_filter;
-    bool const                         all_filters_mode = p_scan_ctx->scan_filters.all_filters_mode;
-    uint8_t const                      counter          =
-        p_scan_ctx->scan_filters.uuid_filter.uuid_cnt;
-    uint8_t  index;
-    uint16_t data_len;
-    uint8_t  uuid_match_cnt = 0;
+    nrf_ble_scan_uuid_filter_t const * p_uuid_filter = &p_scan_ctx->scan_filters.uuid_filter;
+    uint16_t const                     size          = ARRAY_SIZE(p_uuid_filter->hash);
+    uint16_t                           slot;
 
-    data_len = p_adv_report->data.len;
+    slot = scan_hash(p_uuid, len) % size;
 
-    for (index = 0; index < counter; index++)
+    while (p_uuid_filter->hash[slot] != SCAN_HASH_EMPTY)
     {
+        uint8_t const index = p_uuid_filter->hash[slot] - 1;
 
-        if (ble_advdata_uuid_find(p_adv_report->data.p_data,
-                                  data_len,
-                                  &p_uuid_filter->uuid[index]))
+        if ((p_uuid_filter->raw_len[index] == len) &&
+            (memcmp(p_uuid_filter->raw[index], p_uuid, len) == 0))
         {
-            uuid_match_cnt++;
-
-            // In the normal filter mode, only one UUID is needed to match.
-            if (!all_filters_mode)
-            {
-                break;
-            }
-        }
-        else if (all_filters_mode)
-        {
-            break;
-        }
-        else
-        {
-            // Do nothing.
+            return index;
         }
+        slot = (slot + 1 == size) ? 0 : slot + 1;
     }
 
-    // In the multifilter mode, all UUIDs must be found in the advertisement packets.
-    if ((all_filters_mode && (uuid_match_cnt == counter)) ||
-        ((!all_filters_mode) && (uuid_match_cnt > 0)))
+    return SCAN_FILTER_NONE;
+}
+
+
+/**@brief Function for encoding a UUID filter as it appears in the advertising data.
+ *
+ * @param[in,out] p_filter  UUID filter data.
+ * @param[in]     index     Index of the UUID to encode.
+ *
+ * @return NRF_SUCCESS or error code from @ref sd_ble_uuid_encode.
+ */
+static ret_code_t uuid_filter_encode(nrf_ble_scan_uuid_filter_t * p_filter, uint8_t index)
+{
+    ret_code_t err_code;
+
+    p_filter->raw_len[index] = sizeof(p_filter->raw[0]);
+    err_code = sd_ble_uuid_encode(&p_filter->uuid[index],
+                                  &p_filter->raw_len[index],
+                                  p_filter->raw[index]);
+    if (err_code != NRF_SUCCESS)
     {
-        return true;
+        p_filter->raw_len[index] = 0;
+        return err_code;
     }
 
-    return false;
+    scan_hash_insert(p_filter->hash,
+                     ARRAY_SIZE(p_filter->hash),
+                     scan_hash(p_filter->raw[index], p_filter->raw_len[index]),
+                     index);
+    p_filter->unencoded_cnt--;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for encoding the UUID filters that could not be encoded when they were added.
+ *
+ * @details A vendor-specific UUID can be encoded only after its base is registered with
+ *          @ref sd_ble_uuid_vs_add, which can happen after the filter is added.
+ *
+ * @param[in,out] p_scan_ctx Pointer to the Scanning Module instance.
+ */
+static void uuid_filters_encode_pending(nrf_ble_scan_t * const p_scan_ctx)
+{
+    nrf_ble_scan_uuid_filter_t * p_filter = &p_scan_ctx->scan_filters.uuid_filter;
+
+    for (uint8_t index = 0; (index < p_filter->uuid_cnt) && (p_filter->unencoded_cnt > 0); index++)
+    {
+        if (p_filter->raw_len[index] == 0)
+        {
+            UNUSED_RETURN_VALUE(uuid_filter_encode(p_filter, index));
+        }
+    }
 }
 
 
@@ -537,9 +641,10 @@ static bool adv_uuid_compare(ble_gap_evt_adv_report_t const * const p_adv_report
 static ret_code_t nrf_ble_scan_uuid_filter_add(nrf_ble_scan_t * const p_scan_ctx,
                                                ble_uuid_t     const * p_uuid)
 {
-    ble_uuid_t * p_uuid_filter = p_scan_ctx->scan_filters.uuid_filter.uuid;
-    uint8_t    * p_counter     = &p_scan_ctx->scan_filters.uuid_filter.uuid_cnt;
-    uint8_t      index;
+    nrf_ble_scan_uuid_filter_t * p_filter      = &p_scan_ctx->scan_filters.uuid_filter;
+    ble_uuid_t                 * p_uuid_filter = p_filter->uuid;
+    uint8_t                    * p_counter     = &p_filter->uuid_cnt;
+    uint8_t                      index;
 
     // If no memory.
     if (*p_counter >= NRF_BLE_SCAN_UUID_CNT)
@@ -557,9 +662,17 @@ static ret_code_t nrf_ble_scan_uuid_filter_add(nrf_ble_scan_t * const p_scan_ctx
     }
 
     // Add UUID to the filter.
-    p_uuid_filter[(*p_counter)++] = *p_uuid;
+    p_uuid_filter[*p_counter] = *p_uuid;
     NRF_LOG_DEBUG("Added filter on UUID %x", p_uuid->uuid);
 
+    // Encode the UUID once, as it appears in the advertising data. If the SoftDevice is not
+    // enabled or the vendor-specific base is not registered yet, encoding is retried when
+    // advertising reports are received.
+    p_filter->unencoded_cnt++;
+    UNUSED_RETURN_VALUE(uuid_filter_encode(p_filter, *p_counter));
+
+    *p_counter += 1;
+
     return NRF_SUCCESS;
 }
 
@@ -568,35 +681,30 @@ static ret_code_t nrf_ble_scan_uuid_filter_add(nrf_ble_scan_t * const p_scan_ctx
 
 
 #if (NRF_BLE_SCAN_APPEARANCE_CNT)
-/**@brief Function for comparing the provided appearance with the appearance in the advertisement packets.
+/**@brief Function for comparing the advertised appearance with the appearance filters.
  *
- * @param[in]     p_adv_report Advertising data to parse.
- * @param[in,out] p_scan_ctx   Pointer to the Scanning Module instance.
+ * @param[in] p_scan_ctx   Pointer to the Scanning Module instance.
+ * @param[in] appearance   Advertised appearance.
  *
  * @return      True if the appearances match. False otherwise.
  */
-static bool adv_appearance_compare(ble_gap_evt_adv_report_t const * const p_adv_report,
-                                   nrf_ble_scan_t           const * const p_scan_ctx)
+static bool adv_appearance_compare(nrf_ble_scan_t const * const p_scan_ctx,
+                                   uint16_t                     appearance)
 {
     nrf_ble_scan_appearance_filter_t const * p_appearance_filter =
         &p_scan_ctx->scan_filters.appearance_filter;
-    uint8_t const counter =
-        p_scan_ctx->scan_filters.appearance_filter.appearance_cnt;
-    uint8_t  index;
-    uint16_t data_len;
-
-    data_len = p_adv_report->data.len;
+    uint16_t const size = ARRAY_SIZE(p_appearance_filter->hash);
+    uint16_t       slot = appearance % size;
 
-    // Verify if the advertised appearance matches the provided appearance.
-    for (index = 0; index < counter; index++)
+    while (p_appearance_filter->hash[slot] != SCAN_HASH_EMPTY)
     {
-        if (ble_advdata_appearance_find(p_adv_report->data.p_data,
-                                        data_len,
-                                        &p_appearance_filter->appearance[index]))
+        if (p_appearance_filter->appearance[p_appearance_filter->hash[slot] - 1] == appearance)
         {
             return true;
         }
+        slot = (slot + 1 == size) ? 0 : slot + 1;
     }
+
     return false;
 }
 
@@ -633,7 +741,11 @@ static ret_code_t nrf_ble_scan_appearance_filter_add(nrf_ble_scan_t * const p_sc
     }
 
     // Add appearance to the filter.
-    p_appearance_filter[(*p_counter)++] = appearance;
+    p_appearance_filter[*p_counter] = appearance;
+    scan_hash_insert(p_scan_ctx->scan_filters.appearance_filter.hash,
+                     ARRAY_SIZE(p_scan_ctx->scan_filters.appearance_filter.hash),
+                     appearance,
+                     (*p_counter)++);
     NRF_LOG_DEBUG("Added filter on appearance %x", appearance);
     return NRF_SUCCESS;
 }
@@ -702,6 +814,7 @@ ret_code_t nrf_ble_scan_all_filter_remove(nrf_ble_scan_t * const p_scan_ctx)
 #if (NRF_BLE_SCAN_NAME_CNT > 0)
     nrf_ble_scan_name_filter_t * p_name_filter = &p_scan_ctx->scan_filters.name_filter;
     memset(p_name_filter->target_name, 0, sizeof(p_name_filter->target_name));
+    memset(p_name_filter->hash, SCAN_HASH_EMPTY, sizeof(p_name_filter->hash));
     p_name_filter->name_cnt = 0;
 #endif
 
@@ -715,19 +828,24 @@ ret_code_t nrf_ble_scan_all_filter_remove(nrf_ble_scan_t * const p_scan_ctx)
 #if (NRF_BLE_SCAN_ADDRESS_CNT > 0)
     nrf_ble_scan_addr_filter_t * p_addr_filter = &p_scan_ctx->scan_filters.addr_filter;
     memset(p_addr_filter->target_addr, 0, sizeof(p_addr_filter->target_addr));
+    memset(p_addr_filter->hash, SCAN_HASH_EMPTY, sizeof(p_addr_filter->hash));
     p_addr_filter->addr_cnt = 0;
 #endif
 
 #if (NRF_BLE_SCAN_UUID_CNT > 0)
     nrf_ble_scan_uuid_filter_t * p_uuid_filter = &p_scan_ctx->scan_filters.uuid_filter;
     memset(p_uuid_filter->uuid, 0, sizeof(p_uuid_filter->uuid));
-    p_uuid_filter->uuid_cnt = 0;
+    memset(p_uuid_filter->raw_len, 0, sizeof(p_uuid_filter->raw_len));
+    memset(p_uuid_filter->hash, SCAN_HASH_EMPTY, sizeof(p_uuid_filter->hash));
+    p_uuid_filter->uuid_cnt      = 0;
+    p_uuid_filter->unencoded_cnt = 0;
 #endif
 
 #if (NRF_BLE_SCAN_APPEARANCE_CNT > 0)
     nrf_ble_scan_appearance_filter_t * p_appearance_filter =
         &p_scan_ctx->scan_filters.appearance_filter;
     memset(p_appearance_filter->appearance, 0, sizeof(p_appearance_filter->appearance));
+    memset(p_appearance_filter->hash, SCAN_HASH_EMPTY, sizeof(p_appearance_filter->hash));
     p_appearance_filter->appearance_cnt = 0;
 #endif
 
@@ -812,6 +930,12 @@ ret_code_t nrf_ble_scan_filters_disable(nrf_ble_scan_t * const p_scan_ctx)
     *p_name_filter_enabled = false;
 #endif
 
+#if (NRF_BLE_SCAN_SHORT_NAME_CNT > 0)
+    bool * p_short_name_filter_enabled =
+        &p_scan_ctx->scan_filters.short_name_filter.short_name_filter_enabled;
+    *p_short_name_filter_enabled = false;
+#endif
+
 #if (NRF_BLE_SCAN_ADDRESS_CNT > 0)
     bool * p_addr_filter_enabled = &p_scan_ctx->scan_filters.addr_filter.addr_filter_enabled;
     *p_addr_filter_enabled = false;
@@ -844,6 +968,137 @@ ret_code_t nrf_ble_scan_filter_get(nrf_ble_scan_t * const   p_scan_ctx,
 }
 
 
+#if SCAN_DATA_FILTERS_PRESENT
+/**@brief Function for matching the advertising data against all enabled data filters.
+ *
+ * @details The AD structures are walked once, and each one is dispatched on its type to the
+ *          compiled lookup of the corresponding filter, so the cost of a report does not depend
+ *          on the number of filters.
+ *
+ * @param[in]  p_scan_ctx    Pointer to the Scanning Module instance.
+ * @param[in]  p_adv_report  Advertising report.
+ * @param[out] p_match       Data filters that matched. Only bits of enabled filters are set.
+ */
+static void adv_data_match(nrf_ble_scan_t            const * const p_scan_ctx,
+                           ble_gap_evt_adv_report_t  const * const p_adv_report,
+                           nrf_ble_scan_filter_match       *       p_match)
+{
+    uint8_t const * p_data           = p_adv_report->data.p_data;
+    uint16_t const  data_len         = p_adv_report->data.len;
+    bool const      all_filters_mode = p_scan_ctx->scan_filters.all_filters_mode;
+    uint16_t        offset           = 0;
+
+#if (NRF_BLE_SCAN_NAME_CNT > 0)
+    bool const name_enabled = p_scan_ctx->scan_filters.name_filter.name_filter_enabled;
+#endif
+#if (NRF_BLE_SCAN_SHORT_NAME_CNT > 0)
+    bool const short_name_enabled =
+        p_scan_ctx->scan_filters.short_name_filter.short_name_filter_enabled;
+#endif
+#if (NRF_BLE_SCAN_UUID_CNT > 0)
+    bool const uuid_enabled   = p_scan_ctx->scan_filters.uuid_filter.uuid_filter_enabled;
+    uint8_t    uuid_match_cnt = 0;
+    uint32_t   uuid_found[(NRF_BLE_SCAN_UUID_CNT + 31) / 32];
+
+    memset(uuid_found, 0, sizeof(uuid_found));
+#endif
+#if (NRF_BLE_SCAN_APPEARANCE_CNT > 0)
+    bool const appearance_enabled =
+        p_scan_ctx->scan_filters.appearance_filter.appearance_filter_enabled;
+#endif
+
+    while ((p_data != NULL) && (offset + 1 < data_len))
+    {
+        uint8_t const         field_len = p_data[offset];
+        uint8_t const         ad_type   = p_data[offset + 1];
+        uint8_t const * const p_field   = &p_data[offset + 2];
+        uint16_t const        len       = field_len - 1;
+
+        if ((field_len == 0) || (offset + 1 + field_len > data_len))
+        {
+            // End of significant part or malformed data.
+            break;
+        }
+
+        switch (ad_type)
+        {
+#if (NRF_BLE_SCAN_NAME_CNT > 0)
+            case BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME:
+                if (name_enabled && adv_name_compare(p_scan_ctx, p_field, len))
+                {
+                    p_match->name_filter_match = true;
+                }
+                break;
+#endif
+
+#if (NRF_BLE_SCAN_SHORT_NAME_CNT > 0)
+            case BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME:
+                if (short_name_enabled && adv_short_name_compare(p_scan_ctx, p_field, len))
+                {
+                    p_match->short_name_filter_match = true;
+                }
+                break;
+#endif
+
+#if (NRF_BLE_SCAN_UUID_CNT > 0)
+            case BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE:
+            case BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE:
+            case BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_MORE_AVAILABLE:
+            case BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE:
+                if (uuid_enabled)
+                {
+                    uint8_t const uuid_len =
+                        ((ad_type == BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_MORE_AVAILABLE) ||
+                         (ad_type == BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE)) ? 2 : 16;
+
+                    for (uint16_t i = 0; i + uuid_len <= len; i += uuid_len)
+                    {
+                        uint8_t const index = adv_uuid_lookup(p_scan_ctx, &p_field[i], uuid_len);
+
+                        // Count every UUID filter once, even if the UUID is advertised twice.
+                        if ((index != SCAN_FILTER_NONE) &&
+                            !(uuid_found[index / 32] & (1UL << (index % 32))))
+                        {
+                            uuid_found[index / 32] |= (1UL << (index % 32));
+                            uuid_match_cnt++;
+                        }
+                    }
+                }
+                break;
+#endif
+
+#if (NRF_BLE_SCAN_APPEARANCE_CNT > 0)
+            case BLE_GAP_AD_TYPE_APPEARANCE:
+                if (appearance_enabled &&
+                    (len == sizeof(uint16_t)) &&
+                    adv_appearance_compare(p_scan_ctx, uint16_decode(p_field)))
+                {
+                    p_match->appearance_filter_match = true;
+                }
+                break;
+#endif
+
+            default:
+                break;
+        }
+
+        offset += field_len + 1;
+    }
+
+#if (NRF_BLE_SCAN_UUID_CNT > 0)
+    // In the multifilter mode, all UUIDs must be found in the advertisement packets.
+    if (uuid_enabled &&
+        ((all_filters_mode && (uuid_match_cnt == p_scan_ctx->scan_filters.uuid_filter.uuid_cnt)) ||
+         ((!all_filters_mode) && (uuid_match_cnt > 0))))
+    {
+        p_match->uuid_filter_match = true;
+    }
+#else
+    UNUSED_VARIABLE(all_filters_mode);
+#endif
+}
+#endif // SCAN_DATA_FILTERS_PRESENT
+
 #endif // NRF_BLE_SCAN_FILTER_ENABLE
 
 /**@brief Function for calling the BLE_GAP_EVT_ADV_REPORT event to check whether the received
@@ -880,35 +1135,12 @@ static void nrf_ble_scan_on_adv_report(nrf_ble_scan_t           const * const p_
     }
 
 #if (NRF_BLE_SCAN_FILTER_ENABLE == 1)
-    bool const all_filter_mode   = p_scan_ctx->scan_filters.all_filters_mode;
-    bool       is_filter_matched = false;
-
-#if (NRF_BLE_SCAN_ADDRESS_CNT > 0)
-    bool const addr_filter_enabled = p_scan_ctx->scan_filters.addr_filter.addr_filter_enabled;
-#endif
-
-#if (NRF_BLE_SCAN_NAME_CNT > 0)
-    bool const name_filter_enabled = p_scan_ctx->scan_filters.name_filter.name_filter_enabled;
-#endif
-
-#if (NRF_BLE_SCAN_SHORT_NAME_CNT > 0)
-    bool const short_name_filter_enabled =
-        p_scan_ctx->scan_filters.short_name_filter.short_name_filter_enabled;
-#endif
-
-#if (NRF_BLE_SCAN_UUID_CNT > 0)
-    bool const uuid_filter_enabled = p_scan_ctx->scan_filters.uuid_filter.uuid_filter_enabled;
-#endif
-
-#if (NRF_BLE_SCAN_APPEARANCE_CNT > 0)
-    bool const appearance_filter_enabled =
-        p_scan_ctx->scan_filters.appearance_filter.appearance_filter_enabled;
-#endif
-
+    bool const                  all_filter_mode = p_scan_ctx->scan_filters.all_filters_mode;
+    nrf_ble_scan_filter_match * p_match         = &scan_evt.params.filter_match.filter_match;
 
 #if (NRF_BLE_SCAN_ADDRESS_CNT > 0)
     // Check the address filter.
-    if (addr_filter_enabled)
+    if (p_scan_ctx->scan_filters.addr_filter.addr_filter_enabled)
     {
         // Number of active filters.
         filter_cnt++;
@@ -917,75 +1149,52 @@ static void nrf_ble_scan_on_adv_report(nrf_ble_scan_t           const * const p_
             // Number of filters matched.
             filter_match_cnt++;
             // Information about the filters matched.
-            scan_evt.params.filter_match.filter_match.address_filter_match = true;
-            is_filter_matched = true;
+            p_match->address_filter_match = true;
         }
     }
 #endif
 
+#if SCAN_DATA_FILTERS_PRESENT
+    // Check the data filters in a single pass over the advertising data.
+    adv_data_match(p_scan_ctx, p_adv_report, p_match);
+#else
+    UNUSED_VARIABLE(p_match);
+#endif
+
 #if (NRF_BLE_SCAN_NAME_CNT > 0)
-    // Check the name filter.
-    if (name_filter_enabled)
+    if (p_scan_ctx->scan_filters.name_filter.name_filter_enabled)
     {
         filter_cnt++;
-        if (adv_name_compare(p_adv_report, p_scan_ctx))
-        {
-            filter_match_cnt++;
-
-            // Information about the filters matched.
-            scan_evt.params.filter_match.filter_match.name_filter_match = true;
-            is_filter_matched = true;
-        }
+        filter_match_cnt += p_match->name_filter_match;
     }
 #endif
 
 #if (NRF_BLE_SCAN_SHORT_NAME_CNT > 0)
-    if (short_name_filter_enabled)
+    if (p_scan_ctx->scan_filters.short_name_filter.short_name_filter_enabled)
     {
         filter_cnt++;
-        if (adv_short_name_compare(p_adv_report, p_scan_ctx))
-        {
-            filter_match_cnt++;
-
-            // Information about the filters matched.
-            scan_evt.params.filter_match.filter_match.short_name_filter_match = true;
-            is_filter_matched = true;
-        }
+        filter_match_cnt += p_match->short_name_filter_match;
     }
 #endif
 
 #if (NRF_BLE_SCAN_UUID_CNT > 0)
-    // Check the UUID filter.
-    if (uuid_filter_enabled)
+    if (p_scan_ctx->scan_filters.uuid_filter.uuid_filter_enabled)
     {
         filter_cnt++;
-        if (adv_uuid_compare(p_adv_report, p_scan_ctx))
-        {
-            filter_match_cnt++;
-            // Information about the filters matched.
-            scan_evt.params.filter_match.filter_match.uuid_filter_match = true;
-            is_filter_matched = true;
-        }
+        filter_match_cnt += p_match->uuid_filter_match;
     }
 #endif
 
 #if (NRF_BLE_SCAN_APPEARANCE_CNT > 0)
-    // Check the appearance filter.
-    if (appearance_filter_enabled)
+    if (p_scan_ctx->scan_filters.appearance_filter.appearance_filter_enabled)
     {
         filter_cnt++;
-        if (adv_appearance_compare(p_adv_report, p_scan_ctx))
-        {
-            filter_match_cnt++;
-            // Information about the filters matched.
-            scan_evt.params.filter_match.filter_match.appearance_filter_match = true;
-            is_filter_matched = true;
-        }
+        filter_match_cnt += p_match->appearance_filter_match;
     }
-
-    scan_evt.scan_evt_id = NRF_BLE_SCAN_EVT_NOT_FOUND;
 #endif
 
+    bool const is_filter_matched = (filter_match_cnt > 0);
+
     scan_evt.params.filter_match.p_adv_report = p_adv_report;
 
     // In the multifilter mode, the number of the active filters must equal the number of the filters matched to generate the notification.
@@ -1302,6 +1511,12 @@ void nrf_ble_scan_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_contex)
     switch (p_ble_evt->header.evt_id)
     {
         case BLE_GAP_EVT_ADV_REPORT:
+#if (NRF_BLE_SCAN_FILTER_ENABLE == 1) && (NRF_BLE_SCAN_UUID_CNT > 0)
+            if (p_scan_data->scan_filters.uuid_filter.unencoded_cnt > 0)
+            {
+                uuid_filters_encode_pending(p_scan_data);
+            }
+#endif
             nrf_ble_scan_on_adv_report(p_scan_data, p_adv_report);
             break;
 
@@ -210,16 +210,35 @@ typedef void (*nrf_ble_scan_evt_handler_t)(scan_evt_t const * p_scan_evt);
 
 #if (NRF_BLE_SCAN_FILTER_ENABLE == 1)
 
+/**@brief Size of the hash table compiled for a filter type with _cnt entries.
+ *
+ * @details Filters of one type are compiled into an open addressing hash table so that each
+ *          advertising report is matched in a single pass over its AD structures, independently
+ *          of the number of filters. Table slots hold the filter index increased by one.
+ *          Short name filters are the exception, see @ref nrf_ble_scan_short_name_filter_t.
+ */
+#define NRF_BLE_SCAN_HASH_SIZE(_cnt) (2 * (_cnt) + 1)
+
 #if (NRF_BLE_SCAN_NAME_CNT > 0)
 typedef struct
 {
     char    target_name[NRF_BLE_SCAN_NAME_CNT][NRF_BLE_SCAN_NAME_MAX_LEN]; /**< Names that the main application will scan for, and that will be advertised by the peripherals. */
     uint8_t name_cnt;                                                      /**< Name filter counter. */
     bool    name_filter_enabled;                                           /**< Flag to inform about enabling or disabling this filter. */
+    uint8_t hash[NRF_BLE_SCAN_HASH_SIZE(NRF_BLE_SCAN_NAME_CNT)];           /**< Compiled name lookup table. */
 } nrf_ble_scan_name_filter_t;
 #endif
 
 #if (NRF_BLE_SCAN_SHORT_NAME_CNT > 0)
+/**@brief Short name filters.
+ *
+ * @details Short name filters are not hashed. An advertised short name matches a filter if it is
+ *          a prefix of the filter name of at least @ref nrf_ble_scan_short_name_t::short_name_min_len
+ *          characters, so there is no single key to look up. Each advertised short name is
+ *          compared with every filter, and the matching time grows with
+ *          @ref NRF_BLE_SCAN_SHORT_NAME_CNT. Keep the number of short name filters small, and use
+ *          name, UUID or address filters to scan for many devices.
+ */
 typedef struct
 {
     struct
@@ -238,6 +257,7 @@ typedef struct
     ble_gap_addr_t target_addr[NRF_BLE_SCAN_ADDRESS_CNT]; /**< Addresses in the same format as the format used by the SoftDevice that the main application will scan for, and that will be advertised by the peripherals. */
     uint8_t        addr_cnt;                              /**< Address filter counter. */
     bool           addr_filter_enabled;                   /**< Flag to inform about enabling or disabling this filter. */
+    uint8_t        hash[NRF_BLE_SCAN_HASH_SIZE(NRF_BLE_SCAN_ADDRESS_CNT)]; /**< Compiled address lookup table. */
 } nrf_ble_scan_addr_filter_t;
 #endif
 
@@ -247,6 +267,10 @@ typedef struct
     ble_uuid_t uuid[NRF_BLE_SCAN_UUID_CNT]; /**< UUIDs that the main application will scan for, and that will be advertised by the peripherals. */
     uint8_t    uuid_cnt;                    /**< UUID filter counter. */
     bool       uuid_filter_enabled;         /**< Flag to inform about enabling or disabling this filter. */
+    uint8_t    unencoded_cnt;               /**< Number of UUIDs that are not encoded yet. */
+    uint8_t    raw_len[NRF_BLE_SCAN_UUID_CNT];                            /**< Length of the UUIDs as advertised, 0 if the UUID is not encoded yet. */
+    uint8_t    raw[NRF_BLE_SCAN_UUID_CNT][16];                            /**< UUIDs as advertised, little endian. */
+    uint8_t    hash[NRF_BLE_SCAN_HASH_SIZE(NRF_BLE_SCAN_UUID_CNT)];       /**< Compiled UUID lookup table. */
 } nrf_ble_scan_uuid_filter_t;
 #endif
 
@@ -256,6 +280,7 @@ typedef struct
     uint16_t appearance[NRF_BLE_SCAN_APPEARANCE_CNT]; /**< Apperances that the main application will scan for, and that will be advertised by the peripherals. */
     uint8_t  appearance_cnt;                          /**< Appearance filter counter. */
     bool     appearance_filter_enabled;               /**< Flag to inform about enabling or disabling this filter. */
+    uint8_t  hash[NRF_BLE_SCAN_HASH_SIZE(NRF_BLE_SCAN_APPEARANCE_CNT)]; /**< Compiled appearance lookup table. */
 } nrf_ble_scan_appearance_filter_t;
 #endif
 
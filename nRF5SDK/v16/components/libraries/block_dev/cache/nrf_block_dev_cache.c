@@ -0,0 +1,555 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NRF_BLOCK_DEV_CACHE)
+#include "nrf_block_dev_cache.h"
+#include <inttypes.h>
+
+/**@file
+ *
+ * @ingroup nrf_block_dev
+ * @{
+ *
+ * @brief This module implements block device API. It caches another block device.
+ */
+
+#if NRF_BLOCK_DEV_CACHE_CONFIG_LOG_ENABLED
+#define NRF_LOG_LEVEL       NRF_BLOCK_DEV_CACHE_CONFIG_LOG_LEVEL
+#define NRF_LOG_INFO_COLOR  NRF_BLOCK_DEV_CACHE_CONFIG_INFO_COLOR
+#define NRF_LOG_INST_DEBUG_COLOR NRF_BLOCK_DEV_CACHE_CONFIG_DEBUG_COLOR
+#else
+#define NRF_LOG_LEVEL       0
+#endif
+#include "nrf_log.h"
+
+/**
+ * @brief Returns a mask of count blocks, starting at block first of an erase unit.
+ */
+static uint32_t blocks_mask(uint32_t first, uint32_t count)
+{
+    uint32_t mask = (count >= 32) ? UINT32_MAX : ((1uL << count) - 1);
+    return mask << first;
+}
+
+static uint8_t * line_data(nrf_block_dev_cache_t const * p_cache_dev, uint32_t line_idx)
+{
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+
+    return p_config->p_buffer + line_idx * p_config->unit_blocks * p_config->block_size;
+}
+
+static ret_code_t backend_req(nrf_block_dev_cache_t const * p_cache_dev,
+                              uint32_t blk_id,
+                              uint32_t blk_count,
+                              uint8_t * p_buff,
+                              bool write)
+{
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+    NRF_BLOCK_DEV_REQUEST(req, blk_id, blk_count, p_buff);
+
+    if (write)
+    {
+        p_cache_dev->p_work->stats.dev_writes++;
+        return nrf_blk_dev_write_req(p_config->p_backend, &req);
+    }
+
+    p_cache_dev->p_work->stats.dev_reads++;
+    return nrf_blk_dev_read_req(p_config->p_backend, &req);
+}
+
+/**
+ * @brief Reads the blocks from mask that are not yet present in a line.
+ *
+ * Each run of consecutive missing blocks is read with a single request.
+ */
+static ret_code_t line_fill(nrf_block_dev_cache_t const * p_cache_dev,
+                            uint32_t line_idx,
+                            uint32_t mask)
+{
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+    nrf_block_dev_cache_line_t * p_line = &p_config->p_lines[line_idx];
+    uint32_t missing = mask & ~p_line->valid_mask;
+    uint32_t first = 0;
+
+    while (missing)
+    {
+        while (!(missing & (1uL << first)))
+        {
+            first++;
+        }
+
+        uint32_t count = 0;
+        while ((first + count < 32) && (missing & (1uL << (first + count))))
+        {
+            count++;
+        }
+
+        ret_code_t ret = backend_req(p_cache_dev,
+                                     p_line->unit_idx * p_config->unit_blocks + first,
+                                     count,
+                                     line_data(p_cache_dev, line_idx) + first * p_config->block_size,
+                                     false);
+        if (ret != NRF_SUCCESS)
+        {
+            return ret;
+        }
+
+        p_line->valid_mask |= blocks_mask(first, count);
+        missing &= ~blocks_mask(first, count);
+    }
+
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Writes the dirty blocks of a line back to the underlying device.
+ *
+ * The blocks between the first and the last dirty block are written with a single request.
+ * Blocks in that range that are not in the cache are read first, so that the underlying
+ * device erases and programs the unit only once.
+ */
+static ret_code_t line_write_back(nrf_block_dev_cache_t const * p_cache_dev, uint32_t line_idx)
+{
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+    nrf_block_dev_cache_line_t * p_line = &p_config->p_lines[line_idx];
+    ret_code_t ret;
+
+    if (p_line->dirty_mask == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    uint32_t first = 0;
+    uint32_t last  = 31;
+    while (!(p_line->dirty_mask & (1uL << first)))
+    {
+        first++;
+    }
+    while (!(p_line->dirty_mask & (1uL << last)))
+    {
+        last--;
+    }
+
+    uint32_t burst = blocks_mask(first, last - first + 1);
+
+    ret = line_fill(p_cache_dev, line_idx, burst);
+    if (ret != NRF_SUCCESS)
+    {
+        return ret;
+    }
+
+    NRF_LOG_INST_DEBUG(p_cache_dev->p_log,
+                       "Write back unit %"PRIu32" blocks %"PRIu32"-%"PRIu32,
+                       p_line->unit_idx, first, last);
+
+    ret = backend_req(p_cache_dev,
+                      p_line->unit_idx * p_config->unit_blocks + first,
+                      last - first + 1,
+                      line_data(p_cache_dev, line_idx) + first * p_config->block_size,
+                      true);
+    if (ret != NRF_SUCCESS)
+    {
+        return ret;
+    }
+
+    p_line->dirty_mask = 0;
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Writes back all dirty lines, in ascending erase unit order.
+ */
+static ret_code_t cache_write_back(nrf_block_dev_cache_t const * p_cache_dev)
+{
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+
+    for (;;)
+    {
+        uint32_t line_idx = p_config->line_count;
+
+        for (uint32_t i = 0; i < p_config->line_count; i++)
+        {
+            if ((p_config->p_lines[i].dirty_mask != 0) &&
+                ((line_idx == p_config->line_count) ||
+                 (p_config->p_lines[i].unit_idx < p_config->p_lines[line_idx].unit_idx)))
+            {
+                line_idx = i;
+            }
+        }
+
+        if (line_idx == p_config->line_count)
+        {
+            return NRF_SUCCESS;
+        }
+
+        ret_code_t ret = line_write_back(p_cache_dev, line_idx);
+        if (ret != NRF_SUCCESS)
+        {
+            return ret;
+        }
+    }
+}
+
+/**
+ * @brief Returns the line holding an erase unit, allocating the least recently used line
+ *        if the unit is not in the cache.
+ */
+static ret_code_t line_get(nrf_block_dev_cache_t const * p_cache_dev,
+                           uint32_t unit_idx,
+                           uint32_t * p_line_idx,
+                           bool * p_hit)
+{
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+    nrf_block_dev_cache_work_t * p_work = p_cache_dev->p_work;
+    nrf_block_dev_cache_line_t * p_lines = p_config->p_lines;
+    uint32_t victim = 0;
+
+    for (uint32_t i = 0; i < p_config->line_count; i++)
+    {
+        if (p_lines[i].valid_mask != 0 && p_lines[i].unit_idx == unit_idx)
+        {
+            p_lines[i].last_use = ++p_work->use_counter;
+            *p_line_idx = i;
+            *p_hit = true;
+            return NRF_SUCCESS;
+        }
+
+        if (p_lines[victim].valid_mask != 0 &&
+            (p_lines[i].valid_mask == 0 || p_lines[i].last_use < p_lines[victim].last_use))
+        {
+            victim = i;
+        }
+    }
+
+    if (p_lines[victim].valid_mask != 0)
+    {
+        ret_code_t ret = line_write_back(p_cache_dev, victim);
+        if (ret != NRF_SUCCESS)
+        {
+            return ret;
+        }
+        p_work->stats.evictions++;
+    }
+
+    p_lines[victim].unit_idx   = unit_idx;
+    p_lines[victim].valid_mask = 0;
+    p_lines[victim].dirty_mask = 0;
+    p_lines[victim].last_use   = ++p_work->use_counter;
+
+    *p_line_idx = victim;
+    *p_hit = false;
+    return NRF_SUCCESS;
+}
+
+static ret_code_t block_dev_cache_init(nrf_block_dev_t const * p_blk_dev,
+                                       nrf_block_dev_ev_handler ev_handler,
+                                       void const * p_context)
+{
+    ASSERT(p_blk_dev);
+    nrf_block_dev_cache_t const * p_cache_dev =
+                                  CONTAINER_OF(p_blk_dev, nrf_block_dev_cache_t, block_dev);
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+    nrf_block_dev_cache_work_t * p_work = p_cache_dev->p_work;
+
+    NRF_LOG_INST_DEBUG(p_cache_dev->p_log, "Init");
+
+    /* The underlying device always works in synchronous mode. */
+    ret_code_t ret = nrf_blk_dev_init(p_config->p_backend, NULL, NULL);
+    if (ret != NRF_SUCCESS)
+    {
+        return ret;
+    }
+
+    if (nrf_blk_dev_geometry(p_config->p_backend)->blk_size != p_config->block_size)
+    {
+        NRF_LOG_INST_ERROR(p_cache_dev->p_log, "Block size mismatch");
+        (void)nrf_blk_dev_uninit(p_config->p_backend);
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_work, 0, sizeof(nrf_block_dev_cache_work_t));
+    memset(p_config->p_lines, 0, p_config->line_count * sizeof(nrf_block_dev_cache_line_t));
+
+    p_work->geometry = *nrf_blk_dev_geometry(p_config->p_backend);
+    p_work->p_context = p_context;
+    p_work->ev_handler = ev_handler;
+
+    if (p_work->ev_handler)
+    {
+        /*Asynchronous operation (simulation)*/
+        const nrf_block_dev_event_t ev = {
+                NRF_BLOCK_DEV_EVT_INIT,
+                NRF_BLOCK_DEV_RESULT_SUCCESS,
+                NULL,
+                p_work->p_context
+        };
+
+        p_work->ev_handler(p_blk_dev, &ev);
+    }
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t block_dev_cache_uninit(nrf_block_dev_t const * p_blk_dev)
+{
+    ASSERT(p_blk_dev);
+    nrf_block_dev_cache_t const * p_cache_dev =
+                                  CONTAINER_OF(p_blk_dev, nrf_block_dev_cache_t, block_dev);
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+    nrf_block_dev_cache_work_t * p_work = p_cache_dev->p_work;
+
+    NRF_LOG_INST_DEBUG(p_cache_dev->p_log, "Uninit");
+
+    ret_code_t ret = cache_write_back(p_cache_dev);
+    if (ret != NRF_SUCCESS)
+    {
+        return ret;
+    }
+
+    bool flushing = false;
+    do
+    {
+        ret = nrf_blk_dev_ioctl(p_config->p_backend, NRF_BLOCK_DEV_IOCTL_REQ_CACHE_FLUSH, &flushing);
+    } while ((ret == NRF_ERROR_BUSY) || ((ret == NRF_SUCCESS) && flushing));
+
+    ret = nrf_blk_dev_uninit(p_config->p_backend);
+    if (ret != NRF_SUCCESS)
+    {
+        return ret;
+    }
+
+    if (p_work->ev_handler)
+    {
+        /*Asynchronous operation (simulation)*/
+        const nrf_block_dev_event_t ev = {
+                NRF_BLOCK_DEV_EVT_UNINIT,
+                NRF_BLOCK_DEV_RESULT_SUCCESS,
+                NULL,
+                p_work->p_context
+        };
+
+        p_work->ev_handler(p_blk_dev, &ev);
+    }
+
+    memset(p_work, 0, sizeof(nrf_block_dev_cache_work_t));
+    return NRF_SUCCESS;
+}
+
+static ret_code_t block_dev_cache_req(nrf_block_dev_t const * p_blk_dev,
+                                      nrf_block_req_t const * p_blk,
+                                      nrf_block_dev_event_type_t event)
+{
+    ASSERT(p_blk_dev);
+    ASSERT(p_blk);
+    nrf_block_dev_cache_t const * p_cache_dev =
+                                  CONTAINER_OF(p_blk_dev, nrf_block_dev_cache_t, block_dev);
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+    nrf_block_dev_cache_work_t * p_work = p_cache_dev->p_work;
+    bool read = (event == NRF_BLOCK_DEV_EVT_BLK_READ_DONE);
+
+    NRF_LOG_INST_DEBUG(p_cache_dev->p_log,
+        (read ?
+            "Read req from block %"PRIu32" size %"PRIu32"(x%"PRIu32") to %"PRIXPTR
+            :
+            "Write req to block %"PRIu32" size %"PRIu32"(x%"PRIu32") from %"PRIXPTR),
+        p_blk->blk_id,
+        p_blk->blk_count,
+        p_work->geometry.blk_size,
+        p_blk->p_buff);
+
+    if ((p_blk->blk_id + p_blk->blk_count) > p_work->geometry.blk_count)
+    {
+        NRF_LOG_INST_ERROR(p_cache_dev->p_log,
+            (read ?
+                "Out of range read req block %"PRIu32" count %"PRIu32" while max is %"PRIu32
+                :
+                "Out of range write req block %"PRIu32" count %"PRIu32", while max is %"PRIu32),
+            p_blk->blk_id,
+            p_blk->blk_count,
+            p_work->geometry.blk_count);
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    uint32_t  blk_id    = p_blk->blk_id;
+    uint32_t  remaining = p_blk->blk_count;
+    uint8_t * p_buff    = p_blk->p_buff;
+
+    while (remaining)
+    {
+        uint32_t unit_idx = blk_id / p_config->unit_blocks;
+        uint32_t first    = blk_id % p_config->unit_blocks;
+        uint32_t count    = MIN(remaining, p_config->unit_blocks - first);
+        uint32_t mask     = blocks_mask(first, count);
+        uint32_t size     = count * p_config->block_size;
+        uint32_t line_idx;
+        bool     hit;
+
+        ret_code_t ret = line_get(p_cache_dev, unit_idx, &line_idx, &hit);
+        if (ret != NRF_SUCCESS)
+        {
+            return ret;
+        }
+
+        nrf_block_dev_cache_line_t * p_line = &p_config->p_lines[line_idx];
+        uint8_t * p_data = line_data(p_cache_dev, line_idx) + first * p_config->block_size;
+
+        if (read)
+        {
+            uint32_t missing = count;
+            for (uint32_t valid = p_line->valid_mask & mask; valid; valid &= valid - 1)
+            {
+                missing--;
+            }
+            p_work->stats.read_misses += missing;
+            p_work->stats.read_hits   += count - missing;
+
+            ret = line_fill(p_cache_dev, line_idx, mask);
+            if (ret != NRF_SUCCESS)
+            {
+                return ret;
+            }
+
+            memcpy(p_buff, p_data, size);
+        }
+        else
+        {
+            if (hit)
+            {
+                p_work->stats.write_hits += count;
+            }
+            else
+            {
+                p_work->stats.write_misses += count;
+            }
+
+            memcpy(p_data, p_buff, size);
+            p_line->valid_mask |= mask;
+            p_line->dirty_mask |= mask;
+        }
+
+        blk_id    += count;
+        remaining -= count;
+        p_buff    += size;
+    }
+
+    if (p_work->ev_handler)
+    {
+        /*Asynchronous operation (simulation)*/
+        const nrf_block_dev_event_t ev = {
+                event,
+                NRF_BLOCK_DEV_RESULT_SUCCESS,
+                p_blk,
+                p_work->p_context
+        };
+
+        p_work->ev_handler(p_blk_dev, &ev);
+    }
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t block_dev_cache_read_req(nrf_block_dev_t const * p_blk_dev,
+                                           nrf_block_req_t const * p_blk)
+{
+    return block_dev_cache_req(p_blk_dev, p_blk, NRF_BLOCK_DEV_EVT_BLK_READ_DONE);
+}
+
+static ret_code_t block_dev_cache_write_req(nrf_block_dev_t const * p_blk_dev,
+                                            nrf_block_req_t const * p_blk)
+{
+    return block_dev_cache_req(p_blk_dev, p_blk, NRF_BLOCK_DEV_EVT_BLK_WRITE_DONE);
+}
+
+static ret_code_t block_dev_cache_ioctl(nrf_block_dev_t const * p_blk_dev,
+                                        nrf_block_dev_ioctl_req_t req,
+                                        void * p_data)
+{
+    ASSERT(p_blk_dev);
+    nrf_block_dev_cache_t const * p_cache_dev =
+                                  CONTAINER_OF(p_blk_dev, nrf_block_dev_cache_t, block_dev);
+    nrf_block_dev_cache_config_t const * p_config = &p_cache_dev->cache_config;
+
+    switch (req)
+    {
+        case NRF_BLOCK_DEV_IOCTL_REQ_CACHE_FLUSH:
+        {
+            NRF_LOG_INST_DEBUG(p_cache_dev->p_log, "IOCtl: Cache flush");
+
+            ret_code_t ret = cache_write_back(p_cache_dev);
+            if (ret != NRF_SUCCESS)
+            {
+                return ret;
+            }
+
+            /* The underlying device may have a cache of its own. Its flush state is
+             * passed back to the caller, who repeats the request until it is done. */
+            return nrf_blk_dev_ioctl(p_config->p_backend, req, p_data);
+        }
+        case NRF_BLOCK_DEV_IOCTL_REQ_INFO_STRINGS:
+            return nrf_blk_dev_ioctl(p_config->p_backend, req, p_data);
+        default:
+            break;
+    }
+
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+static nrf_block_dev_geometry_t const * block_dev_cache_geometry(nrf_block_dev_t const * p_blk_dev)
+{
+    ASSERT(p_blk_dev);
+    nrf_block_dev_cache_t const * p_cache_dev =
+                                  CONTAINER_OF(p_blk_dev, nrf_block_dev_cache_t, block_dev);
+    nrf_block_dev_cache_work_t const * p_work = p_cache_dev->p_work;
+
+    return &p_work->geometry;
+}
+
+const nrf_block_dev_ops_t nrf_block_device_cache_ops = {
+        .init = block_dev_cache_init,
+        .uninit = block_dev_cache_uninit,
+        .read_req = block_dev_cache_read_req,
+        .write_req = block_dev_cache_write_req,
+        .ioctl = block_dev_cache_ioctl,
+        .geometry = block_dev_cache_geometry,
+};
+
+/** @} */
+#endif // NRF_MODULE_ENABLED(NRF_BLOCK_DEV_CACHE)
@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef NRF_BLOCK_DEV_CACHE_H__
+#define NRF_BLOCK_DEV_CACHE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "nrf_block_dev.h"
+#include "nrf_log_instance.h"
+
+/**@file
+ *
+ * @defgroup nrf_block_dev_cache Write-back cache
+ * @ingroup nrf_block_dev
+ * @{
+ *
+ * @brief This module implements a block device that caches another block device.
+ *
+ * The cache consists of a number of lines, each holding one erase unit (a group of
+ * consecutive, aligned blocks) of the underlying device. Lines are replaced in least
+ * recently used order. Writes only modify the cache. Dirty blocks are written back when
+ * their line is evicted or when @ref NRF_BLOCK_DEV_IOCTL_REQ_CACHE_FLUSH is requested.
+ * All dirty blocks of a line are then written in a single request, so that the underlying
+ * device erases and programs each erase unit once.
+ *
+ * The underlying device is used in synchronous mode. If an event handler is passed to
+ * @ref nrf_blk_dev_init, events are generated after each operation is completed, as in
+ * @ref nrf_block_dev_ram.
+ */
+
+/**
+ * @brief Cache block device operations
+ * */
+extern const nrf_block_dev_ops_t nrf_block_device_cache_ops;
+
+/**
+ * @brief Maximum number of blocks in one cache line (erase unit).
+ * */
+#define NRF_BLOCK_DEV_CACHE_MAX_UNIT_BLOCKS 32
+
+/**
+ * @brief Cache line descriptor
+ */
+typedef struct {
+    uint32_t unit_idx;      //!< Index of the erase unit held by the line
+    uint32_t valid_mask;    //!< Blocks of the unit present in the line (0 if the line is free)
+    uint32_t dirty_mask;    //!< Blocks of the unit modified and not yet written back
+    uint32_t last_use;      //!< Value of the use counter at the last access (for LRU)
+} nrf_block_dev_cache_line_t;
+
+/**
+ * @brief Cache statistics
+ */
+typedef struct {
+    uint32_t read_hits;     //!< Blocks read from the cache
+    uint32_t read_misses;   //!< Blocks read from the underlying device
+    uint32_t write_hits;    //!< Blocks written to a line that was already in the cache
+    uint32_t write_misses;  //!< Blocks written to a newly allocated line
+    uint32_t evictions;     //!< Lines evicted to make room for another erase unit
+    uint32_t dev_reads;     //!< Read requests sent to the underlying device
+    uint32_t dev_writes;    //!< Write requests sent to the underlying device
+} nrf_block_dev_cache_stats_t;
+
+/**
+ * @brief Work structure of cache block device
+ */
+typedef struct {
+    nrf_block_dev_geometry_t    geometry;    //!< Block device geometry
+    nrf_block_dev_ev_handler    ev_handler;  //!< Block device event handler
+    void const *                p_context;   //!< Context handle passed to event handler
+    uint32_t                    use_counter; //!< Access counter used for LRU replacement
+    nrf_block_dev_cache_stats_t stats;       //!< Cache statistics
+} nrf_block_dev_cache_work_t;
+
+/** @brief Name of the module used for logger messaging.
+ */
+#define NRF_BLOCK_DEV_CACHE_LOG_NAME block_dev_cache
+
+/**
+ * @brief Cache block device config
+ */
+typedef struct {
+    nrf_block_dev_t const *      p_backend;     //!< Cached block device
+    uint32_t                     block_size;    //!< Block size of the cached device
+    uint32_t                     unit_blocks;   //!< Blocks per erase unit (cache line)
+    uint32_t                     line_count;    //!< Number of cache lines
+    nrf_block_dev_cache_line_t * p_lines;       //!< Cache line descriptors
+    uint8_t *                    p_buffer;      //!< Cache data (line_count * unit_blocks * block_size bytes)
+} nrf_block_dev_cache_config_t;
+
+/**
+ * @brief Cache block device
+ * */
+typedef struct {
+    nrf_block_dev_t                block_dev;       //!< Block device
+    nrf_block_dev_cache_config_t   cache_config;    //!< Cache block device config
+    nrf_block_dev_cache_work_t *   p_work;          //!< Cache block device work structure
+    NRF_LOG_INSTANCE_PTR_DECLARE(p_log)             //!< Pointer to instance of the logger object (Conditionally compiled).
+} nrf_block_dev_cache_t;
+
+/**
+ * @brief Defines a cache block device.
+ *
+ * The cache takes lines * unit_blks * blk_size bytes of RAM. For QSPI flash, use the
+ * erase unit size of the memory (@ref NRF_BLOCK_DEV_QSPI_ERASE_UNIT_SIZE / blk_size). For
+ * SD cards, multi-block writes are much faster than single-block writes, so a few blocks
+ * per line still pay off. With unit_blks equal to 1, the cache is a plain LRU sector cache.
+ *
+ * @param name          Instance name
+ * @param backend       Cached block device (@ref nrf_block_dev_t const *)
+ * @param blk_size      Block size of the cached device
+ * @param unit_blks     Blocks per erase unit, 1 to @ref NRF_BLOCK_DEV_CACHE_MAX_UNIT_BLOCKS
+ * @param lines         Number of cache lines
+ * */
+#define NRF_BLOCK_DEV_CACHE_DEFINE(name, backend, blk_size, unit_blks, lines)                     \
+    STATIC_ASSERT(((unit_blks) >= 1) && ((unit_blks) <= NRF_BLOCK_DEV_CACHE_MAX_UNIT_BLOCKS));    \
+    STATIC_ASSERT(((blk_size) % sizeof(uint32_t)) == 0);                                          \
+    static uint32_t CONCAT_2(name, _buffer)[(lines) * (unit_blks) * (blk_size) /                  \
+                                            sizeof(uint32_t)];                                    \
+    static nrf_block_dev_cache_line_t CONCAT_2(name, _lines)[lines];                              \
+    static nrf_block_dev_cache_work_t CONCAT_2(name, _work);                                      \
+    NRF_LOG_INSTANCE_REGISTER(NRF_BLOCK_DEV_CACHE_LOG_NAME, name,                                 \
+                              NRF_BLOCK_DEV_CACHE_CONFIG_INFO_COLOR,                              \
+                              NRF_BLOCK_DEV_CACHE_CONFIG_DEBUG_COLOR,                             \
+                              NRF_BLOCK_DEV_CACHE_CONFIG_LOG_INIT_FILTER_LEVEL,                   \
+                              NRF_BLOCK_DEV_CACHE_CONFIG_LOG_ENABLED ?                            \
+                                   NRF_BLOCK_DEV_CACHE_CONFIG_LOG_LEVEL : NRF_LOG_SEVERITY_NONE); \
+    static const nrf_block_dev_cache_t name = {                                                   \
+        .block_dev = { .p_ops = &nrf_block_device_cache_ops },                                    \
+        .cache_config = {                                                                         \
+            .p_backend = (backend),                                                               \
+            .block_size = (blk_size),                                                             \
+            .unit_blocks = (unit_blks),                                                           \
+            .line_count = (lines),                                                                \
+            .p_lines = CONCAT_2(name, _lines),                                                    \
+            .p_buffer = (uint8_t *)CONCAT_2(name, _buffer),                                       \
+        },                                                                                        \
+        .p_work = &CONCAT_2(name, _work),                                                         \
+        NRF_LOG_INSTANCE_PTR_INIT(p_log, NRF_BLOCK_DEV_CACHE_LOG_NAME, name)                      \
+    }
+
+/**
+ * @brief Returns block device API handle from cache block device.
+ *
+ * @param[in] p_blk_cache Cache block device
+ * @return Block device handle
+ */
+static inline nrf_block_dev_t const *
+nrf_block_dev_cache_ops_get(nrf_block_dev_cache_t const * p_blk_cache)
+{
+    return &p_blk_cache->block_dev;
+}
+
+/**
+ * @brief Returns the statistics of a cache block device.
+ *
+ * The statistics are cleared by @ref nrf_blk_dev_init.
+ *
+ * @param[in] p_blk_cache Cache block device
+ * @return Pointer to the statistics
+ */
+static inline nrf_block_dev_cache_stats_t const *
+nrf_block_dev_cache_stats_get(nrf_block_dev_cache_t const * p_blk_cache)
+{
+    return &p_blk_cache->p_work->stats;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_BLOCK_DEV_CACHE_H__ */
@@ -0,0 +1,267 @@
+/**
+ * Copyright (c) 2016 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NRF_CRASH_TRACE)
+#include "nrf_crash_trace.h"
+#include "nrf_fstorage_nvmc.h"
+#include "nrf_atomic.h"
+#include "nrf.h"
+
+/** @brief Flash page size in bytes. */
+#define CODE_PAGE_SIZE          4096
+
+/** @brief Mask used to wrap the ring index. */
+#define RING_MASK               (NRF_CRASH_TRACE_RAM_ENTRIES - 1)
+
+/** @brief Size of the flash area dedicated for the trace. */
+#define TRACE_FLASH_SIZE        (NRF_CRASH_TRACE_FLASH_PAGES * CODE_PAGE_SIZE)
+
+/** @brief Maximum size of the stored image. */
+#define TRACE_IMAGE_MAX_SIZE    (sizeof(nrf_crash_trace_hdr_t) + \
+                                 NRF_CRASH_TRACE_RAM_ENTRIES * sizeof(nrf_crash_trace_entry_t))
+
+/** @brief Start address of the area, determined in runtime if configured to follow the application. */
+#define TRACE_START_ADDR        ((NRF_CRASH_TRACE_FLASH_START_PAGE == 0) ?                           \
+                                 (CODE_PAGE_SIZE * CEIL_DIV((uint32_t)CODE_END, CODE_PAGE_SIZE)) : \
+                                 (NRF_CRASH_TRACE_FLASH_START_PAGE * CODE_PAGE_SIZE))
+
+STATIC_ASSERT(IS_POWER_OF_TWO(NRF_CRASH_TRACE_RAM_ENTRIES));
+STATIC_ASSERT(TRACE_IMAGE_MAX_SIZE <= TRACE_FLASH_SIZE);
+STATIC_ASSERT((sizeof(nrf_crash_trace_entry_t) % sizeof(uint32_t)) == 0);
+STATIC_ASSERT((sizeof(nrf_crash_trace_hdr_t) % sizeof(uint32_t)) == 0);
+
+static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt);
+
+/** @brief Fstorage instance used for the trace area. */
+NRF_FSTORAGE_DEF(nrf_fstorage_t m_crash_trace_fstorage) =
+{
+    .evt_handler = fstorage_evt_handler,
+};
+
+static nrf_crash_trace_entry_t          m_ring[NRF_CRASH_TRACE_RAM_ENTRIES]; //!< RAM trace ring.
+static nrf_atomic_u32_t                 m_wr_idx;                            //!< Number of recorded events.
+static nrf_crash_trace_timestamp_func_t m_timestamp_func;                    //!< Timestamp function.
+static nrf_crash_trace_evt_handler_t    m_evt_handler;                       //!< Event handler.
+static bool                             m_initialized;                       //!< Module state.
+
+
+/**
+ * @brief Function for forwarding the fstorage erase result to the user.
+ */
+static void fstorage_evt_handler(nrf_fstorage_evt_t * p_evt)
+{
+    if ((p_evt->id == NRF_FSTORAGE_EVT_ERASE_RESULT) && (m_evt_handler != NULL))
+    {
+        nrf_crash_trace_evt_t evt =
+        {
+            .type   = NRF_CRASH_TRACE_EVT_ERASE_RESULT,
+            .result = p_evt->result,
+        };
+
+        m_evt_handler(&evt);
+    }
+}
+
+
+/**
+ * @brief Function for checking if the trace area is erased.
+ */
+static bool area_is_blank(void)
+{
+    uint32_t const * p_word = (uint32_t const *)nrf_fstorage_rmap(&m_crash_trace_fstorage,
+                                                                  TRACE_START_ADDR);
+
+    for (size_t i = 0; i < TRACE_IMAGE_MAX_SIZE / sizeof(uint32_t); i++)
+    {
+        if (p_word[i] != 0xFFFFFFFF)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+ret_code_t nrf_crash_trace_init(nrf_fstorage_api_t const *       p_fs_api,
+                                nrf_crash_trace_timestamp_func_t timestamp_func,
+                                nrf_crash_trace_evt_handler_t    evt_handler)
+{
+    ret_code_t err_code;
+
+    m_crash_trace_fstorage.start_addr = TRACE_START_ADDR;
+    m_crash_trace_fstorage.end_addr   = TRACE_START_ADDR + TRACE_FLASH_SIZE - 1;
+
+    err_code = nrf_fstorage_init(&m_crash_trace_fstorage, p_fs_api, NULL);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    m_timestamp_func = timestamp_func;
+    m_evt_handler    = evt_handler;
+    m_initialized    = true;
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_crash_trace_put(uint16_t id, uint32_t arg0, uint32_t arg1)
+{
+    uint32_t                  seq     = nrf_atomic_u32_fetch_add(&m_wr_idx, 1);
+    nrf_crash_trace_entry_t * p_entry = &m_ring[seq & RING_MASK];
+
+    p_entry->id        = id;
+    p_entry->seq       = (uint16_t)seq;
+    p_entry->timestamp = m_timestamp_func ? m_timestamp_func() : 0;
+    p_entry->arg0      = arg0;
+    p_entry->arg1      = arg1;
+}
+
+
+ret_code_t nrf_crash_trace_commit(uint32_t fault_id, uint32_t pc, uint32_t info)
+{
+    ret_code_t            err_code;
+    nrf_crash_trace_hdr_t hdr;
+    uint32_t              addr;
+    uint32_t              total = m_wr_idx;
+    uint32_t              count = MIN(total, NRF_CRASH_TRACE_RAM_ENTRIES);
+    uint32_t              first = (total - count) & RING_MASK;
+
+    if (!m_initialized)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    /* The user is not notified from the fault handler. */
+    m_evt_handler = NULL;
+
+    err_code = nrf_fstorage_init(&m_crash_trace_fstorage, &nrf_fstorage_nvmc, NULL);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+#ifdef SOFTDEVICE_PRESENT
+    /* In case of Softdevice MWU may protect access to NVMC. */
+    NVIC_DisableIRQ(MWU_IRQn);
+#endif
+
+    if (!area_is_blank())
+    {
+        err_code = nrf_fstorage_erase(&m_crash_trace_fstorage, TRACE_START_ADDR,
+                                      NRF_CRASH_TRACE_FLASH_PAGES, NULL);
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    /* Records are written in chronological order. The ring wraps at most once. */
+    addr = TRACE_START_ADDR + sizeof(hdr);
+    if (count != 0)
+    {
+        uint32_t chunk = MIN(count, NRF_CRASH_TRACE_RAM_ENTRIES - first);
+
+        err_code = nrf_fstorage_write(&m_crash_trace_fstorage, addr, &m_ring[first],
+                                      chunk * sizeof(nrf_crash_trace_entry_t), NULL);
+        if ((err_code == NRF_SUCCESS) && (chunk < count))
+        {
+            addr += chunk * sizeof(nrf_crash_trace_entry_t);
+            err_code = nrf_fstorage_write(&m_crash_trace_fstorage, addr, &m_ring[0],
+                                          (count - chunk) * sizeof(nrf_crash_trace_entry_t),
+                                          NULL);
+        }
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+    }
+
+    /* Header is written last so that an interrupted commit is never reported as valid. */
+    hdr.magic    = NRF_CRASH_TRACE_MAGIC;
+    hdr.fault_id = fault_id;
+    hdr.pc       = pc;
+    hdr.info     = info;
+    hdr.count    = count;
+    hdr.total    = total;
+
+    return nrf_fstorage_write(&m_crash_trace_fstorage, TRACE_START_ADDR, &hdr, sizeof(hdr), NULL);
+}
+
+
+ret_code_t nrf_crash_trace_stored_get(uint8_t const ** pp_data, size_t * p_size)
+{
+    ASSERT(pp_data);
+    ASSERT(p_size);
+
+    if (!m_initialized)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    nrf_crash_trace_hdr_t const * p_hdr =
+        (nrf_crash_trace_hdr_t const *)nrf_fstorage_rmap(&m_crash_trace_fstorage, TRACE_START_ADDR);
+
+    if ((p_hdr == NULL)                          ||
+        (p_hdr->magic != NRF_CRASH_TRACE_MAGIC)  ||
+        (p_hdr->count > NRF_CRASH_TRACE_RAM_ENTRIES))
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *pp_data = (uint8_t const *)p_hdr;
+    *p_size  = sizeof(nrf_crash_trace_hdr_t) + p_hdr->count * sizeof(nrf_crash_trace_entry_t);
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_crash_trace_stored_erase(void)
+{
+    if (!m_initialized)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    return nrf_fstorage_erase(&m_crash_trace_fstorage, TRACE_START_ADDR,
+                              NRF_CRASH_TRACE_FLASH_PAGES, NULL);
+}
+
+#endif //NRF_MODULE_ENABLED(NRF_CRASH_TRACE)
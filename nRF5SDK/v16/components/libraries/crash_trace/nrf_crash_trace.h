@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2016 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/**
+ * @defgroup nrf_crash_trace Crash trace
+ * @{
+ * @ingroup app_common
+ * @brief Binary trace ring buffer which is committed to flash on fault.
+ *
+ * @details Every trace event is a fixed size record (event ID, timestamp and two arguments)
+ *          stored in a RAM ring buffer. Recording an event is lock-free and takes only a few
+ *          instructions, so it can be used in interrupt context and in code paths where full
+ *          text logging is too expensive.
+ *
+ *          When a fault occurs, @ref nrf_crash_trace_commit copies the content of the ring,
+ *          oldest event first, to a dedicated flash area using the NVMC directly. On the next
+ *          boot the stored image can be fetched with @ref nrf_crash_trace_stored_get and dumped
+ *          in one go, for example over a BLE characteristic. The area is released with
+ *          @ref nrf_crash_trace_stored_erase.
+ */
+
+#ifndef NRF_CRASH_TRACE_H__
+#define NRF_CRASH_TRACE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sdk_common.h"
+#include "nrf_fstorage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Value of @ref nrf_crash_trace_hdr_t::magic in a complete stored trace. */
+#define NRF_CRASH_TRACE_MAGIC   0x43525354
+
+/**
+ * @brief Macro for recording a trace event.
+ *
+ * The macro compiles to nothing if the module is disabled.
+ *
+ * @param[in] _id   Event ID.
+ * @param[in] _arg0 First event argument.
+ * @param[in] _arg1 Second event argument.
+ */
+#if NRF_MODULE_ENABLED(NRF_CRASH_TRACE)
+#define NRF_CRASH_TRACE(_id, _arg0, _arg1) \
+    nrf_crash_trace_put((uint16_t)(_id), (uint32_t)(_arg0), (uint32_t)(_arg1))
+#else
+#define NRF_CRASH_TRACE(_id, _arg0, _arg1)
+#endif
+
+/** @brief Trace event record. */
+typedef struct
+{
+    uint16_t id;        //!< Event ID.
+    uint16_t seq;       //!< Lower bits of the event sequence number.
+    uint32_t timestamp; //!< Event timestamp.
+    uint32_t arg0;      //!< First event argument.
+    uint32_t arg1;      //!< Second event argument.
+} nrf_crash_trace_entry_t;
+
+/** @brief Header of the trace image stored in flash. Records follow the header. */
+typedef struct
+{
+    uint32_t magic;     //!< @ref NRF_CRASH_TRACE_MAGIC if the image is complete.
+    uint32_t fault_id;  //!< Fault ID passed to @ref nrf_crash_trace_commit.
+    uint32_t pc;        //!< Program counter passed to @ref nrf_crash_trace_commit.
+    uint32_t info;      //!< Fault information passed to @ref nrf_crash_trace_commit.
+    uint32_t count;     //!< Number of stored records.
+    uint32_t total;     //!< Number of events recorded since boot, including overwritten ones.
+} nrf_crash_trace_hdr_t;
+
+/**
+ * @brief Timestamp function prototype.
+ *
+ * @return Current timestamp.
+ */
+typedef uint32_t (*nrf_crash_trace_timestamp_func_t)(void);
+
+/** @brief Crash trace event types. */
+typedef enum
+{
+    NRF_CRASH_TRACE_EVT_ERASE_RESULT, //!< Erase of the stored trace completed.
+} nrf_crash_trace_evt_type_t;
+
+/** @brief Crash trace event. */
+typedef struct
+{
+    nrf_crash_trace_evt_type_t type;   //!< Event type.
+    ret_code_t                 result; //!< Result of the operation.
+} nrf_crash_trace_evt_t;
+
+/**
+ * @brief Event handler function prototype.
+ *
+ * @param[in] p_evt Event.
+ */
+typedef void (*nrf_crash_trace_evt_handler_t)(nrf_crash_trace_evt_t const * p_evt);
+
+/**
+ * @brief Function for initializing the module.
+ *
+ * @param[in] p_fs_api       fstorage implementation used for erasing the flash area at run time.
+ * @param[in] timestamp_func Timestamp function. If NULL, events are not timestamped.
+ * @param[in] evt_handler    Event handler. Can be NULL.
+ *
+ * @return Error code returned by @ref nrf_fstorage_init.
+ */
+ret_code_t nrf_crash_trace_init(nrf_fstorage_api_t const *       p_fs_api,
+                                nrf_crash_trace_timestamp_func_t timestamp_func,
+                                nrf_crash_trace_evt_handler_t    evt_handler);
+
+/**
+ * @brief Function for recording a trace event.
+ *
+ * The function can be called from any context. @ref NRF_CRASH_TRACE should be used instead
+ * of calling it directly.
+ *
+ * @param[in] id   Event ID.
+ * @param[in] arg0 First event argument.
+ * @param[in] arg1 Second event argument.
+ */
+void nrf_crash_trace_put(uint16_t id, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief Function for committing the RAM trace to flash.
+ *
+ * Intended to be called from the fault handler with interrupts disabled. Flash is accessed
+ * through the NVMC directly, so the function blocks until the trace is written. A stored trace
+ * which has not been erased yet is overwritten. No events are reported afterwards.
+ *
+ * @param[in] fault_id Fault ID.
+ * @param[in] pc       Program counter at fault.
+ * @param[in] info     Additional fault information.
+ *
+ * @retval NRF_SUCCESS             Trace committed.
+ * @retval NRF_ERROR_INVALID_STATE Module not initialized.
+ * @return Other error codes returned by @ref nrf_fstorage_init, @ref nrf_fstorage_erase
+ *         or @ref nrf_fstorage_write.
+ */
+ret_code_t nrf_crash_trace_commit(uint32_t fault_id, uint32_t pc, uint32_t info);
+
+/**
+ * @brief Function for getting the trace stored in flash.
+ *
+ * The image starts with @ref nrf_crash_trace_hdr_t, followed by
+ * @ref nrf_crash_trace_hdr_t::count records ordered from the oldest to the newest.
+ *
+ * @param[out] pp_data Pointer to the image in flash.
+ * @param[out] p_size  Size of the image in bytes.
+ *
+ * @retval NRF_SUCCESS         Stored trace found.
+ * @retval NRF_ERROR_NOT_FOUND No complete trace stored.
+ */
+ret_code_t nrf_crash_trace_stored_get(uint8_t const ** pp_data, size_t * p_size);
+
+/**
+ * @brief Function for erasing the trace stored in flash.
+ *
+ * Erase is performed through the fstorage implementation passed to @ref nrf_crash_trace_init
+ * and may complete asynchronously. The outcome is reported with
+ * @ref NRF_CRASH_TRACE_EVT_ERASE_RESULT.
+ *
+ * @retval NRF_SUCCESS             Erase started.
+ * @retval NRF_ERROR_INVALID_STATE Module not initialized.
+ * @return Other error codes returned by @ref nrf_fstorage_erase.
+ */
+ret_code_t nrf_crash_trace_stored_erase(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_CRASH_TRACE_H__
+
+/** @} */
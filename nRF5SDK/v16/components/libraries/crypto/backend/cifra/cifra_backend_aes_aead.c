@@ -43,6 +43,7 @@
 #if NRF_MODULE_ENABLED(NRF_CRYPTO)
 
 #include <stdbool.h>
+#include <string.h>
 #include "cifra_backend_aes_aead.h"
 
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_CIFRA_AES_AEAD)
@@ -50,30 +51,152 @@
 /**@internal @brief Type declaration of a template matching all possible context sizes
  *                  for this backend.
  */
-typedef struct
+typedef nrf_crypto_backend_aes_eax_context_t nrf_crypto_backend_cifra_aes_aead_context_t;
+
+/**@internal @brief OMAC tweaks used by EAX mode. */
+#define EAX_TWEAK_NONCE         0
+#define EAX_TWEAK_HEADER        1
+#define EAX_TWEAK_CIPHERTEXT    2
+
+/**@internal @brief States of a stream operation. */
+#define EAX_STREAM_IDLE         0   /**< No stream operation in progress. */
+#define EAX_STREAM_HEADER       1   /**< Nonce processed, accepting header. */
+#define EAX_STREAM_DATA         2   /**< Header processed, accepting data. */
+
+
+static void block_xor(uint8_t * p_out, uint8_t const * p_in)
+{
+    for (uint32_t i = 0; i < NRF_CRYPTO_AES_BLOCK_SIZE; i++)
+    {
+        p_out[i] ^= p_in[i];
+    }
+}
+
+/**@internal @brief Function for comparing MACs in constant time. */
+static bool mac_equal(uint8_t const * p_mac1, uint8_t const * p_mac2, uint8_t size)
+{
+    uint8_t diff = 0;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        diff |= p_mac1[i] ^ p_mac2[i];
+    }
+
+    return (diff == 0);
+}
+
+/**@internal @brief Function for starting an OMAC calculation.
+ *
+ * @details The tweak block only depends on the key, so the state after it comes from the values
+ *          computed in @ref backend_cifra_init instead of from a block encryption.
+ */
+static void omac_start(nrf_crypto_backend_cifra_aes_aead_context_t const * p_ctx,
+                       nrf_crypto_backend_eax_omac_t                     * p_omac,
+                       uint8_t                                             tweak)
+{
+    memcpy(p_omac->block, p_ctx->omac_first[tweak], NRF_CRYPTO_AES_BLOCK_SIZE);
+    p_omac->used  = 0;
+    p_omac->tweak = tweak;
+    p_omac->empty = true;
+}
+
+static void omac_update(nrf_crypto_backend_cifra_aes_aead_context_t const * p_ctx,
+                        nrf_crypto_backend_eax_omac_t                     * p_omac,
+                        uint8_t const                                     * p_data,
+                        size_t                                              size)
 {
-    nrf_crypto_aead_internal_context_t header;   /**< Common header for context. */
-    cf_aes_context                     context;
-} nrf_crypto_backend_cifra_aes_aead_context_t;
+    size_t chunk;
+
+    if (size == 0)
+    {
+        return;
+    }
 
+    p_omac->empty = false;
 
-static ret_code_t result_get(int error)
+    /* The last block is kept in the buffer, as it is processed differently in omac_finish. */
+    while (size > 0)
+    {
+        if (p_omac->used == NRF_CRYPTO_AES_BLOCK_SIZE)
+        {
+            block_xor(p_omac->block, p_omac->buffer);
+            cf_aes_encrypt(&p_ctx->context, p_omac->block, p_omac->block);
+            p_omac->used = 0;
+        }
+
+        if ((p_omac->used == 0) && (size > NRF_CRYPTO_AES_BLOCK_SIZE))
+        {
+            block_xor(p_omac->block, p_data);
+            cf_aes_encrypt(&p_ctx->context, p_omac->block, p_omac->block);
+            p_data += NRF_CRYPTO_AES_BLOCK_SIZE;
+            size   -= NRF_CRYPTO_AES_BLOCK_SIZE;
+            continue;
+        }
+
+        chunk = MIN(size, (size_t)(NRF_CRYPTO_AES_BLOCK_SIZE - p_omac->used));
+        memcpy(&p_omac->buffer[p_omac->used], p_data, chunk);
+        p_omac->used += (uint8_t)chunk;
+        p_data       += chunk;
+        size         -= chunk;
+    }
+}
+
+static void omac_finish(nrf_crypto_backend_cifra_aes_aead_context_t const * p_ctx,
+                        nrf_crypto_backend_eax_omac_t                     * p_omac,
+                        uint8_t                                           * p_out)
 {
-    switch (error)
+    if (p_omac->empty)
     {
-        case 0:
-            return NRF_SUCCESS;
+        memcpy(p_out, p_ctx->omac_empty[p_omac->tweak], NRF_CRYPTO_AES_BLOCK_SIZE);
+        return;
+    }
 
-        case 1:
-            return NRF_ERROR_CRYPTO_AEAD_INVALID_MAC;
+    if (p_omac->used == NRF_CRYPTO_AES_BLOCK_SIZE)
+    {
+        block_xor(p_omac->block, p_ctx->cmac.B);
+    }
+    else
+    {
+        p_omac->buffer[p_omac->used] = 0x80;
+        memset(&p_omac->buffer[p_omac->used + 1],
+               0,
+               NRF_CRYPTO_AES_BLOCK_SIZE - p_omac->used - 1);
+        block_xor(p_omac->block, p_ctx->cmac.P);
+    }
+
+    block_xor(p_omac->block, p_omac->buffer);
+    cf_aes_encrypt(&p_ctx->context, p_omac->block, p_out);
+}
+
+static void omac_compute(nrf_crypto_backend_cifra_aes_aead_context_t const * p_ctx,
+                         uint8_t                                             tweak,
+                         uint8_t const                                     * p_data,
+                         size_t                                              size,
+                         uint8_t                                           * p_out)
+{
+    nrf_crypto_backend_eax_omac_t omac;
+
+    omac_start(p_ctx, &omac, tweak);
+    omac_update(p_ctx, &omac, p_data, size);
+    omac_finish(p_ctx, &omac, p_out);
+}
 
-        default:
-            return NRF_ERROR_CRYPTO_INTERNAL;
+static void tag_compute(uint8_t       * p_tag,
+                        uint8_t const * p_nonce_mac,
+                        uint8_t const * p_header_mac,
+                        uint8_t const * p_cipher_mac,
+                        uint8_t         tag_size)
+{
+    for (uint32_t i = 0; i < tag_size; i++)
+    {
+        p_tag[i] = p_nonce_mac[i] ^ p_header_mac[i] ^ p_cipher_mac[i];
     }
 }
 
 static ret_code_t backend_cifra_init(void * const p_context, uint8_t * p_key)
 {
+    uint8_t tweak[NRF_CRYPTO_AES_BLOCK_SIZE];
+
     nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
         (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
 
@@ -91,6 +214,23 @@ static ret_code_t backend_cifra_init(void * const p_context, uint8_t * p_key)
                 p_key,
                 (p_ctx->header.p_info->key_size)>>3);  // >>3: changes bits to bytes
 
+    /* Everything in EAX that depends only on the key: the OMAC subkeys, and the OMAC of each
+     * tweak block, alone or followed by more data. */
+    cf_cmac_init(&p_ctx->cmac, &cf_aes, &p_ctx->context);
+
+    for (uint8_t t = 0; t < ARRAY_SIZE(p_ctx->omac_first); t++)
+    {
+        memset(tweak, 0, sizeof(tweak));
+        tweak[NRF_CRYPTO_AES_BLOCK_SIZE - 1] = t;
+
+        cf_aes_encrypt(&p_ctx->context, tweak, p_ctx->omac_first[t]);
+
+        block_xor(tweak, p_ctx->cmac.B);
+        cf_aes_encrypt(&p_ctx->context, tweak, p_ctx->omac_empty[t]);
+    }
+
+    p_ctx->stream_state = EAX_STREAM_IDLE;
+
     return NRF_SUCCESS;
 }
 
@@ -102,6 +242,14 @@ static ret_code_t backend_cifra_uninit(void * const p_context)
 
     cf_aes_finish(&p_ctx->context);
 
+    memset(&p_ctx->cmac, 0, sizeof(p_ctx->cmac));
+    memset(p_ctx->omac_first, 0, sizeof(p_ctx->omac_first));
+    memset(p_ctx->omac_empty, 0, sizeof(p_ctx->omac_empty));
+    memset(&p_ctx->ctr, 0, sizeof(p_ctx->ctr));
+    memset(&p_ctx->omac, 0, sizeof(p_ctx->omac));
+
+    p_ctx->stream_state = EAX_STREAM_IDLE;
+
     return NRF_SUCCESS;
 }
 
@@ -117,56 +265,155 @@ static ret_code_t backend_cifra_crypt(void * const           p_context,
                                       uint8_t *              p_mac,
                                       uint8_t                mac_size)
 {
-
-    int        result;
-    ret_code_t ret_val;
+    uint8_t nonce_mac[NRF_CRYPTO_AES_BLOCK_SIZE];
+    uint8_t header_mac[NRF_CRYPTO_AES_BLOCK_SIZE];
+    uint8_t cipher_mac[NRF_CRYPTO_AES_BLOCK_SIZE];
+    uint8_t tag[NRF_CRYPTO_AES_BLOCK_SIZE];
+    cf_ctr  ctr;
 
     nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
         (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
 
-    ret_val = NRF_SUCCESS;
-
     /* EAX mode allows following mac size: [1 ... 16] */
     if ((mac_size < 1) || (mac_size > NRF_CRYPTO_AES_BLOCK_SIZE))
     {
         return NRF_ERROR_CRYPTO_AEAD_MAC_SIZE;
     }
 
+    if ((operation != NRF_CRYPTO_ENCRYPT) && (operation != NRF_CRYPTO_DECRYPT))
+    {
+        return NRF_ERROR_CRYPTO_INVALID_PARAM;
+    }
+
+    omac_compute(p_ctx, EAX_TWEAK_NONCE, p_nonce, nonce_size, nonce_mac);
+    omac_compute(p_ctx, EAX_TWEAK_HEADER, p_adata, adata_size, header_mac);
+
+    cf_ctr_init(&ctr, &cf_aes, &p_ctx->context, nonce_mac);
+
     if (operation == NRF_CRYPTO_ENCRYPT)
     {
-        cf_eax_encrypt(&cf_aes,
-                       &p_ctx->context,
-                       p_data_in,
-                       data_in_size,
-                       p_adata,
-                       adata_size,
-                       p_nonce,
-                       (size_t)nonce_size,
-                       p_data_out,
-                       p_mac,
-                       mac_size);
-    }
-    else if (operation == NRF_CRYPTO_DECRYPT)
-    {
-        result = cf_eax_decrypt(&cf_aes,
-                                &p_ctx->context,
-                                p_data_in,
-                                data_in_size,
-                                p_adata,
-                                adata_size,
-                                p_nonce,
-                                (size_t)nonce_size,
-                                p_mac,
-                                mac_size,
-                                p_data_out);
-        ret_val = result_get(result);
+        cf_ctr_cipher(&ctr, p_data_in, p_data_out, data_in_size);
+        omac_compute(p_ctx, EAX_TWEAK_CIPHERTEXT, p_data_out, data_in_size, cipher_mac);
+        tag_compute(p_mac, nonce_mac, header_mac, cipher_mac, mac_size);
     }
     else
     {
-        return NRF_ERROR_CRYPTO_INVALID_PARAM;
+        /* The MAC is checked before any data is decrypted. */
+        omac_compute(p_ctx, EAX_TWEAK_CIPHERTEXT, p_data_in, data_in_size, cipher_mac);
+        tag_compute(tag, nonce_mac, header_mac, cipher_mac, mac_size);
+
+        if (!mac_equal(tag, p_mac, mac_size))
+        {
+            return NRF_ERROR_CRYPTO_AEAD_INVALID_MAC;
+        }
+
+        cf_ctr_cipher(&ctr, p_data_in, p_data_out, data_in_size);
     }
 
-    return ret_val;
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_cifra_stream_start(void * const           p_context,
+                                             nrf_crypto_operation_t operation,
+                                             uint8_t *              p_nonce,
+                                             uint8_t                nonce_size)
+{
+    nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
+
+    omac_compute(p_ctx, EAX_TWEAK_NONCE, p_nonce, nonce_size, p_ctx->nonce_mac);
+    cf_ctr_init(&p_ctx->ctr, &cf_aes, &p_ctx->context, p_ctx->nonce_mac);
+    omac_start(p_ctx, &p_ctx->omac, EAX_TWEAK_HEADER);
+
+    p_ctx->operation    = (uint8_t)operation;
+    p_ctx->stream_state = EAX_STREAM_HEADER;
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_cifra_stream_adata(void * const p_context,
+                                             uint8_t *    p_adata,
+                                             size_t       adata_size)
+{
+    nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
+
+    VERIFY_TRUE((p_ctx->stream_state == EAX_STREAM_HEADER), NRF_ERROR_CRYPTO_INVALID_PARAM);
+
+    omac_update(p_ctx, &p_ctx->omac, p_adata, adata_size);
+
+    return NRF_SUCCESS;
+}
+
+/**@internal @brief Function for finishing the header OMAC and starting the ciphertext OMAC. */
+static void stream_header_end(nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx)
+{
+    if (p_ctx->stream_state == EAX_STREAM_HEADER)
+    {
+        omac_finish(p_ctx, &p_ctx->omac, p_ctx->header_mac);
+        omac_start(p_ctx, &p_ctx->omac, EAX_TWEAK_CIPHERTEXT);
+        p_ctx->stream_state = EAX_STREAM_DATA;
+    }
+}
+
+static ret_code_t backend_cifra_stream_update(void * const p_context,
+                                              uint8_t *    p_data_in,
+                                              size_t       data_in_size,
+                                              uint8_t *    p_data_out)
+{
+    nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
+
+    VERIFY_TRUE((p_ctx->stream_state != EAX_STREAM_IDLE), NRF_ERROR_CRYPTO_INVALID_PARAM);
+
+    stream_header_end(p_ctx);
+
+    if (p_ctx->operation == NRF_CRYPTO_ENCRYPT)
+    {
+        cf_ctr_cipher(&p_ctx->ctr, p_data_in, p_data_out, data_in_size);
+        omac_update(p_ctx, &p_ctx->omac, p_data_out, data_in_size);
+    }
+    else
+    {
+        omac_update(p_ctx, &p_ctx->omac, p_data_in, data_in_size);
+        cf_ctr_cipher(&p_ctx->ctr, p_data_in, p_data_out, data_in_size);
+    }
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_cifra_stream_finalize(void * const p_context,
+                                                uint8_t *    p_mac,
+                                                uint8_t      mac_size)
+{
+    uint8_t cipher_mac[NRF_CRYPTO_AES_BLOCK_SIZE];
+    uint8_t tag[NRF_CRYPTO_AES_BLOCK_SIZE];
+
+    nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
+
+    VERIFY_TRUE((p_ctx->stream_state != EAX_STREAM_IDLE), NRF_ERROR_CRYPTO_INVALID_PARAM);
+
+    stream_header_end(p_ctx);
+    p_ctx->stream_state = EAX_STREAM_IDLE;
+
+    /* EAX mode allows following mac size: [1 ... 16] */
+    if ((mac_size < 1) || (mac_size > NRF_CRYPTO_AES_BLOCK_SIZE))
+    {
+        return NRF_ERROR_CRYPTO_AEAD_MAC_SIZE;
+    }
+
+    omac_finish(p_ctx, &p_ctx->omac, cipher_mac);
+
+    if (p_ctx->operation == NRF_CRYPTO_ENCRYPT)
+    {
+        tag_compute(p_mac, p_ctx->nonce_mac, p_ctx->header_mac, cipher_mac, mac_size);
+        return NRF_SUCCESS;
+    }
+
+    tag_compute(tag, p_ctx->nonce_mac, p_ctx->header_mac, cipher_mac, mac_size);
+
+    return mac_equal(tag, p_mac, mac_size) ? NRF_SUCCESS : NRF_ERROR_CRYPTO_AEAD_INVALID_MAC;
 }
 
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_CIFRA_AES_EAX)
@@ -177,7 +424,12 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_128_info =
 
     .init_fn   = backend_cifra_init,
     .uninit_fn = backend_cifra_uninit,
-    .crypt_fn  = backend_cifra_crypt
+    .crypt_fn  = backend_cifra_crypt,
+
+    .stream_start_fn    = backend_cifra_stream_start,
+    .stream_adata_fn    = backend_cifra_stream_adata,
+    .stream_update_fn   = backend_cifra_stream_update,
+    .stream_finalize_fn = backend_cifra_stream_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_192_info =
@@ -187,7 +439,12 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_192_info =
 
     .init_fn   = backend_cifra_init,
     .uninit_fn = backend_cifra_uninit,
-    .crypt_fn  = backend_cifra_crypt
+    .crypt_fn  = backend_cifra_crypt,
+
+    .stream_start_fn    = backend_cifra_stream_start,
+    .stream_adata_fn    = backend_cifra_stream_adata,
+    .stream_update_fn   = backend_cifra_stream_update,
+    .stream_finalize_fn = backend_cifra_stream_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_256_info =
@@ -197,7 +454,12 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_256_info =
 
     .init_fn   = backend_cifra_init,
     .uninit_fn = backend_cifra_uninit,
-    .crypt_fn  = backend_cifra_crypt
+    .crypt_fn  = backend_cifra_crypt,
+
+    .stream_start_fn    = backend_cifra_stream_start,
+    .stream_adata_fn    = backend_cifra_stream_adata,
+    .stream_update_fn   = backend_cifra_stream_update,
+    .stream_finalize_fn = backend_cifra_stream_finalize
 };
 #endif
 
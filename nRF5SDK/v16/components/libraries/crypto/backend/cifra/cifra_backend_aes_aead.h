@@ -50,6 +50,7 @@
  * @brief AES AEAD functionality provided by the nrf_crypto Cifra backend.
  */
 
+#include <stdbool.h>
 #include "sdk_config.h"
 
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_CIFRA)
@@ -80,10 +81,31 @@ extern "C" {
 #define NRF_CRYPTO_AES_EAX_192_ENABLED  1
 #define NRF_CRYPTO_AES_EAX_256_ENABLED  1
 
+/**@internal @brief State of an OMAC calculation in EAX mode. */
+typedef struct
+{
+    uint8_t block[NRF_CRYPTO_AES_BLOCK_SIZE];   /**< CBC-MAC chaining value. */
+    uint8_t buffer[NRF_CRYPTO_AES_BLOCK_SIZE];  /**< Last input block, processed when more data arrives. */
+    uint8_t used;                               /**< Number of bytes in buffer. */
+    uint8_t tweak;                              /**< OMAC tweak: 0 for nonce, 1 for header, 2 for ciphertext. */
+    bool    empty;                              /**< No input was processed yet. */
+} nrf_crypto_backend_eax_omac_t;
+
 typedef struct
 {
     nrf_crypto_aead_internal_context_t header;  /**< Common header for context. */
     cf_aes_context                     context; /**< AES EAX context internal to Cifra. */
+    cf_cmac                            cmac;    /**< OMAC subkeys, computed once per key. */
+    uint8_t omac_first[3][NRF_CRYPTO_AES_BLOCK_SIZE];  /**< OMAC state after the tweak block, for each tweak. */
+    uint8_t omac_empty[3][NRF_CRYPTO_AES_BLOCK_SIZE];  /**< OMAC of empty input, for each tweak. */
+
+    /* Stream operation state. */
+    cf_ctr                             ctr;     /**< CTR state. */
+    nrf_crypto_backend_eax_omac_t      omac;    /**< OMAC of header, then of ciphertext. */
+    uint8_t nonce_mac[NRF_CRYPTO_AES_BLOCK_SIZE];   /**< OMAC of nonce. */
+    uint8_t header_mac[NRF_CRYPTO_AES_BLOCK_SIZE];  /**< OMAC of header. */
+    uint8_t operation;                          /**< Operation of the stream (nrf_crypto_operation_t). */
+    uint8_t stream_state;                       /**< Stream operation state. */
 } nrf_crypto_backend_aes_eax_context_t;
 #endif
 
@@ -142,6 +142,7 @@ static ret_code_t backend_mbedtls_init(void * const p_context, uint8_t * p_key)
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS_AES_GCM)
         case NRF_CRYPTO_AEAD_MODE_AES_GCM:
             mbedtls_gcm_init(&p_ctx->gcm.context);
+            p_ctx->gcm.stream = false;
 
             result = mbedtls_gcm_setkey(&p_ctx->gcm.context,
                                         MBEDTLS_CIPHER_ID_AES,
@@ -278,6 +279,9 @@ static ret_code_t backend_mbedtls_gcm_crypt(void * const            p_context,
         return NRF_ERROR_CRYPTO_AEAD_MAC_SIZE;
     }
 
+    /* A one-shot operation overwrites the state of a stream operation in progress. */
+    p_ctx->gcm.stream = false;
+
     if (operation == NRF_CRYPTO_ENCRYPT)
     {
         result = mbedtls_gcm_crypt_and_tag(&p_ctx->gcm.context,
@@ -316,6 +320,123 @@ static ret_code_t backend_mbedtls_gcm_crypt(void * const            p_context,
 }
 #endif
 
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS_AES_GCM)
+static ret_code_t backend_mbedtls_gcm_stream_start(void * const           p_context,
+                                                   nrf_crypto_operation_t operation,
+                                                   uint8_t *              p_nonce,
+                                                   uint8_t                nonce_size)
+{
+    int result;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    result = mbedtls_gcm_starts(&p_ctx->gcm.context,
+                                (operation == NRF_CRYPTO_ENCRYPT) ? MBEDTLS_GCM_ENCRYPT :
+                                                                    MBEDTLS_GCM_DECRYPT,
+                                p_nonce,
+                                nonce_size,
+                                NULL,
+                                0);
+
+    p_ctx->gcm.stream = (result == 0);
+
+    return result_get(result);
+}
+
+static ret_code_t backend_mbedtls_gcm_stream_adata(void * const p_context,
+                                                   uint8_t *    p_adata,
+                                                   size_t       adata_size)
+{
+    int result;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    /* Additional data must come before the data. */
+    VERIFY_TRUE((p_ctx->gcm.stream && (p_ctx->gcm.context.len == 0)),
+                NRF_ERROR_CRYPTO_INVALID_PARAM);
+
+    /* Only the last chunk of additional data can be a partial block. */
+    result = mbedtls_gcm_update_ad(&p_ctx->gcm.context, p_adata, adata_size);
+    if (result != 0)
+    {
+        p_ctx->gcm.stream = false;
+        return NRF_ERROR_CRYPTO_INPUT_LENGTH;
+    }
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_mbedtls_gcm_stream_update(void * const p_context,
+                                                    uint8_t *    p_data_in,
+                                                    size_t       data_in_size,
+                                                    uint8_t *    p_data_out)
+{
+    int result;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    VERIFY_TRUE(p_ctx->gcm.stream, NRF_ERROR_CRYPTO_INVALID_PARAM);
+
+    /* Only the last chunk of data can be a partial block. */
+    if ((p_ctx->gcm.context.len & (NRF_CRYPTO_AES_BLOCK_SIZE - 1)) != 0)
+    {
+        p_ctx->gcm.stream = false;
+        return NRF_ERROR_CRYPTO_INPUT_LENGTH;
+    }
+
+    result = mbedtls_gcm_update(&p_ctx->gcm.context, data_in_size, p_data_in, p_data_out);
+    if (result != 0)
+    {
+        p_ctx->gcm.stream = false;
+    }
+
+    return result_get(result);
+}
+
+static ret_code_t backend_mbedtls_gcm_stream_finalize(void * const p_context,
+                                                      uint8_t *    p_mac,
+                                                      uint8_t      mac_size)
+{
+    int     result;
+    uint8_t mac[NRF_CRYPTO_AES_GCM_MAC_MAX];
+    uint8_t diff;
+    uint8_t i;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    VERIFY_TRUE(p_ctx->gcm.stream, NRF_ERROR_CRYPTO_INVALID_PARAM);
+
+    p_ctx->gcm.stream = false;
+
+    /* GCM allows following MAC size: [4 ... 16] */
+    if ((mac_size < NRF_CRYPTO_AES_GCM_MAC_MIN) || (mac_size > NRF_CRYPTO_AES_GCM_MAC_MAX))
+    {
+        return NRF_ERROR_CRYPTO_AEAD_MAC_SIZE;
+    }
+
+    if (p_ctx->gcm.context.mode == MBEDTLS_GCM_ENCRYPT)
+    {
+        result = mbedtls_gcm_finish(&p_ctx->gcm.context, p_mac, (size_t)mac_size);
+        return result_get(result);
+    }
+
+    result = mbedtls_gcm_finish(&p_ctx->gcm.context, mac, (size_t)mac_size);
+    VERIFY_TRUE((result == 0), result_get(result));
+
+    /* Check tag in "constant-time" */
+    for (diff = 0, i = 0; i < mac_size; i++)
+    {
+        diff |= p_mac[i] ^ mac[i];
+    }
+
+    return (diff == 0) ? NRF_SUCCESS : NRF_ERROR_CRYPTO_AEAD_INVALID_MAC;
+}
+#endif
+
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS_AES_CCM)
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_ccm_128_info =
 {
@@ -356,7 +477,12 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_128_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_gcm_crypt
+    .crypt_fn  = backend_mbedtls_gcm_crypt,
+
+    .stream_start_fn    = backend_mbedtls_gcm_stream_start,
+    .stream_adata_fn    = backend_mbedtls_gcm_stream_adata,
+    .stream_update_fn   = backend_mbedtls_gcm_stream_update,
+    .stream_finalize_fn = backend_mbedtls_gcm_stream_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_192_info =
@@ -366,7 +492,12 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_192_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_gcm_crypt
+    .crypt_fn  = backend_mbedtls_gcm_crypt,
+
+    .stream_start_fn    = backend_mbedtls_gcm_stream_start,
+    .stream_adata_fn    = backend_mbedtls_gcm_stream_adata,
+    .stream_update_fn   = backend_mbedtls_gcm_stream_update,
+    .stream_finalize_fn = backend_mbedtls_gcm_stream_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_256_info =
@@ -376,7 +507,12 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_256_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_gcm_crypt
+    .crypt_fn  = backend_mbedtls_gcm_crypt,
+
+    .stream_start_fn    = backend_mbedtls_gcm_stream_start,
+    .stream_adata_fn    = backend_mbedtls_gcm_stream_adata,
+    .stream_update_fn   = backend_mbedtls_gcm_stream_update,
+    .stream_finalize_fn = backend_mbedtls_gcm_stream_finalize
 };
 #endif
 
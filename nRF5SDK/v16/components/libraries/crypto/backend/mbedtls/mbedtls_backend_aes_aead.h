@@ -50,6 +50,7 @@
  * @brief AES AEAD functionality provided by the nrf_crypto mbed TLS backend.
  */
 
+#include <stdbool.h>
 #include "sdk_config.h"
 
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS)
@@ -108,6 +109,7 @@ typedef struct
 {
     nrf_crypto_aead_internal_context_t header;   /**< Common header for context. */
     mbedtls_gcm_context                context;  /**< AES GCM context internal to mbed TLS. */
+    bool                               stream;   /**< A stream operation is in progress. */
 } nrf_crypto_backend_aes_gcm_context_t;
 #endif
 
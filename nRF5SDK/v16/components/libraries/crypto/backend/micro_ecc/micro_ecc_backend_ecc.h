@@ -233,9 +233,38 @@ typedef struct
     uint32_t key[2 * 256 / 32];                  /**< @internal @brief micro-ecc specific key representation */
 } nrf_crypto_backend_secp256r1_public_key_t;
 
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB)
+
+/** @internal See @ref nrf_crypto_backend_ecc_key_pair_generate_fn_t.
+ *
+ *  Computes the public key with the fixed-base comb method (micro_ecc_backend_p256_comb.c).
+ */
+ret_code_t nrf_crypto_backend_micro_ecc_p256_comb_key_pair_generate(
+    void * p_context,
+    void * p_private_key,
+    void * p_public_key);
+
+
+/** @internal See @ref nrf_crypto_backend_ecc_public_key_calculate_fn_t.
+ *
+ *  Computes the public key with the fixed-base comb method (micro_ecc_backend_p256_comb.c).
+ */
+ret_code_t nrf_crypto_backend_micro_ecc_p256_comb_public_key_calculate(
+    void       * p_context,
+    void const * p_private_key,
+    void       * p_public_key);
+
+#define nrf_crypto_backend_secp256r1_key_pair_generate nrf_crypto_backend_micro_ecc_p256_comb_key_pair_generate
+#define nrf_crypto_backend_secp256r1_public_key_calculate nrf_crypto_backend_micro_ecc_p256_comb_public_key_calculate
+
+#else
+
 // Aliases for one common micro-ecc implementation
 #define nrf_crypto_backend_secp256r1_key_pair_generate nrf_crypto_backend_micro_ecc_key_pair_generate
 #define nrf_crypto_backend_secp256r1_public_key_calculate nrf_crypto_backend_micro_ecc_public_key_calculate
+
+#endif // NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB)
+
 #define nrf_crypto_backend_secp256r1_private_key_from_raw nrf_crypto_backend_micro_ecc_private_key_from_raw
 #define nrf_crypto_backend_secp256r1_private_key_to_raw nrf_crypto_backend_micro_ecc_private_key_to_raw
 #define nrf_crypto_backend_secp256r1_public_key_from_raw nrf_crypto_backend_micro_ecc_public_key_from_raw
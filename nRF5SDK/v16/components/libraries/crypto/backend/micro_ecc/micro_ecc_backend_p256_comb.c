@@ -0,0 +1,888 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "sdk_config.h"
+#include "nordic_common.h"
+
+#if NRF_MODULE_ENABLED(NRF_CRYPTO) && NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MICRO_ECC) \
+    && NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MICRO_ECC_ECC_SECP256R1)                  \
+    && NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB)
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "app_util.h"
+#include "nrf_crypto_ecc.h"
+#include "micro_ecc_backend_ecc.h"
+
+/*
+ * Computation of secp256r1 public keys (d * G) with the fixed-base comb method.
+ *
+ * The scalar is split into NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH rows of P256_COMB_D bits.
+ * Each column of the comb selects a precomputed sum of G * 2^(P256_COMB_D * row) from a table in
+ * flash, so the multiplication costs P256_COMB_D doublings and additions, instead of 256 of each.
+ * The columns are recoded to be odd and signed (as in mbed TLS ecp_mul_comb()), so the table only
+ * holds the odd combinations, and there is no addition of the point at infinity.
+ *
+ * Timing does not depend on the private key: the field arithmetic has no data-dependent branches,
+ * and every table entry is read on each lookup. The special cases of the point addition are only
+ * hit for a negligible fraction of the keys.
+ *
+ * Field elements and scalars are little-endian arrays of 32-bit words, which is also the format
+ * of the micro-ecc keys (uECC_VLI_NATIVE_LITTLE_ENDIAN).
+ */
+
+#define P256_WORDS      8                                                   /**< Number of 32-bit words in a field element. */
+#define P256_COMB_W     NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH         /**< Number of comb teeth. */
+#define P256_COMB_D     ((256 + P256_COMB_W - 1) / P256_COMB_W)             /**< Number of comb columns. */
+#define P256_KEYGEN_TRIES   64                                              /**< Number of random private keys to try, as in micro-ecc. */
+
+typedef uint32_t p256_fe_t[P256_WORDS];
+
+/** Point in affine coordinates. */
+typedef struct
+{
+    p256_fe_t x;
+    p256_fe_t y;
+} p256_affine_t;
+
+/** Point in Jacobian coordinates (X / Z^2, Y / Z^3). Z equal to 0 is the point at infinity. */
+typedef struct
+{
+    p256_fe_t x;
+    p256_fe_t y;
+    p256_fe_t z;
+} p256_jacobian_t;
+
+/** Field prime p = 2^256 - 2^224 + 2^192 + 2^96 - 1. */
+static const p256_fe_t m_p =
+{
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF
+};
+
+/** Curve order n. */
+static const p256_fe_t m_n =
+{
+    0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF
+};
+
+/** Curve parameter b. */
+static const p256_fe_t m_b =
+{
+    0x27D2604B, 0x3BCE3C3E, 0xCC53B0F6, 0x651D06B0, 0x769886BC, 0xB3EBBD55, 0xAA3A93E7, 0x5AC635D8
+};
+
+/** Comb table. Entry i is the sum of G * 2^(P256_COMB_D * j) for every bit j set in (2 * i + 1).
+ *  Generated with a script from the curve parameters. */
+#if NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH == 4
+
+static const p256_affine_t m_comb_table[8] =
+{
+    {
+        {0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2},
+        {0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+    },
+    {
+        {0x097992AF, 0x93391CE2, 0x0D35F1FA, 0xE96C98FD, 0x95E02789, 0xB257C0DE, 0x89D6726F, 0x300A4BBC},
+        {0xC08127A0, 0xAA54A291, 0xA9D806A5, 0x5BB1EEAD, 0xFF1E3C6F, 0x7F1DDB25, 0xD09B4644, 0x72AAC7E0},
+    },
+    {
+        {0x2A1D367F, 0x13949C93, 0x1A0A11B7, 0xEF7FBD2B, 0xB91DFC60, 0xDDC6068B, 0x8A9C72FF, 0xEF951932},
+        {0x7376D8A8, 0x196035A7, 0x95CA1740, 0x23183B08, 0x022C219C, 0xC1EE9807, 0x7DBB2C9B, 0x611E9FC3},
+    },
+    {
+        {0xFC5CDE01, 0xE48ECAFF, 0x0D715F26, 0x7CCD84E7, 0xF43E4391, 0xA2E8F483, 0xB21141EA, 0xEB5D7745},
+        {0x731A3479, 0xCAC917E2, 0x2844B645, 0x85F22CFE, 0x58006CEE, 0x0990E6A1, 0xDBECC17B, 0xEAFD72EB},
+    },
+    {
+        {0x677C8A3E, 0x2DF48C04, 0x0203A56B, 0x74E02F08, 0xB8C7FEDB, 0x31855F7D, 0x72C9DDAD, 0x4E769E76},
+        {0xB824BBB0, 0xA4C36165, 0x3B9122A5, 0xFB9AE16F, 0x06947281, 0x1EC00572, 0xDE830663, 0x42B99082},
+    },
+    {
+        {0xC31A3573, 0x7F991ED2, 0xD54FB496, 0x5B82DD5B, 0x812FFCAE, 0x595C5220, 0x716B1287, 0x0C88BC4D},
+        {0x5F48ACA8, 0x3A57BF63, 0xDF2564F3, 0x7C8181F4, 0x9C04E6AA, 0x18D1B5B3, 0xF3901DC6, 0xDD5DDEA3},
+    },
+    {
+        {0xA2582E7F, 0xD36B4789, 0x4EC39C28, 0x0D1A1014, 0xEDBAD7A0, 0x663C62C3, 0x6F461DB9, 0x4052BF4B},
+        {0x188D25EB, 0x235A27C3, 0x99BFCC5B, 0xE724F339, 0x71D70CC8, 0x862BE6BD, 0x90B0FC61, 0xFECF4D51},
+    },
+    {
+        {0x0D1D78E5, 0x9615B511, 0x25C4744B, 0x66B0DE32, 0x6AAF363A, 0x0A4A46FB, 0x84F7A21C, 0xB48E26B4},
+        {0x21A01B2D, 0x06EBB0F6, 0x8B7B0F98, 0xC004E404, 0xFED6F668, 0x64131BCD, 0x4D4D3DAB, 0xFAC01540},
+    },
+};
+
+#elif NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH == 5
+
+static const p256_affine_t m_comb_table[16] =
+{
+    {
+        {0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2},
+        {0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+    },
+    {
+        {0x04BAC870, 0xF7D24BB7, 0x3A23C6AB, 0x593A09A0, 0xF94C9D1D, 0xDFCC2358, 0x297BED02, 0x3CFA0F87},
+        {0x40F26940, 0xCE98A30B, 0x0248A8AF, 0x62121C0D, 0x8309AF9B, 0xA758AA80, 0x70BE12C6, 0xE4E37694},
+    },
+    {
+        {0x86EF7D7D, 0xDD37E3FF, 0x088B86DB, 0xF6D77C27, 0x254C5491, 0x28FE9A4F, 0x6DF0FD5E, 0xD6690337},
+        {0xADDAD596, 0x9FF04992, 0x9E4373F9, 0xF3D1A7AF, 0xDF074167, 0xA13E9578, 0xE6D13D22, 0x20E2A53C},
+    },
+    {
+        {0x525D6ABF, 0xAEBFD735, 0x96BEA25A, 0xC302F8F4, 0x544920A4, 0xDB82B3EA, 0x02EADB2E, 0x621C75D1},
+        {0x9EF485F0, 0x8939DC4C, 0x57C46D63, 0x225D03D8, 0x522D7F70, 0x4FDAC96F, 0xB4FA649D, 0xD7C4A4FE},
+    },
+    {
+        {0xC0B9372A, 0x8BC659AA, 0xEDD9583F, 0xF7659958, 0x8C267D88, 0x9F05F94A, 0xC99A739D, 0x00DC46E7},
+        {0xDF55D0F2, 0x4AF50A00, 0x8156BF6A, 0xB5EB202D, 0x5228C111, 0x40D1E3AB, 0x45793424, 0x0312A557},
+    },
+    {
+        {0x7EB8CFEE, 0x8D9692F7, 0x0D8C013D, 0x05E3F223, 0x84E32E59, 0x76347A52, 0x15B0A1E5, 0x3C53E290},
+        {0xFAE798D4, 0x538B7DA5, 0x00D23591, 0x1B9F1BD1, 0x9A08693F, 0x11A9F072, 0x140EFEB3, 0xD30E7CDA},
+    },
+    {
+        {0xF8E8F683, 0x6DFCF787, 0x3F7FBE90, 0x13D72B7A, 0x2DF232CF, 0xFD426D94, 0x5FE39AAD, 0xED84BB42},
+        {0x732995FC, 0x023E67A1, 0x355430E3, 0x67DD0A8E, 0x97A1D703, 0x0CF83B61, 0x583C33F2, 0xA3233455},
+    },
+    {
+        {0x5F165D99, 0xCEBBBC7B, 0x8A4EEE61, 0x50CC51C1, 0x1B4D0D1F, 0xB31D2353, 0x66382ADA, 0x95E18452},
+        {0x0A839B5B, 0xACAD4F81, 0x4142FF0F, 0xA0A2A96E, 0x1F4FA12F, 0x3EAA8289, 0x6B0FB8F3, 0x68D68C8F},
+    },
+    {
+        {0x51BBB3F1, 0x9311A269, 0x8D0F4F65, 0xE80F26BD, 0x6BECCBB9, 0x9D3DC334, 0x101E5DE4, 0x54E244D5},
+        {0xF1B19E28, 0xB3AD4C6E, 0x58C2E3B7, 0x4334FBC0, 0x35DF9C25, 0x19BD4107, 0xEC106EB6, 0xD6BBEC0E},
+    },
+    {
+        {0x3FEFCFC8, 0xE8881A83, 0xB9B5290B, 0xAEA3C9E0, 0x771E4688, 0x10B37ECD, 0xD4D021B6, 0xEE0816A3},
+        {0xB3A8CAA1, 0x8E9929BF, 0xC105F2D1, 0x48915DCF, 0xDB49019F, 0x3A5FDF82, 0xAD9006E1, 0xC4A438E3},
+    },
+    {
+        {0xE83AD2C9, 0x5D6DC503, 0xAED035BE, 0xCA9F7A1D, 0xCBD21E33, 0x552788AC, 0xE09CB9F0, 0x8699DD31},
+        {0x329BF961, 0x38584196, 0xB82A5AF9, 0x4CB20E96, 0xC72C78C1, 0x24199908, 0xE92859B7, 0x16E65484},
+    },
+    {
+        {0xDB3038DD, 0xA20A2C70, 0xE99D5C7C, 0x5F0B46D5, 0x4B600B83, 0xC9B97D37, 0x3DF3245E, 0x186C7F79},
+        {0x4F1CE57F, 0x2AF72460, 0x91E2D8ED, 0x9249897F, 0x8D2EA797, 0x8139B36A, 0x9AB58913, 0x9C428DB8},
+    },
+    {
+        {0x4BE6458D, 0x1F1E4F3F, 0x595E6547, 0x5F72CC22, 0x271A93F1, 0x5BC5341E, 0x58A5F263, 0xC62E155C},
+        {0x58BA7FF4, 0x5F6F845A, 0x7E36A6AD, 0x67E1F7DC, 0xEEAA4D04, 0xD33A7657, 0x18267E4E, 0xFF9F2322},
+    },
+    {
+        {0xC7644C1D, 0xE33F0255, 0xBB9002D8, 0x4030ECC3, 0xF4646F9F, 0xA4486916, 0x959C44FA, 0x5E677D0C},
+        {0xD88B9144, 0xE2E7D7D0, 0x6248F91F, 0x5D93A86F, 0x02993AEA, 0xE33D0BD5, 0x3100D31E, 0x449F0CE6},
+    },
+    {
+        {0xFDAAB256, 0x52DF1588, 0x3127354C, 0x68C0CD44, 0xA591F853, 0x2A849471, 0x93D0CB92, 0xE4DA88E9},
+        {0x1639C624, 0x6D1EA35D, 0x263707BA, 0x60FE2A36, 0xD0F3BC51, 0x97FC50DE, 0x10062E80, 0xF7FA4D15},
+    },
+    {
+        {0x5B696527, 0x2E75A266, 0x5A00169C, 0x1A2530B0, 0x4286FB42, 0x76C4C180, 0x8E831D5B, 0x825F0194},
+        {0xEF703739, 0xDBF0A11F, 0xCE5B106A, 0x106F9BC4, 0x24111150, 0x61794C4F, 0xBC723A17, 0x435872FE},
+    },
+};
+
+#elif NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH == 6
+
+static const p256_affine_t m_comb_table[32] =
+{
+    {
+        {0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2},
+        {0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2},
+    },
+    {
+        {0x5A1C3FB1, 0x59DB167C, 0xBF318EB2, 0x98B3CE2A, 0xD2BC2FA6, 0x2DF1C41E, 0x6ED1B2AF, 0xEFCC2C43},
+        {0x97B25513, 0x17FE07F1, 0x3734A589, 0x46824533, 0xED34F543, 0xA5384A77, 0x8D9F3863, 0xF3684F9C},
+    },
+    {
+        {0x7318188E, 0xAEC90264, 0xCA167099, 0x410BEC28, 0x099C202B, 0xBF664D2F, 0x55FA625C, 0x13CCCA34},
+        {0x05421C0C, 0xAA84C231, 0x6CDB0D71, 0x6B647521, 0xFB216A5E, 0xE90446B1, 0xAF46893D, 0x4B5BA5A5},
+    },
+    {
+        {0xCBDB1C78, 0xD3B22809, 0x30F6CDA4, 0x5591C8EB, 0xBFE80F8B, 0xB6E28740, 0x40E7E7E7, 0x0F74342A},
+        {0x351C51F2, 0xD2968E87, 0xF5E17B5E, 0x65C5C581, 0x9D994E2E, 0x6F58F02A, 0xF5C1EC07, 0x531C0B00},
+    },
+    {
+        {0x8B21AA51, 0x2B52C47D, 0x5A7E870D, 0x0F503629, 0x88B45127, 0xBAA92814, 0xC402E050, 0x27D6451E},
+        {0x5567432D, 0x5C96EC14, 0x0F4150C7, 0xCDEB9829, 0xCDEEF566, 0x5D91740C, 0x1BE9E583, 0x2A58FA5E},
+    },
+    {
+        {0x2195A979, 0x73B7C550, 0xB8DD5813, 0x2D7ED474, 0xE104E9AC, 0xC0B9ECD2, 0xA2BD0ED8, 0xDC90D975},
+        {0x4DD6EB2E, 0x9FB55203, 0xC01DFDE8, 0x50D554BB, 0xF0977A30, 0x4CFD3277, 0x815374C4, 0xC87CE232},
+    },
+    {
+        {0x1703406D, 0xCB4DC35B, 0x75DAC54C, 0x4FD3AFC9, 0x29F02878, 0x112321EB, 0xAD6B225F, 0xAFB18D2F},
+        {0xF1776A67, 0xDDF58273, 0xF6B96C2F, 0x96889755, 0x22208FFB, 0x31A8D663, 0xFCCA4877, 0x5ED81C10},
+    },
+    {
+        {0x336AAF40, 0x2DC61E1B, 0x4251F5B7, 0x897E87BD, 0x6511B370, 0x2FB32023, 0x2341F499, 0x460FA9CF},
+        {0xCBAF01A7, 0x03E63B79, 0x44157434, 0x937E123F, 0x809E4A1A, 0x9D59226E, 0x41775E62, 0x18D6F63A},
+    },
+    {
+        {0x016476EA, 0xC6E4B6D0, 0xD4EC2510, 0x71B9A7E5, 0xCBE490D2, 0x1975B71E, 0xB52ACD25, 0xDF6B472F},
+        {0x784055EB, 0xF1738716, 0xB87D399E, 0xCCC7B0B3, 0x1BB51119, 0x3C9A1337, 0xA88FD593, 0xB42639E1},
+    },
+    {
+        {0x20B4D697, 0x41E94206, 0x29FA0DF9, 0xA10FD0D9, 0x76022C38, 0xF11EB0A7, 0xA5621C63, 0xFFCB7DDC},
+        {0x0927965A, 0x24E37B1B, 0xBD2C199E, 0x8D9FC102, 0x907F3F85, 0x862DE75E, 0x5A9C778E, 0xD3985129},
+    },
+    {
+        {0xF119B8CC, 0x546A08E7, 0x8AFC696A, 0x03B7D523, 0x459F70B4, 0x0A896132, 0xA86A9116, 0x57A46257},
+        {0xBB314C65, 0xFAA56FEF, 0x74795C6D, 0xF4E61F40, 0x437850D6, 0x1A3C5652, 0x6621EC11, 0x7C4B127D},
+    },
+    {
+        {0x56C8815E, 0xF41E0307, 0x7D37A2F1, 0xBAF647E3, 0xFEFAFBF5, 0x7791EB36, 0x35B7F606, 0x158262FB},
+        {0x32DCE9E5, 0xF6C32255, 0x361B4780, 0x6C7CD4CE, 0x3F85288F, 0xE5BE5E70, 0xC98E624A, 0x4C281AA3},
+    },
+    {
+        {0x4D6A3DEF, 0x5B2911DD, 0xB96008F1, 0x4BEDD07C, 0xE36E7D64, 0xEE748A6F, 0x4BBF5CF4, 0xBFC49934},
+        {0x8E74750F, 0x55C6F62D, 0x48919902, 0x22639F87, 0x958A248F, 0xFA01AA94, 0xED51AA40, 0x2743AE8A},
+    },
+    {
+        {0x86EB7815, 0x9CDDA821, 0xCE413265, 0x8C003612, 0x91B577F5, 0x8BCE1FAB, 0x488F730C, 0x0F3F29FF},
+        {0xE6960D55, 0xEBB08063, 0xAECBF467, 0x1A9699E2, 0x4CE5761B, 0x6B1564A4, 0x81382996, 0x08F00EA5},
+    },
+    {
+        {0x70514A21, 0x0D17FF39, 0xDADD80EE, 0xD2A7B5BA, 0x8126C8C4, 0x941E33C3, 0x1D57C1DE, 0xB9E156D0},
+        {0xEA8105AD, 0x220D500D, 0x0202F3AE, 0x6A2AA462, 0x3DC96356, 0x450056AB, 0x452142C3, 0x506AB6AA},
+    },
+    {
+        {0xC05131CD, 0xF197735B, 0x22BEB567, 0x05650768, 0xF7F55B1F, 0xDBF2B189, 0x132C2614, 0xAA144C82},
+        {0xB3822251, 0xF41CBE14, 0xFFD0AFBE, 0xB1CE72B2, 0x844743FA, 0x01A14D18, 0x923739B8, 0xC1D89FE3},
+    },
+    {
+        {0x5F3F5B80, 0x12416A5C, 0xDA522422, 0x58E903DB, 0x4291867E, 0x18CC80F1, 0x7A152C2B, 0xB2035CF8},
+        {0x95C80EDE, 0x71125691, 0xAF97C5B0, 0xBFE02568, 0x8A14E493, 0x603E1DC5, 0x749680DE, 0xF12F359C},
+    },
+    {
+        {0xFEA77B0C, 0x40429D1B, 0x595E9A31, 0x4651A4DC, 0xE712693A, 0x8900AAB1, 0x84BF612D, 0x90EA7767},
+        {0x0D02F2B6, 0xBDD10425, 0xFB4D594F, 0xF5583BCC, 0x5BA7B6A1, 0x75754462, 0x101E86F4, 0xD1A321D3},
+    },
+    {
+        {0xE62DA069, 0x6890B26C, 0x7C586265, 0xA5702319, 0x865672AB, 0xE64E19BF, 0xA07D9893, 0xA66503F5},
+        {0x21FE4743, 0xE4DEB7C0, 0x7D7100BE, 0x3BAE847D, 0xE17B1D29, 0x1769FCA7, 0x320AFC60, 0xADBA60EC},
+    },
+    {
+        {0xC4E48158, 0xA3C9D614, 0xAE8FC508, 0xB26B4A98, 0x38B68E18, 0x44EF8BE0, 0xDB271FCD, 0xBE9CF596},
+        {0x8E6F95AD, 0x737B653E, 0x9B9E4D0A, 0x73DBE6FF, 0xA4139F59, 0x4B772A8C, 0x66C67E8A, 0xA1F335E5},
+    },
+    {
+        {0xF77CF152, 0xC0B161FB, 0x8CE30043, 0x243C4FED, 0x050E20DF, 0xB1B4A2D0, 0xC34999AE, 0x5A61A286},
+        {0x70214EB7, 0x8C7BAF68, 0xF2C261FE, 0x975BCA7D, 0x1ED91AE8, 0x03C6DF31, 0xA1380D38, 0xE8CFAAAD},
+    },
+    {
+        {0x966D28DD, 0xC79E3178, 0x89F8A2C1, 0x67BA8686, 0x4ACF8D42, 0xAF1F9C6D, 0xE0847F7D, 0x2D2B4273},
+        {0x69130CEC, 0x1D9E1A90, 0x9383E7B5, 0x95CB10FD, 0x44CC71AE, 0x73438A26, 0x1EE4EA49, 0x37EAEB10},
+    },
+    {
+        {0xD84A37DE, 0x1C12B5CB, 0xC7B1EA1A, 0x56D66DB4, 0x2CE31E9A, 0x852BE420, 0xE40FAF48, 0x17BE9C2D},
+        {0x38CC8797, 0x735B3CCB, 0x34B1093E, 0x1F8D9D80, 0xE75B81C0, 0xD8CC6E86, 0x3FDBE697, 0x6914BF94},
+    },
+    {
+        {0x00B16F35, 0x54B44D33, 0x002D5707, 0x59988EF3, 0xD0494F94, 0x256FE1EB, 0x7F710DE4, 0xAEF84169},
+        {0x8BD49604, 0xCA38FB1F, 0xBFA0B15C, 0xAEC9DAAE, 0x642CF6DD, 0x1551365E, 0x160E8FFF, 0x75B8B0FA},
+    },
+    {
+        {0xEDAB9CB9, 0x6033D113, 0xE69D45EE, 0x1DF87BA3, 0xE4D65A03, 0x93436236, 0x3F98A508, 0x5893F6F9},
+        {0xAAD54FAB, 0xB3832E15, 0x6BC7365E, 0x3277FF0D, 0x200C4FB8, 0xE8301118, 0xD4E9384D, 0x26E471BC},
+    },
+    {
+        {0xC52427D8, 0x3276C5A4, 0xF5A34B64, 0x66958243, 0xF36E0D92, 0x04166798, 0xC6E9E63F, 0x43E33927},
+        {0xF0CA8D2B, 0x899AED76, 0x0AF50DD8, 0x43B89CDE, 0x5951E13B, 0x805EA21E, 0x28413043, 0xE210DAA4},
+    },
+    {
+        {0x0758035B, 0xCE46A165, 0xE070A0C9, 0xB33DF1AD, 0x686934C9, 0xBF01FB38, 0xF0F16ED0, 0x1CBA6257},
+        {0xEE93409C, 0xE538A9B6, 0x4A6B38DA, 0xD82429A1, 0xA5C215B1, 0x1488770D, 0x891D7658, 0x4ADE1F8E},
+    },
+    {
+        {0x27ADE63F, 0xFE702B4B, 0xA105673A, 0x5DF11A33, 0xA362B9CE, 0x0D33CB80, 0x855BB209, 0xA7BB42F5},
+        {0xC95FE575, 0xFDCC6096, 0x2351DEC6, 0xFF0E08D7, 0xBB6A5B28, 0xA3323FF5, 0x89F7A2AB, 0x2CAA2DAE},
+    },
+    {
+        {0x2DA7EB49, 0x2096D676, 0xFB775E41, 0x6E04768E, 0xAF24F76C, 0xC3349C3D, 0xDE0C90F6, 0xE6DB6CCA},
+        {0xA416FD87, 0x98AA01F5, 0x781EC427, 0x84C3270B, 0x021034B2, 0x37680F04, 0x654BF735, 0xEB90FE3C},
+    },
+    {
+        {0xB3571976, 0x8E35BF16, 0x346864E7, 0xE2EB0C63, 0x7E9B6C7F, 0x2B7B57E0, 0x70B35A98, 0x3157CF6F},
+        {0x5AC49EA5, 0xFEC24C14, 0x6B1A32AE, 0xC20C5690, 0x345FA335, 0xEAEF7B4E, 0x4077475F, 0xB4C9655D},
+    },
+    {
+        {0xFCF866B9, 0xF3F4E3FE, 0xE18B0AD5, 0x152A0807, 0x1B9B2E7B, 0x2EC4C706, 0xDADD006F, 0x41D7E92B},
+        {0x1D4B6EF7, 0xFF0A8A79, 0xB2AA2F47, 0x02344DFF, 0x357A0681, 0x1726D704, 0xC1BC85F4, 0x4CE6BB77},
+    },
+    {
+        {0xAFCC2BEF, 0xB9E437F4, 0x3ADA2B53, 0x4F1FB2D6, 0xBB580C9A, 0xE6C0E12D, 0x33C7546D, 0x25183734},
+        {0xBFD92FB9, 0xAB12D90F, 0xA185AE46, 0x2CB9B9B3, 0x9CE6F49F, 0x2A0C7A7E, 0xB48F21F2, 0x531F307F},
+    },
+};
+
+#else
+#error "Unsupported NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH value."
+#endif
+
+/**@brief Function for adding two numbers.
+ *
+ * @return Carry out of the most significant word.
+ */
+static uint32_t vli_add(uint32_t * p_r, uint32_t const * p_a, uint32_t const * p_b)
+{
+    uint64_t acc = 0;
+
+    for (uint32_t i = 0; i < P256_WORDS; i++)
+    {
+        acc   += (uint64_t)p_a[i] + p_b[i];
+        p_r[i] = (uint32_t)acc;
+        acc  >>= 32;
+    }
+    return (uint32_t)acc;
+}
+
+/**@brief Function for subtracting two numbers.
+ *
+ * @return Borrow out of the most significant word (0 or 1).
+ */
+static uint32_t vli_sub(uint32_t * p_r, uint32_t const * p_a, uint32_t const * p_b)
+{
+    int64_t acc = 0;
+
+    for (uint32_t i = 0; i < P256_WORDS; i++)
+    {
+        acc   += (int64_t)p_a[i] - p_b[i];
+        p_r[i] = (uint32_t)acc;
+        acc  >>= 32;
+    }
+    return (uint32_t)(-acc);
+}
+
+/**@brief Function for copying @p p_a to @p p_r if @p mask is all ones. @p mask must be 0 or all ones. */
+static void vli_cmov(uint32_t * p_r, uint32_t const * p_a, uint32_t mask)
+{
+    for (uint32_t i = 0; i < P256_WORDS; i++)
+    {
+        p_r[i] ^= (p_r[i] ^ p_a[i]) & mask;
+    }
+}
+
+/**@brief Function for checking if a number is zero.
+ *
+ * @return All ones if the number is zero, 0 otherwise.
+ */
+static uint32_t vli_zero_mask(uint32_t const * p_a)
+{
+    uint32_t bits = 0;
+
+    for (uint32_t i = 0; i < P256_WORDS; i++)
+    {
+        bits |= p_a[i];
+    }
+    return (uint32_t)(((uint64_t)bits - 1) >> 32);
+}
+
+static void fe_add(uint32_t * p_r, uint32_t const * p_a, uint32_t const * p_b)
+{
+    p256_fe_t t;
+    uint32_t  carry  = vli_add(p_r, p_a, p_b);
+    uint32_t  borrow = vli_sub(t, p_r, m_p);
+
+    // Keep a + b - p unless a + b < p.
+    vli_cmov(p_r, t, (uint32_t)0 - (carry | (borrow ^ 1)));
+}
+
+static void fe_sub(uint32_t * p_r, uint32_t const * p_a, uint32_t const * p_b)
+{
+    p256_fe_t t;
+    uint32_t  borrow = vli_sub(p_r, p_a, p_b);
+
+    (void)vli_add(t, p_r, m_p);
+    vli_cmov(p_r, t, (uint32_t)0 - borrow);
+}
+
+/**@brief Function for reducing a 512-bit product modulo p.
+ *
+ * @details Fast reduction for the NIST prime (FIPS 186-4, D.2.3): r = s1 + 2 s2 + 2 s3 + s4 + s5
+ *          - s6 - s7 - s8 - s9. The carry out of the 256-bit sum is then folded back twice with
+ *          2^256 = 2^224 - 2^192 - 2^96 + 1 (mod p), which leaves a value below 2^256, and p is
+ *          subtracted if needed.
+ */
+static void fe_reduce(uint32_t * p_r, uint32_t const * c)
+{
+    int64_t acc[P256_WORDS];
+    int64_t carry;
+
+    acc[0] = (int64_t)c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+    acc[1] = (int64_t)c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+    acc[2] = (int64_t)c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+    acc[3] = (int64_t)c[3] + 2 * ((int64_t)c[11] + c[12]) + c[13] - c[15] - c[8] - c[9];
+    acc[4] = (int64_t)c[4] + 2 * ((int64_t)c[12] + c[13]) + c[14] - c[9] - c[10];
+    acc[5] = (int64_t)c[5] + 2 * ((int64_t)c[13] + c[14]) + c[15] - c[10] - c[11];
+    acc[6] = (int64_t)c[6] + 3 * (int64_t)c[14] + 2 * (int64_t)c[15] + c[13] - c[8] - c[9];
+    acc[7] = (int64_t)c[7] + 3 * (int64_t)c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+
+    for (uint32_t fold = 0; fold < 3; fold++)
+    {
+        carry = 0;
+        for (uint32_t i = 0; i < P256_WORDS; i++)
+        {
+            carry  += acc[i];
+            p_r[i]  = (uint32_t)carry;
+            carry >>= 32;
+            acc[i]  = p_r[i];
+        }
+        if (fold == 2)
+        {
+            break;
+        }
+        acc[0] += carry;
+        acc[3] -= carry;
+        acc[6] -= carry;
+        acc[7] += carry;
+    }
+
+    p256_fe_t t;
+    uint32_t  borrow = vli_sub(t, p_r, m_p);
+    vli_cmov(p_r, t, borrow - 1);
+}
+
+static void fe_mul(uint32_t * p_r, uint32_t const * p_a, uint32_t const * p_b)
+{
+    uint32_t product[2 * P256_WORDS];
+    uint64_t lo  = 0;
+    uint32_t hi  = 0;
+
+    // Column-wise (product scanning) multiplication with a 96-bit accumulator.
+    for (uint32_t k = 0; k < 2 * P256_WORDS - 1; k++)
+    {
+        uint32_t i_min = (k < P256_WORDS) ? 0 : (k - P256_WORDS + 1);
+        uint32_t i_max = (k < P256_WORDS) ? k : (P256_WORDS - 1);
+
+        for (uint32_t i = i_min; i <= i_max; i++)
+        {
+            uint64_t p   = (uint64_t)p_a[i] * p_b[k - i];
+            uint64_t sum = lo + p;
+
+            hi += (sum < p);
+            lo  = sum;
+        }
+        product[k] = (uint32_t)lo;
+        lo         = (lo >> 32) | ((uint64_t)hi << 32);
+        hi         = 0;
+    }
+    product[2 * P256_WORDS - 1] = (uint32_t)lo;
+
+    fe_reduce(p_r, product);
+}
+
+static void fe_sqr(uint32_t * p_r, uint32_t const * p_a)
+{
+    fe_mul(p_r, p_a, p_a);
+}
+
+/**@brief Function for squaring @p count times. */
+static void fe_sqr_n(uint32_t * p_r, uint32_t const * p_a, uint32_t count)
+{
+    fe_sqr(p_r, p_a);
+    while (--count > 0)
+    {
+        fe_sqr(p_r, p_r);
+    }
+}
+
+/**@brief Function for computing 1 / a = a^(p - 2) with a fixed addition chain. */
+static void fe_inv(uint32_t * p_r, uint32_t const * p_a)
+{
+    p256_fe_t x2;
+    p256_fe_t x3;
+    p256_fe_t x6;
+    p256_fe_t x12;
+    p256_fe_t x15;
+    p256_fe_t x30;
+    p256_fe_t x32;
+    p256_fe_t t;
+
+    // xN = a^(2^N - 1)
+    fe_sqr(t, p_a);
+    fe_mul(x2, t, p_a);
+    fe_sqr(t, x2);
+    fe_mul(x3, t, p_a);
+    fe_sqr_n(t, x3, 3);
+    fe_mul(x6, t, x3);
+    fe_sqr_n(t, x6, 6);
+    fe_mul(x12, t, x6);
+    fe_sqr_n(t, x12, 3);
+    fe_mul(x15, t, x3);
+    fe_sqr_n(t, x15, 15);
+    fe_mul(x30, t, x15);
+    fe_sqr_n(t, x30, 2);
+    fe_mul(x32, t, x2);
+
+    // p - 2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd
+    fe_sqr_n(t, x32, 32);
+    fe_mul(t, t, p_a);
+    fe_sqr_n(t, t, 128);
+    fe_mul(t, t, x32);
+    fe_sqr_n(t, t, 32);
+    fe_mul(t, t, x32);
+    fe_sqr_n(t, t, 30);
+    fe_mul(t, t, x30);
+    fe_sqr_n(t, t, 2);
+    fe_mul(p_r, t, p_a);
+}
+
+/**@brief Function for doubling a point (dbl-2001-b, a = -3). */
+static void point_double(p256_jacobian_t * p_r)
+{
+    p256_fe_t delta;
+    p256_fe_t gamma;
+    p256_fe_t beta;
+    p256_fe_t alpha;
+    p256_fe_t t;
+
+    fe_sqr(delta, p_r->z);
+    fe_sqr(gamma, p_r->y);
+    fe_mul(beta, p_r->x, gamma);
+
+    fe_sub(t, p_r->x, delta);
+    fe_add(alpha, p_r->x, delta);
+    fe_mul(alpha, alpha, t);
+    fe_add(t, alpha, alpha);
+    fe_add(alpha, alpha, t);                // alpha = 3 (X - delta)(X + delta)
+
+    fe_add(t, p_r->y, p_r->z);
+    fe_sqr(t, t);
+    fe_sub(t, t, gamma);
+    fe_sub(p_r->z, t, delta);               // Z3 = (Y + Z)^2 - gamma - delta
+
+    fe_add(beta, beta, beta);
+    fe_add(beta, beta, beta);               // beta = 4 beta
+    fe_sqr(p_r->x, alpha);
+    fe_add(t, beta, beta);
+    fe_sub(p_r->x, p_r->x, t);              // X3 = alpha^2 - 8 beta
+
+    fe_sub(t, beta, p_r->x);
+    fe_mul(t, alpha, t);
+    fe_sqr(gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_sub(p_r->y, t, gamma);               // Y3 = alpha (4 beta - X3) - 8 gamma^2
+}
+
+/**@brief Function for adding an affine point to a point (madd-2007-bl).
+ *
+ * @details The special cases (R is the point at infinity, R = Q or R = -Q) are handled by
+ *          branches. For the comb, they only happen for a negligible fraction of the keys.
+ */
+static void point_add_mixed(p256_jacobian_t * p_r, p256_affine_t const * p_q)
+{
+    p256_fe_t z1z1;
+    p256_fe_t u2;
+    p256_fe_t s2;
+    p256_fe_t h;
+    p256_fe_t hh;
+    p256_fe_t i;
+    p256_fe_t j;
+    p256_fe_t r;
+    p256_fe_t v;
+
+    if (vli_zero_mask(p_r->z))
+    {
+        memcpy(p_r->x, p_q->x, sizeof(p256_fe_t));
+        memcpy(p_r->y, p_q->y, sizeof(p256_fe_t));
+        memset(p_r->z, 0, sizeof(p256_fe_t));
+        p_r->z[0] = 1;
+        return;
+    }
+
+    fe_sqr(z1z1, p_r->z);
+    fe_mul(u2, p_q->x, z1z1);
+    fe_mul(s2, p_q->y, p_r->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, p_r->x);
+    fe_sub(r, s2, p_r->y);
+
+    if (vli_zero_mask(h))
+    {
+        if (vli_zero_mask(r))
+        {
+            point_double(p_r);
+        }
+        else
+        {
+            memset(p_r->z, 0, sizeof(p256_fe_t));
+        }
+        return;
+    }
+
+    fe_add(r, r, r);                        // r = 2 (S2 - Y1)
+    fe_sqr(hh, h);
+    fe_add(i, hh, hh);
+    fe_add(i, i, i);                        // I = 4 HH
+    fe_mul(j, h, i);
+    fe_mul(v, p_r->x, i);
+
+    fe_add(p_r->z, p_r->z, h);
+    fe_sqr(p_r->z, p_r->z);
+    fe_sub(p_r->z, p_r->z, z1z1);
+    fe_sub(p_r->z, p_r->z, hh);             // Z3 = (Z1 + H)^2 - Z1Z1 - HH
+
+    fe_sqr(p_r->x, r);
+    fe_sub(p_r->x, p_r->x, j);
+    fe_sub(p_r->x, p_r->x, v);
+    fe_sub(p_r->x, p_r->x, v);              // X3 = r^2 - J - 2 V
+
+    fe_mul(j, p_r->y, j);
+    fe_add(j, j, j);
+    fe_sub(v, v, p_r->x);
+    fe_mul(p_r->y, r, v);
+    fe_sub(p_r->y, p_r->y, j);              // Y3 = r (V - X3) - 2 Y1 J
+}
+
+/**@brief Function for reading a comb table entry without leaking the index.
+ *
+ * @param[out] p_r      Selected point.
+ * @param[in]  digit    Odd comb digit. Bit 7 is the sign, bits 1 to 6 are the table index.
+ */
+static void comb_select(p256_affine_t * p_r, uint8_t digit)
+{
+    uint32_t  index = (digit & 0x7F) >> 1;
+    p256_fe_t neg_y;
+
+    memset(p_r, 0, sizeof(p256_affine_t));
+    for (uint32_t k = 0; k < ARRAY_SIZE(m_comb_table); k++)
+    {
+        uint32_t mask = (uint32_t)(((uint64_t)(k ^ index) - 1) >> 32);
+
+        for (uint32_t w = 0; w < P256_WORDS; w++)
+        {
+            p_r->x[w] |= m_comb_table[k].x[w] & mask;
+            p_r->y[w] |= m_comb_table[k].y[w] & mask;
+        }
+    }
+
+    (void)vli_sub(neg_y, m_p, p_r->y);
+    vli_cmov(p_r->y, neg_y, (uint32_t)0 - (digit >> 7));
+}
+
+/**@brief Function for recoding an odd scalar into odd signed comb digits (see mbed TLS
+ *        ecp_comb_recode_core()).
+ */
+static void comb_recode(uint8_t * p_x, uint32_t const * p_m)
+{
+    uint8_t c = 0;
+
+    for (uint32_t i = 0; i < P256_COMB_D; i++)
+    {
+        p_x[i] = 0;
+        for (uint32_t j = 0; j < P256_COMB_W; j++)
+        {
+            uint32_t bit = i + P256_COMB_D * j;
+
+            if (bit < 256)
+            {
+                p_x[i] |= (uint8_t)(((p_m[bit / 32] >> (bit % 32)) & 1) << j);
+            }
+        }
+    }
+    p_x[P256_COMB_D] = 0;
+
+    for (uint32_t i = 1; i <= P256_COMB_D; i++)
+    {
+        uint8_t cc;
+        uint8_t adjust;
+
+        cc      = p_x[i] & c;
+        p_x[i] ^= c;
+        c       = cc;
+
+        adjust      = 1 - (p_x[i] & 0x01);
+        c          |= p_x[i] & (p_x[i - 1] * adjust);
+        p_x[i]     ^= p_x[i - 1] * adjust;
+        p_x[i - 1] |= adjust << 7;
+    }
+}
+
+/**@brief Function for checking that a private key is in the range [1, n - 1]. */
+static bool private_key_valid(uint32_t const * p_key)
+{
+    p256_fe_t t;
+
+    return (vli_zero_mask(p_key) == 0) && (vli_sub(t, p_key, m_n) == 1);
+}
+
+/**@brief Function for checking that a point is on the curve: y^2 = x^3 - 3 x + b. */
+static bool point_on_curve(p256_affine_t const * p_q)
+{
+    p256_fe_t lhs;
+    p256_fe_t rhs;
+    p256_fe_t t;
+
+    fe_sqr(lhs, p_q->y);
+    fe_sqr(rhs, p_q->x);
+    fe_mul(rhs, rhs, p_q->x);
+    fe_add(t, p_q->x, p_q->x);
+    fe_add(t, t, p_q->x);
+    fe_sub(rhs, rhs, t);
+    fe_add(rhs, rhs, m_b);
+    (void)vli_sub(t, lhs, rhs);
+
+    return vli_zero_mask(t) != 0;
+}
+
+/**@brief Function for computing a public key.
+ *
+ * @param[out] p_public_key     X followed by Y, 16 words.
+ * @param[in]  p_private_key    Private key in the range [1, n - 1], 8 words.
+ *
+ * @retval NRF_SUCCESS                  Public key computed.
+ * @retval NRF_ERROR_CRYPTO_INTERNAL    Invalid private key, or the computation failed the
+ *                                      on-curve check.
+ */
+static ret_code_t public_key_compute(uint32_t * p_public_key, uint32_t const * p_private_key)
+{
+    p256_fe_t       m;
+    p256_fe_t       z_inv;
+    p256_fe_t       t;
+    uint8_t         digits[P256_COMB_D + 1];
+    p256_jacobian_t r;
+    p256_affine_t   q;
+    uint32_t        even_mask;
+    ret_code_t      result = NRF_SUCCESS;
+
+    if (!private_key_valid(p_private_key))
+    {
+        return NRF_ERROR_CRYPTO_INTERNAL;
+    }
+
+    // The recoding needs an odd scalar. For an even d, use n - d and negate the result.
+    even_mask = (p_private_key[0] & 1) - 1;
+    memcpy(m, p_private_key, sizeof(m));
+    (void)vli_sub(t, m_n, p_private_key);
+    vli_cmov(m, t, even_mask);
+
+    comb_recode(digits, m);
+
+    comb_select(&q, digits[P256_COMB_D]);
+    memcpy(r.x, q.x, sizeof(p256_fe_t));
+    memcpy(r.y, q.y, sizeof(p256_fe_t));
+    memset(r.z, 0, sizeof(p256_fe_t));
+    r.z[0] = 1;
+
+    for (uint32_t i = P256_COMB_D; i-- > 0;)
+    {
+        point_double(&r);
+        comb_select(&q, digits[i]);
+        point_add_mixed(&r, &q);
+    }
+
+    fe_inv(z_inv, r.z);
+    fe_sqr(t, z_inv);
+    fe_mul(q.x, r.x, t);
+    fe_mul(t, t, z_inv);
+    fe_mul(q.y, r.y, t);
+
+    (void)vli_sub(t, m_p, q.y);
+    vli_cmov(q.y, t, even_mask);
+
+    // Guard against faults and arithmetic errors, like micro-ecc does for its results.
+    if (vli_zero_mask(r.z) || !point_on_curve(&q))
+    {
+        result = NRF_ERROR_CRYPTO_INTERNAL;
+    }
+    else
+    {
+        memcpy(&p_public_key[0], q.x, sizeof(p256_fe_t));
+        memcpy(&p_public_key[P256_WORDS], q.y, sizeof(p256_fe_t));
+    }
+
+    memset(m, 0, sizeof(m));
+    memset(digits, 0, sizeof(digits));
+
+    return result;
+}
+
+
+ret_code_t nrf_crypto_backend_micro_ecc_p256_comb_key_pair_generate(
+    void * p_context,
+    void * p_private_key,
+    void * p_public_key)
+{
+    nrf_crypto_backend_secp256r1_private_key_t * p_prv =
+        (nrf_crypto_backend_secp256r1_private_key_t *)p_private_key;
+    nrf_crypto_backend_secp256r1_public_key_t * p_pub =
+        (nrf_crypto_backend_secp256r1_public_key_t *)p_public_key;
+
+    UNUSED_PARAMETER(p_context);
+
+    for (uint32_t tries = 0; tries < P256_KEYGEN_TRIES; tries++)
+    {
+        if (nrf_crypto_backend_micro_ecc_rng_callback((uint8_t *)p_prv->key,
+                                                      sizeof(p_prv->key)) == 0)
+        {
+            return NRF_ERROR_CRYPTO_INTERNAL;
+        }
+
+        if (private_key_valid(p_prv->key))
+        {
+            return public_key_compute(p_pub->key, p_prv->key);
+        }
+    }
+
+    return NRF_ERROR_CRYPTO_INTERNAL;
+}
+
+
+ret_code_t nrf_crypto_backend_micro_ecc_p256_comb_public_key_calculate(
+    void       * p_context,
+    void const * p_private_key,
+    void       * p_public_key)
+{
+    nrf_crypto_backend_secp256r1_private_key_t const * p_prv =
+        (nrf_crypto_backend_secp256r1_private_key_t const *)p_private_key;
+    nrf_crypto_backend_secp256r1_public_key_t * p_pub =
+        (nrf_crypto_backend_secp256r1_public_key_t *)p_public_key;
+
+    UNUSED_PARAMETER(p_context);
+
+    return public_key_compute(p_pub->key, p_prv->key);
+}
+
+
+#endif // NRF_MODULE_ENABLED(NRF_CRYPTO) && NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MICRO_ECC) ...
@@ -154,6 +154,172 @@ ret_code_t nrf_crypto_aead_crypt(nrf_crypto_aead_context_t * const p_context,
     return ret_val;
 }
 
+ret_code_t nrf_crypto_aead_batch_crypt(nrf_crypto_aead_context_t * const p_context,
+                                       nrf_crypto_operation_t            operation,
+                                       nrf_crypto_aead_record_t const *  p_records,
+                                       size_t                            record_count,
+                                       size_t *                          p_processed)
+{
+    ret_code_t ret_val;
+    size_t     i;
+
+    nrf_crypto_aead_internal_context_t * p_int_context =
+        (nrf_crypto_aead_internal_context_t *)p_context;
+
+    if (p_processed != NULL)
+    {
+        *p_processed = 0;
+    }
+
+    ret_val = context_verify(p_int_context);
+    VERIFY_SUCCESS(ret_val);
+
+    VERIFY_FALSE(((p_records == NULL) && (record_count != 0)),
+                 NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    for (i = 0; i < record_count; i++)
+    {
+        nrf_crypto_aead_record_t const * p_record = &p_records[i];
+
+        VERIFY_FALSE(((p_record->p_nonce == NULL) && (p_record->nonce_size != 0)),
+                     NRF_ERROR_CRYPTO_INPUT_NULL);
+
+        VERIFY_FALSE(((p_record->p_mac == NULL) && (p_record->mac_size != 0)),
+                     NRF_ERROR_CRYPTO_INPUT_NULL);
+
+        VERIFY_FALSE(((p_record->p_adata == NULL) && (p_record->adata_size != 0)),
+                     NRF_ERROR_CRYPTO_INPUT_NULL);
+
+        VERIFY_FALSE(((p_record->p_data_in == NULL) && (p_record->data_in_size != 0)),
+                     NRF_ERROR_CRYPTO_INPUT_NULL);
+
+        VERIFY_FALSE(((p_record->p_data_out == NULL) && (p_record->data_in_size != 0)),
+                     NRF_ERROR_CRYPTO_OUTPUT_NULL);
+
+        ret_val = p_int_context->p_info->crypt_fn(p_context,
+                                                  operation,
+                                                  p_record->p_nonce,
+                                                  p_record->nonce_size,
+                                                  p_record->p_adata,
+                                                  p_record->adata_size,
+                                                  p_record->p_data_in,
+                                                  p_record->data_in_size,
+                                                  p_record->p_data_out,
+                                                  p_record->p_mac,
+                                                  p_record->mac_size);
+        VERIFY_SUCCESS(ret_val);
+
+        if (p_processed != NULL)
+        {
+            *p_processed = i + 1;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_crypto_aead_stream_start(nrf_crypto_aead_context_t * const p_context,
+                                        nrf_crypto_operation_t            operation,
+                                        uint8_t *                         p_nonce,
+                                        uint8_t                           nonce_size)
+{
+    ret_code_t ret_val;
+
+    nrf_crypto_aead_internal_context_t * p_int_context =
+        (nrf_crypto_aead_internal_context_t *)p_context;
+
+    ret_val = context_verify(p_int_context);
+    VERIFY_SUCCESS(ret_val);
+
+    VERIFY_TRUE((p_int_context->p_info->stream_start_fn != NULL),
+                NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE);
+
+    VERIFY_FALSE(((p_nonce == NULL) && (nonce_size != 0)),
+                 NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    VERIFY_TRUE(((operation == NRF_CRYPTO_ENCRYPT) || (operation == NRF_CRYPTO_DECRYPT)),
+                NRF_ERROR_CRYPTO_INVALID_PARAM);
+
+    ret_val = p_int_context->p_info->stream_start_fn(p_context, operation, p_nonce, nonce_size);
+
+    return ret_val;
+}
+
+ret_code_t nrf_crypto_aead_stream_adata_update(nrf_crypto_aead_context_t * const p_context,
+                                               uint8_t *                         p_adata,
+                                               size_t                            adata_size)
+{
+    ret_code_t ret_val;
+
+    nrf_crypto_aead_internal_context_t * p_int_context =
+        (nrf_crypto_aead_internal_context_t *)p_context;
+
+    ret_val = context_verify(p_int_context);
+    VERIFY_SUCCESS(ret_val);
+
+    VERIFY_TRUE((p_int_context->p_info->stream_adata_fn != NULL),
+                NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE);
+
+    VERIFY_FALSE(((p_adata == NULL) && (adata_size != 0)),
+                 NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    ret_val = p_int_context->p_info->stream_adata_fn(p_context, p_adata, adata_size);
+
+    return ret_val;
+}
+
+ret_code_t nrf_crypto_aead_stream_update(nrf_crypto_aead_context_t * const p_context,
+                                         uint8_t *                         p_data_in,
+                                         size_t                            data_in_size,
+                                         uint8_t *                         p_data_out)
+{
+    ret_code_t ret_val;
+
+    nrf_crypto_aead_internal_context_t * p_int_context =
+        (nrf_crypto_aead_internal_context_t *)p_context;
+
+    ret_val = context_verify(p_int_context);
+    VERIFY_SUCCESS(ret_val);
+
+    VERIFY_TRUE((p_int_context->p_info->stream_update_fn != NULL),
+                NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE);
+
+    VERIFY_FALSE(((p_data_in == NULL) && (data_in_size != 0)),
+                 NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    VERIFY_FALSE(((p_data_out == NULL) && (data_in_size != 0)),
+                 NRF_ERROR_CRYPTO_OUTPUT_NULL);
+
+    ret_val = p_int_context->p_info->stream_update_fn(p_context,
+                                                      p_data_in,
+                                                      data_in_size,
+                                                      p_data_out);
+    return ret_val;
+}
+
+ret_code_t nrf_crypto_aead_stream_finalize(nrf_crypto_aead_context_t * const p_context,
+                                           uint8_t *                         p_mac,
+                                           uint8_t                           mac_size)
+{
+    ret_code_t ret_val;
+
+    nrf_crypto_aead_internal_context_t * p_int_context =
+        (nrf_crypto_aead_internal_context_t *)p_context;
+
+    ret_val = context_verify(p_int_context);
+    VERIFY_SUCCESS(ret_val);
+
+    VERIFY_TRUE((p_int_context->p_info->stream_finalize_fn != NULL),
+                NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE);
+
+    VERIFY_FALSE(((p_mac == NULL) && (mac_size != 0)),
+                 NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    ret_val = p_int_context->p_info->stream_finalize_fn(p_context, p_mac, mac_size);
+
+    return ret_val;
+}
+
 #endif // NRF_MODULE_ENABLED(NRF_CRYPTO_AEAD)
 #endif // NRF_MODULE_ENABLED(NRF_CRYPTO)
 
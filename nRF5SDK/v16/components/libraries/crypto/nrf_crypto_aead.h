@@ -150,6 +150,23 @@ extern const nrf_crypto_aead_info_t g_nrf_crypto_chacha_poly_256_info;
  */
 typedef nrf_crypto_backend_aead_context_t nrf_crypto_aead_context_t;
 
+/**@brief Record processed by @ref nrf_crypto_aead_batch_crypt.
+ *
+ * @details The members have the same meaning as the parameters of @ref nrf_crypto_aead_crypt.
+ */
+typedef struct
+{
+    uint8_t * p_nonce;      /**< Pointer to nonce. */
+    uint8_t   nonce_size;   /**< Nonce byte size. */
+    uint8_t * p_adata;      /**< Pointer to additional authenticated data. */
+    size_t    adata_size;   /**< Length of additional authenticated data in bytes. */
+    uint8_t * p_data_in;    /**< Pointer to the input data. */
+    size_t    data_in_size; /**< Length of the input data in bytes. */
+    uint8_t * p_data_out;   /**< Pointer to the output buffer, at least data_in_size bytes wide. */
+    uint8_t * p_mac;        /**< Pointer to the MAC. Written on encryption, read on decryption. */
+    uint8_t   mac_size;     /**< MAC byte size. */
+} nrf_crypto_aead_record_t;
+
 
 /**@brief Function for initializing the AEAD calculation context.
  *
@@ -224,6 +241,99 @@ ret_code_t nrf_crypto_aead_crypt(nrf_crypto_aead_context_t * const p_context,
                                  uint8_t *                         p_mac,
                                  uint8_t                           mac_size);
 
+/**@brief Function for encrypting or decrypting a batch of records under the key of the context.
+ *
+ * @details The key schedule and the other per-key values are computed once by
+ *          @ref nrf_crypto_aead_init, so processing many small records this way only costs
+ *          the per-record work. Records are processed in order. Processing stops at the first
+ *          record that fails, for example on a MAC mismatch during decryption.
+ *
+ * @param[in]     p_context     Context object. Must be initialized before the call.
+ * @param[in]     operation     NRF_CRYPTO_ENCRYPT or NRF_CRYPTO_DECRYPT.
+ * @param[in,out] p_records     Array of records. See @ref nrf_crypto_aead_crypt for the
+ *                              constraints on each member.
+ * @param[in]     record_count  Number of records in p_records.
+ * @param[out]    p_processed   Number of records successfully processed. If the function fails,
+ *                              this is the index of the record that failed. Can be NULL.
+ *
+ * @retval  NRF_SUCCESS  All records were successfully processed.
+ */
+ret_code_t nrf_crypto_aead_batch_crypt(nrf_crypto_aead_context_t * const p_context,
+                                       nrf_crypto_operation_t            operation,
+                                       nrf_crypto_aead_record_t const *  p_records,
+                                       size_t                            record_count,
+                                       size_t *                          p_processed);
+
+/**@brief Function for starting a stream encryption or decryption.
+ *
+ * @details A stream operation processes a message in chunks, so that large payloads do not have
+ *          to be in memory at once. The sequence is @ref nrf_crypto_aead_stream_start, any number
+ *          of @ref nrf_crypto_aead_stream_adata_update, any number of
+ *          @ref nrf_crypto_aead_stream_update and @ref nrf_crypto_aead_stream_finalize.
+ *          Supported modes:
+ *            - EAX (Cifra): chunks can have any length.
+ *            - GCM (mbed TLS): all chunks of additional data and of data, except the last
+ *                              one of each, must be a multiple of 16 bytes.
+ *          CCM needs the message length before the first block and cannot be streamed.
+ *
+ * @note On decryption, the data returned by @ref nrf_crypto_aead_stream_update is not
+ *       authenticated before @ref nrf_crypto_aead_stream_finalize succeeds. It must be
+ *       discarded if that function fails.
+ *
+ * @param[in]  p_context    Context object. Must be initialized before the call.
+ * @param[in]  operation    NRF_CRYPTO_ENCRYPT or NRF_CRYPTO_DECRYPT.
+ * @param[in]  p_nonce      Pointer to nonce.
+ * @param[in]  nonce_size   Nonce byte size. See @ref nrf_crypto_aead_crypt.
+ *
+ * @retval  NRF_SUCCESS                           Stream operation was successfully started.
+ * @retval  NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE  The mode does not support stream operations.
+ */
+ret_code_t nrf_crypto_aead_stream_start(nrf_crypto_aead_context_t * const p_context,
+                                        nrf_crypto_operation_t            operation,
+                                        uint8_t *                         p_nonce,
+                                        uint8_t                           nonce_size);
+
+/**@brief Function for adding additional authenticated data to a stream operation.
+ *
+ * @details Must be called before the first call to @ref nrf_crypto_aead_stream_update.
+ *
+ * @param[in]  p_context    Context object with a started stream operation.
+ * @param[in]  p_adata      Pointer to additional authenticated data.
+ * @param[in]  adata_size   Length of additional authenticated data in bytes.
+ *
+ * @retval  NRF_SUCCESS  Additional data was successfully processed.
+ */
+ret_code_t nrf_crypto_aead_stream_adata_update(nrf_crypto_aead_context_t * const p_context,
+                                               uint8_t *                         p_adata,
+                                               size_t                            adata_size);
+
+/**@brief Function for encrypting or decrypting a chunk of a stream operation.
+ *
+ * @param[in]  p_context        Context object with a started stream operation.
+ * @param[in]  p_data_in        Pointer to the input data.
+ * @param[in]  data_in_size     Length of the input data in bytes.
+ * @param[out] p_data_out       Pointer to the output buffer, at least data_in_size bytes wide.
+ *
+ * @retval  NRF_SUCCESS  Data was successfully processed.
+ */
+ret_code_t nrf_crypto_aead_stream_update(nrf_crypto_aead_context_t * const p_context,
+                                         uint8_t *                         p_data_in,
+                                         size_t                            data_in_size,
+                                         uint8_t *                         p_data_out);
+
+/**@brief Function for finishing a stream operation.
+ *
+ * @param[in]     p_context     Context object with a started stream operation.
+ * @param[in,out] p_mac         Pointer to the MAC. Written on encryption, compared on decryption.
+ * @param[in]     mac_size      MAC byte size. See @ref nrf_crypto_aead_crypt.
+ *
+ * @retval  NRF_SUCCESS                         Stream operation was successfully finished.
+ * @retval  NRF_ERROR_CRYPTO_AEAD_INVALID_MAC   Decrypted data is not authentic.
+ */
+ret_code_t nrf_crypto_aead_stream_finalize(nrf_crypto_aead_context_t * const p_context,
+                                           uint8_t *                         p_mac,
+                                           uint8_t                           mac_size);
+
 #ifdef __cplusplus
 }
 #endif
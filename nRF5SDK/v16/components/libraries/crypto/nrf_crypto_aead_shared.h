@@ -112,6 +112,40 @@ typedef ret_code_t (*aead_crypt_fn_t)(void * const           p_context,
                                       uint8_t *              p_mac,
                                       uint8_t                mac_size);
 
+/**@internal @brief Type declaration to start an AEAD stream operation in nrf_crypto backend.
+ *
+ *  This is internal API. See @ref nrf_crypto_aead_stream_start for documentation.
+ */
+typedef ret_code_t (*aead_stream_start_fn_t)(void * const           p_context,
+                                             nrf_crypto_operation_t operation,
+                                             uint8_t *              p_nonce,
+                                             uint8_t                nonce_size);
+
+/**@internal @brief Type declaration to add AEAD stream additional data in nrf_crypto backend.
+ *
+ *  This is internal API. See @ref nrf_crypto_aead_stream_adata_update for documentation.
+ */
+typedef ret_code_t (*aead_stream_adata_fn_t)(void * const p_context,
+                                             uint8_t *    p_adata,
+                                             size_t       adata_size);
+
+/**@internal @brief Type declaration to encrypt or decrypt AEAD stream data in nrf_crypto backend.
+ *
+ *  This is internal API. See @ref nrf_crypto_aead_stream_update for documentation.
+ */
+typedef ret_code_t (*aead_stream_update_fn_t)(void * const p_context,
+                                              uint8_t *    p_data_in,
+                                              size_t       data_in_size,
+                                              uint8_t *    p_data_out);
+
+/**@internal @brief Type declaration to finalize an AEAD stream operation in nrf_crypto backend.
+ *
+ *  This is internal API. See @ref nrf_crypto_aead_stream_finalize for documentation.
+ */
+typedef ret_code_t (*aead_stream_finalize_fn_t)(void * const p_context,
+                                                uint8_t *    p_mac,
+                                                uint8_t      mac_size);
+
 /**@internal @brief Type declaration for the nrf_crypto_aead info structure.
  *
  * @details     This structure contains the calling interface and any metadata required
@@ -125,6 +159,12 @@ typedef struct
     aead_init_fn_t   const init_fn;
     aead_uninit_fn_t const uninit_fn;
     aead_crypt_fn_t  const crypt_fn;
+
+    /* Optional, NULL if the backend does not support the mode in stream operations. */
+    aead_stream_start_fn_t    const stream_start_fn;
+    aead_stream_adata_fn_t    const stream_adata_fn;
+    aead_stream_update_fn_t   const stream_update_fn;
+    aead_stream_finalize_fn_t const stream_finalize_fn;
 } nrf_crypto_aead_info_t;
 
 /**@internal @brief Type declaration of internal representation of an AEAD context structure.
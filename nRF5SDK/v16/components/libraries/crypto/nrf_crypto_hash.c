@@ -118,6 +118,46 @@ ret_code_t nrf_crypto_hash_update(nrf_crypto_hash_context_t   * const p_context,
 }
 
 
+ret_code_t nrf_crypto_hash_update_vector(nrf_crypto_hash_context_t     * const p_context,
+                                         nrf_crypto_hash_chunk_t       const * p_chunks,
+                                         size_t                                chunk_count)
+{
+    ret_code_t                              ret_val;
+    nrf_crypto_hash_update_fn_t             update_fn;
+    nrf_crypto_hash_internal_context_t    * p_int_context
+        = (nrf_crypto_hash_internal_context_t *) p_context;
+
+    ret_val = verify_context(p_int_context);
+    if (ret_val != NRF_SUCCESS)
+    {
+        return ret_val;
+    }
+
+    VERIFY_TRUE((p_chunks != NULL) || (chunk_count == 0), NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    update_fn = p_int_context->p_info->update_fn;
+
+    for (size_t i = 0; i < chunk_count; i++)
+    {
+        // Allow zero size chunks
+        if (p_chunks[i].data_size == 0)
+        {
+            continue;
+        }
+
+        VERIFY_TRUE(p_chunks[i].p_data != NULL, NRF_ERROR_CRYPTO_INPUT_NULL);
+
+        ret_val = update_fn(p_context, p_chunks[i].p_data, p_chunks[i].data_size);
+        if (ret_val != NRF_SUCCESS)
+        {
+            return ret_val;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
+
+
 ret_code_t nrf_crypto_hash_finalize(nrf_crypto_hash_context_t * const p_context,
                                     uint8_t                         * p_digest,
                                     size_t                    * const p_digest_size)
@@ -141,12 +181,12 @@ ret_code_t nrf_crypto_hash_finalize(nrf_crypto_hash_context_t * const p_context,
 }
 
 
-ret_code_t nrf_crypto_hash_calculate(nrf_crypto_hash_context_t    * const p_context,
-                                     nrf_crypto_hash_info_t       const * p_info,
-                                     uint8_t                      const * p_data,
-                                     size_t                               data_size,
-                                     uint8_t                            * p_digest,
-                                     size_t                       * const p_digest_size)
+ret_code_t nrf_crypto_hash_calculate_vector(nrf_crypto_hash_context_t * const p_context,
+                                            nrf_crypto_hash_info_t    const * p_info,
+                                            nrf_crypto_hash_chunk_t   const * p_chunks,
+                                            size_t                            chunk_count,
+                                            uint8_t                         * p_digest,
+                                            size_t                    * const p_digest_size)
 {
     ret_code_t                      ret_val;
     nrf_crypto_hash_context_t     * p_ctx  = (nrf_crypto_hash_context_t *)p_context;
@@ -183,7 +223,7 @@ ret_code_t nrf_crypto_hash_calculate(nrf_crypto_hash_context_t    * const p_cont
     ret_val = nrf_crypto_hash_init(p_ctx, p_info);
     NRF_CRYPTO_VERIFY_SUCCESS_DEALLOCATE(ret_val, p_allocated_context);
 
-    ret_val = nrf_crypto_hash_update(p_ctx, p_data, data_size);
+    ret_val = nrf_crypto_hash_update_vector(p_ctx, p_chunks, chunk_count);
     NRF_CRYPTO_VERIFY_SUCCESS_DEALLOCATE(ret_val, p_allocated_context);
 
     ret_val = nrf_crypto_hash_finalize(p_ctx, p_digest, p_digest_size);
@@ -200,6 +240,21 @@ ret_code_t nrf_crypto_hash_calculate(nrf_crypto_hash_context_t    * const p_cont
     return NRF_SUCCESS;
 }
 
+ret_code_t nrf_crypto_hash_calculate(nrf_crypto_hash_context_t    * const p_context,
+                                     nrf_crypto_hash_info_t       const * p_info,
+                                     uint8_t                      const * p_data,
+                                     size_t                               data_size,
+                                     uint8_t                            * p_digest,
+                                     size_t                       * const p_digest_size)
+{
+    nrf_crypto_hash_chunk_t chunk = {.p_data = p_data, .data_size = data_size};
+
+    // Keep the behavior of nrf_crypto_hash_update, which requires p_data also for empty input.
+    VERIFY_TRUE(p_data != NULL, NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    return nrf_crypto_hash_calculate_vector(p_context, p_info, &chunk, 1, p_digest, p_digest_size);
+}
+
 #endif // NRF_MODULE_ENABLED(NRF_CRYPTO_HASH)
 
 #endif // NRF_MODULE_ENABLED(NRF_CRYPTO)
@@ -95,6 +95,16 @@ typedef uint8_t nrf_crypto_hash_sha256_digest_t[NRF_CRYPTO_HASH_SIZE_SHA256];
 typedef uint8_t nrf_crypto_hash_sha512_digest_t[NRF_CRYPTO_HASH_SIZE_SHA512];
 
 
+/**@brief Structure describing one buffer in a list of buffers (scatter-gather list) to be hashed
+ *        as one contiguous message, see @ref nrf_crypto_hash_update_vector.
+ */
+typedef struct
+{
+    uint8_t const * p_data;     /**< Pointer to data to be hashed. May be NULL if data_size is 0. */
+    size_t          data_size;  /**< Length of the data to be hashed. */
+} nrf_crypto_hash_chunk_t;
+
+
 /**@brief Function for initializing the context structure required to compute a hash digest from
  *        arbitrary input data.
  *
@@ -166,6 +176,42 @@ ret_code_t nrf_crypto_hash_update(nrf_crypto_hash_context_t   * const p_context,
                                   uint8_t                     const * p_data,
                                   size_t                              data_size);
 
+/**@brief Function for updating the hash calculation with a list of buffers.
+ * @details The buffers are hashed in order, as if they were concatenated and passed to
+ *          @ref nrf_crypto_hash_update in one call. This is intended for data which is not
+ *          contiguous in memory, for example several flash regions that make up one firmware
+ *          image. The context is validated once for the whole list and the chunks are passed
+ *          directly to the nrf_crypto backend.
+ * @note    Processing stops at the first chunk that fails. The context must then be
+ *          initialized again using @ref nrf_crypto_hash_init.
+ * @note    The return values @ref NRF_ERROR_CRYPTO_BUSY and @ref NRF_ERROR_CRYPTO_INPUT_LOCATION
+ *          can only occur in CC310 backend.
+ * @param[in,out]   p_context       Pointer to structure holding context information for
+ *                                  the hash calculation.
+ * @param[in]       p_chunks        Pointer to an array of buffers to be hashed.
+ * @param[in]       chunk_count     Number of elements in p_chunks. May be 0.
+ * @retval  NRF_SUCCESS                               All chunks were hashed successfully.
+ * @retval  NRF_ERROR_CRYPTO_NOT_INITIALIZED          @ref nrf_crypto_init was not called prior to
+ *                                                    this crypto function.
+ * @retval  NRF_ERROR_CRYPTO_CONTEXT_NOT_INITIALIZED  The context was not initialized prior to
+ *                                                    this call or it was corrupted. Please call
+ *                                                    @ref nrf_crypto_hash_init to initialize it.
+ * @retval  NRF_ERROR_CRYPTO_CONTEXT_NULL             A NULL pointer was provided for the context
+ *                                                    structure.
+ * @retval  NRF_ERROR_CRYPTO_INPUT_NULL               p_chunks was NULL while chunk_count was not
+ *                                                    0, or a chunk with non-zero size had a NULL
+ *                                                    data pointer.
+ * @retval  NRF_ERROR_CRYPTO_INPUT_LOCATION           Input data not in RAM.
+ * @retval  NRF_ERROR_CRYPTO_BUSY                     The function could not be called because the
+ *                                                    nrf_crypto backend was busy. Please rerun the
+ *                                                    cryptographic routine at a later time.
+ * @retval  NRF_ERROR_CRYPTO_INTERNAL                 An internal error occurred in the nrf_crypto
+ *                                                    backend.
+ */
+ret_code_t nrf_crypto_hash_update_vector(nrf_crypto_hash_context_t     * const p_context,
+                                         nrf_crypto_hash_chunk_t       const * p_chunks,
+                                         size_t                                chunk_count);
+
 /**@brief Function for finalizing computation of a hash digest from arbitrary data.
  *
  * @details This function is called to get the calculated
@@ -259,6 +305,32 @@ ret_code_t nrf_crypto_hash_calculate(nrf_crypto_hash_context_t    * const p_cont
                                      uint8_t                            * p_digest,
                                      size_t                       * const p_digest_size);
 
+
+/**@brief Function for computing a hash from a list of buffers in a single integrated step.
+ * @details Same as @ref nrf_crypto_hash_calculate, but the message is given as a list of buffers
+ *          which are hashed in order, see @ref nrf_crypto_hash_update_vector.
+ * @param[in,out]   p_context       Pointer to structure holding context information for
+ *                                  the hash calculation. If this
+ *                                  is set to NULL, it will be allocated by the user configurable
+ *                                  allocate/free function @ref NRF_CRYPTO_ALLOC and
+ *                                  @ref NRF_CRYPTO_FREE.
+ * @param[in]       p_info          Pointer to structure holding info about hash algorithm
+ *                                  for the computed hash.
+ * @param[in]       p_chunks        Pointer to an array of buffers to be hashed.
+ * @param[in]       chunk_count     Number of elements in p_chunks. May be 0.
+ * @param[out]      p_digest        Pointer to buffer holding the calculated hash digest.
+ * @param[in,out]   p_digest_size   Pointer to a variable holding the length of the calculated hash.
+ *                                  Set this to the length of buffer that p_digest is pointing to.
+ * @return  The same values as @ref nrf_crypto_hash_calculate. NRF_ERROR_CRYPTO_INPUT_NULL is also
+ *          returned for the cases listed in @ref nrf_crypto_hash_update_vector.
+ */
+ret_code_t nrf_crypto_hash_calculate_vector(nrf_crypto_hash_context_t * const p_context,
+                                            nrf_crypto_hash_info_t    const * p_info,
+                                            nrf_crypto_hash_chunk_t   const * p_chunks,
+                                            size_t                            chunk_count,
+                                            uint8_t                         * p_digest,
+                                            size_t                    * const p_digest_size);
+
 #ifdef __cplusplus
 }
 #endif
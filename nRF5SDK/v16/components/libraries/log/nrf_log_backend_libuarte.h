@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2016 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+ /**@file
+ *
+ * @defgroup nrf_log_backend_libuarte Log libUARTE backend
+ * @{
+ * @ingroup  nrf_log
+ * @brief Log backend using @ref nrf_libuarte_async.
+ *
+ * Formatted logs are written to a TX ring buffer which is sent by EasyDMA directly
+ * from the ring buffer in chunks as large as available, without waiting for the
+ * transfer to complete. The same stream can be used to send raw data, for example
+ * ADC samples, using @ref nrf_log_backend_libuarte_alloc and
+ * @ref nrf_log_backend_libuarte_commit.
+ *
+ * @note The backend requires @ref nrf_libuarte_async configuration (for example
+ *       NRF_LIBUARTE_DRV_UARTE0) and the TIMER and RTC instances selected in
+ *       the backend configuration to be enabled in sdk_config.h.
+ */
+
+#ifndef NRF_LOG_BACKEND_LIBUARTE_H
+#define NRF_LOG_BACKEND_LIBUARTE_H
+
+#include "nrf_log_backend_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const nrf_log_backend_api_t nrf_log_backend_libuarte_api;
+
+typedef struct {
+    nrf_log_backend_t               backend;
+} nrf_log_backend_libuarte_t;
+
+#define NRF_LOG_BACKEND_LIBUARTE_DEF(_name)                         \
+    NRF_LOG_BACKEND_DEF(_name, nrf_log_backend_libuarte_api, NULL)
+
+void nrf_log_backend_libuarte_init(void);
+
+/**
+ * @brief Function for allocating space for raw data in the TX stream.
+ *
+ * Data is written by the caller directly into the TX ring buffer and sent without copying.
+ * Allocated space is contiguous, so it can be smaller than requested when the ring buffer
+ * wraps. The allocation must be followed by @ref nrf_log_backend_libuarte_commit, unless
+ * the allocated length is 0.
+ *
+ * @param[out]    pp_data  Pointer to the allocated space.
+ * @param[in,out] p_length Requested length. Filled with the allocated length.
+ *
+ * @retval NRF_SUCCESS    Space allocated (length can be 0 if the buffer is full).
+ * @retval NRF_ERROR_BUSY Another allocation (or log output) is ongoing.
+ */
+ret_code_t nrf_log_backend_libuarte_alloc(uint8_t ** pp_data, size_t * p_length);
+
+/**
+ * @brief Function for committing raw data written to the space allocated by
+ *        @ref nrf_log_backend_libuarte_alloc and starting the transfer.
+ *
+ * @param[in] length Number of bytes to send. Can be smaller than allocated.
+ *
+ * @return NRF_SUCCESS or error code from @ref nrf_ringbuf_put.
+ */
+ret_code_t nrf_log_backend_libuarte_commit(size_t length);
+
+/**
+ * @brief Function for getting the number of log output bytes dropped because the TX ring
+ *        buffer was full, or because raw data was being allocated in a preempted context.
+ *
+ * Log output is not awaited in the deferred mode because it can be processed in a context
+ * that preempts the UARTE interrupt. Increase @ref NRF_LOG_BACKEND_LIBUARTE_TX_BUFFER_SIZE
+ * if data is dropped.
+ *
+ * @return Number of dropped bytes since initialization.
+ */
+uint32_t nrf_log_backend_libuarte_dropped_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //NRF_LOG_BACKEND_LIBUARTE_H
+
+/** @} */
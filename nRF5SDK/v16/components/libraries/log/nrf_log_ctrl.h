@@ -155,6 +155,10 @@ void nrf_log_panic(void);
  * Use this function only if the logs are buffered. It takes a single entry from the
  * buffer and attempts to process it.
  *
+ * With @ref NRF_LOG_LOCK_FREE_ENABLED, the function also returns true without processing an
+ * entry if a producer has reserved space but has not marked its entry yet. The call must then
+ * be retried after the producer has completed.
+ *
  * @retval true  If there are more entries to process.
  * @retval false If there are no more entries to process.
  */
@@ -216,6 +220,51 @@ nrf_log_severity_t nrf_log_module_filter_get(uint32_t backend_id,
                                              bool     is_ordered_idx,
                                              bool     dynamic);
 
+/**
+ * @brief Function for configuring a token bucket rate limit of the module.
+ *
+ * Entries exceeding the limit are suppressed in the frontend before buffer allocation.
+ * Rate limiting requires timestamps (@ref NRF_LOG_USES_TIMESTAMP).
+ *
+ * @param module_id  Module ID.
+ * @param rate       Number of entries per second. 0 disables rate limiting.
+ * @param burst      Maximum number of entries which can be logged at once.
+ *
+ * @retval NRF_SUCCESS              Rate limit configured.
+ * @retval NRF_ERROR_NOT_SUPPORTED  Rate limiting is not enabled or timestamps are not used.
+ * @retval NRF_ERROR_INVALID_PARAM  Invalid module ID or burst is 0.
+ * @retval NRF_ERROR_NO_MEM         @ref NRF_LOG_RATE_LIMIT_MODULE_COUNT modules are already
+ *                                  rate limited or sampled.
+ */
+ret_code_t nrf_log_module_rate_limit_set(uint32_t module_id, uint16_t rate, uint16_t burst);
+
+/**
+ * @brief Function for configuring sampling of the module logs.
+ *
+ * Only every n-th entry of the module is passed to the logger. The rest is suppressed in
+ * the frontend before buffer allocation.
+ *
+ * @param module_id  Module ID.
+ * @param n          Sampling ratio. 0 or 1 disables sampling.
+ *
+ * @retval NRF_SUCCESS              Sampling configured.
+ * @retval NRF_ERROR_NOT_SUPPORTED  Rate limiting is not enabled.
+ * @retval NRF_ERROR_INVALID_PARAM  Invalid module ID.
+ * @retval NRF_ERROR_NO_MEM         @ref NRF_LOG_RATE_LIMIT_MODULE_COUNT modules are already
+ *                                  rate limited or sampled.
+ */
+ret_code_t nrf_log_module_sampling_set(uint32_t module_id, uint32_t n);
+
+/**
+ * @brief Function for getting the number of module entries suppressed by rate limiting or sampling.
+ *
+ * @param module_id  Module ID.
+ * @param reset      If true, the counter is cleared after reading.
+ *
+ * @return Number of suppressed entries.
+ */
+uint32_t nrf_log_module_suppressed_cnt_get(uint32_t module_id, bool reset);
+
 /**
  * @brief Function stores current filtering configuration into non-volatile memory using @ref fds module.
  *
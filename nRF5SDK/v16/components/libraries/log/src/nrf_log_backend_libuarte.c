@@ -0,0 +1,307 @@
+/**
+ * Copyright (c) 2016 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NRF_LOG) && NRF_MODULE_ENABLED(NRF_LOG_BACKEND_LIBUARTE)
+#include "nrf_log_backend_libuarte.h"
+#include "nrf_log_backend_serial.h"
+#include "nrf_log_internal.h"
+#include "nrf_libuarte_async.h"
+#include "nrf_ringbuf.h"
+#include "nrf_atomic.h"
+#include "app_util_platform.h"
+#include "nrf_gpio.h"
+#include "app_error.h"
+
+#define LIBUARTE_RX_BUF_SIZE   8
+#define LIBUARTE_RX_BUF_CNT    3
+#define LIBUARTE_TIMEOUT_US    100
+#define BLOCKING_TX_MAX_LEN    ((1UL << UARTE0_EASYDMA_MAXCNT_SIZE) - 1)
+
+NRF_LIBUARTE_ASYNC_DEFINE(m_libuarte,
+                          NRF_LOG_BACKEND_LIBUARTE_UARTE_INSTANCE,
+                          NRF_LOG_BACKEND_LIBUARTE_TIMER_INSTANCE,
+                          NRF_LOG_BACKEND_LIBUARTE_RTC_INSTANCE,
+                          NRF_LIBUARTE_PERIPHERAL_NOT_USED,
+                          LIBUARTE_RX_BUF_SIZE,
+                          LIBUARTE_RX_BUF_CNT);
+
+NRF_RINGBUF_DEF(m_tx_ringbuf, NRF_LOG_BACKEND_LIBUARTE_TX_BUFFER_SIZE);
+
+static uint8_t m_string_buff[NRF_LOG_BACKEND_LIBUARTE_TEMP_BUFFER_SIZE];
+static nrf_atomic_flag_t m_tx_busy;
+static nrf_atomic_u32_t  m_dropped;
+static bool m_blocking;
+
+static bool tx_data_pending(void)
+{
+    return m_tx_ringbuf.p_cb->wr_idx != m_tx_ringbuf.p_cb->rd_idx;
+}
+
+/**
+ * @brief Function starts DMA transfer of the oldest contiguous chunk of the TX ring buffer
+ *        if no transfer is ongoing.
+ *
+ * Function can be called from any context. Data put while the transfer is ongoing is sent
+ * when the transfer is completed.
+ */
+static void tx_start(void)
+{
+    while (nrf_atomic_flag_set_fetch(&m_tx_busy) == 0)
+    {
+        uint8_t * p_data;
+        size_t    len = NRF_LOG_BACKEND_LIBUARTE_TX_BUFFER_SIZE;
+
+        if (nrf_ringbuf_get(&m_tx_ringbuf, &p_data, &len, true) != NRF_SUCCESS)
+        {
+            // Reading is ongoing in the preempted context which sends the data.
+            UNUSED_RETURN_VALUE(nrf_atomic_flag_clear(&m_tx_busy));
+            return;
+        }
+        if (len > 0)
+        {
+            ret_code_t err_code = nrf_libuarte_async_tx(&m_libuarte, p_data, len);
+            APP_ERROR_CHECK(err_code);
+            return;
+        }
+
+        UNUSED_RETURN_VALUE(nrf_atomic_flag_clear(&m_tx_busy));
+
+        // Data could have been put after the ring buffer was checked.
+        if (!tx_data_pending())
+        {
+            return;
+        }
+    }
+}
+
+static void blocking_tx_flush(void)
+{
+    NRF_UARTE_Type * p_uarte = m_libuarte.p_libuarte->uarte;
+    uint8_t *        p_data;
+    size_t           len;
+
+    do
+    {
+        len = BLOCKING_TX_MAX_LEN;
+        if (nrf_ringbuf_get(&m_tx_ringbuf, &p_data, &len, true) != NRF_SUCCESS)
+        {
+            // Flushing is ongoing in the preempted context which sends the data.
+            return;
+        }
+        if (len > 0)
+        {
+            nrf_uarte_event_clear(p_uarte, NRF_UARTE_EVENT_ENDTX);
+            nrf_uarte_tx_buffer_set(p_uarte, p_data, len);
+            nrf_uarte_task_trigger(p_uarte, NRF_UARTE_TASK_STARTTX);
+            while (!nrf_uarte_event_check(p_uarte, NRF_UARTE_EVENT_ENDTX))
+            {
+
+            }
+            UNUSED_RETURN_VALUE(nrf_ringbuf_free(&m_tx_ringbuf, len));
+        }
+    } while (len > 0);
+}
+
+static void tx_kick(void)
+{
+    if (m_blocking)
+    {
+        blocking_tx_flush();
+    }
+    else
+    {
+        tx_start();
+    }
+}
+
+static void libuarte_evt_handler(void * p_context, nrf_libuarte_async_evt_t * p_evt)
+{
+    if (p_evt->type == NRF_LIBUARTE_ASYNC_EVT_TX_DONE)
+    {
+        UNUSED_RETURN_VALUE(nrf_ringbuf_free(&m_tx_ringbuf, p_evt->data.rxtx.length));
+        UNUSED_RETURN_VALUE(nrf_atomic_flag_clear(&m_tx_busy));
+        tx_start();
+    }
+}
+
+static void blocking_mode_enter(void)
+{
+    NRF_UARTE_Type * p_uarte = m_libuarte.p_libuarte->uarte;
+
+    nrf_gpio_pin_set(NRF_LOG_BACKEND_LIBUARTE_TX_PIN);
+    nrf_gpio_cfg_output(NRF_LOG_BACKEND_LIBUARTE_TX_PIN);
+
+    nrf_uarte_disable(p_uarte);
+    nrf_uarte_baudrate_set(p_uarte, (nrf_uarte_baudrate_t)NRF_LOG_BACKEND_LIBUARTE_BAUDRATE);
+    nrf_uarte_configure(p_uarte, NRF_UARTE_PARITY_EXCLUDED, NRF_UARTE_HWFC_DISABLED);
+    nrf_uarte_txrx_pins_set(p_uarte, NRF_LOG_BACKEND_LIBUARTE_TX_PIN, NRF_UARTE_PSEL_DISCONNECTED);
+    nrf_uarte_int_disable(p_uarte, 0xFFFFFFFF);
+    nrf_uarte_enable(p_uarte);
+
+    m_blocking = true;
+}
+
+void nrf_log_backend_libuarte_init(void)
+{
+    nrf_ringbuf_init(&m_tx_ringbuf);
+    m_tx_busy  = 0;
+    m_dropped  = 0;
+    m_blocking = false;
+
+    if (!NRF_LOG_DEFERRED)
+    {
+        // Logs are processed in the context of the caller which may have higher priority
+        // than the UARTE interrupt, so the transfer completion cannot be awaited.
+        blocking_mode_enter();
+        return;
+    }
+
+    nrf_libuarte_async_config_t config = {
+            .tx_pin     = NRF_LOG_BACKEND_LIBUARTE_TX_PIN,
+            .rx_pin     = NRF_LOG_BACKEND_LIBUARTE_RX_PIN,
+            .cts_pin    = NRF_UARTE_PSEL_DISCONNECTED,
+            .rts_pin    = NRF_UARTE_PSEL_DISCONNECTED,
+            .timeout_us = LIBUARTE_TIMEOUT_US,
+            .hwfc       = NRF_UARTE_HWFC_DISABLED,
+            .parity     = NRF_UARTE_PARITY_EXCLUDED,
+            .baudrate   = (nrf_uarte_baudrate_t)NRF_LOG_BACKEND_LIBUARTE_BAUDRATE,
+            .pullup_rx  = false,
+            .int_prio   = APP_IRQ_PRIORITY_LOWEST
+    };
+
+    ret_code_t err_code = nrf_libuarte_async_init(&m_libuarte, &config, libuarte_evt_handler, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+ret_code_t nrf_log_backend_libuarte_alloc(uint8_t ** pp_data, size_t * p_length)
+{
+    return nrf_ringbuf_alloc(&m_tx_ringbuf, pp_data, p_length, true);
+}
+
+uint32_t nrf_log_backend_libuarte_dropped_get(void)
+{
+    return m_dropped;
+}
+
+ret_code_t nrf_log_backend_libuarte_commit(size_t length)
+{
+    ret_code_t err_code = nrf_ringbuf_put(&m_tx_ringbuf, length);
+    if (err_code == NRF_SUCCESS)
+    {
+        tx_kick();
+    }
+    return err_code;
+}
+
+static void serial_tx(void const * p_context, char const * p_buffer, size_t len)
+{
+    while (len > 0)
+    {
+        size_t chunk_len = len;
+
+        if (nrf_ringbuf_cpy_put(&m_tx_ringbuf, (uint8_t const *)p_buffer, &chunk_len) != NRF_SUCCESS)
+        {
+            // Raw data allocation is ongoing in the preempted context. Drop the output.
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_dropped, len));
+            return;
+        }
+        p_buffer += chunk_len;
+        len      -= chunk_len;
+
+        tx_kick();
+
+        if ((len > 0) && !m_blocking)
+        {
+            // The ring buffer is full. Waiting for the transfer to free some space would block
+            // forever if the caller preempts the UARTE interrupt, so the rest is dropped.
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_dropped, len));
+            return;
+        }
+    }
+}
+
+static void nrf_log_backend_libuarte_put(nrf_log_backend_t const * p_backend,
+                                         nrf_log_entry_t * p_msg)
+{
+    nrf_log_backend_serial_put(p_backend, p_msg, m_string_buff,
+                               NRF_LOG_BACKEND_LIBUARTE_TEMP_BUFFER_SIZE, serial_tx);
+}
+
+static void nrf_log_backend_libuarte_flush(nrf_log_backend_t const * p_backend)
+{
+    if (m_blocking)
+    {
+        blocking_tx_flush();
+        return;
+    }
+
+    tx_start();
+
+    // Transfer completion can only be awaited if the UARTE interrupt can preempt the caller.
+    if (current_int_priority_get() > APP_IRQ_PRIORITY_LOWEST)
+    {
+        while (tx_data_pending())
+        {
+
+        }
+    }
+}
+
+static void nrf_log_backend_libuarte_panic_set(nrf_log_backend_t const * p_backend)
+{
+    if (!m_blocking)
+    {
+        nrf_libuarte_async_uninit(&m_libuarte);
+
+        // Data of the aborted transfer is sent again.
+        UNUSED_RETURN_VALUE(nrf_ringbuf_free(&m_tx_ringbuf, 0));
+        m_tx_busy = 0;
+
+        blocking_mode_enter();
+    }
+    blocking_tx_flush();
+}
+
+const nrf_log_backend_api_t nrf_log_backend_libuarte_api = {
+        .put       = nrf_log_backend_libuarte_put,
+        .flush     = nrf_log_backend_libuarte_flush,
+        .panic_set = nrf_log_backend_libuarte_panic_set,
+};
+#endif //NRF_MODULE_ENABLED(NRF_LOG) && NRF_MODULE_ENABLED(NRF_LOG_BACKEND_LIBUARTE)
@@ -55,6 +55,11 @@ NRF_LOG_BACKEND_RTT_DEF(rtt_log_backend);
 NRF_LOG_BACKEND_UART_DEF(uart_log_backend);
 #endif
 
+#if defined(NRF_LOG_BACKEND_LIBUARTE_ENABLED) && NRF_LOG_BACKEND_LIBUARTE_ENABLED
+#include "nrf_log_backend_libuarte.h"
+NRF_LOG_BACKEND_LIBUARTE_DEF(libuarte_log_backend);
+#endif
+
 void nrf_log_default_backends_init(void)
 {
     int32_t backend_id = -1;
@@ -72,5 +77,12 @@ void nrf_log_default_backends_init(void)
     ASSERT(backend_id >= 0);
     nrf_log_backend_enable(&uart_log_backend);
 #endif
+
+#if defined(NRF_LOG_BACKEND_LIBUARTE_ENABLED) && NRF_LOG_BACKEND_LIBUARTE_ENABLED
+    nrf_log_backend_libuarte_init();
+    backend_id = nrf_log_backend_add(&libuarte_log_backend, NRF_LOG_SEVERITY_DEBUG);
+    ASSERT(backend_id >= 0);
+    nrf_log_backend_enable(&libuarte_log_backend);
+#endif
 }
 #endif
@@ -75,6 +75,7 @@ NRF_RINGBUF_DEF(m_log_push_ringbuf, NRF_LOG_STR_PUSH_BUFFER_SIZE);
 #define NRF_LOG_MAX_BACKENDS           (32/NRF_LOG_FILTER_BITS_PER_BACKEND)
 #define NRF_LOG_MAX_HEXDUMP            (NRF_LOG_MSGPOOL_ELEMENT_SIZE*NRF_LOG_MSGPOOL_ELEMENT_COUNT/2)
 #define NRF_LOG_INVALID_BACKEND_U32    0xFFFFFFFF
+#define NRF_LOG_LOCK_FREE_DEQUEUE_SPIN 64 // Number of polls for a pending reservation in dequeue.
 /**
  * brief An internal control block of the logger
  *
@@ -90,15 +91,35 @@ typedef struct
     uint32_t                  mask;            // Size of buffer (must be power of 2) presented as mask
     uint32_t                  buffer[NRF_LOG_BUF_WORDS];
     nrf_log_timestamp_func_t  timestamp_func;  // A pointer to function that returns timestamp
+    uint32_t                  timestamp_freq;  // Frequency of the timestamp
     nrf_log_backend_t const * p_backend_head;
     nrf_atomic_flag_t         log_skipping;
     nrf_atomic_flag_t         log_skipped;
     nrf_atomic_u32_t          log_dropped_cnt;
+    nrf_atomic_u32_t          reserving;       // Number of producers between reservation and header marking
     bool                      autoflush;
 } log_data_t;
 
 static log_data_t   m_log_data;
 
+#if NRF_LOG_RATE_LIMIT_ENABLED
+typedef struct
+{
+    uint16_t                  module_id;       // ID of the module which uses the slot
+    uint16_t                  rate;            // Entries per second allowed by the token bucket (0 if rate is not limited)
+    uint16_t                  burst;           // Capacity of the token bucket
+    uint32_t                  tokens;          // Available tokens multiplied by the timestamp frequency
+    uint32_t                  last_ts;         // Timestamp of the last token bucket update
+    uint32_t                  sample_n;        // Only every n-th entry is accepted (0 or 1 if sampling is disabled)
+    nrf_atomic_u32_t          sample_cnt;      // Number of entries that reached sampling
+    nrf_atomic_u32_t          suppressed;      // Number of entries suppressed by rate limiting or sampling
+} log_rate_limit_t;
+
+static log_rate_limit_t m_rate_limit[NRF_LOG_RATE_LIMIT_MODULE_COUNT];
+static uint32_t         m_rate_limit_cnt;      // Number of used slots
+static uint32_t         m_rate_limit_mask;     // Bit (module ID % 32) is set for the module of each used slot
+#endif
+
 
 NRF_LOG_MODULE_REGISTER();
 
@@ -123,11 +144,17 @@ ret_code_t nrf_log_init(nrf_log_timestamp_func_t timestamp_func, uint32_t timest
     m_log_data.rd_idx       = 0;
     m_log_data.log_skipped  = 0;
     m_log_data.log_skipping = 0;
+    m_log_data.reserving    = 0;
     m_log_data.autoflush    = NRF_LOG_DEFERRED ? false : true;
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    m_rate_limit_cnt        = 0;
+    m_rate_limit_mask       = 0;
+#endif
     if (NRF_LOG_USES_TIMESTAMP)
     {
         nrf_log_str_formatter_timestamp_freq_set(timestamp_freq);
         m_log_data.timestamp_func = timestamp_func;
+        m_log_data.timestamp_freq = timestamp_freq;
     }
 
     ret_code_t err_code = nrf_memobj_pool_init(&log_mempool);
@@ -309,6 +336,205 @@ nrf_log_severity_t nrf_log_module_filter_get(uint32_t backend_id,
     }
     return severity;
 }
+
+#if NRF_LOG_RATE_LIMIT_ENABLED
+/**
+ * @brief Function for finding the rate limiting slot of the module.
+ *
+ * @param module_id Module ID.
+ *
+ * @return Pointer to the slot or NULL if the module has no rate limiting or sampling configured.
+ */
+static log_rate_limit_t * rate_limit_find(uint32_t module_id)
+{
+    uint32_t cnt = m_rate_limit_cnt;
+
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        if (m_rate_limit[i].module_id == module_id)
+        {
+            return &m_rate_limit[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Function for getting the rate limiting slot of the module, allocating it if needed.
+ *
+ * A new slot is initialized before it is counted, so that the producers never see a slot
+ * which is only partially initialized.
+ *
+ * @param module_id Module ID.
+ *
+ * @return Pointer to the slot or NULL if all slots are in use.
+ */
+static log_rate_limit_t * rate_limit_get(uint32_t module_id)
+{
+    log_rate_limit_t * p_slot;
+
+    CRITICAL_REGION_ENTER();
+    p_slot = rate_limit_find(module_id);
+    if ((p_slot == NULL) && (m_rate_limit_cnt < NRF_LOG_RATE_LIMIT_MODULE_COUNT))
+    {
+        p_slot = &m_rate_limit[m_rate_limit_cnt];
+        memset(p_slot, 0, sizeof(*p_slot));
+        p_slot->module_id = (uint16_t)module_id;
+        __DMB();
+        m_rate_limit_cnt++;
+        m_rate_limit_mask |= 1UL << (module_id & 0x1F);
+    }
+    CRITICAL_REGION_EXIT();
+
+    return p_slot;
+}
+#endif // NRF_LOG_RATE_LIMIT_ENABLED
+
+ret_code_t nrf_log_module_rate_limit_set(uint32_t module_id, uint16_t rate, uint16_t burst)
+{
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    if (!NRF_LOG_USES_TIMESTAMP)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    uint64_t capacity = (uint64_t)burst * m_log_data.timestamp_freq;
+    if ((module_id >= nrf_log_module_cnt_get()) || (burst == 0) || (capacity > UINT32_MAX))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    log_rate_limit_t * p_slot = rate_limit_get(module_id);
+    if (p_slot == NULL)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_slot->rate    = 0;
+    p_slot->burst   = burst;
+    p_slot->tokens  = (uint32_t)capacity;
+    p_slot->last_ts = m_log_data.timestamp_func();
+    p_slot->rate    = rate;
+
+    return NRF_SUCCESS;
+#else
+    UNUSED_PARAMETER(module_id);
+    UNUSED_PARAMETER(rate);
+    UNUSED_PARAMETER(burst);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+ret_code_t nrf_log_module_sampling_set(uint32_t module_id, uint32_t n)
+{
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    if (module_id >= nrf_log_module_cnt_get())
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    log_rate_limit_t * p_slot = rate_limit_get(module_id);
+    if (p_slot == NULL)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    p_slot->sample_cnt = 0;
+    p_slot->sample_n   = n;
+
+    return NRF_SUCCESS;
+#else
+    UNUSED_PARAMETER(module_id);
+    UNUSED_PARAMETER(n);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+uint32_t nrf_log_module_suppressed_cnt_get(uint32_t module_id, bool reset)
+{
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    log_rate_limit_t * p_slot = rate_limit_find(module_id);
+    if (p_slot == NULL)
+    {
+        return 0;
+    }
+
+    return reset ? nrf_atomic_u32_fetch_store(&p_slot->suppressed, 0) : p_slot->suppressed;
+#else
+    UNUSED_PARAMETER(module_id);
+    UNUSED_PARAMETER(reset);
+    return 0;
+#endif
+}
+
+#if NRF_LOG_RATE_LIMIT_ENABLED
+/**
+ * @brief Function checks if a new entry of the module passes sampling and rate limiting.
+ *
+ * @details Token bucket keeps tokens multiplied by the timestamp frequency, so each timestamp
+ * tick adds @p rate tokens and each entry consumes @p timestamp_freq tokens. Timestamp wrap
+ * (e.g. 24-bit RTC counter) refills the bucket. If the same module logs from different
+ * priorities, the bucket state is updated without locking and the limit is approximate.
+ *
+ * Modules without a slot are recognized by the slot mask, so that their entries do not
+ * pay for the search of the slot table.
+ *
+ * @param module_id Module ID.
+ *
+ * @return True if entry should be logged, false if it is suppressed.
+ */
+static bool rate_limit_pass(uint32_t module_id)
+{
+    if ((m_rate_limit_mask & (1UL << (module_id & 0x1F))) == 0)
+    {
+        return true;
+    }
+
+    log_rate_limit_t * p_slot = rate_limit_find(module_id);
+    if (p_slot == NULL)
+    {
+        return true;
+    }
+
+    uint32_t sample_n = p_slot->sample_n;
+    if (sample_n > 1)
+    {
+        uint32_t cnt = nrf_atomic_u32_fetch_add(&p_slot->sample_cnt, 1);
+        if ((cnt % sample_n) != 0)
+        {
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&p_slot->suppressed, 1));
+            return false;
+        }
+    }
+
+    if (NRF_LOG_USES_TIMESTAMP && (p_slot->rate != 0))
+    {
+        uint32_t freq     = m_log_data.timestamp_freq;
+        uint32_t capacity = p_slot->burst * freq;
+        uint32_t now      = m_log_data.timestamp_func();
+        uint32_t last_ts  = p_slot->last_ts;
+        uint64_t tokens   = capacity;
+
+        if (now >= last_ts)
+        {
+            tokens = p_slot->tokens + (uint64_t)(now - last_ts) * p_slot->rate;
+            tokens = MIN(tokens, capacity);
+        }
+        p_slot->last_ts = now;
+
+        if (tokens < freq)
+        {
+            p_slot->tokens = (uint32_t)tokens;
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&p_slot->suppressed, 1));
+            return false;
+        }
+        p_slot->tokens = (uint32_t)(tokens - freq);
+    }
+
+    return true;
+}
+#endif // NRF_LOG_RATE_LIMIT_ENABLED
+
 /**
  * Function examines current header and omits packets which are in progress.
  */
@@ -432,10 +658,48 @@ static inline void std_header_set(uint32_t severity_mid,
     p_header->base.std.in_progress = 0;
 }
 
+/**
+ * @brief Marks the entry starting at @p wr_idx as in progress.
+ *
+ * @param content_len   Number of 32bit arguments or hex dump length in 32bit words (ceiled).
+ * @param wr_idx        Write index of the entry.
+ * @param std           True for standard entry, false for hex dump.
+ */
+static inline void in_progress_header_set(uint32_t content_len, uint32_t wr_idx, bool std)
+{
+    nrf_log_main_header_t invalid_header;
+    invalid_header.raw = 0;
+
+    if (std)
+    {
+        invalid_header.std.type        = HEADER_TYPE_STD;
+        invalid_header.std.in_progress = 1;
+        invalid_header.std.nargs       = content_len;
+    }
+    else
+    {
+        invalid_header.hexdump.type = HEADER_TYPE_HEXDUMP;
+        invalid_header.hexdump.in_progress = 1;
+        invalid_header.hexdump.len = content_len;
+    }
+
+    nrf_log_main_header_t * p_header =
+               (nrf_log_main_header_t *)&m_log_data.buffer[wr_idx & m_log_data.mask];
+
+    p_header->raw = invalid_header.raw;
+}
+
+#if NRF_LOG_LOCK_FREE_ENABLED
 /**
  * @brief Allocates chunk in a buffer for one entry and injects overflow if
  * there is no room for requested entry.
  *
+ * @details Lock-free variant. The write index is advanced with compare-and-exchange
+ * (LDREX/STREX), so producers never disable interrupts. Until the new entry is marked as in
+ * progress, the producer is counted in @ref log_data_t::reserving. Oldest entries are skipped
+ * only if no other producer is in that window, because its entry may be the oldest one and
+ * its header is not valid yet. Otherwise the new entry is dropped.
+ *
  * @param content_len   Number of 32bit arguments. In case of allocating for hex dump it
  *                      is the size of the buffer in 32bit words (ceiled).
  * @param p_wr_idx      Pointer to write index.
@@ -446,18 +710,31 @@ static inline void std_header_set(uint32_t severity_mid,
 static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool std)
 {
     uint32_t req_len = content_len + HEADER_SIZE;
-    bool     ret            = true;
-    CRITICAL_REGION_ENTER();
-    *p_wr_idx = m_log_data.wr_idx;
-    uint32_t available_words = (m_log_data.mask + 1) - (m_log_data.wr_idx - m_log_data.rd_idx);
-    while (req_len > available_words)
+    bool     ret     = true;
+
+    UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.reserving, 1));
+
+    while (true)
     {
+        uint32_t wr_idx          = m_log_data.wr_idx;
+        uint32_t available_words = (m_log_data.mask + 1) - (wr_idx - m_log_data.rd_idx);
+
+        if (req_len <= available_words)
+        {
+            if (nrf_atomic_u32_cmp_exch(&m_log_data.wr_idx, &wr_idx, wr_idx + req_len))
+            {
+                *p_wr_idx = wr_idx;
+                break;
+            }
+            // Preempted by another producer, try again with updated write index.
+            continue;
+        }
+
         UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.log_dropped_cnt, 1));
-        if (NRF_LOG_ALLOW_OVERFLOW)
+        if (NRF_LOG_ALLOW_OVERFLOW && (m_log_data.reserving == 1))
         {
             uint32_t dropped_in_skip = log_skip();
             UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.log_dropped_cnt, dropped_in_skip));
-            available_words = (m_log_data.mask + 1) - (m_log_data.wr_idx - m_log_data.rd_idx);
         }
         else
         {
@@ -468,26 +745,50 @@ static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool
 
     if (ret)
     {
-        nrf_log_main_header_t invalid_header;
-        invalid_header.raw = 0;
+        in_progress_header_set(content_len, *p_wr_idx, std);
+    }
 
-        if (std)
+    UNUSED_RETURN_VALUE(nrf_atomic_u32_sub(&m_log_data.reserving, 1));
+    return ret;
+}
+#else
+/**
+ * @brief Allocates chunk in a buffer for one entry and injects overflow if
+ * there is no room for requested entry.
+ *
+ * @param content_len   Number of 32bit arguments. In case of allocating for hex dump it
+ *                      is the size of the buffer in 32bit words (ceiled).
+ * @param p_wr_idx      Pointer to write index.
+ *
+ * @return True if successful allocation, false otherwise.
+ *
+ */
+static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool std)
+{
+    uint32_t req_len = content_len + HEADER_SIZE;
+    bool     ret            = true;
+    CRITICAL_REGION_ENTER();
+    *p_wr_idx = m_log_data.wr_idx;
+    uint32_t available_words = (m_log_data.mask + 1) - (m_log_data.wr_idx - m_log_data.rd_idx);
+    while (req_len > available_words)
+    {
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.log_dropped_cnt, 1));
+        if (NRF_LOG_ALLOW_OVERFLOW)
         {
-            invalid_header.std.type        = HEADER_TYPE_STD;
-            invalid_header.std.in_progress = 1;
-            invalid_header.std.nargs       = content_len;
+            uint32_t dropped_in_skip = log_skip();
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_log_data.log_dropped_cnt, dropped_in_skip));
+            available_words = (m_log_data.mask + 1) - (m_log_data.wr_idx - m_log_data.rd_idx);
         }
         else
         {
-            invalid_header.hexdump.type = HEADER_TYPE_HEXDUMP;
-            invalid_header.hexdump.in_progress = 1;
-            invalid_header.hexdump.len = content_len;
+            ret = false;
+            break;
         }
+    }
 
-        nrf_log_main_header_t * p_header =
-                   (nrf_log_main_header_t *)&m_log_data.buffer[m_log_data.wr_idx & m_log_data.mask];
-
-        p_header->raw = invalid_header.raw;
+    if (ret)
+    {
+        in_progress_header_set(content_len, m_log_data.wr_idx, std);
 
         m_log_data.wr_idx += req_len;
     }
@@ -495,6 +796,7 @@ static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx, bool
     CRITICAL_REGION_EXIT();
     return ret;
 }
+#endif // NRF_LOG_LOCK_FREE_ENABLED
 
 char const * nrf_log_push(char * const p_str)
 {
@@ -541,6 +843,13 @@ static inline void std_n(uint32_t           severity_mid,
     uint32_t mask   = m_log_data.mask;
     uint32_t wr_idx;
 
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    if (!rate_limit_pass(severity_mid >> NRF_LOG_MODULE_ID_POS))
+    {
+        return;
+    }
+#endif
+
     if (buf_prealloc(nargs, &wr_idx, true))
     {
         // Proceed only if buffer was successfully preallocated.
@@ -649,6 +958,13 @@ void nrf_log_frontend_hexdump(uint32_t           severity_mid,
 {
     uint32_t mask   = m_log_data.mask;
 
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    if (!rate_limit_pass(severity_mid >> NRF_LOG_MODULE_ID_POS))
+    {
+        return;
+    }
+#endif
+
     uint32_t wr_idx;
     if (buf_prealloc(CEIL_DIV(length, sizeof(uint32_t)), &wr_idx, false))
     {
@@ -714,6 +1030,21 @@ bool nrf_log_frontend_dequeue(void)
     {
         return false;
     }
+#if NRF_LOG_LOCK_FREE_ENABLED
+    // A producer has reserved space but not marked its entry yet. Give it a moment to finish.
+    uint32_t spin = NRF_LOG_LOCK_FREE_DEQUEUE_SPIN;
+    while (m_log_data.reserving != 0)
+    {
+        if (spin-- == 0)
+        {
+            // The producer is still in progress, most likely preempted by this context. Report
+            // pending entries so that the caller retries. In autoflush mode the consumer runs on
+            // top of the producers, so retrying here would never end. The preempted producer
+            // flushes the buffer itself once its entry is complete.
+            return !m_log_data.autoflush;
+        }
+    }
+#endif
     m_log_data.log_skipped      = 0;
     //It has to be ensured that reading rd_idx occurs after skipped flag is cleared.
     __DSB();
@@ -85,6 +85,18 @@
 #define NRF_LOG_FILTERS_ENABLED   0
 #endif
 
+#ifndef NRF_LOG_LOCK_FREE_ENABLED
+#define NRF_LOG_LOCK_FREE_ENABLED 0
+#endif
+
+#ifndef NRF_LOG_RATE_LIMIT_ENABLED
+#define NRF_LOG_RATE_LIMIT_ENABLED 0
+#endif
+
+#ifndef NRF_LOG_RATE_LIMIT_MODULE_COUNT
+#define NRF_LOG_RATE_LIMIT_MODULE_COUNT 4
+#endif
+
 #ifndef NRF_LOG_MODULE_NAME
     #define NRF_LOG_MODULE_NAME app
 #endif
@@ -38,7 +38,8 @@
  *
  */
 #include "sdk_common.h"
-#if NRF_MODULE_ENABLED(MEM_MANAGER)
+#if NRF_MODULE_ENABLED(MEM_MANAGER) && !MEM_MANAGER_TLSF_ENABLED
+#include <stdio.h>
 #include "mem_manager.h"
 #include "nrf_assert.h"
 
@@ -896,7 +897,7 @@ void print_block_info(uint32_t block_cat, uint32_t * p_mem_in_use)
         }
         snprintf(&print_buffer[column_end], 2, "|");
 
-        NRF_LOG_BYTES_DEBUG(print_buffer, strlen(print_buffer));
+        NRF_LOG_DEBUG("%s", NRF_LOG_PUSH(print_buffer));
 
         (*p_mem_in_use) += in_use;
     }
@@ -928,4 +929,4 @@ void nrf_mem_diagnose(void)
 
 #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
 /** @} */
-#endif //NRF_MODULE_ENABLED(MEM_MANAGER)
+#endif //NRF_MODULE_ENABLED(MEM_MANAGER) && !MEM_MANAGER_TLSF_ENABLED
@@ -56,6 +56,12 @@
  * To use fewer than seven buffer pools, do not define the count for the unwanted block
  * or explicitly set it to zero. At least one block category must be configured
  * for this module to function as expected.
+ *
+ * Alternatively, when @c MEM_MANAGER_TLSF_ENABLED is set, memory is served from a single pool of
+ * @c MEM_MANAGER_TLSF_POOL_SIZE bytes by a two-level segregated fit (TLSF) allocator implemented in
+ * mem_manager_tlsf.c. Allocation and free take constant time regardless of the pool size, blocks
+ * are split to the requested size and coalesced on free. Block category settings are then ignored
+ * and @ref nrf_realloc can also grow a buffer.
  */
 
 #ifndef MEM_MANAGER_H__
@@ -159,6 +165,8 @@ void * nrf_realloc(void *p_buffer, uint32_t size);
  *          block count, number of blocks in use at the time of printing, smallest memory size
  *          allocated in the block and the largest one. This  API is intended to help developers
  *          tune the block sizes to make optimal use of memory for the application.
+ *          With the TLSF allocator, the pool usage, its high-water mark, the number of free blocks,
+ *          the largest free block and the resulting fragmentation are printed instead.
  *          This functionality is never needed in final application and therefore, is disabled by
  *          default.
  */
@@ -0,0 +1,707 @@
+/**
+ * Copyright (c) 2016 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(MEM_MANAGER) && MEM_MANAGER_TLSF_ENABLED
+#include "mem_manager.h"
+#include "nrf_assert.h"
+
+#define NRF_LOG_MODULE_NAME mem_mngr
+
+#if MEM_MANAGER_CONFIG_LOG_ENABLED
+#define NRF_LOG_LEVEL       MEM_MANAGER_CONFIG_LOG_LEVEL
+#define NRF_LOG_INFO_COLOR  MEM_MANAGER_CONFIG_INFO_COLOR
+#define NRF_LOG_DEBUG_COLOR MEM_MANAGER_CONFIG_DEBUG_COLOR
+#else //MEM_MANAGER_CONFIG_LOG_ENABLED
+#define NRF_LOG_LEVEL       0
+#endif //MEM_MANAGER_CONFIG_LOG_ENABLED
+#include "nrf_log.h"
+NRF_LOG_MODULE_REGISTER();
+
+/**
+ * @defgroup memory_manager_tlsf_mutex_lock_unlock Module's Mutex Lock/Unlock Macros.
+ *
+ * @details Macros used to lock and unlock modules. Currently the SDK does not use mutexes but
+ *          framework is provided in case need arises to use an alternative architecture.
+ * @{
+ */
+#define MM_MUTEX_LOCK()   SDK_MUTEX_LOCK(m_mm_mutex)                                                /**< Lock module using mutex. */
+#define MM_MUTEX_UNLOCK() SDK_MUTEX_UNLOCK(m_mm_mutex)                                              /**< Unlock module using mutex. */
+/** @} */
+
+#undef NULL_PARAM_CHECK
+#undef VERIFY_MODULE_INITIALIZED
+#undef VERIFY_REQUESTED_SIZE
+
+#if (MEM_MANAGER_DISABLE_API_PARAM_CHECK == 0)
+
+/**@brief Macro for verifying NULL parameters. Returning with an appropriate error code on failure. */
+#define NULL_PARAM_CHECK(PARAM)                                                 \
+    if ((PARAM) == NULL)                                                        \
+    {                                                                           \
+        return (NRF_ERROR_NULL | NRF_ERROR_MEMORY_MANAGER_ERR_BASE);            \
+    }
+
+/**@brief Macro for verifying module's initialization status. Returning with an appropriate error code on failure. */
+#define VERIFY_MODULE_INITIALIZED()                                             \
+    do                                                                          \
+    {                                                                           \
+        if (!m_module_initialized)                                              \
+        {                                                                       \
+            return (NRF_ERROR_INVALID_STATE | NRF_ERROR_MEMORY_MANAGER_ERR_BASE); \
+        }                                                                       \
+    } while (0)
+
+/**@brief Macro for verifying requested size of memory does not exceed the pool. */
+#define VERIFY_REQUESTED_SIZE(SIZE)                                             \
+    do                                                                          \
+    {                                                                           \
+        if (((SIZE) == 0) || ((SIZE) > MAX_MEM_SIZE))                           \
+        {                                                                       \
+            return (NRF_ERROR_INVALID_PARAM | NRF_ERROR_MEMORY_MANAGER_ERR_BASE); \
+        }                                                                       \
+    } while (0)
+
+/**@brief Macro for verifying that a pointer was handed out by the module. Returns on failure. */
+#define VERIFY_BLOCK_VOID(P_BLOCK)                                              \
+    do                                                                          \
+    {                                                                           \
+        if (!m_module_initialized || !block_is_valid(P_BLOCK))                  \
+        {                                                                       \
+            return;                                                             \
+        }                                                                       \
+    } while (0)
+
+#else  //MEM_MANAGER_DISABLE_API_PARAM_CHECK
+
+#define NULL_PARAM_CHECK(PARAM)
+#define VERIFY_MODULE_INITIALIZED()
+#define VERIFY_REQUESTED_SIZE(SIZE)
+#define VERIFY_BLOCK_VOID(P_BLOCK)
+
+#endif //MEM_MANAGER_DISABLE_API_PARAM_CHECK
+
+/**
+ * @defgroup memory_manager_tlsf_params TLSF parameters.
+ *
+ * @details Free blocks are kept in segregated lists. The first level splits sizes in powers of two,
+ *          the second level divides each power of two range in SL_INDEX_COUNT linear classes.
+ *          Sizes smaller than SMALL_BLOCK_SIZE are kept in the first level list 0, with
+ *          one class per word.
+ * @{
+ */
+#define ALIGN_SIZE_LOG2         2                                                                   /**< Block sizes are word aligned. */
+#define ALIGN_SIZE              (1UL << ALIGN_SIZE_LOG2)                                            /**< Block size alignment. */
+#define SL_INDEX_COUNT_LOG2     4                                                                   /**< log2 of the number of second level classes. */
+#define SL_INDEX_COUNT          (1UL << SL_INDEX_COUNT_LOG2)                                        /**< Number of second level classes. */
+#define FL_INDEX_MAX            17                                                                  /**< log2 of the largest supported pool. */
+#define FL_INDEX_SHIFT          (SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2)                             /**< First level index of the first power of two range. */
+#define FL_INDEX_COUNT          (FL_INDEX_MAX - FL_INDEX_SHIFT + 1)                                 /**< Number of first level classes. */
+#define SMALL_BLOCK_SIZE        (1UL << FL_INDEX_SHIFT)                                             /**< Sizes below this are mapped linearly. */
+/** @} */
+
+#define BLOCK_FREE_BIT          0x1UL                                                               /**< Flag set in the size field of free blocks. */
+#define BLOCK_OVERHEAD          (offsetof(block_hdr_t, p_next_free))                                /**< Bookkeeping bytes of every block. */
+#define BLOCK_SIZE_MIN          (sizeof(block_hdr_t) - BLOCK_OVERHEAD)                              /**< Smallest payload, fits free list links. */
+#define POOL_SIZE               (MEM_MANAGER_TLSF_POOL_SIZE)                                        /**< Size of the pool. */
+#define MAX_MEM_SIZE            (POOL_SIZE - 2 * BLOCK_OVERHEAD)                                    /**< Largest possible allocation. */
+
+STATIC_ASSERT((POOL_SIZE % ALIGN_SIZE) == 0);
+STATIC_ASSERT(POOL_SIZE <= (1UL << FL_INDEX_MAX));
+STATIC_ASSERT(FL_INDEX_COUNT <= 32);
+
+/**@brief Block header.
+ *
+ * @details Payload of a used block starts at @ref p_next_free. Free list links are only valid for
+ *          free blocks. The last block of the pool is a zero size sentinel which is never free.
+ */
+typedef struct block_hdr_s
+{
+    struct block_hdr_s * p_prev_phys;   /**< Physically previous block, NULL for the first one. */
+    uint32_t             size;          /**< Payload size with @ref BLOCK_FREE_BIT. */
+    struct block_hdr_s * p_next_free;   /**< Next block in the free list. */
+    struct block_hdr_s * p_prev_free;   /**< Previous block in the free list. */
+} block_hdr_t;
+
+static uint32_t      m_pool[POOL_SIZE / sizeof(uint32_t)];                                          /**< Memory managed by the module. */
+static uint32_t      m_fl_bitmap;                                                                   /**< First level classes with free blocks. */
+static uint32_t      m_sl_bitmap[FL_INDEX_COUNT];                                                   /**< Second level classes with free blocks. */
+static block_hdr_t * m_free_lists[FL_INDEX_COUNT][SL_INDEX_COUNT];                                  /**< Heads of the free lists. */
+static block_hdr_t * mp_sentinel;                                                                   /**< Last block of the pool. */
+
+#ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+static uint32_t      m_in_use;                                                                      /**< Bytes currently allocated, including block rounding. */
+static uint32_t      m_in_use_peak;                                                                 /**< High-water mark of @ref m_in_use. */
+static uint32_t      m_alloc_cnt;                                                                   /**< Number of successful allocations. */
+static uint32_t      m_alloc_fail_cnt;                                                              /**< Number of failed allocations. */
+static uint32_t      m_min_size = UINT32_MAX;                                                       /**< Smallest size requested. */
+static uint32_t      m_max_size;                                                                    /**< Largest size requested. */
+#endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+
+SDK_MUTEX_DEFINE(m_mm_mutex)                                                                        /**< Mutex variable. Currently unused, this declaration does not occupy any space in RAM. */
+#if (MEM_MANAGER_DISABLE_API_PARAM_CHECK == 0)
+static bool          m_module_initialized = false;                                                  /**< State indicating if module is initialized or not. */
+#endif // MEM_MANAGER_DISABLE_API_PARAM_CHECK
+
+
+/**@brief Function for finding the index of the most significant bit set. */
+static __INLINE uint32_t msb_index(uint32_t word)
+{
+    return 31 - __CLZ(word);
+}
+
+
+/**@brief Function for finding the index of the least significant bit set. */
+static __INLINE uint32_t lsb_index(uint32_t word)
+{
+    return 31 - __CLZ(word & (~word + 1));
+}
+
+
+static __INLINE uint32_t block_size(block_hdr_t const * p_block)
+{
+    return p_block->size & ~BLOCK_FREE_BIT;
+}
+
+
+static __INLINE bool block_is_free(block_hdr_t const * p_block)
+{
+    return (p_block->size & BLOCK_FREE_BIT) != 0;
+}
+
+
+static __INLINE void * block_to_ptr(block_hdr_t * p_block)
+{
+    return (uint8_t *)p_block + BLOCK_OVERHEAD;
+}
+
+
+static __INLINE block_hdr_t * block_from_ptr(void const * p_mem)
+{
+    return (block_hdr_t *)((uint8_t *)p_mem - BLOCK_OVERHEAD);
+}
+
+
+static __INLINE block_hdr_t * block_next(block_hdr_t const * p_block)
+{
+    return (block_hdr_t *)((uint8_t *)p_block + BLOCK_OVERHEAD + block_size(p_block));
+}
+
+
+#if (MEM_MANAGER_DISABLE_API_PARAM_CHECK == 0)
+/**@brief Function for checking that a block header lies in the pool and is in use. */
+static bool block_is_valid(block_hdr_t const * p_block)
+{
+    uintptr_t addr = (uintptr_t)p_block;
+
+    return (addr >= (uintptr_t)m_pool)                             &&
+           (addr <  (uintptr_t)mp_sentinel)                        &&
+           ((addr % ALIGN_SIZE) == 0)                              &&
+           !block_is_free(p_block)                                 &&
+           (block_next(p_block) <= mp_sentinel)                    &&
+           (block_next(p_block)->p_prev_phys == p_block);
+}
+#endif // MEM_MANAGER_DISABLE_API_PARAM_CHECK
+
+
+/**@brief Function for mapping a size to the free list it belongs to. */
+static void mapping_insert(uint32_t size, uint32_t * p_fl, uint32_t * p_sl)
+{
+    if (size < SMALL_BLOCK_SIZE)
+    {
+        *p_fl = 0;
+        *p_sl = size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+    }
+    else
+    {
+        uint32_t fl = msb_index(size);
+
+        *p_sl = (size >> (fl - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+        *p_fl = fl - (FL_INDEX_SHIFT - 1);
+    }
+}
+
+
+/**@brief Function for mapping a request to the first free list whose blocks are all large enough. */
+static void mapping_search(uint32_t size, uint32_t * p_fl, uint32_t * p_sl)
+{
+    if (size >= SMALL_BLOCK_SIZE)
+    {
+        size += (1UL << (msb_index(size) - SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    mapping_insert(size, p_fl, p_sl);
+}
+
+
+static void free_list_insert(block_hdr_t * p_block)
+{
+    uint32_t fl;
+    uint32_t sl;
+
+    mapping_insert(block_size(p_block), &fl, &sl);
+
+    block_hdr_t * p_head = m_free_lists[fl][sl];
+
+    p_block->p_next_free = p_head;
+    p_block->p_prev_free = NULL;
+    if (p_head != NULL)
+    {
+        p_head->p_prev_free = p_block;
+    }
+    m_free_lists[fl][sl] = p_block;
+
+    m_fl_bitmap     |= (1UL << fl);
+    m_sl_bitmap[fl] |= (1UL << sl);
+
+    p_block->size |= BLOCK_FREE_BIT;
+}
+
+
+static void free_list_remove(block_hdr_t * p_block)
+{
+    uint32_t fl;
+    uint32_t sl;
+
+    mapping_insert(block_size(p_block), &fl, &sl);
+
+    if (p_block->p_prev_free != NULL)
+    {
+        p_block->p_prev_free->p_next_free = p_block->p_next_free;
+    }
+    else
+    {
+        m_free_lists[fl][sl] = p_block->p_next_free;
+        if (p_block->p_next_free == NULL)
+        {
+            m_sl_bitmap[fl] &= ~(1UL << sl);
+            if (m_sl_bitmap[fl] == 0)
+            {
+                m_fl_bitmap &= ~(1UL << fl);
+            }
+        }
+    }
+    if (p_block->p_next_free != NULL)
+    {
+        p_block->p_next_free->p_prev_free = p_block->p_prev_free;
+    }
+
+    p_block->size &= ~BLOCK_FREE_BIT;
+}
+
+
+/**@brief Function for finding a free block of at least 'size' bytes in constant time, good fit. */
+static block_hdr_t * free_block_find(uint32_t size)
+{
+    uint32_t fl;
+    uint32_t sl;
+
+    mapping_search(size, &fl, &sl);
+    if (fl >= FL_INDEX_COUNT)
+    {
+        return NULL;
+    }
+
+    uint32_t sl_map = m_sl_bitmap[fl] & (~0UL << sl);
+
+    if (sl_map == 0)
+    {
+        uint32_t fl_map = (fl + 1 < 32) ? (m_fl_bitmap & (~0UL << (fl + 1))) : 0;
+
+        if (fl_map == 0)
+        {
+            return NULL;
+        }
+        fl     = lsb_index(fl_map);
+        sl_map = m_sl_bitmap[fl];
+    }
+    sl = lsb_index(sl_map);
+
+    return m_free_lists[fl][sl];
+}
+
+
+/**@brief Function for finding a free block of at least 'size' bytes.
+ *
+ * @details Good fit search first. Only if it fails, the head of the list 'size' itself maps to is
+ *          checked, so that requests close to the size of the largest free block can still succeed.
+ */
+static block_hdr_t * free_block_get(uint32_t size)
+{
+    block_hdr_t * p_block = free_block_find(size);
+
+    if (p_block == NULL)
+    {
+        uint32_t fl;
+        uint32_t sl;
+
+        mapping_insert(size, &fl, &sl);
+        p_block = m_free_lists[fl][sl];
+        if ((p_block != NULL) && (block_size(p_block) < size))
+        {
+            p_block = NULL;
+        }
+    }
+
+    return p_block;
+}
+
+
+/**@brief Function for absorbing the physically next block into 'p_block'. */
+static void block_absorb(block_hdr_t * p_block, block_hdr_t * p_next)
+{
+    p_block->size += BLOCK_OVERHEAD + block_size(p_next);
+    block_next(p_block)->p_prev_phys = p_block;
+}
+
+
+/**@brief Function for trimming a used block to 'size' bytes and releasing the tail. */
+static void block_trim(block_hdr_t * p_block, uint32_t size)
+{
+    if (block_size(p_block) < size + sizeof(block_hdr_t))
+    {
+        // Remainder would not fit a free block.
+        return;
+    }
+
+    block_hdr_t * p_rem = (block_hdr_t *)((uint8_t *)block_to_ptr(p_block) + size);
+
+    p_rem->size        = block_size(p_block) - size - BLOCK_OVERHEAD;
+    p_rem->p_prev_phys = p_block;
+    p_block->size      = size;
+
+    block_hdr_t * p_next = block_next(p_rem);
+
+    p_next->p_prev_phys = p_rem;
+    if (block_is_free(p_next))
+    {
+        free_list_remove(p_next);
+        block_absorb(p_rem, p_next);
+    }
+    free_list_insert(p_rem);
+}
+
+
+/**@brief Function for adjusting a requested size to the allocation granularity. */
+static __INLINE uint32_t size_adjust(uint32_t size)
+{
+    return ALIGN_NUM(ALIGN_SIZE, MAX(size, BLOCK_SIZE_MIN));
+}
+
+
+uint32_t nrf_mem_init(void)
+{
+    NRF_LOG_DEBUG(">> %s.", (uint32_t)__func__);
+
+    SDK_MUTEX_INIT(m_mm_mutex);
+
+    MM_MUTEX_LOCK();
+
+    memset(m_sl_bitmap, 0, sizeof(m_sl_bitmap));
+    memset(m_free_lists, 0, sizeof(m_free_lists));
+    m_fl_bitmap = 0;
+
+    // Whole pool is one free block followed by the sentinel.
+    block_hdr_t * p_block = (block_hdr_t *)m_pool;
+
+    p_block->p_prev_phys = NULL;
+    p_block->size        = MAX_MEM_SIZE;
+
+    mp_sentinel              = block_next(p_block);
+    mp_sentinel->p_prev_phys = p_block;
+    mp_sentinel->size        = 0;
+
+    free_list_insert(p_block);
+
+#if (MEM_MANAGER_DISABLE_API_PARAM_CHECK == 0)
+    m_module_initialized = true;
+#endif // MEM_MANAGER_DISABLE_API_PARAM_CHECK
+
+#ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+    m_in_use         = 0;
+    m_in_use_peak    = 0;
+    m_alloc_cnt      = 0;
+    m_alloc_fail_cnt = 0;
+    m_min_size       = UINT32_MAX;
+    m_max_size       = 0;
+    nrf_mem_diagnose();
+#endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+
+    MM_MUTEX_UNLOCK();
+
+    NRF_LOG_DEBUG("<< %s.", (uint32_t)__func__);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_mem_reserve(uint8_t ** pp_buffer, uint32_t * p_size)
+{
+    VERIFY_MODULE_INITIALIZED();
+    NULL_PARAM_CHECK(pp_buffer);
+    NULL_PARAM_CHECK(p_size);
+
+    const uint32_t requested_size = (*p_size);
+
+    VERIFY_REQUESTED_SIZE(requested_size);
+
+    NRF_LOG_DEBUG(">> %s, size 0x%04lX.", (uint32_t)__func__, requested_size);
+
+    MM_MUTEX_LOCK();
+
+    uint32_t      err_code = (NRF_ERROR_NO_MEM | NRF_ERROR_MEMORY_MANAGER_ERR_BASE);
+    uint32_t      size     = size_adjust(requested_size);
+    block_hdr_t * p_block  = free_block_get(size);
+
+    if (p_block != NULL)
+    {
+        free_list_remove(p_block);
+        block_trim(p_block, size);
+
+        (*pp_buffer) = block_to_ptr(p_block);
+        (*p_size)    = block_size(p_block);
+        err_code     = NRF_SUCCESS;
+
+#ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+        m_alloc_cnt++;
+        m_in_use        += block_size(p_block);
+        m_in_use_peak    = MAX(m_in_use_peak, m_in_use);
+        m_min_size       = MIN(m_min_size, requested_size);
+        m_max_size       = MAX(m_max_size, requested_size);
+#endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+    }
+    else
+    {
+        NRF_LOG_DEBUG("Memory reservation result %d, size %d!", err_code, requested_size);
+
+#ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+        m_alloc_fail_cnt++;
+        nrf_mem_diagnose();
+#endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+    }
+
+    MM_MUTEX_UNLOCK();
+
+    NRF_LOG_DEBUG("<< %s %p, result 0x%08lX.", (uint32_t)__func__,
+                 (uint32_t)(*pp_buffer), err_code);
+
+    return err_code;
+}
+
+
+void * nrf_malloc(uint32_t size)
+{
+    uint8_t * buffer = NULL;
+    uint32_t allocated_size = size;
+
+    uint32_t retval = nrf_mem_reserve(&buffer, &allocated_size);
+
+    if (retval != NRF_SUCCESS)
+    {
+        buffer = NULL;
+    }
+
+    return buffer;
+}
+
+
+void * nrf_calloc(uint32_t count, uint32_t size)
+{
+    uint8_t * buffer = NULL;
+    uint32_t allocated_size = (size * count);
+
+    uint32_t retval = nrf_mem_reserve(&buffer, &allocated_size);
+    if (retval == NRF_SUCCESS)
+    {
+        memset(buffer, 0, allocated_size);
+    }
+    else
+    {
+        buffer = NULL;
+    }
+
+    return buffer;
+}
+
+
+void nrf_free(void * p_mem)
+{
+    if (p_mem == NULL)
+    {
+        return;
+    }
+
+    block_hdr_t * p_block = block_from_ptr(p_mem);
+
+    VERIFY_BLOCK_VOID(p_block);
+
+    NRF_LOG_DEBUG(">> %s %p.", (uint32_t)__func__, (uint32_t)p_mem);
+
+    MM_MUTEX_LOCK();
+
+#ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+    m_in_use -= block_size(p_block);
+#endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+
+    block_hdr_t * p_next = block_next(p_block);
+    block_hdr_t * p_prev = p_block->p_prev_phys;
+
+    if (block_is_free(p_next))
+    {
+        free_list_remove(p_next);
+        block_absorb(p_block, p_next);
+    }
+    if ((p_prev != NULL) && block_is_free(p_prev))
+    {
+        free_list_remove(p_prev);
+        block_absorb(p_prev, p_block);
+        p_block = p_prev;
+    }
+    free_list_insert(p_block);
+
+    MM_MUTEX_UNLOCK();
+
+    NRF_LOG_DEBUG("<< %s.", (uint32_t)__func__);
+}
+
+
+void * nrf_realloc(void * p_mem, uint32_t size)
+{
+    if (p_mem == NULL)
+    {
+        return nrf_malloc(size);
+    }
+    if ((size == 0) || (size > MAX_MEM_SIZE))
+    {
+        return NULL;
+    }
+
+    block_hdr_t * p_block  = block_from_ptr(p_mem);
+    uint32_t      new_size = size_adjust(size);
+    uint32_t      old_size = block_size(p_block);
+
+#if (MEM_MANAGER_DISABLE_API_PARAM_CHECK == 0)
+    if (!m_module_initialized || !block_is_valid(p_block))
+    {
+        return NULL;
+    }
+#endif // MEM_MANAGER_DISABLE_API_PARAM_CHECK
+
+    MM_MUTEX_LOCK();
+
+    block_hdr_t * p_next = block_next(p_block);
+
+    // Grow in place if the physically next block is free and large enough.
+    if ((new_size > old_size) &&
+        block_is_free(p_next) &&
+        (old_size + BLOCK_OVERHEAD + block_size(p_next) >= new_size))
+    {
+        free_list_remove(p_next);
+        block_absorb(p_block, p_next);
+    }
+
+    if (new_size <= block_size(p_block))
+    {
+        block_trim(p_block, new_size);
+
+#ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+        m_in_use      = m_in_use - old_size + block_size(p_block);
+        m_in_use_peak = MAX(m_in_use_peak, m_in_use);
+#endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+
+        MM_MUTEX_UNLOCK();
+        return p_mem;
+    }
+
+    MM_MUTEX_UNLOCK();
+
+    // Relocate.
+    void * p_new = nrf_malloc(size);
+
+    if (p_new != NULL)
+    {
+        memcpy(p_new, p_mem, old_size);
+        nrf_free(p_mem);
+    }
+
+    return p_new;
+}
+
+
+#ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+
+void nrf_mem_diagnose(void)
+{
+    uint32_t free_total   = 0;
+    uint32_t free_largest = 0;
+    uint32_t free_cnt     = 0;
+    uint32_t used_cnt     = 0;
+    uint32_t frag;
+
+    for (block_hdr_t * p_block = (block_hdr_t *)m_pool; p_block != mp_sentinel; p_block = block_next(p_block))
+    {
+        if (block_is_free(p_block))
+        {
+            free_cnt++;
+            free_total  += block_size(p_block);
+            free_largest = MAX(free_largest, block_size(p_block));
+        }
+        else
+        {
+            used_cnt++;
+        }
+    }
+
+    // Share of free memory which cannot be served as a single allocation.
+    frag = (free_total == 0) ? 0 : (100 - (free_largest * 100) / free_total);
+
+    NRF_LOG_DEBUG("");
+    NRF_LOG_DEBUG("+------------+------------+------------+------------+------------+------------+");
+    NRF_LOG_DEBUG("| Pool       | In Use     | Peak       | Free       | Largest    | Frag %%     |");
+    NRF_LOG_DEBUG("+------------+------------+------------+------------+------------+------------+");
+    NRF_LOG_DEBUG("| %-10d | %-10d | %-10d | %-10d | %-10d | %-10d |",
+                  POOL_SIZE, m_in_use, m_in_use_peak, free_total, free_largest, frag);
+    NRF_LOG_DEBUG("+------------+------------+------------+------------+------------+------------+");
+    NRF_LOG_DEBUG("Blocks used %d, free %d. Allocations %d, failed %d.",
+                  used_cnt, free_cnt, m_alloc_cnt, m_alloc_fail_cnt);
+    NRF_LOG_DEBUG("Min alloc %d, max alloc %d.",
+                  (m_alloc_cnt != 0) ? m_min_size : 0, m_max_size);
+}
+
+#endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+#endif //NRF_MODULE_ENABLED(MEM_MANAGER) && MEM_MANAGER_TLSF_ENABLED
@@ -77,6 +77,7 @@ typedef struct
 } memobj_head_t;
 
 STATIC_ASSERT(sizeof(memobj_header_t) == NRF_MEMOBJ_STD_HEADER_SIZE);
+STATIC_ASSERT(sizeof(memobj_head_header_t) == NRF_MEMOBJ_HEAD_HEADER_SIZE);
 
 /** @brief Standard chunk structure. */
 struct memobj_elem_s
@@ -256,3 +257,55 @@ void nrf_memobj_read(nrf_memobj_t * p_obj,
     ASSERT(op_len == len);
 
 }
+
+size_t nrf_memobj_contiguous_size_get(nrf_memobj_pool_t const * p_pool)
+{
+    return NRF_BALLOC_ELEMENT_SIZE((nrf_balloc_t const *)p_pool) -
+           sizeof(memobj_header_t) - sizeof(memobj_head_header_t);
+}
+
+void * nrf_memobj_span_get(nrf_memobj_t * p_obj,
+                           size_t         offset,
+                           size_t *       p_len)
+{
+    ASSERT(p_obj);
+    ASSERT(p_len);
+
+    memobj_head_t * p_head       = (memobj_head_t *)p_obj;
+    memobj_elem_t * p_curr_chunk = (memobj_elem_t *)p_obj;
+    size_t          chunk_size   = p_head->head_header.data.fields.chunk_size;
+    size_t          obj_capacity = (chunk_size * p_head->head_header.data.fields.chunk_cnt) -
+                                   sizeof(memobj_head_header_fields_t);
+    size_t          chunk_idx    = (offset + sizeof(memobj_head_header_fields_t)) / chunk_size;
+    size_t          chunk_offset = (offset + sizeof(memobj_head_header_fields_t)) % chunk_size;
+
+    ASSERT(offset < obj_capacity);
+
+    //Move to the chunk that holds the offset
+    while (chunk_idx > 0)
+    {
+        p_curr_chunk = p_curr_chunk->header.p_next;
+        chunk_idx--;
+    }
+
+    *p_len = MIN(*p_len, MIN(chunk_size - chunk_offset, obj_capacity - offset));
+
+    return &p_curr_chunk->data[chunk_offset];
+}
+
+void const * nrf_memobj_gather(nrf_memobj_t * p_obj,
+                               void *         p_buf,
+                               size_t         len,
+                               size_t         offset)
+{
+    size_t span_len = len;
+    void * p_span   = nrf_memobj_span_get(p_obj, offset, &span_len);
+
+    if (span_len == len)
+    {
+        return p_span;
+    }
+
+    nrf_memobj_read(p_obj, p_buf, len, offset);
+    return p_buf;
+}
@@ -78,7 +78,23 @@ extern "C" {
 @endverbatim
  *
  */
-#define NRF_MEMOBJ_STD_HEADER_SIZE sizeof(uint32_t)
+#define NRF_MEMOBJ_STD_HEADER_SIZE sizeof(void *)
+
+/**
+ * @brief Size of the extra header in the first chunk of a memory object.
+ */
+#define NRF_MEMOBJ_HEAD_HEADER_SIZE sizeof(uint32_t)
+
+/**
+ * @brief Macro for getting the chunk size for which an object of the given size is contiguous.
+ *
+ * An object that fits in a single chunk can be accessed in place with @ref nrf_memobj_span_get
+ * and @ref nrf_memobj_gather. Use this value as @p _chunk_size of @ref NRF_MEMOBJ_POOL_DEF to
+ * size a pool for the largest object that should avoid copies.
+ *
+ * @param _data_size Size of the object data.
+ */
+#define NRF_MEMOBJ_CONTIGUOUS_CHUNK_SIZE(_data_size) ((_data_size) + NRF_MEMOBJ_HEAD_HEADER_SIZE)
 
 /**
  * @brief Macro for creating an nrf_memobj pool.
@@ -194,6 +210,54 @@ void nrf_memobj_read(nrf_memobj_t * p_obj,
                      size_t         len,
                      size_t         offset);
 
+/**
+ * @brief Function for getting the number of bytes from the start of an object that are stored
+ *        contiguously.
+ *
+ * Objects allocated from the pool with a size up to this value consist of a single chunk.
+ *
+ * @param[in] p_pool Pointer to the memobj pool instance structure.
+ *
+ * @return Contiguous size in bytes.
+ */
+size_t nrf_memobj_contiguous_size_get(nrf_memobj_pool_t const * p_pool);
+
+/**
+ * @brief Function for getting direct access to the data of the memory object.
+ *
+ * The returned span ends at the end of the chunk that holds @p offset. The remaining data can be
+ * accessed with subsequent calls.
+ *
+ * @param[in]     p_obj  Pointer to memory object.
+ * @param[in]     offset Offset.
+ * @param[in,out] p_len  Requested length. Length of the returned span.
+ *
+ * @return Pointer to the data at @p offset.
+ */
+void * nrf_memobj_span_get(nrf_memobj_t * p_obj,
+                           size_t         offset,
+                           size_t *       p_len);
+
+/**
+ * @brief Function for getting the data of the memory object as one contiguous block.
+ *
+ * If the requested data is stored in a single chunk, a pointer into the object is returned and
+ * nothing is copied. Otherwise, the data is gathered into @p p_buf. Either way, the result can be
+ * passed directly to a function that takes a flat buffer, which avoids copying the data to an
+ * intermediate buffer first.
+ *
+ * @param[in]     p_obj  Pointer to memory object.
+ * @param[in]     p_buf  Buffer of at least @p len bytes, used if the data is not contiguous.
+ * @param[in]     len    Amount of data.
+ * @param[in]     offset Offset.
+ *
+ * @return Pointer to @p len bytes of data, either into the object or @p p_buf.
+ */
+void const * nrf_memobj_gather(nrf_memobj_t * p_obj,
+                               void *         p_buf,
+                               size_t         len,
+                               size_t         offset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -54,6 +54,28 @@
 
 NRF_SECTION_DEF(nrf_queue, nrf_queue_t);
 
+/**@brief Macro for entering a critical region that guards the queue control block.
+ *
+ * @details Queues in @ref NRF_QUEUE_MODE_SPSC are not guarded. There, only the producer moves
+ *          the back index and only the consumer moves the front index.
+ */
+#define QUEUE_CRITICAL_REGION_ENTER(_p_queue)                                   \
+    {                                                                           \
+        uint8_t __QUEUE_CR_NESTED = 0;                                          \
+        bool    __QUEUE_CR_USED   = ((_p_queue)->mode != NRF_QUEUE_MODE_SPSC);  \
+        if (__QUEUE_CR_USED)                                                    \
+        {                                                                       \
+            app_util_critical_region_enter(&__QUEUE_CR_NESTED);                 \
+        }
+
+/**@brief Macro for leaving a critical region entered with @ref QUEUE_CRITICAL_REGION_ENTER. */
+#define QUEUE_CRITICAL_REGION_EXIT()                                            \
+        if (__QUEUE_CR_USED)                                                    \
+        {                                                                       \
+            app_util_critical_region_exit(__QUEUE_CR_NESTED);                   \
+        }                                                                       \
+    }
+
 #if NRF_QUEUE_CLI_CMDS && NRF_CLI_ENABLED
 #include "nrf_cli.h"
 
@@ -93,7 +115,8 @@ static void nrf_queue_status(nrf_cli_t const * p_cli, size_t argc, char **argv)
                         p_name, element_size,
                         100ul * util/size, util,size,
                         100ul * max_util/size, max_util,size,
-                        (p_instance->mode == NRF_QUEUE_MODE_OVERFLOW) ? "Overflow" : "No overflow");
+                        (p_instance->mode == NRF_QUEUE_MODE_OVERFLOW) ? "Overflow" :
+                        (p_instance->mode == NRF_QUEUE_MODE_SPSC) ? "SPSC" : "No overflow");
 
     }
 }
@@ -132,6 +155,37 @@ __STATIC_INLINE size_t nrf_queue_next_idx(nrf_queue_t const * p_queue, size_t id
     return (idx < p_queue->size) ? (idx + 1) : 0;
 }
 
+/**@brief Advance an element index by a number of elements.
+ *
+ * @param[in]   p_queue     Pointer to the queue instance.
+ * @param[in]   idx         Current index.
+ * @param[in]   count       Number of elements, not larger than the queue size.
+ *
+ * @return      Advanced element index.
+ */
+__STATIC_INLINE size_t queue_idx_advance(nrf_queue_t const * p_queue, size_t idx, size_t count)
+{
+    idx += count;
+
+    return (idx >= circullar_buffer_size_get(p_queue)) ? (idx - circullar_buffer_size_get(p_queue))
+                                                       : idx;
+}
+
+/**@brief Order the accesses to the elements before the update of the index that hands them over.
+ *
+ * @details In @ref NRF_QUEUE_MODE_SPSC, the index update is what hands the elements over to the
+ *          other side, so it must not be observed before the element data.
+ *
+ * @param[in]   p_queue     Pointer to the queue instance.
+ */
+__STATIC_INLINE void queue_publish_barrier(nrf_queue_t const * p_queue)
+{
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        __DMB();
+    }
+}
+
 /**@brief Get current queue utilization. This function assumes that this process will not be interrupted.
  *
  * @param[in]   p_queue     Pointer to the queue instance.
@@ -163,14 +217,13 @@ ret_code_t nrf_queue_push(nrf_queue_t const * p_queue, void const * p_element)
     ASSERT(p_queue != NULL);
     ASSERT(p_element != NULL);
 
-    CRITICAL_REGION_ENTER();
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
     bool is_full = nrf_queue_is_full(p_queue);
 
     if (!is_full || (p_queue->mode == NRF_QUEUE_MODE_OVERFLOW))
     {
         // Get write position.
         size_t write_pos = p_queue->p_cb->back;
-        p_queue->p_cb->back = nrf_queue_next_idx(p_queue, p_queue->p_cb->back);
         if (is_full)
         {
             // Overwrite the oldest element.
@@ -204,6 +257,10 @@ ret_code_t nrf_queue_push(nrf_queue_t const * p_queue, void const * p_element)
                 break;
         }
 
+        // Hand the element over to the reader.
+        queue_publish_barrier(p_queue);
+        p_queue->p_cb->back = nrf_queue_next_idx(p_queue, write_pos);
+
         // Update utilization.
         size_t utilization = queue_utilization_get(p_queue);
         if (p_queue->p_cb->max_utilization < utilization)
@@ -216,7 +273,7 @@ ret_code_t nrf_queue_push(nrf_queue_t const * p_queue, void const * p_element)
         status = NRF_ERROR_NO_MEM;
     }
 
-    CRITICAL_REGION_EXIT();
+    QUEUE_CRITICAL_REGION_EXIT();
 
     NRF_LOG_INST_DEBUG(p_queue->p_log, "pushed element 0x%08X, status:%d", p_element, status);
     return status;
@@ -231,19 +288,13 @@ ret_code_t nrf_queue_generic_pop(nrf_queue_t const * p_queue,
     ASSERT(p_queue      != NULL);
     ASSERT(p_element    != NULL);
 
-    CRITICAL_REGION_ENTER();
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
 
     if (!nrf_queue_is_empty(p_queue))
     {
         // Get read position.
         size_t read_pos = p_queue->p_cb->front;
 
-        // Update next read position.
-        if (!just_peek)
-        {
-            p_queue->p_cb->front = nrf_queue_next_idx(p_queue, p_queue->p_cb->front);
-        }
-
         // Read element.
         switch (p_queue->element_size)
         {
@@ -269,13 +320,20 @@ ret_code_t nrf_queue_generic_pop(nrf_queue_t const * p_queue,
                        p_queue->element_size);
                 break;
         }
+
+        // Update next read position.
+        if (!just_peek)
+        {
+            queue_publish_barrier(p_queue);
+            p_queue->p_cb->front = nrf_queue_next_idx(p_queue, read_pos);
+        }
     }
     else
     {
         status = NRF_ERROR_NOT_FOUND;
     }
 
-    CRITICAL_REGION_EXIT();
+    QUEUE_CRITICAL_REGION_EXIT();
     NRF_LOG_INST_DEBUG(p_queue->p_log, "%s element 0x%08X, status:%d",
                                          just_peek ? "peeked" : "popped", p_element, status);
     return status;
@@ -320,6 +378,7 @@ static void queue_write(nrf_queue_t const * p_queue, void const * p_data, uint32
                p_data,
                element_count * p_queue->element_size);
 
+        queue_publish_barrier(p_queue);
         p_queue->p_cb->back = ((p_queue->p_cb->back + element_count) <= p_queue->size)
                             ? (p_queue->p_cb->back + element_count)
                             : 0;
@@ -336,6 +395,7 @@ static void queue_write(nrf_queue_t const * p_queue, void const * p_data, uint32
                (void const *)((size_t)p_data + first_write_length),
                elements_left * p_queue->element_size);
 
+        queue_publish_barrier(p_queue);
         p_queue->p_cb->back = elements_left;
         if (prev_available < element_count)
         {
@@ -367,7 +427,7 @@ ret_code_t nrf_queue_write(nrf_queue_t const * p_queue,
         return NRF_SUCCESS;
     }
 
-    CRITICAL_REGION_ENTER();
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
 
     if ((nrf_queue_available_get(p_queue) >= element_count)
      || (p_queue->mode == NRF_QUEUE_MODE_OVERFLOW))
@@ -379,7 +439,7 @@ ret_code_t nrf_queue_write(nrf_queue_t const * p_queue,
         status = NRF_ERROR_NO_MEM;
     }
 
-    CRITICAL_REGION_EXIT();
+    QUEUE_CRITICAL_REGION_EXIT();
 
     NRF_LOG_INST_DEBUG(p_queue->p_log, "Write %d elements (start address: 0x%08X), status:%d",
                                        element_count, p_data, status);
@@ -401,7 +461,7 @@ size_t nrf_queue_in(nrf_queue_t const * p_queue,
         return 0;
     }
 
-    CRITICAL_REGION_ENTER();
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
 
     if (p_queue->mode == NRF_QUEUE_MODE_OVERFLOW)
     {
@@ -415,7 +475,7 @@ size_t nrf_queue_in(nrf_queue_t const * p_queue,
 
     queue_write(p_queue, p_data, element_count);
 
-    CRITICAL_REGION_EXIT();
+    QUEUE_CRITICAL_REGION_EXIT();
 
     NRF_LOG_INST_DEBUG(p_queue->p_log, "Put in %d elements (start address: 0x%08X), requested :%d",
                                        element_count, p_data, req_element_count);
@@ -443,6 +503,7 @@ static void queue_read(nrf_queue_t const * p_queue, void * p_data, uint32_t elem
                p_read_ptr,
                element_count * p_queue->element_size);
 
+        queue_publish_barrier(p_queue);
         p_queue->p_cb->front = ((front + element_count) <= p_queue->size)
                              ? (front + element_count)
                              : 0;
@@ -459,6 +520,7 @@ static void queue_read(nrf_queue_t const * p_queue, void * p_data, uint32_t elem
                p_queue->p_buffer,
                elements_left * p_queue->element_size);
 
+        queue_publish_barrier(p_queue);
         p_queue->p_cb->front = elements_left;
     }
 }
@@ -477,7 +539,7 @@ ret_code_t nrf_queue_read(nrf_queue_t const * p_queue,
         return NRF_SUCCESS;
     }
 
-    CRITICAL_REGION_ENTER();
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
 
     if (element_count <= queue_utilization_get(p_queue))
     {
@@ -488,7 +550,7 @@ ret_code_t nrf_queue_read(nrf_queue_t const * p_queue,
         status = NRF_ERROR_NOT_FOUND;
     }
 
-    CRITICAL_REGION_EXIT();
+    QUEUE_CRITICAL_REGION_EXIT();
 
     NRF_LOG_INST_DEBUG(p_queue->p_log, "Read %d elements (start address: 0x%08X), status :%d",
                                        element_count, p_data, status);
@@ -509,29 +571,162 @@ size_t nrf_queue_out(nrf_queue_t const * p_queue,
         return 0;
     }
 
-    CRITICAL_REGION_ENTER();
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
 
     size_t utilization = queue_utilization_get(p_queue);
     element_count      = MIN(element_count, utilization);
 
     queue_read(p_queue, p_data, element_count);
 
-    CRITICAL_REGION_EXIT();
+    QUEUE_CRITICAL_REGION_EXIT();
 
     NRF_LOG_INST_DEBUG(p_queue->p_log, "Out %d elements (start address: 0x%08X), requested :%d",
                                        element_count, p_data, req_element_count);
     return element_count;
 }
 
+/**@brief Get the number of contiguous free elements at the back of the queue.
+ *
+ * @param[in]   p_queue     Pointer to the queue instance.
+ *
+ * @return      Number of elements that can be written without wrapping.
+ */
+static size_t write_span_get(nrf_queue_t const * p_queue)
+{
+    size_t front    = p_queue->p_cb->front;
+    size_t back     = p_queue->p_cb->back;
+
+    if (back >= front)
+    {
+        // One element is always left free to distinguish a full queue from an empty one.
+        return circullar_buffer_size_get(p_queue) - back - ((front == 0) ? 1 : 0);
+    }
+    else
+    {
+        return front - back - 1;
+    }
+}
+
+void * nrf_queue_write_reserve(nrf_queue_t const * p_queue, size_t * p_count)
+{
+    void * p_span = NULL;
+
+    ASSERT(p_queue != NULL);
+    ASSERT(p_count != NULL);
+
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
+
+    *p_count = MIN(*p_count, write_span_get(p_queue));
+
+    if (*p_count > 0)
+    {
+        p_span = (void *)((size_t)p_queue->p_buffer + p_queue->p_cb->back * p_queue->element_size);
+    }
+
+    QUEUE_CRITICAL_REGION_EXIT();
+
+    return p_span;
+}
+
+ret_code_t nrf_queue_write_commit(nrf_queue_t const * p_queue, size_t element_count)
+{
+    ret_code_t status = NRF_SUCCESS;
+
+    ASSERT(p_queue != NULL);
+
+    if (element_count == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
+
+    if (element_count <= write_span_get(p_queue))
+    {
+        queue_publish_barrier(p_queue);
+        p_queue->p_cb->back = queue_idx_advance(p_queue, p_queue->p_cb->back, element_count);
+
+        // Update utilization.
+        size_t utilization = queue_utilization_get(p_queue);
+        if (p_queue->p_cb->max_utilization < utilization)
+        {
+            p_queue->p_cb->max_utilization = utilization;
+        }
+    }
+    else
+    {
+        status = NRF_ERROR_INVALID_LENGTH;
+    }
+
+    QUEUE_CRITICAL_REGION_EXIT();
+
+    NRF_LOG_INST_DEBUG(p_queue->p_log, "Commit %d elements, status:%d", element_count, status);
+    return status;
+}
+
+void const * nrf_queue_read_peek(nrf_queue_t const * p_queue, size_t * p_count)
+{
+    void const * p_span = NULL;
+
+    ASSERT(p_queue != NULL);
+    ASSERT(p_count != NULL);
+
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
+
+    size_t front = p_queue->p_cb->front;
+    size_t back  = p_queue->p_cb->back;
+
+    *p_count = MIN(*p_count, (back >= front) ? (back - front)
+                                             : (circullar_buffer_size_get(p_queue) - front));
+
+    if (*p_count > 0)
+    {
+        p_span = (void const *)((size_t)p_queue->p_buffer + front * p_queue->element_size);
+    }
+
+    QUEUE_CRITICAL_REGION_EXIT();
+
+    return p_span;
+}
+
+ret_code_t nrf_queue_read_consume(nrf_queue_t const * p_queue, size_t element_count)
+{
+    ret_code_t status = NRF_SUCCESS;
+
+    ASSERT(p_queue != NULL);
+
+    if (element_count == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
+
+    if (element_count <= queue_utilization_get(p_queue))
+    {
+        queue_publish_barrier(p_queue);
+        p_queue->p_cb->front = queue_idx_advance(p_queue, p_queue->p_cb->front, element_count);
+    }
+    else
+    {
+        status = NRF_ERROR_NOT_FOUND;
+    }
+
+    QUEUE_CRITICAL_REGION_EXIT();
+
+    NRF_LOG_INST_DEBUG(p_queue->p_log, "Consume %d elements, status:%d", element_count, status);
+    return status;
+}
+
 void nrf_queue_reset(nrf_queue_t const * p_queue)
 {
     ASSERT(p_queue != NULL);
 
-    CRITICAL_REGION_ENTER();
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
 
     memset(p_queue->p_cb, 0, sizeof(nrf_queue_cb_t));
 
-    CRITICAL_REGION_EXIT();
+    QUEUE_CRITICAL_REGION_EXIT();
 
     NRF_LOG_INST_DEBUG(p_queue->p_log, "Reset");
 }
@@ -541,11 +736,11 @@ size_t nrf_queue_utilization_get(nrf_queue_t const * p_queue)
     size_t utilization;
     ASSERT(p_queue != NULL);
 
-    CRITICAL_REGION_ENTER();
+    QUEUE_CRITICAL_REGION_ENTER(p_queue);
 
     utilization = queue_utilization_get(p_queue);
 
-    CRITICAL_REGION_EXIT();
+    QUEUE_CRITICAL_REGION_EXIT();
 
     return utilization;
 }
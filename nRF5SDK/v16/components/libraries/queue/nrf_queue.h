@@ -78,6 +78,7 @@ typedef enum
 {
     NRF_QUEUE_MODE_OVERFLOW,        //!< If the queue is full, new element will overwrite the oldest.
     NRF_QUEUE_MODE_NO_OVERFLOW,     //!< If the queue is full, new element will not be accepted.
+    NRF_QUEUE_MODE_SPSC,            //!< Lock-free mode for a single producer and a single consumer. New element will not be accepted if the queue is full.
 } nrf_queue_mode_t;
 
 /**@brief Instance of the queue. */
@@ -192,6 +193,10 @@ typedef struct
     size_t      _name##_utilization_get(void);              \
     size_t      _name##_available_get(void);                \
     size_t      _name##_max_utilization_get(void);          \
+    _type *     _name##_write_reserve(size_t * p_count);    \
+    ret_code_t  _name##_write_commit(size_t element_count); \
+    _type const * _name##_read_peek(size_t * p_count);      \
+    ret_code_t  _name##_read_consume(size_t element_count); \
     void        _name##_reset(void)
 
 /**@brief Define a queue interface.
@@ -308,6 +313,40 @@ typedef struct
         GCC_PRAGMA("GCC diagnostic pop")                                \
         return nrf_queue_max_utilization_get(_p_queue);                 \
     }                                                                   \
+    _type * _name##_write_reserve(size_t * p_count)                     \
+    {                                                                   \
+        GCC_PRAGMA("GCC diagnostic push")                               \
+        GCC_PRAGMA("GCC diagnostic ignored \"-Waddress\"")              \
+        ASSERT((_p_queue) != NULL);                                     \
+        ASSERT((_p_queue)->element_size == sizeof(_type));              \
+        GCC_PRAGMA("GCC diagnostic pop")                                \
+        return (_type *)nrf_queue_write_reserve((_p_queue), p_count);   \
+    }                                                                   \
+    ret_code_t _name##_write_commit(size_t element_count)               \
+    {                                                                   \
+        GCC_PRAGMA("GCC diagnostic push")                               \
+        GCC_PRAGMA("GCC diagnostic ignored \"-Waddress\"")              \
+        ASSERT((_p_queue) != NULL);                                     \
+        GCC_PRAGMA("GCC diagnostic pop")                                \
+        return nrf_queue_write_commit((_p_queue), element_count);       \
+    }                                                                   \
+    _type const * _name##_read_peek(size_t * p_count)                   \
+    {                                                                   \
+        GCC_PRAGMA("GCC diagnostic push")                               \
+        GCC_PRAGMA("GCC diagnostic ignored \"-Waddress\"")              \
+        ASSERT((_p_queue) != NULL);                                     \
+        ASSERT((_p_queue)->element_size == sizeof(_type));              \
+        GCC_PRAGMA("GCC diagnostic pop")                                \
+        return (_type const *)nrf_queue_read_peek((_p_queue), p_count); \
+    }                                                                   \
+    ret_code_t _name##_read_consume(size_t element_count)               \
+    {                                                                   \
+        GCC_PRAGMA("GCC diagnostic push")                               \
+        GCC_PRAGMA("GCC diagnostic ignored \"-Waddress\"")              \
+        ASSERT((_p_queue) != NULL);                                     \
+        GCC_PRAGMA("GCC diagnostic pop")                                \
+        return nrf_queue_read_consume((_p_queue), element_count);       \
+    }                                                                   \
     void _name##_reset(void)                                            \
     {                                                                   \
         GCC_PRAGMA("GCC diagnostic push")                               \
@@ -410,6 +449,63 @@ size_t nrf_queue_out(nrf_queue_t const * p_queue,
                     void               * p_data,
                     size_t               element_count);
 
+/**@brief Function for reserving contiguous space for writing elements in place.
+ *
+ * @details The returned span lies directly in the queue storage, so elements can be produced
+ *          into it (for example by DMA) without an intermediate copy. The elements are added
+ *          to the queue by @ref nrf_queue_write_commit. A span never wraps around the end of
+ *          the storage: when the free space wraps, commit the first span and reserve again to
+ *          get the rest. A reservation never overwrites elements, also in
+ *          @ref NRF_QUEUE_MODE_OVERFLOW.
+ *
+ * @note Only one context may hold a reservation on a queue at a time.
+ *
+ * @param[in]     p_queue   Pointer to the nrf_queue_t instance.
+ * @param[in,out] p_count   In: maximum number of elements to reserve.
+ *                          Out: number of contiguous elements that can be written.
+ *
+ * @return      Pointer to the first reserved element, or NULL if the queue is full.
+ */
+void * nrf_queue_write_reserve(nrf_queue_t const * p_queue, size_t * p_count);
+
+/**@brief Function for adding elements written in place to the queue.
+ *
+ * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
+ * @param[in]   element_count       Number of elements written to the span returned by
+ *                                  @ref nrf_queue_write_reserve.
+ *
+ * @return      NRF_SUCCESS                 If the elements were added.
+ * @return      NRF_ERROR_INVALID_LENGTH    If @p element_count exceeds the contiguous free space.
+ */
+ret_code_t nrf_queue_write_commit(nrf_queue_t const * p_queue, size_t element_count);
+
+/**@brief Function for getting contiguous elements from the front of the queue in place.
+ *
+ * @details The returned span lies directly in the queue storage and stays valid until the
+ *          elements are removed by @ref nrf_queue_read_consume. A span never wraps around the
+ *          end of the storage: consume the first span and peek again to get the rest.
+ *
+ * @note In @ref NRF_QUEUE_MODE_OVERFLOW, the elements may be overwritten by a writer while
+ *       they are being used.
+ *
+ * @param[in]     p_queue   Pointer to the nrf_queue_t instance.
+ * @param[in,out] p_count   In: maximum number of elements to get.
+ *                          Out: number of contiguous elements that can be read.
+ *
+ * @return      Pointer to the first element, or NULL if the queue is empty.
+ */
+void const * nrf_queue_read_peek(nrf_queue_t const * p_queue, size_t * p_count);
+
+/**@brief Function for removing elements from the front of the queue without copying them.
+ *
+ * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
+ * @param[in]   element_count       Number of elements to remove.
+ *
+ * @return      NRF_SUCCESS         If the elements were removed.
+ * @return      NRF_ERROR_NOT_FOUND There is not enough elements in the queue.
+ */
+ret_code_t nrf_queue_read_consume(nrf_queue_t const * p_queue, size_t element_count);
+
 /**@brief Function for checking if the queue is full.
  *
  * @param[in]   p_queue     Pointer to the queue instance.
@@ -458,6 +554,9 @@ size_t nrf_queue_max_utilization_get(nrf_queue_t const * p_queue);
 void nrf_queue_max_utilization_reset(nrf_queue_t const * p_queue);
 
 /**@brief Function for resetting the queue state.
+ *
+ * @note In @ref NRF_QUEUE_MODE_SPSC, neither the producer nor the consumer may use the queue
+ *       while it is being reset.
  *
  * @param[in]   p_queue     Pointer to the queue instance.
  */
@@ -44,6 +44,18 @@
 #define WR_OFFSET 0
 #define RD_OFFSET 1
 
+/* Multi-producer state: the reservation head (modulo 2^24) in the lower bits and the number of
+ * pending reservations in the upper bits. Keeping both in one word lets a producer tell, in the
+ * same atomic operation, that it committed the last pending reservation and how far the
+ * committed data reaches. */
+#define MP_HEAD_MASK        0x00FFFFFFUL
+#define MP_PENDING_POS      24
+#define MP_PENDING_ONE      (1UL << MP_PENDING_POS)
+#define MP_PENDING_MAX      (0xFFUL)
+
+#define MP_HEAD_GET(_state)     ((_state) & MP_HEAD_MASK)
+#define MP_PENDING_GET(_state)  ((_state) >> MP_PENDING_POS)
+
 void nrf_ringbuf_init(nrf_ringbuf_t const * p_ringbuf)
 {
     p_ringbuf->p_cb->wr_idx = 0;
@@ -52,6 +64,7 @@ void nrf_ringbuf_init(nrf_ringbuf_t const * p_ringbuf)
     p_ringbuf->p_cb->tmp_wr_idx = 0;
     p_ringbuf->p_cb->rd_flag   = 0;
     p_ringbuf->p_cb->wr_flag   = 0;
+    p_ringbuf->p_cb->mp_state  = 0;
 }
 
 ret_code_t nrf_ringbuf_alloc(nrf_ringbuf_t const * p_ringbuf, uint8_t * * pp_data, size_t * p_length, bool start)
@@ -235,3 +248,161 @@ ret_code_t nrf_ringbuf_free(nrf_ringbuf_t const * p_ringbuf, size_t length)
 
     return NRF_SUCCESS;
 }
+
+/**
+ * @brief Function for reserving space for one producer in the multi-producer mode.
+ *
+ * @param[in]      p_ringbuf   Pointer to the ring buffer instance.
+ * @param[out]     p_head      Reservation start (modulo 2^24).
+ * @param[in, out] p_length    Requested amount. Reserved amount.
+ * @param[in]      contiguous  True if the reservation must not wrap around the end of the buffer.
+ *                             Otherwise, the whole requested amount is reserved or nothing.
+ *
+ * @retval NRF_SUCCESS       Reservation made, or nothing reserved if @p p_length is set to 0.
+ * @retval NRF_ERROR_NO_MEM  Not enough free space for a reservation that may wrap.
+ * @retval NRF_ERROR_BUSY    Too many reservations are pending.
+ */
+static ret_code_t mp_reserve(nrf_ringbuf_t const * p_ringbuf,
+                             uint32_t            * p_head,
+                             size_t              * p_length,
+                             bool                  contiguous)
+{
+    uint32_t bufsize = p_ringbuf->bufsize_mask + 1;
+    uint32_t state   = p_ringbuf->p_cb->mp_state;
+    uint32_t new_state;
+    uint32_t length;
+
+    do
+    {
+        uint32_t head = MP_HEAD_GET(state);
+
+        if (MP_PENDING_GET(state) == MP_PENDING_MAX)
+        {
+            return NRF_ERROR_BUSY;
+        }
+
+        /* A stale read index only makes the free space look smaller. */
+        length = bufsize - ((head - p_ringbuf->p_cb->rd_idx) & MP_HEAD_MASK);
+        if (contiguous)
+        {
+            uint32_t trail = bufsize - (head & p_ringbuf->bufsize_mask);
+            length = MIN(length, trail);
+        }
+        else if (length < *p_length)
+        {
+            return NRF_ERROR_NO_MEM;
+        }
+        length = MIN(length, *p_length);
+
+        if (length == 0)
+        {
+            *p_length = 0;
+            return NRF_SUCCESS;
+        }
+
+        new_state = (MP_HEAD_GET(head + length)) | (state & ~MP_HEAD_MASK);
+        new_state += MP_PENDING_ONE;
+    } while (!nrf_atomic_u32_cmp_exch(&p_ringbuf->p_cb->mp_state, &state, new_state));
+
+    *p_head   = MP_HEAD_GET(state);
+    *p_length = length;
+
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Function for moving the consumer-visible write index forward to a committed head.
+ *
+ * Producers that commit the last pending reservation may publish out of order. The write index is
+ * only ever moved forward, so a producer that publishes a stale head does not hide data that a
+ * later producer has already published.
+ *
+ * @param[in] p_ringbuf  Pointer to the ring buffer instance.
+ * @param[in] head       Committed head (modulo 2^24).
+ */
+static void mp_publish(nrf_ringbuf_t const * p_ringbuf, uint32_t head)
+{
+    nrf_atomic_u32_t * p_wr_idx = (nrf_atomic_u32_t *)&p_ringbuf->p_cb->wr_idx;
+    uint32_t           wr_idx   = *p_wr_idx;
+    uint32_t           delta;
+
+    do
+    {
+        delta = (head - wr_idx) & MP_HEAD_MASK;
+        if ((delta == 0) || (delta > p_ringbuf->bufsize_mask + 1))
+        {
+            /* Already published, or overtaken by a later commit. */
+            return;
+        }
+    } while (!nrf_atomic_u32_cmp_exch(p_wr_idx, &wr_idx, wr_idx + delta));
+}
+
+ret_code_t nrf_ringbuf_mp_alloc(nrf_ringbuf_t const * p_ringbuf, uint8_t * * pp_data, size_t * p_length)
+{
+    ASSERT(pp_data);
+    ASSERT(p_length);
+
+    uint32_t   head;
+    ret_code_t err_code = mp_reserve(p_ringbuf, &head, p_length, true);
+
+    if ((err_code == NRF_SUCCESS) && (*p_length > 0))
+    {
+        *pp_data = &p_ringbuf->p_buffer[head & p_ringbuf->bufsize_mask];
+    }
+
+    return err_code;
+}
+
+ret_code_t nrf_ringbuf_mp_put(nrf_ringbuf_t const * p_ringbuf)
+{
+    uint32_t state = p_ringbuf->p_cb->mp_state;
+
+    /* Data written to the reservation must be visible before the commit is. */
+    __DMB();
+
+    do
+    {
+        if (MP_PENDING_GET(state) == 0)
+        {
+            /* Nothing to commit. Suggests misuse. */
+            return NRF_ERROR_INVALID_STATE;
+        }
+    } while (!nrf_atomic_u32_cmp_exch(&p_ringbuf->p_cb->mp_state, &state, state - MP_PENDING_ONE));
+
+    if (MP_PENDING_GET(state) == 1)
+    {
+        /* All reservations up to the head in this state are filled. */
+        mp_publish(p_ringbuf, MP_HEAD_GET(state));
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_ringbuf_mp_cpy_put(nrf_ringbuf_t const * p_ringbuf,
+                                  uint8_t const * p_data,
+                                  size_t length)
+{
+    ASSERT(p_data);
+
+    uint32_t   head;
+    ret_code_t err_code = mp_reserve(p_ringbuf, &head, &length, false);
+
+    if ((err_code != NRF_SUCCESS) || (length == 0))
+    {
+        return err_code;
+    }
+
+    uint32_t masked_wr_idx = head & p_ringbuf->bufsize_mask;
+    uint32_t trail         = p_ringbuf->bufsize_mask + 1 - masked_wr_idx;
+
+    if (length > trail)
+    {
+        memcpy(&p_ringbuf->p_buffer[masked_wr_idx], p_data, trail);
+        length -= trail;
+        masked_wr_idx = 0;
+        p_data += trail;
+    }
+    memcpy(&p_ringbuf->p_buffer[masked_wr_idx], p_data, length);
+
+    return nrf_ringbuf_mp_put(p_ringbuf);
+}
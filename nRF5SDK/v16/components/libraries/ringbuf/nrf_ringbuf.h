@@ -65,6 +65,7 @@ typedef struct
     uint32_t            tmp_wr_idx; //!< Temporary write index (updated when allocating).
     uint32_t            rd_idx;     //!< Read index (updated when freeing).
     uint32_t            tmp_rd_idx; //!< Temporary read index (updated when getting).
+    nrf_atomic_u32_t    mp_state;   //!< Multi-producer reservation state (see @ref nrf_ringbuf_mp_alloc).
 } nrf_ringbuf_cb_t;
 
 /**
@@ -77,6 +78,13 @@ typedef struct
     nrf_ringbuf_cb_t  * p_cb;         //!< Pointer to the instance control block.
 } nrf_ringbuf_t;
 
+/**
+ * @brief Maximum size of a ring buffer that is used with the multi-producer functions.
+ *
+ * The reservation head shares a 32-bit word with the number of pending reservations.
+ */
+#define NRF_RINGBUF_MP_MAX_SIZE  (1UL << 23)
+
 /**
  * @brief Macro for defining a ring buffer instance.
  *
@@ -85,6 +93,7 @@ typedef struct
  * */
 #define NRF_RINGBUF_DEF(_name, _size)                                         \
     STATIC_ASSERT(IS_POWER_OF_TWO(_size));                                    \
+    STATIC_ASSERT((_size) <= NRF_RINGBUF_MP_MAX_SIZE);                        \
     static uint8_t CONCAT_2(_name,_buf)[_size];                               \
     static nrf_ringbuf_cb_t CONCAT_2(_name,_cb);                              \
     static const nrf_ringbuf_t _name = {                                      \
@@ -150,6 +159,63 @@ ret_code_t nrf_ringbuf_cpy_put(nrf_ringbuf_t const * p_ringbuf,
                                uint8_t const* p_data,
                                size_t * p_length);
 
+/**
+ * @brief Function for allocating memory from a ring buffer that is shared by multiple producers.
+ *
+ * Unlike @ref nrf_ringbuf_alloc, this function does not establish exclusive access. Producers
+ * running in different contexts (for example, interrupts of different priorities) can hold
+ * reservations at the same time. Each reservation must be completely filled and committed with
+ * @ref nrf_ringbuf_mp_put. Reservations become visible to @ref nrf_ringbuf_get and
+ * @ref nrf_ringbuf_cpy_get in allocation order, once all overlapping reservations are committed,
+ * so the consumer always sees contiguous, fully written data.
+ *
+ * The multi-producer functions must not be mixed with @ref nrf_ringbuf_alloc,
+ * @ref nrf_ringbuf_put and @ref nrf_ringbuf_cpy_put on the same instance. The consumer side is
+ * unchanged.
+ *
+ * @param[in] p_ringbuf      Pointer to the ring buffer instance.
+ * @param[in] pp_data        Pointer to the pointer to the allocated buffer.
+ * @param[in, out] p_length  Pointer to length. Length is set to the requested amount and filled
+ *                           by the function with the actually allocated amount. It is set to 0
+ *                           if the ring buffer is full, in which case nothing must be committed.
+ *
+ * @retval NRF_SUCCESS       Successful allocation (can be smaller amount than requested).
+ * @retval NRF_ERROR_BUSY    Too many reservations are pending.
+ */
+ret_code_t nrf_ringbuf_mp_alloc(nrf_ringbuf_t const * p_ringbuf, uint8_t * * pp_data, size_t * p_length);
+
+/**
+ * @brief Function for committing a reservation made with @ref nrf_ringbuf_mp_alloc.
+ *
+ * The last pending reservation to be committed publishes all reservations made so far to the
+ * consumer.
+ *
+ * @param[in] p_ringbuf          Pointer to the ring buffer instance.
+ *
+ * @retval NRF_SUCCESS              Successful commit.
+ * @retval NRF_ERROR_INVALID_STATE  No reservation is pending.
+ */
+ret_code_t nrf_ringbuf_mp_put(nrf_ringbuf_t const * p_ringbuf);
+
+/**
+ * @brief Function for copying data into a ring buffer that is shared by multiple producers.
+ *
+ * The data is reserved as one block that may wrap around the end of the buffer. Unlike
+ * @ref nrf_ringbuf_cpy_put, the data is copied completely or not at all, so records written by
+ * different producers are never cut or interleaved.
+ *
+ * @param[in] p_ringbuf       Pointer to the ring buffer instance.
+ * @param[in] p_data          Pointer to the input buffer.
+ * @param[in] length          Amount of bytes to copy.
+ *
+ * @retval NRF_SUCCESS       Successful copy.
+ * @retval NRF_ERROR_NO_MEM  Not enough free space. Nothing was copied.
+ * @retval NRF_ERROR_BUSY    Too many reservations are pending.
+ */
+ret_code_t nrf_ringbuf_mp_cpy_put(nrf_ringbuf_t const * p_ringbuf,
+                                  uint8_t const * p_data,
+                                  size_t length);
+
 
 /**
  * Function for getting data from the ring buffer.
@@ -0,0 +1,307 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NRF_SAMPLE_LOG)
+#include "nrf_sample_log.h"
+#include "nrf_atomic.h"
+#include "app_timer.h"
+
+#if !_USE_EXPAND || _FS_TINY
+#error "nrf_sample_log requires FatFS with _USE_EXPAND enabled and _FS_TINY disabled."
+#endif
+
+#define TICKS_TO_US(ticks)                                                          \
+        (((uint64_t)(ticks) * 1000000uLL * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)) /  \
+         APP_TIMER_CLOCK_FREQ)
+
+static uint32_t ring_fill(nrf_sample_log_t const * p_log)
+{
+    return p_log->p_ringbuf->p_cb->wr_idx - p_log->p_ringbuf->p_cb->rd_idx;
+}
+
+/**
+ * @brief Function for writing data to the file and recording the time it took.
+ *
+ * If the data is not written completely, the file position is moved back to where the write
+ * started. The caller keeps the data in the ring buffer, and the next attempt writes it to the
+ * same position, so a partially written prefix is not stored twice.
+ */
+static ret_code_t file_write(nrf_sample_log_t const * p_log, uint8_t const * p_data, uint32_t size)
+{
+    nrf_sample_log_cb_t * p_cb = p_log->p_cb;
+    UINT                  written;
+
+    uint32_t start = app_timer_cnt_get();
+    FRESULT  fr    = f_write(&p_cb->file, p_data, size, &written);
+    uint32_t ticks = app_timer_cnt_diff_compute(app_timer_cnt_get(), start);
+    uint32_t us    = (uint32_t)TICKS_TO_US(ticks);
+
+    if ((fr != FR_OK) || (written != size))
+    {
+        /* A short write (for example, the volume is full) returns FR_OK. */
+        if (written > 0)
+        {
+            UNUSED_RETURN_VALUE(f_lseek(&p_cb->file, f_tell(&p_cb->file) - written));
+        }
+        return NRF_ERROR_INTERNAL;
+    }
+
+    p_cb->busy_ticks          += ticks;
+    p_cb->stats.busy_us        = TICKS_TO_US(p_cb->busy_ticks);
+    p_cb->stats.bytes_written += size;
+    p_cb->stats.write_us_max   = MAX(p_cb->stats.write_us_max, us);
+    p_cb->unsynced            += size;
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t file_sync(nrf_sample_log_t const * p_log)
+{
+    nrf_sample_log_cb_t * p_cb = p_log->p_cb;
+
+    uint32_t start = app_timer_cnt_get();
+    FRESULT  fr    = f_sync(&p_cb->file);
+    uint32_t ticks = app_timer_cnt_diff_compute(app_timer_cnt_get(), start);
+    uint32_t us    = (uint32_t)TICKS_TO_US(ticks);
+
+    if (fr != FR_OK)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    p_cb->busy_ticks       += ticks;
+    p_cb->stats.busy_us     = TICKS_TO_US(p_cb->busy_ticks);
+    p_cb->stats.syncs++;
+    p_cb->stats.sync_us_max = MAX(p_cb->stats.sync_us_max, us);
+    p_cb->since_sync        = 0;
+    p_cb->unsynced          = 0;
+
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Function for updating the time since the file was opened and since the last
+ *        synchronization.
+ */
+static void time_update(nrf_sample_log_t const * p_log)
+{
+    nrf_sample_log_cb_t * p_cb = p_log->p_cb;
+
+    uint32_t now   = app_timer_cnt_get();
+    uint32_t ticks = app_timer_cnt_diff_compute(now, p_cb->last_ticks);
+
+    p_cb->last_ticks        = now;
+    p_cb->elapsed_ticks    += ticks;
+    p_cb->stats.elapsed_us  = TICKS_TO_US(p_cb->elapsed_ticks);
+
+    /* The synchronization interval starts when data is written after the last one. */
+    p_cb->since_sync = (p_cb->unsynced > 0) ? (p_cb->since_sync + ticks) : 0;
+}
+
+ret_code_t nrf_sample_log_open(nrf_sample_log_t const * p_log,
+                               TCHAR const *            p_path,
+                               uint32_t                 prealloc_size,
+                               uint32_t                 sync_interval_ms)
+{
+    ASSERT(p_log);
+    ASSERT(p_path);
+    nrf_sample_log_cb_t * p_cb = p_log->p_cb;
+    FRESULT               fr;
+
+    VERIFY_FALSE(p_cb->open, NRF_ERROR_INVALID_STATE);
+
+    memset(p_cb, 0, sizeof(nrf_sample_log_cb_t));
+
+    fr = f_open(&p_cb->file, p_path, FA_CREATE_ALWAYS | FA_WRITE);
+    if (fr != FR_OK)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    if (prealloc_size > 0)
+    {
+        /* Allocate a contiguous cluster chain now, so that no FAT lookups or updates are needed
+         * while recording. */
+        fr = f_expand(&p_cb->file, prealloc_size, 1);
+        if (fr != FR_OK)
+        {
+            (void)f_close(&p_cb->file);
+            return (fr == FR_DENIED) ? NRF_ERROR_NO_MEM : NRF_ERROR_INTERNAL;
+        }
+
+        /* Store the allocation in the directory entry. */
+        fr = f_sync(&p_cb->file);
+        if (fr != FR_OK)
+        {
+            (void)f_close(&p_cb->file);
+            return NRF_ERROR_INTERNAL;
+        }
+    }
+
+    nrf_ringbuf_init(p_log->p_ringbuf);
+
+    p_cb->sync_ticks = APP_TIMER_TICKS(sync_interval_ms);
+    p_cb->last_ticks = app_timer_cnt_get();
+    p_cb->open       = true;
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sample_log_write(nrf_sample_log_t const * p_log, void const * p_data, size_t size)
+{
+    ASSERT(p_log);
+    nrf_sample_log_cb_t * p_cb = p_log->p_cb;
+
+    ret_code_t ret = nrf_ringbuf_mp_cpy_put(p_log->p_ringbuf, p_data, size);
+    if (ret != NRF_SUCCESS)
+    {
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&p_cb->stats.dropped, (uint32_t)size));
+        return NRF_ERROR_NO_MEM;
+    }
+
+    /* Writers of different priorities may race here, so the maximum is only raised with a
+     * compare-and-exchange. */
+    uint32_t fill = ring_fill(p_log);
+    uint32_t max  = p_cb->stats.ring_max;
+    while ((fill > max) && !nrf_atomic_u32_cmp_exch(&p_cb->stats.ring_max, &max, fill))
+    {
+        // Retry with the value stored by the preempting context.
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sample_log_process(nrf_sample_log_t const * p_log)
+{
+    ASSERT(p_log);
+    nrf_sample_log_cb_t * p_cb = p_log->p_cb;
+    ret_code_t            ret;
+
+    VERIFY_TRUE(p_cb->open, NRF_ERROR_INVALID_STATE);
+
+    time_update(p_log);
+
+    for (;;)
+    {
+        uint8_t * p_data;
+        size_t    length = p_log->burst_size;
+
+        /* The read index always advances by whole bursts and the buffer size is a multiple
+         * of the burst size, so a burst is never split by the end of the buffer. */
+        ret = nrf_ringbuf_get(p_log->p_ringbuf, &p_data, &length, true);
+        if (ret != NRF_SUCCESS)
+        {
+            return ret;
+        }
+
+        if (length < p_log->burst_size)
+        {
+            UNUSED_RETURN_VALUE(nrf_ringbuf_free(p_log->p_ringbuf, 0));
+            break;
+        }
+
+        ret = file_write(p_log, p_data, length);
+        if (ret != NRF_SUCCESS)
+        {
+            UNUSED_RETURN_VALUE(nrf_ringbuf_free(p_log->p_ringbuf, 0));
+            return ret;
+        }
+
+        p_cb->stats.bursts++;
+        UNUSED_RETURN_VALUE(nrf_ringbuf_free(p_log->p_ringbuf, length));
+    }
+
+    if ((p_cb->unsynced > 0) && (p_cb->since_sync >= p_cb->sync_ticks))
+    {
+        return file_sync(p_log);
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_sample_log_close(nrf_sample_log_t const * p_log)
+{
+    ASSERT(p_log);
+    nrf_sample_log_cb_t * p_cb = p_log->p_cb;
+    ret_code_t            ret;
+
+    VERIFY_TRUE(p_cb->open, NRF_ERROR_INVALID_STATE);
+
+    ret = nrf_sample_log_process(p_log);
+    VERIFY_SUCCESS(ret);
+
+    /* Write the incomplete burst left in the ring buffer. It may wrap around the end. */
+    for (;;)
+    {
+        uint8_t * p_data;
+        size_t    length = p_log->burst_size;
+
+        ret = nrf_ringbuf_get(p_log->p_ringbuf, &p_data, &length, true);
+        VERIFY_SUCCESS(ret);
+
+        if (length == 0)
+        {
+            break;
+        }
+
+        ret = file_write(p_log, p_data, length);
+        UNUSED_RETURN_VALUE(nrf_ringbuf_free(p_log->p_ringbuf, (ret == NRF_SUCCESS) ? length : 0));
+        VERIFY_SUCCESS(ret);
+    }
+
+    /* Release the preallocated space that was not used. */
+    if ((f_truncate(&p_cb->file) != FR_OK) || (f_close(&p_cb->file) != FR_OK))
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    time_update(p_log);
+    p_cb->open = false;
+
+    return NRF_SUCCESS;
+}
+
+nrf_sample_log_stats_t const * nrf_sample_log_stats_get(nrf_sample_log_t const * p_log)
+{
+    ASSERT(p_log);
+    return &p_log->p_cb->stats;
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_SAMPLE_LOG)
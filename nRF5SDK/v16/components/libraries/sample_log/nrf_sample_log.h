@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef NRF_SAMPLE_LOG_H__
+#define NRF_SAMPLE_LOG_H__
+
+/**
+ * @defgroup nrf_sample_log Sample logger for FatFS
+ * @{
+ * @ingroup app_common
+ * @brief Module for recording streams of samples (for example from SAADC) to a FatFS file.
+ *
+ * @details Writing each sample with f_write is slow: every call that does not fill a sector
+ *          goes through the FatFS sector window, and every cluster boundary requires a FAT
+ *          lookup and update. This module instead:
+ *          - Preallocates the file as one contiguous cluster chain using f_expand, so that no
+ *            FAT updates are needed while recording.
+ *          - Collects the samples in a ring buffer. Producers (also interrupt handlers) only
+ *            copy the data using @ref nrf_sample_log_write.
+ *          - Writes the data from @ref nrf_sample_log_process in bursts of a fixed number of
+ *            sectors. The bursts are sector aligned in the file, so FatFS passes them directly
+ *            to the disk as multi-sector writes, without copying.
+ *          - Synchronizes the file (f_sync) when the configured time has passed since the last
+ *            synchronization. This limits the amount of data lost on power failure, without
+ *            updating the directory entry after every burst.
+ *
+ *          Until @ref nrf_sample_log_close is called, the file size recorded on the disk is the
+ *          preallocated size. The data after the last synchronized burst is undefined.
+ *
+ * @note    FatFS must be built with _USE_EXPAND enabled and _FS_TINY disabled.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sdk_errors.h"
+#include "app_util.h"
+#include "nrf_ringbuf.h"
+#include "ff.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sample logger statistics.
+ *
+ * Times are measured with the app_timer counter. The sustained recording throughput is
+ * bytes_written / elapsed_us and the throughput of the storage is bytes_written / busy_us
+ * (both in MB/s).
+ */
+typedef struct
+{
+    uint32_t bytes_written;     //!< Bytes written to the file.
+    uint32_t bursts;            //!< Number of burst writes.
+    uint32_t syncs;             //!< Number of file synchronizations.
+    uint32_t dropped;           //!< Bytes dropped because the ring buffer was full.
+    uint32_t ring_max;          //!< Maximum ring buffer fill level, in bytes.
+    uint32_t write_us_max;      //!< Worst-case duration of a burst write, in microseconds.
+    uint32_t sync_us_max;       //!< Worst-case duration of a file synchronization, in microseconds.
+    uint64_t busy_us;           //!< Total time spent writing and synchronizing, in microseconds.
+    uint64_t elapsed_us;        //!< Time since the file was opened, in microseconds.
+} nrf_sample_log_stats_t;
+
+/**
+ * @brief Sample logger control block.
+ */
+typedef struct
+{
+    FIL                    file;            //!< Log file.
+    bool                   open;            //!< True if the file is open.
+    uint32_t               sync_ticks;      //!< Synchronization interval, in app_timer ticks.
+    uint32_t               last_ticks;      //!< app_timer counter at the last processing.
+    uint32_t               since_sync;      //!< Ticks since the last synchronization.
+    uint32_t               unsynced;        //!< Bytes written since the last synchronization.
+    uint64_t               elapsed_ticks;   //!< Ticks since the file was opened.
+    uint64_t               busy_ticks;      //!< Ticks spent writing and synchronizing.
+    nrf_sample_log_stats_t stats;           //!< Statistics.
+} nrf_sample_log_cb_t;
+
+/**
+ * @brief Sample logger instance.
+ */
+typedef struct
+{
+    nrf_ringbuf_t const * p_ringbuf;    //!< Ring buffer holding the samples.
+    uint32_t              burst_size;   //!< Size of a burst write, in bytes.
+    nrf_sample_log_cb_t * p_cb;         //!< Control block.
+} nrf_sample_log_t;
+
+/**
+ * @brief Macro for defining a sample logger instance.
+ *
+ * @param _name       Instance name.
+ * @param _ring_size  Size of the ring buffer, in bytes (must be a power of 2, and at least two
+ *                    bursts, so that samples can be added while a burst is written).
+ *                    On top of one burst, it must hold the samples produced during the
+ *                    longest write stall of the card, which can take tens of milliseconds.
+ * @param _burst_size Size of a burst write, in bytes (must be a multiple of the sector size).
+ *                    Using the cluster size of the volume gives one disk write per burst.
+ */
+#define NRF_SAMPLE_LOG_DEF(_name, _ring_size, _burst_size)                    \
+    STATIC_ASSERT(((_burst_size) % _MAX_SS) == 0);                            \
+    STATIC_ASSERT((_ring_size) >= 2 * (_burst_size));                         \
+    STATIC_ASSERT(((_ring_size) % (_burst_size)) == 0);                       \
+    NRF_RINGBUF_DEF(CONCAT_2(_name, _ringbuf), _ring_size);                   \
+    static nrf_sample_log_cb_t CONCAT_2(_name, _cb);                          \
+    static const nrf_sample_log_t _name = {                                   \
+            .p_ringbuf  = &CONCAT_2(_name, _ringbuf),                         \
+            .burst_size = (_burst_size),                                      \
+            .p_cb       = &CONCAT_2(_name, _cb),                              \
+    }
+
+/**
+ * @brief Function for creating the log file and starting recording.
+ *
+ * An existing file is overwritten. The ring buffer is emptied and the statistics are cleared.
+ *
+ * @param[in] p_log             Pointer to the sample logger instance.
+ * @param[in] p_path            Path of the log file. The volume must be mounted.
+ * @param[in] prealloc_size     Number of bytes to allocate contiguously. 0 disables
+ *                              preallocation. Recording may continue past this size, with
+ *                              clusters allocated by FatFS as needed.
+ * @param[in] sync_interval_ms  Maximum time between file synchronizations, in milliseconds.
+ *
+ * @retval NRF_SUCCESS              The file was created.
+ * @retval NRF_ERROR_INVALID_STATE  A file is already open.
+ * @retval NRF_ERROR_NO_MEM         There is no contiguous free area of prealloc_size bytes.
+ * @retval NRF_ERROR_INTERNAL       A FatFS operation failed.
+ */
+ret_code_t nrf_sample_log_open(nrf_sample_log_t const * p_log,
+                               TCHAR const *            p_path,
+                               uint32_t                 prealloc_size,
+                               uint32_t                 sync_interval_ms);
+
+/**
+ * @brief Function for adding samples to the log.
+ *
+ * The data is copied to the ring buffer completely or not at all. This function can be called
+ * from interrupt handlers of any priority.
+ *
+ * @param[in] p_log     Pointer to the sample logger instance.
+ * @param[in] p_data    Pointer to the data.
+ * @param[in] size      Size of the data, in bytes.
+ *
+ * @retval NRF_SUCCESS       The data was added.
+ * @retval NRF_ERROR_NO_MEM  The ring buffer is full. The data was dropped.
+ */
+ret_code_t nrf_sample_log_write(nrf_sample_log_t const * p_log, void const * p_data, size_t size);
+
+/**
+ * @brief Function for writing the collected samples to the file.
+ *
+ * Writes all complete bursts from the ring buffer and synchronizes the file if the
+ * synchronization interval has passed. Call this function from the main loop (for example
+ * through the scheduler), often enough for the ring buffer not to overflow.
+ *
+ * @param[in] p_log     Pointer to the sample logger instance.
+ *
+ * @retval NRF_SUCCESS              The data was processed.
+ * @retval NRF_ERROR_INVALID_STATE  No file is open.
+ * @retval NRF_ERROR_INTERNAL       A FatFS operation failed. The burst stays in the ring buffer
+ *                                  and the file position is restored to its start, so the call
+ *                                  can be repeated, for example after freeing space on the volume.
+ */
+ret_code_t nrf_sample_log_process(nrf_sample_log_t const * p_log);
+
+/**
+ * @brief Function for stopping recording and closing the log file.
+ *
+ * Writes the remaining samples, truncates the unused preallocated space and closes the file.
+ *
+ * @param[in] p_log     Pointer to the sample logger instance.
+ *
+ * @retval NRF_SUCCESS              The file was closed.
+ * @retval NRF_ERROR_INVALID_STATE  No file is open.
+ * @retval NRF_ERROR_INTERNAL       A FatFS operation failed.
+ */
+ret_code_t nrf_sample_log_close(nrf_sample_log_t const * p_log);
+
+/**
+ * @brief Function for getting the statistics of the sample logger.
+ *
+ * @param[in] p_log     Pointer to the sample logger instance.
+ *
+ * @return Pointer to the statistics.
+ */
+nrf_sample_log_stats_t const * nrf_sample_log_stats_get(nrf_sample_log_t const * p_log);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_SAMPLE_LOG_H__
@@ -38,6 +38,7 @@
  *
  */
 #include <stdlib.h>
+#include <string.h>
 #include "sha256.h"
 #include "sdk_errors.h"
 #include "sdk_common.h"
@@ -140,11 +141,24 @@ ret_code_t sha256_update(sha256_context_t *ctx, const uint8_t * data, size_t len
         return NRF_ERROR_NULL;
     }
 
-    uint32_t i;
+    size_t chunk;
+
+    while (len > 0) {
+        if ((ctx->datalen == 0) && (len >= 64)) {
+            // Hash whole blocks in place, without copying them to the buffer.
+            sha256_transform(ctx, data);
+            ctx->bitlen += 512;
+            data += 64;
+            len -= 64;
+            continue;
+        }
+
+        chunk = MIN(len, 64 - ctx->datalen);
+        memcpy(&ctx->data[ctx->datalen], data, chunk);
+        ctx->datalen += chunk;
+        data += chunk;
+        len -= chunk;
 
-    for (i = 0; i < len; ++i) {
-        ctx->data[ctx->datalen] = data[i];
-        ctx->datalen++;
         if (ctx->datalen == 64) {
             sha256_transform(ctx, ctx->data);
             ctx->bitlen += 512;
@@ -0,0 +1,334 @@
+/**
+ * Copyright (c) 2016 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NRF_SLAB)
+
+#include "nrf_slab.h"
+#include "nrf_assert.h"
+
+/**@brief Function for updating a high-water mark.
+ *
+ * @param[in] p_max  Pointer to the high-water mark.
+ * @param[in] value  New value.
+ */
+static void stat_max_update(nrf_atomic_u32_t * p_max, uint32_t value)
+{
+    uint32_t old_value = *p_max;
+
+    while ((old_value < value) && !nrf_atomic_u32_cmp_exch(p_max, &old_value, value))
+    {
+        // Retry with the value stored by the preempting context.
+    }
+}
+
+/**@brief Function for getting the number of blocks in a pool. */
+__STATIC_INLINE uint32_t pool_size_get(nrf_balloc_t const * p_pool)
+{
+    return (uint32_t)(p_pool->p_stack_limit - p_pool->p_stack_base);
+}
+
+/**@brief Function for finding the class that owns a block.
+ *
+ * @return Class index, or class count if the block does not belong to any pool.
+ */
+static uint8_t class_find(nrf_slab_t const * p_slab, void const * p_element)
+{
+    for (uint8_t i = 0; i < p_slab->class_count; i++)
+    {
+        nrf_balloc_t const * p_pool  = p_slab->pp_pools[i];
+        uint8_t const      * p_begin = (uint8_t const *)p_pool->p_memory_begin;
+
+        if (((uint8_t const *)p_element >= p_begin) &&
+            ((uint8_t const *)p_element <  p_begin + p_pool->block_size * pool_size_get(p_pool)))
+        {
+            return i;
+        }
+    }
+
+    return p_slab->class_count;
+}
+
+#if NRF_SLAB_MAGAZINE_SIZE
+/**@brief Function for getting the magazine level of the current execution priority.
+ *
+ * @return Level, or @ref NRF_SLAB_PRIO_LEVELS if the current priority has no magazines.
+ */
+static uint8_t magazine_level_get(void)
+{
+    uint8_t prio = current_int_priority_get();
+
+    if (prio == APP_IRQ_PRIORITY_THREAD)
+    {
+        return NRF_SLAB_PRIO_LEVELS - 1;
+    }
+
+    return (prio <= APP_IRQ_PRIORITY_LOWEST) ? prio : NRF_SLAB_PRIO_LEVELS;
+}
+
+/**@brief Function for taking a block from a magazine.
+ *
+ * @return Block, or NULL if the magazine is empty.
+ */
+static void * magazine_take(nrf_slab_t const * p_slab, uint8_t class_idx, uint8_t level)
+{
+    nrf_slab_magazine_t * p_magazine = &p_slab->p_magazines[level * p_slab->class_count + class_idx];
+
+    for (uint8_t i = 0; i < NRF_SLAB_MAGAZINE_SIZE; i++)
+    {
+        // Slots of the own level are only contended by steals, so check before exchanging.
+        if (p_magazine->slots[i] != 0)
+        {
+            uint32_t slot = nrf_atomic_u32_fetch_store(&p_magazine->slots[i], 0);
+
+            if (slot != 0)
+            {
+                return (uint8_t *)p_slab->pp_pools[class_idx]->p_memory_begin + (slot - 1);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**@brief Function for putting a block into a magazine.
+ *
+ * @retval true   Block cached.
+ * @retval false  Magazine full.
+ */
+static bool magazine_put(nrf_slab_t const * p_slab, uint8_t class_idx, uint8_t level, void * p_element)
+{
+    nrf_slab_magazine_t * p_magazine = &p_slab->p_magazines[level * p_slab->class_count + class_idx];
+    uint32_t              slot       = (uint32_t)((uint8_t *)p_element -
+                                       (uint8_t *)p_slab->pp_pools[class_idx]->p_memory_begin) + 1;
+
+    for (uint8_t i = 0; i < NRF_SLAB_MAGAZINE_SIZE; i++)
+    {
+        uint32_t empty = 0;
+
+        if ((p_magazine->slots[i] == 0) &&
+            nrf_atomic_u32_cmp_exch(&p_magazine->slots[i], &empty, slot))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif // NRF_SLAB_MAGAZINE_SIZE
+
+/**@brief Function for taking a block from a class.
+ *
+ * @return Block, or NULL if the class is exhausted.
+ */
+static void * class_alloc(nrf_slab_t const * p_slab, uint8_t class_idx)
+{
+    void * p_element;
+
+#if NRF_SLAB_MAGAZINE_SIZE
+    uint8_t level = magazine_level_get();
+
+    if (level < NRF_SLAB_PRIO_LEVELS)
+    {
+        p_element = magazine_take(p_slab, class_idx, level);
+        if (p_element != NULL)
+        {
+            return p_element;
+        }
+    }
+#endif
+
+    p_element = nrf_balloc_alloc(p_slab->pp_pools[class_idx]);
+
+#if NRF_SLAB_MAGAZINE_SIZE
+    // The pool is exhausted. Take back blocks cached by other priorities.
+    for (uint8_t i = 0; (p_element == NULL) && (i < NRF_SLAB_PRIO_LEVELS); i++)
+    {
+        if (i != level)
+        {
+            p_element = magazine_take(p_slab, class_idx, i);
+        }
+    }
+#endif
+
+    return p_element;
+}
+
+/**@brief Function for giving a block back to its class. */
+static void class_free(nrf_slab_t const * p_slab, uint8_t class_idx, void * p_element)
+{
+#if NRF_SLAB_MAGAZINE_SIZE
+    uint8_t level = magazine_level_get();
+
+    if ((level < NRF_SLAB_PRIO_LEVELS) && magazine_put(p_slab, class_idx, level, p_element))
+    {
+        return;
+    }
+#endif
+
+    nrf_balloc_free(p_slab->pp_pools[class_idx], p_element);
+}
+
+ret_code_t nrf_slab_init(nrf_slab_t const * p_slab)
+{
+    ASSERT(p_slab != NULL);
+
+    for (uint8_t i = 0; i < p_slab->class_count; i++)
+    {
+        if ((i > 0) && (NRF_BALLOC_ELEMENT_SIZE(p_slab->pp_pools[i]) <=
+                        NRF_BALLOC_ELEMENT_SIZE(p_slab->pp_pools[i - 1])))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        ret_code_t err_code = nrf_balloc_init(p_slab->pp_pools[i]);
+        VERIFY_SUCCESS(err_code);
+    }
+
+    memset(p_slab->p_classes, 0, p_slab->class_count * sizeof(nrf_slab_class_cb_t));
+#if NRF_SLAB_MAGAZINE_SIZE
+    memset(p_slab->p_magazines,
+           0,
+           NRF_SLAB_PRIO_LEVELS * p_slab->class_count * sizeof(nrf_slab_magazine_t));
+#endif
+
+    return NRF_SUCCESS;
+}
+
+void * nrf_slab_alloc(nrf_slab_t const * p_slab, size_t size)
+{
+    ASSERT(p_slab != NULL);
+
+    uint8_t class_idx = 0;
+
+    // Find the smallest class that fits the request.
+    while ((class_idx < p_slab->class_count) &&
+           (NRF_BALLOC_ELEMENT_SIZE(p_slab->pp_pools[class_idx]) < size))
+    {
+        class_idx++;
+    }
+
+    if (class_idx == p_slab->class_count)
+    {
+        // Larger than any class. Accounted to the largest one.
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&p_slab->p_classes[class_idx - 1].fail_cnt, 1));
+        return NULL;
+    }
+
+    for (uint8_t i = class_idx; i < p_slab->class_count; i++)
+    {
+        void * p_element = class_alloc(p_slab, i);
+
+        if (p_element != NULL)
+        {
+            nrf_slab_class_cb_t * p_class = &p_slab->p_classes[i];
+
+            if (i != class_idx)
+            {
+                UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&p_slab->p_classes[class_idx].spill_cnt, 1));
+            }
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&p_class->alloc_cnt, 1));
+            stat_max_update(&p_class->max_in_use, nrf_atomic_u32_add(&p_class->in_use, 1));
+            stat_max_update(&p_class->max_req_size, size);
+
+            return p_element;
+        }
+    }
+
+    UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&p_slab->p_classes[class_idx].fail_cnt, 1));
+    return NULL;
+}
+
+void nrf_slab_free(nrf_slab_t const * p_slab, void * p_element)
+{
+    ASSERT(p_slab != NULL);
+
+    if (p_element == NULL)
+    {
+        return;
+    }
+
+    uint8_t class_idx = class_find(p_slab, p_element);
+    ASSERT(class_idx < p_slab->class_count);
+
+    UNUSED_RETURN_VALUE(nrf_atomic_u32_sub(&p_slab->p_classes[class_idx].in_use, 1));
+    class_free(p_slab, class_idx, p_element);
+}
+
+ret_code_t nrf_slab_stats_get(nrf_slab_t const * p_slab, uint8_t class_idx, nrf_slab_stats_t * p_stats)
+{
+    ASSERT(p_slab != NULL);
+    ASSERT(p_stats != NULL);
+
+    if (class_idx >= p_slab->class_count)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    nrf_slab_class_cb_t const * p_class = &p_slab->p_classes[class_idx];
+
+    p_stats->element_size = NRF_BALLOC_ELEMENT_SIZE(p_slab->pp_pools[class_idx]);
+    p_stats->pool_size    = pool_size_get(p_slab->pp_pools[class_idx]);
+    p_stats->alloc_cnt    = p_class->alloc_cnt;
+    p_stats->fail_cnt     = p_class->fail_cnt;
+    p_stats->spill_cnt    = p_class->spill_cnt;
+    p_stats->in_use       = p_class->in_use;
+    p_stats->max_in_use   = p_class->max_in_use;
+    p_stats->max_req_size = p_class->max_req_size;
+
+    return NRF_SUCCESS;
+}
+
+void nrf_slab_stats_reset(nrf_slab_t const * p_slab)
+{
+    ASSERT(p_slab != NULL);
+
+    for (uint8_t i = 0; i < p_slab->class_count; i++)
+    {
+        nrf_slab_class_cb_t * p_class = &p_slab->p_classes[i];
+
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_store(&p_class->alloc_cnt, 0));
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_store(&p_class->fail_cnt, 0));
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_store(&p_class->spill_cnt, 0));
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_store(&p_class->max_in_use, p_class->in_use));
+        UNUSED_RETURN_VALUE(nrf_atomic_u32_store(&p_class->max_req_size, 0));
+    }
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_SLAB)
@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2016 - 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @defgroup nrf_slab Size-class block allocator
+ * @{
+ * @ingroup app_common
+ * @brief Allocator that serves variable-size requests from several @ref nrf_balloc pools.
+ *
+ * @details Each pool forms one size class. A request is served by the smallest class whose
+ *          element size fits it. If that class is exhausted, the next larger class is used. Per-class
+ *          statistics record how many blocks were in use at most, how often a class overflowed
+ *          into a larger one, and the largest request it served, so that pool sizes can be set
+ *          from measured usage.
+ *
+ *          When @ref NRF_SLAB_MAGAZINE_SIZE is not 0, every interrupt priority keeps a small cache
+ *          (magazine) of free blocks per class. Allocations and frees that hit the cache of the
+ *          current priority do not enter the critical region of @ref nrf_balloc. The cache slots
+ *          are exchanged atomically, so a class whose pool is exhausted takes blocks from the
+ *          caches of other priorities before a larger class is used.
+ */
+
+#ifndef NRF_SLAB_H__
+#define NRF_SLAB_H__
+
+#include <stdint.h>
+#include "sdk_errors.h"
+#include "sdk_config.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+#include "nrf_atomic.h"
+#include "nrf_balloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NRF_SLAB_MAGAZINE_SIZE
+#define NRF_SLAB_MAGAZINE_SIZE 0
+#endif
+
+/**@brief Number of execution priorities that have their own magazines (all interrupt
+ *        priorities available to the application and Thread Mode). */
+#define NRF_SLAB_PRIO_LEVELS    (APP_IRQ_PRIORITY_LOWEST + 2)
+
+/**@brief Per-class statistics, updated atomically. */
+typedef struct
+{
+    nrf_atomic_u32_t alloc_cnt;     //!< Number of blocks allocated from the class.
+    nrf_atomic_u32_t fail_cnt;      //!< Number of requests for the class that could not be served at all.
+    nrf_atomic_u32_t spill_cnt;     //!< Number of requests for the class served by a larger class.
+    nrf_atomic_u32_t in_use;        //!< Number of blocks of the class currently in use.
+    nrf_atomic_u32_t max_in_use;    //!< High-water mark of @p in_use.
+    nrf_atomic_u32_t max_req_size;  //!< Largest request served by the class, in bytes.
+} nrf_slab_class_cb_t;
+
+/**@brief Magazine of free blocks of one class, owned by one execution priority. */
+typedef struct
+{
+    nrf_atomic_u32_t slots[MAX(NRF_SLAB_MAGAZINE_SIZE, 1)]; //!< Cached blocks as offset in the pool plus one, 0 if empty.
+} nrf_slab_magazine_t;
+
+/**@brief Slab allocator instance. */
+typedef struct
+{
+    nrf_balloc_t const * const * pp_pools;      //!< Pools, ordered by increasing element size.
+    nrf_slab_class_cb_t        * p_classes;     //!< Per-class statistics.
+#if NRF_SLAB_MAGAZINE_SIZE
+    nrf_slab_magazine_t        * p_magazines;   //!< Magazines, @ref NRF_SLAB_PRIO_LEVELS rows of @p class_count.
+#endif
+    uint8_t                      class_count;   //!< Number of size classes.
+} nrf_slab_t;
+
+/**@brief Snapshot of the statistics of one size class. */
+typedef struct
+{
+    uint32_t element_size;  //!< Usable size of a block of the class.
+    uint32_t pool_size;     //!< Number of blocks in the class.
+    uint32_t alloc_cnt;     //!< Number of blocks allocated from the class.
+    uint32_t fail_cnt;      //!< Number of requests for the class that could not be served at all.
+    uint32_t spill_cnt;     //!< Number of requests for the class served by a larger class.
+    uint32_t in_use;        //!< Number of blocks of the class currently in use.
+    uint32_t max_in_use;    //!< High-water mark of blocks in use.
+    uint32_t max_req_size;  //!< Largest request served by the class, in bytes.
+} nrf_slab_stats_t;
+
+/**@cond NO_DOXYGEN */
+#if NRF_SLAB_MAGAZINE_SIZE
+#define NRF_SLAB_MAGAZINES_DEF(_name, _class_count)                                         \
+    static nrf_slab_magazine_t CONCAT_2(_name, _magazines)[NRF_SLAB_PRIO_LEVELS * (_class_count)];
+#define NRF_SLAB_MAGAZINES_ASSIGN(_name)    .p_magazines = CONCAT_2(_name, _magazines),
+#else
+#define NRF_SLAB_MAGAZINES_DEF(_name, _class_count)
+#define NRF_SLAB_MAGAZINES_ASSIGN(_name)
+#endif
+/**@endcond */
+
+/**@brief Macro for defining a slab allocator instance.
+ *
+ * The pools must be defined with @ref NRF_BALLOC_DEF and listed by increasing element size.
+ *
+ * @code
+ * NRF_BALLOC_DEF(m_pool_small, 16, 8);
+ * NRF_BALLOC_DEF(m_pool_large, 64, 4);
+ * NRF_SLAB_DEF(m_slab, &m_pool_small, &m_pool_large);
+ * @endcode
+ *
+ * @param[in] _name  Name of the instance.
+ * @param[in] ...    Pointers to the pools, one per size class.
+ */
+#define NRF_SLAB_DEF(_name, ...)                                                            \
+    static nrf_balloc_t const * const CONCAT_2(_name, _pools)[] = { __VA_ARGS__ };          \
+    static nrf_slab_class_cb_t CONCAT_2(_name, _classes)[NUM_VA_ARGS(__VA_ARGS__)];         \
+    NRF_SLAB_MAGAZINES_DEF(_name, NUM_VA_ARGS(__VA_ARGS__))                                 \
+    static const nrf_slab_t _name =                                                         \
+    {                                                                                       \
+        .pp_pools    = CONCAT_2(_name, _pools),                                             \
+        .p_classes   = CONCAT_2(_name, _classes),                                           \
+        NRF_SLAB_MAGAZINES_ASSIGN(_name)                                                    \
+        .class_count = NUM_VA_ARGS(__VA_ARGS__),                                            \
+    }
+
+/**@brief Function for initializing a slab allocator instance and all its pools.
+ *
+ * @param[in] p_slab  Pointer to the instance.
+ *
+ * @retval NRF_SUCCESS              Initialization succeeded.
+ * @retval NRF_ERROR_INVALID_PARAM  The pools are not ordered by increasing element size.
+ * @return Other errors returned by @ref nrf_balloc_init.
+ */
+ret_code_t nrf_slab_init(nrf_slab_t const * p_slab);
+
+/**@brief Function for allocating a block of at least the given size.
+ *
+ * @note The returned memory is aligned to 4.
+ *
+ * @param[in] p_slab  Pointer to the instance.
+ * @param[in] size    Requested size in bytes.
+ *
+ * @return Allocated block, or NULL if no class that fits the request has a free block.
+ */
+void * nrf_slab_alloc(nrf_slab_t const * p_slab, size_t size);
+
+/**@brief Function for freeing a block allocated with @ref nrf_slab_alloc.
+ *
+ * @param[in] p_slab     Pointer to the instance.
+ * @param[in] p_element  Block to free.
+ */
+void nrf_slab_free(nrf_slab_t const * p_slab, void * p_element);
+
+/**@brief Function for getting the statistics of one size class.
+ *
+ * @param[in]  p_slab     Pointer to the instance.
+ * @param[in]  class_idx  Index of the class, in the order given to @ref NRF_SLAB_DEF.
+ * @param[out] p_stats    Statistics.
+ *
+ * @retval NRF_SUCCESS              Statistics copied.
+ * @retval NRF_ERROR_INVALID_PARAM  Class index out of range.
+ */
+ret_code_t nrf_slab_stats_get(nrf_slab_t const * p_slab, uint8_t class_idx, nrf_slab_stats_t * p_stats);
+
+/**@brief Function for clearing the counters and restarting the high-water marks from the current
+ *        usage.
+ *
+ * @param[in] p_slab  Pointer to the instance.
+ */
+void nrf_slab_stats_reset(nrf_slab_t const * p_slab);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_SLAB_H__
+
+/** @} */
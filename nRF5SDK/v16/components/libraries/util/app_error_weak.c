@@ -48,17 +48,12 @@
 #include "nrf_sdm.h"
 #endif
 
-/*lint -save -e14 */
-/**
- * Function is implemented as weak so that it can be overwritten by custom application error handler
- * when needed.
- */
-__WEAK void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
+void app_error_log_handle(uint32_t id, uint32_t pc, uint32_t info)
 {
-    __disable_irq();
-    NRF_LOG_FINAL_FLUSH();
-
 #ifndef DEBUG
+    UNUSED_PARAMETER(id);
+    UNUSED_PARAMETER(pc);
+    UNUSED_PARAMETER(info);
     NRF_LOG_ERROR("Fatal error");
 #else
     switch (id)
@@ -88,7 +83,7 @@ __WEAK void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
                           p_info->p_file_name,
                           p_info->line_num,
                           pc);
-             NRF_LOG_ERROR("End of error report");
+            NRF_LOG_ERROR("End of error report");
             break;
         }
         default:
@@ -97,6 +92,20 @@ __WEAK void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
     }
 #endif
 
+    NRF_LOG_FINAL_FLUSH();
+}
+
+
+/*lint -save -e14 */
+/**
+ * Function is implemented as weak so that it can be overwritten by custom application error handler
+ * when needed.
+ */
+__WEAK void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
+{
+    __disable_irq();
+    app_error_log_handle(id, pc, info);
+
     NRF_BREAKPOINT_COND;
     // On assert, the system can only recover with a reset.
 
@@ -429,9 +429,9 @@ uint32_t _sd_ble_gattc_write(uint16_t                               conn_handle,
     APP_ERROR_CHECK(err_code);
 
     //@note: Increment buffer length as internally managed packet type field must be included.
-    return ser_sd_transport_cmd_write(p_buffer,
-                                      (++buffer_length),
-                                      gattc_write_rsp_dec);
+    return ser_sd_transport_cmd_write_pipelined(p_buffer,
+                                                (++buffer_length),
+                                                gattc_write_rsp_dec);
 }
 
 /**@brief Command response callback function for @ref sd_ble_gattc_hv_confirm BLE command.
@@ -149,9 +149,10 @@ uint32_t _sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const *
     APP_ERROR_CHECK(err_code);
 
     //@note: Increment buffer length as internally managed packet type field must be included.
-    return ser_sd_transport_cmd_write(p_buffer,
-                                      (++buffer_length),
-                                      gatts_hvx_rsp_dec);
+    //@note: When pipelined, *p_hvx_params->p_len is not updated with the number of bytes written.
+    return ser_sd_transport_cmd_write_pipelined(p_buffer,
+                                                (++buffer_length),
+                                                gatts_hvx_rsp_dec);
 }
 
 
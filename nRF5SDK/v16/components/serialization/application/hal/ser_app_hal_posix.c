@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "ser_phy.h"
+#include <errno.h>
+#include <time.h>
+#include "ser_app_hal.h"
+#include "ser_phy_posix.h"
+#include "nrf_soc.h"
+#include "nrf_error.h"
+
+/** Longest time (in milliseconds) that sd_app_evt_wait() sleeps waiting for the serial port.
+ *  The application gets control back at least this often, like after an interrupt. */
+#ifndef SER_APP_HAL_POSIX_WAIT_MS
+#define SER_APP_HAL_POSIX_WAIT_MS   10
+#endif
+
+/** Handler of the SoftDevice event interrupt, provided by the SoftDevice handler (nrf_sdh.c). */
+void SD_EVT_IRQHandler(void);
+
+static bool m_evt_pending;      /**< Emulated SoftDevice event interrupt is pending. */
+static bool m_evt_irq_active;   /**< Emulated SoftDevice event interrupt handler is running. */
+
+uint32_t ser_app_hal_hw_init(ser_app_hal_flash_op_done_handler_t handler)
+{
+    // Flash operations are not supported on the host, so the handler is never called.
+    (void)handler;
+    m_evt_pending = false;
+
+    return NRF_SUCCESS;
+}
+
+void ser_app_hal_delay(uint32_t ms)
+{
+    struct timespec delay = {
+        .tv_sec  = ms / 1000,
+        .tv_nsec = (long)(ms % 1000) * 1000000L,
+    };
+
+    while ((nanosleep(&delay, &delay) != 0) && (errno == EINTR))
+    {
+        // Sleep for the remaining time.
+    }
+}
+
+void ser_app_hal_nrf_reset_pin_clear()
+{
+    ser_phy_posix_dtr_set(false);
+}
+
+void ser_app_hal_nrf_reset_pin_set()
+{
+    ser_phy_posix_dtr_set(true);
+}
+
+void ser_app_hal_nrf_evt_irq_priority_set()
+{
+    // There are no interrupt priorities on the host. The events are dispatched from
+    // sd_app_evt_wait(), never while the handler is running.
+}
+
+void ser_app_hal_nrf_evt_pending()
+{
+    m_evt_pending = true;
+}
+
+/**@brief Function for waiting for serial port events on the host.
+ *
+ * @details Replaces the WFE-based implementation. Runs the PHY I/O and, if events from the
+ *          Connectivity Chip have been decoded, calls SD_EVT_IRQHandler, unless it is already
+ *          running (a SoftDevice call made from the event handler waits for its response here).
+ */
+uint32_t sd_app_evt_wait(void)
+{
+    (void)ser_phy_posix_process(m_evt_pending ? 0 : SER_APP_HAL_POSIX_WAIT_MS);
+
+    if (m_evt_pending && !m_evt_irq_active)
+    {
+        m_evt_pending    = false;
+        m_evt_irq_active = true;
+        SD_EVT_IRQHandler();
+        m_evt_irq_active = false;
+    }
+
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_ppi_channel_enable_get(uint32_t * p_channel_enable)
+{
+    *p_channel_enable = 0;
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+uint32_t sd_ppi_channel_enable_set(uint32_t channel_enable_set_msk)
+{
+    (void)channel_enable_set_msk;
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+uint32_t sd_ppi_channel_assign(uint8_t               channel_num,
+                               const volatile void * evt_endpoint,
+                               const volatile void * task_endpoint)
+{
+    (void)channel_num;
+    (void)evt_endpoint;
+    (void)task_endpoint;
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+uint32_t sd_flash_page_erase(uint32_t page_number)
+{
+    // The host has no flash memory of the application chip.
+    (void)page_number;
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+uint32_t sd_flash_write(uint32_t * const p_dst, uint32_t const * const p_src, uint32_t size)
+{
+    (void)p_dst;
+    (void)p_src;
+    (void)size;
+    return NRF_ERROR_NOT_SUPPORTED;
+}
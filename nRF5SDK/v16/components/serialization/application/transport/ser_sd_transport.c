@@ -42,6 +42,7 @@
 #include <stddef.h>
 #include "ser_sd_transport.h"
 #include "ser_hal_transport.h"
+#include "ser_config.h"
 #include "nrf_error.h"
 #include "app_error.h"
 #include "ble_serialization.h"
@@ -74,15 +75,133 @@ static ser_sd_transport_rsp_set_handler_t m_os_rsp_set_handler = NULL;
 /** Handler called when hal_transport notifies that packet reception has started. */
 static ser_sd_transport_rx_notification_handler_t m_rx_notify_handler = NULL;
 
-/** User decoder handler for expected response packet. */
-static ser_sd_transport_rsp_handler_t m_rsp_dec_handler = NULL;
+/** Command waiting for its response packet. */
+typedef struct
+{
+    ser_sd_transport_rsp_handler_t rsp_dec_handler; /**< User decoder handler. NULL for a pipelined command. */
+    uint8_t                        op_code;         /**< Operation code of the command. */
+} ser_sd_transport_rsp_entry_t;
+
+/** Queue of commands waiting for their responses, in the order in which they were sent. It holds
+ *  the pipelined commands and one blocking command. One element is left unused to tell a full
+ *  queue from an empty one. */
+#define RSP_QUEUE_SIZE  (SER_SD_TRANSPORT_PIPELINE_DEPTH + 2)
+static ser_sd_transport_rsp_entry_t m_rsp_queue[RSP_QUEUE_SIZE];
+
+/** Index of the next element to be written. Modified only in task context. */
+static volatile uint8_t m_rsp_queue_in = 0;
+
+/** Index of the oldest command waiting for its response. Modified only in the serial peripheral
+ *  interrupt context. */
+static volatile uint8_t m_rsp_queue_out = 0;
+
+/** Handler for failed pipelined calls. NULL if pipelining is disabled. */
+static ser_sd_transport_pipeline_err_handler_t m_pipeline_err_handler = NULL;
 
 /** Flag indicated whether module is waiting for response packet. */
 static volatile bool m_rsp_wait = false;
 
+/** Flag indicating whether a pipelined command is waiting to be transmitted and for a free
+ *  pipeline slot. */
+static volatile bool m_pipeline_wait = false;
+
+/** Flag indicating whether a pipelined command is being transmitted. */
+static volatile bool m_pipeline_tx_pending = false;
+
 /** SoftDevice call return value decoded by user decoder handler. */
 static uint32_t m_return_value;
 
+/**@brief Function for getting the index that follows @p index in the response queue. */
+static uint8_t rsp_queue_next(uint8_t index)
+{
+    return (index + 1 < RSP_QUEUE_SIZE) ? (uint8_t)(index + 1) : 0;
+}
+
+/**@brief Function for getting the number of commands waiting for their responses. */
+static uint8_t rsp_queue_count(void)
+{
+    uint8_t in  = m_rsp_queue_in;
+    uint8_t out = m_rsp_queue_out;
+
+    return (uint8_t)((in >= out) ? (in - out) : (in + RSP_QUEUE_SIZE - out));
+}
+
+/**@brief Function for adding a sent command to the response queue.
+ *
+ * @details Called before the command is sent, because the response may arrive before
+ *          ser_hal_transport_tx_pkt_send() returns.
+ */
+static void rsp_queue_push(ser_sd_transport_rsp_handler_t rsp_dec_handler, uint8_t op_code)
+{
+    uint8_t in = m_rsp_queue_in;
+
+    APP_ERROR_CHECK_BOOL(rsp_queue_next(in) != m_rsp_queue_out);
+
+    m_rsp_queue[in].rsp_dec_handler = rsp_dec_handler;
+    m_rsp_queue[in].op_code         = op_code;
+    m_rsp_queue_in                  = rsp_queue_next(in);
+}
+
+/**@brief Function for signaling to the task context that the state it waits on has changed. */
+static void rsp_waiter_signal(void)
+{
+    /* If os handler is set, signal os that response has arrived.*/
+    if (m_os_rsp_set_handler)
+    {
+        m_os_rsp_set_handler();
+    }
+}
+
+/**@brief Function for handling the response to the oldest command in the response queue.
+ *
+ * @param[in]   p_data   Pointer to the response, or NULL if the response has been lost.
+ * @param[in]   length   Size of the response.
+ */
+static void rsp_handle(uint8_t * p_data, uint16_t length)
+{
+    ser_sd_transport_rsp_entry_t const * p_entry = &m_rsp_queue[m_rsp_queue_out];
+    uint32_t                             result_code = NRF_ERROR_INTERNAL;
+
+    if (p_entry->rsp_dec_handler == NULL)
+    {
+        /* Pipelined command. Only the return code is checked. */
+        if (p_data != NULL)
+        {
+            uint32_t index    = 0;
+            uint32_t err_code = ser_ble_cmd_rsp_result_code_dec(p_data, &index, length,
+                                                                p_entry->op_code, &result_code);
+            APP_ERROR_CHECK(err_code);
+        }
+
+        if ((result_code != NRF_SUCCESS) && m_pipeline_err_handler)
+        {
+            NRF_LOG_DEBUG("[SD_CALL]:%s, pipelined err_code= 0x%X",
+                          (uint32_t)ser_dbg_sd_call_str_get(p_entry->op_code), result_code);
+            m_pipeline_err_handler(p_entry->op_code, result_code);
+        }
+
+        m_rsp_queue_out = rsp_queue_next(m_rsp_queue_out);
+
+        if (m_pipeline_wait)
+        {
+            rsp_waiter_signal();
+        }
+    }
+    else
+    {
+        if (p_data != NULL)
+        {
+            result_code = p_entry->rsp_dec_handler(p_data, length);
+        }
+        m_return_value  = result_code;
+        m_rsp_queue_out = rsp_queue_next(m_rsp_queue_out);
+
+        /* Reset response flag - cmd_write function is pending on it.*/
+        m_rsp_wait = false;
+        rsp_waiter_signal();
+    }
+}
+
 /**@brief Function for handling the rx packets comming from hal_transport.
  *
  * @details
@@ -108,19 +227,10 @@ static void ser_sd_transport_rx_packet_handler(uint8_t * p_data, uint16_t length
 #ifdef ANT_STACK_SUPPORT_REQD
             case SER_PKT_TYPE_ANT_RESP:
 #endif // ANT_STACK_SUPPORT_REQD
-                if (m_rsp_wait)
+                if (rsp_queue_count() > 0)
                 {
-                    m_return_value = m_rsp_dec_handler(p_data, length);
+                    rsp_handle(p_data, length);
                     (void)ser_sd_transport_rx_free(p_data);
-
-                    /* Reset response flag - cmd_write function is pending on it.*/
-                    m_rsp_wait = false;
-
-                    /* If os handler is set, signal os that response has arrived.*/
-                    if (m_os_rsp_set_handler)
-                    {
-                        m_os_rsp_set_handler();
-                    }
                 }
                 else
                 {
@@ -177,21 +287,20 @@ static void ser_sd_transport_hal_handler(ser_hal_transport_evt_t event)
         {
             ser_app_power_system_off_enter();
         }
+
+        if (m_pipeline_tx_pending)
+        {
+            m_pipeline_tx_pending = false;
+            rsp_waiter_signal();
+        }
         break;
     case SER_HAL_TRANSP_EVT_PHY_ERROR:
+        m_pipeline_tx_pending = false;
 
-        if (m_rsp_wait)
+        /* Responses may have been lost. Fail all commands waiting for them. */
+        while (rsp_queue_count() > 0)
         {
-            m_return_value = NRF_ERROR_INTERNAL;
-
-            /* Reset response flag - cmd_write function is pending on it.*/
-            m_rsp_wait = false;
-
-            /* If os handler is set, signal os that response has arrived.*/
-            if (m_os_rsp_set_handler)
-            {
-                m_os_rsp_set_handler();
-            }
+            rsp_handle(NULL, 0);
         }
         break;
     default:
@@ -210,6 +319,12 @@ uint32_t ser_sd_transport_open(ser_sd_transport_evt_handler_t             ble_ev
     m_rx_notify_handler   = rx_not_handler;
     m_ot_rsp_wait_handler = NULL;
 
+    m_rsp_queue_in        = 0;
+    m_rsp_queue_out       = 0;
+    m_rsp_wait            = false;
+    m_pipeline_wait       = false;
+    m_pipeline_tx_pending = false;
+
 #ifdef ANT_STACK_SUPPORT_REQD
     m_ant_evt_handler = ant_evt_handler;
 
@@ -245,9 +360,10 @@ uint32_t ser_sd_transport_close(void)
     m_ble_evt_handler     = NULL;
 #endif // BLE_STACK_SUPPORT_REQD
 
-    m_os_rsp_wait_handler = NULL;
-    m_os_rsp_set_handler  = NULL;
-    m_ot_rsp_wait_handler = NULL;
+    m_os_rsp_wait_handler  = NULL;
+    m_os_rsp_set_handler   = NULL;
+    m_ot_rsp_wait_handler  = NULL;
+    m_pipeline_err_handler = NULL;
 
     ser_hal_transport_close();
 
@@ -261,9 +377,23 @@ uint32_t ser_sd_transport_ot_rsp_wait_handler_set(ser_sd_transport_rsp_wait_hand
     return NRF_SUCCESS;
 }
 
+uint32_t ser_sd_transport_pipeline_enable(ser_sd_transport_pipeline_err_handler_t err_handler)
+{
+    if ((SER_SD_TRANSPORT_PIPELINE_DEPTH == 0) && (err_handler != NULL))
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    m_pipeline_err_handler = err_handler;
+
+    return NRF_SUCCESS;
+}
+
 bool ser_sd_transport_is_busy(void)
 {
-    return m_rsp_wait;
+    return m_rsp_wait ||
+           (m_pipeline_wait &&
+            (m_pipeline_tx_pending || (rsp_queue_count() >= SER_SD_TRANSPORT_PIPELINE_DEPTH)));
 }
 
 uint32_t ser_sd_transport_tx_alloc(uint8_t * * pp_data, uint16_t * p_len)
@@ -298,14 +428,19 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
 {
     uint32_t err_code = NRF_SUCCESS;
 
-    m_rsp_wait        = true;
-    m_rsp_dec_handler = cmd_rsp_decode_callback;
-    err_code          = ser_hal_transport_tx_pkt_send(p_buffer, length);
+    /* Execute callback for response decoding only if one was provided.*/
+    if (cmd_rsp_decode_callback)
+    {
+        m_rsp_wait = true;
+        rsp_queue_push(cmd_rsp_decode_callback, p_buffer[SER_PKT_OP_CODE_POS]);
+    }
+
+    err_code = ser_hal_transport_tx_pkt_send(p_buffer, length);
     APP_ERROR_CHECK(err_code);
 
-    /* Execute callback for response decoding only if one was provided.*/
-    if ((err_code == NRF_SUCCESS) && cmd_rsp_decode_callback)
+    if (cmd_rsp_decode_callback)
     {
+        /* The response is handled after the responses of all pipelined commands sent before. */
         if (m_ot_rsp_wait_handler)
         {
             m_ot_rsp_wait_handler();
@@ -315,11 +450,37 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
         m_os_rsp_wait_handler();
         err_code = m_return_value;
     }
-    else
-    {
-        m_rsp_wait = false;
-    }
 
     NRF_LOG_DEBUG("[SD_CALL]:%s, err_code= 0x%X", (uint32_t)ser_dbg_sd_call_str_get(p_buffer[1]), err_code);
     return err_code;
 }
+
+uint32_t ser_sd_transport_cmd_write_pipelined(const uint8_t *                p_buffer,
+                                              uint16_t                       length,
+                                              ser_sd_transport_rsp_handler_t cmd_rsp_decode_callback)
+{
+    uint32_t err_code;
+
+    if (m_pipeline_err_handler == NULL)
+    {
+        return ser_sd_transport_cmd_write(p_buffer, length, cmd_rsp_decode_callback);
+    }
+
+    rsp_queue_push(NULL, p_buffer[SER_PKT_OP_CODE_POS]);
+    m_pipeline_tx_pending = true;
+
+    err_code = ser_hal_transport_tx_pkt_send(p_buffer, length);
+    APP_ERROR_CHECK(err_code);
+
+    /* Only one TX buffer is available, so the next command can be allocated after this one has
+     * been transmitted. Wait for that, and for a free pipeline slot. */
+    m_pipeline_wait = true;
+    while (ser_sd_transport_is_busy())
+    {
+        m_os_rsp_wait_handler();
+    }
+    m_pipeline_wait = false;
+
+    NRF_LOG_DEBUG("[SD_CALL]:%s, pipelined", (uint32_t)ser_dbg_sd_call_str_get(p_buffer[1]));
+    return NRF_SUCCESS;
+}
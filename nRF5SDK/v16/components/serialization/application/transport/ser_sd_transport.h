@@ -76,6 +76,13 @@ typedef void (*ser_sd_transport_rx_notification_handler_t)(void);
 
 typedef uint32_t (*ser_sd_transport_rsp_handler_t)(const uint8_t * p_buffer, uint16_t length);
 
+/**@brief Handler called when a pipelined SoftDevice call has failed.
+ *
+ * @param[in] op_code       Operation code of the failed SoftDevice call.
+ * @param[in] result_code   Return code of the SoftDevice call on the connectivity side.
+ */
+typedef void (*ser_sd_transport_pipeline_err_handler_t)(uint8_t op_code, uint32_t result_code);
+
 /**@brief Function for opening the module.
  *
  * @note 'Wait for response' and 'Response set' callbacks can be set in RTOS environment.
@@ -161,6 +168,9 @@ uint32_t ser_sd_transport_rx_free(uint8_t * p_data);
 
 
 /**@brief Function for checking if module is busy waiting for response from connectivity side.
+ *
+ * @note While a pipelined command is being sent, the module is also busy until the command has
+ *       been transmitted and there is room for another pipelined command.
  *
  * @retval true      Module busy. Cannot accept the next command.
  * @retval false     Module not busy. Can accept next the command.
@@ -185,6 +195,43 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
                                     ser_sd_transport_rsp_handler_t cmd_resp_decode_callback);
 
 
+/**@brief Function for enabling or disabling the pipelining of SoftDevice commands.
+ *
+ * @details When pipelining is enabled, @ref ser_sd_transport_cmd_write_pipelined returns as soon
+ *          as the command has been sent, without waiting for its response. Up to
+ *          SER_SD_TRANSPORT_PIPELINE_DEPTH commands can be in flight. Their responses are checked
+ *          when they arrive, and @p err_handler is called for each call that did not return
+ *          NRF_SUCCESS. Commands sent with @ref ser_sd_transport_cmd_write still block, and they
+ *          return only after the responses of all previously pipelined commands have been handled.
+ *
+ * @note @p err_handler is called in the same context as the response handling, that is, in the
+ *       serial peripheral interrupt context.
+ *
+ * @param[in] err_handler   Handler for failed pipelined calls. NULL disables pipelining.
+ *
+ * @retval NRF_SUCCESS              Operation success.
+ * @retval NRF_ERROR_NOT_SUPPORTED  Pipelining is disabled by SER_SD_TRANSPORT_PIPELINE_DEPTH.
+ */
+uint32_t ser_sd_transport_pipeline_enable(ser_sd_transport_pipeline_err_handler_t err_handler);
+
+/**@brief Function for handling a SoftDevice command that has no output parameters.
+ *
+ * @details If pipelining is enabled, the function waits only until the command has been
+ *          transmitted and there is room for another pipelined command. The response is decoded
+ *          later and only its return code is checked, so @p cmd_resp_decode_callback is not used.
+ *          Otherwise, the function behaves like @ref ser_sd_transport_cmd_write.
+ *
+ * @param[in] p_buffer                 Pointer to command.
+ * @param[in] length                   Pointer to allocated buffer length.
+ * @param[in] cmd_resp_decode_callback Pointer to a function for decoding the response packet when
+ *                                     the command is not pipelined.
+ *
+ * @retval NRF_SUCCESS          Command pipelined, or operation success.
+ */
+uint32_t ser_sd_transport_cmd_write_pipelined(const uint8_t *                p_buffer,
+                                              uint16_t                       length,
+                                              ser_sd_transport_rsp_handler_t cmd_resp_decode_callback);
+
 #ifdef __cplusplus
 }
 #endif
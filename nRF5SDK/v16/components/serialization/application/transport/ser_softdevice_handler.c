@@ -67,6 +67,18 @@ typedef struct
     uint32_t evt_data[CEIL_DIV(NRF_SDH_BLE_EVT_BUF_SIZE, sizeof (uint32_t))]; /**< Buffer for decoded event */
     //lint -restore
 } ser_sd_handler_evt_data_t;
+
+/** @brief Structure used to pass received event packets through mailbox.
+ *
+ * @details The packet stays in the RX buffer of the transport until the application fetches
+ *          the event, and is then decoded directly into the buffer of the application. NULL
+ *          @p p_data marks an event that was decoded on reception into @ref m_sd_ble_evt_mailbox.
+ */
+typedef struct
+{
+    uint8_t * p_data; /**< Received event packet, or NULL. */
+    uint16_t  length; /**< Length of the event packet. */
+} ser_sd_handler_evt_pkt_t;
 #endif
 
 #if defined(ANT_STACK_SUPPORT_REQD)
@@ -85,6 +97,21 @@ NRF_QUEUE_DEF(ser_sd_handler_evt_data_t,
               m_sd_ble_evt_mailbox,
               SD_BLE_EVT_MAILBOX_QUEUE_SIZE,
               NRF_QUEUE_MODE_NO_OVERFLOW);
+
+/** @brief Mailbox with all the received events in order. At most SER_HAL_TRANSPORT_RX_BUF_COUNT - 1
+ *         of them hold an RX buffer, the rest are in @ref m_sd_ble_evt_mailbox.
+ */
+NRF_QUEUE_DEF(ser_sd_handler_evt_pkt_t,
+              m_sd_ble_evt_pkt_mailbox,
+              SD_BLE_EVT_MAILBOX_QUEUE_SIZE + SER_HAL_TRANSPORT_RX_BUF_COUNT - 1,
+              NRF_QUEUE_MODE_NO_OVERFLOW);
+
+/** Number of event packets that have been kept in RX buffers. Written only on reception. */
+static uint32_t volatile m_ble_evt_pkts_held;
+
+/** Number of event packets kept in RX buffers that have been decoded and freed. Written only
+ *  by @ref sd_ble_evt_get. */
+static uint32_t volatile m_ble_evt_pkts_released;
 #endif
 
 #if defined(ANT_STACK_SUPPORT_REQD)
@@ -130,17 +157,45 @@ static void connectivity_reset_high(void)
 #if defined(BLE_STACK_SUPPORT_REQD)
 static void ser_softdevice_ble_evt_handler(uint8_t * p_data, uint16_t length)
 {
-    ser_sd_handler_evt_data_t item;
-    uint32_t                  err_code;
-    uint32_t                  len32 = sizeof (item.evt_data);
+    ser_sd_handler_evt_pkt_t pkt;
+    uint32_t                 err_code;
 
-    err_code = ble_event_dec(p_data, length, (ble_evt_t *)item.evt_data, &len32);
-    APP_ERROR_CHECK(err_code);
+    if ((m_ble_evt_pkts_held - m_ble_evt_pkts_released) < (SER_HAL_TRANSPORT_RX_BUF_COUNT - 1))
+    {
+        // Keep the packet in the RX buffer, it is decoded when the event is fetched.
+        pkt.p_data = p_data;
+        pkt.length = length;
+        m_ble_evt_pkts_held++;
+    }
+    else
+    {
+        // The last free RX buffer is left for command responses, so the event is decoded now,
+        // directly into the mailbox.
+        size_t                      count  = 1;
+        ser_sd_handler_evt_data_t * p_item = nrf_queue_write_reserve(&m_sd_ble_evt_mailbox, &count);
+        uint32_t                    len32  = sizeof (p_item->evt_data);
 
-    err_code = ser_sd_transport_rx_free(p_data);
-    APP_ERROR_CHECK(err_code);
+        if (p_item == NULL)
+        {
+            err_code = NRF_ERROR_NO_MEM;
+        }
+        else
+        {
+            err_code = ble_event_dec(p_data, length, (ble_evt_t *)p_item->evt_data, &len32);
+        }
+        APP_ERROR_CHECK(err_code);
+
+        err_code = nrf_queue_write_commit(&m_sd_ble_evt_mailbox, 1);
+        APP_ERROR_CHECK(err_code);
+
+        err_code = ser_sd_transport_rx_free(p_data);
+        APP_ERROR_CHECK(err_code);
 
-    err_code = nrf_queue_push(&m_sd_ble_evt_mailbox, &item);
+        pkt.p_data = NULL;
+        pkt.length = 0;
+    }
+
+    err_code = nrf_queue_push(&m_sd_ble_evt_pkt_mailbox, &pkt);
     APP_ERROR_CHECK(err_code);
 
     ser_app_hal_nrf_evt_pending();
@@ -200,22 +255,51 @@ uint32_t sd_evt_get(uint32_t * p_evt_id)
 #if defined(BLE_STACK_SUPPORT_REQD)
 uint32_t sd_ble_evt_get(uint8_t * p_data, uint16_t * p_len)
 {
-    uint32_t err_code = nrf_queue_pop(&m_sd_ble_evt_mailbox, p_data);
+    ser_sd_handler_evt_pkt_t pkt;
+    uint32_t                 err_code = nrf_queue_pop(&m_sd_ble_evt_pkt_mailbox, &pkt);
 
-    if (err_code == NRF_SUCCESS) //if anything in the mailbox
+    if (err_code != NRF_SUCCESS) //if nothing in the mailbox
     {
-        if (((ble_evt_t *)p_data)->header.evt_len > *p_len)
+        err_code = NRF_ERROR_NOT_FOUND;
+    }
+    else if (pkt.p_data != NULL)
+    {
+        uint32_t len32 = *p_len;
+
+        // Decode straight from the RX buffer and release it.
+        err_code = ble_event_dec(pkt.p_data, pkt.length, (ble_evt_t *)p_data, &len32);
+
+        uint32_t free_err_code = ser_sd_transport_rx_free(pkt.p_data);
+        APP_ERROR_CHECK(free_err_code);
+        m_ble_evt_pkts_released++;
+
+        if (err_code == NRF_SUCCESS)
+        {
+            *p_len = ((ble_evt_t *)p_data)->header.evt_len;
+        }
+        else if ((err_code == NRF_ERROR_INVALID_LENGTH) &&
+                 (*p_len < sizeof (ser_sd_handler_evt_data_t)))
         {
             err_code = NRF_ERROR_DATA_SIZE;
         }
         else
         {
-            *p_len = ((ble_evt_t *)p_data)->header.evt_len;
+            APP_ERROR_CHECK(err_code);
         }
     }
     else
     {
-        err_code = NRF_ERROR_NOT_FOUND;
+        err_code = nrf_queue_pop(&m_sd_ble_evt_mailbox, p_data);
+        APP_ERROR_CHECK(err_code);
+
+        if (((ble_evt_t *)p_data)->header.evt_len > *p_len)
+        {
+            err_code = NRF_ERROR_DATA_SIZE;
+        }
+        else
+        {
+            *p_len = ((ble_evt_t *)p_data)->header.evt_len;
+        }
     }
 
     return err_code;
@@ -251,7 +335,7 @@ uint32_t sd_ant_event_get(uint8_t* p_channel, uint8_t* p_event, uint8_t* p_ant_m
 #if defined(BLE_STACK_SUPPORT_REQD)
 uint32_t sd_ble_evt_mailbox_length_get(uint32_t * p_mailbox_length)
 {
-    *p_mailbox_length = nrf_queue_utilization_get(&m_sd_ble_evt_mailbox);
+    *p_mailbox_length = nrf_queue_utilization_get(&m_sd_ble_evt_pkt_mailbox);
     return NRF_SUCCESS;
 }
 #endif
@@ -280,6 +364,9 @@ uint32_t sd_softdevice_enable(nrf_clock_lf_cfg_t const * p_clock_lf_cfg,
 #ifdef BLE_STACK_SUPPORT_REQD
         ble_evt_handler = ser_softdevice_ble_evt_handler;
         nrf_queue_reset(&m_sd_ble_evt_mailbox);
+        nrf_queue_reset(&m_sd_ble_evt_pkt_mailbox);
+        m_ble_evt_pkts_held     = 0;
+        m_ble_evt_pkts_released = 0;
 #endif // BLE_STACK_SUPPORT_REQD
 
 #ifdef ANT_STACK_SUPPORT_REQD
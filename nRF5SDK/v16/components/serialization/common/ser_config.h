@@ -60,6 +60,12 @@ extern "C" {
  *  should NOT be reset. */
 #define SER_WARNING_CODE     (0xBADDCAFEUL)
 
+/** Maximum number of pipelined SoftDevice commands that can wait for their responses on the
+ *  application side (see @ref ser_sd_transport_pipeline_enable). 0 disables pipelining. */
+#ifndef SER_SD_TRANSPORT_PIPELINE_DEPTH
+#define SER_SD_TRANSPORT_PIPELINE_DEPTH    4
+#endif
+
 /***********************************************************************************************//**
  * HAL Transport layer configuration.
  **************************************************************************************************/
@@ -79,6 +85,16 @@ extern "C" {
                                         ?                                               \
                                         (SER_HAL_TRANSPORT_APP_TO_CONN_MAX_PKT_SIZE) :  \
                                         (SER_HAL_TRANSPORT_CONN_TO_APP_MAX_PKT_SIZE))
+/** Number of RX packet buffers in the serialization HAL Transport layer. On the application side,
+ *  received event packets can stay in their buffers until the application fetches them, so more
+ *  than one buffer lets the events be decoded without intermediate copies (see
+ *  ser_softdevice_handler.c). One buffer is always left for the command responses. Each buffer
+ *  takes SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE bytes of RAM, so an application opts in by defining
+ *  a larger count. */
+#ifndef SER_HAL_TRANSPORT_RX_BUF_COUNT
+#define SER_HAL_TRANSPORT_RX_BUF_COUNT    1
+#endif
+
 #ifdef SER_CONNECTIVITY
     #define SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE         SER_HAL_TRANSPORT_CONN_TO_APP_MAX_PKT_SIZE
     #define SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE         SER_HAL_TRANSPORT_APP_TO_CONN_MAX_PKT_SIZE
@@ -97,6 +113,17 @@ extern "C" {
 
 #define SER_PHY_HCI_SLIP_TX_BUF_SIZE    30
 
+/** Number of reliable HCI packets that can be sent before the first one is acknowledged (1 to 7).
+ *  With 1, the packet is sent from the buffer of the upper layer, which is released when the
+ *  packet is acknowledged. With more, each packet is copied into the PHY, which takes
+ *  SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE bytes of RAM per packet, and its buffer is released as soon
+ *  as it is copied. With HCI_LINK_CONTROL, the smaller of this value and
+ *  the window announced by the peer in the CONFIG packet is used. Without it, both sides must use
+ *  the same value. */
+#ifndef SER_PHY_HCI_WINDOW_SIZE
+#define SER_PHY_HCI_WINDOW_SIZE         1
+#endif
+
 #define SER_PHY_SPI_FREQUENCY           NRF_DRV_SPI_FREQ_1M
 
 /** Max transfer unit for SPI MASTER and SPI SLAVE. */
@@ -109,6 +136,11 @@ extern "C" {
 
 #define SER_PHY_UART_BAUDRATE CONCAT_2(NRF_UART_BAUDRATE_,SER_PHY_UART_BAUDRATE_VAL)
 
+/** Default serial device of the UART PHY on a POSIX host (ser_phy_uart_posix.c). */
+#ifndef SER_PHY_POSIX_DEVICE
+#define SER_PHY_POSIX_DEVICE            "/dev/ttyACM0"
+#endif
+
 /** Configuration timeouts of connectivity MCU. */
 #define CONN_CHIP_RESET_TIME            50      /**< Time to keep the reset line to the connectivity chip low (in milliseconds). */
 #define CONN_CHIP_WAKEUP_TIME           500     /**< Time for the connectivity chip to reset and become ready to receive serialized commands (in milliseconds). */
@@ -40,6 +40,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include "app_error.h"
+#include "app_util.h"
 #include "sdk_config.h"
 #include "ser_config.h"
 #include "ser_phy.h"
@@ -100,9 +101,15 @@ static ser_hal_transp_tx_states_t m_tx_state = HAL_TRANSP_TX_STATE_CLOSED;
  */
 static uint8_t m_tx_buffer[SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE];
 /**
- * @brief Reception buffer.
+ * @brief Reception buffers.
  */
-static uint8_t m_rx_buffer[SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE];
+static uint8_t m_rx_buffer[SER_HAL_TRANSPORT_RX_BUF_COUNT][SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE];
+/**
+ * @brief Bitmask of reception buffers passed to the PHY or held by an upper layer.
+ */
+static uint32_t m_rx_buf_in_use;
+
+STATIC_ASSERT((SER_HAL_TRANSPORT_RX_BUF_COUNT >= 1) && (SER_HAL_TRANSPORT_RX_BUF_COUNT <= 32));
 
 /**
  * @brief Callback function handler for Serialization HAL Transport layer events.
@@ -110,6 +117,33 @@ static uint8_t m_rx_buffer[SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE];
 static ser_hal_transport_events_handler_t m_events_handler = NULL;
 
 
+/**
+ * @brief Function for taking a free reception buffer.
+ *
+ * @return Pointer to the buffer, or NULL if all the buffers are in use.
+ */
+static uint8_t * rx_buf_alloc(void)
+{
+    for (uint32_t i = 0; i < SER_HAL_TRANSPORT_RX_BUF_COUNT; i++)
+    {
+        if ((m_rx_buf_in_use & (1UL << i)) == 0)
+        {
+            m_rx_buf_in_use |= (1UL << i);
+            return m_rx_buffer[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Function for checking if any reception buffer is free.
+ */
+static bool rx_buf_available(void)
+{
+    return (m_rx_buf_in_use != ((1UL << (SER_HAL_TRANSPORT_RX_BUF_COUNT - 1)) << 1) - 1);
+}
+
 /**
  * @brief A callback function to be used to handle a PHY module events. This function is called in
  *        an interrupt context.
@@ -151,12 +185,12 @@ static void phy_events_handler(ser_phy_evt_t phy_event)
             hal_transp_event.evt_type = SER_HAL_TRANSP_EVT_RX_PKT_RECEIVING;
 
             /* Receive or drop a packet. */
-            if (phy_event.evt_params.rx_buf_request.num_of_bytes <= sizeof (m_rx_buffer))
+            if (phy_event.evt_params.rx_buf_request.num_of_bytes <= sizeof (m_rx_buffer[0]))
             {
                 if (HAL_TRANSP_RX_STATE_IDLE == m_rx_state)
                 {
                     m_events_handler(hal_transp_event);
-                    err_code = ser_phy_rx_buf_set(m_rx_buffer);
+                    err_code = ser_phy_rx_buf_set(rx_buf_alloc());
                     APP_ERROR_CHECK(err_code);
                     m_rx_state = HAL_TRANSP_RX_STATE_RECEIVING;
                 }
@@ -203,7 +237,9 @@ static void phy_events_handler(ser_phy_evt_t phy_event)
         {
             if (HAL_TRANSP_RX_STATE_RECEIVING == m_rx_state)
             {
-                m_rx_state = HAL_TRANSP_RX_STATE_RECEIVED;
+                /* The next packet can be received right away if there is a free buffer left. */
+                m_rx_state = rx_buf_available() ? HAL_TRANSP_RX_STATE_IDLE :
+                                                  HAL_TRANSP_RX_STATE_RECEIVED;
                 /* Generate the event to an upper layer. */
                 hal_transp_event.evt_type =
                     SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED;
@@ -273,7 +309,12 @@ static void phy_events_handler(ser_phy_evt_t phy_event)
                 SER_HAL_TRANSP_PHY_ERROR_HW_ERROR;
             hal_transp_event.evt_params.phy_error.hw_error_code =
                 phy_event.evt_params.hw_error.error_code;
-            if (HAL_TRANSP_TX_STATE_TRANSMITTING == m_tx_state)
+            if (NULL == phy_event.evt_params.hw_error.p_buffer)
+            {
+                /* The error is not related to a buffer of this module, for example a packet
+                 * that the PHY layer had copied before it failed to deliver it. */
+            }
+            else if (HAL_TRANSP_TX_STATE_TRANSMITTING == m_tx_state)
             {
                 m_tx_state = HAL_TRANSP_TX_STATE_TRANSMITTED;
                 err_code   = ser_hal_transport_tx_pkt_free(phy_event.evt_params.hw_error.p_buffer);
@@ -304,6 +345,7 @@ static void phy_events_handler(ser_phy_evt_t phy_event)
 
 void ser_hal_transport_reset(void)
 {
+    m_rx_buf_in_use = 0;
     m_rx_state = HAL_TRANSP_RX_STATE_IDLE;
     m_tx_state = HAL_TRANSP_TX_STATE_IDLE;
 }
@@ -325,6 +367,7 @@ uint32_t ser_hal_transport_open(ser_hal_transport_events_handler_t events_handle
         /* We have to change states before calling lower layer because ser_phy_open() function is
          * going to enable interrupts. On success an event from PHY layer can be emitted immediately
          * after return from ser_phy_open(). */
+        m_rx_buf_in_use = 0;
         m_rx_state = HAL_TRANSP_RX_STATE_IDLE;
         m_tx_state = HAL_TRANSP_TX_STATE_IDLE;
 
@@ -368,43 +411,61 @@ uint32_t ser_hal_transport_rx_pkt_free(uint8_t * p_buffer)
 
     NRF_LOG_INFO("rx pkt free:%d", p_buffer);
     uint32_t err_code = NRF_SUCCESS;
+    uint32_t buf_mask = 0;
 
     ser_phy_interrupts_disable();
 
+    for (uint32_t i = 0; i < SER_HAL_TRANSPORT_RX_BUF_COUNT; i++)
+    {
+        if (p_buffer == m_rx_buffer[i])
+        {
+            buf_mask = (1UL << i);
+        }
+    }
+
     if (NULL == p_buffer)
     {
         err_code = NRF_ERROR_NULL;
     }
-    else if (p_buffer != m_rx_buffer)
+    else if (buf_mask == 0)
     {
         err_code = NRF_ERROR_INVALID_ADDR;
     }
-    else if (HAL_TRANSP_RX_STATE_RECEIVED == m_rx_state)
-    {
-        m_rx_state = HAL_TRANSP_RX_STATE_IDLE;
-    }
-    else if (HAL_TRANSP_RX_STATE_RECEIVED_DROPPING == m_rx_state)
+    else if ((m_rx_buf_in_use & buf_mask) == 0)
     {
-        m_rx_state = HAL_TRANSP_RX_STATE_DROPPING;
+        /* Upper layer should not free a buffer twice. */
+        err_code = NRF_ERROR_INVALID_STATE;
     }
-    else if (HAL_TRANSP_RX_STATE_RECEIVED_PENDING_BUF_REQ == m_rx_state)
+    else
     {
-        err_code = ser_phy_rx_buf_set(m_rx_buffer);
+        m_rx_buf_in_use &= ~buf_mask;
 
-        if (NRF_SUCCESS == err_code)
+        if (HAL_TRANSP_RX_STATE_RECEIVED == m_rx_state)
+        {
+            m_rx_state = HAL_TRANSP_RX_STATE_IDLE;
+        }
+        else if (HAL_TRANSP_RX_STATE_RECEIVED_DROPPING == m_rx_state)
+        {
+            m_rx_state = HAL_TRANSP_RX_STATE_DROPPING;
+        }
+        else if (HAL_TRANSP_RX_STATE_RECEIVED_PENDING_BUF_REQ == m_rx_state)
         {
-            m_rx_state = HAL_TRANSP_RX_STATE_RECEIVING;
+            err_code = ser_phy_rx_buf_set(rx_buf_alloc());
+
+            if (NRF_SUCCESS == err_code)
+            {
+                m_rx_state = HAL_TRANSP_RX_STATE_RECEIVING;
+            }
+            else
+            {
+                err_code = NRF_ERROR_INTERNAL;
+            }
         }
         else
         {
-            err_code = NRF_ERROR_INTERNAL;
+            /* Other buffers are still free, so the reception is not affected. */
         }
     }
-    else
-    {
-        /* Upper layer should not call this function in current state. */
-        err_code = NRF_ERROR_INVALID_STATE;
-    }
     ser_phy_interrupts_enable();
 
     return err_code;
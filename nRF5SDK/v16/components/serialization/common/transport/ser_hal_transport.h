@@ -178,7 +178,9 @@ void ser_hal_transport_close(void);
  * @note The function should be called as a response to an event of type
  *       @ref SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED when the received data has beed processed. The function
  *       frees the RX memory pointed by p_buffer. The memory, immediately or at a later time, is
- *       reused by the underlying transport layer.
+ *       reused by the underlying transport layer. With @ref SER_HAL_TRANSPORT_RX_BUF_COUNT greater
+ *       than 1, the next packets are received while the previous ones are held, until all the
+ *       buffers are in use. The buffers can be freed in any order.
  *
  * @param[in] p_buffer    A pointer to the beginning of the buffer that has been processed (has to be
  *                        the same address as provided in the event of type
@@ -183,7 +183,8 @@ typedef struct
 typedef struct
 {
     uint32_t error_code; /**< Hardware error code - specific for a microcontroller. */
-    uint8_t * p_buffer;  /**< Pointer to the buffer that was processed when error occured. */
+    uint8_t * p_buffer;  /**< Pointer to the buffer that was processed when error occured, or NULL
+                          *   if the error does not involve a buffer of the upper layer. */
 } ser_phy_evt_hw_error_params_t;
 
 
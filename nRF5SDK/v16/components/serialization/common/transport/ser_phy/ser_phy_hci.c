@@ -100,7 +100,8 @@ NRF_LOG_MODULE_REGISTER();
 #define HCI_PKT_SYNC_RSP    0x7D02u                                                    /**< Link Control Packet: type SYNC RESPONSE */
 #define HCI_PKT_CONFIG      0xFC03u                                                    /**< Link Control Packet: type CONFIG */
 #define HCI_PKT_CONFIG_RSP  0x7B04u                                                    /**< Link Control Packet: type CONFIG RESPONSE */
-#define HCI_CONFIG_FIELD    0x11u                                                      /**< Configuration field of CONFIG and CONFIG_RSP packet */
+#define HCI_CONFIG_FIELD    (0x10u | SER_PHY_HCI_WINDOW_SIZE)                          /**< Configuration field of CONFIG and CONFIG_RSP packet */
+#define HCI_CONFIG_WINDOW_MASK 0x07u                                                   /**< Sliding Window Size bits of the configuration field. */
 #define HCI_PKT_SYNC_SIZE   6u                                                         /**< Size of SYNC and SYNC_RSP packet */
 #define HCI_PKT_CONFIG_SIZE 7u                                                         /**< Size of CONFIG and CONFIG_RSP packet */
 #define HCI_LINK_CONTROL_PKT_INVALID 0xFFFFu                                           /**< Size of CONFIG and CONFIG_RSP packet */
@@ -115,6 +116,10 @@ NRF_LOG_MODULE_REGISTER();
 #define RETRANSMISSION_TIMEOUT_IN_TICKS (APP_TIMER_TICKS(RETRANSMISSION_TIMEOUT_IN_ms)) /**< Retransmission timeout for application packet in units of timer ticks. */
 #define MAX_RETRY_COUNT                 5                                      /**< Max retransmission retry count for application packets. */
 
+#if (SER_PHY_HCI_WINDOW_SIZE < 1) || (SER_PHY_HCI_WINDOW_SIZE > 7)
+#error "SER_PHY_HCI_WINDOW_SIZE must be in range 1 to 7."
+#endif
+
 #if   (defined(HCI_TIMER0))
 #define HCI_TIMER            NRF_TIMER0
 #define HCI_TIMER_IRQn       TIMER0_IRQn
@@ -136,10 +141,7 @@ NRF_LOG_MODULE_REGISTER();
 typedef enum
 {
     HCI_TX_STATE_DISABLE,
-    HCI_TX_STATE_SEND,
-    HCI_TX_STATE_WAIT_FOR_FIRST_TX_END,
-    HCI_TX_STATE_WAIT_FOR_ACK_OR_TX_END,
-    HCI_TX_STATE_WAIT_FOR_ACK,
+    HCI_TX_STATE_SEND,        /**< No reliable packet is being written by SLIP. */
     HCI_TX_STATE_WAIT_FOR_TX_END
 } hci_tx_fsm_state_t;
 
@@ -148,8 +150,6 @@ typedef enum
     HCI_RX_STATE_DISABLE,
     HCI_RX_STATE_RECEIVE,
     HCI_RX_STATE_WAIT_FOR_MEM,
-    HCI_RX_STATE_WAIT_FOR_SLIP_ACK_END,
-    HCI_RX_STATE_WAIT_FOR_SLIP_NACK_END,
 } hci_rx_fsm_state_t;
 
 typedef enum
@@ -212,12 +212,45 @@ _static uint8_t m_tx_link_control_payload[HCI_PKT_CONFIG_SIZE - PKT_HDR_SIZE];
 static bool m_cfg_sent;
 #endif /* HCI_LINK_CONTROL */
 
+/**@brief Reliable packet kept for retransmission until it is acknowledged.
+ *
+ * @details With a window of one packet, the packet is sent from the buffer of the upper layer,
+ *          which is released when the packet is acknowledged. With a larger window, the packet is
+ *          copied into the slot, so that the buffer of the upper layer can be released at once.
+ */
+typedef struct
+{
+#if (SER_PHY_HCI_WINDOW_SIZE > 1)
+    uint8_t         payload[SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE];
+#endif
+    uint8_t       * p_payload;
+    uint16_t        length;
+} hci_tx_slot_t;
+
 _static uint32_t m_packet_ack_number; // Sequence number counter of the packet expected to be received
-_static uint32_t m_packet_seq_number; // Sequence number counter of the transmitted packet for which acknowledgement packet is waited for
+_static uint32_t m_packet_seq_number; // Sequence number of the oldest transmitted packet for which acknowledgement packet is waited for
 
 
 _static uint32_t m_tx_retry_count;
 
+// Transmit window. Slots are used in order starting at m_tx_slot_first, which holds the packet with
+// sequence number m_packet_seq_number. Counters are relative to m_tx_slot_first.
+_static hci_tx_slot_t m_tx_slots[SER_PHY_HCI_WINDOW_SIZE];
+_static uint8_t       m_tx_window;         // Number of packets that can be unacknowledged, negotiated with peer
+_static uint8_t       m_tx_slot_first;     // Slot of the oldest packet in the window
+_static uint8_t       m_tx_slot_count;     // Packets in the window
+_static uint8_t       m_tx_slot_sent;      // Packets handed to SLIP since the last go-back
+_static uint8_t       m_tx_slot_done;      // Packets whose transmission has ended at least once
+_static uint8_t       m_tx_slip_slot;      // Slot of the packet being written by SLIP
+_static uint8_t       m_tx_slip_pos;       // Window position of the packet being written by SLIP
+_static bool          m_tx_slip_pos_valid; // False if that packet has been acknowledged or dropped meanwhile
+_static uint8_t       m_tx_last_ack;       // Last acknowledge number received
+_static bool          m_tx_fast_retx_done; // Fast retransmission performed for the current window start
+_static bool          m_tx_timer_running;
+
+_static bool m_ack_tx_busy;    // ACK packet is being written by SLIP
+_static bool m_ack_tx_pending; // Another ACK packet is to be sent when the current one ends
+
 
 // _static uint32_t m_tx_retx_counter = 0;
 // _static uint32_t m_rx_drop_counter = 0;
@@ -447,15 +480,15 @@ static __INLINE uint8_t packet_ack_get(void)
 }
 
 
-/**@brief Function for getting the sequence number of a reliable TX packet for which peer protocol
- * entity acknowledgment is pending.
+/**@brief Function for getting the sequence number of a packet in the transmit window.
  *
- * @return sequence number of a reliable TX packet for which peer protocol entity acknowledgement
- * is pending.
+ * @param[in] pos Position of the packet in the window.
+ *
+ * @return sequence number of the packet.
  */
-static __INLINE uint8_t packet_seq_get(void)
+static __INLINE uint8_t packet_seq_get(uint8_t pos)
 {
-    return m_packet_seq_number;
+    return (uint8_t)((m_packet_seq_number + pos) & 0x07u);
 }
 
 
@@ -466,13 +499,15 @@ static __INLINE uint8_t packet_seq_nmbr_extract(const uint8_t * p_buffer)
 
 
 /**@brief Function for constructing 1st byte of the packet header of the packet to be transmitted.
+ *
+ * @param[in] seq Sequence number of the packet.
  *
  * @return 1st byte of the packet header of the packet to be transmitted
  */
-static __INLINE uint8_t tx_packet_byte_zero_construct(void)
+static __INLINE uint8_t tx_packet_byte_zero_construct(uint8_t seq)
 {
     const uint32_t value = DATA_INTEGRITY_MASK | RELIABLE_PKT_MASK |
-                           (packet_ack_get() << 3u) | packet_seq_get();
+                           (packet_ack_get() << 3u) | seq;
 
     return (uint8_t) value;
 }
@@ -499,48 +534,33 @@ static __INLINE uint8_t header_checksum_calculate(const uint8_t * p_hdr)
 }
 
 
-/**@brief Function for getting the expected ACK number.
+/**@brief Function for getting the number of window packets covered by an acknowledge number.
  *
- * @return expected ACK number.
- */
-static __INLINE uint8_t expected_ack_number_get(void)
-{
-    uint8_t seq_nmbr = packet_seq_get();
-
-    ++seq_nmbr;
-    seq_nmbr &= 0x07u;
-
-    return seq_nmbr;
-}
-
-
-/**@brief Function for getting the expected ACK number.
+ * Acknowledgements are cumulative: the acknowledge number is the sequence number of the next packet
+ * the peer expects, so it acknowledges all the packets sent before it.
  *
- * @return next expected ACK number.
+ * @param[in] ack_number Received acknowledge number.
+ *
+ * @return number of packets acknowledged, counted from the start of the window.
  */
-
-static __INLINE uint8_t next_expected_ack_number_get(void)
+static __INLINE uint8_t acked_count_get(uint8_t ack_number)
 {
-    uint8_t seq_nmbr = expected_ack_number_get();
-
-    ++seq_nmbr;
-    seq_nmbr &= 0x07u;
-
-    return seq_nmbr;
+    return (uint8_t)((ack_number - m_packet_seq_number) & 0x07u);
 }
 
 
 /**@brief Function for processing a received acknowledgement packet.
  *
- * Verifies does the received acknowledgement packet has the expected acknowledgement number and
- * that the header checksum is correct.
+ * Verifies that the header checksum of the received acknowledgement packet is correct and that
+ * its acknowledgement number falls within the transmit window.
  *
- * @param[in] p_buffer Pointer to the packet data.
+ * @param[in]  p_buffer       Pointer to the packet data.
+ * @param[out] p_ack_number   Acknowledgement number of the packet.
  *
  * @return true if valid acknowledgement packet received.
  */
 
-static bool rx_ack_pkt_valid(const uint8_t * p_buffer)
+static bool rx_ack_pkt_valid(const uint8_t * p_buffer, uint8_t * p_ack_number)
 {
     // @note: no pointer validation check needed as allready checked by calling function.
 
@@ -553,11 +573,10 @@ static bool rx_ack_pkt_valid(const uint8_t * p_buffer)
         return false;
     }
 
-    const uint8_t ack_number = (p_buffer[0] >> 3u) & 0x07u;
+    *p_ack_number = (p_buffer[0] >> 3u) & 0x07u;
 
-    // Verify expected acknowledgment number.
-    return ( (ack_number == expected_ack_number_get()) ||
-             (ack_number == next_expected_ack_number_get()) );
+    // Verify that acknowledgment number does not go beyond the packets in the window.
+    return (acked_count_get(*p_ack_number) <= m_tx_slot_count);
 }
 
 
@@ -633,12 +652,14 @@ static uint16_t link_control_packet_decode(const uint8_t * p_buffer, uint32_t le
         {
             packet_type = HCI_LINK_CONTROL_PKT_INVALID;
         }
-        // Verify configuration field (0x11):
-        // - Sliding Window Size       == 1,
+        // Verify configuration field (0x1N):
+        // - Sliding Window Size       == 1 to 7,
         // - OOF Flow Control          == 0,
         // - Data Integrity Check Type == 1,
         // - Version Number            == 0
-        if (p_buffer[HCI_PKT_CONFIG_SIZE - 1] != HCI_CONFIG_FIELD)
+        if (((p_buffer[HCI_PKT_CONFIG_SIZE - 1] & ~HCI_CONFIG_WINDOW_MASK) !=
+             (HCI_CONFIG_FIELD & ~HCI_CONFIG_WINDOW_MASK)) ||
+            ((p_buffer[HCI_PKT_CONFIG_SIZE - 1] & HCI_CONFIG_WINDOW_MASK) == 0))
         {
             packet_type = HCI_LINK_CONTROL_PKT_INVALID;
         }
@@ -690,6 +711,26 @@ static void ack_transmit(void)
 }
 
 
+/**@brief Function for requesting transmission of an acknowledgment packet.
+ *
+ * @details If an acknowledgment packet is already being sent, the request is held until it ends.
+ *          All the requests made meanwhile are then served by a single packet carrying the latest
+ *          acknowledge number.
+ */
+static void ack_request(void)
+{
+    if (m_ack_tx_busy)
+    {
+        m_ack_tx_pending = true;
+    }
+    else
+    {
+        m_ack_tx_busy = true;
+        ack_transmit();
+    }
+}
+
+
 static void ser_phy_event_callback(ser_phy_evt_t event)
 {
     if (m_ser_phy_callback)
@@ -748,7 +789,12 @@ static void packet_transmitted_callback(void)
 }
 
 
-static void error_callback(void)
+/**@brief Function for reporting a packet that was dropped because it was not acknowledged.
+ *
+ * @param[in] p_buffer Buffer of the upper layer that held the packet, or NULL if the packet had
+ *                     already been copied and its buffer released.
+ */
+static void error_callback(uint8_t * p_buffer)
 {
     ser_phy_evt_t event;
 
@@ -756,7 +802,8 @@ static void error_callback(void)
 
     NRF_LOG_DEBUG("no ack");
     event.evt_type = SER_PHY_EVT_HW_ERROR;
-    event.evt_params.hw_error.p_buffer = m_p_tx_payload;
+    event.evt_params.hw_error.error_code = NRF_ERROR_TIMEOUT;
+    event.evt_params.hw_error.p_buffer   = p_buffer;
     ser_phy_event_callback(event);
 }
 
@@ -892,16 +939,16 @@ static void hci_slip_event_handler(ser_phy_hci_slip_evt_t * p_event)
 }
 
 
-static void hci_pkt_send(void)
+static void hci_pkt_send(hci_tx_slot_t * p_slot, uint8_t seq)
 {
     uint32_t err_code;
 
-    m_tx_packet_header[0] = tx_packet_byte_zero_construct();
-    uint16_t type_and_length_fields = ((m_tx_payload_length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);
+    m_tx_packet_header[0] = tx_packet_byte_zero_construct(seq);
+    uint16_t type_and_length_fields = ((p_slot->length << 4u) | PKT_TYPE_VENDOR_SPECIFIC);
     (void)uint16_encode(type_and_length_fields, &(m_tx_packet_header[1]));
     m_tx_packet_header[3] = header_checksum_calculate(m_tx_packet_header);
     uint16_t crc = crc16_compute(m_tx_packet_header, PKT_HDR_SIZE, NULL);
-    crc = crc16_compute(m_p_tx_payload, m_tx_payload_length, &crc);
+    crc = crc16_compute(p_slot->p_payload, p_slot->length, &crc);
     (void)uint16_encode(crc, m_tx_packet_crc);
 
     ser_phy_hci_pkt_params_t pkt_header;
@@ -910,13 +957,13 @@ static void hci_pkt_send(void)
 
     pkt_header.p_buffer      = m_tx_packet_header;
     pkt_header.num_of_bytes  = PKT_HDR_SIZE;
-    pkt_payload.p_buffer     = m_p_tx_payload;
-    pkt_payload.num_of_bytes = m_tx_payload_length;
+    pkt_payload.p_buffer     = p_slot->p_payload;
+    pkt_payload.num_of_bytes = p_slot->length;
     pkt_crc.p_buffer         = m_tx_packet_crc;
     pkt_crc.num_of_bytes     = PKT_CRC_SIZE;
     DEBUG_EVT_SLIP_PACKET_TX(0);
     err_code = ser_phy_hci_slip_tx_pkt_send(&pkt_header, &pkt_payload, &pkt_crc);
-    NRF_LOG_DEBUG("Started TX packet (payload %d).", m_tx_payload_length);
+    NRF_LOG_DEBUG("Started TX packet (seq %d, payload %d).", seq, p_slot->length);
     ser_phy_hci_assert(err_code == NRF_SUCCESS);
 
     return;
@@ -973,17 +1020,6 @@ static void hci_link_control_pkt_send(void)
 }
 #endif /* HCI_LINK_CONTROL */
 
-static void hci_pkt_sent_upcall(void)
-{
-    m_packet_seq_number++; // incoming ACK is valid, increment SEQ
-    m_packet_seq_number &= 0x07u;
-    m_p_tx_payload       = NULL;
-    packet_transmitted_callback();
-
-    return;
-}
-
-
 static void hci_release_ack_buffer(hci_evt_t * p_event)
 {
     uint32_t err_code;
@@ -996,133 +1032,267 @@ static void hci_release_ack_buffer(hci_evt_t * p_event)
 }
 
 
-static void hci_process_orphaned_ack(hci_evt_t * p_event)
+/**@brief Function for clearing the transmit window. Sequence numbering continues. */
+static void tx_window_clear(void)
 {
-    hci_release_ack_buffer(p_event);
-    return;
+    m_tx_slot_count     = 0;
+    m_tx_slot_sent      = 0;
+    m_tx_slot_done      = 0;
+    m_tx_slip_pos_valid = false;
+    m_tx_fast_retx_done = false;
+    m_tx_last_ack       = (uint8_t)m_packet_seq_number;
 }
 
-/* main tx fsm   */
-static void hci_tx_fsm_event_process(hci_evt_t * p_event)
+
+/**@brief Function for resetting the transmit window and the acknowledgement state. */
+static void hci_window_reset(void)
 {
+    m_tx_slot_first    = 0;
+    m_tx_window        = SER_PHY_HCI_WINDOW_SIZE;
+    m_tx_timer_running = false;
+    m_ack_tx_busy      = false;
+    m_ack_tx_pending   = false;
+    tx_window_clear();
+}
+
 
-    switch (m_hci_tx_fsm_state)
+/**@brief Function for moving the packet requested by the upper layer into the transmit window.
+ *
+ * @details With a window larger than one packet, the packet is copied, so the upper layer is
+ *          notified that it has been sent and may prepare the next one while the previous ones
+ *          are waiting for acknowledgement. Otherwise it is sent from the buffer of the upper
+ *          layer, which is notified when the packet is acknowledged.
+ */
+static void tx_window_packet_accept(void)
+{
+    if ((m_p_tx_payload == NULL) || (m_tx_slot_count >= m_tx_window))
     {
-        case HCI_TX_STATE_SEND:
+        return;
+    }
 
-            if ((p_event->evt_source == HCI_SER_PHY_EVT) &&
-                (p_event->evt.ser_phy_evt.evt_type == HCI_SER_PHY_TX_REQUEST))
-            {
-                hci_pkt_send();
-                hci_timeout_setup(0);
-                m_tx_retry_count   = MAX_RETRY_COUNT;
-                m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_FIRST_TX_END;
-            }
-            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
-            {
-                hci_process_orphaned_ack(p_event);
-            }
+    uint8_t slot = (m_tx_slot_first + m_tx_slot_count) % SER_PHY_HCI_WINDOW_SIZE;
 
-            break;
+    // SLIP may still be reading the slot, if its packet has been acknowledged or dropped.
+    if ((m_hci_tx_fsm_state == HCI_TX_STATE_WAIT_FOR_TX_END) && (slot == m_tx_slip_slot))
+    {
+        return;
+    }
 
-        case HCI_TX_STATE_WAIT_FOR_FIRST_TX_END:
+#if (SER_PHY_HCI_WINDOW_SIZE > 1)
+    memcpy(m_tx_slots[slot].payload, m_p_tx_payload, m_tx_payload_length);
+    m_tx_slots[slot].p_payload = m_tx_slots[slot].payload;
+#else
+    m_tx_slots[slot].p_payload = m_p_tx_payload;
+#endif
+    m_tx_slots[slot].length = m_tx_payload_length;
 
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT))
-            {
-                hci_timeout_setup(1);
-                m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_ACK;
-            }
-            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
-            {
-                hci_process_orphaned_ack(p_event);
-            }
-            break;
+    if (m_tx_slot_count++ == 0)
+    {
+        m_tx_retry_count = MAX_RETRY_COUNT;
+    }
 
-        case HCI_TX_STATE_WAIT_FOR_ACK_OR_TX_END:
+#if (SER_PHY_HCI_WINDOW_SIZE > 1)
+    m_p_tx_payload = NULL;
+    packet_transmitted_callback();
+#endif
+}
 
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT))
-            {
-                hci_timeout_setup(1);
-                m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_ACK;
-            }
-            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
-            {
-                if (rx_ack_pkt_valid(p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer))
-                {
-                    hci_timeout_setup(0);
-                    m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_TX_END;
-                }
-                hci_release_ack_buffer(p_event);
-            }
-            break;
 
-        case HCI_TX_STATE_WAIT_FOR_ACK:
+/**@brief Function for handing the next packet of the transmit window to SLIP. */
+static void tx_window_send(void)
+{
+    if ((m_hci_tx_fsm_state != HCI_TX_STATE_SEND) || (m_tx_slot_sent >= m_tx_slot_count))
+    {
+        return;
+    }
 
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
-            {
-                if (rx_ack_pkt_valid(p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer))
-                {
-                    hci_timeout_setup(0);
-                    hci_pkt_sent_upcall();
-                    m_hci_tx_fsm_state = HCI_TX_STATE_SEND;
-                }
-                hci_release_ack_buffer(p_event);
-            }
-            else if (p_event->evt_source == HCI_TIMER_EVT)
-            {
-                m_tx_retry_count--;
-                // m_tx_retx_counter++; // global retransmissions counter
-                if (m_tx_retry_count)
-                {
-                    NRF_LOG_DEBUG("Timeout, no ACK. Retrying tx packet.");
-                    hci_pkt_send();
-                    DEBUG_HCI_RETX(0);
-                    m_hci_tx_fsm_state = HCI_TX_STATE_WAIT_FOR_ACK_OR_TX_END;
-                }
-                else
-                {
-                    error_callback();
-                    m_hci_tx_fsm_state = HCI_TX_STATE_SEND;
-                    NRF_LOG_WARNING("Timeout, no ACK. Dropping.");
-                }
-            }
-            break;
+    m_tx_slip_pos       = m_tx_slot_sent++;
+    m_tx_slip_slot      = (m_tx_slot_first + m_tx_slip_pos) % SER_PHY_HCI_WINDOW_SIZE;
+    m_tx_slip_pos_valid = true;
+    m_hci_tx_fsm_state  = HCI_TX_STATE_WAIT_FOR_TX_END;
 
-        case HCI_TX_STATE_WAIT_FOR_TX_END:
+    hci_pkt_send(&m_tx_slots[m_tx_slip_slot], packet_seq_get(m_tx_slip_pos));
+}
 
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT))
-            {
-                hci_pkt_sent_upcall();
-                m_hci_tx_fsm_state = HCI_TX_STATE_SEND;
-            }
-            else if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
+
+/**@brief Function for restarting the retransmission timer, or stopping it if no packet sent is
+ *        waiting for acknowledgement. */
+static void tx_timer_update(void)
+{
+    m_tx_timer_running = (m_tx_slot_done != 0);
+    hci_timeout_setup(m_tx_timer_running ? 1 : 0);
+}
+
+
+/**@brief Function for removing acknowledged packets from the transmit window.
+ *
+ * @details Only packets whose transmission has ended are removed, as SLIP may still be reading
+ *          the others. Acknowledgements that arrive before the end of transmission is reported are
+ *          applied when it is.
+ *
+ * @param[in] ack_number Received acknowledge number.
+ */
+static void tx_window_advance(uint8_t ack_number)
+{
+    uint8_t acked = acked_count_get(ack_number);
+
+    if (acked > m_tx_slot_done)
+    {
+        acked = m_tx_slot_done;
+    }
+
+    if (acked == 0)
+    {
+        return;
+    }
+
+    m_packet_seq_number  = (m_packet_seq_number + acked) & 0x07u;
+    m_tx_slot_first      = (m_tx_slot_first + acked) % SER_PHY_HCI_WINDOW_SIZE;
+    m_tx_slot_count     -= acked;
+    m_tx_slot_done      -= acked;
+    m_tx_slot_sent       = (m_tx_slot_sent > acked) ? (m_tx_slot_sent - acked) : 0;
+    m_tx_retry_count     = MAX_RETRY_COUNT;
+    m_tx_fast_retx_done  = false;
+
+    if (m_tx_slip_pos_valid)
+    {
+        if (m_tx_slip_pos < acked)
+        {
+            m_tx_slip_pos_valid = false;
+        }
+        else
+        {
+            m_tx_slip_pos -= acked;
+        }
+    }
+
+#if (SER_PHY_HCI_WINDOW_SIZE == 1)
+    // The packet was sent from the buffer of the upper layer, which can be released now.
+    m_p_tx_payload = NULL;
+    packet_transmitted_callback();
+#endif
+
+    tx_timer_update();
+    tx_window_packet_accept();
+}
+
+
+/**@brief Function for going back to the oldest unacknowledged packet and sending the window again. */
+static void tx_window_go_back(void)
+{
+    m_tx_slot_sent = 0;
+    DEBUG_HCI_RETX(0);
+    tx_window_send();
+}
+
+
+/* main tx fsm   */
+static void hci_tx_fsm_event_process(hci_evt_t * p_event)
+{
+    uint8_t ack_number;
+
+    if (m_hci_tx_fsm_state == HCI_TX_STATE_DISABLE)
+    {
+#ifdef HCI_LINK_CONTROL
+        /* This case should not happen if HCI is in ACTIVE mode */
+        ser_phy_hci_assert(m_hci_mode != HCI_MODE_ACTIVE);
+#else
+        ser_phy_hci_assert(false);
+#endif /* HCI_LINK_CONTROL */
+        return;
+    }
+
+    if ((p_event->evt_source == HCI_SER_PHY_EVT) &&
+        (p_event->evt.ser_phy_evt.evt_type == HCI_SER_PHY_TX_REQUEST))
+    {
+        tx_window_packet_accept();
+        tx_window_send();
+    }
+    else if ((p_event->evt_source == HCI_SLIP_EVT) &&
+             (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_SENT) &&
+             (m_hci_tx_fsm_state == HCI_TX_STATE_WAIT_FOR_TX_END))
+    {
+        m_hci_tx_fsm_state = HCI_TX_STATE_SEND;
+
+        if (m_tx_slip_pos_valid && (m_tx_slip_pos >= m_tx_slot_done))
+        {
+            m_tx_slot_done = m_tx_slip_pos + 1;
+        }
+        m_tx_slip_pos_valid = false;
+
+        if (!m_tx_timer_running && (m_tx_slot_done != 0))
+        {
+            m_tx_timer_running = true;
+            hci_timeout_setup(1);
+        }
+
+        tx_window_advance(m_tx_last_ack);
+        tx_window_packet_accept();
+        tx_window_send();
+    }
+    else if ((p_event->evt_source == HCI_SLIP_EVT) &&
+             (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
+    {
+        if (rx_ack_pkt_valid(p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer,
+                             &ack_number))
+        {
+            // An acknowledge number that does not move the window while sent packets wait for
+            // acknowledgement is sent by the peer when it drops an out-of-order packet. The
+            // packet at the start of the window was lost, so retransmit without waiting for
+            // the timeout. Do it once per window start, as the peer may drop several packets.
+            if ((acked_count_get(ack_number) == 0) && (m_tx_slot_done != 0) &&
+                !m_tx_fast_retx_done)
             {
-                hci_process_orphaned_ack(p_event);
+                NRF_LOG_DEBUG("Duplicate ACK. Retransmitting window.");
+                m_tx_fast_retx_done = true;
+                tx_window_go_back();
             }
 
-            break;
+            m_tx_last_ack = ack_number;
+            tx_window_advance(ack_number);
+            tx_window_send();
+        }
+        hci_release_ack_buffer(p_event);
+    }
+    else if (p_event->evt_source == HCI_TIMER_EVT)
+    {
+        if (!m_tx_timer_running)
+        {
+            return;
+        }
+        m_tx_timer_running = false;
+        hci_timeout_setup(0);
 
-#ifdef HCI_LINK_CONTROL
-        case HCI_TX_STATE_DISABLE:
-            /* This case should not happen if HCI is in ACTIVE mode */
-            if (m_hci_mode == HCI_MODE_ACTIVE)
+        m_tx_retry_count--;
+        // m_tx_retx_counter++; // global retransmissions counter
+        if (m_tx_retry_count)
+        {
+            NRF_LOG_DEBUG("Timeout, no ACK. Retrying tx packet.");
+            tx_window_go_back();
+        }
+        else
+        {
+            // Drop the window and report each of its packets, so that the upper layer can go on.
+            uint8_t dropped = m_tx_slot_count;
+
+            tx_window_clear();
+            NRF_LOG_WARNING("Timeout, no ACK. Dropping %d packet(s).", dropped);
+#if (SER_PHY_HCI_WINDOW_SIZE > 1)
+            // The buffers of the dropped packets have been released already. A packet waiting for
+            // the window has not been sent yet and takes its place.
+            for (uint8_t i = 0; i < dropped; i++)
             {
-                ser_phy_hci_assert(false);
+                error_callback(NULL);
             }
-            break;
-#endif /* HCI_LINK_CONTROL */
+            tx_window_packet_accept();
+            tx_window_send();
+#else
+            uint8_t * p_dropped = m_p_tx_payload;
 
-        default:
-            ser_phy_hci_assert(false);
-            break;
+            m_p_tx_payload = NULL;
+            error_callback(p_dropped);
+#endif
+        }
     }
 }
 
@@ -1147,6 +1317,18 @@ static void hci_inc_ack()
 
 static void hci_rx_fsm_event_process(hci_evt_t * p_event)
 {
+    if ((p_event->evt_source == HCI_SLIP_EVT) &&
+        (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_ACK_SENT))
+    {
+        m_ack_tx_busy = false;
+        if (m_ack_tx_pending)
+        {
+            m_ack_tx_pending = false;
+            ack_request();
+        }
+        return;
+    }
+
     switch (m_hci_rx_fsm_state)
     {
         case HCI_RX_STATE_RECEIVE:
@@ -1166,9 +1348,9 @@ static void hci_rx_fsm_event_process(hci_evt_t * p_event)
                 else
                 {
                     // m_rx_drop_counter++;
-                    m_hci_rx_fsm_state = HCI_RX_STATE_WAIT_FOR_SLIP_NACK_END;
-                    (void) ser_phy_hci_slip_rx_buf_free(m_p_rx_packet); // and drop a packet
-                    ack_transmit();                                     // send NACK with valid ACK
+                    (void) ser_phy_hci_slip_rx_buf_free(
+                        p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer); // and drop a packet
+                    ack_request();                                                       // send NACK with valid ACK
                 }
             }
             break;
@@ -1183,20 +1365,11 @@ static void hci_rx_fsm_event_process(hci_evt_t * p_event)
                     memcpy(m_p_rx_buffer,
                            m_p_rx_packet + PKT_HDR_SIZE,
                            m_rx_packet_length - PKT_HDR_SIZE - PKT_CRC_SIZE);
-                    (void) ser_phy_hci_slip_rx_buf_free(m_p_rx_packet);
                 }
-                m_hci_rx_fsm_state = HCI_RX_STATE_WAIT_FOR_SLIP_ACK_END;
+                (void) ser_phy_hci_slip_rx_buf_free(m_p_rx_packet);
+                m_hci_rx_fsm_state = HCI_RX_STATE_RECEIVE;
                 hci_inc_ack(); // SEQ was valid for good packet, we will send incremented SEQ as ACK
-                ack_transmit();
-            }
-
-            break;
-
-        case HCI_RX_STATE_WAIT_FOR_SLIP_ACK_END:
-
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-                (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_ACK_SENT))
-            {
+                ack_request();
 
                 if (m_p_rx_buffer)
                 {
@@ -1207,7 +1380,6 @@ static void hci_rx_fsm_event_process(hci_evt_t * p_event)
                 {
                     packet_dropped_callback();
                 }
-                m_hci_rx_fsm_state = HCI_RX_STATE_RECEIVE;
             }
             else if ((p_event->evt_source == HCI_SLIP_EVT) &&
                     (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED))
@@ -1216,19 +1388,6 @@ static void hci_rx_fsm_event_process(hci_evt_t * p_event)
             }
             break;
 
-        case HCI_RX_STATE_WAIT_FOR_SLIP_NACK_END:
-            if ((p_event->evt_source == HCI_SLIP_EVT) &&
-               (p_event->evt.ser_phy_slip_evt.evt_type == SER_PHY_HCI_SLIP_EVT_ACK_SENT))
-            {
-               m_hci_rx_fsm_state = HCI_RX_STATE_RECEIVE;
-            }
-            else
-            {
-               (void) ser_phy_hci_slip_rx_buf_free(p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer);
-            }
-            break;
-
-
 #ifdef HCI_LINK_CONTROL
         case HCI_RX_STATE_DISABLE:
             if (m_hci_mode == HCI_MODE_ACTIVE)
@@ -1411,6 +1570,18 @@ static void hci_rx_event_handler(hci_evt_t * p_event)
 }
 
 #ifdef HCI_LINK_CONTROL
+/**@brief Function for limiting the transmit window to the window size announced by the peer.
+ *
+ * @param[in] p_buffer Pointer to a valid CONFIG or CONFIG_RSP packet.
+ */
+static void hci_window_negotiate(const uint8_t * p_buffer)
+{
+    uint8_t peer_window = p_buffer[HCI_PKT_CONFIG_SIZE - 1] & HCI_CONFIG_WINDOW_MASK;
+
+    m_tx_window = MIN(SER_PHY_HCI_WINDOW_SIZE, peer_window);
+}
+
+
 /* Link control event handler - used only for Link Control packets */
 /* This handler will be called only in 2 cases:
    - when SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED event is received
@@ -1437,6 +1608,7 @@ static void hci_link_control_event_handler(hci_evt_t * p_event)
                         m_hci_mode          = HCI_MODE_UNINITIALIZED;
                         m_packet_ack_number = INITIAL_ACK_NUMBER_EXPECTED;
                         m_packet_seq_number = INITIAL_SEQ_NUMBER;
+                        hci_window_reset();
                         m_hci_tx_fsm_state  = HCI_TX_STATE_DISABLE;
                         m_hci_rx_fsm_state  = HCI_RX_STATE_DISABLE;
                         m_hci_other_side_active = false;
@@ -1457,6 +1629,8 @@ static void hci_link_control_event_handler(hci_evt_t * p_event)
                 case HCI_PKT_CONFIG:
                     if (m_hci_mode != HCI_MODE_UNINITIALIZED)
                     {
+                        hci_window_negotiate(
+                            p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer);
                         if (m_cfg_sent)
                         {
                             m_hci_link_control_next_pkt = HCI_PKT_CONFIG_RSP;
@@ -1473,6 +1647,8 @@ static void hci_link_control_event_handler(hci_evt_t * p_event)
                 case HCI_PKT_CONFIG_RSP:
                     if (m_hci_mode == HCI_MODE_INITIALIZED)
                     {
+                        hci_window_negotiate(
+                            p_event->evt.ser_phy_slip_evt.evt_params.received_pkt.p_buffer);
                         m_hci_mode          = HCI_MODE_ACTIVE;
                         m_hci_tx_fsm_state  = HCI_TX_STATE_SEND;
                         m_hci_rx_fsm_state  = HCI_RX_STATE_RECEIVE;
@@ -1679,6 +1855,7 @@ void ser_phy_hci_reset(void)
     (void)hci_timer_reset();
     m_packet_ack_number = INITIAL_ACK_NUMBER_EXPECTED;
     m_packet_seq_number = INITIAL_SEQ_NUMBER;
+    hci_window_reset();
 
 #ifndef HCI_LINK_CONTROL
     m_hci_tx_fsm_state  = HCI_TX_STATE_SEND;
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup ser_phy_posix POSIX UART Serialization PHY
+ * @{
+ * @ingroup ble_sdk_lib_serialization
+ *
+ * @brief UART PHY layer for serialization running on a POSIX host.
+ *
+ * @details Implements @ref ser_phy.h on top of a serial device (for example /dev/ttyACM0) or
+ *          a pseudo-terminal, so that the application side of serialization can run on a PC
+ *          and drive a connectivity chip. The framing is the same as in the UART PHY
+ *          (ser_phy_uart.c): every packet is preceded by its length, encoded on
+ *          @ref SER_PHY_HEADER_SIZE bytes.
+ *
+ *          There are no interrupts on the host. All the PHY events are generated from
+ *          @ref ser_phy_posix_process, which must be called by the thread that uses
+ *          the serialization API. The POSIX application HAL calls it from sd_app_evt_wait.
+ */
+
+#ifndef SER_PHY_POSIX_H__
+#define SER_PHY_POSIX_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Function for selecting the serial device used by the PHY.
+ *
+ * @note Must be called before @ref ser_phy_open. If it is not called, @ref SER_PHY_POSIX_DEVICE
+ *       is used.
+ *
+ * @param[in] p_device Path to the serial device or to the pseudo-terminal.
+ *
+ * @retval NRF_SUCCESS             Device selected.
+ * @retval NRF_ERROR_NULL          NULL pointer supplied.
+ * @retval NRF_ERROR_INVALID_STATE The PHY is already open.
+ */
+uint32_t ser_phy_posix_device_set(char const * p_device);
+
+/**@brief Function for performing the pending serial port I/O and generating the PHY events.
+ *
+ * @details Writes the pending part of the transmitted packet and reads the bytes available
+ *          from the serial port. The events are passed to the handler registered in
+ *          @ref ser_phy_open from the context of this function. Nothing is done while the PHY
+ *          interrupts are disabled (see @ref ser_phy_interrupts_disable).
+ *
+ *          If the serial port fails, @ref SER_PHY_EVT_HW_ERROR is generated once, with the
+ *          buffer of the abandoned packet. After that, the port is not used and
+ *          @ref ser_phy_tx_pkt_send returns NRF_ERROR_INVALID_STATE until the PHY is closed
+ *          and opened again.
+ *
+ * @param[in] timeout_ms Maximum time (in milliseconds) to wait for the serial port to become
+ *                       ready, if there is nothing to do immediately.
+ *
+ * @retval NRF_SUCCESS             I/O performed or timeout expired.
+ * @retval NRF_ERROR_INVALID_STATE The PHY is not open.
+ */
+uint32_t ser_phy_posix_process(uint32_t timeout_ms);
+
+/**@brief Function for setting the level of the DTR line of the serial port.
+ *
+ * @details The line can be wired to the reset pin of the connectivity chip. The level is
+ *          remembered and applied when the port is opened.
+ *
+ * @param[in] level Level of the line.
+ */
+void ser_phy_posix_dtr_set(bool level);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SER_PHY_POSIX_H__ */
+/** @} */
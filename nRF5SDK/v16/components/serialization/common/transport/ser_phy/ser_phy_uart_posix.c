@@ -0,0 +1,548 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "ser_phy.h"
+#include "ser_phy_posix.h"
+#include "ser_config.h"
+#include "app_error.h"
+#include "app_util.h"
+// The system headers go last: termios.h defines macros (B0, B1200, ...) that clash with
+// register names in the device headers included by ser_config.h.
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+/** Termios speed matching the UART PHY baud rate. */
+#define UART_POSIX_BAUDRATE     CONCAT_2(B, SER_PHY_UART_BAUDRATE_VAL)
+
+#define RX_BUF_SIZE             256     /**< Size of the buffer for bytes read from the port. */
+
+typedef enum
+{
+    RX_STATE_HEADER,      /**< Receiving packet length. */
+    RX_STATE_BUF_REQUEST, /**< Waiting for the upper layer to provide the buffer. */
+    RX_STATE_PAYLOAD,     /**< Receiving packet data. */
+    RX_STATE_DROP,        /**< Dropping packet data. */
+} rx_state_t;
+
+static char const *    mp_device = SER_PHY_POSIX_DEVICE;
+static int             m_fd      = -1;
+static bool            m_dtr_level;
+static bool            m_irq_enabled;
+static bool            m_hw_error;       /**< The port failed. No I/O is done until it is reopened. */
+static uint32_t        m_hw_error_code;  /**< errno of the failure, until it is reported. */
+
+static bool            m_tx_in_progress;
+static bool            m_tx_done;
+static uint8_t         m_tx_header_buf[SER_PHY_HEADER_SIZE];
+static uint16_t        m_tx_header_index;
+static uint16_t        m_tx_index;
+static uint16_t        m_bytes_to_transmit;
+static uint8_t const * mp_tx_buffer;
+
+static uint8_t         m_rx_buf[RX_BUF_SIZE];
+static uint16_t        m_rx_buf_head;
+static uint16_t        m_rx_buf_tail;
+static rx_state_t      m_rx_state;
+static uint8_t         m_rx_header_buf[SER_PHY_HEADER_SIZE];
+static uint16_t        m_rx_index;
+static uint16_t        m_bytes_to_receive;
+
+static ser_phy_events_handler_t m_ser_phy_event_handler;
+static ser_phy_evt_t m_ser_phy_rx_event;
+
+
+static void packet_sent_callback(void)
+{
+    static ser_phy_evt_t const event = {
+        .evt_type = SER_PHY_EVT_TX_PKT_SENT,
+    };
+    m_ser_phy_event_handler(event);
+}
+
+static void buffer_request_callback(uint16_t num_of_bytes)
+{
+    m_ser_phy_rx_event.evt_type = SER_PHY_EVT_RX_BUF_REQUEST;
+    m_ser_phy_rx_event.evt_params.rx_buf_request.num_of_bytes = num_of_bytes;
+    m_ser_phy_event_handler(m_ser_phy_rx_event);
+}
+
+static void packet_received_callback(void)
+{
+    m_ser_phy_event_handler(m_ser_phy_rx_event);
+}
+
+static void packet_dropped_callback(void)
+{
+    static ser_phy_evt_t const event = {
+        .evt_type = SER_PHY_EVT_RX_PKT_DROPPED,
+    };
+    m_ser_phy_event_handler(event);
+}
+
+/**@brief Function for reporting the failure of the port.
+ *
+ * @details The packet being transmitted is abandoned and its buffer is passed with the event,
+ *          so that the upper layer can release it. If no packet is being transmitted, the buffer
+ *          of the packet being received is passed instead, or NULL if there is none.
+ */
+static void hardware_error_callback(void)
+{
+    ser_phy_evt_t event = {
+        .evt_type = SER_PHY_EVT_HW_ERROR,
+        .evt_params.hw_error.error_code = m_hw_error_code,
+        .evt_params.hw_error.p_buffer   = NULL,
+    };
+
+    if (m_tx_in_progress)
+    {
+        event.evt_params.hw_error.p_buffer = (uint8_t *)mp_tx_buffer;
+        m_tx_in_progress = false;
+        m_tx_done        = false;
+    }
+    else if (m_rx_state == RX_STATE_PAYLOAD)
+    {
+        event.evt_params.hw_error.p_buffer =
+            m_ser_phy_rx_event.evt_params.rx_pkt_received.p_buffer;
+    }
+    m_hw_error_code = 0;
+
+    m_ser_phy_event_handler(event);
+}
+
+/**@brief Function for stopping the I/O after a failure of the port.
+ *
+ * @details Only the first failure is kept. It is reported from @ref ser_phy_posix_process, as
+ *          the upper layer does not expect events from the API calls.
+ */
+static void port_error_set(int error)
+{
+    if (!m_hw_error)
+    {
+        m_hw_error      = true;
+        m_hw_error_code = (uint32_t)error;
+    }
+}
+
+static void dtr_apply(void)
+{
+    int modem_bits = TIOCM_DTR;
+
+    // Not every device has modem lines (a pseudo-terminal does not), so the result is ignored.
+    (void)ioctl(m_fd, m_dtr_level ? TIOCMBIS : TIOCMBIC, &modem_bits);
+}
+
+static uint32_t port_open(void)
+{
+    struct termios tty;
+
+    m_fd = open(mp_device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (m_fd < 0)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    if (tcgetattr(m_fd, &tty) != 0)
+    {
+        (void)close(m_fd);
+        m_fd = -1;
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // Raw 8-bit transfer with the parameters of the UART PHY: even parity and RTS/CTS flow
+    // control (see SER_PHY_UART_PARITY and SER_PHY_UART_FLOW_CTRL). The settings that do not
+    // apply to a pseudo-terminal are ignored by the kernel.
+    cfmakeraw(&tty);
+    tty.c_cflag |= (CLOCAL | CREAD | PARENB | CRTSCTS);
+    tty.c_cflag &= ~(PARODD | CSTOPB);
+    tty.c_cc[VMIN]  = 0;
+    tty.c_cc[VTIME] = 0;
+    (void)cfsetispeed(&tty, UART_POSIX_BAUDRATE);
+    (void)cfsetospeed(&tty, UART_POSIX_BAUDRATE);
+
+    if (tcsetattr(m_fd, TCSANOW, &tty) != 0)
+    {
+        (void)close(m_fd);
+        m_fd = -1;
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    (void)tcflush(m_fd, TCIOFLUSH);
+    dtr_apply();
+
+    return NRF_SUCCESS;
+}
+
+/**@brief Function for writing as much of the packet being transmitted as the port accepts. */
+static void packet_tx_continue(void)
+{
+    while (m_tx_in_progress && !m_tx_done && !m_hw_error)
+    {
+        uint8_t const * p_data;
+        size_t          len;
+        ssize_t         written;
+
+        if (m_tx_header_index < SER_PHY_HEADER_SIZE)
+        {
+            p_data = &m_tx_header_buf[m_tx_header_index];
+            len    = SER_PHY_HEADER_SIZE - m_tx_header_index;
+        }
+        else
+        {
+            p_data = &mp_tx_buffer[m_tx_index];
+            len    = m_bytes_to_transmit - m_tx_index;
+        }
+
+        written = write(m_fd, p_data, len);
+        if (written < 0)
+        {
+            if ((errno != EAGAIN) && (errno != EINTR))
+            {
+                port_error_set(errno);
+            }
+            return;
+        }
+
+        if (m_tx_header_index < SER_PHY_HEADER_SIZE)
+        {
+            m_tx_header_index += (uint16_t)written;
+        }
+        else
+        {
+            m_tx_index += (uint16_t)written;
+            m_tx_done   = (m_tx_index == m_bytes_to_transmit);
+        }
+    }
+}
+
+/**@brief Function for passing the bytes read from the port to the packet being received. */
+static void packet_rx_continue(void)
+{
+    while ((m_rx_state != RX_STATE_BUF_REQUEST) && !m_hw_error)
+    {
+        uint16_t available = m_rx_buf_head - m_rx_buf_tail;
+        uint16_t len;
+
+        if ((m_rx_state != RX_STATE_HEADER) && (m_rx_index == m_bytes_to_receive))
+        {
+            rx_state_t state = m_rx_state;
+
+            m_rx_index = 0;
+            m_rx_state = RX_STATE_HEADER;
+            if (state == RX_STATE_PAYLOAD)
+            {
+                packet_received_callback();
+            }
+            else
+            {
+                packet_dropped_callback();
+            }
+        }
+        else if (available == 0)
+        {
+            break;
+        }
+        else if (m_rx_state == RX_STATE_HEADER)
+        {
+            m_rx_header_buf[m_rx_index++] = m_rx_buf[m_rx_buf_tail++];
+            if (m_rx_index == SER_PHY_HEADER_SIZE)
+            {
+                m_bytes_to_receive = uint16_decode(m_rx_header_buf);
+                m_rx_index         = 0;
+                m_rx_state         = RX_STATE_BUF_REQUEST;
+                buffer_request_callback(m_bytes_to_receive);
+            }
+        }
+        else
+        {
+            len = MIN(available, m_bytes_to_receive - m_rx_index);
+            if (m_rx_state == RX_STATE_PAYLOAD)
+            {
+                memcpy(&m_ser_phy_rx_event.evt_params.rx_pkt_received.p_buffer[m_rx_index],
+                       &m_rx_buf[m_rx_buf_tail],
+                       len);
+            }
+            m_rx_buf_tail += len;
+            m_rx_index    += len;
+        }
+    }
+}
+
+/**@brief Function for reading the bytes available from the port. */
+static void port_read(void)
+{
+    ssize_t len;
+
+    if (m_hw_error)
+    {
+        return;
+    }
+    else if (m_rx_buf_tail == m_rx_buf_head)
+    {
+        m_rx_buf_head = 0;
+        m_rx_buf_tail = 0;
+    }
+    else if (m_rx_buf_head == RX_BUF_SIZE)
+    {
+        // The upper layer has not provided the buffer yet; keep the unread bytes.
+        return;
+    }
+
+    len = read(m_fd, &m_rx_buf[m_rx_buf_head], RX_BUF_SIZE - m_rx_buf_head);
+    if (len > 0)
+    {
+        m_rx_buf_head += (uint16_t)len;
+    }
+    else if ((len < 0) && (errno != EAGAIN) && (errno != EINTR))
+    {
+        port_error_set(errno);
+    }
+}
+
+/** API FUNCTIONS */
+
+uint32_t ser_phy_posix_device_set(char const * p_device)
+{
+    if (p_device == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if (m_ser_phy_event_handler != NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    mp_device = p_device;
+
+    return NRF_SUCCESS;
+}
+
+void ser_phy_posix_dtr_set(bool level)
+{
+    m_dtr_level = level;
+
+    if (m_fd >= 0)
+    {
+        dtr_apply();
+    }
+}
+
+uint32_t ser_phy_posix_process(uint32_t timeout_ms)
+{
+    struct pollfd pfd;
+
+    if (m_ser_phy_event_handler == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (!m_irq_enabled)
+    {
+        return NRF_SUCCESS;
+    }
+
+    // After a failure of the port, only wait for the timeout. A negative descriptor is ignored.
+    pfd.fd      = m_hw_error ? -1 : m_fd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    if (m_tx_in_progress && !m_tx_done)
+    {
+        pfd.events |= POLLOUT;
+    }
+
+    // Do not wait if there is something to report already.
+    if (m_tx_done || (m_hw_error_code != 0) ||
+        (!m_hw_error && (m_rx_buf_tail != m_rx_buf_head) && (m_rx_state != RX_STATE_BUF_REQUEST)))
+    {
+        timeout_ms = 0;
+    }
+
+    if (poll(&pfd, 1, (int)timeout_ms) < 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    if (pfd.revents & POLLOUT)
+    {
+        packet_tx_continue();
+    }
+
+    if (m_tx_done)
+    {
+        m_tx_in_progress = false;
+        m_tx_done        = false;
+        packet_sent_callback();
+    }
+
+    if (pfd.revents & (POLLIN | POLLERR | POLLHUP))
+    {
+        port_read();
+    }
+
+    packet_rx_continue();
+
+    if (m_hw_error_code != 0)
+    {
+        hardware_error_callback();
+    }
+
+    return NRF_SUCCESS;
+}
+
+uint32_t ser_phy_open(ser_phy_events_handler_t events_handler)
+{
+    uint32_t err_code;
+
+    if (events_handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    // Check if function was not called before.
+    if (m_ser_phy_event_handler != NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    err_code = port_open();
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    m_hw_error       = false;
+    m_hw_error_code  = 0;
+    m_tx_in_progress = false;
+    m_tx_done        = false;
+    m_rx_buf_head    = 0;
+    m_rx_buf_tail    = 0;
+    m_rx_index       = 0;
+    m_rx_state       = RX_STATE_HEADER;
+    m_irq_enabled    = true;
+
+    m_ser_phy_event_handler = events_handler;
+
+    return err_code;
+}
+
+uint32_t ser_phy_tx_pkt_send(const uint8_t * p_buffer, uint16_t num_of_bytes)
+{
+    if (p_buffer == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    else if (num_of_bytes == 0)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (m_hw_error)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    else if (m_tx_in_progress)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    (void)uint16_encode(num_of_bytes, m_tx_header_buf);
+    m_tx_header_index   = 0;
+    m_tx_index          = 0;
+    mp_tx_buffer        = p_buffer;
+    m_bytes_to_transmit = num_of_bytes;
+    m_tx_in_progress    = true;
+
+    // Start writing right away, the rest is written from ser_phy_posix_process(). The event is
+    // generated from there as well, as the upper layer does not expect it from this call.
+    packet_tx_continue();
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_phy_rx_buf_set(uint8_t * p_buffer)
+{
+
+    if (m_rx_state != RX_STATE_BUF_REQUEST)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_ser_phy_rx_event.evt_type = SER_PHY_EVT_RX_PKT_RECEIVED;
+    m_ser_phy_rx_event.evt_params.rx_pkt_received.p_buffer = p_buffer;
+    m_ser_phy_rx_event.evt_params.rx_pkt_received.num_of_bytes =
+        m_bytes_to_receive;
+
+    // If there is not enough memory to receive the packet (no buffer was
+    // provided), drop its data.
+    m_rx_state = (p_buffer == NULL) ? RX_STATE_DROP : RX_STATE_PAYLOAD;
+
+    // The data is passed to the buffer from ser_phy_posix_process(), in the same context
+    // as all the other events.
+    return NRF_SUCCESS;
+}
+
+
+void ser_phy_close(void)
+{
+    if (m_fd >= 0)
+    {
+        (void)close(m_fd);
+        m_fd = -1;
+    }
+    m_irq_enabled           = false;
+    m_ser_phy_event_handler = NULL;
+}
+
+
+void ser_phy_interrupts_enable(void)
+{
+    m_irq_enabled = true;
+}
+
+
+void ser_phy_interrupts_disable(void)
+{
+    m_irq_enabled = false;
+}
@@ -1156,6 +1156,35 @@
 #define BLE_ADVERTISING_ENABLED 0
 #endif
 
+// <e> BLE_DB_DISCOVERY_ENABLED - ble_db_discovery - Database discovery module
+//==========================================================
+#ifndef BLE_DB_DISCOVERY_ENABLED
+#define BLE_DB_DISCOVERY_ENABLED 0
+#endif
+// <q> BLE_DB_DISCOVERY_CACHE_ENABLED  - Store the discovered database of bonded peers
+ 
+
+// <i> The database is stored through the Peer Manager and replayed on reconnection
+// <i> while the Database Hash of the peer is unchanged. Requires PEER_MANAGER_ENABLED.
+
+#ifndef BLE_DB_DISCOVERY_CACHE_ENABLED
+#define BLE_DB_DISCOVERY_CACHE_ENABLED 0
+#endif
+
+// <q> BLE_DB_DISCOVERY_SCHED_ENABLED  - Schedule the discovery of many concurrent links
+ 
+
+// <i> All registered services are located with one sweep of the primary services of the
+// <i> peer, discovery requests are queued in the high priority lane of nrf_ble_gq (if
+// <i> NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE is not 0) and each service is reported as soon as it
+// <i> is discovered. The discovery time of each link is measured with app_timer.
+
+#ifndef BLE_DB_DISCOVERY_SCHED_ENABLED
+#define BLE_DB_DISCOVERY_SCHED_ENABLED 0
+#endif
+
+// </e>
+
 // <q> BLE_DTM_ENABLED  - ble_dtm - Module for testing RF/PHY using DTM commands
  
 
@@ -1170,6 +1199,56 @@
 #define BLE_RACP_ENABLED 0
 #endif
 
+// <e> NRF_BLE_GQ_ENABLED - nrf_ble_gq - BLE GATT Queue Module
+//==========================================================
+#ifndef NRF_BLE_GQ_ENABLED
+#define NRF_BLE_GQ_ENABLED 0
+#endif
+// <o> NRF_BLE_GQ_DATAPOOL_ELEMENT_SIZE - Default size of a single element in the pool of memory objects. 
+// <i> Write data of up to 4 bytes less, and notification data of up to 6 bytes less,
+// <i> is passed to the SoftDevice without an intermediate copy.
+#ifndef NRF_BLE_GQ_DATAPOOL_ELEMENT_SIZE
+#define NRF_BLE_GQ_DATAPOOL_ELEMENT_SIZE 20
+#endif
+
+// <o> NRF_BLE_GQ_DATAPOOL_ELEMENT_COUNT - Default number of elements in the pool of memory objects. 
+#ifndef NRF_BLE_GQ_DATAPOOL_ELEMENT_COUNT
+#define NRF_BLE_GQ_DATAPOOL_ELEMENT_COUNT 8
+#endif
+
+// <o> NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN - Maximal size of the data inside GATTC write request (in bytes). 
+#ifndef NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN
+#define NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN 16
+#endif
+
+// <o> NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN - Maximal size of the data inside GATTC notification or indication request (in bytes). 
+#ifndef NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN
+#define NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN 16
+#endif
+
+// <o> NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE - Number of requests per connection in the high priority queue. 0 disables the high priority lane. <0-255> 
+#ifndef NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE
+#define NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE 0
+#endif
+
+// <q> NRF_BLE_GQ_COALESCE_ENABLED  - Replace queued notifications and write commands to the same handle with the latest value.
+ 
+
+// <i> Enable only if the characteristics carry state rather than a stream of data.
+
+#ifndef NRF_BLE_GQ_COALESCE_ENABLED
+#define NRF_BLE_GQ_COALESCE_ENABLED 0
+#endif
+
+// <q> NRF_BLE_GQ_STATS_ENABLED  - Collect per-link queue statistics. Requires app_timer.
+ 
+
+#ifndef NRF_BLE_GQ_STATS_ENABLED
+#define NRF_BLE_GQ_STATS_ENABLED 0
+#endif
+
+// </e>
+
 // <e> NRF_BLE_QWR_ENABLED - nrf_ble_qwr - Queued writes support module (prepare/execute write)
 //==========================================================
 #ifndef NRF_BLE_QWR_ENABLED
@@ -2181,6 +2260,28 @@
 #define NRF_CRYPTO_BACKEND_MICRO_ECC_ECC_SECP256K1_ENABLED 1
 #endif
 
+// <e> NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_ENABLED - Compute secp256r1 public keys with a precomputed table.
+
+// <i> Key pair generation and public key calculation (for example, in LESC pairing) use
+// <i> the fixed-base comb method with a table of multiples of the generator in flash,
+// <i> instead of the generic micro-ecc scalar multiplication. ECDH and ECDSA are not affected.
+//==========================================================
+#ifndef NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_ENABLED
+#define NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_ENABLED 0
+#endif
+// <o> NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH  - Number of comb teeth.
+
+// <i> More teeth make the computation faster and the table larger.
+// <4=> 4 (512 bytes of flash)
+// <5=> 5 (1024 bytes of flash)
+// <6=> 6 (2048 bytes of flash)
+
+#ifndef NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH
+#define NRF_CRYPTO_BACKEND_MICRO_ECC_P256_COMB_TEETH 5
+#endif
+
+// </e>
+
 // </e>
 
 // <e> NRF_CRYPTO_BACKEND_NRF_HW_RNG_ENABLED - Enable the nRF HW RNG backend.
@@ -7898,6 +7999,20 @@
 #define MEM_MANAGER_DISABLE_API_PARAM_CHECK 0
 #endif
 
+// <e> MEM_MANAGER_TLSF_ENABLED - Use the TLSF allocator instead of fixed size blocks.
+// <i> Memory is served from a single pool by a two-level segregated fit allocator
+// <i> (mem_manager_tlsf.c) with constant-time allocation and free. Block settings are ignored.
+//==========================================================
+#ifndef MEM_MANAGER_TLSF_ENABLED
+#define MEM_MANAGER_TLSF_ENABLED 0
+#endif
+// <o> MEM_MANAGER_TLSF_POOL_SIZE - Size of the memory pool in bytes. Must be word aligned.
+#ifndef MEM_MANAGER_TLSF_POOL_SIZE
+#define MEM_MANAGER_TLSF_POOL_SIZE 4096
+#endif
+
+// </e>
+
 // </e>
 
 // <e> NRF_BALLOC_ENABLED - nrf_balloc - Block allocator module
@@ -7956,6 +8071,30 @@
 
 // </e>
 
+// <e> NRF_CRASH_TRACE_ENABLED - nrf_crash_trace - Binary trace ring committed to flash on fault
+//==========================================================
+#ifndef NRF_CRASH_TRACE_ENABLED
+#define NRF_CRASH_TRACE_ENABLED 0
+#endif
+// <o> NRF_CRASH_TRACE_RAM_ENTRIES - Number of events kept in RAM. Must be a power of 2.
+#ifndef NRF_CRASH_TRACE_RAM_ENTRIES
+#define NRF_CRASH_TRACE_RAM_ENTRIES 64
+#endif
+
+// <o> NRF_CRASH_TRACE_FLASH_START_PAGE - Starting page.
+// <i> If 0, then pages directly after the application are used.
+
+#ifndef NRF_CRASH_TRACE_FLASH_START_PAGE
+#define NRF_CRASH_TRACE_FLASH_START_PAGE 0
+#endif
+
+// <o> NRF_CRASH_TRACE_FLASH_PAGES - Number of flash pages dedicated for the stored trace.
+#ifndef NRF_CRASH_TRACE_FLASH_PAGES
+#define NRF_CRASH_TRACE_FLASH_PAGES 1
+#endif
+
+// </e>
+
 // <e> NRF_CSENSE_ENABLED - nrf_csense - Capacitive sensor module
 //==========================================================
 #ifndef NRF_CSENSE_ENABLED
@@ -8222,6 +8361,13 @@
 
 // </e>
 
+// <q> NRF_SAMPLE_LOG_ENABLED  - nrf_sample_log - Sample logger for FatFS
+ 
+
+#ifndef NRF_SAMPLE_LOG_ENABLED
+#define NRF_SAMPLE_LOG_ENABLED 0
+#endif
+
 // <q> NRF_SECTION_ITER_ENABLED  - nrf_section_iter - Section iterator
  
 
@@ -8229,6 +8375,22 @@
 #define NRF_SECTION_ITER_ENABLED 1
 #endif
 
+// <e> NRF_SLAB_ENABLED - nrf_slab - Size-class block allocator over nrf_balloc pools
+//==========================================================
+#ifndef NRF_SLAB_ENABLED
+#define NRF_SLAB_ENABLED 0
+#endif
+// <o> NRF_SLAB_MAGAZINE_SIZE - Number of free blocks cached per size class and interrupt priority.  <0-16> 
+
+// <i> Cached blocks are allocated and freed without a critical region.
+// <i> A size class that runs out takes back blocks cached by other priorities.
+
+#ifndef NRF_SLAB_MAGAZINE_SIZE
+#define NRF_SLAB_MAGAZINE_SIZE 0
+#endif
+
+// </e>
+
 // <q> NRF_SORTLIST_ENABLED  - nrf_sortlist - Sorted list
  
 
@@ -8485,6 +8647,73 @@
 // <h> nRF_Log 
 
 //==========================================================
+// <e> NRF_LOG_BACKEND_LIBUARTE_ENABLED - nrf_log_backend_libuarte - Log libUARTE backend
+// <i> Logs are sent by EasyDMA directly from a TX ring buffer using nrf_libuarte_async.
+// <i> Requires nrf_libuarte_async configuration and enabled TIMER and RTC instances.
+//==========================================================
+#ifndef NRF_LOG_BACKEND_LIBUARTE_ENABLED
+#define NRF_LOG_BACKEND_LIBUARTE_ENABLED 0
+#endif
+// <o> NRF_LOG_BACKEND_LIBUARTE_UARTE_INSTANCE - UARTE instance used by the backend. 
+#ifndef NRF_LOG_BACKEND_LIBUARTE_UARTE_INSTANCE
+#define NRF_LOG_BACKEND_LIBUARTE_UARTE_INSTANCE 0
+#endif
+
+// <o> NRF_LOG_BACKEND_LIBUARTE_TIMER_INSTANCE - TIMER instance used by libUARTE for byte counting. 
+#ifndef NRF_LOG_BACKEND_LIBUARTE_TIMER_INSTANCE
+#define NRF_LOG_BACKEND_LIBUARTE_TIMER_INSTANCE 1
+#endif
+
+// <o> NRF_LOG_BACKEND_LIBUARTE_RTC_INSTANCE - RTC instance used by libUARTE for RX timeout. 
+#ifndef NRF_LOG_BACKEND_LIBUARTE_RTC_INSTANCE
+#define NRF_LOG_BACKEND_LIBUARTE_RTC_INSTANCE 2
+#endif
+
+// <o> NRF_LOG_BACKEND_LIBUARTE_TX_PIN - UARTE TX pin 
+#ifndef NRF_LOG_BACKEND_LIBUARTE_TX_PIN
+#define NRF_LOG_BACKEND_LIBUARTE_TX_PIN 6
+#endif
+
+// <o> NRF_LOG_BACKEND_LIBUARTE_RX_PIN - UARTE RX pin 
+#ifndef NRF_LOG_BACKEND_LIBUARTE_RX_PIN
+#define NRF_LOG_BACKEND_LIBUARTE_RX_PIN 8
+#endif
+
+// <o> NRF_LOG_BACKEND_LIBUARTE_BAUDRATE  - Default Baudrate
+ 
+// <30801920=> 115200 baud 
+// <61865984=> 230400 baud 
+// <121634816=> 460800 baud 
+// <251658240=> 921600 baud 
+// <268435456=> 1000000 baud 
+
+#ifndef NRF_LOG_BACKEND_LIBUARTE_BAUDRATE
+#define NRF_LOG_BACKEND_LIBUARTE_BAUDRATE 268435456
+#endif
+
+// <o> NRF_LOG_BACKEND_LIBUARTE_TEMP_BUFFER_SIZE - Size of buffer for partially processed strings. 
+// <i> Formatted strings are copied from this buffer to the TX ring buffer.
+
+#ifndef NRF_LOG_BACKEND_LIBUARTE_TEMP_BUFFER_SIZE
+#define NRF_LOG_BACKEND_LIBUARTE_TEMP_BUFFER_SIZE 64
+#endif
+
+// <o> NRF_LOG_BACKEND_LIBUARTE_TX_BUFFER_SIZE  - Size of the TX ring buffer.
+ 
+// <i> Must be a power of 2. Data is sent directly from this buffer.
+// <256=> 256 
+// <512=> 512 
+// <1024=> 1024 
+// <2048=> 2048 
+// <4096=> 4096 
+// <8192=> 8192 
+
+#ifndef NRF_LOG_BACKEND_LIBUARTE_TX_BUFFER_SIZE
+#define NRF_LOG_BACKEND_LIBUARTE_TX_BUFFER_SIZE 1024
+#endif
+
+// </e>
+
 // <e> NRF_LOG_ENABLED - nrf_log - Logger
 //==========================================================
 #ifndef NRF_LOG_ENABLED
@@ -8579,6 +8808,18 @@
 #define NRF_LOG_FILTERS_ENABLED 0
 #endif
 
+// <q> NRF_LOG_LOCK_FREE_ENABLED  - Enable lock-free allocation of log entries.
+ 
+
+// <i> When enabled, space for log entries is reserved using LDREX/STREX
+// <i> compare-and-exchange instead of a critical region, so logging does not
+// <i> disable interrupts. If another producer is preempted while reserving
+// <i> space, overflow is handled by dropping the new entry.
+
+#ifndef NRF_LOG_LOCK_FREE_ENABLED
+#define NRF_LOG_LOCK_FREE_ENABLED 0
+#endif
+
 // <q> NRF_LOG_NON_DEFFERED_CRITICAL_REGION_ENABLED  - Enable use of critical region for non deffered mode when flushing logs.
  
 
@@ -8590,6 +8831,25 @@
 #define NRF_LOG_NON_DEFFERED_CRITICAL_REGION_ENABLED 0
 #endif
 
+// <q> NRF_LOG_RATE_LIMIT_ENABLED  - Enable per module rate limiting and sampling of logs.
+ 
+
+// <i> When enabled, each module can be configured with a token bucket rate
+// <i> limit and 1-in-N sampling evaluated before an entry is buffered.
+// <i> Suppressed entries are counted per module.
+// <i> Rate limiting requires timestamps.
+
+#ifndef NRF_LOG_RATE_LIMIT_ENABLED
+#define NRF_LOG_RATE_LIMIT_ENABLED 0
+#endif
+
+// <o> NRF_LOG_RATE_LIMIT_MODULE_COUNT - Maximum number of modules with rate limiting or sampling configured. <1-255> 
+
+
+#ifndef NRF_LOG_RATE_LIMIT_MODULE_COUNT
+#define NRF_LOG_RATE_LIMIT_MODULE_COUNT 4
+#endif
+
 // <o> NRF_LOG_STR_PUSH_BUFFER_SIZE  - Size of the buffer dedicated for strings stored using @ref NRF_LOG_PUSH.
  
 // <16=> 16 
@@ -10455,6 +10715,69 @@
 
 // </e>
 
+// <e> NRF_BLOCK_DEV_CACHE_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRF_BLOCK_DEV_CACHE_CONFIG_LOG_ENABLED
+#define NRF_BLOCK_DEV_CACHE_CONFIG_LOG_ENABLED 0
+#endif
+// <o> NRF_BLOCK_DEV_CACHE_CONFIG_LOG_LEVEL  - Default Severity level
+ 
+// <0=> Off 
+// <1=> Error 
+// <2=> Warning 
+// <3=> Info 
+// <4=> Debug 
+
+#ifndef NRF_BLOCK_DEV_CACHE_CONFIG_LOG_LEVEL
+#define NRF_BLOCK_DEV_CACHE_CONFIG_LOG_LEVEL 3
+#endif
+
+// <o> NRF_BLOCK_DEV_CACHE_CONFIG_LOG_INIT_FILTER_LEVEL  - Initial severity level if dynamic filtering is enabled
+ 
+// <0=> Off 
+// <1=> Error 
+// <2=> Warning 
+// <3=> Info 
+// <4=> Debug 
+
+#ifndef NRF_BLOCK_DEV_CACHE_CONFIG_LOG_INIT_FILTER_LEVEL
+#define NRF_BLOCK_DEV_CACHE_CONFIG_LOG_INIT_FILTER_LEVEL 3
+#endif
+
+// <o> NRF_BLOCK_DEV_CACHE_CONFIG_INFO_COLOR  - ANSI escape code prefix.
+ 
+// <0=> Default 
+// <1=> Black 
+// <2=> Red 
+// <3=> Green 
+// <4=> Yellow 
+// <5=> Blue 
+// <6=> Magenta 
+// <7=> Cyan 
+// <8=> White 
+
+#ifndef NRF_BLOCK_DEV_CACHE_CONFIG_INFO_COLOR
+#define NRF_BLOCK_DEV_CACHE_CONFIG_INFO_COLOR 0
+#endif
+
+// <o> NRF_BLOCK_DEV_CACHE_CONFIG_DEBUG_COLOR  - ANSI escape code prefix.
+ 
+// <0=> Default 
+// <1=> Black 
+// <2=> Red 
+// <3=> Green 
+// <4=> Yellow 
+// <5=> Blue 
+// <6=> Magenta 
+// <7=> Cyan 
+// <8=> White 
+
+#ifndef NRF_BLOCK_DEV_CACHE_CONFIG_DEBUG_COLOR
+#define NRF_BLOCK_DEV_CACHE_CONFIG_DEBUG_COLOR 0
+#endif
+
+// </e>
+
 // <e> NRF_BLOCK_DEV_EMPTY_CONFIG_LOG_ENABLED - Enables logging in the module.
 //==========================================================
 #ifndef NRF_BLOCK_DEV_EMPTY_CONFIG_LOG_ENABLED
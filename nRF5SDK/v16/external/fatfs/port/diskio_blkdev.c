@@ -288,7 +288,8 @@ DRESULT disk_ioctl(BYTE drv, BYTE cmd, void *buff)
                                                    &flush_in_progress);
                 if (ret != NRF_SUCCESS && ret != NRF_ERROR_BUSY)
                 {
-                    break;
+                    /*Dirty blocks may not have reached the backend: report the failure to FatFs*/
+                    return RES_ERROR;
                 }
 
             } while (flush_in_progress);
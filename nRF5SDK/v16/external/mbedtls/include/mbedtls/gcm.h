@@ -162,6 +162,23 @@ int mbedtls_gcm_starts( mbedtls_gcm_context *ctx,
                 const unsigned char *add,
                 size_t add_len );
 
+/**
+ * \brief           Feed more additional data into a GCM operation started
+ *                  with mbedtls_gcm_starts(). Can be called several times
+ *                  before the first call to mbedtls_gcm_update(). Expects
+ *                  add_len to be a multiple of 16 bytes! Only the last call
+ *                  can be less than 16 bytes!
+ *
+ * \param ctx       GCM context
+ * \param add       additional data (or NULL if length is 0)
+ * \param add_len   length of additional data
+ *
+ * \return         0 if successful or MBEDTLS_ERR_GCM_BAD_INPUT
+ */
+int mbedtls_gcm_update_ad( mbedtls_gcm_context *ctx,
+                const unsigned char *add,
+                size_t add_len );
+
 /**
  * \brief           Generic GCM update function. Encrypts/decrypts using the
  *                  given GCM context. Expects input to be a multiple of 16
@@ -1167,6 +1167,90 @@ void mpi_mul_hlp( size_t i, mbedtls_mpi_uint *s, mbedtls_mpi_uint *d, mbedtls_mp
     while( c != 0 );
 }
 
+#if defined(MBEDTLS_MPI_MUL_COMBA) && defined(MBEDTLS_HAVE_UDBL)
+/*
+ * Comba (product scanning) multiplication: d[0..na+nb-1] = a[0..na-1] * b[0..nb-1]
+ *
+ * Each result limb is computed once, from all the products of its column.
+ * The column sum is kept in a limb (lo) and a double limb (hi), so that
+ * every step is a single "a * b + lo" (UMAAL on Cortex-M4) followed by
+ * a double-limb addition, without carry tests.
+ */
+static void mpi_mul_comba( mbedtls_mpi_uint *d,
+                           const mbedtls_mpi_uint *a, size_t na,
+                           const mbedtls_mpi_uint *b, size_t nb )
+{
+    mbedtls_t_udbl t, hi = 0;
+    mbedtls_mpi_uint lo = 0;
+    size_t i, k, i_min, i_max;
+
+    for( k = 0; k < na + nb - 1; k++ )
+    {
+        i_min = ( k < nb ) ? 0 : k - nb + 1;
+        i_max = ( k < na ) ? k : na - 1;
+
+        for( i = i_min; i <= i_max; i++ )
+        {
+            t   = (mbedtls_t_udbl) a[i] * b[k - i] + lo;
+            lo  = (mbedtls_mpi_uint) t;
+            hi += t >> biL;
+        }
+
+        d[k] = lo;
+        lo   = (mbedtls_mpi_uint) hi;
+        hi >>= biL;
+    }
+
+    d[na + nb - 1] = lo;
+}
+
+/*
+ * Comba squaring: d[0..2n-1] = a[0..n-1]^2
+ *
+ * The products a[i] * a[j] with i != j appear twice in each column, so
+ * they are computed once, summed separately and doubled.
+ */
+static void mpi_sqr_comba( mbedtls_mpi_uint *d, const mbedtls_mpi_uint *a, size_t n )
+{
+    mbedtls_t_udbl t, hi = 0, cross_hi;
+    mbedtls_mpi_uint lo = 0, cross_lo;
+    size_t i, k, i_min;
+
+    for( k = 0; k < 2 * n - 1; k++ )
+    {
+        i_min = ( k < n ) ? 0 : k - n + 1;
+
+        /* Products below the diagonal */
+        cross_lo = 0;
+        cross_hi = 0;
+        for( i = i_min; 2 * i < k; i++ )
+        {
+            t         = (mbedtls_t_udbl) a[i] * a[k - i] + cross_lo;
+            cross_lo  = (mbedtls_mpi_uint) t;
+            cross_hi += t >> biL;
+        }
+
+        /* Double them. The column has at most n / 2 of them, so cross_hi
+         * cannot overflow for any reasonable n. */
+        cross_hi = ( cross_hi << 1 ) | ( cross_lo >> ( biL - 1 ) );
+        cross_lo <<= 1;
+
+        /* Add the square on the diagonal, if any */
+        if( ( k & 1 ) == 0 )
+            t = (mbedtls_t_udbl) a[k / 2] * a[k / 2] + cross_lo + lo;
+        else
+            t = (mbedtls_t_udbl) cross_lo + lo;
+
+        d[k] = (mbedtls_mpi_uint) t;
+        hi  += ( t >> biL ) + cross_hi;
+        lo   = (mbedtls_mpi_uint) hi;
+        hi >>= biL;
+    }
+
+    d[2 * n - 1] = lo;
+}
+#endif /* MBEDTLS_MPI_MUL_COMBA && MBEDTLS_HAVE_UDBL */
+
 /*
  * Baseline multiplication: X = A * B  (HAC 14.12)
  */
@@ -1175,6 +1259,9 @@ int mbedtls_mpi_mul_mpi( mbedtls_mpi *X, const mbedtls_mpi *A, const mbedtls_mpi
     int ret;
     size_t i, j;
     mbedtls_mpi TA, TB;
+#if defined(MBEDTLS_MPI_MUL_COMBA) && defined(MBEDTLS_HAVE_UDBL)
+    int square = ( A == B );
+#endif
 
     mbedtls_mpi_init( &TA ); mbedtls_mpi_init( &TB );
 
@@ -1192,8 +1279,18 @@ int mbedtls_mpi_mul_mpi( mbedtls_mpi *X, const mbedtls_mpi *A, const mbedtls_mpi
     MBEDTLS_MPI_CHK( mbedtls_mpi_grow( X, i + j ) );
     MBEDTLS_MPI_CHK( mbedtls_mpi_lset( X, 0 ) );
 
+#if defined(MBEDTLS_MPI_MUL_COMBA) && defined(MBEDTLS_HAVE_UDBL)
+    if( i > 0 && j > 0 )
+    {
+        if( square )
+            mpi_sqr_comba( X->p, A->p, i );
+        else
+            mpi_mul_comba( X->p, A->p, i, B->p, j );
+    }
+#else
     for( i++; j > 0; j-- )
         mpi_mul_hlp( i - 1, A->p, X->p + j - 1, B->p[j - 1] );
+#endif
 
     X->s = A->s * B->s;
 
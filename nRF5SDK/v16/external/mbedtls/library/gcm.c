@@ -326,7 +326,27 @@ int mbedtls_gcm_starts( mbedtls_gcm_context *ctx,
         return( ret );
     }
 
-    ctx->add_len = add_len;
+    return( mbedtls_gcm_update_ad( ctx, add, add_len ) );
+}
+
+int mbedtls_gcm_update_ad( mbedtls_gcm_context *ctx,
+                const unsigned char *add,
+                size_t add_len )
+{
+    size_t i;
+    const unsigned char *p;
+    size_t use_len;
+
+    /* No more additional data once data has been processed or once a
+     * partial block of additional data has been hashed */
+    if( ctx->len != 0 || ( ctx->add_len & 15 ) != 0 )
+        return( MBEDTLS_ERR_GCM_BAD_INPUT );
+
+    /* AD is limited to 2^64 bits, so 2^61 bytes */
+    if( ( (uint64_t) ctx->add_len + add_len ) >> 61 != 0 )
+        return( MBEDTLS_ERR_GCM_BAD_INPUT );
+
+    ctx->add_len += add_len;
     p = add;
     while( add_len > 0 )
     {
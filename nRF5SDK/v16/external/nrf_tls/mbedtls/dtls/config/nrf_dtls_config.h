@@ -436,7 +436,23 @@
  *
  * Comment this macro to disable NIST curves optimisation.
  */
-//#define MBEDTLS_ECP_NIST_OPTIM
+#define MBEDTLS_ECP_NIST_OPTIM
+
+/**
+ * \def MBEDTLS_MPI_MUL_COMBA
+ *
+ * Use Comba (product scanning) multiplication and squaring in
+ * mbedtls_mpi_mul_mpi() instead of the schoolbook row-by-row loop.
+ * Each result limb is written once and every inner step is a single
+ * multiply-accumulate, which maps to UMAAL/UMLAL on Cortex-M3/M4 without
+ * any assembly. Squaring computes each cross product only once.
+ *
+ * Requires a double-width limb type (MBEDTLS_HAVE_UDBL), otherwise the
+ * generic code is used.
+ *
+ * Comment this macro to use the generic multiplication.
+ */
+#define MBEDTLS_MPI_MUL_COMBA
 
 /**
  * \def MBEDTLS_ECDSA_DETERMINISTIC
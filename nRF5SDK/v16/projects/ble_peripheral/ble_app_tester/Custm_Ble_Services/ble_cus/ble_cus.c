@@ -58,6 +58,31 @@ static void on_write(ble_cus_t * p_cus, ble_evt_t const * p_ble_evt)
 
       p_cus->evt_handler(p_cus, &evt);
    }
+
+    // writing to the diagnostics characteristic
+    else if (p_evt_write->handle == p_cus->diag_char_handles.value_handle)
+    {
+        evt.params_command.command_data.p_data = p_evt_write->data;
+        evt.params_command.command_data.length = p_evt_write->len;
+        evt.evt_type = BLE_DIAG_CHAR_EVT_COMMAND_RX;
+
+        p_cus->evt_handler(p_cus, &evt);
+    }
+
+    // writing to the diagnostics characteristic (cccd)
+    else if (p_evt_write->handle == p_cus->diag_char_handles.cccd_handle)
+    {
+        if (ble_srv_is_notification_enabled(p_evt_write->data))
+        {
+            evt.evt_type = BLE_DIAG_CHAR_NOTIFICATIONS_ENABLED;
+        }
+        else
+        {
+            evt.evt_type = BLE_DIAG_CHAR_NOTIFICATIONS_DISABLED;
+        }
+
+        p_cus->evt_handler(p_cus, &evt);
+    }
 }
 
 
@@ -201,6 +226,34 @@ uint32_t ble_cus_init(ble_cus_t * p_cus, const ble_cus_init_t * p_cus_init)
         return err_code;
     }
 
+    // Add the diagnostics characteristic.
+
+    uint8_t diag_char_init_value [1] = {0};
+
+    memset(&add_char_params, 0, sizeof(add_char_params));
+    add_char_params.uuid              = DIAG_CHAR_UUID;
+    add_char_params.uuid_type         = p_cus->uuid_type;
+
+    add_char_params.init_len          = 1; // (in bytes)
+    add_char_params.max_len           = NRF_SDH_BLE_GATT_MAX_MTU_SIZE - 3;
+    add_char_params.is_var_len        = true;
+    add_char_params.p_init_value      = diag_char_init_value;
+
+    add_char_params.char_props.write  = 1;
+    add_char_params.char_props.notify = 1;
+
+    // Crash traces can be read out and erased only over an encrypted link.
+    add_char_params.write_access      = SEC_JUST_WORKS;
+    add_char_params.cccd_write_access = SEC_JUST_WORKS;
+
+    err_code = characteristic_add(p_cus->service_handle,
+                                  &add_char_params,
+                                  &p_cus->diag_char_handles);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
     return NRF_SUCCESS;
 }
 
@@ -248,4 +301,27 @@ uint32_t ble_cus_buttons_states_update(ble_cus_t * p_cus, uint8_t  * p_buttons_s
     params.p_len  = &len;
 
     return sd_ble_gatts_hvx(conn_handle, &params);
-}
\ No newline at end of file
+}
+
+/**@brief Function for sending a chunk of diagnostics data on the diagnostics ble characteristic.
+ *
+ * @param[in]     p_cus        Custom service structure.
+ * @param[in]     p_data       Diagnostics data.
+ * @param[in,out] p_length     Length of the data to send, number of bytes sent on return.
+ * @param[in]     conn_handle  Connection handle.
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+
+uint32_t ble_cus_diag_data_send(ble_cus_t * p_cus, uint8_t const * p_data, uint16_t * p_length, uint16_t conn_handle)
+{
+    ble_gatts_hvx_params_t params;
+
+    memset(&params, 0, sizeof(params));
+    params.type   = BLE_GATT_HVX_NOTIFICATION;
+    params.handle = p_cus->diag_char_handles.value_handle;
+    params.p_data = p_data;
+    params.p_len  = p_length;
+
+    return sd_ble_gatts_hvx(conn_handle, &params);
+}
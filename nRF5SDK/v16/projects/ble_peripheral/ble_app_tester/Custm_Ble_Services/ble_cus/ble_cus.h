@@ -34,6 +34,7 @@ NRF_SDH_BLE_OBSERVER(_name ## _obs,
 #define BUTTONS_STATES_CHAR_UUID   0x1001 
 #define POTENTIO_LEVEL_CHAR_UUID   0x1002	
 #define LEDS_STATES_CHAR_UUID      0x1003	
+#define DIAG_CHAR_UUID             0x1004
 
 /**@brief Custom service event types.
  *
@@ -46,7 +47,12 @@ typedef enum
     BLE_POTENTIO_LEVEL_CHAR_NOTIFICATIONS_ENABLED,
     BLE_POTENTIO_LEVEL_CHAR_NOTIFICATIONS_DISABLED,
 
-    BLE_LEDS_STATES_CHAR_EVT_COMMAND_RX 
+    BLE_LEDS_STATES_CHAR_EVT_COMMAND_RX,
+
+    BLE_DIAG_CHAR_NOTIFICATIONS_ENABLED,
+    BLE_DIAG_CHAR_NOTIFICATIONS_DISABLED,
+
+    BLE_DIAG_CHAR_EVT_COMMAND_RX
 
 } ble_cus_evt_type_t;
 
@@ -107,6 +113,7 @@ struct ble_cus_s
     ble_gatts_char_handles_t      buttons_states_char_handles;    /**< Handles related to the buttons states characteristic. */
     ble_gatts_char_handles_t      leds_states_char_handles;       /**< Handles related to the leds states characteristic. */
     ble_gatts_char_handles_t      potentio_level_char_handles;    /**< Handles related to the potentio level characteristic. */
+    ble_gatts_char_handles_t      diag_char_handles;              /**< Handles related to the diagnostics characteristic. */
       
     uint16_t                      conn_handle;                    /**< Handle of the current connection (as provided by the BLE stack, is BLE_CONN_HANDLE_INVALID if not in a connection). */
     uint8_t                       uuid_type;                      /**< Holds the service uuid type. */
@@ -151,3 +158,15 @@ uint32_t ble_cus_potentio_level_update(ble_cus_t * p_cus, uint8_t potentio_level
  * @return      NRF_SUCCESS on success, otherwise an error code.
  */
 uint32_t ble_cus_buttons_states_update(ble_cus_t * p_cus, uint8_t  * p_buttons_states, uint16_t conn_handle);
+
+
+/**@brief Function for sending a chunk of diagnostics data on the diagnostics ble characteristic.
+ *
+ * @param[in]     p_cus        Custom service structure.
+ * @param[in]     p_data       Diagnostics data.
+ * @param[in,out] p_length     Length of the data to send, number of bytes sent on return.
+ * @param[in]     conn_handle  Connection handle.
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+uint32_t ble_cus_diag_data_send(ble_cus_t * p_cus, uint8_t const * p_data, uint16_t * p_length, uint16_t conn_handle);
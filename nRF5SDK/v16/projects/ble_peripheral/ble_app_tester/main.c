@@ -56,6 +56,7 @@
 #include "ble_advdata.h"
 #include "ble_advertising.h"
 #include "ble_conn_params.h"
+#include "nrf_sdm.h"
 #include "nrf_sdh.h"
 #include "nrf_sdh_soc.h"
 #include "nrf_sdh_ble.h"
@@ -69,6 +70,9 @@
 #include "nrf_ble_gatt.h"
 #include "nrf_ble_qwr.h"
 #include "nrf_pwr_mgmt.h"
+#include "nrf_fstorage_sd.h"
+#include "nrf_crash_trace.h"
+#include "nrf_strerror.h"
 
 #include "ble_cus.h"
 #include "ble_bas.h"
@@ -112,6 +116,14 @@
 #define BATTERY_TIMER_INTERVAL          APP_TIMER_TICKS(60000)                  /**< Battery timer interval (60000 ms). */
 #define SAADC_TIMER_INTERVAL            APP_TIMER_TICKS(200)                    /**< Saadc sampling timer interval (200 ms). */
 
+#define DIAG_CMD_DUMP                   0x00                                    /**< Diagnostics command: restart the crash trace dump. */
+#define DIAG_CMD_ERASE                  0x01                                    /**< Diagnostics command: erase the stored crash trace. */
+
+#define TRACE_ID_BLE_EVT                1                                       /**< Trace event: BLE stack event (event id, connection handle). */
+#define TRACE_ID_ADV_EVT                2                                       /**< Trace event: advertising event (event, 0). */
+#define TRACE_ID_CUS_EVT                3                                       /**< Trace event: custom service event (event type, 0). */
+#define TRACE_ID_BUTTON_EVT             4                                       /**< Trace event: button event (pin, action). */
+
 NRF_BLE_GATT_DEF(m_gatt);                                                       /**< GATT module instance. */
 NRF_BLE_QWR_DEF(m_qwr);                                                         /**< Context for the Queued Write module.*/
 BLE_ADVERTISING_DEF(m_advertising);                                             /**< Advertising module instance. */
@@ -123,6 +135,10 @@ APP_TIMER_DEF(m_battery_timer_id);
 
 static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID;                        /**< Handle of the current connection. */
 
+static uint8_t const * mp_diag_data;                                            /**< Stored crash trace being dumped. */
+static size_t          m_diag_size;                                             /**< Size of the stored crash trace. */
+static size_t          m_diag_offset;                                           /**< Number of crash trace bytes already sent. */
+
 static ble_uuid_t m_adv_uuids[] =                                               /**< Universally unique service identifiers. */
 {
     {BLE_UUID_DEVICE_INFORMATION_SERVICE, BLE_UUID_TYPE_BLE}
@@ -175,6 +191,32 @@ void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
 }
 
 
+/**@brief Function for handling faults.
+ *
+ * @details Commits the crash trace to flash and logs the fault before falling back to
+ *          the default behaviour: the system is reset, or halted in debug builds.
+ *
+ * @param[in] id    Fault identifier.
+ * @param[in] pc    The program counter of the instruction that triggered the fault.
+ * @param[in] info  Optional additional information regarding the fault.
+ */
+void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
+{
+    __disable_irq();
+
+    uint32_t trace_info = (id == NRF_FAULT_ID_SDK_ERROR) ? ((error_info_t *)info)->err_code : info;
+    (void)nrf_crash_trace_commit(id, pc, trace_info);
+
+    app_error_log_handle(id, pc, info);
+
+#ifndef DEBUG
+    NVIC_SystemReset();
+#else
+    app_error_save_and_stop(id, pc, info);
+#endif // DEBUG
+}
+
+
 /**@brief Function for handling Peer Manager events.
  *
  * @param[in] p_evt  Peer Manager event.
@@ -359,6 +401,135 @@ static void leds_states_char_commands_handler(uint8_t const * commands, uint16_t
    }
 }
 
+/**@brief Function for sending the stored crash trace on the diagnostics characteristic.
+ *
+ * @details Sends as many chunks as the SoftDevice accepts, the dump is resumed on
+ *          BLE_GATTS_EVT_HVN_TX_COMPLETE.
+ */
+static void diag_dump_continue(void)
+{
+    ret_code_t err_code;
+    uint16_t   chunk_max = nrf_ble_gatt_eff_mtu_get(&m_gatt, m_conn_handle) - 3;
+
+    while ((mp_diag_data != NULL) && (m_diag_offset < m_diag_size))
+    {
+        uint16_t length = (uint16_t)MIN(m_diag_size - m_diag_offset, chunk_max);
+
+        err_code = ble_cus_diag_data_send(&m_cus, mp_diag_data + m_diag_offset, &length, m_conn_handle);
+        if (err_code == NRF_ERROR_RESOURCES)
+        {
+            return;
+        }
+        if (err_code != NRF_SUCCESS)
+        {
+            NRF_LOG_DEBUG("Crash trace dump aborted: 0x%x.", err_code);
+            mp_diag_data = NULL;
+            return;
+        }
+        m_diag_offset += length;
+    }
+
+    if (mp_diag_data != NULL)
+    {
+        NRF_LOG_INFO("Crash trace dump completed.");
+        mp_diag_data = NULL;
+    }
+}
+
+
+/**@brief Function for starting the dump of the stored crash trace.
+ */
+static void diag_dump_start(void)
+{
+    m_diag_offset = 0;
+    if (nrf_crash_trace_stored_get(&mp_diag_data, &m_diag_size) != NRF_SUCCESS)
+    {
+        NRF_LOG_INFO("No crash trace stored.");
+        mp_diag_data = NULL;
+        return;
+    }
+
+    NRF_LOG_INFO("Dumping crash trace (%u bytes).", (uint32_t)m_diag_size);
+    diag_dump_continue();
+}
+
+
+/**@brief Function for handling the diagnostics characteristic commands.
+ *
+ * @param[in]   commands   Received commands.
+ * @param[in]   length     Commands length.
+ */
+static void diag_char_commands_handler(uint8_t const * commands, uint16_t length)
+{
+    ret_code_t err_code;
+
+    if (length == 0)
+    {
+        return;
+    }
+
+    switch (commands[0])
+    {
+        case DIAG_CMD_DUMP:
+            diag_dump_start();
+            break;
+
+        case DIAG_CMD_ERASE:
+            mp_diag_data = NULL;
+            err_code = nrf_crash_trace_stored_erase();
+            APP_ERROR_CHECK(err_code);
+            NRF_LOG_INFO("Erasing crash trace.");
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/**@brief Function for handling the crash trace events.
+ *
+ * @param[in]   p_evt   Crash trace event.
+ */
+static void crash_trace_evt_handler(nrf_crash_trace_evt_t const * p_evt)
+{
+    if (p_evt->type != NRF_CRASH_TRACE_EVT_ERASE_RESULT)
+    {
+        return;
+    }
+
+    if (p_evt->result == NRF_SUCCESS)
+    {
+        NRF_LOG_INFO("Crash trace erased.");
+    }
+    else
+    {
+        NRF_LOG_ERROR("Crash trace erase failed: %s.", nrf_strerror_get(p_evt->result));
+    }
+}
+
+
+/**@brief Function for initializing the crash trace.
+ */
+static void crash_trace_init(void)
+{
+    ret_code_t      err_code;
+    uint8_t const * p_data;
+    size_t          size;
+
+    err_code = nrf_crash_trace_init(&nrf_fstorage_sd, app_timer_cnt_get, crash_trace_evt_handler);
+    APP_ERROR_CHECK(err_code);
+
+    if (nrf_crash_trace_stored_get(&p_data, &size) == NRF_SUCCESS)
+    {
+        nrf_crash_trace_hdr_t const * p_hdr = (nrf_crash_trace_hdr_t const *)p_data;
+
+        NRF_LOG_WARNING("Crash trace stored: fault 0x%x at 0x%08x, %d events.",
+                        p_hdr->fault_id, p_hdr->pc, p_hdr->count);
+    }
+}
+
+
 /**@brief Function for handling the custom Service events.
  *
  * @details This function will be called for all Custom Service ble events which are passed to
@@ -372,6 +543,8 @@ static void cus_evt_handler(ble_cus_t * p_cus, ble_cus_evt_t * p_evt)
 {
   ret_code_t   err_code;
 
+  NRF_CRASH_TRACE(TRACE_ID_CUS_EVT, p_evt->evt_type, 0);
+
   switch(p_evt->evt_type)
   {
     case BLE_LEDS_STATES_CHAR_EVT_COMMAND_RX:
@@ -409,6 +582,26 @@ static void cus_evt_handler(ble_cus_t * p_cus, ble_cus_evt_t * p_evt)
 
     } break;
 
+    case BLE_DIAG_CHAR_NOTIFICATIONS_ENABLED:
+    {
+        NRF_LOG_INFO("diag char notifications are enabled.");
+        diag_dump_start();
+
+    } break;
+
+    case BLE_DIAG_CHAR_NOTIFICATIONS_DISABLED:
+    {
+        NRF_LOG_INFO("diag char notifications are disabled.");
+        mp_diag_data = NULL;
+
+    } break;
+
+    case BLE_DIAG_CHAR_EVT_COMMAND_RX:
+    {
+        diag_char_commands_handler(p_evt->params_command.command_data.p_data, p_evt->params_command.command_data.length);
+
+    } break;
+
     default:
     break;
   }
@@ -551,6 +744,8 @@ static void on_adv_evt(ble_adv_evt_t ble_adv_evt)
 {
     ret_code_t err_code;
 
+    NRF_CRASH_TRACE(TRACE_ID_ADV_EVT, ble_adv_evt, 0);
+
     switch (ble_adv_evt)
     {
         case BLE_ADV_EVT_FAST:
@@ -578,10 +773,13 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
 {
     ret_code_t err_code = NRF_SUCCESS;
 
+    NRF_CRASH_TRACE(TRACE_ID_BLE_EVT, p_ble_evt->header.evt_id, m_conn_handle);
+
     switch (p_ble_evt->header.evt_id)
     {
         case BLE_GAP_EVT_DISCONNECTED:
             NRF_LOG_INFO("Disconnected.");
+            mp_diag_data = NULL;
             // LED indication will be changed when advertising starts.
             break;
 
@@ -614,6 +812,10 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
             APP_ERROR_CHECK(err_code);
             break;
 
+        case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+            diag_dump_continue();
+            break;
+
         case BLE_GATTS_EVT_TIMEOUT:
             // Disconnect on GATT Server timeout event.
             NRF_LOG_DEBUG("GATT Server Timeout.");
@@ -779,6 +981,8 @@ static void button_event_handler(uint8_t button_pin, uint8_t button_action)
 {
   ret_code_t err_code;
 
+  NRF_CRASH_TRACE(TRACE_ID_BUTTON_EVT, button_pin, button_action);
+
   switch(button_pin)
   {
    case BUTTON_1:
@@ -1023,6 +1227,7 @@ int main(void)
     advertising_init();
     conn_params_init();
     peer_manager_init();
+    crash_trace_init();
 
     saadc_init();
 
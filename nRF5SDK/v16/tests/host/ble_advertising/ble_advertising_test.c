@@ -0,0 +1,509 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the advertising data layout and of ble_advertising_advdata_patch.
+ *
+ * The layout recorded by ble_advdata_encode_layout is checked against ble_advdata_encode for
+ * several sets of advertising data, and its offsets against the AD structures found by parsing
+ * the encoded data. The SoftDevice stub records the data given to sd_ble_gap_adv_set_configure,
+ * so that the data patched in place can be compared with the data encoded from scratch.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "ble_advdata.h"
+#include "ble_advertising.h"
+#include "host_test.h"
+
+#define DEVICE_NAME     "Nordic_Beacon"     // Name returned by the SoftDevice stub.
+#define APPEARANCE      0x0200              // Appearance returned by the SoftDevice stub.
+#define COMPANY_ID      0x0059              // Company Identifier of the manufacturer data.
+#define SRV_UUID_0      0x1809              // UUIDs of the service data.
+#define SRV_UUID_1      0x180F
+#define ENC_BUF_SIZE    BLE_GAP_ADV_SET_DATA_SIZE_MAX
+
+/**@brief Data given to the SoftDevice stub in the last configuration of the advertising data. */
+typedef struct
+{
+    uint32_t configure_cnt;
+    uint8_t  adv[ENC_BUF_SIZE];
+    uint16_t adv_len;
+    uint8_t  sr[ENC_BUF_SIZE];
+    uint16_t sr_len;
+    uint8_t const * p_adv;  // Buffers handed to the SoftDevice.
+    uint8_t const * p_sr;
+} sd_adv_t;
+
+static sd_adv_t m_sd;
+
+
+uint32_t sd_ble_gap_device_name_get(uint8_t * p_dev_name, uint16_t * p_len)
+{
+    // As the SoftDevice does, copy what fits and return the length of the complete name.
+    memcpy(p_dev_name, DEVICE_NAME, MIN(*p_len, strlen(DEVICE_NAME)));
+    *p_len = strlen(DEVICE_NAME);
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_appearance_get(uint16_t * p_appearance)
+{
+    *p_appearance = APPEARANCE;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_addr_get(ble_gap_addr_t * p_addr)
+{
+    memset(p_addr, 0, sizeof(*p_addr));
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_uuid_encode(ble_uuid_t const * p_uuid, uint8_t * p_uuid_le_len, uint8_t * p_uuid_le)
+{
+    // Only 16-bit UUIDs are used. A NULL buffer asks for the length only.
+    *p_uuid_le_len = sizeof(uint16_t);
+    if (p_uuid_le != NULL)
+    {
+        (void)uint16_encode(p_uuid->uuid, p_uuid_le);
+    }
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_adv_set_configure(uint8_t                    * p_adv_handle,
+                                      ble_gap_adv_data_t const   * p_adv_data,
+                                      ble_gap_adv_params_t const * p_adv_params)
+{
+    *p_adv_handle = 0;
+
+    if (p_adv_data != NULL)
+    {
+        m_sd.configure_cnt++;
+        m_sd.p_adv   = p_adv_data->adv_data.p_data;
+        m_sd.adv_len = p_adv_data->adv_data.len;
+        m_sd.p_sr    = p_adv_data->scan_rsp_data.p_data;
+        m_sd.sr_len  = p_adv_data->scan_rsp_data.len;
+        memcpy(m_sd.adv, m_sd.p_adv, m_sd.adv_len);
+        memcpy(m_sd.sr, m_sd.p_sr, m_sd.sr_len);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_adv_start(uint8_t adv_handle, uint8_t conn_cfg_tag)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_adv_stop(uint8_t adv_handle)
+{
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for finding the value of an AD structure by parsing the encoded data.
+ *
+ * @param[in] p_data Encoded data.
+ * @param[in] len    Length of the encoded data.
+ * @param[in] type   AD type to look for.
+ * @param[in] index  Number of AD structures of this type to skip.
+ *
+ * @return Offset of the first byte after the AD type, or BLE_ADVDATA_OFFSET_INVALID.
+ */
+static uint16_t ad_value_find(uint8_t const * p_data, uint16_t len, uint8_t type, uint8_t index)
+{
+    uint16_t offset = 0;
+
+    while (offset + 1 < len)
+    {
+        HOST_TEST_ASSERT((p_data[offset] != 0) && (offset + 1 + p_data[offset] <= len));
+
+        if ((p_data[offset + 1] == type) && (index-- == 0))
+        {
+            return offset + 2;
+        }
+        offset += 1 + p_data[offset];
+    }
+
+    return BLE_ADVDATA_OFFSET_INVALID;
+}
+
+
+/**@brief Function for encoding advertising data in both ways and checking the layout.
+ *
+ * @param[in]  p_advdata Advertising data.
+ * @param[in]  buf_size  Size of the encoding buffer.
+ * @param[out] p_layout  Layout of the encoded data.
+ */
+static void layout_check(ble_advdata_t const * p_advdata, uint16_t buf_size,
+                         ble_advdata_layout_t * p_layout)
+{
+    uint8_t  ref[ENC_BUF_SIZE];
+    uint8_t  enc[ENC_BUF_SIZE];
+    uint16_t ref_len = buf_size;
+    uint16_t enc_len = buf_size;
+    uint16_t offset;
+
+    memset(ref, 0xA5, sizeof(ref));
+    memset(enc, 0x5A, sizeof(enc));
+
+    HOST_TEST_ASSERT(ble_advdata_encode(p_advdata, ref, &ref_len) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(ble_advdata_encode_layout(p_advdata, enc, &enc_len, p_layout) == NRF_SUCCESS);
+
+    // The layout does not change the encoded data.
+    HOST_TEST_ASSERT((enc_len == ref_len) && (memcmp(enc, ref, ref_len) == 0));
+    HOST_TEST_ASSERT(p_layout->len == enc_len);
+
+    offset = ad_value_find(enc, enc_len, BLE_GAP_AD_TYPE_TX_POWER_LEVEL, 0);
+    HOST_TEST_ASSERT(p_layout->tx_power_level == offset);
+    if (p_advdata->p_tx_power_level != NULL)
+    {
+        HOST_TEST_ASSERT((int8_t)enc[offset] == *p_advdata->p_tx_power_level);
+    }
+
+    offset = ad_value_find(enc, enc_len, BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA, 0);
+    if (p_advdata->p_manuf_specific_data != NULL)
+    {
+        uint8_array_t const * p_manuf = &p_advdata->p_manuf_specific_data->data;
+
+        HOST_TEST_ASSERT(uint16_decode(&enc[offset]) ==
+                         p_advdata->p_manuf_specific_data->company_identifier);
+        HOST_TEST_ASSERT(p_layout->manuf_specific_data == offset + sizeof(uint16_t));
+        HOST_TEST_ASSERT(memcmp(&enc[offset + sizeof(uint16_t)], p_manuf->p_data, p_manuf->size)
+                         == 0);
+    }
+    else
+    {
+        HOST_TEST_ASSERT(p_layout->manuf_specific_data == BLE_ADVDATA_OFFSET_INVALID);
+    }
+
+    for (uint8_t i = 0; i < BLE_ADVDATA_LAYOUT_SERVICE_DATA_MAX; i++)
+    {
+        offset = ad_value_find(enc, enc_len, BLE_GAP_AD_TYPE_SERVICE_DATA, i);
+        if (i < p_advdata->service_data_count)
+        {
+            ble_advdata_service_data_t const * p_srv = &p_advdata->p_service_data_array[i];
+
+            HOST_TEST_ASSERT(uint16_decode(&enc[offset]) == p_srv->service_uuid);
+            HOST_TEST_ASSERT(p_layout->service_data[i] == offset + sizeof(uint16_t));
+            HOST_TEST_ASSERT(memcmp(&enc[offset + sizeof(uint16_t)],
+                                    p_srv->data.p_data,
+                                    p_srv->data.size) == 0);
+        }
+        else
+        {
+            HOST_TEST_ASSERT(p_layout->service_data[i] == BLE_ADVDATA_OFFSET_INVALID);
+        }
+    }
+
+    offset = ad_value_find(enc, enc_len, BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME, 0);
+    if (offset == BLE_ADVDATA_OFFSET_INVALID)
+    {
+        offset = ad_value_find(enc, enc_len, BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME, 0);
+    }
+    HOST_TEST_ASSERT(p_layout->name == offset);
+    if (offset != BLE_ADVDATA_OFFSET_INVALID)
+    {
+        uint16_t name_len = enc[offset - 2] - 1;
+
+        HOST_TEST_ASSERT(memcmp(&enc[offset], DEVICE_NAME, name_len) == 0);
+    }
+}
+
+
+/**@brief Test of the layout of several sets of advertising data. */
+static void layout_test(void)
+{
+    int8_t                     tx_power     = -4;
+    uint8_t                    manuf[4]     = {1, 2, 3, 4};
+    uint8_t                    srv_0[2]     = {0x11, 0x12};
+    uint8_t                    srv_1[3]     = {0x21, 0x22, 0x23};
+    ble_advdata_manuf_data_t   manuf_data   = {COMPANY_ID, {sizeof(manuf), manuf}};
+    ble_advdata_service_data_t srv_data[BLE_ADVDATA_LAYOUT_SERVICE_DATA_MAX + 1] =
+    {
+        {SRV_UUID_0, {sizeof(srv_0), srv_0}},
+        {SRV_UUID_1, {sizeof(srv_1), srv_1}},
+        {0x1810,     {0, NULL}},
+        {0x1811,     {0, NULL}},
+        {0x1812,     {0, NULL}},
+    };
+    ble_uuid_t                 uuids[]      = {{0x180D, BLE_UUID_TYPE_BLE}};
+    ble_advdata_t              advdata;
+    ble_advdata_layout_t       layout;
+
+    // Everything that can be patched, with the full name.
+    memset(&advdata, 0, sizeof(advdata));
+    advdata.name_type             = BLE_ADVDATA_FULL_NAME;
+    advdata.flags                 = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    advdata.p_tx_power_level      = &tx_power;
+    advdata.p_manuf_specific_data = &manuf_data;
+    advdata.p_service_data_array  = srv_data;
+    advdata.service_data_count    = 2;
+    layout_check(&advdata, ENC_BUF_SIZE, &layout);
+    HOST_TEST_ASSERT(layout.name != BLE_ADVDATA_OFFSET_INVALID);
+
+    // Fields before the patchable ones shift the offsets.
+    advdata.include_appearance           = true;
+    advdata.uuids_complete.uuid_cnt      = ARRAY_SIZE(uuids);
+    advdata.uuids_complete.p_uuids       = uuids;
+    advdata.p_manuf_specific_data        = NULL;
+    advdata.service_data_count           = 1;
+    layout_check(&advdata, ENC_BUF_SIZE, &layout);
+
+    // The full name does not fit and is truncated to a short name.
+    advdata.p_manuf_specific_data = &manuf_data;
+    layout_check(&advdata, ENC_BUF_SIZE, &layout);
+    HOST_TEST_ASSERT(layout.len == ENC_BUF_SIZE);
+
+    // Service data that does not fit is rejected by both encoders.
+    uint8_t  buf[ENC_BUF_SIZE];
+    uint16_t len = sizeof(buf);
+    advdata.service_data_count = 2;
+    HOST_TEST_ASSERT(ble_advdata_encode(&advdata, buf, &len) == NRF_ERROR_DATA_SIZE);
+    len = sizeof(buf);
+    HOST_TEST_ASSERT(ble_advdata_encode_layout(&advdata, buf, &len, &layout)
+                     == NRF_ERROR_DATA_SIZE);
+
+    // Short name, and more service data than the layout records.
+    memset(&advdata, 0, sizeof(advdata));
+    advdata.name_type            = BLE_ADVDATA_SHORT_NAME;
+    advdata.short_name_len       = 4;
+    advdata.p_service_data_array = srv_data;
+    advdata.service_data_count   = ARRAY_SIZE(srv_data);
+    layout_check(&advdata, ENC_BUF_SIZE, &layout);
+
+    // Nothing that can be patched.
+    memset(&advdata, 0, sizeof(advdata));
+    advdata.flags = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    layout_check(&advdata, ENC_BUF_SIZE, &layout);
+    HOST_TEST_ASSERT((layout.tx_power_level == BLE_ADVDATA_OFFSET_INVALID) &&
+                     (layout.name == BLE_ADVDATA_OFFSET_INVALID));
+
+    printf("layout: OK\n");
+}
+
+
+/**@brief Test of ble_advertising_advdata_patch against the data encoded from scratch. */
+static void patch_test(void)
+{
+    static ble_advertising_t advertising;
+
+    int8_t                     tx_power   = 0;
+    uint8_t                    manuf[4]   = {0, 0, 0, 0};
+    uint8_t                    srv_0[2]   = {0, 0};
+    ble_advdata_manuf_data_t   manuf_data = {COMPANY_ID, {sizeof(manuf), manuf}};
+    ble_advdata_service_data_t srv_data   = {SRV_UUID_0, {sizeof(srv_0), srv_0}};
+    ble_advertising_init_t     init;
+    ble_advdata_layout_t       adv_layout;
+    ble_advdata_layout_t       sr_layout;
+    uint8_t                    scratch[ENC_BUF_SIZE];
+    uint16_t                   scratch_len;
+    uint8_t                    ref[ENC_BUF_SIZE];
+    uint16_t                   ref_len;
+
+    memset(&init, 0, sizeof(init));
+    init.advdata.name_type             = BLE_ADVDATA_SHORT_NAME;
+    init.advdata.short_name_len        = 6;
+    init.advdata.flags                 = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    init.advdata.p_tx_power_level      = &tx_power;
+    init.advdata.p_manuf_specific_data = &manuf_data;
+    init.srdata.p_service_data_array   = &srv_data;
+    init.srdata.service_data_count     = 1;
+    init.config.ble_adv_fast_enabled   = true;
+    init.config.ble_adv_fast_interval  = 64;
+    init.config.ble_adv_fast_timeout   = 0;
+
+    HOST_TEST_ASSERT(ble_advertising_init(&advertising, &init) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(ble_advertising_start(&advertising, BLE_ADV_MODE_FAST) == NRF_SUCCESS);
+
+    // The layout is recorded by encoding the same data into a scratch buffer.
+    scratch_len = sizeof(scratch);
+    HOST_TEST_ASSERT(ble_advdata_encode_layout(&init.advdata, scratch, &scratch_len, &adv_layout)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT((scratch_len == m_sd.adv_len) &&
+                     (memcmp(scratch, m_sd.adv, scratch_len) == 0));
+    scratch_len = sizeof(scratch);
+    HOST_TEST_ASSERT(ble_advdata_encode_layout(&init.srdata, scratch, &scratch_len, &sr_layout)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT((scratch_len == m_sd.sr_len) &&
+                     (memcmp(scratch, m_sd.sr, scratch_len) == 0));
+
+    for (uint32_t round = 1; round <= 4; round++)
+    {
+        uint8_t const * p_prev_adv = m_sd.p_adv;
+        uint8_t const * p_prev_sr  = m_sd.p_sr;
+
+        tx_power = -(int8_t)(4 * round);
+        memset(manuf, (int)round, sizeof(manuf));
+        memset(srv_0, (int)(0x80 + round), sizeof(srv_0));
+
+        ble_advertising_patch_t adv_patches[] =
+        {
+            {adv_layout.tx_power_level,      (uint8_t const *)&tx_power, sizeof(tx_power)},
+            {adv_layout.manuf_specific_data, manuf,                      sizeof(manuf)},
+        };
+        ble_advertising_patch_t sr_patches[] =
+        {
+            {sr_layout.service_data[0], srv_0, sizeof(srv_0)},
+        };
+
+        HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising,
+                                                       adv_patches, ARRAY_SIZE(adv_patches),
+                                                       sr_patches, ARRAY_SIZE(sr_patches))
+                         == NRF_SUCCESS);
+
+        // The SoftDevice gets the swap buffers, with the data it would get from ble_advdata_encode.
+        HOST_TEST_ASSERT((m_sd.p_adv != p_prev_adv) && (m_sd.p_sr != p_prev_sr));
+
+        ref_len = sizeof(ref);
+        HOST_TEST_ASSERT(ble_advdata_encode(&init.advdata, ref, &ref_len) == NRF_SUCCESS);
+        HOST_TEST_ASSERT((ref_len == m_sd.adv_len) && (memcmp(ref, m_sd.adv, ref_len) == 0));
+
+        ref_len = sizeof(ref);
+        HOST_TEST_ASSERT(ble_advdata_encode(&init.srdata, ref, &ref_len) == NRF_SUCCESS);
+        HOST_TEST_ASSERT((ref_len == m_sd.sr_len) && (memcmp(ref, m_sd.sr, ref_len) == 0));
+    }
+
+    // Only the scan response data is patched, the advertising data is carried over.
+    srv_0[0] = 0x55;
+    ble_advertising_patch_t sr_patch = {sr_layout.service_data[0], srv_0, 1};
+    HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising, NULL, 0, &sr_patch, 1)
+                     == NRF_SUCCESS);
+    ref_len = sizeof(ref);
+    HOST_TEST_ASSERT(ble_advdata_encode(&init.srdata, ref, &ref_len) == NRF_SUCCESS);
+    HOST_TEST_ASSERT((ref_len == m_sd.sr_len) && (memcmp(ref, m_sd.sr, ref_len) == 0));
+    ref_len = sizeof(ref);
+    HOST_TEST_ASSERT(ble_advdata_encode(&init.advdata, ref, &ref_len) == NRF_SUCCESS);
+    HOST_TEST_ASSERT((ref_len == m_sd.adv_len) && (memcmp(ref, m_sd.adv, ref_len) == 0));
+
+    printf("patch: OK\n");
+}
+
+
+/**@brief Test of the patches that are rejected. */
+static void patch_bounds_test(void)
+{
+    static ble_advertising_t advertising;
+    static ble_advertising_t advertising_uninit;
+
+    int8_t                  tx_power = -8;
+    uint8_t                 value[4] = {0xEE, 0xEE, 0xEE, 0xEE};
+    ble_advertising_init_t  init;
+    uint8_t                 adv[ENC_BUF_SIZE];
+    uint16_t                adv_len;
+    uint32_t                configure_cnt;
+
+    memset(&init, 0, sizeof(init));
+    init.advdata.name_type            = BLE_ADVDATA_FULL_NAME;
+    init.advdata.p_tx_power_level     = &tx_power;
+    init.config.ble_adv_fast_enabled  = true;
+    init.config.ble_adv_fast_interval = 64;
+
+    HOST_TEST_ASSERT(ble_advertising_init(&advertising, &init) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(ble_advertising_start(&advertising, BLE_ADV_MODE_FAST) == NRF_SUCCESS);
+
+    adv_len = m_sd.adv_len;
+    memcpy(adv, m_sd.adv, adv_len);
+    configure_cnt = m_sd.configure_cnt;
+
+    // A patch that ends at the end of the data is accepted.
+    ble_advertising_patch_t last = {adv_len - 1, value, 1};
+    HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising, &last, 1, NULL, 0)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT((m_sd.adv_len == adv_len) && (m_sd.adv[adv_len - 1] == 0xEE));
+    HOST_TEST_ASSERT(memcmp(m_sd.adv, adv, adv_len - 1) == 0);
+    adv[adv_len - 1] = 0xEE;
+    configure_cnt++;
+
+    // Patches past the end of the data are rejected, and nothing is handed to the SoftDevice.
+    ble_advertising_patch_t const rejected[] =
+    {
+        {adv_len,                    value, 1},
+        {adv_len - 1,                value, 2},
+        {adv_len - 3,                value, sizeof(value)},
+        {BLE_ADVDATA_OFFSET_INVALID, value, 1},
+        {0xFFFF,                     value, 0xFFFF},
+    };
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(rejected); i++)
+    {
+        ble_advertising_patch_t const patches[] = {last, rejected[i]};
+
+        HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising, patches, 2, NULL, 0)
+                         == NRF_ERROR_INVALID_PARAM);
+        HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising, &last, 1, &rejected[i], 1)
+                         == NRF_ERROR_INVALID_PARAM);
+    }
+
+    // There is no scan response data, so any patch of it is out of bounds.
+    ble_advertising_patch_t const sr_first = {0, value, 1};
+    HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising, NULL, 0, &sr_first, 1)
+                     == NRF_ERROR_INVALID_PARAM);
+
+    HOST_TEST_ASSERT(m_sd.configure_cnt == configure_cnt);
+    HOST_TEST_ASSERT((m_sd.adv_len == adv_len) && (memcmp(m_sd.adv, adv, adv_len) == 0));
+    HOST_TEST_ASSERT((advertising.adv_data.adv_data.len == adv_len) &&
+                     (memcmp(advertising.adv_data.adv_data.p_data, adv, adv_len) == 0));
+
+    ble_advertising_patch_t const no_data = {0, NULL, 1};
+    HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising, &no_data, 1, NULL, 0)
+                     == NRF_ERROR_NULL);
+    HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising, NULL, 1, NULL, 0)
+                     == NRF_ERROR_NULL);
+    HOST_TEST_ASSERT(ble_advertising_advdata_patch(&advertising_uninit, &last, 1, NULL, 0)
+                     == NRF_ERROR_INVALID_STATE);
+    HOST_TEST_ASSERT(m_sd.configure_cnt == configure_cnt);
+
+    printf("patch bounds: OK\n");
+}
+
+
+int main(void)
+{
+    layout_test();
+    patch_test();
+    patch_bounds_test();
+
+    return 0;
+}
@@ -0,0 +1,591 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the nrf_ble_gq priority lanes, coalescing, statistics and payload handling.
+ *
+ * The SoftDevice is replaced by a stub that accepts a set number of requests and asks to retry
+ * the others later, and records the handle and the first value byte of every accepted request.
+ * The tests that need the high priority lane, coalescing or statistics check that the feature
+ * is rejected or compiled out when it is disabled.
+ *
+ * Payloads are runs of consecutive byte values. The stub checks the whole payload when it
+ * accepts a request and then overwrites it, like the owner of the memory would once the
+ * SoftDevice call has returned. A payload read again after its request was accepted no longer
+ * passes the check.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_ble_gq.h"
+#include "app_timer.h"
+#include "host_test.h"
+
+#define CONN_HANDLE     5       // Connection handle of the test link.
+#define QUEUE_SIZE      8       // Number of requests in the normal priority queue.
+#define LOG_SIZE        32      // Number of requests recorded by the SoftDevice stub.
+#define FAIL_HANDLE     0x99    // Requests to this handle are rejected by the SoftDevice stub.
+#define NO_VALUE        0xFF    // Recorded value of the requests that carry no data.
+#define POISON          0xDD    // Written over a payload once its request is accepted.
+
+/**@brief Request recorded by the SoftDevice stub. */
+typedef struct
+{
+    uint16_t        handle;
+    uint8_t         value;
+    uint8_t const * p_data;     // Payload pointer passed to the SoftDevice.
+    uint8_t         pool_used;  // Utilization of the data pool during the SoftDevice call.
+} sd_log_entry_t;
+
+NRF_BLE_GQ_DEF(m_gatt_queue, 1, QUEUE_SIZE);
+
+static sd_log_entry_t m_sd_log[LOG_SIZE];
+static uint32_t       m_sd_log_cnt;
+static uint32_t       m_sd_credits;     // Number of requests the SoftDevice stub accepts.
+static uint32_t       m_ticks;
+static uint32_t       m_error_cnt;
+static ret_code_t     m_last_error;
+static bool           m_sd_in_call;
+static void        (* m_sd_hook)(void); // Called once from within the next accepted request.
+
+
+uint32_t app_timer_cnt_get(void)
+{
+    return m_ticks;
+}
+
+
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from)
+{
+    return ticks_to - ticks_from;
+}
+
+
+/**@brief Function for checking that a payload is a run of consecutive byte values. */
+static void payload_check(uint8_t const * p_data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        HOST_TEST_ASSERT(p_data[i] == (uint8_t)(p_data[0] + i));
+    }
+}
+
+
+/**@brief Function for accepting a request in the SoftDevice stub.
+ *
+ * @param[in] handle  Attribute handle of the request.
+ * @param[in] p_data  Value of the request, NULL if it carries no data.
+ * @param[in] len     Length of the value.
+ * @param[in] busy    Error code returned when there are no credits left.
+ */
+static uint32_t sd_request(uint16_t handle, uint8_t const * p_data, uint16_t len, uint32_t busy)
+{
+    // A request from a context that preempted the SoftDevice call is retried later.
+    if ((m_sd_credits == 0) || m_sd_in_call)
+    {
+        return busy;
+    }
+    m_sd_credits--;
+
+    if (handle == FAIL_HANDLE)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    HOST_TEST_ASSERT(m_sd_log_cnt < LOG_SIZE);
+    m_sd_log[m_sd_log_cnt].handle    = handle;
+    m_sd_log[m_sd_log_cnt].value     = (p_data != NULL) ? p_data[0] : NO_VALUE;
+    m_sd_log[m_sd_log_cnt].p_data    = p_data;
+    m_sd_log[m_sd_log_cnt].pool_used = nrf_balloc_utilization_get(m_gatt_queue.p_data_pool);
+    m_sd_log_cnt++;
+
+    if (p_data != NULL)
+    {
+        payload_check(p_data, len);
+
+        if (m_sd_hook != NULL)
+        {
+            void (* hook)(void) = m_sd_hook;
+
+            m_sd_hook    = NULL;
+            m_sd_in_call = true;
+            hook();
+            m_sd_in_call = false;
+
+            HOST_TEST_ASSERT(p_data[0] == m_sd_log[m_sd_log_cnt - 1].value);
+            payload_check(p_data, len);
+        }
+
+        memset((void *)p_data, POISON, len);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gattc_read(uint16_t conn_handle, uint16_t handle, uint16_t offset)
+{
+    return sd_request(handle, NULL, 0, NRF_ERROR_BUSY);
+}
+
+
+uint32_t sd_ble_gattc_write(uint16_t conn_handle, ble_gattc_write_params_t const * p_write_params)
+{
+    // Write commands are limited by the SoftDevice queue, write requests by the ATT procedure.
+    return sd_request(p_write_params->handle,
+                      p_write_params->p_value,
+                      p_write_params->len,
+                      (p_write_params->write_op == BLE_GATT_OP_WRITE_CMD) ? NRF_ERROR_RESOURCES
+                                                                          : NRF_ERROR_BUSY);
+}
+
+
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params)
+{
+    return sd_request(p_hvx_params->handle,
+                      p_hvx_params->p_data,
+                      *p_hvx_params->p_len,
+                      NRF_ERROR_RESOURCES);
+}
+
+
+uint32_t sd_ble_gattc_primary_services_discover(uint16_t           conn_handle,
+                                                uint16_t           start_handle,
+                                                ble_uuid_t const * p_srvc_uuid)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gattc_characteristics_discover(uint16_t                         conn_handle,
+                                               ble_gattc_handle_range_t const * p_handle_range)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gattc_descriptors_discover(uint16_t                         conn_handle,
+                                           ble_gattc_handle_range_t const * p_handle_range)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gattc_char_value_by_uuid_read(uint16_t                         conn_handle,
+                                              ble_uuid_t const               * p_uuid,
+                                              ble_gattc_handle_range_t const * p_handle_range)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+static void error_handler(uint32_t nrf_error, void * p_ctx, uint16_t conn_handle)
+{
+    HOST_TEST_ASSERT(conn_handle == CONN_HANDLE);
+    m_error_cnt++;
+    m_last_error = nrf_error;
+}
+
+
+/**@brief Function for sending a BLE event of the test link to the GATT queue. */
+static void ble_evt_send(uint16_t evt_id)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id = evt_id;
+    if (evt_id == BLE_GAP_EVT_DISCONNECTED)
+    {
+        evt.evt.gap_evt.conn_handle = CONN_HANDLE;
+    }
+    else
+    {
+        evt.evt.gattc_evt.conn_handle = CONN_HANDLE;
+    }
+    nrf_ble_gq_on_ble_evt(&evt, &m_gatt_queue);
+}
+
+
+/**@brief Function for starting a test on a newly connected link with a busy SoftDevice. */
+static void link_reset(void)
+{
+    ble_evt_send(BLE_GAP_EVT_DISCONNECTED);
+    HOST_TEST_ASSERT(nrf_ble_gq_conn_handle_register(&m_gatt_queue, CONN_HANDLE) == NRF_SUCCESS);
+
+    m_sd_log_cnt = 0;
+    m_sd_credits = 0;
+    m_ticks      = 0;
+    m_error_cnt  = 0;
+}
+
+
+/**@brief Function for letting the SoftDevice accept all requests and processing the queues. */
+static void sd_release(void)
+{
+    m_sd_credits = UINT32_MAX;
+    ble_evt_send(BLE_GATTC_EVT_WRITE_RSP);
+}
+
+
+/**@brief Function for checking the handles of the requests accepted by the SoftDevice. */
+static void sd_log_check(uint16_t const * p_handles, uint8_t const * p_values, uint32_t count)
+{
+    HOST_TEST_ASSERT(m_sd_log_cnt == count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        HOST_TEST_ASSERT(m_sd_log[i].handle == p_handles[i]);
+        HOST_TEST_ASSERT(m_sd_log[i].value == p_values[i]);
+    }
+}
+
+
+static ret_code_t read_add(uint16_t handle, nrf_ble_gq_prio_t prio)
+{
+    nrf_ble_gq_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.type                     = NRF_BLE_GQ_REQ_GATTC_READ;
+    req.error_handler.cb         = error_handler;
+    req.params.gattc_read.handle = handle;
+
+    return nrf_ble_gq_item_add_prio(&m_gatt_queue, &req, CONN_HANDLE, prio);
+}
+
+
+/**@brief Function for filling a payload with consecutive byte values.
+ *
+ * The buffer is overwritten after the request is added, as the payload belongs to the caller.
+ */
+static void payload_fill(uint8_t * p_data, uint8_t value, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        p_data[i] = value + i;
+    }
+}
+
+
+static ret_code_t write_add_len(uint16_t handle, uint8_t write_op, uint8_t value, uint16_t len)
+{
+    nrf_ble_gq_req_t req;
+    ret_code_t       err_code;
+    uint8_t          data[NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN];
+
+    payload_fill(data, value, len);
+
+    memset(&req, 0, sizeof(req));
+    req.type                        = NRF_BLE_GQ_REQ_GATTC_WRITE;
+    req.error_handler.cb            = error_handler;
+    req.params.gattc_write.write_op = write_op;
+    req.params.gattc_write.handle   = handle;
+    req.params.gattc_write.len      = len;
+    req.params.gattc_write.p_value  = data;
+
+    err_code = nrf_ble_gq_item_add(&m_gatt_queue, &req, CONN_HANDLE);
+    memset(data, POISON, sizeof(data));
+
+    return err_code;
+}
+
+
+static ret_code_t write_add(uint16_t handle, uint8_t write_op, uint8_t value)
+{
+    return write_add_len(handle, write_op, value, 1);
+}
+
+
+static ret_code_t hvx_add_len(uint16_t handle, uint8_t type, uint8_t value, uint16_t len)
+{
+    nrf_ble_gq_req_t req;
+    ret_code_t       err_code;
+    uint8_t          data[NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN];
+
+    payload_fill(data, value, len);
+
+    memset(&req, 0, sizeof(req));
+    req.type                    = NRF_BLE_GQ_REQ_GATTS_HVX;
+    req.error_handler.cb        = error_handler;
+    req.params.gatts_hvx.type   = type;
+    req.params.gatts_hvx.handle = handle;
+    req.params.gatts_hvx.p_len  = &len;
+    req.params.gatts_hvx.p_data = data;
+
+    err_code = nrf_ble_gq_item_add(&m_gatt_queue, &req, CONN_HANDLE);
+    memset(data, POISON, sizeof(data));
+
+    return err_code;
+}
+
+
+static ret_code_t hvx_add(uint16_t handle, uint8_t type, uint8_t value)
+{
+    return hvx_add_len(handle, type, value, 1);
+}
+
+
+/**@brief Test of the order in which the priority lanes are passed to the SoftDevice. */
+static void lanes_test(void)
+{
+    link_reset();
+
+#if NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE > 0
+    static uint16_t const handles[] = {3, 4, 1, 2, 5, 6};
+    static uint8_t const  values[]  = {NO_VALUE, NO_VALUE, NO_VALUE, NO_VALUE, NO_VALUE, NO_VALUE};
+
+    // High priority requests overtake the queued normal ones, each lane stays in order.
+    HOST_TEST_ASSERT(read_add(1, NRF_BLE_GQ_PRIO_NORMAL) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(read_add(2, NRF_BLE_GQ_PRIO_NORMAL) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(read_add(3, NRF_BLE_GQ_PRIO_HIGH) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(read_add(4, NRF_BLE_GQ_PRIO_HIGH) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(m_sd_log_cnt == 0);
+    sd_release();
+    sd_log_check(handles, values, 4);
+
+    // A normal request does not bypass a waiting high priority request, even if the
+    // SoftDevice is free when it is added.
+    m_sd_credits = 0;
+    HOST_TEST_ASSERT(read_add(5, NRF_BLE_GQ_PRIO_HIGH) == NRF_SUCCESS);
+    m_sd_credits = UINT32_MAX;
+    HOST_TEST_ASSERT(read_add(6, NRF_BLE_GQ_PRIO_NORMAL) == NRF_SUCCESS);
+    sd_log_check(handles, values, 6);
+
+    // The high priority lane has its own size.
+    m_sd_credits = 0;
+    for (uint32_t i = 0; i < NRF_BLE_GQ_HIGH_PRIO_QUEUE_SIZE; i++)
+    {
+        HOST_TEST_ASSERT(read_add(7, NRF_BLE_GQ_PRIO_HIGH) == NRF_SUCCESS);
+    }
+    HOST_TEST_ASSERT(read_add(7, NRF_BLE_GQ_PRIO_HIGH) == NRF_ERROR_NO_MEM);
+    HOST_TEST_ASSERT(read_add(8, NRF_BLE_GQ_PRIO_NORMAL) == NRF_SUCCESS);
+#else
+    HOST_TEST_ASSERT(read_add(1, NRF_BLE_GQ_PRIO_HIGH) == NRF_ERROR_NOT_SUPPORTED);
+    HOST_TEST_ASSERT(read_add(1, NRF_BLE_GQ_PRIO_NUM) == NRF_ERROR_INVALID_PARAM);
+#endif
+
+    printf("Priority lanes: OK\n");
+}
+
+
+/**@brief Test of the replacement of queued notifications and write commands. */
+static void coalesce_test(void)
+{
+    link_reset();
+
+    // The first request is at the head of the queue and is never replaced. A write request is
+    // not replaced by a write command to the same handle.
+    m_ticks = 0;
+    HOST_TEST_ASSERT(write_add(10, BLE_GATT_OP_WRITE_CMD, 'A') == NRF_SUCCESS);
+    m_ticks = 5;
+    HOST_TEST_ASSERT(write_add(11, BLE_GATT_OP_WRITE_CMD, 'B') == NRF_SUCCESS);
+    m_ticks = 6;
+    HOST_TEST_ASSERT(write_add(11, BLE_GATT_OP_WRITE_REQ, 'X') == NRF_SUCCESS);
+    HOST_TEST_ASSERT(hvx_add(12, BLE_GATT_HVX_NOTIFICATION, 'D') == NRF_SUCCESS);
+    HOST_TEST_ASSERT(hvx_add(13, BLE_GATT_HVX_INDICATION, 'I') == NRF_SUCCESS);
+    m_ticks = 9;
+    HOST_TEST_ASSERT(write_add(10, BLE_GATT_OP_WRITE_CMD, 'Z') == NRF_SUCCESS);
+    HOST_TEST_ASSERT(hvx_add(13, BLE_GATT_HVX_INDICATION, 'J') == NRF_SUCCESS);
+
+#if NRF_BLE_GQ_COALESCE_ENABLED
+    static uint16_t const handles[] = {10, 11, 11, 12, 13, 10, 13};
+    static uint8_t const  values[]  = {'A', 'C', 'X', 'E', 'I', 'Z', 'J'};
+
+    // Many more values than the data pool holds, so the replaced data must be freed.
+    for (uint32_t i = 0; i < 4 * NRF_BLE_GQ_DATAPOOL_ELEMENT_COUNT; i++)
+    {
+        HOST_TEST_ASSERT(write_add(11, BLE_GATT_OP_WRITE_CMD, 'a' + (i % 2)) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(hvx_add(12, BLE_GATT_HVX_NOTIFICATION, 'd' + (i % 2)) == NRF_SUCCESS);
+    }
+    HOST_TEST_ASSERT(write_add(11, BLE_GATT_OP_WRITE_CMD, 'C') == NRF_SUCCESS);
+    HOST_TEST_ASSERT(hvx_add(12, BLE_GATT_HVX_NOTIFICATION, 'E') == NRF_SUCCESS);
+#else
+    static uint16_t const handles[] = {10, 11, 11, 12, 13, 10, 13, 11};
+    static uint8_t const  values[]  = {'A', 'B', 'X', 'D', 'I', 'Z', 'J', 'C'};
+
+    HOST_TEST_ASSERT(write_add(11, BLE_GATT_OP_WRITE_CMD, 'C') == NRF_SUCCESS);
+    HOST_TEST_ASSERT(write_add(11, BLE_GATT_OP_WRITE_CMD, 'D') == NRF_ERROR_NO_MEM);
+#endif
+
+    m_ticks = 20;
+    sd_release();
+    sd_log_check(handles, values, ARRAY_SIZE(handles));
+
+#if NRF_BLE_GQ_STATS_ENABLED
+    nrf_ble_gq_stats_t stats;
+
+    // The latency of a replaced value counts from the time the first value was queued.
+    HOST_TEST_ASSERT(nrf_ble_gq_stats_get(&m_gatt_queue, CONN_HANDLE, &stats) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(stats.queued == 7);
+    HOST_TEST_ASSERT(stats.coalesced == 8 * NRF_BLE_GQ_DATAPOOL_ELEMENT_COUNT + 2);
+    HOST_TEST_ASSERT(stats.processed == 7);
+    HOST_TEST_ASSERT(stats.latency_sum == 20 + 15 + 14 + 14 + 14 + 11 + 11);
+    HOST_TEST_ASSERT(stats.latency_max == 20);
+    HOST_TEST_ASSERT(stats.max_depth == 7);
+#endif
+
+    printf("Coalescing: OK\n");
+}
+
+
+/**@brief Test of the per-link statistics. */
+static void stats_test(void)
+{
+    nrf_ble_gq_stats_t stats;
+
+    link_reset();
+
+#if NRF_BLE_GQ_STATS_ENABLED
+    // Requests accepted at once have no latency, failed requests are counted.
+    m_sd_credits = UINT32_MAX;
+    HOST_TEST_ASSERT(read_add(1, NRF_BLE_GQ_PRIO_NORMAL) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(read_add(FAIL_HANDLE, NRF_BLE_GQ_PRIO_NORMAL) == NRF_SUCCESS);
+    HOST_TEST_ASSERT((m_error_cnt == 1) && (m_last_error == NRF_ERROR_INVALID_STATE));
+
+    m_sd_credits = 0;
+    m_ticks      = 100;
+    HOST_TEST_ASSERT(read_add(FAIL_HANDLE, NRF_BLE_GQ_PRIO_NORMAL) == NRF_SUCCESS);
+    m_ticks      = 110;
+    HOST_TEST_ASSERT(read_add(2, NRF_BLE_GQ_PRIO_NORMAL) == NRF_SUCCESS);
+    m_ticks      = 130;
+    sd_release();
+    HOST_TEST_ASSERT(m_error_cnt == 2);
+
+    HOST_TEST_ASSERT(nrf_ble_gq_stats_get(&m_gatt_queue, CONN_HANDLE, &stats) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(stats.processed == 4);
+    HOST_TEST_ASSERT(stats.failed == 2);
+    HOST_TEST_ASSERT(stats.queued == 2);
+    HOST_TEST_ASSERT(stats.coalesced == 0);
+    HOST_TEST_ASSERT(stats.latency_sum == 30 + 20);
+    HOST_TEST_ASSERT(stats.latency_max == 30);
+    HOST_TEST_ASSERT(stats.max_depth == 2);
+
+    // Statistics of an unknown link are not available, and are reset on a new connection.
+    HOST_TEST_ASSERT(nrf_ble_gq_stats_get(&m_gatt_queue, CONN_HANDLE + 1, &stats) ==
+                     NRF_ERROR_INVALID_PARAM);
+    link_reset();
+    HOST_TEST_ASSERT(nrf_ble_gq_stats_get(&m_gatt_queue, CONN_HANDLE, &stats) == NRF_SUCCESS);
+    HOST_TEST_ASSERT((stats.processed == 0) && (stats.max_depth == 0));
+#else
+    HOST_TEST_ASSERT(nrf_ble_gq_stats_get(&m_gatt_queue, CONN_HANDLE, &stats) ==
+                     NRF_ERROR_NOT_SUPPORTED);
+#endif
+
+    printf("Statistics: OK\n");
+}
+
+
+/**@brief Function for checking if a pointer is inside the data pool of the GATT queue. */
+static bool is_in_pool(void const * p_data)
+{
+    nrf_memobj_pool_t const * p_pool  = m_gatt_queue.p_data_pool;
+    uint8_t const           * p_begin = (uint8_t const *)p_pool->p_memory_begin;
+    size_t                    size    = p_pool->block_size *
+                                        (size_t)(p_pool->p_stack_limit - p_pool->p_stack_base);
+
+    return ((uint8_t const *)p_data >= p_begin) && ((uint8_t const *)p_data < p_begin + size);
+}
+
+
+/**@brief Function for adding a request from a context that preempts a SoftDevice call. */
+static void preempting_write_add(void)
+{
+    HOST_TEST_ASSERT(write_add_len(30,
+                                   BLE_GATT_OP_WRITE_CMD,
+                                   'x',
+                                   NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN) == NRF_SUCCESS);
+}
+
+
+/**@brief Test of the payloads passed to the SoftDevice from the data pool.
+ *
+ * A payload that fits in one chunk of the data pool is passed in place, a longer one is gathered
+ * into a buffer. With the default pool, only notifications are long enough to be gathered. Either way it is complete when the SoftDevice accepts the request, is not
+ * touched by a request added from a context that preempts the SoftDevice call, and is not read
+ * once the request was accepted. The data is freed as soon as the SoftDevice call returns.
+ */
+static void payload_test(void)
+{
+    size_t in_place_len = nrf_memobj_contiguous_size_get(m_gatt_queue.p_data_pool);
+
+    // Notifications store the length in front of the data.
+    HOST_TEST_ASSERT(in_place_len >= NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN);
+    HOST_TEST_ASSERT(NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN + sizeof(uint16_t) > in_place_len);
+
+    link_reset();
+
+    HOST_TEST_ASSERT(write_add_len(30,
+                                   BLE_GATT_OP_WRITE_CMD,
+                                   'a',
+                                   NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(hvx_add_len(31,
+                                 BLE_GATT_HVX_NOTIFICATION,
+                                 'b',
+                                 in_place_len - sizeof(uint16_t)) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(hvx_add_len(32,
+                                 BLE_GATT_HVX_NOTIFICATION,
+                                 'c',
+                                 NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_balloc_utilization_get(m_gatt_queue.p_data_pool) == 4);
+
+    m_sd_hook = preempting_write_add;
+    sd_release();
+
+    static uint16_t const handles[] = {30, 31, 32, 30};
+    static uint8_t const  values[]  = {'a', 'b', 'c', 'x'};
+
+    sd_log_check(handles, values, ARRAY_SIZE(handles));
+    HOST_TEST_ASSERT(is_in_pool(m_sd_log[0].p_data) && is_in_pool(m_sd_log[1].p_data));
+    HOST_TEST_ASSERT(!is_in_pool(m_sd_log[2].p_data) && is_in_pool(m_sd_log[3].p_data));
+    for (uint32_t i = 0; i < ARRAY_SIZE(handles); i++)
+    {
+        HOST_TEST_ASSERT(m_sd_log[i].pool_used > 0);
+    }
+    HOST_TEST_ASSERT(nrf_balloc_utilization_get(m_gatt_queue.p_data_pool) == 0);
+
+    printf("Payloads: OK (%u bytes in place)\n", (unsigned)in_place_len);
+}
+
+
+int main(void)
+{
+    lanes_test();
+    coalesce_test();
+    stats_test();
+    payload_test();
+
+    return 0;
+}
@@ -0,0 +1,524 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Replay benchmark of the nrf_ble_scan filters.
+ *
+ * A corpus of advertising reports, as seen by a scanner in a crowded environment, is generated
+ * once with a fixed seed: flags, 16-bit and 128-bit service UUIDs, complete and short names,
+ * appearance and manufacturer specific data, in random combinations. A small share of the
+ * reports carries an address, a name, a UUID or an appearance from the filter set.
+ *
+ * The corpus is replayed through nrf_ble_scan_on_ble_evt with a small and a large filter set.
+ * The match result of every report is checked against a reference matcher, which tests the
+ * filters one by one with the ble_advdata search functions. The time per report of both is
+ * reported.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_ble_scan.h"
+#include "ble_advdata.h"
+#include "host_test.h"
+
+#define REPORT_COUNT        4096    // Number of reports in the corpus.
+#define REPLAY_COUNT        50      // Number of times the corpus is replayed.
+#define MATCH_PERCENT       3       // Share of the report fields taken from the filter set.
+#define VENDOR_UUID_TYPE    BLE_UUID_TYPE_VENDOR_BEGIN
+#define UUID16_SIZE         2       // Size of a 16-bit UUID.
+#define UUID128_SIZE        16      // Size of a 128-bit UUID.
+
+/**@brief Filter set. */
+typedef struct
+{
+    char const * p_name;
+    uint8_t      name_cnt;
+    uint8_t      short_name_cnt;
+    uint8_t      uuid_cnt;
+    uint8_t      addr_cnt;
+    uint8_t      appearance_cnt;
+} filter_set_t;
+
+typedef struct
+{
+    uint8_t        data[BLE_GAP_ADV_SET_DATA_SIZE_MAX];
+    uint16_t       len;
+    ble_gap_addr_t addr;
+} report_t;
+
+static filter_set_t const m_filter_sets[] =
+{
+    {"small", 2,                     1,                           4,                     4,
+     2},
+    {"large", NRF_BLE_SCAN_NAME_CNT, NRF_BLE_SCAN_SHORT_NAME_CNT, NRF_BLE_SCAN_UUID_CNT,
+     NRF_BLE_SCAN_ADDRESS_CNT, NRF_BLE_SCAN_APPEARANCE_CNT},
+};
+
+static char                      m_names[NRF_BLE_SCAN_NAME_CNT][NRF_BLE_SCAN_NAME_MAX_LEN];
+static nrf_ble_scan_short_name_t m_short_names[NRF_BLE_SCAN_SHORT_NAME_CNT];
+static char                      m_short_name_strs[NRF_BLE_SCAN_SHORT_NAME_CNT][16];
+static ble_uuid_t                m_uuids[NRF_BLE_SCAN_UUID_CNT];
+static uint8_t                   m_addrs[NRF_BLE_SCAN_ADDRESS_CNT][BLE_GAP_ADDR_LEN];
+static uint16_t                  m_appearances[NRF_BLE_SCAN_APPEARANCE_CNT];
+
+static report_t                  m_reports[REPORT_COUNT];
+static nrf_ble_scan_t            m_scan;
+static filter_set_t const *      mp_set;
+static uint32_t                  m_rand_state = 0x9E3779B9;
+static uint8_t                   m_scan_buffer[NRF_BLE_SCAN_BUFFER];
+static nrf_ble_scan_filter_match m_match;
+static bool                      m_matched;
+static union
+{
+    ble_evt_t evt;
+    uint8_t   buf[sizeof(ble_evt_t) + BLE_GAP_ADV_SET_DATA_SIZE_MAX];
+} m_evt;
+
+
+uint32_t sd_ble_uuid_encode(ble_uuid_t const * p_uuid, uint8_t * p_uuid_le_len, uint8_t * p_uuid_le)
+{
+    if (p_uuid->type == BLE_UUID_TYPE_BLE)
+    {
+        *p_uuid_le_len = UUID16_SIZE;
+        if (p_uuid_le != NULL)
+        {
+            (void)uint16_encode(p_uuid->uuid, p_uuid_le);
+        }
+        return NRF_SUCCESS;
+    }
+    if (p_uuid->type == VENDOR_UUID_TYPE)
+    {
+        *p_uuid_le_len = UUID128_SIZE;
+        if (p_uuid_le != NULL)
+        {
+            for (uint8_t i = 0; i < UUID128_SIZE; i++)
+            {
+                p_uuid_le[i] = 0xA0 + i;
+            }
+            (void)uint16_encode(p_uuid->uuid, &p_uuid_le[12]);
+        }
+        return NRF_SUCCESS;
+    }
+    return NRF_ERROR_INVALID_PARAM;
+}
+
+
+uint32_t sd_ble_gap_scan_start(ble_gap_scan_params_t const * p_scan_params,
+                               ble_data_t const *            p_adv_report_buffer)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_scan_stop(void)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_connect(ble_gap_addr_t const *        p_peer_addr,
+                            ble_gap_scan_params_t const * p_scan_params,
+                            ble_gap_conn_params_t const * p_conn_params,
+                            uint8_t                       conn_cfg_tag)
+{
+    return NRF_SUCCESS;
+}
+
+
+/* Used by the ble_advdata encoder only. */
+uint32_t sd_ble_gap_addr_get(ble_gap_addr_t * p_addr)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gap_appearance_get(uint16_t * p_appearance)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gap_device_name_get(uint8_t * p_dev_name, uint16_t * p_len)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+static void scan_evt_handler(scan_evt_t const * p_scan_evt)
+{
+    m_matched = (p_scan_evt->scan_evt_id == NRF_BLE_SCAN_EVT_FILTER_MATCH);
+    m_match   = p_scan_evt->params.filter_match.filter_match;
+}
+
+
+/**@brief Function for generating the filter values. Filter i of each type is the same in all sets. */
+static void filters_generate(void)
+{
+    for (uint32_t i = 0; i < NRF_BLE_SCAN_NAME_CNT; i++)
+    {
+        sprintf(m_names[i], "Sensor_%04X", (unsigned)(0x1000 + i * 7));
+    }
+    for (uint32_t i = 0; i < NRF_BLE_SCAN_SHORT_NAME_CNT; i++)
+    {
+        sprintf(m_short_name_strs[i], "Gateway_%02u", (unsigned)i);
+        m_short_names[i].p_short_name       = m_short_name_strs[i];
+        m_short_names[i].short_name_min_len = 4;
+    }
+    for (uint32_t i = 0; i < NRF_BLE_SCAN_UUID_CNT; i++)
+    {
+        // Every fourth UUID filter is a vendor specific UUID.
+        m_uuids[i].type = ((i % 4) == 3) ? VENDOR_UUID_TYPE : BLE_UUID_TYPE_BLE;
+        m_uuids[i].uuid = 0x1800 + i;
+    }
+    for (uint32_t i = 0; i < NRF_BLE_SCAN_ADDRESS_CNT; i++)
+    {
+        for (uint32_t j = 0; j < BLE_GAP_ADDR_LEN; j++)
+        {
+            m_addrs[i][j] = (uint8_t)host_rand(&m_rand_state);
+        }
+        m_addrs[i][BLE_GAP_ADDR_LEN - 1] |= 0xC0;
+    }
+    for (uint32_t i = 0; i < NRF_BLE_SCAN_APPEARANCE_CNT; i++)
+    {
+        m_appearances[i] = BLE_APPEARANCE_GENERIC_TAG + i;
+    }
+}
+
+
+static bool chance(uint32_t percent)
+{
+    return (host_rand(&m_rand_state) % 100) < percent;
+}
+
+
+/**@brief Function for appending an AD structure if it fits. */
+static void field_add(report_t * p_report, uint8_t type, void const * p_data, uint8_t len)
+{
+    if (p_report->len + 2 + len > BLE_GAP_ADV_SET_DATA_SIZE_MAX)
+    {
+        return;
+    }
+    p_report->data[p_report->len++] = len + 1;
+    p_report->data[p_report->len++] = type;
+    memcpy(&p_report->data[p_report->len], p_data, len);
+    p_report->len += len;
+}
+
+
+/**@brief Function for generating a report. Filter values are taken from the large filter set. */
+static void report_generate(report_t * p_report)
+{
+    uint8_t buf[BLE_GAP_ADV_SET_DATA_SIZE_MAX];
+    uint8_t len;
+    uint8_t flags = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+
+    memset(p_report, 0, sizeof(*p_report));
+
+    p_report->addr.addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC;
+    if (chance(MATCH_PERCENT))
+    {
+        memcpy(p_report->addr.addr, m_addrs[host_rand(&m_rand_state) % NRF_BLE_SCAN_ADDRESS_CNT],
+               BLE_GAP_ADDR_LEN);
+    }
+    else
+    {
+        for (uint32_t j = 0; j < BLE_GAP_ADDR_LEN; j++)
+        {
+            p_report->addr.addr[j] = (uint8_t)host_rand(&m_rand_state);
+        }
+    }
+
+    field_add(p_report, BLE_GAP_AD_TYPE_FLAGS, &flags, sizeof(flags));
+
+    if (chance(60))
+    {
+        // 16-bit UUIDs mostly outside of the filter range.
+        len = 2 * (1 + host_rand(&m_rand_state) % 3);
+        for (uint8_t i = 0; i < len; i += 2)
+        {
+            uint16_t uuid = chance(MATCH_PERCENT) ? (0x1800 + host_rand(&m_rand_state) % 256) :
+                                                    (0x2A00 + host_rand(&m_rand_state) % 256);
+            (void)uint16_encode(uuid, &buf[i]);
+        }
+        field_add(p_report, BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE, buf, len);
+    }
+    if (chance(20))
+    {
+        ble_uuid_t uuid = {.uuid = 0x1803 + 4 * (host_rand(&m_rand_state) % 64),
+                           .type = VENDOR_UUID_TYPE};
+
+        if (!chance(MATCH_PERCENT))
+        {
+            uuid.uuid += 0x4000;
+        }
+        (void)sd_ble_uuid_encode(&uuid, &len, buf);
+        field_add(p_report, BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE, buf, len);
+    }
+    if (chance(40))
+    {
+        uint32_t id = chance(MATCH_PERCENT) ? (0x1000 + 7 * (host_rand(&m_rand_state) % 32)) :
+                                              (host_rand(&m_rand_state) & 0xFFFF);
+
+        len = (uint8_t)sprintf((char *)buf, "Sensor_%04X", (unsigned)id);
+        field_add(p_report, BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME, buf, len);
+    }
+    else if (chance(20))
+    {
+        len = (uint8_t)sprintf((char *)buf, chance(10) ? "Gateway_%02u" : "Phone_%02u",
+                               (unsigned)(host_rand(&m_rand_state) % 8));
+        len = 3 + host_rand(&m_rand_state) % (len - 3);
+        field_add(p_report, BLE_GAP_AD_TYPE_SHORT_LOCAL_NAME, buf, len);
+    }
+    if (chance(30))
+    {
+        uint16_t appearance = chance(MATCH_PERCENT) ?
+                              (BLE_APPEARANCE_GENERIC_TAG + host_rand(&m_rand_state) % 32) :
+                              BLE_APPEARANCE_GENERIC_PHONE;
+
+        (void)uint16_encode(appearance, buf);
+        field_add(p_report, BLE_GAP_AD_TYPE_APPEARANCE, buf, sizeof(uint16_t));
+    }
+    if (chance(50))
+    {
+        len = 4 + host_rand(&m_rand_state) % 20;
+        for (uint8_t i = 0; i < len; i++)
+        {
+            buf[i] = (uint8_t)host_rand(&m_rand_state);
+        }
+        field_add(p_report, BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA, buf, len);
+    }
+}
+
+
+/**@brief Function for setting the filters of a set. */
+static void filters_set(filter_set_t const * p_set)
+{
+    ret_code_t err_code;
+
+    HOST_TEST_ASSERT(nrf_ble_scan_all_filter_remove(&m_scan) == NRF_SUCCESS);
+
+    for (uint32_t i = 0; i < p_set->name_cnt; i++)
+    {
+        err_code = nrf_ble_scan_filter_set(&m_scan, SCAN_NAME_FILTER, m_names[i]);
+        HOST_TEST_ASSERT(err_code == NRF_SUCCESS);
+    }
+    for (uint32_t i = 0; i < p_set->short_name_cnt; i++)
+    {
+        err_code = nrf_ble_scan_filter_set(&m_scan, SCAN_SHORT_NAME_FILTER, &m_short_names[i]);
+        HOST_TEST_ASSERT(err_code == NRF_SUCCESS);
+    }
+    for (uint32_t i = 0; i < p_set->uuid_cnt; i++)
+    {
+        err_code = nrf_ble_scan_filter_set(&m_scan, SCAN_UUID_FILTER, &m_uuids[i]);
+        HOST_TEST_ASSERT(err_code == NRF_SUCCESS);
+    }
+    for (uint32_t i = 0; i < p_set->addr_cnt; i++)
+    {
+        err_code = nrf_ble_scan_filter_set(&m_scan, SCAN_ADDR_FILTER, m_addrs[i]);
+        HOST_TEST_ASSERT(err_code == NRF_SUCCESS);
+    }
+    for (uint32_t i = 0; i < p_set->appearance_cnt; i++)
+    {
+        err_code = nrf_ble_scan_filter_set(&m_scan, SCAN_APPEARANCE_FILTER, &m_appearances[i]);
+        HOST_TEST_ASSERT(err_code == NRF_SUCCESS);
+    }
+
+    err_code = nrf_ble_scan_filters_enable(&m_scan, NRF_BLE_SCAN_ALL_FILTER, false);
+    HOST_TEST_ASSERT(err_code == NRF_SUCCESS);
+
+    mp_set = p_set;
+}
+
+
+/**@brief Function for matching a report with the filters one by one.
+ *
+ * @return Match bits in the layout of @ref nrf_ble_scan_filter_match.
+ */
+static nrf_ble_scan_filter_match reference_match(report_t const * p_report)
+{
+    nrf_ble_scan_filter_match match;
+
+    memset(&match, 0, sizeof(match));
+
+    for (uint32_t i = 0; i < mp_set->name_cnt; i++)
+    {
+        if (ble_advdata_name_find(p_report->data, p_report->len, m_names[i]))
+        {
+            match.name_filter_match = true;
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < mp_set->short_name_cnt; i++)
+    {
+        if (ble_advdata_short_name_find(p_report->data, p_report->len,
+                                        m_short_names[i].p_short_name,
+                                        m_short_names[i].short_name_min_len))
+        {
+            match.short_name_filter_match = true;
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < mp_set->uuid_cnt; i++)
+    {
+        if (ble_advdata_uuid_find(p_report->data, p_report->len, &m_uuids[i]))
+        {
+            match.uuid_filter_match = true;
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < mp_set->addr_cnt; i++)
+    {
+        if (memcmp(p_report->addr.addr, m_addrs[i], BLE_GAP_ADDR_LEN) == 0)
+        {
+            match.address_filter_match = true;
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < mp_set->appearance_cnt; i++)
+    {
+        if (ble_advdata_appearance_find(p_report->data, p_report->len, &m_appearances[i]))
+        {
+            match.appearance_filter_match = true;
+            break;
+        }
+    }
+
+    return match;
+}
+
+
+static void report_replay(report_t const * p_report)
+{
+    ble_gap_evt_adv_report_t * p_adv_report = &m_evt.evt.evt.gap_evt.params.adv_report;
+
+    m_evt.evt.header.evt_id  = BLE_GAP_EVT_ADV_REPORT;
+    p_adv_report->peer_addr  = p_report->addr;
+    p_adv_report->data.p_data = (uint8_t *)p_report->data;
+    p_adv_report->data.len    = p_report->len;
+
+    nrf_ble_scan_on_ble_evt(&m_evt.evt, &m_scan);
+}
+
+
+static uint32_t match_bits(nrf_ble_scan_filter_match const * p_match)
+{
+    return (p_match->name_filter_match       << 0) |
+           (p_match->address_filter_match    << 1) |
+           (p_match->uuid_filter_match       << 2) |
+           (p_match->appearance_filter_match << 3) |
+           (p_match->short_name_filter_match << 4);
+}
+
+
+static void filter_set_run(filter_set_t const * p_set)
+{
+    uint32_t matched = 0;
+    uint64_t start;
+    uint64_t module_ns;
+    uint64_t reference_ns;
+    uint32_t sink = 0;
+
+    filters_set(p_set);
+
+    // Every report must give the same result as the reference.
+    for (uint32_t i = 0; i < REPORT_COUNT; i++)
+    {
+        nrf_ble_scan_filter_match expected = reference_match(&m_reports[i]);
+
+        report_replay(&m_reports[i]);
+        HOST_TEST_ASSERT(m_matched == (match_bits(&expected) != 0));
+        HOST_TEST_ASSERT(match_bits(&m_match) == match_bits(&expected));
+        matched += m_matched;
+    }
+
+    start = host_time_ns();
+    for (uint32_t r = 0; r < REPLAY_COUNT; r++)
+    {
+        for (uint32_t i = 0; i < REPORT_COUNT; i++)
+        {
+            report_replay(&m_reports[i]);
+            sink += m_matched;
+        }
+    }
+    module_ns = host_time_ns() - start;
+
+    start = host_time_ns();
+    for (uint32_t r = 0; r < REPLAY_COUNT; r++)
+    {
+        for (uint32_t i = 0; i < REPORT_COUNT; i++)
+        {
+            nrf_ble_scan_filter_match match = reference_match(&m_reports[i]);
+            sink += (match_bits(&match) != 0);
+        }
+    }
+    reference_ns = host_time_ns() - start;
+
+    HOST_TEST_ASSERT(sink == 2 * REPLAY_COUNT * matched);
+
+    printf("%s filters (%u names, %u short names, %u UUIDs, %u addresses, %u appearances): "
+           "%u of %u reports match\n",
+           p_set->p_name, p_set->name_cnt, p_set->short_name_cnt, p_set->uuid_cnt,
+           p_set->addr_cnt, p_set->appearance_cnt, (unsigned)matched, REPORT_COUNT);
+    printf("  nrf_ble_scan %6.1f ns/report, reference %7.1f ns/report\n",
+           (double)module_ns / (REPLAY_COUNT * REPORT_COUNT),
+           (double)reference_ns / (REPLAY_COUNT * REPORT_COUNT));
+}
+
+
+int main(void)
+{
+    nrf_ble_scan_init_t init;
+
+    memset(&init, 0, sizeof(init));
+    HOST_TEST_ASSERT(nrf_ble_scan_init(&m_scan, &init, scan_evt_handler) == NRF_SUCCESS);
+    m_scan.scan_buffer.p_data = m_scan_buffer;
+    m_scan.scan_buffer.len    = sizeof(m_scan_buffer);
+
+    filters_generate();
+    for (uint32_t i = 0; i < REPORT_COUNT; i++)
+    {
+        report_generate(&m_reports[i]);
+    }
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_filter_sets); i++)
+    {
+        filter_set_run(&m_filter_sets[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,494 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test and benchmark of the nrf_block_dev_cache write-back cache.
+ *
+ * The cache is placed in front of a flash model: a block device that passes the requests to
+ * nrf_block_dev_ram and counts the time a QSPI flash without write-back mode would take. Each
+ * write request erases and programs every erase unit it touches, after reading the blocks of
+ * the unit that are not written, as nrf_block_dev_qspi does.
+ *
+ * The random test sends requests of random position and length to the cache and keeps a
+ * shadow copy of the device image. Reads must return the shadow, and after each flush the
+ * image of the RAM device must equal it. The write errors of the flash model are injected to
+ * check that dirty blocks are kept until they are written.
+ *
+ * The benchmark runs the requests of a FAT file system appending to files, with sector writes,
+ * FAT and directory updates and a sync after every few sectors, with and without the cache.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_block_dev_cache.h"
+#include "nrf_block_dev_ram.h"
+#include "host_test.h"
+
+#define BLOCK_SIZE          512     // Block size of the device.
+#define UNIT_BLOCKS         8       // Blocks per erase unit (4 kB).
+#define DEV_BLOCKS          1024    // Number of blocks of the device.
+#define CACHE_LINES         4       // Number of cache lines.
+
+#define READ_SETUP_US       10      // Flash model: time of a read command.
+#define READ_BLOCK_US       32      // Flash model: time to read one block.
+#define ERASE_US            40000   // Flash model: time to erase one unit.
+#define PROGRAM_BLOCK_US    1700    // Flash model: time to program one block.
+
+#define RANDOM_OPS          20000   // Number of requests of the random test.
+#define HOT_UNITS           3       // Erase units that most random requests go to.
+#define HOT_PERCENT         75      // Share of the random requests that go to the hot units.
+#define MAX_REQ_BLOCKS      (2 * UNIT_BLOCKS + 1)   // Longest random request.
+
+#define FAT_START           1       // Workload: first block of the first FAT.
+#define FAT_BLOCKS          4       // Workload: blocks of each FAT.
+#define DIR_BLOCK           9       // Workload: block of the directory entries.
+#define DATA_START          16      // Workload: first data block.
+#define CLUSTER_BLOCKS      4       // Workload: blocks per cluster.
+#define FILE_COUNT          8       // Workload: number of files written.
+#define FILE_BLOCKS         64      // Workload: blocks of each file.
+#define SYNC_BLOCKS         16      // Workload: blocks written between syncs.
+
+/**@brief Counters of the flash model. */
+typedef struct
+{
+    uint64_t time_us;       // Time the flash would have taken.
+    uint32_t reads;         // Read requests.
+    uint32_t writes;        // Write requests.
+    uint32_t erases;        // Erased units.
+    uint32_t fail_writes;   // Number of next write requests to fail.
+} flash_model_t;
+
+static uint32_t m_ram_buffer[DEV_BLOCKS * BLOCK_SIZE / sizeof(uint32_t)];
+static uint8_t  m_shadow[DEV_BLOCKS * BLOCK_SIZE];
+static uint8_t  m_buffer[MAX_REQ_BLOCKS * BLOCK_SIZE];
+
+NRF_BLOCK_DEV_RAM_DEFINE(m_ram,
+                         NRF_BLOCK_DEV_RAM_CONFIG(BLOCK_SIZE, m_ram_buffer, sizeof(m_ram_buffer)),
+                         NFR_BLOCK_DEV_INFO_CONFIG("Nordic", "RAM", "1.00"));
+
+static flash_model_t m_flash_model;
+
+static ret_code_t flash_init(nrf_block_dev_t const * p_blk_dev,
+                             nrf_block_dev_ev_handler ev_handler,
+                             void const * p_context);
+static ret_code_t flash_uninit(nrf_block_dev_t const * p_blk_dev);
+static ret_code_t flash_read_req(nrf_block_dev_t const * p_blk_dev, nrf_block_req_t const * p_blk);
+static ret_code_t flash_write_req(nrf_block_dev_t const * p_blk_dev,
+                                  nrf_block_req_t const * p_blk);
+static ret_code_t flash_ioctl(nrf_block_dev_t const * p_blk_dev,
+                              nrf_block_dev_ioctl_req_t req,
+                              void * p_data);
+static nrf_block_dev_geometry_t const * flash_geometry(nrf_block_dev_t const * p_blk_dev);
+
+static const nrf_block_dev_ops_t m_flash_ops =
+{
+    .init      = flash_init,
+    .uninit    = flash_uninit,
+    .read_req  = flash_read_req,
+    .write_req = flash_write_req,
+    .ioctl     = flash_ioctl,
+    .geometry  = flash_geometry,
+};
+
+static const nrf_block_dev_t m_flash = { .p_ops = &m_flash_ops };
+
+NRF_BLOCK_DEV_CACHE_DEFINE(m_cache, &m_flash, BLOCK_SIZE, UNIT_BLOCKS, CACHE_LINES);
+
+static nrf_block_dev_t const * const m_p_ram   = &m_ram.block_dev;
+static nrf_block_dev_t const * const m_p_cache = &m_cache.block_dev;
+
+static uint32_t                m_rand_state = 0x6A09E667;
+static bool                    m_evt_enabled;   // The cache has an event handler.
+static uint32_t                m_evt_count;
+static nrf_block_req_t const * mp_evt_req;
+
+
+static ret_code_t flash_init(nrf_block_dev_t const * p_blk_dev,
+                             nrf_block_dev_ev_handler ev_handler,
+                             void const * p_context)
+{
+    HOST_TEST_ASSERT(ev_handler == NULL);
+    return nrf_blk_dev_init(m_p_ram, NULL, NULL);
+}
+
+
+static ret_code_t flash_uninit(nrf_block_dev_t const * p_blk_dev)
+{
+    return nrf_blk_dev_uninit(m_p_ram);
+}
+
+
+static ret_code_t flash_read_req(nrf_block_dev_t const * p_blk_dev, nrf_block_req_t const * p_blk)
+{
+    m_flash_model.reads++;
+    m_flash_model.time_us += READ_SETUP_US + p_blk->blk_count * READ_BLOCK_US;
+
+    return nrf_blk_dev_read_req(m_p_ram, p_blk);
+}
+
+
+/**@brief Function for writing blocks to the flash model.
+ *
+ * Each erase unit that the request touches is read where it is not written, erased and
+ * programmed.
+ */
+static ret_code_t flash_write_req(nrf_block_dev_t const * p_blk_dev,
+                                  nrf_block_req_t const * p_blk)
+{
+    if (m_flash_model.fail_writes > 0)
+    {
+        m_flash_model.fail_writes--;
+        return NRF_ERROR_INTERNAL;
+    }
+
+    m_flash_model.writes++;
+
+    uint32_t blk_id    = p_blk->blk_id;
+    uint32_t remaining = p_blk->blk_count;
+
+    while (remaining)
+    {
+        uint32_t count = MIN(remaining, UNIT_BLOCKS - (blk_id % UNIT_BLOCKS));
+
+        if (count < UNIT_BLOCKS)
+        {
+            m_flash_model.time_us += READ_SETUP_US + (UNIT_BLOCKS - count) * READ_BLOCK_US;
+        }
+        m_flash_model.time_us += ERASE_US + UNIT_BLOCKS * PROGRAM_BLOCK_US;
+        m_flash_model.erases++;
+
+        blk_id    += count;
+        remaining -= count;
+    }
+
+    return nrf_blk_dev_write_req(m_p_ram, p_blk);
+}
+
+
+static ret_code_t flash_ioctl(nrf_block_dev_t const * p_blk_dev,
+                              nrf_block_dev_ioctl_req_t req,
+                              void * p_data)
+{
+    return nrf_blk_dev_ioctl(m_p_ram, req, p_data);
+}
+
+
+static nrf_block_dev_geometry_t const * flash_geometry(nrf_block_dev_t const * p_blk_dev)
+{
+    return nrf_blk_dev_geometry(m_p_ram);
+}
+
+
+static void blk_dev_ev_handler(nrf_block_dev_t const * p_blk_dev,
+                               nrf_block_dev_event_t const * p_event)
+{
+    HOST_TEST_ASSERT(p_blk_dev == m_p_cache);
+    HOST_TEST_ASSERT(p_event->result == NRF_BLOCK_DEV_RESULT_SUCCESS);
+
+    m_evt_count++;
+    mp_evt_req = p_event->p_blk_req;
+}
+
+
+static ret_code_t blk_read(nrf_block_dev_t const * p_dev,
+                           uint32_t blk_id,
+                           uint32_t count,
+                           void * p_buff)
+{
+    NRF_BLOCK_DEV_REQUEST(req, blk_id, count, p_buff);
+    uint32_t   evt_count = m_evt_count;
+    ret_code_t ret       = nrf_blk_dev_read_req(p_dev, &req);
+
+    if ((ret == NRF_SUCCESS) && m_evt_enabled)
+    {
+        HOST_TEST_ASSERT((m_evt_count == evt_count + 1) && (mp_evt_req == &req));
+    }
+    return ret;
+}
+
+
+static ret_code_t blk_write(nrf_block_dev_t const * p_dev,
+                        uint32_t blk_id,
+                        uint32_t count,
+                        void const * p_buff)
+{
+    NRF_BLOCK_DEV_REQUEST(req, blk_id, count, (void *)p_buff);
+    uint32_t   evt_count = m_evt_count;
+    ret_code_t ret       = nrf_blk_dev_write_req(p_dev, &req);
+
+    if ((ret == NRF_SUCCESS) && m_evt_enabled)
+    {
+        HOST_TEST_ASSERT((m_evt_count == evt_count + 1) && (mp_evt_req == &req));
+    }
+    return ret;
+}
+
+
+/**@brief Function for flushing a device, repeating the request as disk_ioctl(CTRL_SYNC) does. */
+static ret_code_t flush(nrf_block_dev_t const * p_dev)
+{
+    bool       flushing;
+    ret_code_t ret;
+
+    do
+    {
+        flushing = false;
+        ret = nrf_blk_dev_ioctl(p_dev, NRF_BLOCK_DEV_IOCTL_REQ_CACHE_FLUSH, &flushing);
+    } while ((ret == NRF_ERROR_BUSY) || ((ret == NRF_SUCCESS) && flushing));
+
+    return ret;
+}
+
+
+static void random_fill(uint8_t * p_data, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        p_data[i] = (uint8_t)host_rand(&m_rand_state);
+    }
+}
+
+
+/**@brief Function for writing random data through the cache and to the shadow image. */
+static ret_code_t shadow_write(uint32_t blk_id, uint32_t count)
+{
+    random_fill(m_buffer, count * BLOCK_SIZE);
+
+    ret_code_t ret = blk_write(m_p_cache, blk_id, count, m_buffer);
+    if (ret == NRF_SUCCESS)
+    {
+        memcpy(&m_shadow[blk_id * BLOCK_SIZE], m_buffer, count * BLOCK_SIZE);
+    }
+    return ret;
+}
+
+
+static bool image_matches(void)
+{
+    return memcmp(m_ram_buffer, m_shadow, sizeof(m_shadow)) == 0;
+}
+
+
+/**@brief Test of random requests against the shadow image. */
+static void random_test(void)
+{
+    nrf_block_dev_cache_stats_t const * p_stats = nrf_block_dev_cache_stats_get(&m_cache);
+    uint32_t                            read_blocks  = 0;
+    uint32_t                            write_blocks = 0;
+    uint32_t                            flushes      = 0;
+
+    random_fill((uint8_t *)m_ram_buffer, sizeof(m_ram_buffer));
+    memcpy(m_shadow, m_ram_buffer, sizeof(m_shadow));
+
+    m_evt_count   = 0;
+    m_evt_enabled = true;
+    HOST_TEST_ASSERT(nrf_blk_dev_init(m_p_cache, blk_dev_ev_handler, NULL) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(m_evt_count == 1);
+    HOST_TEST_ASSERT(nrf_blk_dev_geometry(m_p_cache)->blk_count == DEV_BLOCKS);
+    HOST_TEST_ASSERT(nrf_blk_dev_geometry(m_p_cache)->blk_size == BLOCK_SIZE);
+
+    HOST_TEST_ASSERT(blk_read(m_p_cache, DEV_BLOCKS - 1, 2, m_buffer) == NRF_ERROR_INVALID_ADDR);
+    HOST_TEST_ASSERT(blk_write(m_p_cache, DEV_BLOCKS, 1, m_buffer) == NRF_ERROR_INVALID_PARAM);
+
+    for (uint32_t i = 0; i < RANDOM_OPS; i++)
+    {
+        uint32_t op     = host_rand(&m_rand_state) % 100;
+        bool     hot    = (host_rand(&m_rand_state) % 100) < HOT_PERCENT;
+        uint32_t blk_id = host_rand(&m_rand_state) % (hot ? (HOT_UNITS * UNIT_BLOCKS) : DEV_BLOCKS);
+        uint32_t count  = 1 + host_rand(&m_rand_state) % MAX_REQ_BLOCKS;
+
+        count = MIN(count, DEV_BLOCKS - blk_id);
+
+        if (op < 50)
+        {
+            HOST_TEST_ASSERT(shadow_write(blk_id, count) == NRF_SUCCESS);
+            write_blocks += count;
+        }
+        else if (op < 97)
+        {
+            HOST_TEST_ASSERT(blk_read(m_p_cache, blk_id, count, m_buffer) == NRF_SUCCESS);
+            HOST_TEST_ASSERT(memcmp(m_buffer, &m_shadow[blk_id * BLOCK_SIZE],
+                                    count * BLOCK_SIZE) == 0);
+            read_blocks += count;
+        }
+        else
+        {
+            HOST_TEST_ASSERT(flush(m_p_cache) == NRF_SUCCESS);
+            HOST_TEST_ASSERT(image_matches());
+            flushes++;
+        }
+    }
+
+    HOST_TEST_ASSERT(p_stats->read_hits + p_stats->read_misses == read_blocks);
+    HOST_TEST_ASSERT(p_stats->write_hits + p_stats->write_misses == write_blocks);
+    HOST_TEST_ASSERT((p_stats->read_hits > 0) && (p_stats->write_hits > 0));
+    HOST_TEST_ASSERT(p_stats->evictions > 0);
+
+    printf("random requests: %u requests, %u flushes, %u evictions, %u of %u blocks read from "
+           "the cache",
+           RANDOM_OPS, (unsigned)flushes, (unsigned)p_stats->evictions,
+           (unsigned)p_stats->read_hits, (unsigned)read_blocks);
+
+    m_evt_count = 0;
+    HOST_TEST_ASSERT(nrf_blk_dev_uninit(m_p_cache) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(m_evt_count == 1);
+    HOST_TEST_ASSERT(image_matches());
+    m_evt_enabled = false;
+    printf(": OK\n");
+}
+
+
+/**@brief Test of write errors of the underlying device during a flush and an eviction. */
+static void write_error_test(void)
+{
+    HOST_TEST_ASSERT(nrf_blk_dev_init(m_p_cache, NULL, NULL) == NRF_SUCCESS);
+
+    // A failed flush keeps the blocks dirty, and the next flush writes them.
+    HOST_TEST_ASSERT(shadow_write(3, 2) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(shadow_write(UNIT_BLOCKS + 1, 1) == NRF_SUCCESS);
+    m_flash_model.fail_writes = 1;
+    HOST_TEST_ASSERT(flush(m_p_cache) == NRF_ERROR_INTERNAL);
+    HOST_TEST_ASSERT(!image_matches());
+    HOST_TEST_ASSERT(flush(m_p_cache) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(image_matches());
+
+    // A failed eviction fails the request, which leaves the cache and the device unchanged.
+    for (uint32_t i = 0; i < CACHE_LINES; i++)
+    {
+        HOST_TEST_ASSERT(shadow_write(i * UNIT_BLOCKS, 1) == NRF_SUCCESS);
+    }
+    m_flash_model.fail_writes = 1;
+    HOST_TEST_ASSERT(shadow_write(CACHE_LINES * UNIT_BLOCKS, 1) == NRF_ERROR_INTERNAL);
+    HOST_TEST_ASSERT(blk_read(m_p_cache, 0, 1, m_buffer) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(memcmp(m_buffer, m_shadow, BLOCK_SIZE) == 0);
+    HOST_TEST_ASSERT(shadow_write(CACHE_LINES * UNIT_BLOCKS, 1) == NRF_SUCCESS);
+
+    HOST_TEST_ASSERT(nrf_blk_dev_uninit(m_p_cache) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(image_matches());
+    printf("write errors: OK\n");
+}
+
+
+/**@brief Function for running the requests of a FAT file system that appends to files.
+ *
+ * Each file is written block by block. A new cluster updates the FAT and its copy, and a sync
+ * writes the directory entry and flushes the device.
+ */
+static void fs_workload(nrf_block_dev_t const * p_dev)
+{
+    uint8_t  fat[BLOCK_SIZE];
+    uint8_t  data[BLOCK_SIZE];
+    uint32_t blk_id = DATA_START;
+
+    HOST_TEST_ASSERT(nrf_blk_dev_init(p_dev, NULL, NULL) == NRF_SUCCESS);
+
+    for (uint32_t file = 0; file < FILE_COUNT; file++)
+    {
+        for (uint32_t i = 0; i < FILE_BLOCKS; i++, blk_id++)
+        {
+            uint32_t cluster = (blk_id - DATA_START) / CLUSTER_BLOCKS;
+
+            if ((blk_id - DATA_START) % CLUSTER_BLOCKS == 0)
+            {
+                uint32_t fat_blk = FAT_START + (cluster * sizeof(uint32_t) / BLOCK_SIZE);
+                uint32_t offset  = (cluster * sizeof(uint32_t)) % BLOCK_SIZE;
+
+                HOST_TEST_ASSERT(blk_read(p_dev, fat_blk, 1, fat) == NRF_SUCCESS);
+                uint32_encode(cluster + 1, &fat[offset]);
+                HOST_TEST_ASSERT(blk_write(p_dev, fat_blk, 1, fat) == NRF_SUCCESS);
+                HOST_TEST_ASSERT(blk_write(p_dev, fat_blk + FAT_BLOCKS, 1, fat) == NRF_SUCCESS);
+            }
+
+            memset(data, (int)(file * FILE_BLOCKS + i), sizeof(data));
+            HOST_TEST_ASSERT(blk_write(p_dev, blk_id, 1, data) == NRF_SUCCESS);
+
+            if ((i + 1) % SYNC_BLOCKS == 0)
+            {
+                HOST_TEST_ASSERT(blk_read(p_dev, DIR_BLOCK, 1, data) == NRF_SUCCESS);
+                uint32_encode((i + 1) * BLOCK_SIZE, &data[file * 32 + 28]);
+                HOST_TEST_ASSERT(blk_write(p_dev, DIR_BLOCK, 1, data) == NRF_SUCCESS);
+                HOST_TEST_ASSERT(flush(p_dev) == NRF_SUCCESS);
+            }
+        }
+    }
+
+    HOST_TEST_ASSERT(nrf_blk_dev_uninit(p_dev) == NRF_SUCCESS);
+}
+
+
+/**@brief Benchmark of the file system workload on the flash model with and without the cache. */
+static void bench(void)
+{
+    flash_model_t direct;
+    flash_model_t cached;
+
+    memset(m_ram_buffer, 0, sizeof(m_ram_buffer));
+    memset(&m_flash_model, 0, sizeof(m_flash_model));
+    fs_workload(&m_flash);
+    direct = m_flash_model;
+    memcpy(m_shadow, m_ram_buffer, sizeof(m_shadow));
+
+    memset(m_ram_buffer, 0, sizeof(m_ram_buffer));
+    memset(&m_flash_model, 0, sizeof(m_flash_model));
+    fs_workload(m_p_cache);
+    cached = m_flash_model;
+
+    // Both runs leave the same image.
+    HOST_TEST_ASSERT(image_matches());
+
+    printf("file system workload: direct %u reads, %u writes, %u erases, %.1f ms\n",
+           (unsigned)direct.reads, (unsigned)direct.writes, (unsigned)direct.erases,
+           direct.time_us / 1e3);
+    printf("                      cached %u reads, %u writes, %u erases, %.1f ms (%u lines of "
+           "%u blocks)\n",
+           (unsigned)cached.reads, (unsigned)cached.writes, (unsigned)cached.erases,
+           cached.time_us / 1e3, CACHE_LINES, UNIT_BLOCKS);
+
+    HOST_TEST_ASSERT(cached.erases < direct.erases);
+    HOST_TEST_ASSERT(cached.time_us < direct.time_us);
+}
+
+
+int main(void)
+{
+    random_test();
+    write_error_test();
+    bench();
+
+    return 0;
+}
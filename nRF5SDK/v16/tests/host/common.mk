@@ -0,0 +1,107 @@
+# Common part of the host test makefiles.
+#
+# Each test directory sets TARGETS and, for every target, <target>_SRC_FILES and optionally
+# <target>_CFLAGS, adds its INC_FOLDERS and CFLAGS, and then includes this file. The targets are
+# built with the host compiler into $(OUTPUT_DIRECTORY).
+#
+# Static libraries are listed in LIBRARIES, with <library>_SRC_FILES and optionally
+# <library>_CFLAGS, and are built into $(OUTPUT_DIRECTORY)/lib<library>.a. A target links the
+# libraries listed in <target>_LIBRARIES.
+
+SDK_ROOT         ?= ../../..
+HOST_ROOT        := $(SDK_ROOT)/tests/host
+OUTPUT_DIRECTORY ?= _build
+
+CC ?= gcc
+AR ?= ar
+
+# Set VERBOSE=1 to print the compiler command lines.
+ifneq ($(VERBOSE),1)
+NO_ECHO := @
+endif
+
+# The host shims come first, so that they take precedence over the target headers.
+INC_FOLDERS := \
+  $(HOST_ROOT)/common \
+  $(HOST_ROOT)/config \
+  $(SDK_ROOT)/components \
+  $(SDK_ROOT)/components/libraries/util \
+  $(SDK_ROOT)/components/libraries/atomic \
+  $(SDK_ROOT)/components/libraries/balloc \
+  $(SDK_ROOT)/components/libraries/memobj \
+  $(SDK_ROOT)/components/libraries/log \
+  $(SDK_ROOT)/components/libraries/log/src \
+  $(SDK_ROOT)/components/libraries/strerror \
+  $(SDK_ROOT)/external/fprintf \
+  $(SDK_ROOT)/components/libraries/experimental_section_vars \
+  $(SDK_ROOT)/components/toolchain/cmsis/include \
+  $(SDK_ROOT)/modules/nrfx \
+  $(SDK_ROOT)/modules/nrfx/mdk \
+  $(SDK_ROOT)/integration/nrfx \
+  $(SDK_ROOT)/components/softdevice/common \
+  $(SDK_ROOT)/components/softdevice/s132/headers \
+  $(SDK_ROOT)/components/softdevice/s132/headers/nrf52 \
+  $(INC_FOLDERS)
+
+OPT ?= -O2 -g
+
+CFLAGS += $(OPT)
+CFLAGS += -std=gnu99 -Wall -Wno-unused-function -Wno-array-bounds
+CFLAGS += -Wno-pointer-to-int-cast -Wno-int-to-pointer-cast
+CFLAGS += -U__unix -U__unix__ -Uunix
+CFLAGS += -D__GNUC_VERSION_OK
+CFLAGS += -DNRF52 -DNRF52832_XXAA -DBOARD_PCA10040
+CFLAGS += -DS132 -DSOFTDEVICE_PRESENT -DNRF_SD_BLE_API_VERSION=7
+CFLAGS += -DNRF_ATOMIC_USE_BUILD_IN=1
+CFLAGS += -pthread
+# The registration sections are indexed as arrays, so their items must not be over-aligned.
+CFLAGS += -malign-data=abi
+
+LDFLAGS += -pthread -Wl,-T,$(HOST_ROOT)/common/host_sections.ld
+LIB_FILES += -lm
+
+COMMON_SRC_FILES := \
+  $(HOST_ROOT)/common/app_util_platform_host.c \
+  $(SDK_ROOT)/components/libraries/atomic/nrf_atomic.c \
+
+.PHONY: default all run clean
+
+default: all
+
+all: $(foreach l, $(LIBRARIES), $(OUTPUT_DIRECTORY)/lib$(l).a) \
+     $(addprefix $(OUTPUT_DIRECTORY)/, $(TARGETS))
+
+run: all
+	@set -e; for t in $(TARGETS); do echo "== $$t"; ./$(OUTPUT_DIRECTORY)/$$t $(RUN_ARGS); done
+
+clean:
+	rm -rf $(OUTPUT_DIRECTORY)
+
+define host_target
+$(OUTPUT_DIRECTORY)/$(1): $$($(1)_SRC_FILES) $$(COMMON_SRC_FILES) \
+                          $$(foreach l, $$($(1)_LIBRARIES), $(OUTPUT_DIRECTORY)/lib$$(l).a) \
+                          | $(OUTPUT_DIRECTORY)
+	@echo Building $$@
+	$$(NO_ECHO)$$(CC) $$(CFLAGS) $$($(1)_CFLAGS) $$(addprefix -I, $$(INC_FOLDERS)) \
+	    $$($(1)_SRC_FILES) $$(COMMON_SRC_FILES) \
+	    $$(foreach l, $$($(1)_LIBRARIES), $(OUTPUT_DIRECTORY)/lib$$(l).a) \
+	    $$(LDFLAGS) $$(LIB_FILES) -o $$@
+endef
+
+# Every source file is compiled separately, so the object names must be unique in a library.
+define host_library
+$(OUTPUT_DIRECTORY)/lib$(1).a: $$($(1)_SRC_FILES) | $(OUTPUT_DIRECTORY)
+	@echo Building $$@
+	$$(NO_ECHO)rm -rf $$@ $(OUTPUT_DIRECTORY)/$(1) && mkdir -p $(OUTPUT_DIRECTORY)/$(1)
+	$$(NO_ECHO)for f in $$($(1)_SRC_FILES); do \
+	    $$(CC) $$(CFLAGS) $$($(1)_CFLAGS) $$(addprefix -I, $$(INC_FOLDERS)) \
+	        -c $$$$f -o $(OUTPUT_DIRECTORY)/$(1)/$$$$(basename $$$$f .c).o || exit 1; \
+	done
+	$$(NO_ECHO)$$(AR) rcs $$@ $(OUTPUT_DIRECTORY)/$(1)/*.o
+endef
+
+$(foreach l, $(LIBRARIES), $(eval $(call host_library,$(l))))
+$(foreach t, $(TARGETS), $(eval $(call host_target,$(t))))
+
+$(OUTPUT_DIRECTORY):
+	mkdir -p $@
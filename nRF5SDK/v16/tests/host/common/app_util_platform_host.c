@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host implementation of the platform functions used by the modules under test.
+ *
+ * Interrupts are modeled by threads. A critical region takes one recursive lock, so it excludes
+ * every other thread, like disabling interrupts excludes every other priority on the target.
+ * A thread runs in Thread Mode until it sets its interrupt priority with host_int_priority_set().
+ */
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "app_util_platform.h"
+#include "app_error.h"
+#include "app_error_weak.h"
+#include "nrf_assert.h"
+#include "host_test.h"
+
+static pthread_mutex_t m_critical_region = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static __thread uint8_t m_int_priority   = APP_IRQ_PRIORITY_THREAD;
+
+void app_util_critical_region_enter(uint8_t * p_nested)
+{
+    UNUSED_PARAMETER(p_nested);
+    (void)pthread_mutex_lock(&m_critical_region);
+}
+
+void app_util_critical_region_exit(uint8_t nested)
+{
+    UNUSED_PARAMETER(nested);
+    (void)pthread_mutex_unlock(&m_critical_region);
+}
+
+void app_util_disable_irq(void)
+{
+    app_util_critical_region_enter(NULL);
+}
+
+void app_util_enable_irq(void)
+{
+    app_util_critical_region_exit(0);
+}
+
+uint8_t current_int_priority_get(void)
+{
+    return m_int_priority;
+}
+
+void host_int_priority_set(uint8_t priority)
+{
+    m_int_priority = priority;
+}
+
+uint8_t privilege_level_get(void)
+{
+    return APP_LEVEL_PRIVILEGED;
+}
+
+void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info)
+{
+    fprintf(stderr, "Fatal error: id 0x%08x, pc 0x%08x, info 0x%08x\n",
+            (unsigned)id, (unsigned)pc, (unsigned)info);
+    if (id == NRF_FAULT_ID_SDK_ERROR)
+    {
+        error_info_t const * p_info = (error_info_t const *)(uintptr_t)info;
+        fprintf(stderr, "  error 0x%08x at %s:%u\n", (unsigned)p_info->err_code,
+                (char const *)p_info->p_file_name, (unsigned)p_info->line_num);
+    }
+    abort();
+}
+
+void app_error_handler(uint32_t error_code, uint32_t line_num, const uint8_t * p_file_name)
+{
+    error_info_t error_info = {
+        .line_num    = line_num,
+        .p_file_name = p_file_name,
+        .err_code    = error_code,
+    };
+    app_error_fault_handler(NRF_FAULT_ID_SDK_ERROR, 0, (uint32_t)(uintptr_t)&error_info);
+}
+
+void app_error_handler_bare(ret_code_t error_code)
+{
+    app_error_handler(error_code, 0, (uint8_t const *)"?");
+}
+
+void assert_nrf_callback(uint16_t line_num, const uint8_t * file_name)
+{
+    fprintf(stderr, "Assertion failed at %s:%u\n", (char const *)file_name, line_num);
+    abort();
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host wrapper of the Cortex-M4 core header.
+ *
+ * The SDK headers are used unchanged on the host. Barriers are mapped to compiler fences, the
+ * event and sleep instructions to no-ops, and saturation and bit reversal are done in C, so that the modules under
+ * test can be built with the host compiler. Core register accessors are left as they are and
+ * must not be used by host tests.
+ */
+#ifndef HOST_CORE_CM4_H__
+#define HOST_CORE_CM4_H__
+
+#define __NOP __cmsis_NOP
+#define __WFI __cmsis_WFI
+#define __WFE __cmsis_WFE
+#define __SEV __cmsis_SEV
+#define __ISB __cmsis_ISB
+#define __DSB __cmsis_DSB
+#define __DMB __cmsis_DMB
+#define __RBIT __cmsis_RBIT
+
+#include_next "core_cm4.h"
+
+#undef __NOP
+#undef __WFI
+#undef __WFE
+#undef __SEV
+#undef __ISB
+#undef __DSB
+#undef __DMB
+#undef __RBIT
+#undef __SSAT
+#undef __USAT
+
+#define __NOP() do { } while (0)
+#define __WFI() do { } while (0)
+#define __WFE() do { } while (0)
+#define __SEV() do { } while (0)
+#define __ISB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#define __SSAT(ARG1, ARG2)                                                      \
+    ({                                                                          \
+        int32_t __max = (int32_t)((1UL << ((ARG2) - 1)) - 1);                   \
+        int32_t __val = (int32_t)(ARG1);                                        \
+        (__val > __max) ? __max : ((__val < -__max - 1) ? -__max - 1 : __val);  \
+    })
+
+#define __USAT(ARG1, ARG2)                                                      \
+    ({                                                                          \
+        int32_t __max = (int32_t)((1UL << (ARG2)) - 1);                         \
+        int32_t __val = (int32_t)(ARG1);                                        \
+        (uint32_t)((__val > __max) ? __max : ((__val < 0) ? 0 : __val));        \
+    })
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+    value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+    value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F) | ((value & 0x0F0F0F0F) << 4);
+    return __builtin_bswap32(value);
+}
+
+#endif // HOST_CORE_CM4_H__
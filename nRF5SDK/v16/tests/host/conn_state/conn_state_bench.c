@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test and benchmark of the connection state queries with many links.
+ *
+ * Links are connected through the BLE event handler of the module, alternately in the central
+ * and the peripheral role. The test checks the handle lists and counts against the roles after
+ * connecting, after half of the links disconnect and after one of them reconnects in the other
+ * role. It also checks that flags above @ref BLE_CONN_STATE_MAX_CONNECTIONS never reach a
+ * handle list.
+ *
+ * The benchmark measures the cost of the handle list getters, of the connection counts and of
+ * @ref ble_conn_state_for_each_connected with 1, 8 and 20 links.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "ble_conn_state.h"
+#include "nrf_atflags.h"
+#include "nrf_sdh_ble.h"
+#include "nrf_section.h"
+#include "host_test.h"
+
+#define MAX_LINKS   20          // Number of links in the largest scenario.
+#define BENCH_LOOPS 2000000     // Number of iterations of each benchmark.
+
+STATIC_ASSERT(BLE_CONN_STATE_MAX_CONNECTIONS >= MAX_LINKS);
+
+// Internal functions of the module.
+void                              bcs_internal_state_reset(void);
+ble_conn_state_conn_handle_list_t conn_handle_list_get(nrf_atflags_t flags);
+
+NRF_SECTION_DEF(sdh_ble_observers, nrf_sdh_ble_evt_observer_t);
+
+static volatile uint32_t m_sink;
+
+
+/**@brief Function for passing a GAP event to the BLE observers, as the SoftDevice handler does. */
+static void gap_evt_send(uint16_t evt_id, uint16_t conn_handle, uint8_t role)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                        = evt_id;
+    evt.evt.gap_evt.conn_handle              = conn_handle;
+    evt.evt.gap_evt.params.connected.role    = role;
+
+    for (uint32_t i = 0; i < NRF_SECTION_ITEM_COUNT(sdh_ble_observers, nrf_sdh_ble_evt_observer_t); i++)
+    {
+        nrf_sdh_ble_evt_observer_t * p_observer =
+            NRF_SECTION_ITEM_GET(sdh_ble_observers, nrf_sdh_ble_evt_observer_t, i);
+
+        p_observer->handler(&evt, p_observer->p_context);
+    }
+}
+
+
+/**@brief Function for checking that a handle list holds exactly the handles in a bitmap. */
+static void handle_list_check(ble_conn_state_conn_handle_list_t const * p_list, uint32_t handles)
+{
+    uint32_t seen = 0;
+
+    for (uint32_t i = 0; i < p_list->len; i++)
+    {
+        HOST_TEST_ASSERT(p_list->conn_handles[i] < MAX_LINKS);
+        HOST_TEST_ASSERT((i == 0) || (p_list->conn_handles[i] > p_list->conn_handles[i - 1]));
+        seen |= 1UL << p_list->conn_handles[i];
+    }
+
+    HOST_TEST_ASSERT(seen == handles);
+}
+
+
+/**@brief Function for checking the queries against the links in each role. */
+static void state_check(uint32_t central, uint32_t periph, uint32_t valid)
+{
+    ble_conn_state_conn_handle_list_t list;
+
+    list = ble_conn_state_central_handles();
+    handle_list_check(&list, central);
+    list = ble_conn_state_periph_handles();
+    handle_list_check(&list, periph);
+    list = ble_conn_state_conn_handles();
+    handle_list_check(&list, valid);
+
+    HOST_TEST_ASSERT(ble_conn_state_central_conn_count() == __builtin_popcount(central));
+    HOST_TEST_ASSERT(ble_conn_state_peripheral_conn_count() == __builtin_popcount(periph));
+    HOST_TEST_ASSERT(ble_conn_state_conn_count() == __builtin_popcount(central | periph));
+}
+
+
+static void count_handles(uint16_t conn_handle, void * p_context)
+{
+    *(uint32_t *)p_context += conn_handle;
+}
+
+
+/**@brief Function for connecting links, checking the state and benchmarking the queries. */
+static void scenario_run(uint32_t link_cnt)
+{
+    uint32_t central = 0;
+    uint32_t periph  = 0;
+    uint32_t context = 0;
+    uint64_t start;
+    double   lists_ns;
+    double   counts_ns;
+    double   for_each_ns;
+
+    bcs_internal_state_reset();
+    ble_conn_state_init();
+
+    for (uint16_t conn_handle = 0; conn_handle < link_cnt; conn_handle++)
+    {
+        if (conn_handle & 1)
+        {
+            gap_evt_send(BLE_GAP_EVT_CONNECTED, conn_handle, BLE_GAP_ROLE_PERIPH);
+            periph |= 1UL << conn_handle;
+        }
+        else
+        {
+            gap_evt_send(BLE_GAP_EVT_CONNECTED, conn_handle, BLE_GAP_ROLE_CENTRAL);
+            central |= 1UL << conn_handle;
+        }
+    }
+    state_check(central, periph, central | periph);
+
+    start = host_time_ns();
+    for (uint32_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        m_sink += ble_conn_state_central_handles().len;
+        m_sink += ble_conn_state_periph_handles().len;
+        m_sink += ble_conn_state_conn_handles().len;
+    }
+    lists_ns = (double)(host_time_ns() - start) / BENCH_LOOPS;
+
+    start = host_time_ns();
+    for (uint32_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        m_sink += ble_conn_state_conn_count();
+        m_sink += ble_conn_state_central_conn_count();
+        m_sink += ble_conn_state_peripheral_conn_count();
+    }
+    counts_ns = (double)(host_time_ns() - start) / BENCH_LOOPS;
+
+    start = host_time_ns();
+    for (uint32_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        m_sink += ble_conn_state_for_each_connected(count_handles, &context);
+    }
+    for_each_ns = (double)(host_time_ns() - start) / BENCH_LOOPS;
+
+    printf("%2u links: 3 handle lists %5.1f ns, 3 counts %5.1f ns, for_each_connected %5.1f ns\n",
+           link_cnt, lists_ns, counts_ns, for_each_ns);
+
+    // Disconnected links stay valid until the event handler of the next event invalidates them.
+    for (uint16_t conn_handle = 0; conn_handle < link_cnt; conn_handle += 2)
+    {
+        gap_evt_send(BLE_GAP_EVT_DISCONNECTED, conn_handle, 0);
+        central &= ~(1UL << conn_handle);
+    }
+    gap_evt_send(BLE_GAP_EVT_CONNECTED, 0, BLE_GAP_ROLE_PERIPH);
+    periph |= 1UL;
+    state_check(central, periph, central | periph);
+}
+
+
+int main(void)
+{
+    static uint32_t const link_cnts[] = {1, 8, MAX_LINKS};
+    ble_conn_state_conn_handle_list_t list;
+
+    // Stray flags above the connection indexes must not be written past conn_handles[].
+    list = conn_handle_list_get(UINT32_MAX);
+    HOST_TEST_ASSERT(list.len == BLE_CONN_STATE_MAX_CONNECTIONS);
+    HOST_TEST_ASSERT(list.conn_handles[BLE_CONN_STATE_MAX_CONNECTIONS - 1] ==
+                     BLE_CONN_STATE_MAX_CONNECTIONS - 1);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(link_cnts); i++)
+    {
+        scenario_run(link_cnts[i]);
+    }
+
+    printf("handle lists and counts: OK\n");
+
+    return 0;
+}
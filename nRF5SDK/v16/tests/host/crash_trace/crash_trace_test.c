@@ -0,0 +1,388 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of nrf_crash_trace: recording, commit to flash, read-back and erase.
+ *
+ * Flash is emulated in RAM with NOR semantics: writes can only clear bits and erase sets a page
+ * to 0xFF. nrf_fstorage_nvmc is replaced by a synchronous implementation, as used by the commit
+ * from the fault handler, and the run-time implementation passed to nrf_crash_trace_init
+ * completes operations only when the test processes them, like the SoftDevice implementation.
+ *
+ * The test checks the stored image, in chronological order with and without the ring wrapping,
+ * that an interrupted commit is never reported as a stored trace, that the erase result is
+ * reported with an event only when the erase completes, and that no events are reported from
+ * the commit.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_crash_trace.h"
+#include "nrf_fstorage_nvmc.h"
+#include "host_test.h"
+
+#define PAGE_SIZE       4096    // Size of a flash page.
+#define FLASH_START     (NRF_CRASH_TRACE_FLASH_START_PAGE * PAGE_SIZE)
+#define FLASH_SIZE      (NRF_CRASH_TRACE_FLASH_PAGES * PAGE_SIZE)
+#define EVT_ID_BASE     0x100   // ID of the first recorded event.
+
+static uint8_t       m_flash[FLASH_SIZE];
+static uint32_t      m_write_budget = UINT32_MAX;   // Number of writes before the flash fails.
+static uint32_t      m_last_write_addr;             // Address of the last write.
+static uint32_t      m_erase_pending;               // Pages of the pending run-time erase.
+static uint32_t      m_erase_addr;                  // Address of the pending run-time erase.
+static ret_code_t    m_erase_result;                // Result of the pending run-time erase.
+static uint32_t      m_timestamp;
+static uint32_t      m_evt_count;
+static ret_code_t    m_evt_result;
+static nrf_fstorage_t const * mp_fs;
+
+static nrf_fstorage_info_t m_flash_info =
+{
+    .erase_unit   = PAGE_SIZE,
+    .program_unit = sizeof(uint32_t),
+    .rmap         = true,
+    .wmap         = false,
+};
+
+static ret_code_t flash_init(nrf_fstorage_t * p_fs, void * p_param)
+{
+    p_fs->p_flash_info = &m_flash_info;
+    mp_fs              = p_fs;
+    return NRF_SUCCESS;
+}
+
+static ret_code_t flash_uninit(nrf_fstorage_t * p_fs, void * p_param)
+{
+    return NRF_SUCCESS;
+}
+
+static ret_code_t flash_read(nrf_fstorage_t const * p_fs, uint32_t src, void * p_dest, uint32_t len)
+{
+    memcpy(p_dest, &m_flash[src - FLASH_START], len);
+    return NRF_SUCCESS;
+}
+
+static uint8_t const * flash_rmap(nrf_fstorage_t const * p_fs, uint32_t addr)
+{
+    return &m_flash[addr - FLASH_START];
+}
+
+static uint8_t * flash_wmap(nrf_fstorage_t const * p_fs, uint32_t addr)
+{
+    return NULL;
+}
+
+static bool flash_is_busy(nrf_fstorage_t const * p_fs)
+{
+    return m_erase_pending != 0;
+}
+
+static void flash_evt_send(nrf_fstorage_t const * p_fs,
+                           nrf_fstorage_evt_id_t  id,
+                           ret_code_t             result,
+                           uint32_t               addr,
+                           uint32_t               len)
+{
+    nrf_fstorage_evt_t evt =
+    {
+        .id     = id,
+        .result = result,
+        .addr   = addr,
+        .len    = len,
+    };
+
+    if (p_fs->evt_handler != NULL)
+    {
+        p_fs->evt_handler(&evt);
+    }
+}
+
+/**@brief Synchronous write, as done by the NVMC implementation. */
+static ret_code_t nvmc_write(nrf_fstorage_t const * p_fs,
+                             uint32_t               dest,
+                             void           const * p_src,
+                             uint32_t               len,
+                             void                 * p_param)
+{
+    uint8_t const * p_byte = p_src;
+
+    if (m_write_budget == 0)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+    m_write_budget--;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        m_flash[dest - FLASH_START + i] &= p_byte[i];
+    }
+    m_last_write_addr = dest;
+
+    flash_evt_send(p_fs, NRF_FSTORAGE_EVT_WRITE_RESULT, NRF_SUCCESS, dest, len);
+    return NRF_SUCCESS;
+}
+
+/**@brief Synchronous erase, as done by the NVMC implementation. */
+static ret_code_t nvmc_erase(nrf_fstorage_t const * p_fs,
+                             uint32_t               addr,
+                             uint32_t               len,
+                             void                 * p_param)
+{
+    memset(&m_flash[addr - FLASH_START], 0xFF, len * PAGE_SIZE);
+
+    flash_evt_send(p_fs, NRF_FSTORAGE_EVT_ERASE_RESULT, NRF_SUCCESS, addr, len);
+    return NRF_SUCCESS;
+}
+
+/**@brief Asynchronous erase, completed by @ref async_process. */
+static ret_code_t async_erase(nrf_fstorage_t const * p_fs,
+                              uint32_t               addr,
+                              uint32_t               len,
+                              void                 * p_param)
+{
+    if (m_erase_pending != 0)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    m_erase_addr    = addr;
+    m_erase_pending = len;
+    return NRF_SUCCESS;
+}
+
+static ret_code_t async_write(nrf_fstorage_t const * p_fs,
+                              uint32_t               dest,
+                              void           const * p_src,
+                              uint32_t               len,
+                              void                 * p_param)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+nrf_fstorage_api_t nrf_fstorage_nvmc =
+{
+    .init    = flash_init,
+    .uninit  = flash_uninit,
+    .read    = flash_read,
+    .write   = nvmc_write,
+    .erase   = nvmc_erase,
+    .rmap    = flash_rmap,
+    .wmap    = flash_wmap,
+    .is_busy = flash_is_busy,
+};
+
+static nrf_fstorage_api_t m_async_api =
+{
+    .init    = flash_init,
+    .uninit  = flash_uninit,
+    .read    = flash_read,
+    .write   = async_write,
+    .erase   = async_erase,
+    .rmap    = flash_rmap,
+    .wmap    = flash_wmap,
+    .is_busy = flash_is_busy,
+};
+
+/**@brief Function for completing the pending run-time erase. */
+static void async_process(void)
+{
+    uint32_t pages = m_erase_pending;
+
+    if (pages == 0)
+    {
+        return;
+    }
+
+    m_erase_pending = 0;
+    if (m_erase_result == NRF_SUCCESS)
+    {
+        memset(&m_flash[m_erase_addr - FLASH_START], 0xFF, pages * PAGE_SIZE);
+    }
+    flash_evt_send(mp_fs, NRF_FSTORAGE_EVT_ERASE_RESULT, m_erase_result, m_erase_addr, pages);
+}
+
+static uint32_t timestamp_get(void)
+{
+    return m_timestamp;
+}
+
+static void crash_trace_evt_handler(nrf_crash_trace_evt_t const * p_evt)
+{
+    HOST_TEST_ASSERT(p_evt->type == NRF_CRASH_TRACE_EVT_ERASE_RESULT);
+    m_evt_count++;
+    m_evt_result = p_evt->result;
+}
+
+/**@brief Function for emulating a boot: the module is initialized with the run-time fstorage. */
+static void boot(void)
+{
+    ret_code_t err_code = nrf_crash_trace_init(&m_async_api, timestamp_get,
+                                               crash_trace_evt_handler);
+    HOST_TEST_ASSERT(err_code == NRF_SUCCESS);
+}
+
+/**@brief Function for recording events with consecutive IDs and timestamps. */
+static void events_put(uint32_t first, uint32_t count)
+{
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        m_timestamp = 1000 + i;
+        NRF_CRASH_TRACE(EVT_ID_BASE + i, i, ~i);
+    }
+}
+
+/**@brief Function for checking the stored image.
+ *
+ * @param[in] fault_id Fault ID passed to the commit.
+ * @param[in] total    Number of events recorded since the first boot.
+ * @param[in] count    Expected number of stored records, the newest ones.
+ */
+static void image_check(uint32_t fault_id, uint32_t total, uint32_t count)
+{
+    uint8_t const * p_data;
+    size_t          size;
+
+    HOST_TEST_ASSERT(nrf_crash_trace_stored_get(&p_data, &size) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(p_data == m_flash);
+    HOST_TEST_ASSERT(size == sizeof(nrf_crash_trace_hdr_t) +
+                             count * sizeof(nrf_crash_trace_entry_t));
+
+    nrf_crash_trace_hdr_t const *   p_hdr   = (nrf_crash_trace_hdr_t const *)p_data;
+    nrf_crash_trace_entry_t const * p_entry = (nrf_crash_trace_entry_t const *)(p_hdr + 1);
+
+    HOST_TEST_ASSERT(p_hdr->magic == NRF_CRASH_TRACE_MAGIC);
+    HOST_TEST_ASSERT(p_hdr->fault_id == fault_id);
+    HOST_TEST_ASSERT(p_hdr->pc == 0x1234);
+    HOST_TEST_ASSERT(p_hdr->info == 0x5678);
+    HOST_TEST_ASSERT(p_hdr->count == count);
+    HOST_TEST_ASSERT(p_hdr->total == total);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t seq = total - count + i;
+
+        HOST_TEST_ASSERT(p_entry[i].id == (uint16_t)(EVT_ID_BASE + seq));
+        HOST_TEST_ASSERT(p_entry[i].seq == (uint16_t)seq);
+        HOST_TEST_ASSERT(p_entry[i].timestamp == 1000 + seq);
+        HOST_TEST_ASSERT(p_entry[i].arg0 == seq);
+        HOST_TEST_ASSERT(p_entry[i].arg1 == ~seq);
+    }
+}
+
+static void stored_none_check(void)
+{
+    uint8_t const * p_data;
+    size_t          size;
+
+    HOST_TEST_ASSERT(nrf_crash_trace_stored_get(&p_data, &size) == NRF_ERROR_NOT_FOUND);
+}
+
+int main(void)
+{
+    uint32_t total = 0;
+
+    memset(m_flash, 0xFF, sizeof(m_flash));
+
+    HOST_TEST_ASSERT(nrf_crash_trace_commit(1, 0x1234, 0x5678) == NRF_ERROR_INVALID_STATE);
+
+    boot();
+    stored_none_check();
+
+    // Commit without the ring wrapping. The header is written last and no events are reported.
+    events_put(total, 5);
+    total += 5;
+    HOST_TEST_ASSERT(nrf_crash_trace_commit(1, 0x1234, 0x5678) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(m_last_write_addr == FLASH_START);
+    HOST_TEST_ASSERT(m_evt_count == 0);
+
+    boot();
+    image_check(1, total, 5);
+    printf("crash_trace commit: OK\n");
+
+    // Commit over the stored trace, with the ring wrapped.
+    events_put(total, 2 * NRF_CRASH_TRACE_RAM_ENTRIES + 3);
+    total += 2 * NRF_CRASH_TRACE_RAM_ENTRIES + 3;
+    HOST_TEST_ASSERT(nrf_crash_trace_commit(2, 0x1234, 0x5678) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(m_evt_count == 0);
+
+    boot();
+    image_check(2, total, NRF_CRASH_TRACE_RAM_ENTRIES);
+    printf("crash_trace wrap: OK\n");
+
+    // Interrupted commit: the records are written, the header is not.
+    events_put(total, 7);
+    total += 7;
+    m_write_budget = 2;
+    HOST_TEST_ASSERT(nrf_crash_trace_commit(3, 0x1234, 0x5678) == NRF_ERROR_INTERNAL);
+    m_write_budget = UINT32_MAX;
+
+    boot();
+    stored_none_check();
+    printf("crash_trace interrupted commit: OK\n");
+
+    // Run-time erase is reported when it completes.
+    HOST_TEST_ASSERT(nrf_crash_trace_commit(4, 0x1234, 0x5678) == NRF_SUCCESS);
+    boot();
+    image_check(4, total, NRF_CRASH_TRACE_RAM_ENTRIES);
+
+    HOST_TEST_ASSERT(nrf_crash_trace_stored_erase() == NRF_SUCCESS);
+    HOST_TEST_ASSERT(m_evt_count == 0);
+    image_check(4, total, NRF_CRASH_TRACE_RAM_ENTRIES);
+
+    async_process();
+    HOST_TEST_ASSERT(m_evt_count == 1);
+    HOST_TEST_ASSERT(m_evt_result == NRF_SUCCESS);
+    stored_none_check();
+
+    // Failed erase is reported with its result and leaves the trace in place.
+    events_put(total, 3);
+    total += 3;
+    HOST_TEST_ASSERT(nrf_crash_trace_commit(5, 0x1234, 0x5678) == NRF_SUCCESS);
+    boot();
+
+    m_erase_result = NRF_ERROR_TIMEOUT;
+    HOST_TEST_ASSERT(nrf_crash_trace_stored_erase() == NRF_SUCCESS);
+    async_process();
+    HOST_TEST_ASSERT(m_evt_count == 2);
+    HOST_TEST_ASSERT(m_evt_result == NRF_ERROR_TIMEOUT);
+    image_check(5, total, NRF_CRASH_TRACE_RAM_ENTRIES);
+    printf("crash_trace erase: OK\n");
+
+    return 0;
+}
@@ -0,0 +1,535 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test and benchmark of the nrf_crypto AEAD operations.
+ *
+ * For EAX-128 and EAX-256 (Cifra) and GCM-128 and GCM-192 (mbed TLS), the test encrypts random
+ * messages with random nonces, additional data and MAC sizes:
+ * - nrf_crypto_aead_crypt must match the reference implementation (cf_eax_encrypt and
+ *   mbedtls_gcm_crypt_and_tag), and decryption must give back the message.
+ * - Stream operations in random chunks, also in place, must give the same result. For GCM, the
+ *   chunks are multiples of 16 bytes, as the mode requires.
+ * - Changing one bit of the ciphertext must make decryption fail, in both ways.
+ * Then a batch of records is encrypted and checked against single operations, and decrypted with
+ * one corrupted record, where the batch must stop. Stream calls in the wrong order must fail.
+ * The EAX test vector from the EAX paper is checked too, and CCM must report stream operations
+ * as unavailable.
+ *
+ * The benchmark measures a 20-byte record with a 12-byte nonce and an 8-byte MAC: with
+ * init/crypt/uninit for every record, with crypt on an initialized context and in batches.
+ * For EAX, the reference cf_eax_encrypt is measured too. The stream throughput is measured with
+ * 256-byte chunks.
+ *
+ * Cifra is built with CF_SIDE_CHANNEL_PROTECTION, so each AES table lookup reads the whole table.
+ * EAX is therefore much slower than GCM and is run with fewer messages and records.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_crypto_aead.h"
+#include "nrf_crypto_error.h"
+#include "modes.h"
+#include "mbedtls/gcm.h"
+#include "host_test.h"
+
+#define MSG_COUNT           3000    // Number of random messages tested in GCM modes.
+#define EAX_MSG_COUNT       500     // Number of random messages tested in EAX modes.
+#define MSG_MAX_SIZE        300     // Maximum size of a random message.
+#define ADATA_MAX_SIZE      200     // Maximum size of random additional data.
+#define NONCE_MAX_SIZE      40      // Maximum size of a random EAX nonce.
+#define BATCH_SIZE          8       // Number of records in the tested batch.
+#define RECORD_SIZE         20      // Size of the records in the batch and in the benchmark.
+#define BENCH_COUNT         20000   // Number of records in one measurement.
+#define EAX_BENCH_COUNT     640     // Number of records in one EAX measurement.
+#define BENCH_BATCH_SIZE    64      // Number of records in a batch in the benchmark.
+#define BENCH_REPEAT        7       // Number of measurements, of which the best is kept.
+#define STREAM_SIZE         4096    // Size of the message in the stream benchmark.
+#define STREAM_CHUNK_SIZE   256     // Size of the chunks in the stream benchmark.
+#define STREAM_COUNT        200     // Number of messages in one stream measurement.
+#define EAX_STREAM_COUNT    5       // Number of messages in one EAX stream measurement.
+
+static nrf_crypto_aead_context_t m_context;
+static uint32_t                  m_rand_state = 0x9E3779B9;
+
+static void rand_fill(uint8_t * p_buf, size_t len)
+{
+    while (len-- > 0)
+    {
+        *p_buf++ = (uint8_t)host_rand(&m_rand_state);
+    }
+}
+
+static uint32_t rand_below(uint32_t limit)
+{
+    return host_rand(&m_rand_state) % limit;
+}
+
+/**@brief Function for processing a message with a stream operation, in random chunks.
+ *
+ * @param[in] block_chunks  If true, all the chunks except the last one are multiples of 16 bytes.
+ */
+static ret_code_t stream_crypt(nrf_crypto_operation_t operation,
+                               uint8_t *              p_nonce,
+                               uint8_t                nonce_size,
+                               uint8_t *              p_adata,
+                               size_t                 adata_size,
+                               uint8_t *              p_data_in,
+                               size_t                 data_in_size,
+                               uint8_t *              p_data_out,
+                               uint8_t *              p_mac,
+                               uint8_t                mac_size,
+                               bool                   block_chunks)
+{
+    ret_code_t err_code;
+    size_t     offset;
+
+    err_code = nrf_crypto_aead_stream_start(&m_context, operation, p_nonce, nonce_size);
+    VERIFY_SUCCESS(err_code);
+
+    for (offset = 0; offset < adata_size; )
+    {
+        size_t len = block_chunks ? 16 * (1 + rand_below(3)) : 1 + rand_below(40);
+
+        len      = MIN(len, adata_size - offset);
+        err_code = nrf_crypto_aead_stream_adata_update(&m_context, &p_adata[offset], len);
+        VERIFY_SUCCESS(err_code);
+        offset += len;
+    }
+
+    for (offset = 0; offset < data_in_size; )
+    {
+        size_t len = block_chunks ? 16 * (1 + rand_below(3)) : rand_below(40);
+
+        len      = MIN(len, data_in_size - offset);
+        err_code = nrf_crypto_aead_stream_update(&m_context,
+                                                 &p_data_in[offset],
+                                                 len,
+                                                 &p_data_out[offset]);
+        VERIFY_SUCCESS(err_code);
+        offset += len;
+    }
+
+    return nrf_crypto_aead_stream_finalize(&m_context, p_mac, mac_size);
+}
+
+static void eax_vector_test(void)
+{
+    // Test vector from "The EAX Mode of Operation", Bellare, Rogaway and Wagner: empty message.
+    static uint8_t key[16] =
+    {
+        0x23, 0x39, 0x52, 0xDE, 0xE4, 0xD5, 0xED, 0x5F,
+        0x9B, 0x9C, 0x6D, 0x6F, 0xF8, 0x0F, 0xF4, 0x78
+    };
+    static uint8_t nonce[16] =
+    {
+        0x62, 0xEC, 0x67, 0xF9, 0xC3, 0xA4, 0xA4, 0x07,
+        0xFC, 0xB2, 0xA8, 0xC4, 0x90, 0x31, 0xA8, 0xB3
+    };
+    static uint8_t adata[8] = {0x6B, 0xFB, 0x91, 0x4F, 0xD0, 0x7E, 0xAE, 0x6B};
+    static uint8_t const tag[16] =
+    {
+        0xE0, 0x37, 0x83, 0x0E, 0x83, 0x89, 0xF2, 0x7B,
+        0x02, 0x5A, 0x2D, 0x65, 0x27, 0xE7, 0x9D, 0x01
+    };
+    uint8_t mac[16];
+
+    HOST_TEST_ASSERT(nrf_crypto_aead_init(&m_context, &g_nrf_crypto_aes_eax_128_info, key)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_crypto_aead_crypt(&m_context, NRF_CRYPTO_ENCRYPT,
+                                           nonce, sizeof(nonce), adata, sizeof(adata),
+                                           NULL, 0, NULL, mac, sizeof(mac)) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(memcmp(mac, tag, sizeof(tag)) == 0);
+    HOST_TEST_ASSERT(nrf_crypto_aead_uninit(&m_context) == NRF_SUCCESS);
+
+    printf("EAX paper test vector: OK\n");
+}
+
+/**@brief Function for the batch operations and the stream state errors of an initialized
+ *        context. */
+static void batch_test(bool is_eax)
+{
+    static uint8_t           nonce[BATCH_SIZE][12];
+    static uint8_t           plain[BATCH_SIZE][RECORD_SIZE];
+    static uint8_t           cipher[BATCH_SIZE][RECORD_SIZE];
+    static uint8_t           decrypted[BATCH_SIZE][RECORD_SIZE];
+    static uint8_t           mac[BATCH_SIZE][8];
+    nrf_crypto_aead_record_t records[BATCH_SIZE];
+    uint8_t                  single_cipher[RECORD_SIZE];
+    uint8_t                  single_mac[8];
+    size_t                   processed;
+    uint32_t                 i;
+
+    for (i = 0; i < BATCH_SIZE; i++)
+    {
+        rand_fill(nonce[i], sizeof(nonce[i]));
+        rand_fill(plain[i], sizeof(plain[i]));
+        records[i] = (nrf_crypto_aead_record_t)
+        {
+            .p_nonce      = nonce[i],
+            .nonce_size   = sizeof(nonce[i]),
+            .p_data_in    = plain[i],
+            .data_in_size = RECORD_SIZE,
+            .p_data_out   = cipher[i],
+            .p_mac        = mac[i],
+            .mac_size     = sizeof(mac[i]),
+        };
+    }
+
+    HOST_TEST_ASSERT(nrf_crypto_aead_batch_crypt(&m_context, NRF_CRYPTO_ENCRYPT,
+                                                 records, BATCH_SIZE, &processed) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(processed == BATCH_SIZE);
+
+    for (i = 0; i < BATCH_SIZE; i++)
+    {
+        HOST_TEST_ASSERT(nrf_crypto_aead_crypt(&m_context, NRF_CRYPTO_ENCRYPT,
+                                               nonce[i], sizeof(nonce[i]), NULL, 0,
+                                               plain[i], RECORD_SIZE, single_cipher,
+                                               single_mac, sizeof(single_mac)) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(memcmp(single_cipher, cipher[i], RECORD_SIZE) == 0);
+        HOST_TEST_ASSERT(memcmp(single_mac, mac[i], sizeof(single_mac)) == 0);
+        records[i].p_data_in  = cipher[i];
+        records[i].p_data_out = decrypted[i];
+    }
+
+    // Decryption stops at the corrupted record.
+    cipher[5][3] ^= 1;
+    HOST_TEST_ASSERT(nrf_crypto_aead_batch_crypt(&m_context, NRF_CRYPTO_DECRYPT,
+                                                 records, BATCH_SIZE, &processed)
+                     == NRF_ERROR_CRYPTO_AEAD_INVALID_MAC);
+    HOST_TEST_ASSERT(processed == 5);
+    for (i = 0; i < 5; i++)
+    {
+        HOST_TEST_ASSERT(memcmp(decrypted[i], plain[i], RECORD_SIZE) == 0);
+    }
+
+    // Stream calls without a started operation, and additional data after data.
+    HOST_TEST_ASSERT(nrf_crypto_aead_stream_update(&m_context, plain[0], 16, cipher[0])
+                     == NRF_ERROR_CRYPTO_INVALID_PARAM);
+    HOST_TEST_ASSERT(nrf_crypto_aead_stream_finalize(&m_context, mac[0], 8)
+                     == NRF_ERROR_CRYPTO_INVALID_PARAM);
+    HOST_TEST_ASSERT(nrf_crypto_aead_stream_start(&m_context, NRF_CRYPTO_ENCRYPT, nonce[0], 12)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_crypto_aead_stream_update(&m_context, plain[0], 5, cipher[0])
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_crypto_aead_stream_adata_update(&m_context, plain[1], 5)
+                     == NRF_ERROR_CRYPTO_INVALID_PARAM);
+
+    if (!is_eax)
+    {
+        // Only the last chunk of GCM can be shorter than a block.
+        HOST_TEST_ASSERT(nrf_crypto_aead_stream_start(&m_context, NRF_CRYPTO_ENCRYPT,
+                                                      nonce[0], 12) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(nrf_crypto_aead_stream_adata_update(&m_context, plain[1], 5)
+                         == NRF_SUCCESS);
+        HOST_TEST_ASSERT(nrf_crypto_aead_stream_adata_update(&m_context, plain[1], 5)
+                         == NRF_ERROR_CRYPTO_INPUT_LENGTH);
+        HOST_TEST_ASSERT(nrf_crypto_aead_stream_start(&m_context, NRF_CRYPTO_ENCRYPT,
+                                                      nonce[0], 12) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(nrf_crypto_aead_stream_update(&m_context, plain[0], 5, cipher[0])
+                         == NRF_SUCCESS);
+        HOST_TEST_ASSERT(nrf_crypto_aead_stream_update(&m_context, plain[0], 5, cipher[0])
+                         == NRF_ERROR_CRYPTO_INPUT_LENGTH);
+    }
+}
+
+static void mode_test(char const *                   p_name,
+                      nrf_crypto_aead_info_t const * p_info,
+                      bool                           is_eax,
+                      uint8_t                        key_size)
+{
+    static uint8_t      plain[MSG_MAX_SIZE];
+    static uint8_t      cipher[MSG_MAX_SIZE];
+    static uint8_t      reference[MSG_MAX_SIZE];
+    static uint8_t      decrypted[MSG_MAX_SIZE];
+    static uint8_t      adata[ADATA_MAX_SIZE];
+    uint8_t             key[32];
+    uint8_t             nonce[NONCE_MAX_SIZE];
+    uint8_t             mac[16];
+    uint8_t             reference_mac[16];
+    cf_aes_context      aes_ref;
+    mbedtls_gcm_context gcm_ref;
+    uint32_t            msg_count = is_eax ? EAX_MSG_COUNT : MSG_COUNT;
+    uint32_t            i;
+
+    rand_fill(key, sizeof(key));
+    memset(&m_context, 0, sizeof(m_context));
+    HOST_TEST_ASSERT(nrf_crypto_aead_init(&m_context, p_info, key) == NRF_SUCCESS);
+    cf_aes_init(&aes_ref, key, key_size);
+    mbedtls_gcm_init(&gcm_ref);
+    HOST_TEST_ASSERT(mbedtls_gcm_setkey(&gcm_ref, MBEDTLS_CIPHER_ID_AES, key, key_size * 8) == 0);
+
+    for (i = 0; i < msg_count; i++)
+    {
+        // EAX takes nonces of any size. GCM is tested with 12-byte nonces and other sizes.
+        uint8_t nonce_size = is_eax ? rand_below(NONCE_MAX_SIZE) : 1 + rand_below(20);
+        size_t  adata_size = rand_below(((i % 3) != 0) ? 40 : ADATA_MAX_SIZE);
+        size_t  size       = rand_below(((i % 3) != 0) ? 40 : MSG_MAX_SIZE);
+        uint8_t mac_size   = is_eax ? 1 + rand_below(16) : 4 + rand_below(13);
+
+        if (!is_eax && ((i % 7) == 0))
+        {
+            nonce_size = 12;
+        }
+        rand_fill(nonce, nonce_size);
+        rand_fill(adata, adata_size);
+        rand_fill(plain, size);
+
+        // One-shot operation against the reference.
+        HOST_TEST_ASSERT(nrf_crypto_aead_crypt(&m_context, NRF_CRYPTO_ENCRYPT,
+                                               nonce, nonce_size, adata, adata_size,
+                                               plain, size, cipher, mac, mac_size)
+                         == NRF_SUCCESS);
+        if (is_eax)
+        {
+            cf_eax_encrypt(&cf_aes, &aes_ref, plain, size, adata, adata_size,
+                           nonce, nonce_size, reference, reference_mac, mac_size);
+        }
+        else
+        {
+            HOST_TEST_ASSERT(mbedtls_gcm_crypt_and_tag(&gcm_ref, MBEDTLS_GCM_ENCRYPT, size,
+                                                       nonce, nonce_size, adata, adata_size,
+                                                       plain, reference, mac_size,
+                                                       reference_mac) == 0);
+        }
+        HOST_TEST_ASSERT(memcmp(cipher, reference, size) == 0);
+        HOST_TEST_ASSERT(memcmp(mac, reference_mac, mac_size) == 0);
+        HOST_TEST_ASSERT(nrf_crypto_aead_crypt(&m_context, NRF_CRYPTO_DECRYPT,
+                                               nonce, nonce_size, adata, adata_size,
+                                               cipher, size, decrypted, mac, mac_size)
+                         == NRF_SUCCESS);
+        HOST_TEST_ASSERT(memcmp(decrypted, plain, size) == 0);
+
+        // Stream operation, and stream encryption in place.
+        memset(reference, 0, sizeof(reference));
+        HOST_TEST_ASSERT(stream_crypt(NRF_CRYPTO_ENCRYPT, nonce, nonce_size, adata, adata_size,
+                                      plain, size, reference, reference_mac, mac_size, !is_eax)
+                         == NRF_SUCCESS);
+        HOST_TEST_ASSERT(memcmp(cipher, reference, size) == 0);
+        HOST_TEST_ASSERT(memcmp(mac, reference_mac, mac_size) == 0);
+        HOST_TEST_ASSERT(stream_crypt(NRF_CRYPTO_DECRYPT, nonce, nonce_size, adata, adata_size,
+                                      cipher, size, decrypted, mac, mac_size, !is_eax)
+                         == NRF_SUCCESS);
+        HOST_TEST_ASSERT(memcmp(decrypted, plain, size) == 0);
+
+        memcpy(reference, plain, size);
+        HOST_TEST_ASSERT(stream_crypt(NRF_CRYPTO_ENCRYPT, nonce, nonce_size, adata, adata_size,
+                                      reference, size, reference, reference_mac, mac_size,
+                                      !is_eax) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(memcmp(cipher, reference, size) == 0);
+        HOST_TEST_ASSERT(memcmp(mac, reference_mac, mac_size) == 0);
+
+        // A changed bit must be detected, unless the MAC is too short to be reliable.
+        if ((size > 0) && (mac_size >= 4))
+        {
+            cipher[rand_below(size)] ^= (uint8_t)(1 << rand_below(8));
+            HOST_TEST_ASSERT(nrf_crypto_aead_crypt(&m_context, NRF_CRYPTO_DECRYPT,
+                                                   nonce, nonce_size, adata, adata_size,
+                                                   cipher, size, decrypted, mac, mac_size)
+                             == NRF_ERROR_CRYPTO_AEAD_INVALID_MAC);
+            HOST_TEST_ASSERT(stream_crypt(NRF_CRYPTO_DECRYPT, nonce, nonce_size,
+                                          adata, adata_size, cipher, size, decrypted,
+                                          mac, mac_size, !is_eax)
+                             == NRF_ERROR_CRYPTO_AEAD_INVALID_MAC);
+        }
+    }
+
+    batch_test(is_eax);
+
+    mbedtls_gcm_free(&gcm_ref);
+    HOST_TEST_ASSERT(nrf_crypto_aead_uninit(&m_context) == NRF_SUCCESS);
+
+    printf("%s: %u random messages, batch and stream: OK\n", p_name, msg_count);
+}
+
+static void ccm_test(void)
+{
+    uint8_t key[16] = {0};
+    uint8_t nonce[13] = {0};
+
+    HOST_TEST_ASSERT(nrf_crypto_aead_init(&m_context, &g_nrf_crypto_aes_ccm_128_info, key)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_crypto_aead_stream_start(&m_context, NRF_CRYPTO_ENCRYPT,
+                                                  nonce, sizeof(nonce))
+                     == NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE);
+    HOST_TEST_ASSERT(nrf_crypto_aead_uninit(&m_context) == NRF_SUCCESS);
+
+    printf("CCM-128: stream operations unavailable: OK\n");
+}
+
+static void record_bench(char const * p_name, nrf_crypto_aead_info_t const * p_info, bool is_eax)
+{
+    static uint8_t           key[16] = {1};
+    static uint8_t           nonce[12] = {2};
+    static uint8_t           plain[RECORD_SIZE];
+    static uint8_t           cipher[BENCH_BATCH_SIZE][RECORD_SIZE];
+    static uint8_t           mac[8];
+    nrf_crypto_aead_record_t records[BENCH_BATCH_SIZE];
+    cf_aes_context           aes_ref;
+    uint64_t                 best[4] = {UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX};
+    uint32_t                 count = is_eax ? EAX_BENCH_COUNT : BENCH_COUNT;
+    uint64_t                 start;
+    uint32_t                 i;
+    uint32_t                 k;
+
+    for (i = 0; i < BENCH_BATCH_SIZE; i++)
+    {
+        records[i] = (nrf_crypto_aead_record_t)
+        {
+            .p_nonce      = nonce,
+            .nonce_size   = sizeof(nonce),
+            .p_data_in    = plain,
+            .data_in_size = RECORD_SIZE,
+            .p_data_out   = cipher[i],
+            .p_mac        = mac,
+            .mac_size     = sizeof(mac),
+        };
+    }
+    cf_aes_init(&aes_ref, key, sizeof(key));
+
+    for (k = 0; k < BENCH_REPEAT; k++)
+    {
+        // The key schedule is computed for every record.
+        start = host_time_ns();
+        for (i = 0; i < count / 10; i++)
+        {
+            (void)nrf_crypto_aead_init(&m_context, p_info, key);
+            (void)nrf_crypto_aead_crypt(&m_context, NRF_CRYPTO_ENCRYPT, nonce, sizeof(nonce),
+                                        NULL, 0, plain, RECORD_SIZE, cipher[0], mac, sizeof(mac));
+            (void)nrf_crypto_aead_uninit(&m_context);
+        }
+        best[0] = MIN(best[0], (host_time_ns() - start) * 10);
+
+        if (is_eax)
+        {
+            start = host_time_ns();
+            for (i = 0; i < count; i++)
+            {
+                cf_eax_encrypt(&cf_aes, &aes_ref, plain, RECORD_SIZE, NULL, 0,
+                               nonce, sizeof(nonce), cipher[0], mac, sizeof(mac));
+            }
+            best[1] = MIN(best[1], host_time_ns() - start);
+        }
+
+        HOST_TEST_ASSERT(nrf_crypto_aead_init(&m_context, p_info, key) == NRF_SUCCESS);
+        start = host_time_ns();
+        for (i = 0; i < count; i++)
+        {
+            (void)nrf_crypto_aead_crypt(&m_context, NRF_CRYPTO_ENCRYPT, nonce, sizeof(nonce),
+                                        NULL, 0, plain, RECORD_SIZE, cipher[0], mac, sizeof(mac));
+        }
+        best[2] = MIN(best[2], host_time_ns() - start);
+
+        start = host_time_ns();
+        for (i = 0; i < count / BENCH_BATCH_SIZE; i++)
+        {
+            (void)nrf_crypto_aead_batch_crypt(&m_context, NRF_CRYPTO_ENCRYPT,
+                                              records, BENCH_BATCH_SIZE, NULL);
+        }
+        best[3] = MIN(best[3], (host_time_ns() - start) * count /
+                               (count / BENCH_BATCH_SIZE * BENCH_BATCH_SIZE));
+        HOST_TEST_ASSERT(nrf_crypto_aead_uninit(&m_context) == NRF_SUCCESS);
+    }
+
+    printf("%s %u-byte record: init+crypt+uninit %7.0f ns, crypt %7.0f ns, batch %7.0f ns",
+           p_name, RECORD_SIZE,
+           (double)best[0] / count,
+           (double)best[2] / count,
+           (double)best[3] / count);
+    if (is_eax)
+    {
+        printf(", cf_eax_encrypt %7.0f ns", (double)best[1] / count);
+    }
+    printf("\n");
+}
+
+static void stream_bench(char const * p_name, nrf_crypto_aead_info_t const * p_info, bool is_eax)
+{
+    static uint8_t key[16] = {1};
+    static uint8_t nonce[12] = {2};
+    static uint8_t plain[STREAM_SIZE];
+    static uint8_t cipher[STREAM_SIZE];
+    uint8_t        mac[8];
+    uint64_t       best = UINT64_MAX;
+    uint32_t       count = is_eax ? EAX_STREAM_COUNT : STREAM_COUNT;
+    uint32_t       i;
+    uint32_t       k;
+
+    HOST_TEST_ASSERT(nrf_crypto_aead_init(&m_context, p_info, key) == NRF_SUCCESS);
+    for (k = 0; k < BENCH_REPEAT; k++)
+    {
+        uint64_t start = host_time_ns();
+
+        for (i = 0; i < count; i++)
+        {
+            uint32_t offset;
+
+            (void)nrf_crypto_aead_stream_start(&m_context, NRF_CRYPTO_ENCRYPT,
+                                               nonce, sizeof(nonce));
+            for (offset = 0; offset < STREAM_SIZE; offset += STREAM_CHUNK_SIZE)
+            {
+                (void)nrf_crypto_aead_stream_update(&m_context, &plain[offset],
+                                                    STREAM_CHUNK_SIZE, &cipher[offset]);
+            }
+            (void)nrf_crypto_aead_stream_finalize(&m_context, mac, sizeof(mac));
+        }
+        best = MIN(best, host_time_ns() - start);
+    }
+    HOST_TEST_ASSERT(nrf_crypto_aead_uninit(&m_context) == NRF_SUCCESS);
+
+    printf("%s stream of %u bytes in %u-byte chunks: %7.1f MB/s\n",
+           p_name, STREAM_SIZE, STREAM_CHUNK_SIZE,
+           (double)count * STREAM_SIZE * 1e3 / best);
+}
+
+int main(void)
+{
+    eax_vector_test();
+    mode_test("EAX-128", &g_nrf_crypto_aes_eax_128_info, true, 16);
+    mode_test("EAX-256", &g_nrf_crypto_aes_eax_256_info, true, 32);
+    mode_test("GCM-128", &g_nrf_crypto_aes_gcm_128_info, false, 16);
+    mode_test("GCM-192", &g_nrf_crypto_aes_gcm_192_info, false, 24);
+    ccm_test();
+
+    record_bench("EAX-128", &g_nrf_crypto_aes_eax_128_info, true);
+    record_bench("GCM-128", &g_nrf_crypto_aes_gcm_128_info, false);
+    record_bench("CCM-128", &g_nrf_crypto_aes_ccm_128_info, false);
+    stream_bench("EAX-128", &g_nrf_crypto_aes_eax_128_info, true);
+    stream_bench("GCM-128", &g_nrf_crypto_aes_gcm_128_info, false);
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test and benchmark of nrf_crypto SHA-256 hashing with the nrf_sw backend.
+ *
+ * The test hashes messages of random lengths split into random chunks, some of them empty with a
+ * NULL pointer. The digests of nrf_crypto_hash_calculate_vector, of nrf_crypto_hash_calculate and
+ * of an nrf_crypto_hash_update loop over the chunks must all match mbedtls_sha256. The FIPS 180-2
+ * "abc" vector and the NULL chunk errors are checked too.
+ *
+ * The benchmark hashes a 256 KiB flash region in 4 KiB pages, with an update loop and with one
+ * scatter-gather list, and in 61-byte chunks. mbedtls_sha256 over the whole region is measured
+ * for reference.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_crypto_hash.h"
+#include "nrf_crypto_error.h"
+#include "mbedtls/sha256.h"
+#include "host_test.h"
+
+#define MSG_COUNT           2000            // Number of random messages in the test.
+#define MSG_MAX_SIZE        5000            // Maximum size of a random message.
+#define CHUNK_MAX_COUNT     40              // Maximum number of chunks of a random message.
+#define CHUNK_MAX_SIZE      200             // Maximum size of a random chunk.
+#define REGION_SIZE         (256 * 1024)    // Size of the hashed region in the benchmark.
+#define PAGE_SIZE           4096            // Size of a flash page.
+#define PAGE_COUNT          (REGION_SIZE / PAGE_SIZE)
+#define SMALL_CHUNK_SIZE    61              // Size of the small chunks in the benchmark.
+#define SMALL_CHUNK_COUNT   CEIL_DIV(REGION_SIZE, SMALL_CHUNK_SIZE)
+#define BENCH_REPEAT        20              // Number of measurements, of which the best is kept.
+
+static nrf_crypto_hash_context_t m_context;
+static uint8_t                   m_region[REGION_SIZE];
+static uint32_t                  m_rand_state = 0x6A09E667;
+
+/**@brief Function for hashing a list of chunks with an nrf_crypto_hash_update loop.
+ *
+ * Empty chunks are skipped, as nrf_crypto_hash_update does not take a NULL pointer.
+ */
+static void hash_update_loop(nrf_crypto_hash_chunk_t const * p_chunks,
+                             size_t                          chunk_count,
+                             uint8_t                       * p_digest)
+{
+    size_t digest_size = NRF_CRYPTO_HASH_SIZE_SHA256;
+    size_t i;
+
+    HOST_TEST_ASSERT(nrf_crypto_hash_init(&m_context, &g_nrf_crypto_hash_sha256_info)
+                     == NRF_SUCCESS);
+    for (i = 0; i < chunk_count; i++)
+    {
+        if (p_chunks[i].data_size == 0)
+        {
+            continue;
+        }
+        HOST_TEST_ASSERT(nrf_crypto_hash_update(&m_context, p_chunks[i].p_data,
+                                                p_chunks[i].data_size) == NRF_SUCCESS);
+    }
+    HOST_TEST_ASSERT(nrf_crypto_hash_finalize(&m_context, p_digest, &digest_size)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT(digest_size == NRF_CRYPTO_HASH_SIZE_SHA256);
+}
+
+static void hash_vector(nrf_crypto_hash_chunk_t const * p_chunks,
+                        size_t                          chunk_count,
+                        uint8_t                       * p_digest)
+{
+    size_t digest_size = NRF_CRYPTO_HASH_SIZE_SHA256;
+
+    HOST_TEST_ASSERT(nrf_crypto_hash_calculate_vector(&m_context, &g_nrf_crypto_hash_sha256_info,
+                                                      p_chunks, chunk_count,
+                                                      p_digest, &digest_size) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(digest_size == NRF_CRYPTO_HASH_SIZE_SHA256);
+}
+
+static void vector_test(void)
+{
+    static uint8_t const     abc_digest[NRF_CRYPTO_HASH_SIZE_SHA256] =
+    {
+        0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA,
+        0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+        0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C,
+        0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD
+    };
+    nrf_crypto_hash_sha256_digest_t digest;
+    nrf_crypto_hash_chunk_t         chunks[] =
+    {
+        {(uint8_t const *)"a", 1}, {NULL, 0}, {(uint8_t const *)"bc", 2}
+    };
+    nrf_crypto_hash_chunk_t         bad_chunk = {NULL, 5};
+    size_t                          digest_size = sizeof(digest);
+
+    HOST_TEST_ASSERT(nrf_crypto_hash_calculate(&m_context, &g_nrf_crypto_hash_sha256_info,
+                                               (uint8_t const *)"abc", 3,
+                                               digest, &digest_size) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(memcmp(digest, abc_digest, sizeof(digest)) == 0);
+    hash_vector(chunks, ARRAY_SIZE(chunks), digest);
+    HOST_TEST_ASSERT(memcmp(digest, abc_digest, sizeof(digest)) == 0);
+
+    HOST_TEST_ASSERT(nrf_crypto_hash_init(&m_context, &g_nrf_crypto_hash_sha256_info)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_crypto_hash_update_vector(&m_context, NULL, 1)
+                     == NRF_ERROR_CRYPTO_INPUT_NULL);
+    HOST_TEST_ASSERT(nrf_crypto_hash_update_vector(&m_context, &bad_chunk, 1)
+                     == NRF_ERROR_CRYPTO_INPUT_NULL);
+    HOST_TEST_ASSERT(nrf_crypto_hash_update_vector(&m_context, NULL, 0) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_crypto_hash_update_vector(&m_context, &chunks[1], 1) == NRF_SUCCESS);
+
+    printf("FIPS 180-2 \"abc\" vector and NULL chunks: OK\n");
+}
+
+static void random_test(void)
+{
+    nrf_crypto_hash_chunk_t         chunks[CHUNK_MAX_COUNT];
+    nrf_crypto_hash_sha256_digest_t digest;
+    uint8_t                         reference[NRF_CRYPTO_HASH_SIZE_SHA256];
+    uint32_t                        i;
+
+    for (i = 0; i < MSG_COUNT; i++)
+    {
+        size_t size        = host_rand(&m_rand_state) % (MSG_MAX_SIZE + 1);
+        size_t offset      = host_rand(&m_rand_state) % (REGION_SIZE - MSG_MAX_SIZE);
+        size_t chunk_count = 0;
+        size_t pos         = 0;
+        size_t digest_size = sizeof(digest);
+
+        // The last chunk takes what the random chunks left.
+        while (chunk_count < (CHUNK_MAX_COUNT - 1))
+        {
+            uint32_t rand = host_rand(&m_rand_state);
+            size_t   len  = ((rand & 3) == 0) ? 0 : MIN((rand >> 8) % CHUNK_MAX_SIZE, size - pos);
+
+            chunks[chunk_count].p_data    = (len == 0) ? NULL : &m_region[offset + pos];
+            chunks[chunk_count].data_size = len;
+            chunk_count++;
+            pos += len;
+        }
+        chunks[chunk_count].p_data    = &m_region[offset + pos];
+        chunks[chunk_count].data_size = size - pos;
+        chunk_count++;
+
+        mbedtls_sha256(&m_region[offset], size, reference, 0);
+
+        hash_vector(chunks, chunk_count, digest);
+        HOST_TEST_ASSERT(memcmp(digest, reference, sizeof(digest)) == 0);
+        hash_update_loop(chunks, chunk_count, digest);
+        HOST_TEST_ASSERT(memcmp(digest, reference, sizeof(digest)) == 0);
+        HOST_TEST_ASSERT(nrf_crypto_hash_calculate(&m_context, &g_nrf_crypto_hash_sha256_info,
+                                                   &m_region[offset], size,
+                                                   digest, &digest_size) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(memcmp(digest, reference, sizeof(digest)) == 0);
+    }
+
+    printf("%u random messages in random chunks: OK\n", MSG_COUNT);
+}
+
+static void bench(void)
+{
+    static nrf_crypto_hash_chunk_t  pages[PAGE_COUNT];
+    static nrf_crypto_hash_chunk_t  small_chunks[SMALL_CHUNK_COUNT];
+    nrf_crypto_hash_sha256_digest_t digest;
+    uint8_t                         reference[NRF_CRYPTO_HASH_SIZE_SHA256];
+    uint64_t                        best[5] = {UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX,
+                                               UINT64_MAX};
+    uint64_t                        start;
+    uint32_t                        i;
+    uint32_t                        k;
+
+    for (i = 0; i < PAGE_COUNT; i++)
+    {
+        pages[i].p_data    = &m_region[i * PAGE_SIZE];
+        pages[i].data_size = PAGE_SIZE;
+    }
+    for (i = 0; i < SMALL_CHUNK_COUNT; i++)
+    {
+        small_chunks[i].p_data    = &m_region[i * SMALL_CHUNK_SIZE];
+        small_chunks[i].data_size = MIN(SMALL_CHUNK_SIZE, REGION_SIZE - i * SMALL_CHUNK_SIZE);
+    }
+
+    mbedtls_sha256(m_region, REGION_SIZE, reference, 0);
+
+    for (k = 0; k < BENCH_REPEAT; k++)
+    {
+        start = host_time_ns();
+        hash_update_loop(pages, PAGE_COUNT, digest);
+        best[0] = MIN(best[0], host_time_ns() - start);
+        HOST_TEST_ASSERT(memcmp(digest, reference, sizeof(digest)) == 0);
+
+        start = host_time_ns();
+        hash_vector(pages, PAGE_COUNT, digest);
+        best[1] = MIN(best[1], host_time_ns() - start);
+        HOST_TEST_ASSERT(memcmp(digest, reference, sizeof(digest)) == 0);
+
+        start = host_time_ns();
+        hash_update_loop(small_chunks, SMALL_CHUNK_COUNT, digest);
+        best[2] = MIN(best[2], host_time_ns() - start);
+        HOST_TEST_ASSERT(memcmp(digest, reference, sizeof(digest)) == 0);
+
+        start = host_time_ns();
+        hash_vector(small_chunks, SMALL_CHUNK_COUNT, digest);
+        best[3] = MIN(best[3], host_time_ns() - start);
+        HOST_TEST_ASSERT(memcmp(digest, reference, sizeof(digest)) == 0);
+
+        start = host_time_ns();
+        mbedtls_sha256(m_region, REGION_SIZE, digest, 0);
+        best[4] = MIN(best[4], host_time_ns() - start);
+    }
+
+    printf("SHA-256 of %u KiB:\n", REGION_SIZE / 1024);
+    printf("  %4u-byte pages, update loop:   %7.0f us (%6.1f MB/s)\n",
+           PAGE_SIZE, best[0] / 1e3, REGION_SIZE * 1e3 / best[0]);
+    printf("  %4u-byte pages, vector:        %7.0f us (%6.1f MB/s)\n",
+           PAGE_SIZE, best[1] / 1e3, REGION_SIZE * 1e3 / best[1]);
+    printf("  %4u-byte chunks, update loop:  %7.0f us (%6.1f MB/s)\n",
+           SMALL_CHUNK_SIZE, best[2] / 1e3, REGION_SIZE * 1e3 / best[2]);
+    printf("  %4u-byte chunks, vector:       %7.0f us (%6.1f MB/s)\n",
+           SMALL_CHUNK_SIZE, best[3] / 1e3, REGION_SIZE * 1e3 / best[3]);
+    printf("  mbedtls_sha256 (reference):     %7.0f us (%6.1f MB/s)\n",
+           best[4] / 1e3, REGION_SIZE * 1e3 / best[4]);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < REGION_SIZE; i++)
+    {
+        m_region[i] = (uint8_t)host_rand(&m_rand_state);
+    }
+
+    vector_test();
+    random_test();
+    bench();
+    return 0;
+}
@@ -0,0 +1,436 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the discovery cache of ble_db_discovery.
+ *
+ * The GATT queue and the Peer Manager are replaced by stubs. The GATT queue stub records the last
+ * request, the peer answers it from the test. The Peer Manager stub holds one stored database.
+ *
+ * The peer has the GATT Service with the Service Changed characteristic and no Battery Service.
+ * The test checks that a database discovered before bonding is stored once the link is bonded,
+ * that a matching Database Hash replays the stored database without discovery procedures, that
+ * a changed Database Hash leads to a full discovery, and that a Service Changed indication
+ * deletes the stored database.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "ble_db_discovery.h"
+#include "ble_srv_common.h"
+#include "peer_manager.h"
+#include "host_test.h"
+
+#define CONN_HANDLE     1       // Connection handle of the test link.
+#define PEER_ID         3       // Peer ID of the test peer once it is bonded.
+#define STORE_TOKEN     7       // Token of the stores in the Peer Manager stub.
+#define STORE_SIZE      2048    // Size of the database storage in the Peer Manager stub.
+
+#define GATT_SRV_START  10      // GATT Service with Service Changed and its CCCD.
+#define GATT_SRV_END    13
+#define SC_DECL_HANDLE  11
+#define SC_VALUE_HANDLE 12
+#define SC_CCCD_HANDLE  13
+#define DB_HASH_HANDLE  20      // Handle of the Database Hash characteristic value.
+
+/**@brief Events received by the application. */
+typedef struct
+{
+    uint32_t complete_cnt;
+    uint32_t not_found_cnt;
+    uint32_t available_cnt;
+    uint16_t sc_value_handle;   // Service Changed value handle of the reported GATT Service.
+    uint16_t sc_cccd_handle;    // Service Changed CCCD handle of the reported GATT Service.
+} app_evts_t;
+
+static ble_db_discovery_t m_db_disc;
+static nrf_ble_gq_t       m_gatt_queue;
+static nrf_ble_gq_req_t   m_last_req;
+static uint32_t           m_req_cnt;
+static pm_evt_handler_t   m_pm_evt_handler;
+static pm_peer_id_t       m_peer_id = PM_PEER_ID_INVALID;
+static uint8_t            m_store[STORE_SIZE];
+static uint32_t           m_store_len;
+static app_evts_t         m_app_evts;
+static union
+{
+    ble_evt_t evt;
+    uint8_t   buf[256];
+} m_evt;
+
+
+ret_code_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * const p_gatt_queue, uint16_t conn_handle)
+{
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
+                               nrf_ble_gq_req_t   * const p_req,
+                               uint16_t                   conn_handle)
+{
+    HOST_TEST_ASSERT(conn_handle == CONN_HANDLE);
+
+    m_last_req = *p_req;
+    m_req_cnt++;
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t pm_register(pm_evt_handler_t event_handler)
+{
+    m_pm_evt_handler = event_handler;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t pm_peer_id_get(uint16_t conn_handle, pm_peer_id_t * p_peer_id)
+{
+    *p_peer_id = m_peer_id;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t pm_peer_data_load(pm_peer_id_t      peer_id,
+                             pm_peer_data_id_t data_id,
+                             void            * p_data,
+                             uint32_t        * p_len)
+{
+    HOST_TEST_ASSERT((peer_id == PEER_ID) && (data_id == PM_PEER_DATA_ID_GATT_REMOTE));
+
+    if (m_store_len == 0)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+    HOST_TEST_ASSERT(*p_len >= m_store_len);
+
+    memcpy(p_data, m_store, m_store_len);
+    *p_len = m_store_len;
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t pm_peer_data_store(pm_peer_id_t       peer_id,
+                              pm_peer_data_id_t  data_id,
+                              void       const * p_data,
+                              uint32_t           len,
+                              pm_store_token_t * p_token)
+{
+    HOST_TEST_ASSERT((peer_id == PEER_ID) && (data_id == PM_PEER_DATA_ID_GATT_REMOTE));
+    HOST_TEST_ASSERT(len <= STORE_SIZE);
+
+    memcpy(m_store, p_data, len);
+    m_store_len = len;
+    *p_token    = STORE_TOKEN;
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t pm_peer_data_delete(pm_peer_id_t peer_id, pm_peer_data_id_t data_id)
+{
+    HOST_TEST_ASSERT((peer_id == PEER_ID) && (data_id == PM_PEER_DATA_ID_GATT_REMOTE));
+
+    if (m_store_len == 0)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+    m_store_len = 0;
+
+    return NRF_SUCCESS;
+}
+
+
+static void db_disc_handler(ble_db_discovery_evt_t * p_evt)
+{
+    HOST_TEST_ASSERT(p_evt->conn_handle == CONN_HANDLE);
+
+    switch (p_evt->evt_type)
+    {
+        case BLE_DB_DISCOVERY_COMPLETE:
+            HOST_TEST_ASSERT(p_evt->params.discovered_db.srv_uuid.uuid == BLE_UUID_GATT);
+            HOST_TEST_ASSERT(p_evt->params.discovered_db.char_count == 1);
+            m_app_evts.complete_cnt++;
+            m_app_evts.sc_value_handle =
+                p_evt->params.discovered_db.charateristics[0].characteristic.handle_value;
+            m_app_evts.sc_cccd_handle = p_evt->params.discovered_db.charateristics[0].cccd_handle;
+            break;
+
+        case BLE_DB_DISCOVERY_SRV_NOT_FOUND:
+            HOST_TEST_ASSERT(p_evt->params.discovered_db.srv_uuid.uuid == BLE_UUID_BATTERY_SERVICE);
+            m_app_evts.not_found_cnt++;
+            break;
+
+        case BLE_DB_DISCOVERY_AVAILABLE:
+            m_app_evts.available_cnt++;
+            break;
+
+        default:
+            HOST_TEST_ASSERT(false);
+            break;
+    }
+}
+
+
+/**@brief Function for sending a GATT Client event of the test link to the module. */
+static void gattc_evt_send(uint16_t evt_id, uint16_t gatt_status)
+{
+    m_evt.evt.header.evt_id             = evt_id;
+    m_evt.evt.evt.gattc_evt.conn_handle = CONN_HANDLE;
+    m_evt.evt.evt.gattc_evt.gatt_status = gatt_status;
+
+    ble_db_discovery_on_ble_evt(&m_evt.evt, &m_db_disc);
+}
+
+
+/**@brief Function for sending a Peer Manager event of the test link to the module. */
+static void pm_evt_send(pm_evt_id_t evt_id)
+{
+    pm_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.evt_id      = evt_id;
+    evt.conn_handle = CONN_HANDLE;
+    evt.peer_id     = m_peer_id;
+    evt.params.peer_data_update_succeeded.token = STORE_TOKEN;
+
+    m_pm_evt_handler(&evt);
+}
+
+
+/**@brief Function for connecting to the peer and answering the Database Hash read.
+ *
+ * @param[in] db_hash Value of every byte of the Database Hash.
+ */
+static void connect(uint8_t db_hash)
+{
+    ble_gattc_evt_char_val_by_uuid_read_rsp_t * p_rsp =
+        &m_evt.evt.evt.gattc_evt.params.char_val_by_uuid_read_rsp;
+
+    memset(&m_app_evts, 0, sizeof(m_app_evts));
+    m_req_cnt = 0;
+
+    HOST_TEST_ASSERT(ble_db_discovery_start(&m_db_disc, CONN_HANDLE) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(m_last_req.type == NRF_BLE_GQ_REQ_CHAR_VAL_BY_UUID_READ);
+
+    p_rsp->count           = 1;
+    p_rsp->value_len       = BLE_DB_DISCOVERY_DB_HASH_LEN;
+    p_rsp->handle_value[0] = LSB_16(DB_HASH_HANDLE);
+    p_rsp->handle_value[1] = MSB_16(DB_HASH_HANDLE);
+    memset(&p_rsp->handle_value[sizeof(uint16_t)], db_hash, BLE_DB_DISCOVERY_DB_HASH_LEN);
+    gattc_evt_send(BLE_GATTC_EVT_CHAR_VAL_BY_UUID_READ_RSP, BLE_GATT_STATUS_SUCCESS);
+}
+
+
+static void disconnect(void)
+{
+    m_evt.evt.header.evt_id           = BLE_GAP_EVT_DISCONNECTED;
+    m_evt.evt.evt.gap_evt.conn_handle = CONN_HANDLE;
+
+    ble_db_discovery_on_ble_evt(&m_evt.evt, &m_db_disc);
+}
+
+
+/**@brief Function for answering the procedures of a full discovery of the peer database. */
+static void full_discovery_answer(void)
+{
+    ble_gattc_evt_t                    * p_gattc_evt = &m_evt.evt.evt.gattc_evt;
+    ble_gattc_evt_prim_srvc_disc_rsp_t * p_srv_rsp   = &p_gattc_evt->params.prim_srvc_disc_rsp;
+    ble_gattc_evt_char_disc_rsp_t      * p_char_rsp  = &p_gattc_evt->params.char_disc_rsp;
+    ble_gattc_evt_desc_disc_rsp_t      * p_desc_rsp  = &p_gattc_evt->params.desc_disc_rsp;
+
+    // GATT Service.
+    HOST_TEST_ASSERT(m_last_req.type == NRF_BLE_GQ_REQ_SRV_DISCOVERY);
+    memset(p_srv_rsp, 0, sizeof(*p_srv_rsp));
+    p_srv_rsp->count                                 = 1;
+    p_srv_rsp->services[0].uuid.type                 = BLE_UUID_TYPE_BLE;
+    p_srv_rsp->services[0].uuid.uuid                 = BLE_UUID_GATT;
+    p_srv_rsp->services[0].handle_range.start_handle = GATT_SRV_START;
+    p_srv_rsp->services[0].handle_range.end_handle   = GATT_SRV_END;
+    gattc_evt_send(BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP, BLE_GATT_STATUS_SUCCESS);
+
+    HOST_TEST_ASSERT(m_last_req.type == NRF_BLE_GQ_REQ_CHAR_DISCOVERY);
+    memset(p_char_rsp, 0, sizeof(*p_char_rsp));
+    p_char_rsp->count                 = 1;
+    p_char_rsp->chars[0].uuid.type    = BLE_UUID_TYPE_BLE;
+    p_char_rsp->chars[0].uuid.uuid    = BLE_UUID_GATT_CHARACTERISTIC_SERVICE_CHANGED;
+    p_char_rsp->chars[0].handle_decl  = SC_DECL_HANDLE;
+    p_char_rsp->chars[0].handle_value = SC_VALUE_HANDLE;
+    gattc_evt_send(BLE_GATTC_EVT_CHAR_DISC_RSP, BLE_GATT_STATUS_SUCCESS);
+
+    HOST_TEST_ASSERT(m_last_req.type == NRF_BLE_GQ_REQ_CHAR_DISCOVERY);
+    gattc_evt_send(BLE_GATTC_EVT_CHAR_DISC_RSP, BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND);
+
+    HOST_TEST_ASSERT(m_last_req.type == NRF_BLE_GQ_REQ_DESC_DISCOVERY);
+    memset(p_desc_rsp, 0, sizeof(*p_desc_rsp));
+    p_desc_rsp->count              = 1;
+    p_desc_rsp->descs[0].handle    = SC_CCCD_HANDLE;
+    p_desc_rsp->descs[0].uuid.type = BLE_UUID_TYPE_BLE;
+    p_desc_rsp->descs[0].uuid.uuid = BLE_UUID_DESCRIPTOR_CLIENT_CHAR_CONFIG;
+    gattc_evt_send(BLE_GATTC_EVT_DESC_DISC_RSP, BLE_GATT_STATUS_SUCCESS);
+
+    // Battery Service.
+    HOST_TEST_ASSERT(m_last_req.type == NRF_BLE_GQ_REQ_SRV_DISCOVERY);
+    gattc_evt_send(BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP, BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND);
+}
+
+
+/**@brief Function for checking the events of a discovery of the peer database. */
+static void app_evts_check(void)
+{
+    HOST_TEST_ASSERT(m_app_evts.complete_cnt == 1);
+    HOST_TEST_ASSERT(m_app_evts.not_found_cnt == 1);
+    HOST_TEST_ASSERT(m_app_evts.available_cnt == 1);
+    HOST_TEST_ASSERT(m_app_evts.sc_value_handle == SC_VALUE_HANDLE);
+    HOST_TEST_ASSERT(m_app_evts.sc_cccd_handle == SC_CCCD_HANDLE);
+    HOST_TEST_ASSERT(!m_db_disc.discovery_in_progress);
+}
+
+
+/**@brief Test of the store of a database discovered before bonding. */
+static void store_on_bonding_test(void)
+{
+    connect(0xAA);
+    full_discovery_answer();
+    app_evts_check();
+    HOST_TEST_ASSERT(m_db_disc.cache_store_pending && (m_store_len == 0));
+
+    m_peer_id = PEER_ID;
+    pm_evt_send(PM_EVT_CONN_SEC_SUCCEEDED);
+    HOST_TEST_ASSERT(!m_db_disc.cache_store_pending && (m_store_len > 0));
+    pm_evt_send(PM_EVT_PEER_DATA_UPDATE_SUCCEEDED);
+    disconnect();
+
+    printf("Store on bonding: OK\n");
+}
+
+
+/**@brief Test of the replay of the stored database when the Database Hash matches. */
+static void hash_match_test(void)
+{
+    connect(0xAA);
+
+    // Only the Database Hash was read, the events came from the stored database.
+    HOST_TEST_ASSERT(m_req_cnt == 1);
+    app_evts_check();
+    disconnect();
+
+    printf("Database Hash match: OK\n");
+}
+
+
+/**@brief Test of the full discovery when the Database Hash has changed. */
+static void hash_mismatch_test(void)
+{
+    connect(0xBB);
+    full_discovery_answer();
+    app_evts_check();
+    HOST_TEST_ASSERT(m_req_cnt == 6);
+    pm_evt_send(PM_EVT_PEER_DATA_UPDATE_SUCCEEDED);
+    disconnect();
+
+    // The database was stored with the new Database Hash.
+    connect(0xBB);
+    HOST_TEST_ASSERT(m_req_cnt == 1);
+    app_evts_check();
+    disconnect();
+
+    printf("Database Hash mismatch: OK\n");
+}
+
+
+/**@brief Test of the deletion of the stored database on a Service Changed indication. */
+static void service_changed_test(void)
+{
+    ble_gattc_evt_hvx_t * p_hvx = &m_evt.evt.evt.gattc_evt.params.hvx;
+
+    connect(0xBB);
+    HOST_TEST_ASSERT(m_req_cnt == 1);
+
+    // Notifications and indications of other characteristics are ignored.
+    p_hvx->type   = BLE_GATT_HVX_NOTIFICATION;
+    p_hvx->handle = SC_VALUE_HANDLE;
+    gattc_evt_send(BLE_GATTC_EVT_HVX, BLE_GATT_STATUS_SUCCESS);
+    p_hvx->type   = BLE_GATT_HVX_INDICATION;
+    p_hvx->handle = SC_DECL_HANDLE;
+    gattc_evt_send(BLE_GATTC_EVT_HVX, BLE_GATT_STATUS_SUCCESS);
+    HOST_TEST_ASSERT(m_store_len > 0);
+
+    p_hvx->handle = SC_VALUE_HANDLE;
+    gattc_evt_send(BLE_GATTC_EVT_HVX, BLE_GATT_STATUS_SUCCESS);
+    HOST_TEST_ASSERT(m_store_len == 0);
+    disconnect();
+
+    // The Database Hash is the same, but the peer is discovered again.
+    connect(0xBB);
+    full_discovery_answer();
+    app_evts_check();
+    pm_evt_send(PM_EVT_PEER_DATA_UPDATE_SUCCEEDED);
+    HOST_TEST_ASSERT(m_store_len > 0);
+    disconnect();
+
+    HOST_TEST_ASSERT(ble_db_discovery_cache_invalidate(PEER_ID) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(ble_db_discovery_cache_invalidate(PEER_ID) == NRF_SUCCESS);
+
+    printf("Service Changed: OK\n");
+}
+
+
+int main(void)
+{
+    ble_db_discovery_init_t db_init =
+    {
+        .evt_handler  = db_disc_handler,
+        .p_gatt_queue = &m_gatt_queue,
+    };
+    ble_uuid_t gatt_uuid = {.uuid = BLE_UUID_GATT,            .type = BLE_UUID_TYPE_BLE};
+    ble_uuid_t bas_uuid  = {.uuid = BLE_UUID_BATTERY_SERVICE, .type = BLE_UUID_TYPE_BLE};
+
+    HOST_TEST_ASSERT(ble_db_discovery_init(&db_init) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(ble_db_discovery_evt_register(&gatt_uuid) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(ble_db_discovery_evt_register(&bas_uuid) == NRF_SUCCESS);
+
+    store_on_bonding_test();
+    hash_match_test();
+    hash_mismatch_test();
+    service_changed_test();
+
+    return 0;
+}
@@ -0,0 +1,455 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Simulation of the GATT discovery of many peers at the same time.
+ *
+ * Each simulated link answers one ATT request per connection event, which is the worst case
+ * for discovery. The GATT queue is replaced by a model with one queue per priority lane and one
+ * outstanding request per link. Every peer has the same database of 10 services with two
+ * characteristics each, 4 of the 5 registered services are present.
+ *
+ * The simulation checks that every link reports the registered services with the right handles
+ * and becomes available once. It prints the number of connection events until the first
+ * service is reported and until the discovery is done, and the number of ATT requests, for
+ * 1, 8 and 20 links, with and without application requests queued before the discovery.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "ble_db_discovery.h"
+#include "host_test.h"
+
+#define MAX_LINKS       20      // Maximum number of simulated links.
+#define LANE_SIZE       16      // Number of requests in each lane of the GATT queue model.
+
+#define SRV_COUNT       10      // Number of services of the peer.
+#define SRV_SIZE        7       // Handles of a service: declaration, then 2 x (declaration, value, CCCD).
+#define SRV_START(_i)   (1 + (_i) * SRV_SIZE)
+#define SRV_END(_i)     (SRV_START(_i) + SRV_SIZE - 1)
+#define LAST_HANDLE     SRV_END(SRV_COUNT - 1)
+
+/**@brief GATT queue model of a link. */
+typedef struct
+{
+    nrf_ble_gq_req_t lane[NRF_BLE_GQ_PRIO_NUM][LANE_SIZE];
+    uint32_t         head[NRF_BLE_GQ_PRIO_NUM];
+    uint32_t         tail[NRF_BLE_GQ_PRIO_NUM];
+    bool             busy;
+    nrf_ble_gq_req_t current;
+} link_t;
+
+/**@brief Result of the discovery of a link. */
+typedef struct
+{
+    uint32_t first_srv_event;  // Connection event in which the first service was reported.
+    uint32_t done_event;       // Connection event in which the discovery was done.
+    uint32_t complete_cnt;     // Number of services reported as found.
+    uint32_t not_found_cnt;    // Number of services reported as not found.
+    uint32_t available_cnt;    // Number of BLE_DB_DISCOVERY_AVAILABLE events.
+} link_result_t;
+
+static uint16_t const m_peer_srv_uuids[SRV_COUNT] =
+{
+    0x1800, 0x1801, 0x180A, 0x180F, 0x180D, 0x1816, 0x1819, 0x181C, 0x1826, 0x1814
+};
+
+static uint16_t const m_registered_uuids[] = {0x180D, 0x180F, 0x181C, 0x1816, 0x1810};
+
+static link_t             m_links[MAX_LINKS];
+static link_result_t      m_results[MAX_LINKS];
+static ble_db_discovery_t m_db_disc[MAX_LINKS];
+static nrf_ble_gq_t       m_gatt_queue;
+static uint32_t           m_link_cnt;
+static uint32_t           m_event;
+static uint32_t           m_att_requests;
+static union
+{
+    ble_evt_t evt;
+    uint8_t   buf[512];
+} m_evt;
+
+
+uint32_t app_timer_cnt_get(void)
+{
+    return m_event;
+}
+
+
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from)
+{
+    return ticks_to - ticks_from;
+}
+
+
+/**@brief Function for passing the next queued request of a link to the peer. */
+static void link_kick(uint16_t conn_handle)
+{
+    link_t * p_link = &m_links[conn_handle];
+
+    if (p_link->busy)
+    {
+        return;
+    }
+
+    for (int prio = NRF_BLE_GQ_PRIO_NUM - 1; prio >= 0; prio--)
+    {
+        if (p_link->head[prio] != p_link->tail[prio])
+        {
+            p_link->current = p_link->lane[prio][p_link->head[prio]++ % LANE_SIZE];
+            p_link->busy    = true;
+            return;
+        }
+    }
+}
+
+
+ret_code_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * const p_gatt_queue, uint16_t conn_handle)
+{
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_ble_gq_item_add_prio(nrf_ble_gq_t const * const p_gatt_queue,
+                                    nrf_ble_gq_req_t   * const p_req,
+                                    uint16_t                   conn_handle,
+                                    nrf_ble_gq_prio_t          prio)
+{
+    link_t * p_link = &m_links[conn_handle];
+
+    HOST_TEST_ASSERT(p_link->tail[prio] - p_link->head[prio] < LANE_SIZE);
+    p_link->lane[prio][p_link->tail[prio]++ % LANE_SIZE] = *p_req;
+    link_kick(conn_handle);
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
+                               nrf_ble_gq_req_t   * const p_req,
+                               uint16_t                   conn_handle)
+{
+    return nrf_ble_gq_item_add_prio(p_gatt_queue, p_req, conn_handle, NRF_BLE_GQ_PRIO_NORMAL);
+}
+
+
+/**@brief Function for building the response to a primary service discovery request. */
+static void srv_disc_rsp_build(nrf_ble_gq_gattc_srv_discovery_t const * p_req, ble_gattc_evt_t * p_evt)
+{
+    ble_gattc_evt_prim_srvc_disc_rsp_t * p_rsp = &p_evt->params.prim_srvc_disc_rsp;
+    bool const                           by_uuid = (p_req->srvc_uuid.type != BLE_UUID_TYPE_UNKNOWN);
+
+    m_evt.evt.header.evt_id = BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP;
+
+    for (uint32_t i = 0; (i < SRV_COUNT) && (p_rsp->count < 3); i++)
+    {
+        if ((SRV_START(i) < p_req->start_handle) ||
+            (by_uuid && (p_req->srvc_uuid.uuid != m_peer_srv_uuids[i])))
+        {
+            continue;
+        }
+
+        ble_gattc_service_t * p_srv = &p_rsp->services[p_rsp->count++];
+
+        p_srv->uuid.type                 = BLE_UUID_TYPE_BLE;
+        p_srv->uuid.uuid                 = m_peer_srv_uuids[i];
+        p_srv->handle_range.start_handle = SRV_START(i);
+        p_srv->handle_range.end_handle   = (i == SRV_COUNT - 1) ? 0xFFFF : SRV_END(i);
+
+        if (by_uuid)
+        {
+            // Find By Type Value returns the first match here, the next request finds no more.
+            break;
+        }
+    }
+}
+
+
+/**@brief Function for building the response to a characteristic discovery request. */
+static void char_disc_rsp_build(ble_gattc_handle_range_t const * p_range, ble_gattc_evt_t * p_evt)
+{
+    ble_gattc_evt_char_disc_rsp_t * p_rsp = &p_evt->params.char_disc_rsp;
+
+    m_evt.evt.header.evt_id = BLE_GATTC_EVT_CHAR_DISC_RSP;
+
+    for (uint32_t i = 0; i < SRV_COUNT; i++)
+    {
+        for (uint32_t k = 0; (k < 2) && (p_rsp->count < 3); k++)
+        {
+            uint16_t decl = SRV_START(i) + 1 + 3 * k;
+
+            if ((decl < p_range->start_handle) || (decl > p_range->end_handle))
+            {
+                continue;
+            }
+
+            ble_gattc_char_t * p_char = &p_rsp->chars[p_rsp->count++];
+
+            p_char->handle_decl       = decl;
+            p_char->handle_value      = decl + 1;
+            p_char->uuid.type         = BLE_UUID_TYPE_BLE;
+            p_char->uuid.uuid         = 0x2A00 + k;
+            p_char->char_props.notify = 1;
+        }
+    }
+}
+
+
+/**@brief Function for building the response to a descriptor discovery request. */
+static void desc_disc_rsp_build(ble_gattc_handle_range_t const * p_range, ble_gattc_evt_t * p_evt)
+{
+    ble_gattc_evt_desc_disc_rsp_t * p_rsp = &p_evt->params.desc_disc_rsp;
+
+    m_evt.evt.header.evt_id = BLE_GATTC_EVT_DESC_DISC_RSP;
+
+    for (uint32_t handle = p_range->start_handle;
+         (handle <= p_range->end_handle) && (handle <= LAST_HANDLE) && (p_rsp->count < 5);
+         handle++)
+    {
+        ble_gattc_desc_t * p_desc = &p_rsp->descs[p_rsp->count++];
+        uint32_t const     pos    = (handle - 1) % SRV_SIZE;
+
+        p_desc->handle    = handle;
+        p_desc->uuid.type = BLE_UUID_TYPE_BLE;
+        p_desc->uuid.uuid = ((pos == 3) || (pos == 6)) ? BLE_UUID_DESCRIPTOR_CLIENT_CHAR_CONFIG :
+                                                          BLE_UUID_CHARACTERISTIC;
+    }
+}
+
+
+/**@brief Function for answering the outstanding request of a link. */
+static void link_respond(uint16_t conn_handle)
+{
+    link_t           * p_link = &m_links[conn_handle];
+    nrf_ble_gq_req_t * p_req  = &p_link->current;
+    ble_gattc_evt_t  * p_evt  = &m_evt.evt.evt.gattc_evt;
+
+    memset(&m_evt, 0, sizeof(m_evt));
+    p_evt->conn_handle = conn_handle;
+    m_att_requests++;
+
+    switch (p_req->type)
+    {
+        case NRF_BLE_GQ_REQ_SRV_DISCOVERY:
+            srv_disc_rsp_build(&p_req->params.gattc_srv_disc, p_evt);
+            break;
+
+        case NRF_BLE_GQ_REQ_CHAR_DISCOVERY:
+            char_disc_rsp_build(&p_req->params.gattc_char_disc, p_evt);
+            break;
+
+        case NRF_BLE_GQ_REQ_DESC_DISCOVERY:
+            desc_disc_rsp_build(&p_req->params.gattc_desc_disc, p_evt);
+            break;
+
+        default:
+            // Application write. The response is not used by the discovery.
+            m_evt.evt.header.evt_id = BLE_GATTC_EVT_WRITE_RSP;
+            p_evt->gatt_status      = BLE_GATT_STATUS_SUCCESS;
+            break;
+    }
+
+    if ((m_evt.evt.header.evt_id != BLE_GATTC_EVT_WRITE_RSP) &&
+        (p_evt->params.prim_srvc_disc_rsp.count == 0))
+    {
+        p_evt->gatt_status = BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND;
+    }
+
+    p_link->busy = false;
+
+    for (uint32_t i = 0; i < m_link_cnt; i++)
+    {
+        ble_db_discovery_on_ble_evt(&m_evt.evt, &m_db_disc[i]);
+    }
+
+    link_kick(conn_handle);
+}
+
+
+/**@brief Function for checking a discovered service against the database of the peer. */
+static void discovered_srv_check(ble_gatt_db_srv_t const * p_srv)
+{
+    uint32_t i;
+
+    for (i = 0; (i < SRV_COUNT) && (m_peer_srv_uuids[i] != p_srv->srv_uuid.uuid); i++)
+    {
+    }
+
+    HOST_TEST_ASSERT(i < SRV_COUNT);
+    HOST_TEST_ASSERT(p_srv->handle_range.start_handle == SRV_START(i));
+    HOST_TEST_ASSERT(p_srv->char_count == 2);
+
+    for (uint32_t k = 0; k < 2; k++)
+    {
+        HOST_TEST_ASSERT(p_srv->charateristics[k].characteristic.handle_value == SRV_START(i) + 2 + 3 * k);
+        HOST_TEST_ASSERT(p_srv->charateristics[k].cccd_handle == SRV_START(i) + 3 + 3 * k);
+    }
+}
+
+
+static void db_disc_evt_handler(ble_db_discovery_evt_t * p_evt)
+{
+    link_result_t * p_result = &m_results[p_evt->conn_handle];
+
+    switch (p_evt->evt_type)
+    {
+        case BLE_DB_DISCOVERY_COMPLETE:
+            discovered_srv_check(&p_evt->params.discovered_db);
+            p_result->complete_cnt++;
+            if (p_result->first_srv_event == 0)
+            {
+                p_result->first_srv_event = m_event;
+            }
+            break;
+
+        case BLE_DB_DISCOVERY_SRV_NOT_FOUND:
+            HOST_TEST_ASSERT(p_evt->params.discovered_db.srv_uuid.uuid == 0x1810);
+            p_result->not_found_cnt++;
+            break;
+
+        case BLE_DB_DISCOVERY_AVAILABLE:
+            p_result->done_event = m_event;
+            p_result->available_cnt++;
+            break;
+
+        default:
+            HOST_TEST_ASSERT(false);
+            break;
+    }
+}
+
+
+/**@brief Function for simulating the discovery of a number of links. */
+static void scenario_run(uint32_t link_cnt, uint32_t app_writes)
+{
+    ble_db_discovery_init_t init =
+    {
+        .evt_handler  = db_disc_evt_handler,
+        .p_gatt_queue = &m_gatt_queue,
+    };
+    uint32_t first_sum = 0;
+    uint32_t done_sum  = 0;
+    uint32_t done_max  = 0;
+
+    memset(m_links, 0, sizeof(m_links));
+    memset(m_results, 0, sizeof(m_results));
+    memset(m_db_disc, 0, sizeof(m_db_disc));
+    m_link_cnt     = link_cnt;
+    m_event        = 0;
+    m_att_requests = 0;
+
+    HOST_TEST_ASSERT(ble_db_discovery_init(&init) == NRF_SUCCESS);
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_registered_uuids); i++)
+    {
+        ble_uuid_t uuid = {.uuid = m_registered_uuids[i], .type = BLE_UUID_TYPE_BLE};
+        HOST_TEST_ASSERT(ble_db_discovery_evt_register(&uuid) == NRF_SUCCESS);
+    }
+
+    for (uint16_t conn_handle = 0; conn_handle < link_cnt; conn_handle++)
+    {
+        m_db_disc[conn_handle].conn_handle = BLE_CONN_HANDLE_INVALID;
+
+        for (uint32_t i = 0; i < app_writes; i++)
+        {
+            nrf_ble_gq_req_t req;
+
+            memset(&req, 0, sizeof(req));
+            req.type = NRF_BLE_GQ_REQ_GATTC_WRITE;
+            UNUSED_RETURN_VALUE(nrf_ble_gq_item_add(&m_gatt_queue, &req, conn_handle));
+        }
+
+        HOST_TEST_ASSERT(ble_db_discovery_start(&m_db_disc[conn_handle], conn_handle) == NRF_SUCCESS);
+    }
+
+    // Every connection event, each link with an outstanding request gets its response.
+    for (m_event = 1; m_event < 1000; m_event++)
+    {
+        bool active = false;
+
+        for (uint16_t conn_handle = 0; conn_handle < link_cnt; conn_handle++)
+        {
+            if (m_links[conn_handle].busy)
+            {
+                active = true;
+                link_respond(conn_handle);
+            }
+        }
+
+        if (!active)
+        {
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < link_cnt; i++)
+    {
+        HOST_TEST_ASSERT(m_results[i].complete_cnt == 4);
+        HOST_TEST_ASSERT(m_results[i].not_found_cnt == 1);
+        HOST_TEST_ASSERT(m_results[i].available_cnt == 1);
+        HOST_TEST_ASSERT(!m_db_disc[i].discovery_in_progress);
+#if NRF_MODULE_ENABLED(BLE_DB_DISCOVERY_SCHED)
+        HOST_TEST_ASSERT(m_db_disc[i].duration_ticks == m_results[i].done_event);
+#endif
+
+        first_sum += m_results[i].first_srv_event;
+        done_sum  += m_results[i].done_event;
+        done_max   = MAX(done_max, m_results[i].done_event);
+    }
+
+    printf("%2u links, %u writes queued: first service %4.1f, done %4.1f (max %2u) events, "
+           "%2u ATT requests per link\n",
+           link_cnt, app_writes,
+           (double)first_sum / link_cnt, (double)done_sum / link_cnt, done_max,
+           m_att_requests / link_cnt);
+}
+
+
+int main(void)
+{
+    static uint32_t const link_cnts[] = {1, 8, MAX_LINKS};
+
+    for (uint32_t writes = 0; writes <= 4; writes += 4)
+    {
+        for (uint32_t i = 0; i < ARRAY_SIZE(link_cnts); i++)
+        {
+            scenario_run(link_cnts[i], writes);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,288 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Stress test and benchmark of the log frontend with concurrent producers.
+ *
+ * Producer threads play the role of interrupts of different priorities. Each of them logs
+ * entries with 2, 4 or 6 arguments, which carry the producer ID, a sequence number and check
+ * values. A consumer thread processes the entries and a test backend checks that:
+ * - every entry is intact,
+ * - the entries of each producer arrive in order,
+ * - without overflow, each entry is either received or counted as dropped.
+ *
+ * The benchmark measures the cost of a log call without contention and the throughput with
+ * all producers active. The test is built with NRF_LOG_LOCK_FREE_ENABLED set to 0 and 1.
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include "sdk_common.h"
+#define NRF_LOG_MODULE_NAME log_frontend_test
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_backend_interface.h"
+#include "nrf_log_internal.h"
+#include "host_test.h"
+
+NRF_LOG_MODULE_REGISTER();
+
+#define PRODUCERS          4        // Number of concurrent producers.
+#define ENTRIES            200000   // Entries logged by each producer in the stress test.
+#define BENCH_ENTRIES      1000000  // Entries logged in the benchmark.
+#define SEQ_MASK           0xFFFFFFUL
+#define TAG(_id, _seq)     (((uint32_t)(_id) << 24) | ((_seq) & SEQ_MASK))
+#define CHECK(_tag)        ((uint32_t)((_tag) * 2654435761UL))
+
+static uint32_t volatile m_received[PRODUCERS];
+static uint32_t          m_next_seq[PRODUCERS];
+static uint32_t volatile m_dropped;
+static uint32_t volatile m_out_of_order;
+static uint32_t volatile m_corrupted;
+static bool     volatile m_check_entries;
+static int      volatile m_producers_done;
+
+static void test_backend_put(nrf_log_backend_t const * p_backend, nrf_log_entry_t * p_entry)
+{
+    nrf_log_header_t header;
+    uint32_t         args[6];
+
+    nrf_memobj_get(p_entry);
+    nrf_memobj_read(p_entry, &header, HEADER_SIZE * sizeof(uint32_t), 0);
+    m_dropped += header.dropped;
+
+    if (m_check_entries)
+    {
+        uint32_t nargs = header.base.std.nargs;
+        bool     valid = (header.base.generic.type == HEADER_TYPE_STD) &&
+                         (nargs >= 2) && (nargs <= 6) && ((nargs % 2) == 0);
+        if (valid)
+        {
+            nrf_memobj_read(p_entry, args, nargs * sizeof(uint32_t),
+                            HEADER_SIZE * sizeof(uint32_t));
+            for (uint32_t i = 1; i < nargs; i++)
+            {
+                valid &= (args[i] == CHECK(args[0] + i - 1));
+            }
+        }
+
+        if (!valid)
+        {
+            m_corrupted++;
+        }
+        else
+        {
+            uint32_t id  = args[0] >> 24;
+            uint32_t seq = args[0] & SEQ_MASK;
+            if ((id >= PRODUCERS) || (seq < m_next_seq[id]))
+            {
+                m_out_of_order++;
+            }
+            else
+            {
+                m_next_seq[id] = seq + 1;
+                m_received[id]++;
+            }
+        }
+    }
+
+    nrf_memobj_put(p_entry);
+}
+
+static void test_backend_panic_set(nrf_log_backend_t const * p_backend)
+{
+}
+
+static void test_backend_flush(nrf_log_backend_t const * p_backend)
+{
+}
+
+static const nrf_log_backend_api_t m_test_backend_api = {
+    .put       = test_backend_put,
+    .panic_set = test_backend_panic_set,
+    .flush     = test_backend_flush,
+};
+
+NRF_LOG_BACKEND_DEF(m_test_backend, m_test_backend_api, NULL);
+
+static void entry_log(uint32_t id, uint32_t seq)
+{
+    uint32_t tag = TAG(id, seq);
+
+    switch (seq % 3)
+    {
+        case 0:
+            NRF_LOG_INFO("%x %x", tag, CHECK(tag));
+            break;
+        case 1:
+            NRF_LOG_INFO("%x %x %x %x", tag, CHECK(tag), CHECK(tag + 1), CHECK(tag + 2));
+            break;
+        default:
+            NRF_LOG_INFO("%x %x %x %x %x %x", tag, CHECK(tag), CHECK(tag + 1), CHECK(tag + 2),
+                         CHECK(tag + 3), CHECK(tag + 4));
+            break;
+    }
+}
+
+static void * producer_thread(void * p_context)
+{
+    uint32_t id = (uint32_t)(uintptr_t)p_context;
+
+    for (uint32_t seq = 0; seq < ENTRIES; seq++)
+    {
+        entry_log(id, seq);
+        if ((seq % 64) == 0)
+        {
+            (void)sched_yield();
+        }
+    }
+    (void)__atomic_add_fetch(&m_producers_done, 1, __ATOMIC_SEQ_CST);
+    return NULL;
+}
+
+static void * bench_producer_thread(void * p_context)
+{
+    uint32_t id = (uint32_t)(uintptr_t)p_context;
+
+    for (uint32_t seq = 0; seq < BENCH_ENTRIES / PRODUCERS; seq++)
+    {
+        NRF_LOG_INFO("%x %x", TAG(id, seq), 0);
+    }
+    (void)__atomic_add_fetch(&m_producers_done, 1, __ATOMIC_SEQ_CST);
+    return NULL;
+}
+
+static void * consumer_thread(void * p_context)
+{
+    while (__atomic_load_n(&m_producers_done, __ATOMIC_SEQ_CST) < PRODUCERS)
+    {
+        if (!NRF_LOG_PROCESS())
+        {
+            (void)sched_yield();
+        }
+    }
+    NRF_LOG_FLUSH();
+    return NULL;
+}
+
+static void producers_run(void * (*producer)(void *))
+{
+    pthread_t producers[PRODUCERS];
+    pthread_t consumer;
+
+    m_producers_done = 0;
+    HOST_TEST_ASSERT(pthread_create(&consumer, NULL, consumer_thread, NULL) == 0);
+    for (uint32_t i = 0; i < PRODUCERS; i++)
+    {
+        HOST_TEST_ASSERT(pthread_create(&producers[i], NULL, producer,
+                                        (void *)(uintptr_t)i) == 0);
+    }
+    for (uint32_t i = 0; i < PRODUCERS; i++)
+    {
+        HOST_TEST_ASSERT(pthread_join(producers[i], NULL) == 0);
+    }
+    HOST_TEST_ASSERT(pthread_join(consumer, NULL) == 0);
+}
+
+static void stress_test(void)
+{
+    m_check_entries = true;
+    producers_run(producer_thread);
+    m_check_entries = false;
+
+    // The number of entries dropped last is attached to the next entry.
+    NRF_LOG_INFO("%x %x", TAG(PRODUCERS, 0), 0);
+    NRF_LOG_FLUSH();
+
+    uint32_t received = 0;
+    for (uint32_t i = 0; i < PRODUCERS; i++)
+    {
+        received += m_received[i];
+    }
+
+    printf("stress: %u producers x %u entries: received %u, dropped %u, "
+           "corrupted %u, out of order %u\n",
+           PRODUCERS, ENTRIES, (unsigned)received, (unsigned)m_dropped,
+           (unsigned)m_corrupted, (unsigned)m_out_of_order);
+
+    HOST_TEST_ASSERT(m_corrupted == 0);
+    HOST_TEST_ASSERT(m_out_of_order == 0);
+    HOST_TEST_ASSERT(received > 0);
+    if (!NRF_LOG_ALLOW_OVERFLOW)
+    {
+        HOST_TEST_ASSERT(received + m_dropped == PRODUCERS * ENTRIES);
+    }
+}
+
+static void benchmark(void)
+{
+    // Cost of one call, with the buffer drained between bursts so that nothing is dropped.
+    uint32_t const burst    = NRF_LOG_BUFSIZE / 32;
+    uint64_t       total_ns = 0;
+
+    for (uint32_t n = 0; n < BENCH_ENTRIES; n += burst)
+    {
+        uint64_t start = host_time_ns();
+        for (uint32_t i = 0; i < burst; i++)
+        {
+            NRF_LOG_INFO("%x %x", TAG(0, n + i), 0);
+        }
+        total_ns += host_time_ns() - start;
+        NRF_LOG_FLUSH();
+    }
+    printf("bench: uncontended log call: %.1f ns\n", (double)total_ns / BENCH_ENTRIES);
+
+    uint64_t start = host_time_ns();
+    producers_run(bench_producer_thread);
+    double seconds = (double)(host_time_ns() - start) / 1e9;
+    printf("bench: %u producers: %.2f M calls/s\n", PRODUCERS, BENCH_ENTRIES / seconds / 1e6);
+}
+
+int main(void)
+{
+    HOST_TEST_ASSERT(NRF_LOG_INIT(NULL) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_log_backend_add(&m_test_backend, NRF_LOG_SEVERITY_DEBUG) >= 0);
+    nrf_log_backend_enable(&m_test_backend);
+
+    printf("lock free: %d, overflow: %d, buffer: %d bytes\n",
+           NRF_LOG_LOCK_FREE_ENABLED, NRF_LOG_ALLOW_OVERFLOW, NRF_LOG_BUFSIZE);
+    stress_test();
+    benchmark();
+    return 0;
+}
@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test and benchmark of the per module rate limiting and sampling of the log frontend.
+ *
+ * The timestamp is a counter set by the test, at 1000 ticks per second. A test backend counts
+ * the entries of each module. The test checks:
+ * - the token bucket: a burst passes at once, then one entry per refill period, the bucket
+ *   refills only up to the burst size and is refilled when the timestamp wraps,
+ * - 1-in-N sampling,
+ * - the suppressed counters and their reset,
+ * - that modules without a limit are not affected, and that the slots are cleared by
+ *   nrf_log_init.
+ *
+ * The benchmark measures the cost of a log call of a module without a limit, with no limits
+ * configured and with all slots used by other modules.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#define NRF_LOG_MODULE_NAME log_rate_limit_test
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_backend_interface.h"
+#include "nrf_log_internal.h"
+#include "host_test.h"
+
+NRF_LOG_MODULE_REGISTER();
+
+#define TIMESTAMP_FREQ  1000        // Timestamp ticks per second.
+#define MAX_MODULES     16          // Maximum number of modules counted by the test backend.
+#define BENCH_ENTRIES   1000000     // Entries logged in one measurement.
+
+static uint32_t m_now;
+static uint32_t m_received[MAX_MODULES];
+static uint32_t m_module_cnt;
+
+static uint32_t timestamp_get(void)
+{
+    return m_now;
+}
+
+static void test_backend_put(nrf_log_backend_t const * p_backend, nrf_log_entry_t * p_entry)
+{
+    nrf_log_header_t header;
+
+    nrf_memobj_get(p_entry);
+    nrf_memobj_read(p_entry, &header, HEADER_SIZE * sizeof(uint32_t), 0);
+    if (header.module_id < MAX_MODULES)
+    {
+        m_received[header.module_id]++;
+    }
+    nrf_memobj_put(p_entry);
+}
+
+static void test_backend_panic_set(nrf_log_backend_t const * p_backend)
+{
+}
+
+static void test_backend_flush(nrf_log_backend_t const * p_backend)
+{
+}
+
+static const nrf_log_backend_api_t m_test_backend_api = {
+    .put       = test_backend_put,
+    .panic_set = test_backend_panic_set,
+    .flush     = test_backend_flush,
+};
+
+NRF_LOG_BACKEND_DEF(m_test_backend, m_test_backend_api, NULL);
+
+/**@brief Function for logging entries of a module and returning how many of them were received. */
+static uint32_t entries_log(uint32_t module_id, uint32_t count)
+{
+    uint32_t severity_mid = NRF_LOG_SEVERITY_INFO | (module_id << NRF_LOG_MODULE_ID_POS);
+    uint32_t received     = m_received[module_id];
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        nrf_log_frontend_std_1(severity_mid, "entry %d", i);
+    }
+    NRF_LOG_FLUSH();
+
+    return m_received[module_id] - received;
+}
+
+static void log_init(void)
+{
+    HOST_TEST_ASSERT(NRF_LOG_INIT(timestamp_get, TIMESTAMP_FREQ) == NRF_SUCCESS);
+    m_module_cnt = nrf_log_module_cnt_get();
+    HOST_TEST_ASSERT((m_module_cnt >= 2) && (m_module_cnt <= MAX_MODULES));
+}
+
+static void rate_limit_test(uint32_t limited, uint32_t other)
+{
+    m_now = 1000;
+
+    HOST_TEST_ASSERT(nrf_log_module_rate_limit_set(m_module_cnt, 10, 5)
+                     == NRF_ERROR_INVALID_PARAM);
+    HOST_TEST_ASSERT(nrf_log_module_rate_limit_set(limited, 10, 0) == NRF_ERROR_INVALID_PARAM);
+    HOST_TEST_ASSERT(nrf_log_module_rate_limit_set(limited, 10, 5) == NRF_SUCCESS);
+
+    // The bucket starts full: the burst passes, the rest is suppressed.
+    HOST_TEST_ASSERT(entries_log(limited, 8) == 5);
+    HOST_TEST_ASSERT(entries_log(other, 8) == 8);
+    HOST_TEST_ASSERT(nrf_log_module_suppressed_cnt_get(limited, false) == 3);
+    HOST_TEST_ASSERT(nrf_log_module_suppressed_cnt_get(other, false) == 0);
+
+    // At 10 entries per second, one token is refilled every 100 ticks.
+    m_now += 99;
+    HOST_TEST_ASSERT(entries_log(limited, 1) == 0);
+    m_now += 1;
+    HOST_TEST_ASSERT(entries_log(limited, 2) == 1);
+    m_now += 250;
+    HOST_TEST_ASSERT(entries_log(limited, 3) == 2);
+
+    // The bucket does not hold more than the burst.
+    m_now += 10 * TIMESTAMP_FREQ;
+    HOST_TEST_ASSERT(entries_log(limited, 8) == 5);
+
+    // A timestamp wrap refills the bucket.
+    m_now = 10;
+    HOST_TEST_ASSERT(entries_log(limited, 8) == 5);
+
+    HOST_TEST_ASSERT(nrf_log_module_suppressed_cnt_get(limited, true) == 3 + 1 + 1 + 1 + 3 + 3);
+    HOST_TEST_ASSERT(nrf_log_module_suppressed_cnt_get(limited, false) == 0);
+
+    // A rate of 0 disables the limit.
+    HOST_TEST_ASSERT(nrf_log_module_rate_limit_set(limited, 0, 5) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(entries_log(limited, 100) == 100);
+    HOST_TEST_ASSERT(nrf_log_module_suppressed_cnt_get(limited, false) == 0);
+
+    printf("token bucket: burst, refill, cap, timestamp wrap and suppressed counter: OK\n");
+}
+
+static void sampling_test(uint32_t sampled, uint32_t other)
+{
+    HOST_TEST_ASSERT(nrf_log_module_sampling_set(m_module_cnt, 4) == NRF_ERROR_INVALID_PARAM);
+    HOST_TEST_ASSERT(nrf_log_module_sampling_set(sampled, 4) == NRF_SUCCESS);
+
+    HOST_TEST_ASSERT(entries_log(sampled, 100) == 25);
+    HOST_TEST_ASSERT(entries_log(sampled, 3) == 1);
+    HOST_TEST_ASSERT(entries_log(other, 100) == 100);
+    HOST_TEST_ASSERT(nrf_log_module_suppressed_cnt_get(sampled, true) == 75 + 2);
+
+    // Sampling and the token bucket are combined: only sampled entries take tokens.
+    m_now += 10 * TIMESTAMP_FREQ;
+    HOST_TEST_ASSERT(nrf_log_module_rate_limit_set(sampled, 10, 5) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_log_module_sampling_set(sampled, 2) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(entries_log(sampled, 20) == 5);
+    HOST_TEST_ASSERT(nrf_log_module_suppressed_cnt_get(sampled, true) == 10 + 5);
+
+    HOST_TEST_ASSERT(nrf_log_module_sampling_set(sampled, 1) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_log_module_rate_limit_set(sampled, 0, 5) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(entries_log(sampled, 100) == 100);
+
+    printf("1-in-N sampling, alone and with the token bucket: OK\n");
+}
+
+static void slots_test(void)
+{
+    uint32_t module_id;
+
+    // Filling all slots makes configuration of another module fail.
+    for (module_id = 0; module_id < m_module_cnt; module_id++)
+    {
+        ret_code_t ret = nrf_log_module_sampling_set(module_id, 2);
+        if (module_id < NRF_LOG_RATE_LIMIT_MODULE_COUNT)
+        {
+            HOST_TEST_ASSERT(ret == NRF_SUCCESS);
+        }
+        else
+        {
+            HOST_TEST_ASSERT(ret == NRF_ERROR_NO_MEM);
+        }
+    }
+
+    // nrf_log_init clears all slots.
+    HOST_TEST_ASSERT(entries_log(0, 10) == 5);
+    log_init();
+    HOST_TEST_ASSERT(nrf_log_module_suppressed_cnt_get(0, false) == 0);
+    HOST_TEST_ASSERT(entries_log(0, 10) == 10);
+
+    printf("%u slots, cleared by nrf_log_init: OK\n", NRF_LOG_RATE_LIMIT_MODULE_COUNT);
+}
+
+static double log_call_ns(uint32_t module_id)
+{
+    uint32_t const severity_mid = NRF_LOG_SEVERITY_INFO | (module_id << NRF_LOG_MODULE_ID_POS);
+    uint32_t const burst        = NRF_LOG_BUFSIZE / 32;
+    uint64_t       total_ns     = 0;
+
+    for (uint32_t n = 0; n < BENCH_ENTRIES; n += burst)
+    {
+        uint64_t start = host_time_ns();
+        for (uint32_t i = 0; i < burst; i++)
+        {
+            nrf_log_frontend_std_2(severity_mid, "%x %x", n + i, 0);
+        }
+        total_ns += host_time_ns() - start;
+        NRF_LOG_FLUSH();
+    }
+
+    return (double)total_ns / BENCH_ENTRIES;
+}
+
+static void benchmark(uint32_t module_id)
+{
+    double   no_limits;
+    double   other_limits;
+    uint32_t used = 0;
+
+    log_init();
+    no_limits = log_call_ns(module_id);
+
+    for (uint32_t i = 0; (i < m_module_cnt) && (used < NRF_LOG_RATE_LIMIT_MODULE_COUNT); i++)
+    {
+        if (i != module_id)
+        {
+            HOST_TEST_ASSERT(nrf_log_module_rate_limit_set(i, 1000, 10) == NRF_SUCCESS);
+            used++;
+        }
+    }
+    other_limits = log_call_ns(module_id);
+
+    printf("bench: log call of a module without a limit: %.1f ns with no limits, "
+           "%.1f ns with limits on other modules\n", no_limits, other_limits);
+}
+
+int main(void)
+{
+    uint32_t module_id;
+    uint32_t other;
+
+    log_init();
+    HOST_TEST_ASSERT(nrf_log_backend_add(&m_test_backend, NRF_LOG_SEVERITY_DEBUG) >= 0);
+    nrf_log_backend_enable(&m_test_backend);
+
+    module_id = NRF_LOG_MODULE_ID;
+    other     = (module_id == 0) ? 1 : 0;
+
+    rate_limit_test(module_id, other);
+    sampling_test(other, module_id);
+    slots_test();
+    benchmark(module_id);
+    return 0;
+}
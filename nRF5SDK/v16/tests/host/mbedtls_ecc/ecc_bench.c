@@ -0,0 +1,295 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test and benchmark of the mbed TLS bignum multiplication and of secp256r1 operations.
+ *
+ * The test checks mbedtls_mpi_mul_mpi on operands of random sizes and signs: every product is
+ * divided by one of its factors, and every square is compared with the product of two copies of
+ * the operand, with the result aliased to each operand. Products of all-ones operands check the
+ * longest carry chains.
+ *
+ * The benchmark measures a 256x256-bit multiplication and square, and secp256r1 key generation,
+ * ECDSA signing and verification and ECDH, as used by the nrf_crypto mbed TLS backend. Every
+ * signature must verify and fail to verify for a changed hash, and both sides of every key
+ * agreement must compute the same secret.
+ *
+ * The test is built with and without MBEDTLS_MPI_MUL_COMBA.
+ */
+#include <string.h>
+#include "mbedtls/bignum.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/ecdsa.h"
+#include "host_test.h"
+
+#define MUL_TEST_COUNT      20000   // Number of random operand pairs in the test.
+#define MUL_TEST_MAX_LIMBS  70      // Maximum size of the random operands, in limbs.
+#define MUL_BENCH_COUNT     20000   // Number of multiplications in one measurement.
+#define MUL_BENCH_REPEAT    30      // Number of measurements, of which the best is kept.
+#define ECC_BENCH_COUNT     40      // Number of runs of each secp256r1 operation.
+#define LIMB_BITS           (8 * sizeof(mbedtls_mpi_uint))
+
+static uint32_t m_rand_state = 0x2545F491;
+
+static int rng(void * p_ctx, unsigned char * p_out, size_t len)
+{
+    (void)p_ctx;
+    while (len-- > 0)
+    {
+        *p_out++ = (unsigned char)host_rand(&m_rand_state);
+    }
+    return 0;
+}
+
+#define MPI_CHECK(call) HOST_TEST_ASSERT((call) == 0)
+
+static void mul_test(void)
+{
+    mbedtls_mpi a, b, x, y, q, r;
+    uint32_t    i;
+
+    mbedtls_mpi_init(&a);
+    mbedtls_mpi_init(&b);
+    mbedtls_mpi_init(&x);
+    mbedtls_mpi_init(&y);
+    mbedtls_mpi_init(&q);
+    mbedtls_mpi_init(&r);
+
+    for (i = 0; i < MUL_TEST_COUNT; i++)
+    {
+        size_t a_len = 1 + host_rand(&m_rand_state) % MUL_TEST_MAX_LIMBS;
+        size_t b_len = 1 + host_rand(&m_rand_state) % MUL_TEST_MAX_LIMBS;
+
+        MPI_CHECK(mbedtls_mpi_fill_random(&a, a_len * sizeof(mbedtls_mpi_uint), rng, NULL));
+        MPI_CHECK(mbedtls_mpi_fill_random(&b, b_len * sizeof(mbedtls_mpi_uint), rng, NULL));
+        if (host_rand(&m_rand_state) & 1)
+        {
+            a.s = -1;
+        }
+
+        // a * b / b == a, with no remainder.
+        MPI_CHECK(mbedtls_mpi_mul_mpi(&x, &a, &b));
+        if (mbedtls_mpi_cmp_int(&b, 0) != 0)
+        {
+            MPI_CHECK(mbedtls_mpi_div_mpi(&q, &r, &x, &b));
+            HOST_TEST_ASSERT(mbedtls_mpi_cmp_mpi(&q, &a) == 0);
+            HOST_TEST_ASSERT(mbedtls_mpi_cmp_int(&r, 0) == 0);
+        }
+
+        // a * a is the same with the result aliased to either operand, and a * a / a == a.
+        MPI_CHECK(mbedtls_mpi_mul_mpi(&x, &a, &a));
+        MPI_CHECK(mbedtls_mpi_copy(&y, &a));
+        MPI_CHECK(mbedtls_mpi_mul_mpi(&y, &y, &y));
+        HOST_TEST_ASSERT(mbedtls_mpi_cmp_mpi(&x, &y) == 0);
+        MPI_CHECK(mbedtls_mpi_copy(&y, &a));
+        MPI_CHECK(mbedtls_mpi_mul_mpi(&y, &y, &a));
+        HOST_TEST_ASSERT(mbedtls_mpi_cmp_mpi(&x, &y) == 0);
+        if (mbedtls_mpi_cmp_int(&a, 0) != 0)
+        {
+            MPI_CHECK(mbedtls_mpi_div_mpi(&q, &r, &x, &a));
+            HOST_TEST_ASSERT(mbedtls_mpi_cmp_mpi(&q, &a) == 0);
+            HOST_TEST_ASSERT(mbedtls_mpi_cmp_int(&r, 0) == 0);
+        }
+    }
+
+    MPI_CHECK(mbedtls_mpi_lset(&a, 0));
+    MPI_CHECK(mbedtls_mpi_mul_mpi(&x, &a, &b));
+    HOST_TEST_ASSERT(mbedtls_mpi_cmp_int(&x, 0) == 0);
+
+    // (2^k - 1)^2 == 2^2k - 2^(k + 1) + 1, squared and multiplied by a copy.
+    for (i = 1; i < 40; i++)
+    {
+        size_t k = i * LIMB_BITS;
+
+        MPI_CHECK(mbedtls_mpi_lset(&a, 1));
+        MPI_CHECK(mbedtls_mpi_shift_l(&a, k));
+        MPI_CHECK(mbedtls_mpi_sub_int(&a, &a, 1));
+
+        MPI_CHECK(mbedtls_mpi_lset(&y, 1));
+        MPI_CHECK(mbedtls_mpi_shift_l(&y, 2 * k));
+        MPI_CHECK(mbedtls_mpi_lset(&b, 1));
+        MPI_CHECK(mbedtls_mpi_shift_l(&b, k + 1));
+        MPI_CHECK(mbedtls_mpi_sub_mpi(&y, &y, &b));
+        MPI_CHECK(mbedtls_mpi_add_int(&y, &y, 1));
+
+        MPI_CHECK(mbedtls_mpi_mul_mpi(&x, &a, &a));
+        HOST_TEST_ASSERT(mbedtls_mpi_cmp_mpi(&x, &y) == 0);
+        MPI_CHECK(mbedtls_mpi_copy(&b, &a));
+        MPI_CHECK(mbedtls_mpi_mul_mpi(&x, &a, &b));
+        HOST_TEST_ASSERT(mbedtls_mpi_cmp_mpi(&x, &y) == 0);
+    }
+
+    mbedtls_mpi_free(&a);
+    mbedtls_mpi_free(&b);
+    mbedtls_mpi_free(&x);
+    mbedtls_mpi_free(&y);
+    mbedtls_mpi_free(&q);
+    mbedtls_mpi_free(&r);
+
+    printf("mpi multiplication, %u random operand pairs and carry chains: OK\n", MUL_TEST_COUNT);
+}
+
+/**@brief Function for measuring the best time of one multiplication of a by b. */
+static double mul_bench(mbedtls_mpi * p_x, mbedtls_mpi const * p_a, mbedtls_mpi const * p_b)
+{
+    uint64_t best = UINT64_MAX;
+    uint32_t i;
+    uint32_t k;
+
+    for (k = 0; k < MUL_BENCH_REPEAT; k++)
+    {
+        uint64_t start = host_time_ns();
+
+        for (i = 0; i < MUL_BENCH_COUNT; i++)
+        {
+            MPI_CHECK(mbedtls_mpi_mul_mpi(p_x, p_a, p_b));
+        }
+        start = host_time_ns() - start;
+        if (start < best)
+        {
+            best = start;
+        }
+    }
+    return (double)best / MUL_BENCH_COUNT;
+}
+
+static void mpi_bench(void)
+{
+    mbedtls_mpi a, b, x;
+    double      mul_ns;
+    double      sqr_ns;
+
+    mbedtls_mpi_init(&a);
+    mbedtls_mpi_init(&b);
+    mbedtls_mpi_init(&x);
+
+    MPI_CHECK(mbedtls_mpi_fill_random(&a, 32, rng, NULL));
+    MPI_CHECK(mbedtls_mpi_fill_random(&b, 32, rng, NULL));
+    MPI_CHECK(mbedtls_mpi_grow(&x, 2 * 32 / sizeof(mbedtls_mpi_uint)));
+
+    mul_ns = mul_bench(&x, &a, &b);
+    sqr_ns = mul_bench(&x, &a, &a);
+    printf("256x256-bit multiply %7.1f ns, square %7.1f ns\n", mul_ns, sqr_ns);
+
+    mbedtls_mpi_free(&a);
+    mbedtls_mpi_free(&b);
+    mbedtls_mpi_free(&x);
+}
+
+static void ecc_bench(void)
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point q1, q2;
+    mbedtls_mpi       d1, d2, r, s, z1, z2;
+    unsigned char     hash[32];
+    uint64_t          keygen_ns = 0;
+    uint64_t          sign_ns   = 0;
+    uint64_t          verify_ns = 0;
+    uint64_t          ecdh_ns   = 0;
+    uint64_t          start;
+    uint32_t          i;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&q1);
+    mbedtls_ecp_point_init(&q2);
+    mbedtls_mpi_init(&d1);
+    mbedtls_mpi_init(&d2);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    mbedtls_mpi_init(&z1);
+    mbedtls_mpi_init(&z2);
+
+    MPI_CHECK(mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1));
+
+    for (i = 0; i < ECC_BENCH_COUNT; i++)
+    {
+        (void)rng(NULL, hash, sizeof(hash));
+
+        start = host_time_ns();
+        MPI_CHECK(mbedtls_ecp_gen_keypair(&grp, &d1, &q1, rng, NULL));
+        keygen_ns += host_time_ns() - start;
+        MPI_CHECK(mbedtls_ecp_gen_keypair(&grp, &d2, &q2, rng, NULL));
+
+        start = host_time_ns();
+        MPI_CHECK(mbedtls_ecdsa_sign(&grp, &r, &s, &d1, hash, sizeof(hash), rng, NULL));
+        sign_ns += host_time_ns() - start;
+
+        start = host_time_ns();
+        MPI_CHECK(mbedtls_ecdsa_verify(&grp, hash, sizeof(hash), &q1, &r, &s));
+        verify_ns += host_time_ns() - start;
+
+        hash[0] ^= 1;
+        HOST_TEST_ASSERT(mbedtls_ecdsa_verify(&grp, hash, sizeof(hash), &q1, &r, &s) != 0);
+
+        start = host_time_ns();
+        MPI_CHECK(mbedtls_ecdh_compute_shared(&grp, &z1, &q2, &d1, rng, NULL));
+        ecdh_ns += host_time_ns() - start;
+        MPI_CHECK(mbedtls_ecdh_compute_shared(&grp, &z2, &q1, &d2, rng, NULL));
+        HOST_TEST_ASSERT(mbedtls_mpi_cmp_mpi(&z1, &z2) == 0);
+    }
+
+    printf("secp256r1 keygen %6.0f us, sign %6.0f us, verify %6.0f us, ECDH %6.0f us\n",
+           keygen_ns / 1e3 / ECC_BENCH_COUNT,
+           sign_ns / 1e3 / ECC_BENCH_COUNT,
+           verify_ns / 1e3 / ECC_BENCH_COUNT,
+           ecdh_ns / 1e3 / ECC_BENCH_COUNT);
+
+    mbedtls_ecp_group_free(&grp);
+    mbedtls_ecp_point_free(&q1);
+    mbedtls_ecp_point_free(&q2);
+    mbedtls_mpi_free(&d1);
+    mbedtls_mpi_free(&d2);
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&z1);
+    mbedtls_mpi_free(&z2);
+}
+
+int main(void)
+{
+#if defined(MBEDTLS_MPI_MUL_COMBA)
+    printf("MBEDTLS_MPI_MUL_COMBA enabled, %u-bit limbs\n", (unsigned)LIMB_BITS);
+#else
+    printf("MBEDTLS_MPI_MUL_COMBA disabled, %u-bit limbs\n", (unsigned)LIMB_BITS);
+#endif
+    mul_test();
+    mpi_bench();
+    ecc_bench();
+    return 0;
+}
@@ -0,0 +1,280 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Benchmark of the mem_manager allocators on the same random workload.
+ *
+ * The test is built once with the block allocator and once with the TLSF allocator, both with
+ * the same amount of memory. The workload keeps a table of slots. Every operation picks a random
+ * slot and frees its buffer, or allocates a buffer of a random size if the slot is empty. Most
+ * requests are small, a few are close to the largest block. Buffers are filled with a pattern
+ * which is checked when they are freed.
+ *
+ * The latency percentiles of nrf_malloc and nrf_free, and the number of failed allocations, are
+ * reported. nrf_mem_diagnose is called with the live buffers of the workload still allocated.
+ * Its output is printed by a log backend writing to stdout.
+ *
+ * The TLSF build also checks that nrf_mem_init clears the statistics of the previous run.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "mem_manager.h"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_backend_interface.h"
+#include "nrf_log_backend_serial.h"
+#include "host_test.h"
+
+#define SLOT_COUNT      256         // Number of buffers which can be allocated at the same time.
+#define OP_COUNT        200000      // Number of operations of the workload.
+#define LOG_TEXT_SIZE   4096        // Size of the captured log output.
+
+#if MEM_MANAGER_TLSF_ENABLED
+#define ALLOCATOR_NAME  "tlsf"
+#else
+#define ALLOCATOR_NAME  "block"
+#endif
+
+typedef struct
+{
+    uint8_t * p_buf;
+    uint32_t  size;
+    uint8_t   pattern;
+} slot_t;
+
+static slot_t   m_slots[SLOT_COUNT];
+static uint32_t m_alloc_ns[OP_COUNT];
+static uint32_t m_free_ns[OP_COUNT];
+static uint32_t m_rand_state = 0x2545F491;
+static uint8_t  m_log_buf[128];
+static char     m_log_text[LOG_TEXT_SIZE];
+static size_t   m_log_len;
+static int32_t  m_backend_id;
+
+static void stdout_write(void const * p_user_ctx, char const * p_str, size_t length)
+{
+    fwrite(p_str, 1, length, stdout);
+
+    length = MIN(length, sizeof(m_log_text) - 1 - m_log_len);
+    memcpy(&m_log_text[m_log_len], p_str, length);
+    m_log_len += length;
+    m_log_text[m_log_len] = '\0';
+}
+
+static void stdout_backend_put(nrf_log_backend_t const * p_backend, nrf_log_entry_t * p_entry)
+{
+    nrf_log_backend_serial_put(p_backend, p_entry, m_log_buf, sizeof(m_log_buf), stdout_write);
+}
+
+static void stdout_backend_panic_set(nrf_log_backend_t const * p_backend)
+{
+}
+
+static void stdout_backend_flush(nrf_log_backend_t const * p_backend)
+{
+}
+
+static const nrf_log_backend_api_t m_stdout_backend_api = {
+    .put       = stdout_backend_put,
+    .panic_set = stdout_backend_panic_set,
+    .flush     = stdout_backend_flush,
+};
+
+NRF_LOG_BACKEND_DEF(m_stdout_backend, m_stdout_backend_api, NULL);
+
+/**@brief Function for enabling or disabling the logs of mem_manager.
+ *
+ * Logs are disabled during the workload, because every call logs a debug message.
+ */
+static void mem_manager_log_set(bool enable)
+{
+    for (uint32_t i = 0; i < nrf_log_module_cnt_get(); i++)
+    {
+        if (strcmp(nrf_log_module_name_get(i, false), "mem_mngr") == 0)
+        {
+            nrf_log_module_filter_set(m_backend_id, i,
+                                      enable ? NRF_LOG_SEVERITY_DEBUG : NRF_LOG_SEVERITY_NONE);
+            return;
+        }
+    }
+    HOST_TEST_ASSERT(false);
+}
+
+static void log_init(void)
+{
+    HOST_TEST_ASSERT(NRF_LOG_INIT(NULL) == NRF_SUCCESS);
+    m_backend_id = nrf_log_backend_add(&m_stdout_backend, NRF_LOG_SEVERITY_DEBUG);
+    HOST_TEST_ASSERT(m_backend_id >= 0);
+    nrf_log_backend_enable(&m_stdout_backend);
+}
+
+/**@brief Function for getting the size of the next request. */
+static uint32_t size_get(void)
+{
+    uint32_t r = host_rand(&m_rand_state) % 100;
+
+    if (r < 50)
+    {
+        return 8 + host_rand(&m_rand_state) % 25;
+    }
+    else if (r < 80)
+    {
+        return 33 + host_rand(&m_rand_state) % 96;
+    }
+    else if (r < 95)
+    {
+        return 129 + host_rand(&m_rand_state) % 128;
+    }
+    return 257 + host_rand(&m_rand_state) % 744;
+}
+
+static void slot_free(slot_t * p_slot, uint32_t * p_ns)
+{
+    for (uint32_t i = 0; i < p_slot->size; i++)
+    {
+        HOST_TEST_ASSERT(p_slot->p_buf[i] == p_slot->pattern);
+    }
+
+    uint64_t start = host_time_ns();
+    nrf_free(p_slot->p_buf);
+    *p_ns = (uint32_t)(host_time_ns() - start);
+
+    p_slot->p_buf = NULL;
+}
+
+static int u32_compare(void const * p_a, void const * p_b)
+{
+    uint32_t a = *(uint32_t const *)p_a;
+    uint32_t b = *(uint32_t const *)p_b;
+
+    return (a > b) - (a < b);
+}
+
+static void percentiles_print(char const * p_name, uint32_t * p_ns, uint32_t count)
+{
+    HOST_TEST_ASSERT(count != 0);
+    qsort(p_ns, count, sizeof(uint32_t), u32_compare);
+
+    printf("%-5s %-6s p50 %5u ns, p90 %5u ns, p99 %5u ns, p99.9 %6u ns, max %7u ns\n",
+           ALLOCATOR_NAME, p_name,
+           p_ns[count / 2], p_ns[(count * 9) / 10], p_ns[(count * 99) / 100],
+           p_ns[(count * 999) / 1000], p_ns[count - 1]);
+}
+
+static void workload_run(void)
+{
+    uint32_t alloc_cnt = 0;
+    uint32_t free_cnt  = 0;
+    uint32_t fail_cnt  = 0;
+
+    for (uint32_t op = 0; op < OP_COUNT; op++)
+    {
+        slot_t * p_slot = &m_slots[host_rand(&m_rand_state) % SLOT_COUNT];
+
+        if (p_slot->p_buf != NULL)
+        {
+            slot_free(p_slot, &m_free_ns[free_cnt++]);
+            continue;
+        }
+
+        uint32_t size  = size_get();
+        uint64_t start = host_time_ns();
+
+        p_slot->p_buf = nrf_malloc(size);
+        m_alloc_ns[alloc_cnt++] = (uint32_t)(host_time_ns() - start);
+
+        if (p_slot->p_buf == NULL)
+        {
+            fail_cnt++;
+            continue;
+        }
+        p_slot->size    = size;
+        p_slot->pattern = (uint8_t)op;
+        memset(p_slot->p_buf, p_slot->pattern, size);
+    }
+
+    percentiles_print("malloc", m_alloc_ns, alloc_cnt);
+    percentiles_print("free", m_free_ns, free_cnt);
+    printf("%-5s %u allocations, %u failed\n", ALLOCATOR_NAME, alloc_cnt, fail_cnt);
+}
+
+int main(void)
+{
+    uint32_t free_ns;
+
+    log_init();
+    mem_manager_log_set(false);
+    HOST_TEST_ASSERT(nrf_mem_init() == NRF_SUCCESS);
+
+    workload_run();
+
+    // Fragmentation with the live buffers of the workload.
+    mem_manager_log_set(true);
+    nrf_mem_diagnose();
+    NRF_LOG_FLUSH();
+    mem_manager_log_set(false);
+
+    for (uint32_t i = 0; i < SLOT_COUNT; i++)
+    {
+        if (m_slots[i].p_buf != NULL)
+        {
+            slot_free(&m_slots[i], &free_ns);
+        }
+    }
+
+#if MEM_MANAGER_TLSF_ENABLED
+    // The statistics of the workload are cleared by nrf_mem_init.
+    HOST_TEST_ASSERT(nrf_mem_init() == NRF_SUCCESS);
+
+    void * p_buf = nrf_malloc(2000);
+    HOST_TEST_ASSERT(p_buf != NULL);
+
+    m_log_len = 0;
+    mem_manager_log_set(true);
+    nrf_mem_diagnose();
+    NRF_LOG_FLUSH();
+    mem_manager_log_set(false);
+    HOST_TEST_ASSERT(strstr(m_log_text, "Allocations 1, failed 0.") != NULL);
+    HOST_TEST_ASSERT(strstr(m_log_text, "Min alloc 2000, max alloc 2000.") != NULL);
+    nrf_free(p_buf);
+    printf("tlsf statistics cleared by nrf_mem_init: OK\n");
+#endif
+
+    return 0;
+}
@@ -0,0 +1,593 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test and benchmark of the fixed-base comb secp256r1 key generation of the micro-ecc
+ *        backend.
+ *
+ * The micro-ecc sources are not part of the SDK, so the ECDH of the backend cannot be built on
+ * the host. In its place, the test has the variable-base co-Z ladder of micro-ecc
+ * (EccPoint_mult), written on the field arithmetic of micro_ecc_backend_p256_comb.c, which this
+ * file includes. The ladder is what the backend used for key generation before the comb, and
+ * what micro-ecc uses for ECDH.
+ *
+ * The key generation and the ECDH are checked against known-answer vectors: the NIST CAVS ECDH
+ * vectors for P-256, the key of RFC 6979 A.2.5 and small multiples of the generator. The comb
+ * must agree with the ladder for random keys, and the benchmark compares their cost.
+ *
+ * The timing test is a Welch t-test on the duration of the public key computation for a fixed
+ * private key against random private keys. The largest measurements are cropped, as they come
+ * from the host and not from the key. A |t| above T_LIMIT means that the duration depends on the
+ * key.
+ */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "micro_ecc_backend_p256_comb.c"
+#include "host_test.h"
+
+#define RANDOM_KEY_COUNT    300     // Number of random keys checked against the ladder.
+#define BENCH_COUNT         1000    // Number of operations measured for each item.
+#define CT_RUNS             10000   // Number of measurements of the timing test.
+#define CT_WARMUP           100     // Number of measurements discarded first.
+#define CT_CROP_PERCENT     90      // Measurements above this percentile are cropped.
+#define T_LIMIT             4.5     // Largest |t| of a key-independent duration.
+
+/**@brief Known-answer vector. Numbers are big-endian hexadecimal strings. */
+typedef struct
+{
+    char const * p_private_key;
+    char const * p_public_x;
+    char const * p_public_y;
+    bool         ladder_exception;  // The ladder hits an addition of equal points.
+    char const * p_peer_x;          // Peer public key of the ECDH, or NULL.
+    char const * p_peer_y;
+    char const * p_secret;          // Shared secret (X coordinate).
+} kat_vector_t;
+
+static kat_vector_t const m_kat_vectors[] =
+{
+    {   // 1 * G
+        "0000000000000000000000000000000000000000000000000000000000000001",
+        "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296",
+        "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5",
+        true,
+    },
+    {   // 2 * G
+        "0000000000000000000000000000000000000000000000000000000000000002",
+        "7CF27B188D034F7E8A52380304B51AC3C08969E277F21B35A60B48FC47669978",
+        "07775510DB8ED040293D9AC69F7430DBBA7DADE63CE982299E04B79D227873D1",
+        false,
+    },
+    {   // 3 * G
+        "0000000000000000000000000000000000000000000000000000000000000003",
+        "5ECBE4D1A6330A44C8F7EF951D4BF165E6C6B721EFADA985FB41661BC6E7FD6C",
+        "8734640C4998FF7E374B06CE1A64A2ECD82AB036384FB83D9A79B127A27D5032",
+        false,
+    },
+    {   // (n - 2) * G = -2 * G
+        "FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC63254F",
+        "7CF27B188D034F7E8A52380304B51AC3C08969E277F21B35A60B48FC47669978",
+        "F888AAEE24712FC0D6C26539608BCF244582521AC3167DD661FB4862DD878C2E",
+        true,
+    },
+    {   // (n - 1) * G = -G
+        "FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632550",
+        "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296",
+        "B01CBD1C01E58065711814B583F061E9D431CCA994CEA1313449BF97C840AE0A",
+        true,
+    },
+    {   // RFC 6979 A.2.5
+        "C9AFA9D845BA75166B5C215767B1D6934E50C3DB36E89B127B8A622B120F6721",
+        "60FED4BA255A9D31C961EB74C6356D68C049B8923B61FA6CE669622E60F29FB6",
+        "7903FE1008B8BC99A41AE9E95628BC64F2F1B20C2D7E9F5177A3C294D4462299",
+        false,
+    },
+    {   // NIST CAVS 14.1 ECC CDH Primitive, P-256, COUNT = 0
+        "7D7DC5F71EB29DDAF80D6214632EEAE03D9058AF1FB6D22ED80BADB62BC1A534",
+        "EAD218590119E8876B29146FF89CA61770C4EDBBF97D38CE385ED281D8A6B230",
+        "28AF61281FD35E2FA7002523ACC85A429CB06EE6648325389F59EDFCE1405141",
+        false,
+        "700C48F77F56584C5CC632CA65640DB91B6BACCE3A4DF6B42CE7CC838833D287",
+        "DB71E509E3FD9B060DDB20BA5C51DCC5948D46FBF640DFE0441782CAB85FA4AC",
+        "46FC62106420FF012E54A434FBDD2D25CCC5852060561E68040DD7778997BD7B",
+    },
+    {   // NIST CAVS 14.1 ECC CDH Primitive, P-256, COUNT = 1
+        "38F65D6DCE47676044D58CE5139582D568F64BB16098D179DBAB07741DD5CAF5",
+        "119F2F047902782AB0C9E27A54AFF5EB9B964829CA99C06B02DDBA95B0A3F6D0",
+        "8F52B726664CAC366FC98AC7A012B2682CBD962E5ACB544671D41B9445704D1D",
+        false,
+        "809F04289C64348C01515EB03D5CE7AC1A8CB9498F5CAA50197E58D43A86A7AE",
+        "B29D84E811197F25EBA8F5194092CB6FF440E26D4421011372461F579271CDA3",
+        "057D636096CB80B67A8C038C890E887D1ADFA4195E9B3CE241C8A778C59CDA67",
+    },
+};
+
+/** Generator, X followed by Y. */
+static const uint32_t m_g[2 * P256_WORDS] =
+{
+    0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+    0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2,
+};
+
+static uint32_t m_rand_state = 0x2545F491;
+
+
+int nrf_crypto_backend_micro_ecc_rng_callback(uint8_t * dest, unsigned size)
+{
+    for (unsigned i = 0; i < size; i++)
+    {
+        dest[i] = (uint8_t)host_rand(&m_rand_state);
+    }
+    return 1;
+}
+
+
+/**@brief Function for converting a big-endian hexadecimal string to little-endian words. */
+static void words_from_hex(uint32_t * p_words, char const * p_hex)
+{
+    HOST_TEST_ASSERT(strlen(p_hex) == 8 * P256_WORDS);
+
+    for (uint32_t i = 0; i < P256_WORDS; i++)
+    {
+        char word[9];
+
+        memcpy(word, &p_hex[8 * (P256_WORDS - 1 - i)], 8);
+        word[8]    = '\0';
+        p_words[i] = (uint32_t)strtoul(word, NULL, 16);
+    }
+}
+
+
+/**@brief Function for getting a random private key in the range [1, n - 1]. */
+static void random_key_get(uint32_t * p_key)
+{
+    do
+    {
+        (void)nrf_crypto_backend_micro_ecc_rng_callback((uint8_t *)p_key, sizeof(p256_fe_t));
+    } while (!private_key_valid(p_key));
+}
+
+
+/**@brief Function for converting a point in co-Z coordinates with the given Z to affine
+ *        coordinates of the same Z representation (apply_z of micro-ecc). */
+static void apply_z(uint32_t * p_x, uint32_t * p_y, uint32_t const * p_z)
+{
+    p256_fe_t t;
+
+    fe_sqr(t, p_z);
+    fe_mul(p_x, p_x, t);
+    fe_mul(t, t, p_z);
+    fe_mul(p_y, p_y, t);
+}
+
+
+/**@brief Function for computing (x1, y1) = P * Z and (x2, y2) = 2 * P * Z with the same Z
+ *        (XYcZ_initial_double of micro-ecc). */
+static void xycz_initial_double(uint32_t       * p_x1,
+                                uint32_t       * p_y1,
+                                uint32_t       * p_x2,
+                                uint32_t       * p_y2,
+                                uint32_t const * p_initial_z)
+{
+    p256_jacobian_t r;
+
+    memcpy(p_x2, p_x1, sizeof(p256_fe_t));
+    memcpy(p_y2, p_y1, sizeof(p256_fe_t));
+
+    memcpy(r.x, p_x1, sizeof(p256_fe_t));
+    memcpy(r.y, p_y1, sizeof(p256_fe_t));
+    memcpy(r.z, p_initial_z, sizeof(p256_fe_t));
+    apply_z(r.x, r.y, r.z);
+    point_double(&r);
+    memcpy(p_x1, r.x, sizeof(p256_fe_t));
+    memcpy(p_y1, r.y, sizeof(p256_fe_t));
+
+    apply_z(p_x2, p_y2, r.z);
+}
+
+
+/**@brief Function for the co-Z addition: (x2, y2) = P1 + P2, (x1, y1) = P1 with the same Z
+ *        (XYcZ_add of micro-ecc). */
+static void xycz_add(uint32_t * p_x1, uint32_t * p_y1, uint32_t * p_x2, uint32_t * p_y2)
+{
+    p256_fe_t t;
+
+    fe_sub(t, p_x2, p_x1);
+    fe_sqr(t, t);
+    fe_mul(p_x1, p_x1, t);
+    fe_mul(p_x2, p_x2, t);
+    fe_sub(p_y2, p_y2, p_y1);
+    fe_sqr(t, p_y2);
+
+    fe_sub(t, t, p_x1);
+    fe_sub(t, t, p_x2);
+    fe_sub(p_x2, p_x2, p_x1);
+    fe_mul(p_y1, p_y1, p_x2);
+    fe_sub(p_x2, p_x1, t);
+    fe_mul(p_y2, p_y2, p_x2);
+    fe_sub(p_y2, p_y2, p_y1);
+
+    memcpy(p_x2, t, sizeof(p256_fe_t));
+}
+
+
+/**@brief Function for the conjugate co-Z addition: (x2, y2) = P1 + P2, (x1, y1) = P1 - P2 with
+ *        the same Z (XYcZ_addC of micro-ecc). */
+static void xycz_addc(uint32_t * p_x1, uint32_t * p_y1, uint32_t * p_x2, uint32_t * p_y2)
+{
+    p256_fe_t t5;
+    p256_fe_t t6;
+    p256_fe_t t7;
+
+    fe_sub(t5, p_x2, p_x1);
+    fe_sqr(t5, t5);
+    fe_mul(p_x1, p_x1, t5);
+    fe_mul(p_x2, p_x2, t5);
+    fe_add(t5, p_y2, p_y1);
+    fe_sub(p_y2, p_y2, p_y1);
+
+    fe_sub(t6, p_x2, p_x1);
+    fe_mul(p_y1, p_y1, t6);
+    fe_add(t6, p_x1, p_x2);
+    fe_sqr(p_x2, p_y2);
+    fe_sub(p_x2, p_x2, t6);
+
+    fe_sub(t7, p_x1, p_x2);
+    fe_mul(p_y2, p_y2, t7);
+    fe_sub(p_y2, p_y2, p_y1);
+
+    fe_sqr(t7, t5);
+    fe_sub(t7, t7, t6);
+    fe_sub(t6, t7, p_x1);
+    fe_mul(t6, t6, t5);
+    fe_sub(p_y1, t6, p_y1);
+
+    memcpy(p_x1, t7, sizeof(p256_fe_t));
+}
+
+
+/**@brief Function for the scalar multiplication of micro-ecc (EccPoint_mult with
+ *        regularize_k), a co-Z Montgomery ladder over 257 bits with a random initial Z.
+ *
+ * @param[out] p_result  Result, X followed by Y.
+ * @param[in]  p_point   Point, X followed by Y.
+ * @param[in]  p_scalar  Scalar in the range [1, n - 1].
+ */
+static void ladder_mult(uint32_t * p_result, uint32_t const * p_point, uint32_t const * p_scalar)
+{
+    p256_fe_t        k_n;
+    p256_fe_t        k_2n;
+    p256_fe_t        rx[2];
+    p256_fe_t        ry[2];
+    p256_fe_t        z;
+    uint32_t const * p_k;
+    uint32_t         nb;
+
+    // k + n or k + 2n, whichever has bit 256 set, so that the ladder always runs 257 bits.
+    p_k = vli_add(k_n, p_scalar, m_n) ? k_n : k_2n;
+    (void)vli_add(k_2n, k_n, m_n);
+
+    random_key_get(z);
+
+    memcpy(rx[1], &p_point[0], sizeof(p256_fe_t));
+    memcpy(ry[1], &p_point[P256_WORDS], sizeof(p256_fe_t));
+    xycz_initial_double(rx[1], ry[1], rx[0], ry[0], z);
+
+    for (uint32_t i = 255; i > 0; i--)
+    {
+        nb = !((p_k[i / 32] >> (i % 32)) & 1);
+        xycz_addc(rx[1 - nb], ry[1 - nb], rx[nb], ry[nb]);
+        xycz_add(rx[nb], ry[nb], rx[1 - nb], ry[1 - nb]);
+    }
+
+    nb = !(p_k[0] & 1);
+    xycz_addc(rx[1 - nb], ry[1 - nb], rx[nb], ry[nb]);
+
+    // Find the final 1 / Z.
+    fe_sub(z, rx[1], rx[0]);
+    fe_mul(z, z, ry[1 - nb]);
+    fe_mul(z, z, &p_point[0]);
+    fe_inv(z, z);
+    fe_mul(z, z, &p_point[P256_WORDS]);
+    fe_mul(z, z, rx[1 - nb]);
+
+    xycz_add(rx[nb], ry[nb], rx[1 - nb], ry[1 - nb]);
+    apply_z(rx[0], ry[0], z);
+
+    memcpy(&p_result[0], rx[0], sizeof(p256_fe_t));
+    memcpy(&p_result[P256_WORDS], ry[0], sizeof(p256_fe_t));
+}
+
+
+/**@brief Function for ECDH as in micro-ecc (uECC_shared_secret).
+ *
+ * @param[out] p_secret      X coordinate of the shared point.
+ * @param[in]  p_public_key  Peer public key, X followed by Y.
+ * @param[in]  p_private_key Private key.
+ *
+ * @retval NRF_SUCCESS                  Shared secret computed.
+ * @retval NRF_ERROR_CRYPTO_INTERNAL    Invalid key.
+ */
+static ret_code_t ecdh_compute(uint32_t       * p_secret,
+                               uint32_t const * p_public_key,
+                               uint32_t const * p_private_key)
+{
+    p256_affine_t q;
+    uint32_t      shared[2 * P256_WORDS];
+
+    memcpy(q.x, &p_public_key[0], sizeof(p256_fe_t));
+    memcpy(q.y, &p_public_key[P256_WORDS], sizeof(p256_fe_t));
+
+    if (!private_key_valid(p_private_key) || !point_on_curve(&q))
+    {
+        return NRF_ERROR_CRYPTO_INTERNAL;
+    }
+
+    ladder_mult(shared, p_public_key, p_private_key);
+    if (vli_zero_mask(&shared[0]) && vli_zero_mask(&shared[P256_WORDS]))
+    {
+        return NRF_ERROR_CRYPTO_INTERNAL;
+    }
+
+    memcpy(p_secret, shared, sizeof(p256_fe_t));
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Test of the key generation and the ECDH with the known-answer vectors. */
+static void kat_test(void)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_kat_vectors); i++)
+    {
+        kat_vector_t const *                       p_vector = &m_kat_vectors[i];
+        nrf_crypto_backend_secp256r1_private_key_t prv;
+        nrf_crypto_backend_secp256r1_public_key_t  pub;
+        uint32_t                                   expected[2 * P256_WORDS];
+        uint32_t                                   ladder[2 * P256_WORDS];
+
+        words_from_hex(prv.key, p_vector->p_private_key);
+        words_from_hex(&expected[0], p_vector->p_public_x);
+        words_from_hex(&expected[P256_WORDS], p_vector->p_public_y);
+
+        HOST_TEST_ASSERT(nrf_crypto_backend_secp256r1_public_key_calculate(NULL, &prv, &pub)
+                         == NRF_SUCCESS);
+        HOST_TEST_ASSERT(memcmp(pub.key, expected, sizeof(expected)) == 0);
+
+        // The co-Z formulas of the ladder do not handle the addition of equal points, which
+        // the keys 1, n - 2 and n - 1 lead to. Random keys do not, in micro-ecc either.
+        if (!p_vector->ladder_exception)
+        {
+            ladder_mult(ladder, m_g, prv.key);
+            HOST_TEST_ASSERT(memcmp(ladder, expected, sizeof(expected)) == 0);
+        }
+
+        if (p_vector->p_peer_x != NULL)
+        {
+            uint32_t peer[2 * P256_WORDS];
+            uint32_t secret[P256_WORDS];
+
+            words_from_hex(&peer[0], p_vector->p_peer_x);
+            words_from_hex(&peer[P256_WORDS], p_vector->p_peer_y);
+            words_from_hex(expected, p_vector->p_secret);
+
+            HOST_TEST_ASSERT(ecdh_compute(secret, peer, prv.key) == NRF_SUCCESS);
+            HOST_TEST_ASSERT(memcmp(secret, expected, sizeof(secret)) == 0);
+        }
+    }
+
+    printf("known answers: %u vectors: OK\n", (unsigned)ARRAY_SIZE(m_kat_vectors));
+}
+
+
+/**@brief Test of random keys against the ladder, and of the keys that are not valid. */
+static void random_key_test(void)
+{
+    nrf_crypto_backend_secp256r1_private_key_t prv_a;
+    nrf_crypto_backend_secp256r1_private_key_t prv_b;
+    nrf_crypto_backend_secp256r1_public_key_t  pub_a;
+    nrf_crypto_backend_secp256r1_public_key_t  pub_b;
+    uint32_t                                   ladder[2 * P256_WORDS];
+    uint32_t                                   secret_a[P256_WORDS];
+    uint32_t                                   secret_b[P256_WORDS];
+
+    for (uint32_t i = 0; i < RANDOM_KEY_COUNT; i++)
+    {
+        HOST_TEST_ASSERT(nrf_crypto_backend_secp256r1_key_pair_generate(NULL, &prv_a, &pub_a)
+                         == NRF_SUCCESS);
+        ladder_mult(ladder, m_g, prv_a.key);
+        HOST_TEST_ASSERT(memcmp(pub_a.key, ladder, sizeof(ladder)) == 0);
+
+        // Both sides of the key exchange get the same secret.
+        HOST_TEST_ASSERT(nrf_crypto_backend_secp256r1_key_pair_generate(NULL, &prv_b, &pub_b)
+                         == NRF_SUCCESS);
+        HOST_TEST_ASSERT(ecdh_compute(secret_a, pub_b.key, prv_a.key) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(ecdh_compute(secret_b, pub_a.key, prv_b.key) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(memcmp(secret_a, secret_b, sizeof(secret_a)) == 0);
+    }
+
+    // 0 and n are not valid private keys.
+    memset(prv_a.key, 0, sizeof(prv_a.key));
+    HOST_TEST_ASSERT(nrf_crypto_backend_secp256r1_public_key_calculate(NULL, &prv_a, &pub_a)
+                     == NRF_ERROR_CRYPTO_INTERNAL);
+    memcpy(prv_a.key, m_n, sizeof(prv_a.key));
+    HOST_TEST_ASSERT(nrf_crypto_backend_secp256r1_public_key_calculate(NULL, &prv_a, &pub_a)
+                     == NRF_ERROR_CRYPTO_INTERNAL);
+
+    printf("random keys: %u keys agree with the ladder: OK\n", RANDOM_KEY_COUNT);
+}
+
+
+/**@brief Benchmark of the key generation with the comb and with the ladder, and of the ECDH. */
+static void bench(void)
+{
+    nrf_crypto_backend_secp256r1_private_key_t prv;
+    nrf_crypto_backend_secp256r1_public_key_t  pub;
+    uint32_t                                   peer[2 * P256_WORDS];
+    uint32_t                                   secret[P256_WORDS];
+    uint64_t                                   comb_ns;
+    uint64_t                                   ladder_ns;
+    uint64_t                                   ecdh_ns;
+    uint64_t                                   start;
+
+    random_key_get(prv.key);
+    HOST_TEST_ASSERT(nrf_crypto_backend_secp256r1_public_key_calculate(NULL, &prv, &pub)
+                     == NRF_SUCCESS);
+    memcpy(peer, pub.key, sizeof(peer));
+
+    start = host_time_ns();
+    for (uint32_t i = 0; i < BENCH_COUNT; i++)
+    {
+        prv.key[0] ^= i << 1;
+        HOST_TEST_ASSERT(nrf_crypto_backend_secp256r1_public_key_calculate(NULL, &prv, &pub)
+                         == NRF_SUCCESS);
+    }
+    comb_ns = host_time_ns() - start;
+
+    start = host_time_ns();
+    for (uint32_t i = 0; i < BENCH_COUNT; i++)
+    {
+        prv.key[0] ^= i << 1;
+        ladder_mult(pub.key, m_g, prv.key);
+    }
+    ladder_ns = host_time_ns() - start;
+
+    start = host_time_ns();
+    for (uint32_t i = 0; i < BENCH_COUNT; i++)
+    {
+        prv.key[0] ^= i << 1;
+        HOST_TEST_ASSERT(ecdh_compute(secret, peer, prv.key) == NRF_SUCCESS);
+    }
+    ecdh_ns = host_time_ns() - start;
+
+    printf("key generation: comb (%u teeth, %u bytes) %.1f us, ladder %.1f us; ECDH %.1f us\n",
+           P256_COMB_W,
+           (unsigned)sizeof(m_comb_table),
+           comb_ns / 1e3 / BENCH_COUNT,
+           ladder_ns / 1e3 / BENCH_COUNT,
+           ecdh_ns / 1e3 / BENCH_COUNT);
+}
+
+
+static int duration_cmp(void const * p_a, void const * p_b)
+{
+    uint32_t a = *(uint32_t const *)p_a;
+    uint32_t b = *(uint32_t const *)p_b;
+
+    return (a > b) - (a < b);
+}
+
+
+/**@brief Welch t-test of the duration of the public key computation, for a fixed private key
+ *        against random private keys. */
+static void ct_test(void)
+{
+    static uint32_t duration[CT_RUNS];
+    static uint32_t sorted[CT_RUNS];
+    static uint8_t  key_class[CT_RUNS];
+
+    nrf_crypto_backend_secp256r1_private_key_t prv;
+    nrf_crypto_backend_secp256r1_public_key_t  pub;
+    uint32_t                                   fixed[P256_WORDS];
+    uint32_t                                   crop;
+    double                                     sum[2] = {0};
+    double                                     sum_sq[2] = {0};
+    uint32_t                                   cnt[2] = {0};
+    double                                     mean[2];
+    double                                     var[2];
+    double                                     t;
+
+    random_key_get(fixed);
+
+    for (uint32_t i = 0; i < CT_RUNS; i++)
+    {
+        uint64_t start;
+
+        key_class[i] = host_rand(&m_rand_state) & 1;
+        if (key_class[i] == 0)
+        {
+            memcpy(prv.key, fixed, sizeof(fixed));
+        }
+        else
+        {
+            random_key_get(prv.key);
+        }
+
+        start = host_time_ns();
+        (void)nrf_crypto_backend_secp256r1_public_key_calculate(NULL, &prv, &pub);
+        duration[i] = (uint32_t)(host_time_ns() - start);
+    }
+
+    memcpy(sorted, duration, sizeof(sorted));
+    qsort(&sorted[CT_WARMUP], CT_RUNS - CT_WARMUP, sizeof(sorted[0]), duration_cmp);
+    crop = sorted[CT_WARMUP + (CT_RUNS - CT_WARMUP) * CT_CROP_PERCENT / 100];
+
+    for (uint32_t i = CT_WARMUP; i < CT_RUNS; i++)
+    {
+        if (duration[i] <= crop)
+        {
+            sum[key_class[i]]    += duration[i];
+            sum_sq[key_class[i]] += (double)duration[i] * duration[i];
+            cnt[key_class[i]]++;
+        }
+    }
+
+    for (uint32_t c = 0; c < 2; c++)
+    {
+        mean[c] = sum[c] / cnt[c];
+        var[c]  = sum_sq[c] / cnt[c] - mean[c] * mean[c];
+    }
+    t = (mean[0] - mean[1]) / sqrt(var[0] / cnt[0] + var[1] / cnt[1]);
+
+    printf("timing: fixed key %.1f us, random keys %.1f us, t = %.2f",
+           mean[0] / 1e3, mean[1] / 1e3, t);
+    HOST_TEST_ASSERT(fabs(t) < T_LIMIT);
+    printf(": OK\n");
+}
+
+
+int main(void)
+{
+    kat_test();
+    random_key_test();
+    bench();
+    ct_test();
+
+    return 0;
+}
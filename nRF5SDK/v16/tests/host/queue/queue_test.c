@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test and throughput benchmark of the queue library.
+ *
+ * The test checks the zero-copy span API at the wrap-around of the circular buffer and at the
+ * full and empty edges. In @ref NRF_QUEUE_MODE_SPSC, a producer thread writes through
+ * reserve/commit and the main thread reads through peek/consume, with spans of varying length.
+ * Every element carries its sequence number and its complement, which the consumer checks.
+ *
+ * The benchmark measures the cost per element of push/pop, of write/read in bursts and of
+ * reserve/peek in bursts, in @ref NRF_QUEUE_MODE_NO_OVERFLOW and @ref NRF_QUEUE_MODE_SPSC.
+ */
+#include <pthread.h>
+#include <sched.h>
+#include "sdk_common.h"
+#include "nrf_queue.h"
+#include "host_test.h"
+
+#define QUEUE_SIZE      255         // Number of elements in the queues.
+#define BURST           8           // Number of elements in a burst in the benchmark.
+#define BENCH_COUNT     10000000UL  // Number of elements in each benchmark.
+#define STRESS_COUNT    2000000UL   // Number of elements passed between the threads.
+
+/**@brief Element of the queues. */
+typedef struct
+{
+    uint32_t seq;       // Sequence number.
+    uint32_t data[2];
+    uint32_t check;     // Complement of the sequence number.
+} element_t;
+
+NRF_QUEUE_DEF(element_t, m_queue, QUEUE_SIZE, NRF_QUEUE_MODE_NO_OVERFLOW);
+NRF_QUEUE_DEF(element_t, m_queue_spsc, QUEUE_SIZE, NRF_QUEUE_MODE_SPSC);
+
+static volatile uint32_t m_sink;
+
+
+/**@brief Function for testing the span API at the edges of the buffer. */
+static void span_api_test(void)
+{
+    element_t         element = {0};
+    element_t       * p_write;
+    element_t const * p_read;
+    size_t            count;
+
+    // Move the indexes close to the end of the buffer.
+    for (uint32_t i = 0; i < 250; i++)
+    {
+        HOST_TEST_ASSERT(nrf_queue_push(&m_queue, &element) == NRF_SUCCESS);
+        HOST_TEST_ASSERT(nrf_queue_pop(&m_queue, &element) == NRF_SUCCESS);
+    }
+
+    // A span ends at the end of the buffer.
+    count   = 100;
+    p_write = nrf_queue_write_reserve(&m_queue, &count);
+    HOST_TEST_ASSERT((p_write != NULL) && (count == 6));
+    for (uint32_t i = 0; i < count; i++)
+    {
+        p_write[i].seq = i;
+    }
+    HOST_TEST_ASSERT(nrf_queue_write_commit(&m_queue, 7) == NRF_ERROR_INVALID_LENGTH);
+    HOST_TEST_ASSERT(nrf_queue_write_commit(&m_queue, 6) == NRF_SUCCESS);
+
+    // The next span starts at the beginning of the buffer.
+    count   = 1000;
+    p_write = nrf_queue_write_reserve(&m_queue, &count);
+    HOST_TEST_ASSERT((p_write == (element_t *)m_queue.p_buffer) && (count == 249));
+    p_write[0].seq = 6;
+    HOST_TEST_ASSERT(nrf_queue_write_commit(&m_queue, 1) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_queue_utilization_get(&m_queue) == 7);
+
+    count  = 100;
+    p_read = nrf_queue_read_peek(&m_queue, &count);
+    HOST_TEST_ASSERT((p_read != NULL) && (count == 6) && (p_read[5].seq == 5));
+    HOST_TEST_ASSERT(nrf_queue_read_consume(&m_queue, 8) == NRF_ERROR_NOT_FOUND);
+    HOST_TEST_ASSERT(nrf_queue_read_consume(&m_queue, 6) == NRF_SUCCESS);
+
+    count  = 100;
+    p_read = nrf_queue_read_peek(&m_queue, &count);
+    HOST_TEST_ASSERT((p_read != NULL) && (count == 1) && (p_read[0].seq == 6));
+    HOST_TEST_ASSERT(nrf_queue_pop(&m_queue, &element) == NRF_SUCCESS);
+    HOST_TEST_ASSERT((element.seq == 6) && nrf_queue_is_empty(&m_queue));
+
+    count = 3;
+    HOST_TEST_ASSERT((nrf_queue_read_peek(&m_queue, &count) == NULL) && (count == 0));
+
+    // Fill the queue completely through one span.
+    nrf_queue_reset(&m_queue);
+    count   = 1000;
+    p_write = nrf_queue_write_reserve(&m_queue, &count);
+    HOST_TEST_ASSERT((p_write != NULL) && (count == QUEUE_SIZE));
+    HOST_TEST_ASSERT(nrf_queue_write_commit(&m_queue, count) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_queue_is_full(&m_queue));
+
+    count = 1;
+    HOST_TEST_ASSERT(nrf_queue_write_reserve(&m_queue, &count) == NULL);
+    HOST_TEST_ASSERT(nrf_queue_max_utilization_get(&m_queue) == QUEUE_SIZE);
+
+    nrf_queue_reset(&m_queue);
+    printf("span API at the buffer edges: OK\n");
+}
+
+
+/**@brief Producer thread of the SPSC test. */
+static void * spsc_producer(void * p_context)
+{
+    uint32_t seq = 0;
+
+    while (seq < STRESS_COUNT)
+    {
+        size_t      count   = 1 + (seq % 13);
+        element_t * p_write = nrf_queue_write_reserve(&m_queue_spsc, &count);
+
+        if (p_write == NULL)
+        {
+            (void)sched_yield();
+            continue;
+        }
+
+        count = MIN(count, STRESS_COUNT - seq);
+        for (size_t i = 0; i < count; i++)
+        {
+            p_write[i].seq   = seq + i;
+            p_write[i].check = ~(seq + i);
+        }
+        HOST_TEST_ASSERT(nrf_queue_write_commit(&m_queue_spsc, count) == NRF_SUCCESS);
+        seq += count;
+    }
+
+    return NULL;
+}
+
+
+/**@brief Function for testing the SPSC mode with a producer and a consumer thread. */
+static void spsc_test(void)
+{
+    pthread_t thread;
+    uint32_t  seq = 0;
+
+    nrf_queue_reset(&m_queue_spsc);
+    HOST_TEST_ASSERT(pthread_create(&thread, NULL, spsc_producer, NULL) == 0);
+
+    while (seq < STRESS_COUNT)
+    {
+        size_t            count  = 1 + (seq % 7);
+        element_t const * p_read = nrf_queue_read_peek(&m_queue_spsc, &count);
+
+        if (count == 0)
+        {
+            (void)sched_yield();
+            continue;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            HOST_TEST_ASSERT(p_read[i].seq == seq + i);
+            HOST_TEST_ASSERT(p_read[i].check == (uint32_t)~(seq + i));
+        }
+        HOST_TEST_ASSERT(nrf_queue_read_consume(&m_queue_spsc, count) == NRF_SUCCESS);
+        seq += count;
+    }
+
+    HOST_TEST_ASSERT(pthread_join(thread, NULL) == 0);
+    HOST_TEST_ASSERT(nrf_queue_is_empty(&m_queue_spsc));
+    printf("SPSC with 2 threads, %lu elements: OK\n", STRESS_COUNT);
+}
+
+
+static void push_pop_bench(nrf_queue_t const * p_queue)
+{
+    element_t element = {0};
+
+    for (uint32_t i = 0; i < BENCH_COUNT; i++)
+    {
+        element.seq = i;
+        (void)nrf_queue_push(p_queue, &element);
+        (void)nrf_queue_pop(p_queue, &element);
+        m_sink += element.seq;
+    }
+}
+
+
+static void write_read_bench(nrf_queue_t const * p_queue)
+{
+    element_t elements[BURST] = {0};
+
+    for (uint32_t i = 0; i < BENCH_COUNT; i += BURST)
+    {
+        elements[0].seq = i;
+        (void)nrf_queue_write(p_queue, elements, BURST);
+        (void)nrf_queue_read(p_queue, elements, BURST);
+        m_sink += elements[0].seq;
+    }
+}
+
+
+static void reserve_peek_bench(nrf_queue_t const * p_queue)
+{
+    uint32_t i = 0;
+
+    while (i < BENCH_COUNT)
+    {
+        size_t      count   = BURST;
+        element_t * p_write = nrf_queue_write_reserve(p_queue, &count);
+
+        for (size_t k = 0; k < count; k++)
+        {
+            p_write[k].seq = i + k;
+        }
+        (void)nrf_queue_write_commit(p_queue, count);
+
+        count = BURST;
+        element_t const * p_read = nrf_queue_read_peek(p_queue, &count);
+
+        for (size_t k = 0; k < count; k++)
+        {
+            m_sink += p_read[k].seq;
+        }
+        (void)nrf_queue_read_consume(p_queue, count);
+        i += count;
+    }
+}
+
+
+/**@brief Function for running a benchmark on the queue of each mode. */
+static void bench_run(char const * p_name, void (* bench)(nrf_queue_t const * p_queue))
+{
+    static nrf_queue_t const * const queues[]     = {&m_queue, &m_queue_spsc};
+    static char const * const        mode_names[] = {"NO_OVERFLOW", "SPSC"};
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(queues); i++)
+    {
+        nrf_queue_reset(queues[i]);
+
+        uint64_t start = host_time_ns();
+        bench(queues[i]);
+        uint64_t duration = host_time_ns() - start;
+
+        printf("%-20s %-12s %6.2f ns/element\n",
+               p_name, mode_names[i], (double)duration / BENCH_COUNT);
+    }
+}
+
+
+int main(void)
+{
+    span_api_test();
+    spsc_test();
+
+    bench_run("push/pop", push_pop_bench);
+    bench_run("write/read x8", write_read_bench);
+    bench_run("reserve/peek x8", reserve_peek_bench);
+
+    return 0;
+}
@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Randomized stress test of the multi-producer mode of the ring buffer.
+ *
+ * Producer threads play the role of interrupts of different priorities. Each of them writes
+ * records of random length, randomly through @ref nrf_ringbuf_mp_cpy_put or through
+ * @ref nrf_ringbuf_mp_alloc and @ref nrf_ringbuf_mp_put, and sometimes yields while it holds a
+ * reservation. The consumer reads chunks of varying size and checks that:
+ * - the records of each producer arrive complete and in order,
+ * - the payload of every record is intact.
+ *
+ * The test is built with a consumer that uses @ref nrf_ringbuf_get and @ref nrf_ringbuf_free and
+ * with one that uses @ref nrf_ringbuf_cpy_get. The seed of the random generator can be given as
+ * the first argument, otherwise it is taken from the clock and printed.
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_ringbuf.h"
+#include "host_test.h"
+
+#ifndef CONSUMER_CPY_GET
+#define CONSUMER_CPY_GET 0      // Use nrf_ringbuf_cpy_get in the consumer.
+#endif
+
+#define PRODUCER_CNT        4       // Number of producer threads.
+#define RECORDS_PER_PRODUCER 200000 // Number of records written by each producer.
+#define RECORD_MIN_LEN      4       // Record header: length, producer, sequence number (2 bytes).
+#define RECORD_MAX_LEN      40
+
+NRF_RINGBUF_DEF(m_ringbuf, 256);
+
+static uint32_t          m_seed;
+static nrf_atomic_u32_t  m_retries;   // Allocations that failed because the buffer was full.
+
+
+/**@brief Function for filling a record. A length of 0 marks a padding byte. */
+static void record_fill(uint8_t * p_record, uint8_t len, uint8_t producer, uint16_t seq)
+{
+    p_record[0] = len;
+    p_record[1] = producer;
+    p_record[2] = (uint8_t)seq;
+    p_record[3] = (uint8_t)(seq >> 8);
+
+    for (uint32_t i = RECORD_MIN_LEN; i < len; i++)
+    {
+        p_record[i] = (uint8_t)(seq + producer + i);
+    }
+}
+
+
+static void * producer_thread(void * p_context)
+{
+    uint8_t  producer = (uint8_t)(uintptr_t)p_context;
+    uint32_t rand     = m_seed + producer;
+    uint32_t seq      = 0;
+
+    while (seq < RECORDS_PER_PRODUCER)
+    {
+        uint8_t len = RECORD_MIN_LEN + host_rand(&rand) % (RECORD_MAX_LEN - RECORD_MIN_LEN + 1);
+        uint8_t record[RECORD_MAX_LEN];
+
+        record_fill(record, len, producer, (uint16_t)seq);
+
+        if (host_rand(&rand) & 1)
+        {
+            if (nrf_ringbuf_mp_cpy_put(&m_ringbuf, record, len) == NRF_SUCCESS)
+            {
+                seq++;
+            }
+            else
+            {
+                UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_retries, 1));
+                (void)sched_yield();
+            }
+            continue;
+        }
+
+        uint8_t * p_data;
+        size_t    alloc_len = len;
+
+        if ((nrf_ringbuf_mp_alloc(&m_ringbuf, &p_data, &alloc_len) != NRF_SUCCESS) ||
+            (alloc_len == 0))
+        {
+            UNUSED_RETURN_VALUE(nrf_atomic_u32_add(&m_retries, 1));
+            (void)sched_yield();
+            continue;
+        }
+
+        if ((host_rand(&rand) % 4) == 0)
+        {
+            // Hold the reservation while other producers run.
+            (void)sched_yield();
+        }
+
+        if (alloc_len == len)
+        {
+            memcpy(p_data, record, len);
+            seq++;
+        }
+        else
+        {
+            // Only the tail of the buffer was available, fill it with padding.
+            memset(p_data, 0, alloc_len);
+        }
+        HOST_TEST_ASSERT(nrf_ringbuf_mp_put(&m_ringbuf) == NRF_SUCCESS);
+    }
+
+    return NULL;
+}
+
+
+/**@brief Function for reading a chunk of data from the ring buffer. */
+static size_t chunk_read(uint8_t * p_dst, size_t max_len)
+{
+    size_t len = max_len;
+
+#if CONSUMER_CPY_GET
+    HOST_TEST_ASSERT(nrf_ringbuf_cpy_get(&m_ringbuf, p_dst, &len) == NRF_SUCCESS);
+#else
+    uint8_t * p_data;
+
+    HOST_TEST_ASSERT(nrf_ringbuf_get(&m_ringbuf, &p_data, &len, true) == NRF_SUCCESS);
+    memcpy(p_dst, p_data, len);
+    HOST_TEST_ASSERT(nrf_ringbuf_free(&m_ringbuf, len) == NRF_SUCCESS);
+#endif
+
+    return len;
+}
+
+
+/**@brief Function for testing the single-threaded behavior of the multi-producer API. */
+static void mp_api_test(void)
+{
+    uint8_t   buf[300] = {0};
+    uint8_t * p_data;
+    uint8_t * p_data2;
+    size_t    len;
+    size_t    len2;
+
+    nrf_ringbuf_init(&m_ringbuf);
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_put(&m_ringbuf) == NRF_ERROR_INVALID_STATE);
+
+    // The whole buffer is reserved, data is not visible until it is committed.
+    len = sizeof(buf);
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_alloc(&m_ringbuf, &p_data, &len) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(len == 256);
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_cpy_put(&m_ringbuf, buf, 1) == NRF_ERROR_NO_MEM);
+    len = 1;
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_alloc(&m_ringbuf, &p_data, &len) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(len == 0);
+    HOST_TEST_ASSERT(chunk_read(buf, 16) == 0);
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_put(&m_ringbuf) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(chunk_read(buf, sizeof(buf)) == 256);
+
+    // A reservation committed before an earlier one stays hidden until the earlier one is done.
+    len  = 10;
+    len2 = 10;
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_alloc(&m_ringbuf, &p_data, &len) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_alloc(&m_ringbuf, &p_data2, &len2) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_put(&m_ringbuf) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(chunk_read(buf, 100) == 0);
+    HOST_TEST_ASSERT(nrf_ringbuf_mp_put(&m_ringbuf) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(chunk_read(buf, 100) == 20);
+
+    printf("multi-producer API: OK\n");
+}
+
+
+/**@brief Function for running the producers and checking the records in the consumer. */
+static void mp_stress_test(void)
+{
+    pthread_t thread[PRODUCER_CNT];
+    uint32_t  next_seq[PRODUCER_CNT] = {0};
+    uint8_t   pending[RECORD_MAX_LEN + 128];
+    size_t    pending_len = 0;
+    uint32_t  records     = 0;
+    uint32_t  reads       = 0;
+
+    nrf_ringbuf_init(&m_ringbuf);
+    for (uint32_t i = 0; i < PRODUCER_CNT; i++)
+    {
+        HOST_TEST_ASSERT(pthread_create(&thread[i], NULL, producer_thread, (void *)(uintptr_t)i) == 0);
+    }
+
+    while (records < PRODUCER_CNT * RECORDS_PER_PRODUCER)
+    {
+        size_t len = chunk_read(&pending[pending_len], 1 + (reads++ % 97));
+
+        if (len == 0)
+        {
+            (void)sched_yield();
+            continue;
+        }
+        pending_len += len;
+
+        size_t offset = 0;
+        while (offset < pending_len)
+        {
+            uint8_t const * p_record = &pending[offset];
+
+            if (p_record[0] == 0)
+            {
+                offset++;
+                continue;
+            }
+            if (pending_len - offset < p_record[0])
+            {
+                break;
+            }
+
+            uint8_t  producer = p_record[1];
+            uint16_t seq      = uint16_decode(&p_record[2]);
+
+            HOST_TEST_ASSERT(producer < PRODUCER_CNT);
+            HOST_TEST_ASSERT(seq == (uint16_t)next_seq[producer]);
+            for (uint32_t i = RECORD_MIN_LEN; i < p_record[0]; i++)
+            {
+                HOST_TEST_ASSERT(p_record[i] == (uint8_t)(seq + producer + i));
+            }
+
+            next_seq[producer]++;
+            records++;
+            offset += p_record[0];
+        }
+
+        memmove(pending, &pending[offset], pending_len - offset);
+        pending_len -= offset;
+    }
+
+    for (uint32_t i = 0; i < PRODUCER_CNT; i++)
+    {
+        HOST_TEST_ASSERT(pthread_join(thread[i], NULL) == 0);
+    }
+
+    printf("%u records from %u producers: OK (%u retries on full buffer)\n",
+           records, PRODUCER_CNT, m_retries);
+}
+
+
+int main(int argc, char * argv[])
+{
+    m_seed = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : (uint32_t)host_time_ns();
+    if (m_seed == 0)
+    {
+        m_seed = 1;
+    }
+    printf("seed %u\n", m_seed);
+
+    mp_api_test();
+    mp_stress_test();
+
+    return 0;
+}
@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the nrf_sample_log sample logger.
+ *
+ * The logger writes to a FAT volume created with f_mkfs in nrf_block_dev_ram, through the
+ * block device disk interface of FatFS. The app_timer counter is advanced by the test, so the
+ * synchronization interval is deterministic. Records carry a sequence number, and after each
+ * test the file is read back and must hold exactly the records that were accepted, in order.
+ *
+ * The short write test fills the volume, so that a burst is written only partly. The logger
+ * must report the error, keep the burst and write it again at the same file position once
+ * space is freed.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_sample_log.h"
+#include "nrf_block_dev_ram.h"
+#include "diskio_blkdev.h"
+#include "app_timer.h"
+#include "host_test.h"
+
+#define SECTOR_SIZE         512     // Sector size of the volume.
+#define VOLUME_SECTORS      512     // Sectors of the volume (256 kB).
+#define CLUSTER_SIZE        1024    // Cluster size of the volume.
+#define BURST_SIZE          4096    // Burst size of the logger.
+#define RING_SIZE           8192    // Ring buffer size of the logger.
+#define SYNC_INTERVAL_MS    10      // Synchronization interval of the logger.
+#define STREAM_RECORDS      8000    // Records of the stream test.
+#define RECORDS_PER_MS      40      // Records added between two calls of process.
+
+#define LOG_PATH            "LOG.BIN"
+#define FILL_PATH           "FILL.BIN"
+
+/**@brief Record added to the log. */
+typedef struct
+{
+    uint32_t seq;       // Sequence number.
+    uint32_t seq_inv;   // Inverted sequence number.
+} record_t;
+
+static uint32_t m_ram_buffer[VOLUME_SECTORS * SECTOR_SIZE / sizeof(uint32_t)];
+
+NRF_BLOCK_DEV_RAM_DEFINE(m_ram,
+                         NRF_BLOCK_DEV_RAM_CONFIG(SECTOR_SIZE, m_ram_buffer, sizeof(m_ram_buffer)),
+                         NFR_BLOCK_DEV_INFO_CONFIG("Nordic", "RAM", "1.00"));
+
+static diskio_blkdev_t m_drives[] =
+{
+    DISKIO_BLOCKDEV_CONFIG(NRF_BLOCKDEV_BASE_ADDR(m_ram, block_dev), NULL)
+};
+
+NRF_SAMPLE_LOG_DEF(m_log, RING_SIZE, BURST_SIZE);
+
+static FATFS    m_fs;
+static uint32_t m_ticks;    // app_timer counter.
+static uint32_t m_seq;      // Sequence number of the next record.
+
+
+uint32_t app_timer_cnt_get(void)
+{
+    return m_ticks & APP_TIMER_MAX_CNT_VAL;
+}
+
+
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from)
+{
+    return (ticks_to - ticks_from) & APP_TIMER_MAX_CNT_VAL;
+}
+
+
+/**@brief Function for creating and mounting an empty FAT volume. */
+static void volume_create(void)
+{
+    static uint8_t work[SECTOR_SIZE];
+
+    HOST_TEST_ASSERT(f_mount(NULL, "", 0) == FR_OK);
+    HOST_TEST_ASSERT(f_mkfs("", FM_FAT | FM_SFD, CLUSTER_SIZE, work, sizeof(work)) == FR_OK);
+    HOST_TEST_ASSERT(f_mount(&m_fs, "", 1) == FR_OK);
+}
+
+
+/**@brief Function for adding a number of records to the log.
+ *
+ * @return Number of records accepted.
+ */
+static uint32_t records_add(uint32_t count)
+{
+    uint32_t accepted = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        record_t record = { .seq = m_seq, .seq_inv = ~m_seq };
+
+        if (nrf_sample_log_write(&m_log, &record, sizeof(record)) == NRF_SUCCESS)
+        {
+            m_seq++;
+            accepted++;
+        }
+    }
+
+    return accepted;
+}
+
+
+/**@brief Function for checking that the log file holds the records 0 to count - 1. */
+static void log_file_check(uint32_t count)
+{
+    FIL      file;
+    record_t record;
+    UINT     read;
+
+    HOST_TEST_ASSERT(f_open(&file, LOG_PATH, FA_READ) == FR_OK);
+    HOST_TEST_ASSERT(f_size(&file) == count * sizeof(record_t));
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        HOST_TEST_ASSERT(f_read(&file, &record, sizeof(record), &read) == FR_OK);
+        HOST_TEST_ASSERT(read == sizeof(record));
+        HOST_TEST_ASSERT((record.seq == i) && (record.seq_inv == ~i));
+    }
+
+    HOST_TEST_ASSERT(f_close(&file) == FR_OK);
+}
+
+
+/**@brief Test of recording with bursts and synchronizations. */
+static void stream_test(void)
+{
+    nrf_sample_log_stats_t const * p_stats = nrf_sample_log_stats_get(&m_log);
+    uint32_t                       count   = 0;
+
+    volume_create();
+    m_seq = 0;
+
+    HOST_TEST_ASSERT(nrf_sample_log_process(&m_log) == NRF_ERROR_INVALID_STATE);
+    HOST_TEST_ASSERT(nrf_sample_log_open(&m_log, LOG_PATH, STREAM_RECORDS * sizeof(record_t),
+                                         SYNC_INTERVAL_MS) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_sample_log_open(&m_log, LOG_PATH, 0, SYNC_INTERVAL_MS)
+                     == NRF_ERROR_INVALID_STATE);
+
+    while (count < STREAM_RECORDS)
+    {
+        count += records_add(MIN(RECORDS_PER_MS, STREAM_RECORDS - count));
+        m_ticks += APP_TIMER_TICKS(1);
+        HOST_TEST_ASSERT(nrf_sample_log_process(&m_log) == NRF_SUCCESS);
+    }
+
+    HOST_TEST_ASSERT(p_stats->bursts == STREAM_RECORDS * sizeof(record_t) / BURST_SIZE);
+    HOST_TEST_ASSERT(p_stats->bytes_written == p_stats->bursts * BURST_SIZE);
+    HOST_TEST_ASSERT(p_stats->syncs > 0);
+    HOST_TEST_ASSERT((p_stats->dropped == 0) && (p_stats->ring_max < RING_SIZE));
+
+    HOST_TEST_ASSERT(nrf_sample_log_close(&m_log) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(nrf_sample_log_close(&m_log) == NRF_ERROR_INVALID_STATE);
+    HOST_TEST_ASSERT(p_stats->bytes_written == STREAM_RECORDS * sizeof(record_t));
+    log_file_check(STREAM_RECORDS);
+
+    printf("stream: %u bytes, %u bursts, %u syncs: OK\n",
+           (unsigned)p_stats->bytes_written, (unsigned)p_stats->bursts, (unsigned)p_stats->syncs);
+}
+
+
+/**@brief Test of records dropped when the ring buffer is full. */
+static void drop_test(void)
+{
+    nrf_sample_log_stats_t const * p_stats = nrf_sample_log_stats_get(&m_log);
+    uint32_t                       count;
+
+    volume_create();
+    m_seq = 0;
+
+    HOST_TEST_ASSERT(nrf_sample_log_open(&m_log, LOG_PATH, 0, SYNC_INTERVAL_MS) == NRF_SUCCESS);
+
+    count = records_add(RING_SIZE / sizeof(record_t) + 10);
+    HOST_TEST_ASSERT(count == RING_SIZE / sizeof(record_t));
+    HOST_TEST_ASSERT(p_stats->dropped == 10 * sizeof(record_t));
+    HOST_TEST_ASSERT(p_stats->ring_max == RING_SIZE);
+
+    // Processing frees space for new records.
+    HOST_TEST_ASSERT(nrf_sample_log_process(&m_log) == NRF_SUCCESS);
+    count += records_add(10);
+    HOST_TEST_ASSERT(count == RING_SIZE / sizeof(record_t) + 10);
+
+    HOST_TEST_ASSERT(nrf_sample_log_close(&m_log) == NRF_SUCCESS);
+    log_file_check(count);
+
+    printf("drops: %u bytes dropped: OK\n", (unsigned)p_stats->dropped);
+}
+
+
+/**@brief Test of a burst that is written only partly because the volume is full. */
+static void short_write_test(void)
+{
+    nrf_sample_log_stats_t const * p_stats = nrf_sample_log_stats_get(&m_log);
+    FATFS                        * p_fs;
+    FIL                            fill;
+    DWORD                          free_clusters;
+    uint32_t                       count;
+
+    volume_create();
+    m_seq = 0;
+
+    // Leave room for one and a half bursts.
+    HOST_TEST_ASSERT(f_getfree("", &free_clusters, &p_fs) == FR_OK);
+    HOST_TEST_ASSERT(f_open(&fill, FILL_PATH, FA_CREATE_ALWAYS | FA_WRITE) == FR_OK);
+    HOST_TEST_ASSERT(f_expand(&fill,
+                              (free_clusters * CLUSTER_SIZE) - (3 * BURST_SIZE / 2),
+                              1) == FR_OK);
+    HOST_TEST_ASSERT(f_close(&fill) == FR_OK);
+
+    HOST_TEST_ASSERT(nrf_sample_log_open(&m_log, LOG_PATH, 0, SYNC_INTERVAL_MS) == NRF_SUCCESS);
+
+    count = records_add(2 * BURST_SIZE / sizeof(record_t));
+    HOST_TEST_ASSERT(nrf_sample_log_process(&m_log) == NRF_ERROR_INTERNAL);
+
+    // The second burst is kept, and the file position is at its start.
+    HOST_TEST_ASSERT((p_stats->bursts == 1) && (p_stats->bytes_written == BURST_SIZE));
+    HOST_TEST_ASSERT(f_tell(&m_log.p_cb->file) == BURST_SIZE);
+    HOST_TEST_ASSERT(nrf_sample_log_process(&m_log) == NRF_ERROR_INTERNAL);
+    HOST_TEST_ASSERT(f_tell(&m_log.p_cb->file) == BURST_SIZE);
+
+    // Once space is freed, the burst is written where it belongs.
+    HOST_TEST_ASSERT(f_unlink(FILL_PATH) == FR_OK);
+    HOST_TEST_ASSERT(nrf_sample_log_process(&m_log) == NRF_SUCCESS);
+    HOST_TEST_ASSERT((p_stats->bursts == 2) && (p_stats->bytes_written == 2 * BURST_SIZE));
+
+    count += records_add(10);
+    HOST_TEST_ASSERT(nrf_sample_log_close(&m_log) == NRF_SUCCESS);
+    log_file_check(count);
+
+    printf("short write: OK\n");
+}
+
+
+int main(void)
+{
+    diskio_blockdev_register(m_drives, ARRAY_SIZE(m_drives));
+    HOST_TEST_ASSERT(disk_initialize(0) == 0);
+
+    stream_test();
+    drop_test();
+    short_write_test();
+
+    return 0;
+}
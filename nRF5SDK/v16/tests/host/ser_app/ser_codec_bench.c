@@ -0,0 +1,333 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Per-call benchmark of the serialization codecs on the application side.
+ *
+ * For a set of SoftDevice calls, the benchmark measures the encoding of the command by the
+ * application side. For a set of events, it measures the encoding by the connectivity side and
+ * the decoding by the application side, and checks that the decoded event matches the original.
+ * Calls with bulk data are measured with 20-byte and 244-byte payloads.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "ble.h"
+#include "ble_app.h"
+#include "ble_gap_app.h"
+#include "ble_gattc_app.h"
+#include "ble_gatts_app.h"
+#include "host_test.h"
+
+#define CALL_COUNT      200000      // Number of calls measured for each item.
+#define BUF_SIZE        1024        // Size of the packet buffers.
+#define EVT_BUF_WORDS   256         // Size of the event buffers, in words.
+
+/* Event encoder of the connectivity side, see ble_conn.h. The header is not included, as it
+ * depends on the connectivity configuration. */
+uint32_t ble_event_enc(ble_evt_t const * const p_event,
+                       uint32_t                event_len,
+                       uint8_t * const         p_buf,
+                       uint32_t * const        p_buf_len);
+
+static uint8_t  m_buf[BUF_SIZE];
+static uint32_t m_evt[EVT_BUF_WORDS];
+static uint32_t m_evt_dec[EVT_BUF_WORDS];
+
+/**@brief Macro for measuring the cost of a call that encodes into m_buf and returns the length
+ *        of the packet in len. */
+#define CODEC_BENCH(name, call)                                                             \
+    do                                                                                      \
+    {                                                                                       \
+        uint64_t start = host_time_ns();                                                    \
+        uint32_t len   = 0;                                                                 \
+        uint32_t i;                                                                         \
+        for (i = 0; i < CALL_COUNT; i++)                                                    \
+        {                                                                                   \
+            len = sizeof(m_buf);                                                            \
+            HOST_TEST_ASSERT((call) == NRF_SUCCESS);                                        \
+        }                                                                                   \
+        bench_print(name, len, host_time_ns() - start);                                     \
+    } while (0)
+
+static void bench_print(char const * p_name, uint32_t len, uint64_t time_ns)
+{
+    double ns_per_call = (double)time_ns / CALL_COUNT;
+
+    printf("%-40s %4u B %7.1f ns %7.1f MB/s\n",
+           p_name, len, ns_per_call, len * 1e3 / ns_per_call);
+}
+
+static void command_bench(void)
+{
+    static uint8_t adv[BLE_GAP_ADV_SET_DATA_SIZE_MAX] =
+    {
+        2, 1, 6, 3, 3, 0x0D, 0x18, 20, 9, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k',
+        'l', 'm', 'n', 'o', 'p', 'q', 'r', 's'
+    };
+    static uint8_t data[BLE_GATT_ATT_MTU_DEFAULT + 221];
+
+    uint8_t                  adv_handle = 0;
+    uint16_t                 len20      = 20;
+    uint16_t                 len244     = 244;
+    ble_gap_adv_data_t       adv_data   =
+    {
+        .adv_data      = {.p_data = adv, .len = sizeof(adv)},
+        .scan_rsp_data = {.p_data = adv, .len = 20},
+    };
+    ble_gap_adv_params_t     adv_params =
+    {
+        .properties    = {.type = BLE_GAP_ADV_TYPE_CONNECTABLE_SCANNABLE_UNDIRECTED},
+        .interval      = 64,
+        .primary_phy   = BLE_GAP_PHY_1MBPS,
+        .secondary_phy = BLE_GAP_PHY_1MBPS,
+    };
+    ble_gap_addr_t           addr       =
+    {
+        .addr_type = BLE_GAP_ADDR_TYPE_RANDOM_STATIC,
+        .addr      = {1, 2, 3, 4, 5, 6},
+    };
+    ble_gap_scan_params_t    scan_params =
+    {
+        .active    = 1,
+        .interval  = 100,
+        .window    = 50,
+        .scan_phys = BLE_GAP_PHY_1MBPS,
+    };
+    ble_gap_conn_params_t    conn_params =
+    {
+        .min_conn_interval = 6,
+        .max_conn_interval = 12,
+        .slave_latency     = 0,
+        .conn_sup_timeout  = 400,
+    };
+    ble_gap_sec_params_t     sec_params =
+    {
+        .bond         = 1,
+        .io_caps      = BLE_GAP_IO_CAPS_NONE,
+        .min_key_size = 7,
+        .max_key_size = 16,
+    };
+    ble_gatts_hvx_params_t   hvx20      =
+    {
+        .handle = 0x10, .type = BLE_GATT_HVX_NOTIFICATION, .p_len = &len20, .p_data = data
+    };
+    ble_gatts_hvx_params_t   hvx244     =
+    {
+        .handle = 0x10, .type = BLE_GATT_HVX_NOTIFICATION, .p_len = &len244, .p_data = data
+    };
+    ble_gattc_write_params_t write20    =
+    {
+        .write_op = BLE_GATT_OP_WRITE_CMD, .handle = 0x12, .len = 20, .p_value = data
+    };
+    ble_gattc_write_params_t write244   =
+    {
+        .write_op = BLE_GATT_OP_WRITE_CMD, .handle = 0x12, .len = 244, .p_value = data
+    };
+    ble_uuid_t               uuid       = {.uuid = 0x2A37, .type = BLE_UUID_TYPE_BLE};
+    ble_gatts_char_md_t      char_md    = {.char_props = {.read = 1, .notify = 1}};
+    ble_gatts_attr_md_t      attr_md    =
+    {
+        .read_perm  = {.sm = 1, .lv = 1},
+        .write_perm = {.sm = 1, .lv = 1},
+        .vloc       = BLE_GATTS_VLOC_STACK,
+    };
+    ble_gatts_attr_t         attr       =
+    {
+        .p_uuid    = &uuid,
+        .p_attr_md = &attr_md,
+        .init_len  = 20,
+        .max_len   = 244,
+        .p_value   = data,
+    };
+    ble_gatts_char_handles_t handles;
+
+    memset(data, 0x5A, sizeof(data));
+
+    printf("commands (application encoder)\n");
+    CODEC_BENCH("sd_ble_gap_adv_set_configure",
+                ble_gap_adv_set_configure_req_enc(&adv_handle, &adv_data, &adv_params,
+                                                  m_buf, &len));
+    CODEC_BENCH("sd_ble_gap_connect",
+                ble_gap_connect_req_enc(&addr, &scan_params, &conn_params, 1, m_buf, &len));
+    CODEC_BENCH("sd_ble_gap_conn_param_update",
+                ble_gap_conn_param_update_req_enc(0, &conn_params, m_buf, &len));
+    CODEC_BENCH("sd_ble_gap_sec_params_reply",
+                ble_gap_sec_params_reply_req_enc(0, BLE_GAP_SEC_STATUS_SUCCESS, &sec_params,
+                                                 NULL, m_buf, &len));
+    CODEC_BENCH("sd_ble_gatts_hvx (20 B)", ble_gatts_hvx_req_enc(0, &hvx20, m_buf, &len));
+    CODEC_BENCH("sd_ble_gatts_hvx (244 B)", ble_gatts_hvx_req_enc(0, &hvx244, m_buf, &len));
+    CODEC_BENCH("sd_ble_gattc_write (20 B)", ble_gattc_write_req_enc(0, &write20, m_buf, &len));
+    CODEC_BENCH("sd_ble_gattc_write (244 B)",
+                ble_gattc_write_req_enc(0, &write244, m_buf, &len));
+    CODEC_BENCH("sd_ble_gatts_characteristic_add",
+                ble_gatts_characteristic_add_req_enc(1, &char_md, &attr, &handles, m_buf, &len));
+}
+
+/**@brief Function for measuring the encoding and decoding of the event in m_evt. */
+static void event_bench(char const * p_name, uint32_t evt_len)
+{
+    static uint8_t    packet[BUF_SIZE];
+    ble_evt_t const * p_evt     = (ble_evt_t *)m_evt;
+    ble_evt_t const * p_evt_dec = (ble_evt_t *)m_evt_dec;
+    char              name[64];
+    uint32_t          packet_len = sizeof(packet);
+    uint32_t          dec_len;
+
+    HOST_TEST_ASSERT(ble_event_enc((ble_evt_t *)m_evt, evt_len, packet, &packet_len)
+                     == NRF_SUCCESS);
+
+    // The decoded event must match the original.
+    memset(m_evt_dec, 0, sizeof(m_evt_dec));
+    dec_len = sizeof(m_evt_dec);
+    HOST_TEST_ASSERT(ble_event_dec(packet, packet_len, (ble_evt_t *)m_evt_dec, &dec_len)
+                     == NRF_SUCCESS);
+    HOST_TEST_ASSERT(dec_len <= evt_len);
+    HOST_TEST_ASSERT(memcmp(&p_evt_dec->evt, &p_evt->evt, dec_len - sizeof(ble_evt_hdr_t)) == 0);
+
+    (void)snprintf(name, sizeof(name), "%s enc", p_name);
+    CODEC_BENCH(name, ble_event_enc((ble_evt_t *)m_evt, evt_len, m_buf, &len));
+
+    (void)snprintf(name, sizeof(name), "%s dec", p_name);
+    CODEC_BENCH(name, (len = packet_len,
+                       dec_len = sizeof(m_evt_dec),
+                       ble_event_dec(packet, packet_len, (ble_evt_t *)m_evt_dec, &dec_len)));
+}
+
+/**@brief Function for preparing an event of the given type in m_evt. */
+static ble_evt_t * event_prepare(uint16_t evt_id)
+{
+    ble_evt_t * p_evt = (ble_evt_t *)m_evt;
+
+    memset(m_evt, 0, sizeof(m_evt));
+    p_evt->header.evt_id = evt_id;
+    return p_evt;
+}
+
+static void events_bench(void)
+{
+    ble_gap_conn_params_t conn_params =
+    {
+        .min_conn_interval = 6,
+        .max_conn_interval = 12,
+        .slave_latency     = 0,
+        .conn_sup_timeout  = 400,
+    };
+    ble_evt_t *           p_evt;
+    uint32_t              i;
+
+    printf("events (connectivity encoder / application decoder)\n");
+
+    p_evt = event_prepare(BLE_GAP_EVT_CONNECTED);
+    p_evt->evt.gap_evt.params.connected.conn_params = conn_params;
+    event_bench("BLE_GAP_EVT_CONNECTED", sizeof(ble_evt_t));
+
+    p_evt = event_prepare(BLE_GAP_EVT_DISCONNECTED);
+    p_evt->evt.gap_evt.params.disconnected.reason = BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION;
+    event_bench("BLE_GAP_EVT_DISCONNECTED", sizeof(ble_evt_t));
+
+    p_evt = event_prepare(BLE_GAP_EVT_CONN_PARAM_UPDATE);
+    p_evt->evt.gap_evt.params.conn_param_update.conn_params = conn_params;
+    event_bench("BLE_GAP_EVT_CONN_PARAM_UPDATE", sizeof(ble_evt_t));
+
+    p_evt = event_prepare(BLE_GAP_EVT_SEC_PARAMS_REQUEST);
+    p_evt->evt.gap_evt.params.sec_params_request.peer_params.bond         = 1;
+    p_evt->evt.gap_evt.params.sec_params_request.peer_params.min_key_size = 7;
+    p_evt->evt.gap_evt.params.sec_params_request.peer_params.max_key_size = 16;
+    event_bench("BLE_GAP_EVT_SEC_PARAMS_REQUEST", sizeof(ble_evt_t));
+
+    p_evt = event_prepare(BLE_GATTS_EVT_WRITE);
+    p_evt->evt.gatts_evt.params.write.len = 20;
+    memset(p_evt->evt.gatts_evt.params.write.data, 0x01, 20);
+    event_bench("BLE_GATTS_EVT_WRITE (20 B)", sizeof(ble_evt_t) + 20);
+
+    p_evt = event_prepare(BLE_GATTS_EVT_WRITE);
+    p_evt->evt.gatts_evt.params.write.len = 244;
+    memset(p_evt->evt.gatts_evt.params.write.data, 0x01, 244);
+    event_bench("BLE_GATTS_EVT_WRITE (244 B)", sizeof(ble_evt_t) + 244);
+
+    p_evt = event_prepare(BLE_GATTC_EVT_HVX);
+    p_evt->evt.gattc_evt.params.hvx.len = 20;
+    memset(p_evt->evt.gattc_evt.params.hvx.data, 0x02, 20);
+    event_bench("BLE_GATTC_EVT_HVX (20 B)", sizeof(ble_evt_t) + 20);
+
+    p_evt = event_prepare(BLE_GATTC_EVT_HVX);
+    p_evt->evt.gattc_evt.params.hvx.len = 244;
+    memset(p_evt->evt.gattc_evt.params.hvx.data, 0x02, 244);
+    event_bench("BLE_GATTC_EVT_HVX (244 B)", sizeof(ble_evt_t) + 244);
+
+    p_evt = event_prepare(BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP);
+    p_evt->evt.gattc_evt.params.prim_srvc_disc_rsp.count = 8;
+    for (i = 0; i < 8; i++)
+    {
+        p_evt->evt.gattc_evt.params.prim_srvc_disc_rsp.services[i].uuid.uuid = 0x1800 + i;
+        p_evt->evt.gattc_evt.params.prim_srvc_disc_rsp.services[i].uuid.type = BLE_UUID_TYPE_BLE;
+    }
+    event_bench("BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP (8)",
+                sizeof(ble_evt_t) + 8 * sizeof(ble_gattc_service_t));
+
+    p_evt = event_prepare(BLE_GATTC_EVT_CHAR_DISC_RSP);
+    p_evt->evt.gattc_evt.params.char_disc_rsp.count = 8;
+    for (i = 0; i < 8; i++)
+    {
+        p_evt->evt.gattc_evt.params.char_disc_rsp.chars[i].uuid.uuid     = 0x2A00 + i;
+        p_evt->evt.gattc_evt.params.char_disc_rsp.chars[i].uuid.type     = BLE_UUID_TYPE_BLE;
+        p_evt->evt.gattc_evt.params.char_disc_rsp.chars[i].handle_decl   = 2 * i + 1;
+        p_evt->evt.gattc_evt.params.char_disc_rsp.chars[i].handle_value  = 2 * i + 2;
+    }
+    event_bench("BLE_GATTC_EVT_CHAR_DISC_RSP (8)",
+                sizeof(ble_evt_t) + 8 * sizeof(ble_gattc_char_t));
+
+    p_evt = event_prepare(BLE_GATTC_EVT_DESC_DISC_RSP);
+    p_evt->evt.gattc_evt.params.desc_disc_rsp.count = 8;
+    for (i = 0; i < 8; i++)
+    {
+        p_evt->evt.gattc_evt.params.desc_disc_rsp.descs[i].handle    = i + 1;
+        p_evt->evt.gattc_evt.params.desc_disc_rsp.descs[i].uuid.uuid = 0x2900 + i;
+        p_evt->evt.gattc_evt.params.desc_disc_rsp.descs[i].uuid.type = BLE_UUID_TYPE_BLE;
+    }
+    event_bench("BLE_GATTC_EVT_DESC_DISC_RSP (8)",
+                sizeof(ble_evt_t) + 8 * sizeof(ble_gattc_desc_t));
+}
+
+int main(void)
+{
+    command_bench();
+    events_bench();
+    return 0;
+}
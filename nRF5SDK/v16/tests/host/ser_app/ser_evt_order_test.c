@@ -0,0 +1,328 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the order of the events received by the serialization application side.
+ *
+ * The application side runs on one end of a pseudo-terminal, through the SoftDevice handler,
+ * SoftDevice transport, POSIX HAL and POSIX UART PHY. A forked peer plays the connectivity chip
+ * on the other end. Before it answers the n-th command, it sends n % (MAX_EVTS_PER_CMD + 1)
+ * BLE_GATTS_EVT_WRITE events of varying length, numbered in the handle and the data.
+ *
+ * The main loop fetches the events with sd_ble_evt_get, as with the scheduler dispatch model,
+ * and checks that they come in order and intact. For every EVT_CALL_INTERVAL-th event, it makes
+ * a SoftDevice call while the next events are still waiting, so that the response must be
+ * received while event packets occupy the RX buffers. The test is built with
+ * SER_HAL_TRANSPORT_RX_BUF_COUNT of 1 and 4, which covers the events that are decoded on
+ * reception and the ones that stay in their RX buffers. A deadlock fails the test on a timeout.
+ */
+#define _GNU_SOURCE
+#include <string.h>
+#include "sdk_common.h"
+#include "ble.h"
+#include "nrf_sdm.h"
+#include "nrf_soc.h"
+#include "ble_serialization.h"
+#include "ser_config.h"
+#include "ser_softdevice_handler.h"
+#include "ser_phy_posix.h"
+#include "host_test.h"
+// The system headers go last, see ser_phy_uart_posix.c.
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define CMD_COUNT           3000    // Number of commands sent by the main loop.
+#define MAX_EVTS_PER_CMD    3       // Largest number of events sent before a response.
+#define EVT_CALL_INTERVAL   4       // Every EVT_CALL_INTERVAL-th event makes a SoftDevice call.
+#define EVT_DATA_MIN        4       // Shortest write data: the event number, then a pattern.
+#define EVT_DATA_MAX        (NRF_SDH_BLE_GATT_MAX_MTU_SIZE - 3) // Longest write data for the MTU.
+#define EVT_BUF_WORDS       128     // Size of the event buffer, in words.
+#define PEER_BUF_SIZE       4096
+#define TIMEOUT_S           60      // The test is stopped by SIGALRM after this time.
+
+/* Event encoder of the connectivity side, see ble_conn.h. The header is not included, as it
+ * depends on the connectivity configuration. */
+uint32_t ble_event_enc(ble_evt_t const * const p_event,
+                       uint32_t                event_len,
+                       uint8_t * const         p_buf,
+                       uint32_t * const        p_buf_len);
+
+static uint32_t m_cmd_cnt;          // Commands sent, by the main loop and the event handler.
+static uint32_t m_evt_expected;     // Events the peer sends before the responses to them.
+static uint32_t m_evt_cnt;          // Events received in order.
+static uint32_t m_evt_call_cnt;     // SoftDevice calls made by the event handler.
+static uint32_t m_pending_max;      // Largest number of events waiting in the mailbox.
+static uint32_t m_evt_irq_cnt;      // SoftDevice event interrupts.
+
+
+/**@brief Function for the number of events the peer sends before the response to a command. */
+static uint32_t evts_per_cmd(uint32_t cmd_idx)
+{
+    return cmd_idx % (MAX_EVTS_PER_CMD + 1);
+}
+
+
+/**@brief Function for the length of the write data of an event. */
+static uint16_t evt_data_len(uint32_t evt_idx)
+{
+    return EVT_DATA_MIN + (evt_idx % (EVT_DATA_MAX - EVT_DATA_MIN + 1));
+}
+
+
+/**@brief Function for the pattern byte of the write data of an event. */
+static uint8_t evt_data_byte(uint32_t evt_idx, uint16_t pos)
+{
+    return (uint8_t)(evt_idx * 7 + pos);
+}
+
+
+/**@brief Function for writing a whole frame to the pseudo-terminal. */
+static void peer_write(int fd, uint8_t const * p_frame, uint16_t len)
+{
+    uint16_t done = 0;
+
+    while (done < len)
+    {
+        ssize_t written = write(fd, &p_frame[done], len - done);
+
+        HOST_TEST_ASSERT(written > 0);
+        done += (uint16_t)written;
+    }
+}
+
+
+/**@brief Function for sending the event with the given number from the peer. */
+static void peer_evt_send(int fd, uint32_t evt_idx)
+{
+    static uint32_t evt[EVT_BUF_WORDS];
+    static uint8_t  frame[SER_PHY_HEADER_SIZE + SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE];
+
+    ble_evt_t             * p_evt   = (ble_evt_t *)evt;
+    ble_gatts_evt_write_t * p_write = &p_evt->evt.gatts_evt.params.write;
+    uint32_t                pkt_len = sizeof(frame) - SER_PHY_HEADER_SIZE - SER_PKT_TYPE_SIZE;
+
+    memset(evt, 0, sizeof(evt));
+    p_evt->header.evt_id = BLE_GATTS_EVT_WRITE;
+    p_write->handle      = (uint16_t)evt_idx;
+    p_write->op          = BLE_GATTS_OP_WRITE_CMD;
+    p_write->len         = evt_data_len(evt_idx);
+    (void)uint32_encode(evt_idx, p_write->data);
+    for (uint16_t i = sizeof(uint32_t); i < p_write->len; i++)
+    {
+        p_write->data[i] = evt_data_byte(evt_idx, i);
+    }
+
+    HOST_TEST_ASSERT(ble_event_enc(p_evt,
+                                   sizeof(ble_evt_t) + p_write->len,
+                                   &frame[SER_PHY_HEADER_SIZE + SER_PKT_TYPE_SIZE],
+                                   &pkt_len) == NRF_SUCCESS);
+    frame[SER_PHY_HEADER_SIZE] = SER_PKT_TYPE_EVT;
+    pkt_len += SER_PKT_TYPE_SIZE;
+    (void)uint16_encode((uint16_t)pkt_len, frame);
+
+    peer_write(fd, frame, SER_PHY_HEADER_SIZE + pkt_len);
+}
+
+
+/**@brief Function for playing the connectivity chip on the peer side of the pseudo-terminal. */
+static void peer_run(int fd)
+{
+    static uint8_t buf[PEER_BUF_SIZE];
+    uint16_t       len     = 0;
+    uint32_t       cmd_cnt = 0;
+    uint32_t       evt_cnt = 0;
+
+    for (;;)
+    {
+        ssize_t n = read(fd, &buf[len], sizeof(buf) - len);
+
+        if (n <= 0)
+        {
+            _exit(0);
+        }
+        len += (uint16_t)n;
+
+        // Answer the complete commands, each after its events: packet type, op code, result code.
+        while (len >= SER_PHY_HEADER_SIZE)
+        {
+            uint16_t frame_len = SER_PHY_HEADER_SIZE + uint16_decode(buf);
+            uint8_t  rsp[SER_PHY_HEADER_SIZE + 6];
+
+            if (len < frame_len)
+            {
+                break;
+            }
+            HOST_TEST_ASSERT(buf[SER_PHY_HEADER_SIZE] == SER_PKT_TYPE_CMD);
+
+            for (uint32_t i = 0; i < evts_per_cmd(cmd_cnt); i++)
+            {
+                peer_evt_send(fd, evt_cnt++);
+            }
+            cmd_cnt++;
+
+            (void)uint16_encode(6, rsp);
+            rsp[SER_PHY_HEADER_SIZE]     = SER_PKT_TYPE_RESP;
+            rsp[SER_PHY_HEADER_SIZE + 1] = buf[SER_PHY_HEADER_SIZE + 1];
+            (void)uint32_encode(NRF_SUCCESS, &rsp[SER_PHY_HEADER_SIZE + 2]);
+            peer_write(fd, rsp, sizeof(rsp));
+
+            memmove(buf, &buf[frame_len], len - frame_len);
+            len -= frame_len;
+        }
+    }
+}
+
+
+/**@brief Function for making a SoftDevice call. The peer answers it after its events. */
+static void sd_call(void)
+{
+    m_evt_expected += evts_per_cmd(m_cmd_cnt);
+    m_cmd_cnt++;
+    HOST_TEST_ASSERT(sd_ble_gatts_sys_attr_set(0, NULL, 0, 0) == NRF_SUCCESS);
+}
+
+
+/**@brief Function for checking that an event is the next one and intact. */
+static void evt_check(ble_evt_t const * p_evt, uint16_t len)
+{
+    ble_gatts_evt_write_t const * p_write = &p_evt->evt.gatts_evt.params.write;
+
+    HOST_TEST_ASSERT(p_evt->header.evt_id == BLE_GATTS_EVT_WRITE);
+    HOST_TEST_ASSERT(len == p_evt->header.evt_len);
+    HOST_TEST_ASSERT(p_write->handle == (uint16_t)m_evt_cnt);
+    HOST_TEST_ASSERT(p_write->len == evt_data_len(m_evt_cnt));
+    HOST_TEST_ASSERT(uint32_decode(p_write->data) == m_evt_cnt);
+    for (uint16_t i = sizeof(uint32_t); i < p_write->len; i++)
+    {
+        HOST_TEST_ASSERT(p_write->data[i] == evt_data_byte(m_evt_cnt, i));
+    }
+    m_evt_cnt++;
+}
+
+
+/**@brief Function for the SoftDevice event interrupt, called from sd_app_evt_wait. As with
+ *        NRF_SDH_DISPATCH_MODEL_APPSH, the events are fetched later, from the main loop. */
+void SD_EVT_IRQHandler(void)
+{
+    m_evt_irq_cnt++;
+}
+
+
+/**@brief Function for fetching the events and handling them in the main loop. */
+static void evts_fetch(void)
+{
+    static uint32_t evt[EVT_BUF_WORDS];
+    uint32_t        pending;
+    uint16_t        len = sizeof(evt);
+
+    HOST_TEST_ASSERT(sd_ble_evt_mailbox_length_get(&pending) == NRF_SUCCESS);
+    m_pending_max = MAX(m_pending_max, pending);
+
+    while (sd_ble_evt_get((uint8_t *)evt, &len) == NRF_SUCCESS)
+    {
+        evt_check((ble_evt_t *)evt, len);
+        len = sizeof(evt);
+
+        // The call is made while the next events are still waiting in the mailbox.
+        if ((m_evt_cnt % EVT_CALL_INTERVAL) == 0)
+        {
+            sd_call();
+            m_evt_call_cnt++;
+
+            HOST_TEST_ASSERT(sd_ble_evt_mailbox_length_get(&pending) == NRF_SUCCESS);
+            m_pending_max = MAX(m_pending_max, pending);
+        }
+    }
+}
+
+
+int main(void)
+{
+    struct termios tty;
+    pid_t          peer_pid;
+    int            peer_fd;
+
+    (void)alarm(TIMEOUT_S);
+
+    peer_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    HOST_TEST_ASSERT(peer_fd >= 0);
+    HOST_TEST_ASSERT((grantpt(peer_fd) == 0) && (unlockpt(peer_fd) == 0));
+    HOST_TEST_ASSERT(tcgetattr(peer_fd, &tty) == 0);
+    cfmakeraw(&tty);
+    HOST_TEST_ASSERT(tcsetattr(peer_fd, TCSANOW, &tty) == 0);
+
+    // Flush before forking, so that the output is not duplicated.
+    (void)fflush(stdout);
+    peer_pid = fork();
+    HOST_TEST_ASSERT(peer_pid >= 0);
+    if (peer_pid == 0)
+    {
+        peer_run(peer_fd);
+    }
+
+    HOST_TEST_ASSERT(ser_phy_posix_device_set(ptsname(peer_fd)) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(sd_softdevice_enable(NULL, NULL) == NRF_SUCCESS);
+
+    for (uint32_t i = 0; i < CMD_COUNT; i++)
+    {
+        sd_call();
+
+        // Fetch the events, including those of the calls made while handling them.
+        evts_fetch();
+        while (m_evt_cnt < m_evt_expected)
+        {
+            (void)sd_app_evt_wait();
+            evts_fetch();
+        }
+    }
+
+    printf("%u RX buffers: %u events in order, %u calls from the handler, "
+           "up to %u events waiting: OK\n",
+           SER_HAL_TRANSPORT_RX_BUF_COUNT, m_evt_cnt, m_evt_call_cnt, m_pending_max);
+    HOST_TEST_ASSERT((m_evt_call_cnt > 0) && (m_evt_irq_cnt > 0));
+
+    (void)kill(peer_pid, SIGKILL);
+    (void)waitpid(peer_pid, NULL, 0);
+
+    return 0;
+}
@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Notification throughput of the serialization application side, with and without
+ *        pipelining of SoftDevice calls.
+ *
+ * The application side runs on one end of a pseudo-terminal, through the middleware, codecs,
+ * SoftDevice transport, POSIX HAL and POSIX UART PHY. A forked peer plays the connectivity chip
+ * on the other end. It answers every command a fixed latency after the command arrived, and
+ * accepts further commands meanwhile, so the latency models the link and not the processing
+ * time of the chip. Every 1000th command fails with NRF_ERROR_RESOURCES.
+ *
+ * For each latency, NOTIF_COUNT 20-byte notifications are sent with sd_ble_gatts_hvx, first
+ * with blocking calls and then pipelined. The number of failures reported must be the same in
+ * both modes. The test is built for SER_SD_TRANSPORT_PIPELINE_DEPTH of 1, 4 and 8.
+ */
+#define _GNU_SOURCE
+#include <string.h>
+#include "sdk_common.h"
+#include "ble.h"
+#include "nrf_sdm.h"
+#include "nrf_soc.h"
+#include "ble_serialization.h"
+#include "ser_config.h"
+#include "ser_sd_transport.h"
+#include "ser_phy_posix.h"
+#include "host_test.h"
+// The system headers go last, see ser_phy_uart_posix.c.
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define NOTIF_COUNT         2000    // Number of notifications sent in each run.
+#define FAIL_INTERVAL       1000    // Every FAIL_INTERVAL-th command fails.
+#define NOTIF_LEN           20      // Length of the notifications.
+#define PEER_BUF_SIZE       8192
+#define PEER_CMD_COUNT      4096    // Maximum number of commands waiting for their responses.
+
+static uint32_t const m_latencies_us[] = {0, 200, 1000};
+
+static uint32_t m_pipeline_fail_cnt;
+
+/**@brief Function for the SoftDevice events. The peer sends none. */
+void SD_EVT_IRQHandler(void)
+{
+}
+
+/**@brief Function for playing the connectivity chip on the peer side of the pseudo-terminal. */
+static void peer_run(int fd, uint32_t latency_us)
+{
+    static uint8_t  buf[PEER_BUF_SIZE];
+    static uint64_t due_ns[PEER_CMD_COUNT];
+    static uint8_t  op_code[PEER_CMD_COUNT];
+    uint16_t        len     = 0;
+    uint32_t        in      = 0;
+    uint32_t        out     = 0;
+    uint32_t        cmd_cnt = 0;
+
+    for (;;)
+    {
+        struct pollfd     pfd = {.fd = fd, .events = POLLIN};
+        struct timespec   timeout;
+        struct timespec * p_timeout = NULL;
+
+        if (in != out)
+        {
+            uint64_t now = host_time_ns();
+            uint64_t due = due_ns[out % PEER_CMD_COUNT];
+            uint64_t wait_ns = (due > now) ? (due - now) : 0;
+
+            timeout.tv_sec  = (time_t)(wait_ns / 1000000000ULL);
+            timeout.tv_nsec = (long)(wait_ns % 1000000000ULL);
+            p_timeout       = &timeout;
+        }
+        (void)ppoll(&pfd, 1, p_timeout, NULL);
+
+        if (pfd.revents & POLLIN)
+        {
+            ssize_t n = read(fd, &buf[len], sizeof(buf) - len);
+            if (n > 0)
+            {
+                len += (uint16_t)n;
+            }
+        }
+        else if (pfd.revents & (POLLHUP | POLLERR))
+        {
+            _exit(0);
+        }
+
+        // Queue the complete commands: header, packet type, op code, parameters.
+        while (len >= SER_PHY_HEADER_SIZE)
+        {
+            uint16_t frame_len = SER_PHY_HEADER_SIZE + uint16_decode(buf);
+
+            if (len < frame_len)
+            {
+                break;
+            }
+            HOST_TEST_ASSERT(buf[SER_PHY_HEADER_SIZE] == SER_PKT_TYPE_CMD);
+            HOST_TEST_ASSERT(in - out < PEER_CMD_COUNT);
+            op_code[in % PEER_CMD_COUNT] = buf[SER_PHY_HEADER_SIZE + 1];
+            due_ns[in % PEER_CMD_COUNT]  = host_time_ns() + latency_us * 1000ULL;
+            in++;
+            memmove(buf, &buf[frame_len], len - frame_len);
+            len -= frame_len;
+        }
+
+        // Answer the commands that are due: packet type, op code, result code and, for
+        // a successful notification, the number of bytes written.
+        while ((in != out) && (due_ns[out % PEER_CMD_COUNT] <= host_time_ns()))
+        {
+            uint8_t  rsp[SER_PHY_HEADER_SIZE + 9];
+            uint16_t rsp_len = 6;
+            uint32_t result  = ((++cmd_cnt % FAIL_INTERVAL) == 0) ? NRF_ERROR_RESOURCES :
+                                                                     NRF_SUCCESS;
+
+            rsp[SER_PHY_HEADER_SIZE]     = SER_PKT_TYPE_RESP;
+            rsp[SER_PHY_HEADER_SIZE + 1] = op_code[out % PEER_CMD_COUNT];
+            (void)uint32_encode(result, &rsp[SER_PHY_HEADER_SIZE + 2]);
+            if ((result == NRF_SUCCESS) && (op_code[out % PEER_CMD_COUNT] == SD_BLE_GATTS_HVX))
+            {
+                rsp[SER_PHY_HEADER_SIZE + 6] = SER_FIELD_PRESENT;
+                (void)uint16_encode(NOTIF_LEN, &rsp[SER_PHY_HEADER_SIZE + 7]);
+                rsp_len = 9;
+            }
+            (void)uint16_encode(rsp_len, rsp);
+            HOST_TEST_ASSERT(write(fd, rsp, SER_PHY_HEADER_SIZE + rsp_len) ==
+                             SER_PHY_HEADER_SIZE + rsp_len);
+            out++;
+        }
+    }
+}
+
+static void pipeline_err_handler(uint8_t op_code, uint32_t result_code)
+{
+    HOST_TEST_ASSERT(op_code == SD_BLE_GATTS_HVX);
+    HOST_TEST_ASSERT(result_code == NRF_ERROR_RESOURCES);
+    m_pipeline_fail_cnt++;
+}
+
+/**@brief Function for sending the notifications and printing their rate. Runs in its own
+ *        process, so that every run starts with the serialization modules in reset state. */
+static void bench_run(uint32_t latency_us, bool pipelined)
+{
+    static uint8_t         data[NOTIF_LEN];
+    struct termios         tty;
+    uint16_t               len;
+    uint32_t               fail_cnt = 0;
+    uint64_t               start;
+    uint32_t               i;
+    pid_t                  peer_pid;
+    int                    peer_fd;
+    ble_gatts_hvx_params_t hvx_params =
+    {
+        .handle = 0x10,
+        .type   = BLE_GATT_HVX_NOTIFICATION,
+        .offset = 0,
+        .p_len  = &len,
+        .p_data = data,
+    };
+
+    peer_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    HOST_TEST_ASSERT(peer_fd >= 0);
+    HOST_TEST_ASSERT((grantpt(peer_fd) == 0) && (unlockpt(peer_fd) == 0));
+    HOST_TEST_ASSERT(tcgetattr(peer_fd, &tty) == 0);
+    cfmakeraw(&tty);
+    HOST_TEST_ASSERT(tcsetattr(peer_fd, TCSANOW, &tty) == 0);
+
+    peer_pid = fork();
+    HOST_TEST_ASSERT(peer_pid >= 0);
+    if (peer_pid == 0)
+    {
+        peer_run(peer_fd, latency_us);
+    }
+
+    HOST_TEST_ASSERT(ser_phy_posix_device_set(ptsname(peer_fd)) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(sd_softdevice_enable(NULL, NULL) == NRF_SUCCESS);
+    if (pipelined)
+    {
+        HOST_TEST_ASSERT(ser_sd_transport_pipeline_enable(pipeline_err_handler) == NRF_SUCCESS);
+    }
+
+    start = host_time_ns();
+    for (i = 0; i < NOTIF_COUNT; i++)
+    {
+        uint32_t err_code;
+
+        len     = NOTIF_LEN;
+        data[0] = (uint8_t)i;
+        err_code = sd_ble_gatts_hvx(0, &hvx_params);
+        if (err_code == NRF_ERROR_RESOURCES)
+        {
+            fail_cnt++;
+        }
+        else
+        {
+            HOST_TEST_ASSERT(err_code == NRF_SUCCESS);
+        }
+    }
+    // A blocking call returns after the responses of all pipelined calls have been handled.
+    HOST_TEST_ASSERT(sd_ble_gatts_sys_attr_set(0, NULL, 0, 0) == NRF_SUCCESS);
+
+    printf("%4u us latency, %-9s %8.0f notifications/s\n",
+           latency_us,
+           pipelined ? "pipelined" : "blocking",
+           NOTIF_COUNT * 1e9 / (double)(host_time_ns() - start));
+    HOST_TEST_ASSERT(fail_cnt + m_pipeline_fail_cnt == NOTIF_COUNT / FAIL_INTERVAL);
+
+    (void)kill(peer_pid, SIGKILL);
+    (void)waitpid(peer_pid, NULL, 0);
+}
+
+int main(void)
+{
+    uint32_t i;
+    uint32_t k;
+
+    printf("pipeline depth %u, %u notifications of %u bytes\n",
+           SER_SD_TRANSPORT_PIPELINE_DEPTH, NOTIF_COUNT, NOTIF_LEN);
+
+    for (i = 0; i < ARRAY_SIZE(m_latencies_us); i++)
+    {
+        for (k = 0; k < 2; k++)
+        {
+            pid_t pid;
+            int   status;
+
+            // Flush before forking, so that the output is not duplicated.
+            (void)fflush(stdout);
+            pid = fork();
+            HOST_TEST_ASSERT(pid >= 0);
+            if (pid == 0)
+            {
+                bench_run(m_latencies_us[i], (k == 1));
+                exit(0);
+            }
+            HOST_TEST_ASSERT(waitpid(pid, &status, 0) == pid);
+            HOST_TEST_ASSERT(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+        }
+    }
+    return 0;
+}
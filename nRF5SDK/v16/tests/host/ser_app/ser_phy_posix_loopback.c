@@ -0,0 +1,320 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Loopback test of the POSIX UART serialization PHY over a pseudo-terminal.
+ *
+ * The test drives ser_hal_transport and the PHY from the application side of a pseudo-terminal.
+ * The other side plays the connectivity chip and sends every packet back. Packets of random
+ * length and content must come back unchanged. For some of them, the peer replies with a packet
+ * that is larger than the receive buffer, which must be reported as dropped.
+ *
+ * In the port failure scenario, the peer closes its side while a packet is being sent. The
+ * failure must be reported by exactly one SER_HAL_TRANSP_EVT_PHY_ERROR event, the transmit buffer
+ * must be released, and the PHY must work again after it is closed and opened.
+ */
+#define _GNU_SOURCE
+#include <string.h>
+#include "sdk_common.h"
+#include "ser_config.h"
+#include "ser_hal_transport.h"
+#include "ser_phy_posix.h"
+#include "host_test.h"
+// The system headers go last, see ser_phy_uart_posix.c.
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define PKT_COUNT       2000    // Number of packets sent in the loopback scenario.
+#define DROP_INTERVAL   97      // Every DROP_INTERVAL-th packet gets an oversized reply.
+#define DROP_MARKER     0xEE    // First byte of the packets that get an oversized reply.
+#define PEER_BUF_SIZE   4096
+#define WAIT_LIMIT      100000  // Maximum number of process calls while waiting for a packet.
+
+static int       m_peer_fd = -1;
+static uint8_t   m_peer_buf[PEER_BUF_SIZE];
+static uint16_t  m_peer_len;
+
+static uint8_t * mp_rx_pkt;
+static uint16_t  m_rx_pkt_len;
+static uint32_t  m_sent_cnt;
+static uint32_t  m_dropped_cnt;
+static uint32_t  m_error_cnt;
+
+static void hal_transport_evt_handler(ser_hal_transport_evt_t event)
+{
+    switch (event.evt_type)
+    {
+        case SER_HAL_TRANSP_EVT_TX_PKT_SENT:
+            m_sent_cnt++;
+            break;
+
+        case SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED:
+            HOST_TEST_ASSERT(mp_rx_pkt == NULL);
+            mp_rx_pkt    = event.evt_params.rx_pkt_received.p_buffer;
+            m_rx_pkt_len = event.evt_params.rx_pkt_received.num_of_bytes;
+            break;
+
+        case SER_HAL_TRANSP_EVT_RX_PKT_DROPPED:
+            m_dropped_cnt++;
+            break;
+
+        case SER_HAL_TRANSP_EVT_PHY_ERROR:
+            HOST_TEST_ASSERT(event.evt_params.phy_error.error_type ==
+                             SER_HAL_TRANSP_PHY_ERROR_HW_ERROR);
+            m_error_cnt++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**@brief Function for opening the peer side of a new pseudo-terminal and passing the application
+ *        side to the PHY. */
+static void peer_open(void)
+{
+    struct termios tty;
+
+    m_peer_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    HOST_TEST_ASSERT(m_peer_fd >= 0);
+    HOST_TEST_ASSERT(grantpt(m_peer_fd) == 0);
+    HOST_TEST_ASSERT(unlockpt(m_peer_fd) == 0);
+    HOST_TEST_ASSERT(tcgetattr(m_peer_fd, &tty) == 0);
+    cfmakeraw(&tty);
+    HOST_TEST_ASSERT(tcsetattr(m_peer_fd, TCSANOW, &tty) == 0);
+    HOST_TEST_ASSERT(fcntl(m_peer_fd, F_SETFL, O_NONBLOCK) == 0);
+    m_peer_len = 0;
+
+    HOST_TEST_ASSERT(ser_phy_posix_device_set(ptsname(m_peer_fd)) == NRF_SUCCESS);
+}
+
+static void peer_write(uint8_t const * p_data, uint16_t len)
+{
+    uint16_t done = 0;
+
+    while (done < len)
+    {
+        ssize_t written = write(m_peer_fd, &p_data[done], len - done);
+
+        if (written > 0)
+        {
+            done += (uint16_t)written;
+        }
+        else
+        {
+            // The pseudo-terminal is full: let the application side read.
+            (void)ser_phy_posix_process(0);
+        }
+    }
+}
+
+/**@brief Function for sending back the complete packets received by the peer. */
+static void peer_process(void)
+{
+    static uint8_t reply[SER_PHY_HEADER_SIZE + SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE + 1];
+    ssize_t        len;
+
+    len = read(m_peer_fd, &m_peer_buf[m_peer_len], sizeof(m_peer_buf) - m_peer_len);
+    if (len > 0)
+    {
+        m_peer_len += (uint16_t)len;
+    }
+
+    while (m_peer_len >= SER_PHY_HEADER_SIZE)
+    {
+        uint16_t pkt_len   = uint16_decode(m_peer_buf);
+        uint16_t frame_len = SER_PHY_HEADER_SIZE + pkt_len;
+        uint16_t reply_len = pkt_len;
+
+        if (m_peer_len < frame_len)
+        {
+            break;
+        }
+
+        memcpy(&reply[SER_PHY_HEADER_SIZE], &m_peer_buf[SER_PHY_HEADER_SIZE], pkt_len);
+        if (m_peer_buf[SER_PHY_HEADER_SIZE] == DROP_MARKER)
+        {
+            reply_len = SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE + 1;
+            memset(&reply[SER_PHY_HEADER_SIZE + pkt_len], 0xAB, reply_len - pkt_len);
+        }
+        (void)uint16_encode(reply_len, reply);
+        peer_write(reply, SER_PHY_HEADER_SIZE + reply_len);
+
+        memmove(m_peer_buf, &m_peer_buf[frame_len], m_peer_len - frame_len);
+        m_peer_len -= frame_len;
+    }
+}
+
+static void loopback_test(void)
+{
+    static uint8_t sent[SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE];
+    uint32_t       seed         = 1;
+    uint32_t       drop_expected = 0;
+    uint32_t       i;
+
+    peer_open();
+    HOST_TEST_ASSERT(ser_hal_transport_open(hal_transport_evt_handler) == NRF_SUCCESS);
+
+    for (i = 0; i < PKT_COUNT; i++)
+    {
+        uint8_t * p_buf;
+        uint16_t  size;
+        uint16_t  len;
+        uint32_t  sent_cnt    = m_sent_cnt;
+        uint32_t  dropped_cnt = m_dropped_cnt;
+        bool      drop        = ((i % DROP_INTERVAL) == 0);
+        uint32_t  k;
+
+        HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_alloc(&p_buf, &size) == NRF_SUCCESS);
+        len = 1 + host_rand(&seed) % MIN(size, sizeof(sent));
+        for (k = 0; k < len; k++)
+        {
+            p_buf[k] = (uint8_t)host_rand(&seed);
+        }
+        if (drop)
+        {
+            p_buf[0] = DROP_MARKER;
+            drop_expected++;
+        }
+        else if (p_buf[0] == DROP_MARKER)
+        {
+            p_buf[0] = 0;
+        }
+        memcpy(sent, p_buf, len);
+
+        HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_send(p_buf, len) == NRF_SUCCESS);
+        for (k = 0;
+             (k < WAIT_LIMIT) &&
+             ((m_sent_cnt == sent_cnt) || ((mp_rx_pkt == NULL) && (m_dropped_cnt == dropped_cnt)));
+             k++)
+        {
+            peer_process();
+            (void)ser_phy_posix_process(1);
+        }
+        HOST_TEST_ASSERT(m_sent_cnt == sent_cnt + 1);
+
+        if (drop)
+        {
+            HOST_TEST_ASSERT(m_dropped_cnt == dropped_cnt + 1);
+            HOST_TEST_ASSERT(mp_rx_pkt == NULL);
+        }
+        else
+        {
+            HOST_TEST_ASSERT(mp_rx_pkt != NULL);
+            HOST_TEST_ASSERT(m_rx_pkt_len == len);
+            HOST_TEST_ASSERT(memcmp(mp_rx_pkt, sent, len) == 0);
+            HOST_TEST_ASSERT(ser_hal_transport_rx_pkt_free(mp_rx_pkt) == NRF_SUCCESS);
+            mp_rx_pkt = NULL;
+        }
+    }
+    HOST_TEST_ASSERT(m_error_cnt == 0);
+
+    ser_hal_transport_close();
+    (void)close(m_peer_fd);
+
+    printf("loopback: %u packets echoed, %u oversized replies dropped: OK\n",
+           PKT_COUNT - drop_expected, m_dropped_cnt);
+}
+
+static void port_failure_test(void)
+{
+    uint8_t * p_buf;
+    uint16_t  size;
+    uint32_t  i;
+
+    m_error_cnt = 0;
+    m_sent_cnt  = 0;
+
+    peer_open();
+    HOST_TEST_ASSERT(ser_hal_transport_open(hal_transport_evt_handler) == NRF_SUCCESS);
+
+    // Writing to a pseudo-terminal fails once its other side is closed.
+    (void)close(m_peer_fd);
+    HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_alloc(&p_buf, &size) == NRF_SUCCESS);
+    memset(p_buf, 0x55, 100);
+    HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_send(p_buf, 100) == NRF_SUCCESS);
+
+    for (i = 0; i < 10; i++)
+    {
+        (void)ser_phy_posix_process(1);
+    }
+    HOST_TEST_ASSERT(m_error_cnt == 1);
+    HOST_TEST_ASSERT(m_sent_cnt == 0);
+
+    // The transmit buffer was released, but the PHY does not send any more.
+    HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_alloc(&p_buf, &size) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_send(p_buf, 100) != NRF_SUCCESS);
+    HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_free(p_buf) == NRF_SUCCESS);
+    for (i = 0; i < 10; i++)
+    {
+        (void)ser_phy_posix_process(1);
+    }
+    HOST_TEST_ASSERT(m_error_cnt == 1);
+    ser_hal_transport_close();
+
+    // The PHY works again after it is reopened.
+    peer_open();
+    HOST_TEST_ASSERT(ser_hal_transport_open(hal_transport_evt_handler) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_alloc(&p_buf, &size) == NRF_SUCCESS);
+    memset(p_buf, 0x55, 100);
+    HOST_TEST_ASSERT(ser_hal_transport_tx_pkt_send(p_buf, 100) == NRF_SUCCESS);
+    for (i = 0; (i < WAIT_LIMIT) && (mp_rx_pkt == NULL); i++)
+    {
+        peer_process();
+        (void)ser_phy_posix_process(1);
+    }
+    HOST_TEST_ASSERT((m_sent_cnt == 1) && (mp_rx_pkt != NULL) && (m_rx_pkt_len == 100));
+    HOST_TEST_ASSERT(ser_hal_transport_rx_pkt_free(mp_rx_pkt) == NRF_SUCCESS);
+    mp_rx_pkt = NULL;
+    HOST_TEST_ASSERT(m_error_cnt == 1);
+
+    ser_hal_transport_close();
+    (void)close(m_peer_fd);
+
+    printf("port failure: reported once, buffer released, reopened: OK\n");
+}
+
+int main(void)
+{
+    loopback_test();
+    port_failure_test();
+    return 0;
+}
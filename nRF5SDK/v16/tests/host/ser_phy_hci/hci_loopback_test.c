@@ -0,0 +1,653 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Loopback test and throughput benchmark of the HCI serialization PHY.
+ *
+ * Two instances of the PHY, A and B, are connected back to back. The test implements the SLIP
+ * layer and the application timer of each of them over a simulated UART with a given byte time,
+ * latency and loss rate per frame. Time is simulated, so the results do not depend on the host.
+ *
+ * Each packet carries its index and a pattern. The receiving side checks that the packets arrive
+ * complete and in order, and that SLIP never sends a buffer that changed during transmission.
+ * The throughput is measured without loss, with 1% and 5% loss and in both directions at once.
+ *
+ * In the link loss scenario, the link from A to B goes down after some packets. Every packet that
+ * A is asked to send must then be either received by B or reported by a SER_PHY_EVT_HW_ERROR
+ * event. The event carries the buffer of the application when the PHY still uses it (window of
+ * one packet), or NULL when the PHY had copied the packet.
+ *
+ * The test is built for SER_PHY_HCI_WINDOW_SIZE of 1, 2, 4 and 7.
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "app_timer.h"
+#include "ser_phy.h"
+#include "ser_phy_hci.h"
+#include "ser_config.h"
+#include "host_test.h"
+
+#define PKT_LEN         100         // Length of the packets sent by the application.
+#define FRAME_MAX_LEN   (SER_HAL_TRANSPORT_MAX_PKT_SIZE + 8)
+#define BYTE_TIME_us    11.0        // Time of one byte on the wire, including start and stop bits.
+#define LATENCY_us      1000.0      // Delay between the end of a frame and its reception.
+#define FLIGHT_COUNT    64          // Maximum number of frames on the wire.
+#define TIME_LIMIT_us   600e6       // Simulated time after which a scenario fails.
+
+/**@brief Frame handed to the simulated SLIP layer. */
+typedef struct
+{
+    ser_phy_hci_pkt_params_t parts[3];              // Header, payload and CRC.
+    uint8_t                  data[FRAME_MAX_LEN];   // Copy of the frame when its transmission started.
+    uint16_t                 len;
+    bool                     is_ack;
+    bool                     valid;
+} frame_t;
+
+/**@brief Functions of one PHY instance. */
+typedef struct
+{
+    uint32_t (* open)(ser_phy_events_handler_t events_handler);
+    void     (* close)(void);
+    uint32_t (* tx_pkt_send)(uint8_t const * p_buffer, uint16_t num_of_bytes);
+    uint32_t (* rx_buf_set)(uint8_t * p_buffer);
+    void     (* interrupts_enable)(void);
+    void     (* interrupts_disable)(void);
+} phy_api_t;
+
+/**@brief One side of the link: the UART, the SLIP layer, the timer and the application. */
+typedef struct side_s
+{
+    char const                     * p_name;
+    phy_api_t                        phy;
+    struct side_s                  * p_peer;
+
+    ser_phy_hci_slip_event_handler_t slip_handler;
+    frame_t                          tx_frame;          // Frame on the wire.
+    frame_t                          tx_frame_next;     // Frame waiting for the wire.
+    double                           tx_frame_end;      // Time of the end of the frame on the wire.
+    uint8_t                          rx_ack_buf[4];     // SLIP buffer for ACK packets.
+    uint8_t                          rx_pkt_buf[FRAME_MAX_LEN];
+    bool                             rx_ack_buf_used;
+    bool                             rx_pkt_buf_used;
+    bool                             link_down;         // Frames sent by this side are lost.
+
+    app_timer_timeout_handler_t      timer_handler;
+    bool                             timer_running;
+    double                           timer_period;
+    double                           timer_next;
+
+    uint8_t                          tx_buf[PKT_LEN];   // Buffer of the application.
+    uint32_t                         tx_total;          // Packets to send.
+    uint32_t                         tx_idx;            // Packets handed to the PHY.
+    bool                             tx_busy;
+    uint8_t                          rx_buf[FRAME_MAX_LEN];
+    bool                             rx_buf_requested;
+    uint32_t                         rx_count;          // Packets received in order.
+
+    uint32_t                         sent_cnt;          // SER_PHY_EVT_TX_PKT_SENT events.
+    uint32_t                         error_cnt;         // SER_PHY_EVT_HW_ERROR events.
+    uint32_t                         error_buf_cnt;     // Of them, events that returned tx_buf.
+    uint32_t                         data_frames;
+    uint32_t                         ack_frames;
+    uint32_t                         lost_frames;
+} side_t;
+
+/**@brief Frame on its way to the peer. */
+typedef struct
+{
+    side_t * p_to;
+    double   time;
+    uint16_t len;
+    uint8_t  data[FRAME_MAX_LEN];
+} flight_t;
+
+// Instances of the PHY (see hci_phy_a.c and hci_phy_b.c).
+#define PHY_DECLARE(_prefix)                                                                    \
+    uint32_t _prefix##ser_phy_open(ser_phy_events_handler_t events_handler);                   \
+    void     _prefix##ser_phy_close(void);                                                      \
+    uint32_t _prefix##ser_phy_tx_pkt_send(uint8_t const * p_buffer, uint16_t num_of_bytes);    \
+    uint32_t _prefix##ser_phy_rx_buf_set(uint8_t * p_buffer);                                   \
+    void     _prefix##ser_phy_interrupts_enable(void);                                          \
+    void     _prefix##ser_phy_interrupts_disable(void);
+
+#define PHY_API(_prefix)                                                                        \
+    {                                                                                           \
+        .open               = _prefix##ser_phy_open,                                            \
+        .close              = _prefix##ser_phy_close,                                           \
+        .tx_pkt_send        = _prefix##ser_phy_tx_pkt_send,                                     \
+        .rx_buf_set         = _prefix##ser_phy_rx_buf_set,                                      \
+        .interrupts_enable  = _prefix##ser_phy_interrupts_enable,                               \
+        .interrupts_disable = _prefix##ser_phy_interrupts_disable,                              \
+    }
+
+PHY_DECLARE(phy_a_)
+PHY_DECLARE(phy_b_)
+
+static side_t   m_a;
+static side_t   m_b;
+static double   m_now;          // Simulated time in microseconds.
+static double   m_loss;         // Probability that a frame is lost.
+static uint32_t m_rand;
+static flight_t m_flight[FLIGHT_COUNT];
+static uint32_t m_flight_head;
+static uint32_t m_flight_tail;
+
+
+/**@brief Function for copying the parts of a frame into one buffer. */
+static uint16_t frame_gather(frame_t const * p_frame, uint8_t * p_dst)
+{
+    uint16_t len = 0;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(p_frame->parts); i++)
+    {
+        if (p_frame->parts[i].p_buffer != NULL)
+        {
+            memcpy(&p_dst[len], p_frame->parts[i].p_buffer, p_frame->parts[i].num_of_bytes);
+            len += p_frame->parts[i].num_of_bytes;
+        }
+    }
+
+    return len;
+}
+
+
+/**@brief Function for starting the transmission of a frame on the wire. */
+static void frame_start(side_t * p_side)
+{
+    frame_t * p_frame = &p_side->tx_frame;
+    uint32_t  wire_len = 2; // SLIP frame delimiters.
+
+    p_frame->len = frame_gather(p_frame, p_frame->data);
+    for (uint32_t i = 0; i < p_frame->len; i++)
+    {
+        // SLIP escapes the delimiter and the escape character.
+        wire_len += ((p_frame->data[i] == 0xC0) || (p_frame->data[i] == 0xDB)) ? 2 : 1;
+    }
+
+    p_side->tx_frame_end = m_now + BYTE_TIME_us * wire_len;
+    if (p_frame->is_ack)
+    {
+        p_side->ack_frames++;
+    }
+    else
+    {
+        p_side->data_frames++;
+    }
+}
+
+
+static uint32_t slip_tx_pkt_send(side_t                         * p_side,
+                                 ser_phy_hci_pkt_params_t const * p_header,
+                                 ser_phy_hci_pkt_params_t const * p_payload,
+                                 ser_phy_hci_pkt_params_t const * p_crc)
+{
+    frame_t * p_frame = p_side->tx_frame.valid ? &p_side->tx_frame_next : &p_side->tx_frame;
+
+    // The PHY sends at most one data packet and one ACK packet at a time.
+    HOST_TEST_ASSERT(!p_frame->valid);
+
+    memset(p_frame->parts, 0, sizeof(p_frame->parts));
+    p_frame->parts[0] = *p_header;
+    if (p_payload != NULL)
+    {
+        p_frame->parts[1] = *p_payload;
+    }
+    if (p_crc != NULL)
+    {
+        p_frame->parts[2] = *p_crc;
+    }
+    p_frame->is_ack = (p_payload == NULL) || (p_payload->p_buffer == NULL);
+    p_frame->valid  = true;
+
+    if (p_frame == &p_side->tx_frame)
+    {
+        frame_start(p_side);
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+static uint32_t slip_rx_buf_free(side_t * p_side, uint8_t * p_buffer)
+{
+    if ((p_buffer == p_side->rx_ack_buf) && p_side->rx_ack_buf_used)
+    {
+        p_side->rx_ack_buf_used = false;
+    }
+    else if ((p_buffer == p_side->rx_pkt_buf) && p_side->rx_pkt_buf_used)
+    {
+        p_side->rx_pkt_buf_used = false;
+    }
+    else
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for passing a frame from the wire to SLIP, which drops it if it has no buffer. */
+static void slip_rx(side_t * p_side, uint8_t const * p_data, uint16_t len)
+{
+    ser_phy_hci_slip_evt_t evt;
+    uint8_t              * p_buffer;
+
+    if ((len <= sizeof(p_side->rx_ack_buf)) && !p_side->rx_ack_buf_used)
+    {
+        p_buffer                = p_side->rx_ack_buf;
+        p_side->rx_ack_buf_used = true;
+    }
+    else if (!p_side->rx_pkt_buf_used)
+    {
+        p_buffer                = p_side->rx_pkt_buf;
+        p_side->rx_pkt_buf_used = true;
+    }
+    else
+    {
+        return;
+    }
+
+    memcpy(p_buffer, p_data, len);
+    evt.evt_type                               = SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED;
+    evt.evt_params.received_pkt.p_buffer     = p_buffer;
+    evt.evt_params.received_pkt.num_of_bytes = len;
+    p_side->slip_handler(&evt);
+}
+
+
+/**@brief Function for ending the transmission of the frame on the wire. */
+static void wire_tx_end(side_t * p_side)
+{
+    frame_t                * p_frame = &p_side->tx_frame;
+    uint8_t                  data[FRAME_MAX_LEN];
+    ser_phy_hci_slip_evt_t   evt;
+
+    // The buffers of the frame must not change while SLIP reads them.
+    HOST_TEST_ASSERT(frame_gather(p_frame, data) == p_frame->len);
+    HOST_TEST_ASSERT(memcmp(data, p_frame->data, p_frame->len) == 0);
+
+    if (p_side->link_down || ((double)host_rand(&m_rand) / UINT32_MAX < m_loss))
+    {
+        p_side->lost_frames++;
+    }
+    else
+    {
+        flight_t * p_flight = &m_flight[m_flight_tail++ % FLIGHT_COUNT];
+
+        HOST_TEST_ASSERT(m_flight_tail - m_flight_head <= FLIGHT_COUNT);
+        p_flight->p_to = p_side->p_peer;
+        p_flight->time = m_now + LATENCY_us;
+        p_flight->len  = p_frame->len;
+        memcpy(p_flight->data, p_frame->data, p_frame->len);
+    }
+
+    evt.evt_type   = p_frame->is_ack ? SER_PHY_HCI_SLIP_EVT_ACK_SENT : SER_PHY_HCI_SLIP_EVT_PKT_SENT;
+    p_frame->valid = false;
+    if (p_side->tx_frame_next.valid)
+    {
+        *p_frame                     = p_side->tx_frame_next;
+        p_side->tx_frame_next.valid = false;
+        frame_start(p_side);
+    }
+
+    p_side->slip_handler(&evt);
+}
+
+
+/**@brief Function for handing the next packet of the application to the PHY. */
+static void app_send(side_t * p_side)
+{
+    if (p_side->tx_busy || (p_side->tx_idx >= p_side->tx_total))
+    {
+        return;
+    }
+
+    uint32_encode(p_side->tx_idx, p_side->tx_buf);
+    for (uint32_t i = sizeof(uint32_t); i < PKT_LEN; i++)
+    {
+        p_side->tx_buf[i] = (uint8_t)(i * 7 + p_side->tx_idx);
+    }
+    p_side->tx_busy = true;
+    p_side->tx_idx++;
+
+    p_side->phy.interrupts_disable();
+    HOST_TEST_ASSERT(p_side->phy.tx_pkt_send(p_side->tx_buf, PKT_LEN) == NRF_SUCCESS);
+    p_side->phy.interrupts_enable();
+}
+
+
+static void app_rx_pkt_check(side_t * p_side, uint8_t const * p_buffer, uint16_t len)
+{
+    uint32_t idx = uint32_decode(p_buffer);
+
+    HOST_TEST_ASSERT(len == PKT_LEN);
+    HOST_TEST_ASSERT(idx >= p_side->rx_count);
+    for (uint32_t i = sizeof(uint32_t); i < PKT_LEN; i++)
+    {
+        HOST_TEST_ASSERT(p_buffer[i] == (uint8_t)(i * 7 + idx));
+    }
+
+    // Packets dropped by the sender are skipped, the others arrive in order.
+    p_side->rx_count = idx + 1;
+}
+
+
+static void app_evt_handle(side_t * p_side, ser_phy_evt_t event)
+{
+    switch (event.evt_type)
+    {
+        case SER_PHY_EVT_TX_PKT_SENT:
+            p_side->sent_cnt++;
+            p_side->tx_busy = false;
+            app_send(p_side);
+            break;
+
+        case SER_PHY_EVT_RX_BUF_REQUEST:
+            HOST_TEST_ASSERT(!p_side->rx_buf_requested);
+            p_side->rx_buf_requested = true;
+            p_side->phy.interrupts_disable();
+            HOST_TEST_ASSERT(p_side->phy.rx_buf_set(p_side->rx_buf) == NRF_SUCCESS);
+            p_side->phy.interrupts_enable();
+            break;
+
+        case SER_PHY_EVT_RX_PKT_RECEIVED:
+            HOST_TEST_ASSERT(event.evt_params.rx_pkt_received.p_buffer == p_side->rx_buf);
+            app_rx_pkt_check(p_side,
+                             event.evt_params.rx_pkt_received.p_buffer,
+                             event.evt_params.rx_pkt_received.num_of_bytes);
+            p_side->rx_buf_requested = false;
+            break;
+
+        case SER_PHY_EVT_HW_ERROR:
+            p_side->error_cnt++;
+            if (event.evt_params.hw_error.p_buffer != NULL)
+            {
+                // The packet was not copied, the buffer of the application is released.
+                HOST_TEST_ASSERT(event.evt_params.hw_error.p_buffer == p_side->tx_buf);
+                p_side->error_buf_cnt++;
+                p_side->tx_busy = false;
+                app_send(p_side);
+            }
+            break;
+
+        default:
+            HOST_TEST_ASSERT(false);
+            break;
+    }
+}
+
+
+static void a_evt_handler(ser_phy_evt_t event)
+{
+    app_evt_handle(&m_a, event);
+}
+
+
+static void b_evt_handler(ser_phy_evt_t event)
+{
+    app_evt_handle(&m_b, event);
+}
+
+
+// SLIP layer and application timer of each PHY instance.
+#define SIDE_DEFINE(_prefix, _side)                                                             \
+    uint32_t _prefix##ser_phy_hci_slip_open(ser_phy_hci_slip_event_handler_t events_handler)   \
+    {                                                                                           \
+        _side.slip_handler = events_handler;                                                    \
+        return NRF_SUCCESS;                                                                     \
+    }                                                                                           \
+    uint32_t _prefix##ser_phy_hci_slip_close(void)                                              \
+    {                                                                                           \
+        return NRF_SUCCESS;                                                                     \
+    }                                                                                           \
+    uint32_t _prefix##ser_phy_hci_slip_tx_pkt_send(ser_phy_hci_pkt_params_t const * p_header,  \
+                                                   ser_phy_hci_pkt_params_t const * p_payload, \
+                                                   ser_phy_hci_pkt_params_t const * p_crc)     \
+    {                                                                                           \
+        return slip_tx_pkt_send(&_side, p_header, p_payload, p_crc);                            \
+    }                                                                                           \
+    uint32_t _prefix##ser_phy_hci_slip_rx_buf_free(uint8_t * p_buffer)                          \
+    {                                                                                           \
+        return slip_rx_buf_free(&_side, p_buffer);                                              \
+    }                                                                                           \
+    ret_code_t _prefix##app_timer_create(app_timer_id_t const *      p_timer_id,                \
+                                         app_timer_mode_t            mode,                      \
+                                         app_timer_timeout_handler_t timeout_handler)           \
+    {                                                                                           \
+        _side.timer_handler = timeout_handler;                                                  \
+        return NRF_SUCCESS;                                                                     \
+    }                                                                                           \
+    ret_code_t _prefix##app_timer_start(app_timer_id_t timer_id,                                \
+                                        uint32_t       timeout_ticks,                           \
+                                        void         * p_context)                               \
+    {                                                                                           \
+        _side.timer_running = true;                                                             \
+        _side.timer_period  = timeout_ticks * 1e6 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)        \
+                              / APP_TIMER_CLOCK_FREQ;                                           \
+        _side.timer_next    = m_now + _side.timer_period;                                       \
+        return NRF_SUCCESS;                                                                     \
+    }                                                                                           \
+    ret_code_t _prefix##app_timer_stop(app_timer_id_t timer_id)                                 \
+    {                                                                                           \
+        _side.timer_running = false;                                                            \
+        return NRF_SUCCESS;                                                                     \
+    } \
+    void _prefix##NVIC_SystemReset(void)                                                        \
+    {                                                                                           \
+        /* Only sent by the peer on request of the application. */                             \
+        HOST_TEST_ASSERT(false);                                                                \
+    }
+
+SIDE_DEFINE(phy_a_, m_a)
+SIDE_DEFINE(phy_b_, m_b)
+
+
+/**@brief Function for processing the next event in simulated time.
+ *
+ * @return False if there is no event.
+ */
+static bool sim_step(void)
+{
+    side_t * sides[] = {&m_a, &m_b};
+    side_t * p_side  = NULL;
+    double   time    = TIME_LIMIT_us;
+    enum { WIRE_TX_END, TIMER, FLIGHT, NONE } kind = NONE;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(sides); i++)
+    {
+        if (sides[i]->tx_frame.valid && (sides[i]->tx_frame_end < time))
+        {
+            time   = sides[i]->tx_frame_end;
+            kind   = WIRE_TX_END;
+            p_side = sides[i];
+        }
+        if (sides[i]->timer_running && (sides[i]->timer_next < time))
+        {
+            time   = sides[i]->timer_next;
+            kind   = TIMER;
+            p_side = sides[i];
+        }
+    }
+    if ((m_flight_head != m_flight_tail) && (m_flight[m_flight_head % FLIGHT_COUNT].time <= time))
+    {
+        time = m_flight[m_flight_head % FLIGHT_COUNT].time;
+        kind = FLIGHT;
+    }
+
+    m_now = time;
+    switch (kind)
+    {
+        case WIRE_TX_END:
+            wire_tx_end(p_side);
+            break;
+
+        case TIMER:
+            p_side->timer_next += p_side->timer_period;
+            p_side->timer_handler(NULL);
+            break;
+
+        case FLIGHT:
+        {
+            flight_t * p_flight = &m_flight[m_flight_head++ % FLIGHT_COUNT];
+            slip_rx(p_flight->p_to, p_flight->data, p_flight->len);
+            break;
+        }
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+
+static void sides_open(uint32_t a_pkts, uint32_t b_pkts, double loss)
+{
+    static phy_api_t const phy_a = PHY_API(phy_a_);
+    static phy_api_t const phy_b = PHY_API(phy_b_);
+
+    memset(&m_a, 0, sizeof(m_a));
+    memset(&m_b, 0, sizeof(m_b));
+    m_a.p_name   = "A";
+    m_a.phy      = phy_a;
+    m_a.p_peer   = &m_b;
+    m_a.tx_total = a_pkts;
+    m_b.p_name   = "B";
+    m_b.phy      = phy_b;
+    m_b.p_peer   = &m_a;
+    m_b.tx_total = b_pkts;
+
+    m_now         = 0;
+    m_loss        = loss;
+    m_rand        = 12345;
+    m_flight_head = 0;
+    m_flight_tail = 0;
+
+    HOST_TEST_ASSERT(m_a.phy.open(a_evt_handler) == NRF_SUCCESS);
+    HOST_TEST_ASSERT(m_b.phy.open(b_evt_handler) == NRF_SUCCESS);
+    app_send(&m_a);
+    app_send(&m_b);
+}
+
+
+static void sides_close(void)
+{
+    m_a.phy.close();
+    m_b.phy.close();
+}
+
+
+/**@brief Function for measuring the throughput of the link. */
+static void throughput_run(char const * p_name, uint32_t pkts, bool both_ways, double loss)
+{
+    sides_open(pkts, both_ways ? pkts : 0, loss);
+
+    while ((m_b.rx_count < m_a.tx_total) || (m_a.rx_count < m_b.tx_total) ||
+           (m_a.sent_cnt < m_a.tx_total) || (m_b.sent_cnt < m_b.tx_total))
+    {
+        HOST_TEST_ASSERT(sim_step());
+    }
+
+    // No packet may be dropped, and each one is reported as sent once.
+    HOST_TEST_ASSERT((m_a.error_cnt == 0) && (m_b.error_cnt == 0));
+    HOST_TEST_ASSERT((m_a.sent_cnt == m_a.tx_total) && (m_b.sent_cnt == m_b.tx_total));
+
+    double bytes = (double)(m_a.rx_count + m_b.rx_count) * PKT_LEN;
+
+    printf("%-22s %6.1f kB/s  (A: %4u data %4u ACK %3u lost, B: %4u data %4u ACK %3u lost)\n",
+           p_name, bytes / m_now * 1000,
+           m_a.data_frames, m_a.ack_frames, m_a.lost_frames,
+           m_b.data_frames, m_b.ack_frames, m_b.lost_frames);
+
+    sides_close();
+}
+
+
+/**@brief Function for checking the reporting of packets that cannot be delivered. */
+static void link_loss_run(void)
+{
+    uint32_t const pkts      = 40;
+    uint32_t const down_after = 20;
+
+    sides_open(pkts, 0, 0);
+
+    // Every packet handed to the PHY is received by the peer or reported as failed.
+    while (m_b.rx_count + m_a.error_cnt < pkts)
+    {
+        if (m_b.rx_count >= down_after)
+        {
+            m_a.link_down = true;
+        }
+        HOST_TEST_ASSERT(sim_step());
+    }
+
+    HOST_TEST_ASSERT(m_a.tx_idx == pkts);
+    HOST_TEST_ASSERT(m_a.error_cnt > 0);
+#if (SER_PHY_HCI_WINDOW_SIZE == 1)
+    // Packets are reported as sent when they are acknowledged, or returned with the error.
+    HOST_TEST_ASSERT(m_a.error_buf_cnt == m_a.error_cnt);
+    HOST_TEST_ASSERT(m_a.sent_cnt == m_b.rx_count);
+#else
+    // Packets are reported as sent when they are copied, the errors do not return a buffer.
+    HOST_TEST_ASSERT(m_a.error_buf_cnt == 0);
+    HOST_TEST_ASSERT(m_a.sent_cnt == pkts);
+#endif
+
+    printf("link loss: %u of %u packets received, %u reported as failed: OK\n",
+           m_b.rx_count, pkts, m_a.error_cnt);
+
+    sides_close();
+}
+
+
+int main(void)
+{
+    printf("window %u, %u-byte packets, %.0f us per byte, %.0f us latency\n",
+           SER_PHY_HCI_WINDOW_SIZE, PKT_LEN, BYTE_TIME_us, LATENCY_us);
+
+    throughput_run("no loss", 2000, false, 0);
+    throughput_run("1% loss", 2000, false, 0.01);
+    throughput_run("5% loss", 1000, false, 0.05);
+    throughput_run("both ways, 2% loss", 2000, true, 0.02);
+    link_loss_run();
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Renaming of the HCI PHY interface, to link two instances of the PHY into one test.
+ *
+ * Each instance is built from a file that defines HCI_PHY_PREFIX and includes this header before
+ * ser_phy_hci.c. The functions of the PHY, the functions it calls that the test implements for
+ * each side of the link and its non-static variables get the prefix. The system reset requested
+ * by a RESET packet is also implemented by the test.
+ */
+#ifndef HCI_PHY_RENAME_H__
+#define HCI_PHY_RENAME_H__
+
+#include "nrf.h"
+
+#define HCI_PHY_NAME(name)              HCI_PHY_NAME_(HCI_PHY_PREFIX, name)
+#define HCI_PHY_NAME_(prefix, name)     HCI_PHY_NAME__(prefix, name)
+#define HCI_PHY_NAME__(prefix, name)    prefix##name
+
+#define ser_phy_open                    HCI_PHY_NAME(ser_phy_open)
+#define ser_phy_close                   HCI_PHY_NAME(ser_phy_close)
+#define ser_phy_tx_pkt_send             HCI_PHY_NAME(ser_phy_tx_pkt_send)
+#define ser_phy_rx_buf_set              HCI_PHY_NAME(ser_phy_rx_buf_set)
+#define ser_phy_interrupts_enable       HCI_PHY_NAME(ser_phy_interrupts_enable)
+#define ser_phy_interrupts_disable      HCI_PHY_NAME(ser_phy_interrupts_disable)
+#define ser_phy_hci_reset               HCI_PHY_NAME(ser_phy_hci_reset)
+
+#define ser_phy_hci_slip_open           HCI_PHY_NAME(ser_phy_hci_slip_open)
+#define ser_phy_hci_slip_close          HCI_PHY_NAME(ser_phy_hci_slip_close)
+#define ser_phy_hci_slip_reset          HCI_PHY_NAME(ser_phy_hci_slip_reset)
+#define ser_phy_hci_slip_tx_pkt_send    HCI_PHY_NAME(ser_phy_hci_slip_tx_pkt_send)
+#define ser_phy_hci_slip_rx_buf_free    HCI_PHY_NAME(ser_phy_hci_slip_rx_buf_free)
+
+#define app_timer_create                HCI_PHY_NAME(app_timer_create)
+#define app_timer_start                 HCI_PHY_NAME(app_timer_start)
+#define app_timer_stop                  HCI_PHY_NAME(app_timer_stop)
+
+#define m_tx_evt_queue                  HCI_PHY_NAME(m_tx_evt_queue)
+#define m_rx_evt_queue                  HCI_PHY_NAME(m_rx_evt_queue)
+
+#define NVIC_SystemReset                HCI_PHY_NAME(NVIC_SystemReset)
+
+void NVIC_SystemReset(void);
+
+#endif // HCI_PHY_RENAME_H__
@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2019, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the nrf_slab size classes and magazines.
+ *
+ * Interrupt priorities are modeled by threads that set the priority reported by
+ * current_int_priority_get(). The blocks held outside nrf_balloc are the blocks in use and the
+ * blocks cached in magazines, so the number of cached blocks is the pool utilization minus
+ * the blocks in use.
+ *
+ * The stress test passes blocks between Thread Mode and an interrupt priority in both
+ * directions, so that blocks are allocated in one context and freed in the other. It checks
+ * that a block is never handed out twice and that all blocks can be allocated again afterwards.
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include "sdk_common.h"
+#include "nrf_slab.h"
+#include "host_test.h"
+
+#define SMALL_SIZE      16      // Element size of the small class.
+#define SMALL_COUNT     8       // Number of blocks of the small class.
+#define LARGE_SIZE      64      // Element size of the large class.
+#define LARGE_COUNT     4       // Number of blocks of the large class.
+#define IRQ_PRIO        2       // Interrupt priority of the second context.
+
+#define STRESS_OPS      200000  // Number of blocks passed in each direction in the stress test.
+#define CHANNEL_SIZE    4       // Number of blocks in flight in each direction.
+
+/**@brief Single producer, single consumer channel of blocks between two contexts. */
+typedef struct
+{
+    void * volatile   p_blocks[CHANNEL_SIZE];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+} channel_t;
+
+NRF_BALLOC_DEF(m_pool_small, SMALL_SIZE, SMALL_COUNT);
+NRF_BALLOC_DEF(m_pool_large, LARGE_SIZE, LARGE_COUNT);
+NRF_SLAB_DEF(m_slab, &m_pool_small, &m_pool_large);
+
+static channel_t m_to_irq;
+static channel_t m_to_thread;
+
+
+static void stats_get(uint8_t class_idx, nrf_slab_stats_t * p_stats)
+{
+    HOST_TEST_ASSERT(nrf_slab_stats_get(&m_slab, class_idx, p_stats) == NRF_SUCCESS);
+}
+
+
+/**@brief Function for getting the number of free blocks of a class cached in magazines. */
+static uint32_t cached_get(uint8_t class_idx)
+{
+    nrf_balloc_t const * p_pool = (class_idx == 0) ? &m_pool_small : &m_pool_large;
+    nrf_slab_stats_t     stats;
+
+    stats_get(class_idx, &stats);
+    return nrf_balloc_utilization_get(p_pool) - stats.in_use;
+}
+
+
+/**@brief Test of the class selection, spill to a larger class and the statistics. */
+static void classes_test(void)
+{
+    void           * p_small[SMALL_COUNT];
+    void           * p_large[LARGE_COUNT];
+    nrf_slab_stats_t stats;
+
+    HOST_TEST_ASSERT(nrf_slab_init(&m_slab) == NRF_SUCCESS);
+
+    for (uint32_t i = 0; i < SMALL_COUNT; i++)
+    {
+        p_small[i] = nrf_slab_alloc(&m_slab, 1 + i);
+        HOST_TEST_ASSERT(p_small[i] != NULL);
+    }
+    p_large[0] = nrf_slab_alloc(&m_slab, SMALL_SIZE);
+    p_large[1] = nrf_slab_alloc(&m_slab, LARGE_SIZE);
+    p_large[2] = nrf_slab_alloc(&m_slab, SMALL_SIZE + 1);
+    p_large[3] = nrf_slab_alloc(&m_slab, 1);
+    for (uint32_t i = 0; i < LARGE_COUNT; i++)
+    {
+        HOST_TEST_ASSERT(p_large[i] != NULL);
+    }
+    HOST_TEST_ASSERT(nrf_slab_alloc(&m_slab, 1) == NULL);
+    HOST_TEST_ASSERT(nrf_slab_alloc(&m_slab, LARGE_SIZE + 1) == NULL);
+
+    stats_get(0, &stats);
+    HOST_TEST_ASSERT((stats.element_size == SMALL_SIZE) && (stats.pool_size == SMALL_COUNT));
+    HOST_TEST_ASSERT((stats.alloc_cnt == SMALL_COUNT) && (stats.in_use == SMALL_COUNT));
+    HOST_TEST_ASSERT((stats.spill_cnt == 2) && (stats.fail_cnt == 1));
+    HOST_TEST_ASSERT(stats.max_req_size == SMALL_COUNT);
+    stats_get(1, &stats);
+    HOST_TEST_ASSERT((stats.alloc_cnt == LARGE_COUNT) && (stats.max_in_use == LARGE_COUNT));
+    HOST_TEST_ASSERT((stats.spill_cnt == 0) && (stats.fail_cnt == 1));
+    HOST_TEST_ASSERT(stats.max_req_size == LARGE_SIZE);
+
+    for (uint32_t i = 0; i < SMALL_COUNT; i++)
+    {
+        nrf_slab_free(&m_slab, p_small[i]);
+    }
+    for (uint32_t i = 0; i < LARGE_COUNT; i++)
+    {
+        nrf_slab_free(&m_slab, p_large[i]);
+    }
+
+    nrf_slab_stats_reset(&m_slab);
+    stats_get(0, &stats);
+    HOST_TEST_ASSERT((stats.alloc_cnt == 0) && (stats.in_use == 0) && (stats.max_in_use == 0));
+    HOST_TEST_ASSERT(cached_get(0) == MIN(NRF_SLAB_MAGAZINE_SIZE, SMALL_COUNT));
+
+    printf("Size classes: OK\n");
+}
+
+
+/**@brief Test of the refill of a magazine by frees and its drain by allocations. */
+static void magazine_test(void)
+{
+#if NRF_SLAB_MAGAZINE_SIZE
+    void * p_blocks[SMALL_COUNT];
+
+    HOST_TEST_ASSERT(nrf_slab_init(&m_slab) == NRF_SUCCESS);
+
+    // Frees fill the magazine of the current priority, the rest go back to the pool.
+    for (uint32_t i = 0; i < SMALL_COUNT; i++)
+    {
+        p_blocks[i] = nrf_slab_alloc(&m_slab, SMALL_SIZE);
+    }
+    HOST_TEST_ASSERT(cached_get(0) == 0);
+    for (uint32_t i = 0; i < SMALL_COUNT; i++)
+    {
+        nrf_slab_free(&m_slab, p_blocks[i]);
+        HOST_TEST_ASSERT(cached_get(0) == MIN(i + 1, NRF_SLAB_MAGAZINE_SIZE));
+    }
+
+    // Allocations take the cached blocks first, then from the pool.
+    for (uint32_t i = 0; i < SMALL_COUNT; i++)
+    {
+        bool   cached  = false;
+        void * p_block = nrf_slab_alloc(&m_slab, SMALL_SIZE);
+
+        for (uint32_t j = 0; j < NRF_SLAB_MAGAZINE_SIZE; j++)
+        {
+            cached = cached || (p_block == p_blocks[j]);
+        }
+        HOST_TEST_ASSERT(cached == (i < NRF_SLAB_MAGAZINE_SIZE));
+        HOST_TEST_ASSERT(cached_get(0) ==
+                         NRF_SLAB_MAGAZINE_SIZE - MIN(i + 1, NRF_SLAB_MAGAZINE_SIZE));
+        p_blocks[i] = p_block;
+    }
+
+    // A block freed at an interrupt priority is cached there, and an exhausted class takes it
+    // back from Thread Mode before it spills to the larger class.
+    host_int_priority_set(IRQ_PRIO);
+    nrf_slab_free(&m_slab, p_blocks[0]);
+    host_int_priority_set(APP_IRQ_PRIORITY_THREAD);
+    HOST_TEST_ASSERT(cached_get(0) == 1);
+    HOST_TEST_ASSERT(nrf_slab_alloc(&m_slab, SMALL_SIZE) == p_blocks[0]);
+    HOST_TEST_ASSERT(cached_get(0) == 0);
+
+    nrf_slab_stats_t stats;
+    stats_get(0, &stats);
+    HOST_TEST_ASSERT((stats.spill_cnt == 0) && (stats.in_use == SMALL_COUNT));
+
+    for (uint32_t i = 0; i < SMALL_COUNT; i++)
+    {
+        nrf_slab_free(&m_slab, p_blocks[i]);
+    }
+
+    printf("Magazines: OK\n");
+#endif
+}
+
+
+static bool channel_put(channel_t * p_channel, void * p_block)
+{
+    if (p_channel->tail - p_channel->head == CHANNEL_SIZE)
+    {
+        return false;
+    }
+    p_channel->p_blocks[p_channel->tail % CHANNEL_SIZE] = p_block;
+    __atomic_store_n(&p_channel->tail, p_channel->tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+
+static void * channel_get(channel_t * p_channel)
+{
+    void * p_block;
+
+    if (__atomic_load_n(&p_channel->tail, __ATOMIC_ACQUIRE) == p_channel->head)
+    {
+        return NULL;
+    }
+    p_block = p_channel->p_blocks[p_channel->head % CHANNEL_SIZE];
+    __atomic_store_n(&p_channel->head, p_channel->head + 1, __ATOMIC_RELEASE);
+    return p_block;
+}
+
+
+/**@brief Function for passing blocks to the other context and freeing the blocks it passed.
+ *
+ * Every allocated block is marked with the owner, so that a block handed out twice is detected.
+ *
+ * @param[in] p_out  Channel to the other context.
+ * @param[in] p_in   Channel from the other context.
+ * @param[in] mark   Owner mark of this context.
+ */
+static void stress_run(channel_t * p_out, channel_t * p_in, uint8_t mark)
+{
+    uint32_t sent     = 0;
+    uint32_t received = 0;
+    void   * p_block  = NULL;
+
+    while ((sent < STRESS_OPS) || (received < STRESS_OPS))
+    {
+        bool progress = false;
+
+        if ((p_block == NULL) && (sent < STRESS_OPS))
+        {
+            p_block = nrf_slab_alloc(&m_slab, SMALL_SIZE);
+            if (p_block != NULL)
+            {
+                for (uint32_t i = 0; i < SMALL_SIZE; i++)
+                {
+                    HOST_TEST_ASSERT(((uint8_t *)p_block)[i] == 0);
+                }
+                memset(p_block, mark, SMALL_SIZE);
+            }
+        }
+        if ((p_block != NULL) && channel_put(p_out, p_block))
+        {
+            p_block  = NULL;
+            progress = true;
+            sent++;
+        }
+
+        void * p_received = channel_get(p_in);
+        if (p_received != NULL)
+        {
+            for (uint32_t i = 0; i < SMALL_SIZE; i++)
+            {
+                HOST_TEST_ASSERT(((uint8_t *)p_received)[i] != mark);
+                HOST_TEST_ASSERT(((uint8_t *)p_received)[i] == ((uint8_t *)p_received)[0]);
+            }
+            memset(p_received, 0, SMALL_SIZE);
+            nrf_slab_free(&m_slab, p_received);
+            progress = true;
+            received++;
+        }
+
+        if (!progress)
+        {
+            // Let the other context run if the host has fewer cores than threads.
+            (void)sched_yield();
+        }
+    }
+}
+
+
+static void * irq_thread(void * p_arg)
+{
+    host_int_priority_set(IRQ_PRIO);
+    stress_run(&m_to_thread, &m_to_irq, 0xB2);
+    return NULL;
+}
+
+
+/**@brief Test of blocks allocated in one context and freed in another. */
+static void cross_context_test(void)
+{
+    pthread_t        thread;
+    void           * p_blocks[SMALL_COUNT + LARGE_COUNT];
+    nrf_slab_stats_t stats;
+
+    HOST_TEST_ASSERT(nrf_slab_init(&m_slab) == NRF_SUCCESS);
+    for (uint32_t i = 0; i < SMALL_COUNT; i++)
+    {
+        p_blocks[i] = nrf_slab_alloc(&m_slab, SMALL_SIZE);
+        memset(p_blocks[i], 0, SMALL_SIZE);
+    }
+    for (uint32_t i = 0; i < SMALL_COUNT; i++)
+    {
+        nrf_slab_free(&m_slab, p_blocks[i]);
+    }
+
+    HOST_TEST_ASSERT(pthread_create(&thread, NULL, irq_thread, NULL) == 0);
+    stress_run(&m_to_irq, &m_to_thread, 0xA1);
+    HOST_TEST_ASSERT(pthread_join(thread, NULL) == 0);
+
+    // The small blocks are spread over the magazines of both contexts, all of them can be
+    // allocated from Thread Mode.
+    stats_get(0, &stats);
+    HOST_TEST_ASSERT(stats.in_use == 0);
+    stats_get(1, &stats);
+    HOST_TEST_ASSERT(stats.in_use == 0);
+    for (uint32_t i = 0; i < SMALL_COUNT + LARGE_COUNT; i++)
+    {
+        p_blocks[i] = nrf_slab_alloc(&m_slab, SMALL_SIZE);
+        HOST_TEST_ASSERT(p_blocks[i] != NULL);
+    }
+    HOST_TEST_ASSERT(nrf_slab_alloc(&m_slab, SMALL_SIZE) == NULL);
+    stats_get(0, &stats);
+    HOST_TEST_ASSERT((stats.in_use == SMALL_COUNT) && (stats.max_in_use == SMALL_COUNT));
+    HOST_TEST_ASSERT(stats.fail_cnt == 1);
+
+    printf("Cross-context frees: OK (%u blocks passed)\n", 2 * STRESS_OPS);
+}
+
+
+int main(void)
+{
+    classes_test();
+    magazine_test();
+    cross_context_test();
+
+    return 0;
+}